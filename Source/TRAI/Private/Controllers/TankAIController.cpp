@@ -6,8 +6,11 @@
 #include "Pawn/BaseTankPawn.h"
 #include "Components/TankAimingComponent.h"
 #include "Components/HealthComponent.h"
+#include "Utils/BallisticUtils.h"
 
 #include "Subsystems/TankAISharedStateSubsystem.h"
+#include "Subsystems/TankAISchedulerSubsystem.h"
+#include "Subsystems/WanderPointSubsystem.h"
 
 #include "NavigationSystem.h"
 #include "Navigation/PathFollowingComponent.h"
@@ -16,6 +19,7 @@
 #include "Kismet/GameplayStatics.h" 
 
 #include "TRConstants.h"
+#include "Debug/TRCsvProfiler.h"
 #include "TRAILogging.h"
 #include "Logging/LoggingUtils.h"
 #include "VisualLogger/VisualLogger.h"
@@ -49,6 +53,32 @@ void ATankAIController::BeginPlay()
 	// Do alternate checks for line of sight
 	bLOSflag = true;
 	bSkipExtraLOSChecks = false;
+
+	auto World = GetWorld();
+	check(World);
+
+	if (auto SchedulerSubsystem = World->GetSubsystem<UTankAISchedulerSubsystem>(); ensure(SchedulerSubsystem))
+	{
+		SchedulerSubsystem->RegisterController(*this);
+	}
+}
+
+void ATankAIController::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (auto World = GetWorld(); World)
+	{
+		if (auto SchedulerSubsystem = World->GetSubsystem<UTankAISchedulerSubsystem>(); SchedulerSubsystem)
+		{
+			SchedulerSubsystem->UnregisterController(*this);
+		}
+
+		if (auto WanderPointSubsystem = World->GetSubsystem<UWanderPointSubsystem>(); WanderPointSubsystem)
+		{
+			WanderPointSubsystem->ReleaseReservation(*this);
+		}
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void ATankAIController::OnPossess(APawn* InPawn)
@@ -79,31 +109,40 @@ void ATankAIController::OnUnPossess()
 		Tank->GetItemInventory()->Clear();
 		Tank->GetHealthComponent()->OnHealthChanged.RemoveDynamic(this, &ThisClass::OnHealthChanged);
 	}
+
+	if (auto World = GetWorld(); World)
+	{
+		if (auto WanderPointSubsystem = World->GetSubsystem<UWanderPointSubsystem>(); WanderPointSubsystem)
+		{
+			WanderPointSubsystem->ReleaseReservation(*this);
+		}
+	}
 }
 
 void ATankAIController::Tick(float DeltaTime)
 {
 	SCOPE_CYCLE_COUNTER(STAT_TankAIController_Tick);
+	CSV_SCOPED_TIMING_STAT(TR, TankAIController_Tick);
 
 	Super::Tick(DeltaTime);
 
-	ExecuteAI();
+	// Otherwise run in time slices by UTankAISchedulerSubsystem
+	if (!UTankAISchedulerSubsystem::IsEnabled())
+	{
+		ExecuteAI();
+	}
 }
 
 void ATankAIController::ExecuteAI()
 {
-	auto World = GetWorld();
-	check(World);
-
-	const auto AIContextOptional = GetAIContext();
-
-	if (!AIContextOptional)
+	if (const auto AIContextOptional = GetAIContext(); AIContextOptional)
 	{
-		return;
+		ExecuteAI(*AIContextOptional);
 	}
+}
 
-	const auto& AIContext = *AIContextOptional;
-
+void ATankAIController::ExecuteAI(const FTankAIContext& AIContext)
+{
 	if (AIContext.NowSeconds < StartDelayTime)
 	{
 		return;
@@ -214,19 +253,21 @@ void ATankAIController::Wander(const FTankAIContext& AIContext)
 		return;
 	}
 
-	FNavLocation NavLocation;
+	auto World = GetWorld();
+	// already validated in ShouldWander
+	check(World);
 
-	auto NavigationSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
-	if (!ensureMsgf(NavigationSystem, TEXT("NavigationSystem unavailable!")))
+	auto WanderPointSubsystem = World->GetSubsystem<UWanderPointSubsystem>();
+	if (!ensure(WanderPointSubsystem))
 	{
 		return;
 	}
 
 	const auto& StartLocation = AIContext.MyTank.GetActorLocation();
 
-	if (!NavigationSystem->GetRandomReachablePointInRadius(
-		StartLocation,
-		WanderRadius, NavLocation))
+	// Falls back to a navmesh query when there is no free reservoir point in range
+	FVector TargetLocation;
+	if (!WanderPointSubsystem->FindWanderPoint(*this, StartLocation, WanderRadius, TargetLocation))
 	{
 		UE_VLOG_UELOG(this, LogTRAI, Log, TEXT("%s-%s: Wander - Unable to find a navigable point from %s in radius=%fm"),
 			*GetName(), *AIContext.MyTank.GetName(),
@@ -234,14 +275,8 @@ void ATankAIController::Wander(const FTankAIContext& AIContext)
 		return;
 	}
 
-	auto World = GetWorld();
-	// already validated in ShouldWander
-	check(World);
-
 	LastWanderTime = World->GetTimeSeconds();
 
-	const auto& TargetLocation = NavLocation.Location;
-
 	UE_VLOG_UELOG(this, LogTRAI, Log, TEXT("%s-%s: Wander - Wander from %s to %s (Dist=%.1fm / Max=%.1fm"),
 		*GetName(), *AIContext.MyTank.GetName(),
 		*StartLocation.ToCompactString(), *TargetLocation.ToCompactString(),
@@ -297,11 +332,15 @@ void ATankAIController::AimAtPlayerTank(const FTankAIContext& AIContext)
 	FVector PredictiveOffset{ EForceInit::ForceInitToZero };
 	if (ActiveWeapon->IsLaunchable() && PlayerVelocity.SizeSquared() > FMath::Square(PlayerVelocityPredictiveThreshold))
 	{
-		// Assuming only the "X" direction ignoring gravity
-		const float PlayerDistanceMeters = AIContext.MyTank.GetDistanceTo(&PlayerTank);
-		const float InterceptTime = PlayerDistanceMeters / ActiveWeapon->GetLaunchSpeed();
+		auto World = GetWorld();
+		check(World);
 
-		PredictiveOffset = PlayerVelocity * InterceptTime;
+		// Lead by the time of flight of the ballistic arc to where the player will be
+		if (const auto Intercept = TR::BallisticUtils::SolveIntercept(
+			AITank.GetActorLocation(), PlayerTank.GetActorLocation(), PlayerVelocity, ActiveWeapon->GetLaunchSpeed(), World->GetGravityZ()); Intercept)
+		{
+			PredictiveOffset = PlayerVelocity * Intercept->TimeOfFlight;
+		}
 	}
 
 	const auto PredictedPosition = PlayerTank.GetActorLocation() + PredictiveOffset;
@@ -420,6 +459,23 @@ bool ATankAIController::ShouldMoveTowardReportedPosition(const FTankAIContext& A
 	return true;
 }
 
+ETankAIUpdateBucket ATankAIController::GetUpdateBucket(float DistSqToPlayer) const
+{
+	const auto AggroDistance = MaxAggroDistanceMeters * 100;
+
+	if (DistSqToPlayer <= FMath::Square(AggroDistance))
+	{
+		return ETankAIUpdateBucket::Combat;
+	}
+
+	if (DistSqToPlayer <= FMath::Square(AggroDistance * FarUpdateAggroDistanceMultiplier))
+	{
+		return ETankAIUpdateBucket::Wander;
+	}
+
+	return ETankAIUpdateBucket::Far;
+}
+
 bool ATankAIController::IsPlayerInRange(const FTankAIContext& AIContext) const
 {
 	return AIContext.DistSqToPlayer <= FMath::Square(MaxAggroDistanceMeters * 100);
@@ -15,6 +15,7 @@
 #include "Camera/CameraComponent.h"
 
 #include "Subsystems/TankEventsSubsystem.h"
+#include "Subsystems/PawnSpatialHashSubsystem.h"
 
 #include <limits>
 #include <optional>
@@ -33,13 +34,13 @@ namespace
 	};
 
 	std::optional<FCameraFOVResult> GetCameraFOVFor(const APawn& Pawn);
-	bool IsInFOV(const APawn& Pawn, const FVector& SpawnReferenceLocation);
+	bool IsInLineOfSight(const APawn& Pawn, const FCameraFOVResult& FOV, const FVector& SpawnReferenceLocation);
+	bool IsInFOVCone(const APawn& Pawn, const FCameraFOVResult& FOV, const FVector& SpawnReferenceLocation);
 
 	FRotator GetSpawnActorRotation(const USceneComponent& SpawnLocationComponent, const AActor* LookAtActor);
 }
 
-// Initialize the random number generator with a seed from current time
-AEnemySpawner::AEnemySpawner() : Rng(RandUtils::GenerateSeed())
+AEnemySpawner::AEnemySpawner()
 {
 	PrimaryActorTick.bCanEverTick = false;
 
@@ -65,8 +66,13 @@ bool AEnemySpawner::ShouldBeConsideredForSpawning(const APawn& PlayerPawn, float
 	return RefDistSq <= ConsiderationRadiusSq + FMath::Square(MaxDistance);
 }
 
-bool AEnemySpawner::CanSpawnAnyFor(const APawn& PlayerPawn, float* OutScore) const
+bool AEnemySpawner::CanSpawnAnyFor(const APawn& PlayerPawn, float* OutScore, bool* bOutRequiresFOVTrace) const
 {
+	if (bOutRequiresFOVTrace)
+	{
+		*bOutRequiresFOVTrace = false;
+	}
+
 	if (SpawningTypes.IsEmpty() || SpawnLocations.IsEmpty() || IsCoolingDown())
 	{
 		return false;
@@ -93,8 +99,44 @@ bool AEnemySpawner::CanSpawnAnyFor(const APawn& PlayerPawn, float* OutScore) con
 		return false;
 	}
 
+	// Outside the view cone the spawner can't be visible so the result is exact without a trace
+	const auto FOVOpt = GetCameraFOVFor(PlayerPawn);
+	const bool bInFOVCone = FOVOpt && IsInFOVCone(PlayerPawn, *FOVOpt, SpawnReferenceLocation);
+
+	if (bInFOVCone && bOutRequiresFOVTrace)
+	{
+		// Take the best of both outcomes of the line of sight trace
+		const bool bCanSpawnInFOV = RefDistSq >= FMath::Square(MinimumDistanceFOV);
+		const bool bCanSpawnNotInFOV = RefDistSq >= FMath::Square(MinimumDistanceNotFOV);
+
+		if (!bCanSpawnInFOV && !bCanSpawnNotInFOV)
+		{
+			return false;
+		}
+
+		if (OutScore)
+		{
+			const auto RefDist = FMath::Sqrt(RefDistSq);
+
+			*OutScore = std::numeric_limits<float>::max();
+
+			if (bCanSpawnInFOV)
+			{
+				*OutScore = CalculateSpawningScore(RefDist, MinimumDistanceFOV, true);
+			}
+			if (bCanSpawnNotInFOV)
+			{
+				*OutScore = FMath::Min(*OutScore, CalculateSpawningScore(RefDist, MinimumDistanceNotFOV, false));
+			}
+		}
+
+		*bOutRequiresFOVTrace = true;
+
+		return true;
+	}
+
 	// Check min distance based on whether in FOV of player
-	const bool bInFOV = IsInFOV(PlayerPawn, SpawnReferenceLocation);
+	const bool bInFOV = bInFOVCone && IsInLineOfSight(PlayerPawn, *FOVOpt, SpawnReferenceLocation);
 	const float ReferenceMinDistance = bInFOV ? MinimumDistanceFOV : MinimumDistanceNotFOV;
 
 	if (RefDistSq < FMath::Square(ReferenceMinDistance))
@@ -258,6 +300,18 @@ bool AEnemySpawner::IsSpawnPointObstructed(UClass* SpawnClass, const FTransform&
 		BoundsCache.Add(SpawnCDO, BoundsExtent);
 	}
 
+	// Tanks are tracked in the spatial hash so check them first without a physics query
+	if (auto PawnSpatialHashSubsystem = World->GetSubsystem<UPawnSpatialHashSubsystem>(); PawnSpatialHashSubsystem)
+	{
+		const auto SpawnBounds = FBox(-BoundsExtent, BoundsExtent).TransformBy(SpawnTransform);
+		if (PawnSpatialHashSubsystem->AnyOverlappingBox(SpawnBounds, MakeArrayView(SpawnedThisCycle)))
+		{
+			UE_VLOG_UELOG(this, LogTRAI, Log, TEXT("%s: IsSpawnPointObstructed - SpawnClass=%s obstructed by a tank at %s"),
+				*GetName(), *LoggingUtils::GetName(SpawnClass), *SpawnTransform.GetLocation().ToCompactString());
+			return true;
+		}
+	}
+
 	FCollisionQueryParams QueryParams;
 	// Ignore any actors spawned this cycle as we've already accounted for not spawning multiple in same spawn location
 	// and don't want the safety bounds to interfere
@@ -348,6 +402,9 @@ void AEnemySpawner::BeginPlay()
 {
 	Super::BeginPlay();
 
+	// Keyed by path name so that a pinned seed gives each spawner the same sequence every run
+	Rng.seed(RandUtils::GenerateSeed(*this));
+
 	UE_VLOG_UELOG(this, LogTRAI, Log, TEXT("%s: BeginPlay - %d spawn locations found"), *GetName(), SpawnLocations.Num());
 
 	auto World = GetWorld();
@@ -366,6 +423,8 @@ void AEnemySpawner::GroundSpawnPoints()
 
 		GroundSpawnPoint(*SpawnLocation);
 	}
+
+	CachedSpawnReferenceLocation = CalculateSpawnReferenceLocation();
 }
 
 void AEnemySpawner::GroundSpawnPoint(USpawnLocationComponent& SpawnLocation)
@@ -463,6 +522,11 @@ UClass* AEnemySpawner::SelectSpawnClass() const
 }
 
 FVector AEnemySpawner::GetSpawnReferenceLocation() const
+{
+	return CachedSpawnReferenceLocation ? *CachedSpawnReferenceLocation : CalculateSpawnReferenceLocation();
+}
+
+FVector AEnemySpawner::CalculateSpawnReferenceLocation() const
 {
 	if (SpawnLocations.IsEmpty())
 	{
@@ -508,28 +572,8 @@ namespace
 		return FCameraFOVResult { CameraComponent->GetComponentLocation(), CameraComponent->FieldOfView };
 	}
 
-	bool IsInFOV(const APawn& Pawn, const FVector& SpawnReferenceLocation)
+	bool IsInLineOfSight(const APawn& Pawn, const FCameraFOVResult& FOV, const FVector& SpawnReferenceLocation)
 	{
-		auto FOVOpt = GetCameraFOVFor(Pawn);
-		if (!FOVOpt)
-		{
-			return false;
-		}
-
-		const auto FOVHalfAngleRads = FMath::DegreesToRadians(FOVOpt->FOV * 0.5f);
-
-		const auto& ActorForwardVector = Pawn.GetActorForwardVector();
-		const auto& ActorLocation = Pawn.GetActorLocation();
-
-		const auto ToSpawnDirection = (SpawnReferenceLocation - ActorLocation).GetSafeNormal();
-
-		const auto ToSpawnHalfAngleRads = FMath::Acos(ToSpawnDirection | ActorForwardVector);
-
-		if (ToSpawnHalfAngleRads > FOVHalfAngleRads)
-		{
-			return false;
-		}
-
 		// Line test against camera to location to see if player can see the given spawn reference location
 
 		auto World = Pawn.GetWorld();
@@ -544,7 +588,21 @@ namespace
 		QueryParams.MobilityType = EQueryMobilityType::Static;
 
 		// LineTraceTestByChannel returns whether a blocking hit was found, so return true if no blocking hit found
-		return !World->LineTraceTestByChannel(FOVOpt->Location, SpawnReferenceLocation, ECollisionChannel::ECC_Visibility, QueryParams);
+		return !World->LineTraceTestByChannel(FOV.Location, SpawnReferenceLocation, ECollisionChannel::ECC_Visibility, QueryParams);
+	}
+
+	bool IsInFOVCone(const APawn& Pawn, const FCameraFOVResult& FOV, const FVector& SpawnReferenceLocation)
+	{
+		const auto FOVHalfAngleRads = FMath::DegreesToRadians(FOV.FOV * 0.5f);
+
+		const auto& ActorForwardVector = Pawn.GetActorForwardVector();
+		const auto& ActorLocation = Pawn.GetActorLocation();
+
+		const auto ToSpawnDirection = (SpawnReferenceLocation - ActorLocation).GetSafeNormal();
+
+		const auto ToSpawnHalfAngleRads = FMath::Acos(ToSpawnDirection | ActorForwardVector);
+
+		return ToSpawnHalfAngleRads <= FOVHalfAngleRads;
 	}
 
 	FRotator GetSpawnActorRotation(const USceneComponent& SpawnLocationComponent, const AActor* LookAtActor)
@@ -0,0 +1,255 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/TankAISchedulerSubsystem.h"
+
+#include "Controllers/TankAIController.h"
+#include "Subsystems/TankAISharedStateSubsystem.h"
+#include "Pawn/BaseTankPawn.h"
+
+#include "Kismet/GameplayStatics.h"
+
+#include "Debug/TRConsoleVars.h"
+#include "Debug/TRCsvProfiler.h"
+
+#include "Logging/LoggingUtils.h"
+#include "TRAILogging.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(TankAISchedulerSubsystem)
+
+DECLARE_CYCLE_STAT(TEXT("TankAISchedulerSubsystem::Tick"), STAT_TankAISchedulerSubsystem_Tick, STATGROUP_TRAI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AI Controllers Processed"), STAT_TankAISchedulerSubsystem_Processed, STATGROUP_TRAI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AI Controllers Deferred"), STAT_TankAISchedulerSubsystem_Deferred, STATGROUP_TRAI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AI Budget Overruns"), STAT_TankAISchedulerSubsystem_Overruns, STATGROUP_TRAI);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("AI Controllers Scheduled"), STAT_TankAISchedulerSubsystem_Scheduled, STATGROUP_TRAI);
+
+namespace
+{
+	/* Frames between updates for each bucket. Wandering only issues a move after a cooldown of seconds so can tolerate a few frames of latency. */
+	constexpr uint64 CombatUpdateFrameInterval = 1;
+	constexpr uint64 WanderUpdateFrameInterval = 4;
+	constexpr uint64 FarUpdateFrameInterval = 15;
+}
+
+void UTankAISchedulerSubsystem::RegisterController(ATankAIController& Controller)
+{
+	UnregisterController(Controller);
+
+	Controllers.Add(FScheduledController
+	{
+		.Controller = &Controller,
+		.NextUpdateFrame = GFrameCounter,
+		.Bucket = ETankAIUpdateBucket::Combat
+	});
+
+	// The controller only runs its own tick while the scheduler is disabled
+	Controller.SetActorTickEnabled(!bControllersScheduled);
+
+	INC_DWORD_STAT(STAT_TankAISchedulerSubsystem_Scheduled);
+
+	UE_LOG(LogTRAI, Verbose, TEXT("%s: RegisterController: %s - %d controller%s registered"),
+		*GetName(), *Controller.GetName(), Controllers.Num(), LoggingUtils::Pluralize(Controllers.Num()));
+}
+
+void UTankAISchedulerSubsystem::UnregisterController(ATankAIController& Controller)
+{
+	// Controllers may be unregistered while running their AI, e.g. when the player tank is destroyed, so the entry is left for the next tick to remove
+	if (bTicking)
+	{
+		for (auto& Entry : Controllers)
+		{
+			if (Entry.Controller.Get() == &Controller)
+			{
+				Entry.Controller.Reset();
+			}
+		}
+
+		return;
+	}
+
+	const auto RemovedCount = Controllers.RemoveAllSwap([&Controller](const auto& Entry)
+	{
+		return Entry.Controller.Get() == &Controller;
+	});
+
+	DEC_DWORD_STAT_BY(STAT_TankAISchedulerSubsystem_Scheduled, RemovedCount);
+}
+
+bool UTankAISchedulerSubsystem::IsEnabled()
+{
+	return TR::CVarAISchedulerEnabled.GetValueOnGameThread();
+}
+
+bool UTankAISchedulerSubsystem::IsTickable() const
+{
+	// Still ticks while disabled so that controller ticks are handed back when it is toggled
+	return !Controllers.IsEmpty();
+}
+
+void UTankAISchedulerSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_TankAISchedulerSubsystem_Tick);
+	CSV_SCOPED_TIMING_STAT(TR, TankAISchedulerSubsystem_Tick);
+
+	Super::Tick(DeltaTime);
+
+	const auto StaleCount = Controllers.RemoveAllSwap([](const auto& Entry)
+	{
+		return !Entry.Controller.IsValid();
+	});
+
+	DEC_DWORD_STAT_BY(STAT_TankAISchedulerSubsystem_Scheduled, StaleCount);
+
+	if (const auto bEnabled = IsEnabled(); bEnabled != bControllersScheduled)
+	{
+		SetControllersScheduled(bEnabled);
+	}
+
+	if (!bControllersScheduled)
+	{
+		return;
+	}
+
+	TGuardValue TickingGuard(bTicking, true);
+
+	auto World = GetWorld();
+	check(World);
+
+	// Looked up once for all controllers
+	auto PlayerTank = Cast<ABaseTankPawn>(UGameplayStatics::GetPlayerPawn(World, 0));
+	if (!PlayerTank)
+	{
+		return;
+	}
+
+	auto AISubsystem = World->GetSubsystem<UTankAISharedStateSubsystem>();
+	if (!ensure(AISubsystem))
+	{
+		return;
+	}
+
+	const auto NowSeconds = World->GetTimeSeconds();
+	const auto PlayerLocation = PlayerTank->GetActorLocation();
+	const auto CurrentFrame = GFrameCounter;
+
+	const auto BudgetSeconds = FMath::Max(0.0f, TR::CVarAISchedulerBudgetMs.GetValueOnGameThread()) / 1000.0;
+	const auto StartTimeSeconds = FPlatformTime::Seconds();
+
+	const auto Count = Controllers.Num();
+	const auto StartIndex = Count > 0 ? NextIndex % Count : 0;
+
+	int32 ProcessedCount{};
+	int32 DeferredCount{};
+	int32 FirstDeferredIndex{ INDEX_NONE };
+
+	// Entries are not removed until the next tick but controllers that begin play while running the AI are appended so only visit the existing ones
+	for (int32 Offset = 0; Offset < Count; ++Offset)
+	{
+		const auto Index = (StartIndex + Offset) % Count;
+		auto& Entry = Controllers[Index];
+
+		if (Entry.NextUpdateFrame > CurrentFrame)
+		{
+			continue;
+		}
+
+		// Always process at least one controller so that progress is made on a slow frame
+		if (ProcessedCount > 0 && FPlatformTime::Seconds() - StartTimeSeconds > BudgetSeconds)
+		{
+			if (FirstDeferredIndex == INDEX_NONE)
+			{
+				FirstDeferredIndex = Index;
+			}
+			++DeferredCount;
+			continue;
+		}
+
+		auto Controller = Entry.Controller.Get();
+		auto ControlledTank = Controller ? Controller->GetControlledTank() : nullptr;
+
+		if (!ControlledTank)
+		{
+			Entry.NextUpdateFrame = CurrentFrame + FarUpdateFrameInterval;
+			continue;
+		}
+
+		const auto DistSqToPlayer = static_cast<float>(FVector::DistSquared(ControlledTank->GetActorLocation(), PlayerLocation));
+
+		Entry.Bucket = Controller->GetUpdateBucket(DistSqToPlayer);
+		Entry.NextUpdateFrame = CurrentFrame + GetUpdateFrameInterval(Entry.Bucket);
+
+		Controller->ExecuteAI(ATankAIController::FTankAIContext
+		{
+			.MyTank = *ControlledTank,
+			.PlayerTank = *PlayerTank,
+			.AISubsystem = *AISubsystem,
+			.NowSeconds = NowSeconds,
+			.DistSqToPlayer = DistSqToPlayer
+		});
+
+		++ProcessedCount;
+	}
+
+	NextIndex = FirstDeferredIndex != INDEX_NONE ? FirstDeferredIndex : 0;
+
+	INC_DWORD_STAT_BY(STAT_TankAISchedulerSubsystem_Processed, ProcessedCount);
+	INC_DWORD_STAT_BY(STAT_TankAISchedulerSubsystem_Deferred, DeferredCount);
+
+	CSV_CUSTOM_STAT(TR, AIControllersProcessed, ProcessedCount, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(TR, AIControllersDeferred, DeferredCount, ECsvCustomStatOp::Set);
+
+	if (DeferredCount > 0)
+	{
+		INC_DWORD_STAT(STAT_TankAISchedulerSubsystem_Overruns);
+
+		UE_LOG(LogTRAI, Verbose, TEXT("%s: Tick - Budget of %.2fms exceeded after %d controller%s; deferred %d"),
+			*GetName(), BudgetSeconds * 1000, ProcessedCount, LoggingUtils::Pluralize(ProcessedCount), DeferredCount);
+	}
+}
+
+TStatId UTankAISchedulerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTankAISchedulerSubsystem, STATGROUP_Tickables);
+}
+
+void UTankAISchedulerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	bControllersScheduled = IsEnabled();
+}
+
+void UTankAISchedulerSubsystem::Deinitialize()
+{
+	DEC_DWORD_STAT_BY(STAT_TankAISchedulerSubsystem_Scheduled, Controllers.Num());
+
+	Controllers.Reset();
+
+	Super::Deinitialize();
+}
+
+void UTankAISchedulerSubsystem::SetControllersScheduled(bool bScheduled)
+{
+	bControllersScheduled = bScheduled;
+
+	for (const auto& Entry : Controllers)
+	{
+		if (auto Controller = Entry.Controller.Get(); Controller)
+		{
+			Controller->SetActorTickEnabled(!bScheduled);
+		}
+	}
+
+	UE_LOG(LogTRAI, Log, TEXT("%s: SetControllersScheduled - Scheduled=%s; Controllers=%d"),
+		*GetName(), LoggingUtils::GetBoolString(bScheduled), Controllers.Num());
+}
+
+uint64 UTankAISchedulerSubsystem::GetUpdateFrameInterval(ETankAIUpdateBucket Bucket)
+{
+	switch (Bucket)
+	{
+		case ETankAIUpdateBucket::Combat: return CombatUpdateFrameInterval;
+		case ETankAIUpdateBucket::Wander: return WanderUpdateFrameInterval;
+		default: return FarUpdateFrameInterval;
+	}
+}
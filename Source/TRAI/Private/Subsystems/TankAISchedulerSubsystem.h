@@ -0,0 +1,76 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "TankAISchedulerSubsystem.generated.h"
+
+class ATankAIController;
+
+/*
+* Update rate of a tank AI controller based on its distance to the player.
+*/
+enum class ETankAIUpdateBucket : uint8
+{
+	/* Within aggro range and runs every frame. */
+	Combat,
+	/* Near aggro range but only wandering so decimated. */
+	Wander,
+	/* Far from the player and updated rarely. */
+	Far,
+	MAX
+};
+
+/**
+ * Runs the AI of all tank AI controllers in the level from a single tick in time slices instead of each controller running every frame.
+ * Controllers are updated at a rate determined by their distance bucket and processing stops once the per-frame budget
+ * set with <c>tr.ai.scheduler.budgetMs</c> is spent. Controllers that were due but deferred are updated first on the next frame.
+ *
+ * Registered controllers have their own tick disabled. Disabling <c>tr.ai.scheduler.enabled</c> enables it again so every controller runs its AI on its own tick.
+ */
+UCLASS()
+class UTankAISchedulerSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	void RegisterController(ATankAIController& Controller);
+	void UnregisterController(ATankAIController& Controller);
+
+	static bool IsEnabled();
+
+protected:
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+
+	virtual TStatId GetStatId() const override;
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+private:
+	struct FScheduledController
+	{
+		TWeakObjectPtr<ATankAIController> Controller;
+		uint64 NextUpdateFrame;
+		ETankAIUpdateBucket Bucket;
+	};
+
+	static uint64 GetUpdateFrameInterval(ETankAIUpdateBucket Bucket);
+
+	void SetControllersScheduled(bool bScheduled);
+
+private:
+	TArray<FScheduledController> Controllers{};
+
+	/* Index to start from next frame so that controllers deferred by the budget are not starved. */
+	int32 NextIndex{};
+
+	/* Whether the controllers are run from this tick rather than their own. Follows <c>tr.ai.scheduler.enabled</c>. */
+	bool bControllersScheduled{};
+
+	/* Set while running the AI so that unregistering does not remove entries from under the loop. */
+	bool bTicking{};
+};
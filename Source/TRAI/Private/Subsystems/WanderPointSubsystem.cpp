@@ -0,0 +1,805 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/WanderPointSubsystem.h"
+
+#include "NavigationSystem.h"
+#include "NavMesh/RecastNavMesh.h"
+#include "Detour/DetourNavMesh.h"
+#include "Algo/BinarySearch.h"
+#include "GameFramework/Controller.h"
+#include "Misc/ScopeExit.h"
+
+#include "Debug/TRConsoleVars.h"
+#include "Utils/RandUtils.h"
+
+#include "Logging/LoggingUtils.h"
+#include "TRAILogging.h"
+
+#if TR_DEBUG_ENABLED
+	#include "HAL/IConsoleManager.h"
+#endif
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(WanderPointSubsystem)
+
+DECLARE_CYCLE_STAT(TEXT("WanderPointSubsystem::Refill"), STAT_WanderPointSubsystem_Refill, STATGROUP_TRAI);
+DECLARE_CYCLE_STAT(TEXT("WanderPointSubsystem::Query"), STAT_WanderPointSubsystem_Query, STATGROUP_TRAI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Wander Point Hits"), STAT_WanderPointSubsystem_Hits, STATGROUP_TRAI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Wander Point Misses"), STAT_WanderPointSubsystem_Misses, STATGROUP_TRAI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Wander Points Sampled"), STAT_WanderPointSubsystem_Samples, STATGROUP_TRAI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Wander Points Unreachable"), STAT_WanderPointSubsystem_Unreachable, STATGROUP_TRAI);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Wander Points Available"), STAT_WanderPointSubsystem_Available, STATGROUP_TRAI);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Wander Point Hit Rate"), STAT_WanderPointSubsystem_HitRate, STATGROUP_TRAI);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Wander Query Time Saved (ms)"), STAT_WanderPointSubsystem_SavedMs, STATGROUP_TRAI);
+
+namespace
+{
+	/* Points kept in the reservoir for each navmesh tile. */
+	constexpr int32 SamplesPerTile = 4;
+
+	/* Time spent refilling tiles each frame. */
+	constexpr double RefillBudgetSeconds = 0.0002;
+
+	/* Points within this distance of another tank's wander destination are not handed out. */
+	constexpr float ReservationRadius = 1000.0f;
+
+	/* Reservations are dropped after this long in case the requester never releases them, e.g. it was destroyed while moving. */
+	constexpr double ReservationSeconds = 15.0;
+
+	constexpr float PointGridCellSize = 2000.0f;
+
+	/* Candidates path tested per request before falling back to the navmesh query. */
+	constexpr int32 MaxReachabilityTests = 3;
+
+	/* Extent used to find the navmesh polygon of the requester and so its island. */
+	const FVector OriginProjectExtent{ 100.0, 100.0, 250.0 };
+
+	/*
+	* Uniform random point in a convex polygon by picking a triangle of its fan weighted by area.
+	*/
+	FVector RandomPointInConvexPolygon(FRandomStream& Rng, const TArray<FVector>& Verts, double PolygonArea)
+	{
+		check(Verts.Num() >= 3);
+
+		auto Remaining = Rng.FRand() * PolygonArea;
+
+		int32 Triangle = 1;
+		for (; Triangle < Verts.Num() - 2; ++Triangle)
+		{
+			const auto TriangleArea = 0.5 * FVector::CrossProduct(Verts[Triangle] - Verts[0], Verts[Triangle + 1] - Verts[0]).Size();
+			if (Remaining <= TriangleArea)
+			{
+				break;
+			}
+			Remaining -= TriangleArea;
+		}
+
+		// Square root keeps the distribution uniform over the triangle
+		const auto U = FMath::Sqrt(Rng.FRand());
+		const auto V = Rng.FRand();
+
+		return Verts[0] * (1 - U) + Verts[Triangle] * (U * (1 - V)) + Verts[Triangle + 1] * (U * V);
+	}
+
+	double ConvexPolygonArea(const TArray<FVector>& Verts)
+	{
+		double Area{};
+		for (int32 i = 1; i < Verts.Num() - 1; ++i)
+		{
+			Area += 0.5 * FVector::CrossProduct(Verts[i] - Verts[0], Verts[i + 1] - Verts[0]).Size();
+		}
+		return Area;
+	}
+}
+
+bool UWanderPointSubsystem::FindWanderPoint(const AController& Requester, const FVector& Origin, float Radius, FVector& OutLocation)
+{
+	SCOPE_CYCLE_COUNTER(STAT_WanderPointSubsystem_Query);
+
+	if (IsEnabled() && EnsureTiles() && TakeReservoirPoint(Requester, Origin, Radius, OutLocation))
+	{
+		++Counters.Hits;
+
+		INC_DWORD_STAT(STAT_WanderPointSubsystem_Hits);
+
+		Reserve(Requester, OutLocation);
+	}
+	else if (QueryNavigation(Origin, Radius, OutLocation))
+	{
+		Reserve(Requester, OutLocation);
+	}
+	else
+	{
+		return false;
+	}
+
+	SET_FLOAT_STAT(STAT_WanderPointSubsystem_HitRate, Counters.GetHitRate());
+	SET_FLOAT_STAT(STAT_WanderPointSubsystem_SavedMs, Counters.GetSavedQuerySeconds() * 1000);
+
+	UE_LOG(LogTRAI, Verbose, TEXT("%s: FindWanderPoint - Requester=%s; Origin=%s; Radius=%.1fm; Location=%s; Hits=%d; Misses=%d; Available=%d"),
+		*GetName(), *Requester.GetName(), *Origin.ToCompactString(), Radius / 100, *OutLocation.ToCompactString(),
+		Counters.Hits, Counters.Misses, Points.Num());
+
+	return true;
+}
+
+void UWanderPointSubsystem::ReleaseReservation(const AController& Requester)
+{
+	Reservations.RemoveAllSwap([&Requester](const auto& Reservation)
+	{
+		return Reservation.Requester.Get() == &Requester;
+	});
+}
+
+int32 UWanderPointSubsystem::RefillAll()
+{
+	if (!EnsureTiles())
+	{
+		return 0;
+	}
+
+	return RefillTiles(TNumericLimits<double>::Max());
+}
+
+float UWanderPointSubsystem::GetReservationRadius() const
+{
+	return ReservationRadius;
+}
+
+bool UWanderPointSubsystem::IsEnabled()
+{
+	return TR::CVarAIWanderPointsEnabled.GetValueOnGameThread();
+}
+
+void UWanderPointSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Keyed by path name so that a pinned seed gives the same wander points every run
+	Rng.Initialize(RandUtils::GenerateSeed(*this));
+
+	PointGrid.Reset(PointGridCellSize);
+
+	if (auto NavigationSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(&InWorld); NavigationSystem)
+	{
+		NavigationSystem->OnNavigationGenerationFinishedDelegate.AddDynamic(this, &ThisClass::OnNavigationGenerationFinished);
+	}
+}
+
+void UWanderPointSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	auto World = GetWorld();
+	check(World);
+
+	PruneReservations(World->GetTimeSeconds());
+
+	if (EnsureTiles())
+	{
+		RefillTiles(RefillBudgetSeconds);
+	}
+}
+
+bool UWanderPointSubsystem::IsTickable() const
+{
+	return IsEnabled() && (RefillQueueHead < RefillQueue.Num() || !Reservations.IsEmpty() || !CachedNavMesh.IsValid());
+}
+
+TStatId UWanderPointSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWanderPointSubsystem, STATGROUP_Tickables);
+}
+
+void UWanderPointSubsystem::Deinitialize()
+{
+	if (auto World = GetWorld(); World)
+	{
+		if (auto NavigationSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World); NavigationSystem)
+		{
+			NavigationSystem->OnNavigationGenerationFinishedDelegate.RemoveAll(this);
+		}
+	}
+
+	ResetPoints();
+	Reservations.Reset();
+	CachedNavMesh.Reset();
+
+	Super::Deinitialize();
+}
+
+ARecastNavMesh* UWanderPointSubsystem::GetNavMesh() const
+{
+	auto NavigationSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (!NavigationSystem)
+	{
+		return nullptr;
+	}
+
+	return Cast<ARecastNavMesh>(NavigationSystem->GetDefaultNavDataInstance(FNavigationSystem::DontCreate));
+}
+
+bool UWanderPointSubsystem::EnsureTiles()
+{
+	if (CachedNavMesh.IsValid())
+	{
+		return true;
+	}
+
+	auto NavMesh = GetNavMesh();
+	if (!NavMesh)
+	{
+		return false;
+	}
+
+	const auto TileCount = NavMesh->GetNavMeshTilesCount();
+	if (TileCount <= 0)
+	{
+		return false;
+	}
+
+	ResetPoints();
+
+	CachedNavMesh = NavMesh;
+
+	BuildIslands(*NavMesh);
+
+	TileSampleCounts.SetNumZeroed(TileCount);
+	QueuedTiles.Init(true, TileCount);
+
+	RefillQueue.Reserve(TileCount);
+	for (int32 TileIndex = 0; TileIndex < TileCount; ++TileIndex)
+	{
+		RefillQueue.Add(TileIndex);
+	}
+
+	UE_LOG(LogTRAI, Log, TEXT("%s: EnsureTiles - NavMesh=%s; Tiles=%d; Polys=%d; Islands=%d"),
+		*GetName(), *NavMesh->GetName(), TileCount, PolyIslands.Num(), OffMeshLinkedIslands.Num());
+
+	return true;
+}
+
+void UWanderPointSubsystem::ResetPoints()
+{
+	DEC_DWORD_STAT_BY(STAT_WanderPointSubsystem_Available, Points.Num());
+
+	Points.Reset();
+	PointGrid.Reset(PointGridCellSize);
+	TileSampleCounts.Reset();
+	RefillQueue.Reset();
+	QueuedTiles.Reset();
+	RefillQueueHead = 0;
+	PolyIslands.Reset();
+	OffMeshLinkedIslands.Reset();
+}
+
+void UWanderPointSubsystem::BuildIslands(const ARecastNavMesh& NavMesh)
+{
+	PolyIslands.Reset();
+	OffMeshLinkedIslands.Reset();
+
+	auto DetourMesh = NavMesh.GetRecastMesh();
+	if (!DetourMesh)
+	{
+		return;
+	}
+
+	const auto ForEachPoly = [DetourMesh](auto&& Func)
+	{
+		for (int32 TileIndex = 0; TileIndex < DetourMesh->getMaxTiles(); ++TileIndex)
+		{
+			const auto Tile = DetourMesh->getTile(TileIndex);
+			if (!Tile || !Tile->header)
+			{
+				continue;
+			}
+
+			const auto BaseRef = DetourMesh->getPolyRefBase(Tile);
+
+			for (int32 PolyIndex = 0; PolyIndex < Tile->header->polyCount; ++PolyIndex)
+			{
+				Func(BaseRef | static_cast<dtPolyRef>(PolyIndex), *Tile, Tile->polys[PolyIndex]);
+			}
+		}
+	};
+
+	// Union-find over a dense index of the polygons. Links are followed in both directions so the result does not depend on the visiting order
+	TArray<int32> Parents;
+
+	const auto FindRoot = [&Parents](int32 Index)
+	{
+		while (Parents[Index] != Index)
+		{
+			Parents[Index] = Parents[Parents[Index]];
+			Index = Parents[Index];
+		}
+		return Index;
+	};
+
+	ForEachPoly([&](dtPolyRef PolyRef, const dtMeshTile&, const dtPoly&)
+	{
+		PolyIslands.Add(PolyRef, Parents.Add(Parents.Num()));
+	});
+
+	TArray<int32> OffMeshLinkPolys;
+
+	ForEachPoly([&](dtPolyRef PolyRef, const dtMeshTile& Tile, const dtPoly& Poly)
+	{
+		const auto Index = PolyIslands.FindChecked(PolyRef);
+
+		for (auto LinkIndex = Poly.firstLink; LinkIndex != DT_NULL_LINK; LinkIndex = DetourMesh->getLink(&Tile, LinkIndex).next)
+		{
+			if (const auto NeighbourIndex = PolyIslands.Find(DetourMesh->getLink(&Tile, LinkIndex).ref); NeighbourIndex)
+			{
+				Parents[FindRoot(Index)] = FindRoot(*NeighbourIndex);
+			}
+		}
+
+		if (Poly.getType() == DT_POLYTYPE_OFFMESH_CONNECTION)
+		{
+			OffMeshLinkPolys.Add(Index);
+		}
+	});
+
+	// Number the islands densely from their roots
+	TMap<int32, int32> RootIslands;
+
+	for (auto& PolyIsland : PolyIslands)
+	{
+		const auto Root = FindRoot(PolyIsland.Value);
+		PolyIsland.Value = RootIslands.FindOrAdd(Root, RootIslands.Num());
+	}
+
+	OffMeshLinkedIslands.Init(false, RootIslands.Num());
+
+	for (const auto Index : OffMeshLinkPolys)
+	{
+		OffMeshLinkedIslands[RootIslands.FindChecked(FindRoot(Index))] = true;
+	}
+}
+
+int32 UWanderPointSubsystem::GetIsland(NavNodeRef PolyRef) const
+{
+	const auto Island = PolyIslands.Find(PolyRef);
+	return Island ? *Island : INDEX_NONE;
+}
+
+TOptional<bool> UWanderPointSubsystem::IsReachable(int32 OriginIsland, int32 PointIsland) const
+{
+	if (OriginIsland == INDEX_NONE || PointIsland == INDEX_NONE)
+	{
+		return {};
+	}
+
+	// Islands are never connected to each other in either direction
+	if (OriginIsland != PointIsland)
+	{
+		return false;
+	}
+
+	if (OffMeshLinkedIslands[OriginIsland])
+	{
+		return {};
+	}
+
+	return true;
+}
+
+int32 UWanderPointSubsystem::RefillTiles(double BudgetSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_WanderPointSubsystem_Refill);
+
+	auto NavMesh = CachedNavMesh.Get();
+	if (!NavMesh)
+	{
+		return 0;
+	}
+
+	const auto StartTimeSeconds = FPlatformTime::Seconds();
+
+	int32 SampledCount{};
+
+	// Always refill at least one tile so that progress is made on a slow frame
+	while (RefillQueueHead < RefillQueue.Num())
+	{
+		const auto TileIndex = RefillQueue[RefillQueueHead++];
+		QueuedTiles[TileIndex] = false;
+
+		SampledCount += SampleTile(*NavMesh, TileIndex);
+
+		if (FPlatformTime::Seconds() - StartTimeSeconds > BudgetSeconds)
+		{
+			break;
+		}
+	}
+
+	// Compact once drained so the queue doesn't grow as tiles are requeued
+	if (RefillQueueHead >= RefillQueue.Num())
+	{
+		RefillQueue.Reset();
+		RefillQueueHead = 0;
+	}
+
+	Counters.Samples += SampledCount;
+	INC_DWORD_STAT_BY(STAT_WanderPointSubsystem_Samples, SampledCount);
+
+	return SampledCount;
+}
+
+int32 UWanderPointSubsystem::SampleTile(const ARecastNavMesh& NavMesh, int32 TileIndex)
+{
+	const auto MissingCount = SamplesPerTile - TileSampleCounts[TileIndex];
+	if (MissingCount <= 0)
+	{
+		return 0;
+	}
+
+	TArray<FNavPoly> Polys;
+	if (!NavMesh.GetPolysInTile(TileIndex, Polys) || Polys.IsEmpty())
+	{
+		// Empty tile slot so never refilled
+		return 0;
+	}
+
+	// Vertices of each polygon so that they can be picked by area
+	TArray<TArray<FVector>> PolyVerts;
+	TArray<double> CumulativeAreas;
+	PolyVerts.Reserve(Polys.Num());
+	CumulativeAreas.Reserve(Polys.Num());
+
+	double TotalArea{};
+
+	for (const auto& Poly : Polys)
+	{
+		auto& Verts = PolyVerts.AddDefaulted_GetRef();
+		if (!NavMesh.GetPolyVerts(Poly.Ref, Verts) || Verts.Num() < 3)
+		{
+			Verts.Reset();
+		}
+
+		TotalArea += Verts.IsEmpty() ? 0.0 : ConvexPolygonArea(Verts);
+		CumulativeAreas.Add(TotalArea);
+	}
+
+	if (TotalArea <= 0)
+	{
+		return 0;
+	}
+
+	int32 SampledCount{};
+
+	for (int32 i = 0; i < MissingCount; ++i)
+	{
+		const auto PolyIndex = FMath::Min(Algo::LowerBound(CumulativeAreas, Rng.FRand() * TotalArea), Polys.Num() - 1);
+		const auto& Verts = PolyVerts[PolyIndex];
+		if (Verts.IsEmpty())
+		{
+			continue;
+		}
+
+		const auto PolyArea = CumulativeAreas[PolyIndex] - (PolyIndex > 0 ? CumulativeAreas[PolyIndex - 1] : 0.0);
+		const auto Location = RandomPointInConvexPolygon(Rng, Verts, PolyArea);
+
+		const auto PointId = Points.Add(FWanderPoint
+		{
+			.Location = Location,
+			.TileIndex = TileIndex,
+			.Island = GetIsland(Polys[PolyIndex].Ref)
+		});
+
+		PointGrid.Add(PointId, Location);
+		++SampledCount;
+	}
+
+	TileSampleCounts[TileIndex] += SampledCount;
+
+	INC_DWORD_STAT_BY(STAT_WanderPointSubsystem_Available, SampledCount);
+
+	return SampledCount;
+}
+
+bool UWanderPointSubsystem::TakeReservoirPoint(const AController& Requester, const FVector& Origin, float Radius, FVector& OutLocation)
+{
+	// Timed on misses too as the time is then spent on top of the navmesh query
+	const auto StartTimeSeconds = FPlatformTime::Seconds();
+	int32 UnreachableCount{};
+
+	ON_SCOPE_EXIT
+	{
+		Counters.ReservoirSeconds += FPlatformTime::Seconds() - StartTimeSeconds;
+		Counters.Unreachable += UnreachableCount;
+
+		INC_DWORD_STAT_BY(STAT_WanderPointSubsystem_Unreachable, UnreachableCount);
+	};
+
+	auto NavigationSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	auto NavMesh = CachedNavMesh.Get();
+
+	if (!NavigationSystem || !NavMesh)
+	{
+		return false;
+	}
+
+	const auto OriginIsland = GetIsland(NavMesh->FindNearestPoly(Origin, OriginProjectExtent));
+
+	TArray<int32, TInlineAllocator<32>> Candidates;
+
+	PointGrid.ForEachInRadius(Origin, Radius, [&](int32 PointId, const FVector& Location, double)
+	{
+		if (IsReserved(Location))
+		{
+			return;
+		}
+
+		if (const auto bReachable = IsReachable(OriginIsland, Points[PointId].Island); bReachable.IsSet() && !*bReachable)
+		{
+			++UnreachableCount;
+			return;
+		}
+
+		Candidates.Add(PointId);
+	});
+
+	// Unreachable points stay in the reservoir as they may be reachable from other tanks
+	for (int32 Attempt = 0; Attempt < MaxReachabilityTests && !Candidates.IsEmpty(); ++Attempt)
+	{
+		const auto CandidateIndex = Rng.RandHelper(Candidates.Num());
+		const auto PointId = Candidates[CandidateIndex];
+		Candidates.RemoveAtSwap(CandidateIndex, 1, false);
+
+		const auto& Point = Points[PointId];
+
+		if (!IsReachable(OriginIsland, Point.Island).Get(false) && !NavigationSystem->TestPathSync(FPathFindingQuery(&Requester, *NavMesh, Origin, Point.Location)))
+		{
+			++UnreachableCount;
+			continue;
+		}
+
+		OutLocation = Point.Location;
+		RemovePoint(PointId);
+
+		return true;
+	}
+
+	return false;
+}
+
+bool UWanderPointSubsystem::QueryNavigation(const FVector& Origin, float Radius, FVector& OutLocation)
+{
+	auto NavigationSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (!ensureMsgf(NavigationSystem, TEXT("NavigationSystem unavailable!")))
+	{
+		return false;
+	}
+
+	const auto StartTimeSeconds = FPlatformTime::Seconds();
+
+	FNavLocation NavLocation;
+	const bool bFound = NavigationSystem->GetRandomReachablePointInRadius(Origin, Radius, NavLocation);
+
+	// Only time the query when the reservoir was consulted so that the saving estimate is the cost of a miss
+	if (IsEnabled())
+	{
+		++Counters.Misses;
+		Counters.QuerySeconds += FPlatformTime::Seconds() - StartTimeSeconds;
+
+		INC_DWORD_STAT(STAT_WanderPointSubsystem_Misses);
+	}
+
+	if (bFound)
+	{
+		OutLocation = NavLocation.Location;
+	}
+
+	return bFound;
+}
+
+void UWanderPointSubsystem::Reserve(const AController& Requester, const FVector& Location)
+{
+	auto World = GetWorld();
+	check(World);
+
+	ReleaseReservation(Requester);
+
+	Reservations.Add(FReservation
+	{
+		.Requester = &Requester,
+		.Location = Location,
+		.ExpireTimeSeconds = World->GetTimeSeconds() + ReservationSeconds
+	});
+}
+
+bool UWanderPointSubsystem::IsReserved(const FVector& Location) const
+{
+	const auto RadiusSq = FMath::Square(ReservationRadius);
+
+	return Reservations.ContainsByPredicate([&](const auto& Reservation)
+	{
+		return FVector::DistSquared(Reservation.Location, Location) <= RadiusSq;
+	});
+}
+
+void UWanderPointSubsystem::PruneReservations(double TimeSeconds)
+{
+	Reservations.RemoveAllSwap([TimeSeconds](const auto& Reservation)
+	{
+		return !Reservation.Requester.IsValid() || Reservation.ExpireTimeSeconds <= TimeSeconds;
+	});
+}
+
+void UWanderPointSubsystem::RemovePoint(int32 PointId)
+{
+	const auto TileIndex = Points[PointId].TileIndex;
+
+	PointGrid.Remove(PointId);
+	Points.RemoveAt(PointId);
+
+	DEC_DWORD_STAT(STAT_WanderPointSubsystem_Available);
+
+	--TileSampleCounts[TileIndex];
+
+	if (!QueuedTiles[TileIndex])
+	{
+		QueuedTiles[TileIndex] = true;
+		RefillQueue.Add(TileIndex);
+	}
+}
+
+void UWanderPointSubsystem::OnNavigationGenerationFinished(ANavigationData* NavData)
+{
+	if (NavData != CachedNavMesh.Get() && CachedNavMesh.IsValid())
+	{
+		return;
+	}
+
+	UE_LOG(LogTRAI, Log, TEXT("%s: OnNavigationGenerationFinished - NavData=%s; discarding %d point%s"),
+		*GetName(), *LoggingUtils::GetName(NavData), Points.Num(), LoggingUtils::Pluralize(Points.Num()));
+
+	// Points may no longer be on the navmesh so resample every tile
+	ResetPoints();
+	CachedNavMesh.Reset();
+}
+
+#pragma region Verification
+
+#if TR_DEBUG_ENABLED
+
+namespace
+{
+	/*
+	* Requests wander points for a number of simulated tanks spread over the navmesh of the current level and checks that every point is on the navmesh
+	* within the wander radius and that no two active reservations are within the reservation radius of each other. Run on a small test level with -nullrhi.
+	*/
+	void RunWanderPointVerification(const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World)
+		{
+			return;
+		}
+
+		auto Subsystem = World->GetSubsystem<UWanderPointSubsystem>();
+		auto NavigationSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+
+		if (!Subsystem || !NavigationSystem || !UWanderPointSubsystem::IsEnabled())
+		{
+			UE_LOG(LogTRAI, Warning, TEXT("RunWanderPointVerification: Navigation or wander points unavailable or tr.ai.wanderPoints.enabled is 0"));
+			return;
+		}
+
+		const int32 RequesterCount = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 32;
+		const int32 RoundCount = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 10;
+		const float WanderRadius = Args.Num() > 2 ? FMath::Max(100.0f, FCString::Atof(*Args[2])) : 10000.0f;
+
+		const auto SampledCount = Subsystem->RefillAll();
+		if (Subsystem->NumPoints() == 0)
+		{
+			UE_LOG(LogTRAI, Error, TEXT("RunWanderPointVerification: FAILED - No points sampled; is there a navmesh in the level?"));
+			return;
+		}
+
+		Subsystem->ResetCounters();
+
+		// Controllers are only used as reservation keys so unpossessed ones will do
+		TArray<AController*> Requesters;
+		TArray<FVector> Origins;
+
+		for (int32 i = 0; i < RequesterCount; ++i)
+		{
+			FNavLocation Origin;
+			if (!NavigationSystem->GetRandomPoint(Origin))
+			{
+				break;
+			}
+
+			FActorSpawnParameters SpawnParameters;
+			SpawnParameters.ObjectFlags |= RF_Transient;
+
+			auto Requester = World->SpawnActor<AController>(SpawnParameters);
+			if (!Requester)
+			{
+				break;
+			}
+
+			Requesters.Add(Requester);
+			Origins.Add(Origin.Location);
+		}
+
+		const auto ProjectExtent = FVector(50.0, 50.0, 250.0);
+		const auto ReservationRadiusSq = FMath::Square(Subsystem->GetReservationRadius());
+
+		int32 Failures{};
+		int32 Found{};
+
+		for (int32 Round = 0; Round < RoundCount; ++Round)
+		{
+			TArray<FVector> ReservoirDestinations;
+
+			for (int32 i = 0; i < Requesters.Num(); ++i)
+			{
+				const auto PreviousHits = Subsystem->GetCounters().Hits;
+
+				FVector Location;
+				if (!Subsystem->FindWanderPoint(*Requesters[i], Origins[i], WanderRadius, Location))
+				{
+					continue;
+				}
+
+				++Found;
+
+				if (FVector::Dist(Location, Origins[i]) > WanderRadius + ProjectExtent.Z)
+				{
+					++Failures;
+					UE_LOG(LogTRAI, Error, TEXT("RunWanderPointVerification: %s outside radius %.1fm of %s"),
+						*Location.ToCompactString(), WanderRadius / 100, *Origins[i].ToCompactString());
+				}
+
+				FNavLocation Projected;
+				if (!NavigationSystem->ProjectPointToNavigation(Location, Projected, ProjectExtent))
+				{
+					++Failures;
+					UE_LOG(LogTRAI, Error, TEXT("RunWanderPointVerification: %s is not on the navmesh"), *Location.ToCompactString());
+				}
+
+				// Fallback queries don't check reservations so only reservoir points are held to the spacing
+				const bool bFromReservoir = Subsystem->GetCounters().Hits > PreviousHits;
+				if (bFromReservoir && ReservoirDestinations.ContainsByPredicate([&](const FVector& Other) { return FVector::DistSquared(Other, Location) < ReservationRadiusSq; }))
+				{
+					++Failures;
+					UE_LOG(LogTRAI, Error, TEXT("RunWanderPointVerification: %s handed out within the reservation radius of another tank"), *Location.ToCompactString());
+				}
+
+				if (bFromReservoir)
+				{
+					ReservoirDestinations.Add(Location);
+				}
+
+				// Tanks arrive at their destinations and wander from there next round
+				Origins[i] = Location;
+			}
+
+			Subsystem->RefillAll();
+		}
+
+		for (auto Requester : Requesters)
+		{
+			Subsystem->ReleaseReservation(*Requester);
+			Requester->Destroy();
+		}
+
+		const auto& Counters = Subsystem->GetCounters();
+
+		UE_LOG(LogTRAI, Display,
+			TEXT("RunWanderPointVerification: %s - Requesters=%d; Rounds=%d; Found=%d; Hits=%d; Misses=%d; HitRate=%.1f%%; AvgQuery=%.3fms; Saved=%.3fms; Sampled=%d; Failures=%d"),
+			Failures == 0 ? TEXT("PASSED") : TEXT("FAILED"), Requesters.Num(), RoundCount, Found, Counters.Hits, Counters.Misses, Counters.GetHitRate() * 100,
+			Counters.GetAverageQuerySeconds() * 1000, Counters.GetSavedQuerySeconds() * 1000, SampledCount + Counters.Samples, Failures);
+	}
+
+	FAutoConsoleCommandWithWorldAndArgs WanderPointVerifyCommand(
+		TEXT("tr.ai.wanderPoints.verify"),
+		TEXT("Checks wander points handed out on the navmesh of the current level, e.g. a small test level with -nullrhi: [RequesterCount=32] [Rounds=10] [WanderRadius=10000]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunWanderPointVerification));
+}
+
+#endif
+
+#pragma endregion Verification
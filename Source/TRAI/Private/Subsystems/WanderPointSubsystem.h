@@ -0,0 +1,206 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AI/Navigation/NavigationTypes.h"
+
+#include "Containers/SpatialHashGrid.h"
+
+#include "WanderPointSubsystem.generated.h"
+
+class AController;
+class ANavigationData;
+class ARecastNavMesh;
+
+struct FWanderPointCounters
+{
+	/* Requests answered from the reservoir. */
+	int32 Hits{};
+
+	/* Requests that needed a navmesh query because there was no free point near the requester. */
+	int32 Misses{};
+
+	/* Points sampled into the reservoir. */
+	int32 Samples{};
+
+	/* Reservoir points skipped because there was no path to them from the requester, e.g. on another navmesh island. */
+	int32 Unreachable{};
+
+	/* Time spent in the navmesh query on misses. */
+	double QuerySeconds{};
+
+	/* Time spent looking up the reservoir on hits and misses, including any path tests. Refilling is not included. */
+	double ReservoirSeconds{};
+
+	float GetHitRate() const;
+	double GetAverageQuerySeconds() const;
+
+	/*
+	* Estimated time saved by answering hits from the reservoir instead of the navmesh query, less the time spent looking up the reservoir.
+	*/
+	double GetSavedQuerySeconds() const;
+};
+
+/**
+ * Reservoir of navigable wander destinations shared by all AI in the world so that idle tanks don't each run a navmesh query whenever they wander.
+ * A few points are sampled on the polygons of each navmesh tile and handed out at random to requesters within their wander radius. Each point is
+ * only handed out once and reserved to its requester so that two tanks don't wander to the same spot. Tiles are refilled a slice at a time each frame.
+ * The reservoir covers every navmesh island so each point is tagged with its island when sampled. Points on the island of the requester are handed
+ * out without a path test and points on other islands are skipped. A path test is still needed when the island joins others by off-mesh links,
+ * which may be one way, or when the requester is on a polygon added since the islands were found.
+ *
+ * Requests with no free point nearby fall back to <c>UNavigationSystemV1::GetRandomReachablePointInRadius</c>.
+ * Disabling <c>tr.ai.wanderPoints.enabled</c> always runs the navmesh query.
+ */
+UCLASS()
+class UWanderPointSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/*
+	* Finds a wander destination within <c>Radius</c> of <c>Origin</c> and reserves it to <c>Requester</c>, releasing its previous reservation.
+	*/
+	bool FindWanderPoint(const AController& Requester, const FVector& Origin, float Radius, FVector& OutLocation);
+
+	void ReleaseReservation(const AController& Requester);
+
+	/*
+	* Refills empty tiles now instead of a slice per frame. Returns the number of points sampled.
+	*/
+	int32 RefillAll();
+
+	const FWanderPointCounters& GetCounters() const;
+	void ResetCounters();
+
+	int32 NumPoints() const;
+	int32 NumReservations() const;
+	float GetReservationRadius() const;
+
+	static bool IsEnabled();
+
+protected:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+
+	virtual TStatId GetStatId() const override;
+
+	virtual void Deinitialize() override;
+
+private:
+	struct FWanderPoint
+	{
+		FVector Location;
+		int32 TileIndex;
+		int32 Island;
+	};
+
+	struct FReservation
+	{
+		TWeakObjectPtr<const AController> Requester;
+		FVector Location;
+		double ExpireTimeSeconds;
+	};
+
+	ARecastNavMesh* GetNavMesh() const;
+
+	/*
+	* Rebuilds the tile list when the navmesh changes. Returns false if there is no navmesh yet.
+	*/
+	bool EnsureTiles();
+	void ResetPoints();
+
+	/*
+	* Labels each polygon with the navmesh island it is on, i.e. the polygons connected to it by links in either direction.
+	*/
+	void BuildIslands(const ARecastNavMesh& NavMesh);
+	int32 GetIsland(NavNodeRef PolyRef) const;
+
+	/*
+	* Whether there is a path from <c>OriginIsland</c> to <c>PointIsland</c> without a path test. Unset when a path test is needed.
+	*/
+	TOptional<bool> IsReachable(int32 OriginIsland, int32 PointIsland) const;
+
+	int32 RefillTiles(double BudgetSeconds);
+	int32 SampleTile(const ARecastNavMesh& NavMesh, int32 TileIndex);
+
+	bool TakeReservoirPoint(const AController& Requester, const FVector& Origin, float Radius, FVector& OutLocation);
+	bool QueryNavigation(const FVector& Origin, float Radius, FVector& OutLocation);
+
+	void Reserve(const AController& Requester, const FVector& Location);
+	bool IsReserved(const FVector& Location) const;
+	void PruneReservations(double TimeSeconds);
+
+	void RemovePoint(int32 PointId);
+
+	UFUNCTION()
+	void OnNavigationGenerationFinished(ANavigationData* NavData);
+
+private:
+	TSparseArray<FWanderPoint> Points{};
+	TR::TSpatialHashGrid<int32> PointGrid{};
+
+	/* Points currently in the reservoir for each tile. */
+	TArray<int32> TileSampleCounts{};
+
+	/* Tiles below their sample target waiting to be refilled in order. */
+	TArray<int32> RefillQueue{};
+	TBitArray<> QueuedTiles{};
+	int32 RefillQueueHead{};
+
+	TArray<FReservation> Reservations{};
+
+	TMap<NavNodeRef, int32> PolyIslands{};
+
+	/* Islands joined to others by off-mesh links, which may only be traversable one way. */
+	TBitArray<> OffMeshLinkedIslands{};
+
+	TWeakObjectPtr<ARecastNavMesh> CachedNavMesh{};
+
+	FRandomStream Rng{};
+
+	FWanderPointCounters Counters{};
+};
+
+#pragma region Inline Definitions
+
+inline float FWanderPointCounters::GetHitRate() const
+{
+	const auto Total = Hits + Misses;
+	return Total > 0 ? static_cast<float>(Hits) / Total : 0.0f;
+}
+
+inline double FWanderPointCounters::GetAverageQuerySeconds() const
+{
+	return Misses > 0 ? QuerySeconds / Misses : 0.0;
+}
+
+inline double FWanderPointCounters::GetSavedQuerySeconds() const
+{
+	return Hits * GetAverageQuerySeconds() - ReservoirSeconds;
+}
+
+inline const FWanderPointCounters& UWanderPointSubsystem::GetCounters() const
+{
+	return Counters;
+}
+
+inline void UWanderPointSubsystem::ResetCounters()
+{
+	Counters = {};
+}
+
+inline int32 UWanderPointSubsystem::NumPoints() const
+{
+	return Points.Num();
+}
+
+inline int32 UWanderPointSubsystem::NumReservations() const
+{
+	return Reservations.Num();
+}
+
+#pragma endregion Inline Definitions
@@ -11,3 +11,6 @@
 #else
 	DECLARE_LOG_CATEGORY_EXTERN(LogTRAI, Display, All);
 #endif
+
+// Stat groups
+DECLARE_STATS_GROUP(TEXT("TRAI"), STATGROUP_TRAI, STATCAT_Advanced);
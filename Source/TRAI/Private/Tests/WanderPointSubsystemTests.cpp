@@ -0,0 +1,191 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/WanderPointSubsystem.h"
+
+#include "GameFramework/Controller.h"
+#include "Misc/AutomationTest.h"
+#include "NavigationSystem.h"
+#include "Tests/AutomationCommon.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace WanderPointSubsystemTests
+{
+	/* Needs a game world with a navmesh. */
+	constexpr auto TestFlags = EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter;
+
+	constexpr TCHAR MapName[] = TEXT("/Game/Maps/Test/AITest");
+
+	/* Time to wait for the navmesh to finish building after the map loads. */
+	constexpr double NavigationBuildTimeoutSeconds = 30.0;
+
+	constexpr int32 RequesterCount = 8;
+	constexpr int32 RoundCount = 5;
+	constexpr float WanderRadius = 10000.0f;
+}
+
+DEFINE_LATENT_AUTOMATION_COMMAND_TWO_PARAMETER(FCheckWanderPointReservoirCommand, FAutomationTestBase*, Test, double, StartTimeSeconds);
+
+bool FCheckWanderPointReservoirCommand::Update()
+{
+	using namespace WanderPointSubsystemTests;
+
+	auto World = AutomationCommon::GetAnyGameWorld();
+	if (!World)
+	{
+		Test->AddError(FString::Printf(TEXT("No game world after opening %s"), MapName));
+		return true;
+	}
+
+	auto NavigationSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+	if (!NavigationSystem)
+	{
+		Test->AddError(TEXT("No navigation system"));
+		return true;
+	}
+
+	if (NavigationSystem->IsNavigationBuildInProgress())
+	{
+		if (FPlatformTime::Seconds() - StartTimeSeconds < NavigationBuildTimeoutSeconds)
+		{
+			return false;
+		}
+
+		Test->AddError(FString::Printf(TEXT("Navigation still building after %.0fs"), NavigationBuildTimeoutSeconds));
+		return true;
+	}
+
+	auto Subsystem = World->GetSubsystem<UWanderPointSubsystem>();
+	if (!Test->TestNotNull(TEXT("Subsystem"), Subsystem))
+	{
+		return true;
+	}
+
+	if (!UWanderPointSubsystem::IsEnabled())
+	{
+		Test->AddInfo(TEXT("tr.ai.wanderPoints.enabled is 0 so there is no reservoir"));
+		return true;
+	}
+
+	auto NavData = NavigationSystem->GetDefaultNavDataInstance();
+	if (!Test->TestNotNull(TEXT("NavData"), NavData))
+	{
+		return true;
+	}
+
+	Subsystem->RefillAll();
+	if (!Test->TestTrue(TEXT("Points sampled"), Subsystem->NumPoints() > 0))
+	{
+		return true;
+	}
+
+	Subsystem->ResetCounters();
+
+	// Controllers are only used as reservation keys and path query owners so unpossessed ones will do
+	TArray<AController*> Requesters;
+	TArray<FVector> Origins;
+
+	for (int32 i = 0; i < RequesterCount; ++i)
+	{
+		FNavLocation Origin;
+		if (!NavigationSystem->GetRandomPoint(Origin))
+		{
+			break;
+		}
+
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.ObjectFlags |= RF_Transient;
+
+		if (auto Requester = World->SpawnActor<AController>(SpawnParameters); Requester)
+		{
+			Requesters.Add(Requester);
+			Origins.Add(Origin.Location);
+		}
+	}
+
+	const auto ProjectExtent = FVector(50.0, 50.0, 250.0);
+	const auto ReservationRadiusSq = FMath::Square(Subsystem->GetReservationRadius());
+
+	TSet<const AController*> ReservedRequesters;
+
+	// AI already in the map may hold reservations of their own. Nothing else runs until this update returns
+	const auto InitialReservations = Subsystem->NumReservations();
+
+	for (int32 Round = 0; Round < RoundCount; ++Round)
+	{
+		TArray<FVector> ReservoirDestinations;
+
+		for (int32 i = 0; i < Requesters.Num(); ++i)
+		{
+			const auto PreviousHits = Subsystem->GetCounters().Hits;
+
+			FVector Location;
+			if (!Subsystem->FindWanderPoint(*Requesters[i], Origins[i], WanderRadius, Location))
+			{
+				continue;
+			}
+
+			ReservedRequesters.Add(Requesters[i]);
+
+			const auto Description = FString::Printf(TEXT("Round %d requester %d: %s from %s"), Round, i, *Location.ToCompactString(), *Origins[i].ToCompactString());
+
+			Test->TestTrue(*FString::Printf(TEXT("%s within radius"), *Description), FVector::Dist(Location, Origins[i]) <= WanderRadius + ProjectExtent.Z);
+
+			FNavLocation Projected;
+			Test->TestTrue(*FString::Printf(TEXT("%s on the navmesh"), *Description), NavigationSystem->ProjectPointToNavigation(Location, Projected, ProjectExtent));
+
+			// Reservoir points cover every navmesh island so must only be handed out when there is a path
+			Test->TestTrue(*FString::Printf(TEXT("%s reachable"), *Description),
+				NavigationSystem->TestPathSync(FPathFindingQuery(Requesters[i], *NavData, Origins[i], Location)));
+
+			// Fallback queries don't check reservations so only reservoir points are held to the spacing
+			if (Subsystem->GetCounters().Hits > PreviousHits)
+			{
+				Test->TestFalse(*FString::Printf(TEXT("%s within the reservation radius of another tank"), *Description),
+					ReservoirDestinations.ContainsByPredicate([&](const FVector& Other) { return FVector::DistSquared(Other, Location) < ReservationRadiusSq; }));
+
+				ReservoirDestinations.Add(Location);
+			}
+
+			// Tanks arrive at their destinations and wander from there next round
+			Origins[i] = Location;
+		}
+
+		Subsystem->RefillAll();
+	}
+
+	Test->TestTrue(TEXT("Some requests answered from the reservoir"), Subsystem->GetCounters().Hits > 0);
+
+	// Each new request releases the previous reservation of the requester
+	Test->TestEqual(TEXT("One reservation per requester"), Subsystem->NumReservations() - InitialReservations, ReservedRequesters.Num());
+
+	for (auto Requester : Requesters)
+	{
+		Subsystem->ReleaseReservation(*Requester);
+		Requester->Destroy();
+	}
+
+	Test->TestEqual(TEXT("Reservations after release"), Subsystem->NumReservations(), InitialReservations);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWanderPointSubsystemReservoirTest, "TankRampage.TRAI.WanderPointSubsystem.Reservoir", WanderPointSubsystemTests::TestFlags)
+
+bool FWanderPointSubsystemReservoirTest::RunTest(const FString& Parameters)
+{
+	using namespace WanderPointSubsystemTests;
+
+	if (!TestTrue(*FString::Printf(TEXT("Open %s"), MapName), AutomationOpenMap(MapName)))
+	{
+		return true;
+	}
+
+	ADD_LATENT_AUTOMATION_COMMAND(FWaitForMapToLoadCommand());
+	ADD_LATENT_AUTOMATION_COMMAND(FCheckWanderPointReservoirCommand(this, FPlatformTime::Seconds()));
+
+	return true;
+}
+
+#endif
@@ -12,6 +12,8 @@ class UCurveFloat;
 class UHealthComponent;
 class UTankAISharedStateSubsystem;
 
+enum class ETankAIUpdateBucket : uint8;
+
 /**
  * 
  */
@@ -37,8 +39,10 @@ public:
 protected:
 	virtual void OnPossess(APawn* InPawn) override;
 	virtual void OnUnPossess() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 private:
+	friend class UTankAISchedulerSubsystem;
 
 	struct FTankAIContext
 	{
@@ -66,6 +70,9 @@ private:
 
 	void InitReportedPositionReactTimeIfApplicable(const FTankAIContext& AIContext);
 	void ExecuteAI();
+	void ExecuteAI(const FTankAIContext& AIContext);
+
+	ETankAIUpdateBucket GetUpdateBucket(float DistSqToPlayer) const;
 
 	UFUNCTION()
 	void OnHealthChanged(UHealthComponent* HealthComponent, float PreviousHealthValue, float PreviousMaxHealthValue, AController* EventInstigator, AActor* ChangeCauser);
@@ -124,6 +131,10 @@ private:
 	UPROPERTY(EditDefaultsOnly)
 	float WanderRadius{ 10000.0f };
 
+	/* Tanks further than this multiple of the aggro distance from the player are updated at the lowest rate by the AI scheduler. */
+	UPROPERTY(EditDefaultsOnly)
+	float FarUpdateAggroDistanceMultiplier{ 2.0f };
+
 	UPROPERTY(EditDefaultsOnly)
 	float WanderCooldownSeconds{ 3.0f };
 
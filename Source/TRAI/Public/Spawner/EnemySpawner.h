@@ -25,13 +25,21 @@ public:
 	int32 Spawn(int32 DesiredCount, const AActor* LookAtActor = nullptr, TArray<APawn*>* OutSpawned = nullptr);
 
 	int32 GetMaxSpawnCount() const;
-	bool CanSpawnAnyFor(const APawn& PlayerPawn, float* OutScore = nullptr) const;
+
+	/*
+	* Given <c>bOutRequiresFOVTrace</c> the field of view line trace is skipped when the spawner is within the view cone of the player and
+	* <c>bOutRequiresFOVTrace</c> is set. The result is then false only if the spawner cannot spawn whether or not it is visible and <c>OutScore</c>
+	* is the best score it could have, so call again without <c>bOutRequiresFOVTrace</c> for the exact result.
+	*/
+	bool CanSpawnAnyFor(const APawn& PlayerPawn, float* OutScore = nullptr, bool* bOutRequiresFOVTrace = nullptr) const;
 
 	/*
 	* First-level quick check based on max distance
 	*/
 	bool ShouldBeConsideredForSpawning(const APawn& PlayerPawn, float ConsiderationRadiusSq) const;
 
+	float GetMaxDistance() const;
+
 	bool IsCoolingDown() const;
 
 	float GetLastSpawnGameTime() const;
@@ -58,6 +66,7 @@ private:
 	UClass* SelectSpawnClass() const;
 
 	FVector GetSpawnReferenceLocation() const;
+	FVector CalculateSpawnReferenceLocation() const;
 
 	float CalculateSpawningScore(float DistanceFromPlayer, float MinDistance, bool bInFOV) const;
 
@@ -90,6 +99,9 @@ private:
 
 	float LastSpawnTime{ -1.f };
 
+	/* Spawn locations don't move after they are grounded so the average is cached. */
+	TOptional<FVector> CachedSpawnReferenceLocation{};
+
 	UPROPERTY(EditAnywhere, Category = "Spawning")
 	float MinimumDistanceFOV{};
 
@@ -144,6 +156,11 @@ inline int32 AEnemySpawner::GetMaxSpawnCount() const
 	return SpawnLocations.Num();
 }
 
+inline float AEnemySpawner::GetMaxDistance() const
+{
+	return MaxDistance;
+}
+
 inline bool AEnemySpawner::IsCoolingDown() const
 {
 	return LastSpawnTime >= 0 && GetTimeSinceLastSpawn() <= CooldownTime;
@@ -40,6 +40,7 @@ public class TRAI : ModuleRules
 		{
            "AIModule",
 		   "NavigationSystem",
+		   "Navmesh",
         };
 
 		PrivateDependencyModuleNames.AddRange(enginePrivateDependencyModuleNames);
@@ -3,16 +3,34 @@
 
 #include "Components/BaseCollisionRelevanceComponent.h"
 
+#include "Components/PrimitiveComponent.h"
+#include "TRConstants.h"
+
 #include "Logging/LoggingUtils.h"
 #include "TRCoreLogging.h"
 
 #include "VisualLogger/VisualLogger.h"
 
+#if TR_DEBUG_ENABLED
+	#include "HAL/IConsoleManager.h"
+	#include "UObject/UObjectIterator.h"
+#endif
+
 #include UE_INLINE_GENERATED_CPP_BY_NAME(BaseCollisionRelevanceComponent)
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Collision Relevance Cache Hits"), STAT_CollisionRelevance_CacheHits, STATGROUP_TRCore);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Collision Relevance Cache Misses"), STAT_CollisionRelevance_CacheMisses, STATGROUP_TRCore);
+
 namespace
 {
-	bool MatchesByName(const TArray<FString>& Array, const FString& InputName);
+	/* Relevance components that cached a verdict for each hit component so that the verdicts can be removed when it is unregistered. */
+	TMap<const UActorComponent*, TArray<TWeakObjectPtr<UBaseCollisionRelevanceComponent>, TInlineAllocator<2>>> CachingComponentsByHitComponent;
+
+	FDelegateHandle GlobalDestroyPhysicsHandle;
+
+#if TR_DEBUG_ENABLED
+	void RecordHit(const FHitResult& Hit);
+#endif
 }
 
 UBaseCollisionRelevanceComponent::UBaseCollisionRelevanceComponent()
@@ -26,9 +44,26 @@ void UBaseCollisionRelevanceComponent::BeginPlay()
 
 	bMatchTrueCondition = !bNotifyAllButSpecified;
 
+	// Compiled once so that hits never scan the substrings
+	ActorMatcher.Compile(ActorSubstrings);
+	ComponentMatcher.Compile(ComponentSubstrings);
+
+	// Physics state is always destroyed when a component is unregistered
+	if (!GlobalDestroyPhysicsHandle.IsValid())
+	{
+		GlobalDestroyPhysicsHandle = UActorComponent::GlobalDestroyPhysicsDelegate.AddStatic(&ThisClass::InvalidateCachedVerdicts);
+	}
+
 	RegisterCollisions();
 }
 
+void UBaseCollisionRelevanceComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	ClearCachedVerdicts();
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void UBaseCollisionRelevanceComponent::OnActorHit(AActor* SelfActor, AActor* OtherActor, FVector NormalImpulse, const FHitResult& Hit)
 {
 	const bool bIsRelevant = IsRelevantCollision(Hit);
@@ -78,22 +113,59 @@ void UBaseCollisionRelevanceComponent::RegisterComponent(UPrimitiveComponent* Co
 	Component->OnComponentHit.AddUniqueDynamic(this, &ThisClass::OnComponentHit);
 }
 
-bool UBaseCollisionRelevanceComponent::IsRelevantCollision(const FHitResult& Hit) const
+bool UBaseCollisionRelevanceComponent::IsRelevantCollision(const FHitResult& Hit)
 {
+#if TR_DEBUG_ENABLED
+	RecordHit(Hit);
+#endif
+
 	const auto OtherComponent = Hit.GetComponent();
 	const auto Actor = Hit.GetActor();
 
+	if (!OtherComponent)
+	{
+		return EvaluateRelevance(nullptr, Actor);
+	}
+
+	// Object type can change without re-registering, e.g. when the collision profile is changed
+	const auto ObjectType = OtherComponent->GetCollisionObjectType();
+
+	if (const auto Cached = VerdictCache.Find(OtherComponent); Cached && Cached->ObjectType == ObjectType && Cached->Actor == Actor)
+	{
+		INC_DWORD_STAT(STAT_CollisionRelevance_CacheHits);
+		return Cached->bRelevant;
+	}
+
+	INC_DWORD_STAT(STAT_CollisionRelevance_CacheMisses);
+
+	const bool bRelevant = EvaluateRelevance(OtherComponent, Actor);
+
+	VerdictCache.Add(OtherComponent, FCachedVerdict
+	{
+		.Actor = Actor,
+		.ObjectType = ObjectType,
+		.bRelevant = bRelevant
+	});
+
+	CachingComponentsByHitComponent.FindOrAdd(OtherComponent).AddUnique(this);
+
+	return bRelevant;
+}
+
+bool UBaseCollisionRelevanceComponent::EvaluateRelevance(const UPrimitiveComponent* OtherComponent, const AActor* Actor) const
+{
 	if (OtherComponent && ObjectTypes.Contains(OtherComponent->GetCollisionObjectType()))
 	{
 		return bMatchTrueCondition;
 	}
 
-	if (OtherComponent && MatchesByName(ComponentSubstrings, OtherComponent->GetName()))
+	// Match against the name builders to avoid allocating the names
+	if (OtherComponent && !ComponentMatcher.IsEmpty() && ComponentMatcher.Matches(FNameBuilder(OtherComponent->GetFName()).ToView()))
 	{
 		return bMatchTrueCondition;
 	}
 
-	if (Actor && MatchesByName(ActorSubstrings, Actor->GetName()))
+	if (Actor && !ActorMatcher.IsEmpty() && ActorMatcher.Matches(FNameBuilder(Actor->GetFName()).ToView()))
 	{
 		return bMatchTrueCondition;
 	}
@@ -101,13 +173,207 @@ bool UBaseCollisionRelevanceComponent::IsRelevantCollision(const FHitResult& Hit
 	return !bMatchTrueCondition;
 }
 
+void UBaseCollisionRelevanceComponent::ClearCachedVerdicts()
+{
+	for (const auto& [WeakComponent, _] : VerdictCache)
+	{
+		auto Component = WeakComponent.GetEvenIfUnreachable();
+
+		if (auto CachingComponents = CachingComponentsByHitComponent.Find(Component); CachingComponents)
+		{
+			CachingComponents->RemoveSwap(this);
+
+			if (CachingComponents->IsEmpty())
+			{
+				CachingComponentsByHitComponent.Remove(Component);
+			}
+		}
+	}
+
+	VerdictCache.Reset();
+}
+
+void UBaseCollisionRelevanceComponent::InvalidateCachedVerdicts(UActorComponent* Component)
+{
+	const auto CachingComponents = CachingComponentsByHitComponent.Find(Component);
+	if (!CachingComponents)
+	{
+		return;
+	}
+
+	const TWeakObjectPtr<const UPrimitiveComponent> Key = Cast<UPrimitiveComponent>(Component);
+
+	for (const auto& WeakCachingComponent : *CachingComponents)
+	{
+		if (auto CachingComponent = WeakCachingComponent.Get(); CachingComponent)
+		{
+			CachingComponent->VerdictCache.Remove(Key);
+		}
+	}
+
+	CachingComponentsByHitComponent.Remove(Component);
+}
+
+#pragma region Benchmark
+
+#if TR_DEBUG_ENABLED
+
 namespace
 {
-	inline bool MatchesByName(const TArray<FString>& Array, const FString& InputName)
+	TArray<FHitResult> RecordedHits;
+	int32 MaxRecordedHits{};
+
+	void RecordHit(const FHitResult& Hit)
 	{
-		return Array.ContainsByPredicate([&InputName](const auto& NameSubstring)
+		if (RecordedHits.Num() < MaxRecordedHits)
 		{
-			return InputName.Contains(NameSubstring);
-		});
+			RecordedHits.Add(Hit);
+		}
+	}
+
+	void StartRecordingHits(const TArray<FString>& Args)
+	{
+		MaxRecordedHits = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 10000;
+
+		RecordedHits.Reset();
+		RecordedHits.Reserve(MaxRecordedHits);
+
+		UE_LOG(LogTRCore, Display, TEXT("StartRecordingHits: Recording up to %d hits"), MaxRecordedHits);
 	}
+
+	FAutoConsoleCommandWithArgs CollisionRelevanceRecordCommand(
+		TEXT("tr.core.collisionRelevance.record"),
+		TEXT("Records hits evaluated by collision relevance components for tr.core.collisionRelevance.benchmark, e.g. while driving into scenery: [MaxHits=10000]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&StartRecordingHits));
 }
+
+/*
+* Replays the recorded hits through every collision relevance component in the world with the previous substring scan of the allocated names
+* and with the compiled matchers both with a cold and a warm verdict cache, and checks that all verdicts agree.
+*/
+struct FCollisionRelevanceBenchmark
+{
+	static bool IsRelevantCollisionBySubstringScan(const UBaseCollisionRelevanceComponent& Relevance, const FHitResult& Hit)
+	{
+		const auto MatchesByName = [](const TArray<FString>& Array, const FString& InputName)
+		{
+			return Array.ContainsByPredicate([&InputName](const auto& NameSubstring)
+			{
+				return InputName.Contains(NameSubstring);
+			});
+		};
+
+		const auto OtherComponent = Hit.GetComponent();
+		const auto Actor = Hit.GetActor();
+
+		if (OtherComponent && Relevance.ObjectTypes.Contains(OtherComponent->GetCollisionObjectType()))
+		{
+			return Relevance.bMatchTrueCondition;
+		}
+
+		if (OtherComponent && MatchesByName(Relevance.ComponentSubstrings, OtherComponent->GetName()))
+		{
+			return Relevance.bMatchTrueCondition;
+		}
+
+		if (Actor && MatchesByName(Relevance.ActorSubstrings, Actor->GetName()))
+		{
+			return Relevance.bMatchTrueCondition;
+		}
+
+		return !Relevance.bMatchTrueCondition;
+	}
+
+	static void Run(const TArray<FString>& Args, UWorld* World)
+	{
+		// Stop recording so the replay does not record itself
+		MaxRecordedHits = 0;
+
+		if (!World || RecordedHits.IsEmpty())
+		{
+			UE_LOG(LogTRCore, Warning, TEXT("FCollisionRelevanceBenchmark: No hits recorded - run tr.core.collisionRelevance.record first"));
+			return;
+		}
+
+		const int32 RepeatCount = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 10;
+
+		TArray<UBaseCollisionRelevanceComponent*> RelevanceComponents;
+		for (TObjectIterator<UBaseCollisionRelevanceComponent> It; It; ++It)
+		{
+			if (It->GetWorld() == World && It->HasBegunPlay())
+			{
+				RelevanceComponents.Add(*It);
+			}
+		}
+
+		double ScanSeconds{}, ColdSeconds{}, WarmSeconds{};
+		int32 Evaluations{};
+		int32 Mismatches{};
+
+		for (auto Relevance : RelevanceComponents)
+		{
+			TArray<bool> Expected;
+			Expected.Reserve(RecordedHits.Num());
+
+			auto StartTime = FPlatformTime::Seconds();
+			for (int32 Repeat = 0; Repeat < RepeatCount; ++Repeat)
+			{
+				for (const auto& Hit : RecordedHits)
+				{
+					const bool bRelevant = IsRelevantCollisionBySubstringScan(*Relevance, Hit);
+					if (Repeat == 0)
+					{
+						Expected.Add(bRelevant);
+					}
+				}
+			}
+			ScanSeconds += FPlatformTime::Seconds() - StartTime;
+
+			// Cold cache evaluates each hit once after clearing so that every lookup misses
+			StartTime = FPlatformTime::Seconds();
+			for (int32 Repeat = 0; Repeat < RepeatCount; ++Repeat)
+			{
+				for (const auto& Hit : RecordedHits)
+				{
+					Relevance->ClearCachedVerdicts();
+					Relevance->IsRelevantCollision(Hit);
+				}
+			}
+			ColdSeconds += FPlatformTime::Seconds() - StartTime;
+
+			StartTime = FPlatformTime::Seconds();
+			for (int32 Repeat = 0; Repeat < RepeatCount; ++Repeat)
+			{
+				for (int32 i = 0; i < RecordedHits.Num(); ++i)
+				{
+					if (Relevance->IsRelevantCollision(RecordedHits[i]) != Expected[i])
+					{
+						++Mismatches;
+					}
+				}
+			}
+			WarmSeconds += FPlatformTime::Seconds() - StartTime;
+
+			Evaluations += RecordedHits.Num() * RepeatCount;
+		}
+
+		const auto PerHitNs = [Evaluations](double Seconds) { return Seconds * 1e9 / FMath::Max(1, Evaluations); };
+
+		UE_LOG(LogTRCore, Display,
+			TEXT("FCollisionRelevanceBenchmark: %s - Hits=%d; Components=%d; Repeats=%d - SubstringScan=%.1fns/hit; CompiledCold=%.1fns/hit; CompiledCached=%.1fns/hit; Mismatches=%d"),
+			Mismatches == 0 ? TEXT("PASSED") : TEXT("FAILED"), RecordedHits.Num(), RelevanceComponents.Num(), RepeatCount,
+			PerHitNs(ScanSeconds), PerHitNs(ColdSeconds), PerHitNs(WarmSeconds), Mismatches);
+	}
+};
+
+namespace
+{
+	FAutoConsoleCommandWithWorldAndArgs CollisionRelevanceBenchmarkCommand(
+		TEXT("tr.core.collisionRelevance.benchmark"),
+		TEXT("Replays hits recorded with tr.core.collisionRelevance.record through the substring scan and the compiled matchers: [RepeatCount=10]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&FCollisionRelevanceBenchmark::Run));
+}
+
+#endif
+
+#pragma endregion Benchmark
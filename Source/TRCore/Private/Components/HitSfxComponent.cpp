@@ -3,9 +3,8 @@
 
 #include "Components/HitSfxComponent.h"
 
-#include "Kismet/GameplayStatics.h"
+#include "Subsystems/AudioDispatchSubsystem.h"
 
-#include "Components/AudioComponent.h"
 #include "TRCoreLogging.h"
 #include "Logging/LoggingUtils.h"
 #include "VisualLogger/VisualLogger.h"
@@ -126,30 +125,28 @@ void UHitSfxComponent::OnNotifyRelevantCollision(UPrimitiveComponent* HitCompone
 		return;
 	}
 
-	auto SpawnedAudioComponent = UGameplayStatics::SpawnSoundAtLocation(
-		GetOwner(),
-		HitSfx,
-		Hit.Location, NormalImpulse.Rotation(),
-		Volume
-	);
-
-	if (!SpawnedAudioComponent)
+	auto AudioDispatchSubsystem = World->GetSubsystem<UAudioDispatchSubsystem>();
+	if (!ensure(AudioDispatchSubsystem))
 	{
-		// This is not an error condition as the component may not spawn if the sound is not audible,
-		// for example it attenuates below a threshold based on distance or is filtered by sound concurrency
-		UE_VLOG_UELOG(GetOwner(), LogTRCore, Log,
-			TEXT("%s-%s: OnNotifyRelevantCollision - Unable to spawn audio component for sfx=%s; volume=%.3f"),
-			*LoggingUtils::GetName(GetOwner()), *GetName(), *LoggingUtils::GetName(HitSfx), Volume);
 		return;
 	}
 
+	// Hits from a pileup in the same place are merged into one voice at the end of the frame
+	AudioDispatchSubsystem->PlaySfx(FOneShotSfxRequest
+	{
+		.Sound = HitSfx,
+		.Owner = GetOwner(),
+		.Location = Hit.Location,
+		.Rotation = NormalImpulse.Rotation(),
+		.Volume = Volume,
+		.Category = ESfxCategory::Impact,
+		.bReverb = true
+	});
+
 	UE_VLOG_UELOG(GetOwner(), LogTRCore, Log,
-		TEXT("%s-%s: OnNotifyRelevantCollision -  Playing sfx=%s at volume=%.3f"),
+		TEXT("%s-%s: OnNotifyRelevantCollision - Queued sfx=%s at volume=%.3f"),
 		*LoggingUtils::GetName(GetOwner()), *GetName(), *HitSfx->GetName(), Volume);
 
-	SpawnedAudioComponent->bAutoDestroy = true;
-	SpawnedAudioComponent->bReverb = true;
-
 	LastPlayTimeSeconds = TimeSeconds;
 
 	OnPlaySfx();
@@ -0,0 +1,252 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Containers/IndexedMinHeap.h"
+
+#include "TRCoreLogging.h"
+
+#if TR_DEBUG_ENABLED
+	#include "HAL/IConsoleManager.h"
+	#include "Utils/RandUtils.h"
+#endif
+
+#pragma region Verification
+
+#if TR_DEBUG_ENABLED
+
+using namespace TR;
+
+namespace
+{
+	using FExpiryHeap = TIndexedMinHeap<int32, float>;
+
+	/*
+	* Checks that the heap order holds and that the heap agrees with the reference expiries.
+	*/
+	int32 CheckHeap(const TCHAR* Label, const FExpiryHeap& Heap, const TMap<int32, float>& Reference)
+	{
+		int32 Failures{};
+
+		if (Heap.Num() != Reference.Num())
+		{
+			++Failures;
+			UE_LOG(LogTRCore, Error, TEXT("RunIndexedMinHeapVerification: %s - Num=%d; Expected=%d"), Label, Heap.Num(), Reference.Num());
+		}
+
+		for (const auto& [Key, Expiry] : Reference)
+		{
+			const auto Priority = Heap.FindPriority(Key);
+			if (!Priority || *Priority != Expiry)
+			{
+				++Failures;
+				UE_LOG(LogTRCore, Error, TEXT("RunIndexedMinHeapVerification: %s - Key=%d; Priority=%f; Expected=%f"),
+					Label, Key, Priority ? *Priority : -1.0f, Expiry);
+			}
+		}
+
+		if (!Heap.IsEmpty())
+		{
+			float MinExpiry = TNumericLimits<float>::Max();
+			for (const auto& [_, Expiry] : Reference)
+			{
+				MinExpiry = FMath::Min(MinExpiry, Expiry);
+			}
+
+			if (Heap.TopPriority() != MinExpiry)
+			{
+				++Failures;
+				UE_LOG(LogTRCore, Error, TEXT("RunIndexedMinHeapVerification: %s - TopPriority=%f; Expected=%f"), Label, Heap.TopPriority(), MinExpiry);
+			}
+		}
+
+		return Failures;
+	}
+
+	/*
+	* Simulates overlapping EMP activations the way UEMPWeapon tracks stun expiries: each activation stuns a random set of actors, re-hit actors have
+	* their expiry extended in place and expired actors are popped in expiry order. Checked against a reference map after every step along with
+	* random removals for actors destroyed while stunned.
+	*/
+	void RunIndexedMinHeapVerification(const TArray<FString>& Args)
+	{
+		const int32 ActivationCount = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 1000;
+		const int32 ActorCount = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 200;
+
+		constexpr float EffectDuration = 5.0f;
+
+		FRandomStream Rng(RandUtils::GenerateSeed());
+
+		FExpiryHeap Heap;
+		TMap<int32, float> Reference;
+
+		float TimeSeconds{};
+		int32 Failures{};
+		int32 ReHitCount{};
+		int32 ExpiredCount{};
+
+		for (int32 Activation = 0; Activation < ActivationCount && Failures == 0; ++Activation)
+		{
+			// Activations overlap as they come in faster than the effect duration
+			TimeSeconds += Rng.FRandRange(0.0f, EffectDuration * 0.5f);
+
+			// Pop everything that expired before this activation in expiry order
+			float LastExpiry = TNumericLimits<float>::Lowest();
+			while (!Heap.IsEmpty() && Heap.TopPriority() <= TimeSeconds)
+			{
+				const auto Expiry = Heap.TopPriority();
+				const auto Key = Heap.Pop();
+
+				if (Expiry < LastExpiry || Reference.FindRef(Key) != Expiry)
+				{
+					++Failures;
+					UE_LOG(LogTRCore, Error, TEXT("RunIndexedMinHeapVerification: Popped Key=%d; Expiry=%f out of order after %f"), Key, Expiry, LastExpiry);
+				}
+
+				LastExpiry = Expiry;
+				Reference.Remove(Key);
+				++ExpiredCount;
+			}
+
+			Failures += CheckHeap(TEXT("Expire"), Heap, Reference);
+
+			// Durations vary a little so that extending an expiry can move it both up and down relative to other actors
+			const auto HitCount = Rng.RandRange(1, FMath::Max(1, ActorCount / 4));
+			for (int32 i = 0; i < HitCount; ++i)
+			{
+				const auto Key = Rng.RandHelper(ActorCount);
+				const auto Expiry = TimeSeconds + EffectDuration * Rng.FRandRange(0.5f, 1.5f);
+
+				const bool bAdded = Heap.AddOrUpdate(Key, Expiry);
+				const bool bExpectedAdded = !Reference.Contains(Key);
+
+				if (bAdded != bExpectedAdded)
+				{
+					++Failures;
+					UE_LOG(LogTRCore, Error, TEXT("RunIndexedMinHeapVerification: AddOrUpdate Key=%d returned %s"), Key, bAdded ? TEXT("added") : TEXT("updated"));
+				}
+
+				ReHitCount += !bExpectedAdded;
+				Reference.Add(Key, Expiry);
+			}
+
+			Failures += CheckHeap(TEXT("Hit"), Heap, Reference);
+
+			// Actors destroyed while stunned
+			if (!Reference.IsEmpty() && Rng.RandHelper(4) == 0)
+			{
+				TArray<int32> Keys;
+				Reference.GenerateKeyArray(Keys);
+
+				const auto Key = Keys[Rng.RandHelper(Keys.Num())];
+				if (!Heap.Remove(Key))
+				{
+					++Failures;
+					UE_LOG(LogTRCore, Error, TEXT("RunIndexedMinHeapVerification: Remove Key=%d failed"), Key);
+				}
+				Reference.Remove(Key);
+
+				Failures += CheckHeap(TEXT("Remove"), Heap, Reference);
+			}
+		}
+
+		UE_LOG(LogTRCore, Display, TEXT("RunIndexedMinHeapVerification: %s - Activations=%d; Actors=%d; ReHits=%d; Expired=%d; Failures=%d"),
+			Failures == 0 ? TEXT("PASSED") : TEXT("FAILED"), ActivationCount, ActorCount, ReHitCount, ExpiredCount, Failures);
+	}
+
+	FAutoConsoleCommandWithArgs IndexedMinHeapVerifyCommand(
+		TEXT("tr.core.indexedMinHeap.verify"),
+		TEXT("Checks the indexed min-heap against a reference map with overlapping EMP style stuns: [ActivationCount=1000] [ActorCount=200]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunIndexedMinHeapVerification));
+}
+
+#endif
+
+#pragma endregion Verification
+
+#pragma region Benchmark
+
+#if TR_DEBUG_ENABLED
+
+namespace
+{
+	/*
+	* Times rescheduling stun expiry after every hit with the heap against the previous full scan of an expiry map for increasing numbers of stunned actors.
+	*/
+	void RunIndexedMinHeapBenchmark(const TArray<FString>& Args)
+	{
+		const int32 MaxActorCount = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 1000;
+		const int32 HitCount = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 10000;
+
+		FRandomStream Rng(RandUtils::GenerateSeed());
+
+		for (int32 ActorCount = 10; ; ActorCount = FMath::Min(ActorCount * 10, MaxActorCount))
+		{
+			TArray<int32> HitKeys;
+			TArray<float> HitExpiries;
+			HitKeys.Reserve(HitCount);
+			HitExpiries.Reserve(HitCount);
+
+			for (int32 i = 0; i < HitCount; ++i)
+			{
+				HitKeys.Add(Rng.RandHelper(ActorCount));
+				HitExpiries.Add(i * 0.001f + Rng.FRandRange(0.0f, 5.0f));
+			}
+
+			float ScanChecksum{};
+			float HeapChecksum{};
+
+			// Expiry map with a full scan for the earliest expiry on each hit
+			double ScanSeconds;
+			{
+				TMap<int32, float> Expiries;
+				Expiries.Reserve(ActorCount);
+
+				const auto StartTime = FPlatformTime::Seconds();
+				for (int32 i = 0; i < HitCount; ++i)
+				{
+					Expiries.Add(HitKeys[i], HitExpiries[i]);
+
+					float MinExpiry = TNumericLimits<float>::Max();
+					for (const auto& [_, Expiry] : Expiries)
+					{
+						MinExpiry = FMath::Min(MinExpiry, Expiry);
+					}
+					ScanChecksum += MinExpiry;
+				}
+				ScanSeconds = FPlatformTime::Seconds() - StartTime;
+			}
+
+			double HeapSeconds;
+			{
+				FExpiryHeap Heap;
+				Heap.Reserve(ActorCount);
+
+				const auto StartTime = FPlatformTime::Seconds();
+				for (int32 i = 0; i < HitCount; ++i)
+				{
+					Heap.AddOrUpdate(HitKeys[i], HitExpiries[i]);
+					HeapChecksum += Heap.TopPriority();
+				}
+				HeapSeconds = FPlatformTime::Seconds() - StartTime;
+			}
+
+			UE_LOG(LogTRCore, Display, TEXT("RunIndexedMinHeapBenchmark: Actors=%d; Hits=%d - Scan=%.3fms; Heap=%.3fms; Speedup=%.1fx; ChecksumsMatch=%s"),
+				ActorCount, HitCount, ScanSeconds * 1000, HeapSeconds * 1000, HeapSeconds > 0 ? ScanSeconds / HeapSeconds : 0.0,
+				ScanChecksum == HeapChecksum ? TEXT("true") : TEXT("false"));
+
+			if (ActorCount >= MaxActorCount)
+			{
+				break;
+			}
+		}
+	}
+
+	FAutoConsoleCommandWithArgs IndexedMinHeapBenchmarkCommand(
+		TEXT("tr.core.indexedMinHeap.benchmark"),
+		TEXT("Times stun expiry rescheduling with the indexed min-heap against scanning an expiry map for 10 up to MaxActorCount stunned actors: [MaxActorCount=1000] [HitCount=10000]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunIndexedMinHeapBenchmark));
+}
+
+#endif
+
+#pragma endregion Benchmark
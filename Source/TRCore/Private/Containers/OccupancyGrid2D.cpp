@@ -0,0 +1,127 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Containers/OccupancyGrid2D.h"
+
+#include "TRCoreLogging.h"
+
+using namespace TR;
+
+void FOccupancyGrid2D::Init(const FBox2D& InBounds, float InCellSize, int64 MaxCellCount)
+{
+	check(InCellSize > 0);
+	check(MaxCellCount > 0);
+
+	Reset();
+
+	if (!InBounds.bIsValid)
+	{
+		return;
+	}
+
+	Bounds = InBounds;
+	CellSize = InCellSize;
+
+	const auto Size = Bounds.GetSize();
+
+	// Grow the cell size until the cell count fits
+	while (true)
+	{
+		CellCountX = FMath::Max(1, FMath::CeilToInt32(Size.X / CellSize));
+		CellCountY = FMath::Max(1, FMath::CeilToInt32(Size.Y / CellSize));
+
+		if (static_cast<int64>(CellCountX) * CellCountY <= MaxCellCount)
+		{
+			break;
+		}
+
+		CellSize *= 2;
+	}
+
+	if (CellSize != InCellSize)
+	{
+		UE_LOG(LogTRCore, Warning, TEXT("FOccupancyGrid2D: Init - Bounds=%s too large for cell size %.1f; using %.1f"),
+			*Bounds.ToString(), InCellSize, CellSize);
+	}
+
+	Occupied.Init(false, CellCountX * CellCountY);
+}
+
+void FOccupancyGrid2D::Reset()
+{
+	Bounds = FBox2D{ EForceInit::ForceInit };
+	CellCountX = CellCountY = 0;
+	Occupied.Empty();
+}
+
+bool FOccupancyGrid2D::IsFree(const FBox2D& Box) const
+{
+	FIntPoint Min, Max;
+	if (!GetCellRange(Box, Min, Max))
+	{
+		return true;
+	}
+
+	for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+	{
+		const auto RowIndex = ToIndex(0, Y);
+
+		for (int32 X = Min.X; X <= Max.X; ++X)
+		{
+			if (Occupied[RowIndex + X])
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+int32 FOccupancyGrid2D::NumOccupied() const
+{
+	return Occupied.CountSetBits();
+}
+
+bool FOccupancyGrid2D::GetCellRange(const FBox2D& Box, FIntPoint& OutMin, FIntPoint& OutMax) const
+{
+	if (!IsInitialized() || !Box.bIsValid)
+	{
+		return false;
+	}
+
+	const auto RelativeMin = (Box.Min - Bounds.Min) / CellSize;
+	const auto RelativeMax = (Box.Max - Bounds.Min) / CellSize;
+
+	// A box ending exactly on a cell edge does not touch the next cell
+	const auto MinX = FMath::FloorToInt32(RelativeMin.X);
+	const auto MinY = FMath::FloorToInt32(RelativeMin.Y);
+	const auto MaxX = FMath::Max(MinX, FMath::CeilToInt32(RelativeMax.X) - 1);
+	const auto MaxY = FMath::Max(MinY, FMath::CeilToInt32(RelativeMax.Y) - 1);
+
+	if (MaxX < 0 || MaxY < 0 || MinX >= CellCountX || MinY >= CellCountY)
+	{
+		return false;
+	}
+
+	OutMin = { FMath::Max(0, MinX), FMath::Max(0, MinY) };
+	OutMax = { FMath::Min(CellCountX - 1, MaxX), FMath::Min(CellCountY - 1, MaxY) };
+
+	return true;
+}
+
+void FOccupancyGrid2D::SetRegion(const FBox2D& Box, bool bOccupied)
+{
+	FIntPoint Min, Max;
+	if (!GetCellRange(Box, Min, Max))
+	{
+		return;
+	}
+
+	const auto RowCount = Max.X - Min.X + 1;
+
+	for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+	{
+		Occupied.SetRange(ToIndex(Min.X, Y), RowCount, bOccupied);
+	}
+}
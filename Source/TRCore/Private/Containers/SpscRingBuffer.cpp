@@ -0,0 +1,137 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Containers/SpscRingBuffer.h"
+
+#include "TRCoreLogging.h"
+
+#if TR_DEBUG_ENABLED
+	#include "HAL/IConsoleManager.h"
+	#include "HAL/Runnable.h"
+	#include "HAL/RunnableThread.h"
+#endif
+
+#pragma region Verification
+
+#if TR_DEBUG_ENABLED
+
+using namespace TR;
+
+namespace
+{
+	struct FSequencedElement
+	{
+		uint32 Sequence;
+		uint32 Check;
+	};
+
+	constexpr uint32 MakeCheck(uint32 Sequence)
+	{
+		return Sequence * 2654435761u;
+	}
+
+	/*
+	* Consumes the sequence on its own thread, checking nothing is lost, duplicated or torn.
+	*/
+	class FRingConsumer : public FRunnable
+	{
+	public:
+		FRingConsumer(TSpscRingBuffer<FSequencedElement>& InRing, uint32 InCount) : Ring(InRing), Count(InCount) {}
+
+		virtual uint32 Run() override
+		{
+			TArray<FSequencedElement> Popped;
+
+			while (Next < Count)
+			{
+				Popped.Reset();
+				if (Ring.PopAll(Popped) == 0)
+				{
+					FPlatformProcess::Yield();
+					continue;
+				}
+
+				for (const auto& Element : Popped)
+				{
+					if (Element.Sequence != Next || Element.Check != MakeCheck(Element.Sequence))
+					{
+						++Failures;
+					}
+					Next = Element.Sequence + 1;
+				}
+			}
+
+			return 0;
+		}
+
+		TSpscRingBuffer<FSequencedElement>& Ring;
+		const uint32 Count;
+		uint32 Next{};
+		int32 Failures{};
+	};
+
+	/*
+	* Pushes a numbered sequence through a small ring from the calling thread while another thread pops it so that the ring wraps and fills many times.
+	*/
+	void RunSpscRingBufferVerification(const TArray<FString>& Args)
+	{
+		const uint32 Count = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 1000000;
+		const uint32 Capacity = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 64;
+
+		TSpscRingBuffer<FSequencedElement> Ring(Capacity);
+
+		int32 Failures{};
+
+		// Single threaded capacity check first
+		for (uint32 i = 0; i < Ring.Capacity(); ++i)
+		{
+			Failures += !Ring.Push({ i, MakeCheck(i) });
+		}
+		Failures += Ring.Push({}) ? 1 : 0;
+
+		FSequencedElement Element;
+		for (uint32 i = 0; i < Ring.Capacity(); ++i)
+		{
+			Failures += !Ring.Pop(Element) || Element.Sequence != i;
+		}
+		Failures += Ring.Pop(Element) ? 1 : 0;
+
+		FRingConsumer Consumer(Ring, Count);
+		TUniquePtr<FRunnableThread> Thread(FRunnableThread::Create(&Consumer, TEXT("SpscRingBufferVerify")));
+		if (!Thread)
+		{
+			UE_LOG(LogTRCore, Error, TEXT("RunSpscRingBufferVerification: Unable to create consumer thread"));
+			return;
+		}
+
+		int32 FullCount{};
+		const auto StartTime = FPlatformTime::Seconds();
+
+		for (uint32 i = 0; i < Count; ++i)
+		{
+			while (!Ring.Push({ i, MakeCheck(i) }))
+			{
+				++FullCount;
+				FPlatformProcess::Yield();
+			}
+		}
+
+		Thread->WaitForCompletion();
+
+		const auto ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+
+		Failures += Consumer.Failures + (Consumer.Next != Count);
+
+		UE_LOG(LogTRCore, Display, TEXT("RunSpscRingBufferVerification: %s - Count=%u; Capacity=%u; FullWaits=%d; Time=%.3fms; Failures=%d"),
+			Failures == 0 ? TEXT("PASSED") : TEXT("FAILED"), Count, Ring.Capacity(), FullCount, ElapsedSeconds * 1000, Failures);
+	}
+
+	FAutoConsoleCommandWithArgs SpscRingBufferVerifyCommand(
+		TEXT("tr.core.spscRingBuffer.verify"),
+		TEXT("Pushes a numbered sequence through the SPSC ring to a consumer thread and checks it arrives intact and in order: [Count=1000000] [Capacity=64]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunSpscRingBufferVerification));
+}
+
+#endif
+
+#pragma endregion Verification
@@ -0,0 +1,257 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Containers/SubstringMatcher.h"
+
+#include "TRConstants.h"
+
+#include "Logging/LoggingUtils.h"
+#include "TRCoreLogging.h"
+
+#if TR_DEBUG_ENABLED
+	#include "HAL/IConsoleManager.h"
+	#include "Utils/RandUtils.h"
+#endif
+
+using namespace TR;
+
+void FSubstringMatcher::Compile(TConstArrayView<FString> Substrings)
+{
+	Transitions.Reset();
+	Accepting.Empty();
+	AsciiSymbols.Init(INDEX_NONE, AsciiCount);
+	OtherSymbols.Reset();
+	SymbolCount = 0;
+	bMatchesAll = false;
+
+	if (Substrings.IsEmpty())
+	{
+		return;
+	}
+
+	// Assign a symbol to each distinct character first so that the table width is known
+	for (const auto& Substring : Substrings)
+	{
+		if (Substring.IsEmpty())
+		{
+			bMatchesAll = true;
+		}
+
+		for (const auto Char : Substring)
+		{
+			AddSymbol(Char);
+		}
+	}
+
+	// Build the trie with INDEX_NONE for missing children
+	Transitions.Init(INDEX_NONE, SymbolCount);
+	Accepting.Add(false);
+
+	for (const auto& Substring : Substrings)
+	{
+		int32 State{};
+
+		for (const auto Char : Substring)
+		{
+			const auto Symbol = GetSymbol(Char);
+			auto Next = Transitions[State * SymbolCount + Symbol];
+
+			if (Next == INDEX_NONE)
+			{
+				Next = Accepting.Add(false);
+				Transitions.AddUninitialized(SymbolCount);
+
+				for (int32 i = 0; i < SymbolCount; ++i)
+				{
+					Transitions[Next * SymbolCount + i] = INDEX_NONE;
+				}
+
+				Transitions[State * SymbolCount + Symbol] = Next;
+			}
+
+			State = Next;
+		}
+
+		Accepting[State] = true;
+	}
+
+	// Breadth first fill of missing transitions from the failure links so that matching never backtracks
+	TArray<int32> Failure;
+	Failure.SetNumZeroed(Accepting.Num());
+
+	TArray<int32> Queue;
+	Queue.Reserve(Accepting.Num());
+
+	for (int32 Symbol = 0; Symbol < SymbolCount; ++Symbol)
+	{
+		auto& Next = Transitions[Symbol];
+
+		if (Next == INDEX_NONE)
+		{
+			Next = 0;
+		}
+		else
+		{
+			Queue.Add(Next);
+		}
+	}
+
+	for (int32 QueueIndex = 0; QueueIndex < Queue.Num(); ++QueueIndex)
+	{
+		const auto State = Queue[QueueIndex];
+		const auto FailureState = Failure[State];
+
+		if (Accepting[FailureState])
+		{
+			Accepting[State] = true;
+		}
+
+		for (int32 Symbol = 0; Symbol < SymbolCount; ++Symbol)
+		{
+			auto& Next = Transitions[State * SymbolCount + Symbol];
+			const auto FailureNext = Transitions[FailureState * SymbolCount + Symbol];
+
+			if (Next == INDEX_NONE)
+			{
+				Next = FailureNext;
+			}
+			else
+			{
+				Failure[Next] = FailureNext;
+				Queue.Add(Next);
+			}
+		}
+	}
+}
+
+bool FSubstringMatcher::Matches(FStringView Input) const
+{
+	if (bMatchesAll)
+	{
+		return true;
+	}
+
+	if (Accepting.IsEmpty())
+	{
+		return false;
+	}
+
+	int32 State{};
+
+	for (const auto Char : Input)
+	{
+		const auto Symbol = GetSymbol(Char);
+
+		// No substring contains the character so any match must start after it
+		State = Symbol != INDEX_NONE ? Transitions[State * SymbolCount + Symbol] : 0;
+
+		if (Accepting[State])
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int32 FSubstringMatcher::AddSymbol(TCHAR Char)
+{
+	const auto Upper = TChar<TCHAR>::ToUpper(Char);
+
+	if (static_cast<uint32>(Upper) < AsciiCount)
+	{
+		auto& Symbol = AsciiSymbols[Upper];
+		if (Symbol == INDEX_NONE)
+		{
+			Symbol = SymbolCount++;
+		}
+		return Symbol;
+	}
+
+	if (const auto Symbol = OtherSymbols.Find(Upper); Symbol)
+	{
+		return *Symbol;
+	}
+
+	return OtherSymbols.Add(Upper, SymbolCount++);
+}
+
+#pragma region Verification
+
+#if TR_DEBUG_ENABLED
+
+namespace
+{
+	FString MakeRandomString(FRandomStream& Rng, int32 MinLength, int32 MaxLength)
+	{
+		// Small alphabet with mixed case so that substrings overlap and share prefixes often
+		static constexpr TCHAR Alphabet[] = TEXT("abcABC_1");
+
+		const auto Length = Rng.RandRange(MinLength, MaxLength);
+
+		FString Result;
+		Result.Reserve(Length);
+
+		for (int32 i = 0; i < Length; ++i)
+		{
+			Result.AppendChar(Alphabet[Rng.RandHelper(UE_ARRAY_COUNT(Alphabet) - 1)]);
+		}
+
+		return Result;
+	}
+
+	/*
+	* Checks the matcher against FString::Contains over each substring for random substring sets and inputs.
+	*/
+	void RunSubstringMatcherVerification(const TArray<FString>& Args)
+	{
+		const int32 SetCount = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 1000;
+
+		constexpr int32 InputsPerSet = 100;
+
+		FRandomStream Rng(RandUtils::GenerateSeed());
+
+		int32 Failures{};
+
+		for (int32 Set = 0; Set < SetCount; ++Set)
+		{
+			TArray<FString> Substrings;
+			const auto SubstringCount = Rng.RandRange(0, 8);
+
+			for (int32 i = 0; i < SubstringCount; ++i)
+			{
+				// Occasionally empty which matches everything
+				Substrings.Add(MakeRandomString(Rng, Rng.FRand() < 0.02f ? 0 : 1, 5));
+			}
+
+			const FSubstringMatcher Matcher(Substrings);
+
+			for (int32 i = 0; i < InputsPerSet; ++i)
+			{
+				const auto Input = MakeRandomString(Rng, 0, 24);
+
+				const bool bExpected = Substrings.ContainsByPredicate([&Input](const auto& Substring) { return Input.Contains(Substring); });
+				const bool bActual = Matcher.Matches(Input);
+
+				if (bExpected != bActual)
+				{
+					++Failures;
+					UE_LOG(LogTRCore, Error, TEXT("RunSubstringMatcherVerification: Input=%s; Substrings=[%s] - Matches=%s; Expected=%s"),
+						*Input, *FString::Join(Substrings, TEXT(",")), LoggingUtils::GetBoolString(bActual), LoggingUtils::GetBoolString(bExpected));
+				}
+			}
+		}
+
+		UE_LOG(LogTRCore, Display, TEXT("RunSubstringMatcherVerification: %s - Sets=%d; Inputs=%d; Failures=%d"),
+			Failures == 0 ? TEXT("PASSED") : TEXT("FAILED"), SetCount, SetCount * InputsPerSet, Failures);
+	}
+
+	FAutoConsoleCommandWithArgs SubstringMatcherVerifyCommand(
+		TEXT("tr.core.substringMatcher.verify"),
+		TEXT("Verifies the substring matcher against FString::Contains for random substring sets: [SetCount=1000]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunSubstringMatcherVerification));
+}
+
+#endif
+
+#pragma endregion Verification
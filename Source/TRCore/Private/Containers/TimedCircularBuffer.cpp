@@ -0,0 +1,224 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Containers/TimedCircularBuffer.h"
+
+#include "TRConstants.h"
+
+#include "TRCoreLogging.h"
+
+#if TR_DEBUG_ENABLED
+	#include "HAL/IConsoleManager.h"
+	#include "Utils/RandUtils.h"
+#endif
+
+#pragma region Verification
+
+#if TR_DEBUG_ENABLED
+
+using namespace TR;
+
+namespace
+{
+	using FZeroVectorFunc = decltype([]() { return FVector{ ForceInitToZero }; });
+	using FVectorMagnitudeFunc = decltype([](const FVector& V) { return FMath::Max3(FMath::Abs(V.X), FMath::Abs(V.Y), FMath::Abs(V.Z)); });
+	using FZeroFloatFunc = decltype([]() { return 0.0f; });
+	using FFloatMagnitudeFunc = decltype([](float V) { return FMath::Abs(V); });
+
+	using FFloatMinMaxBuffer = TTimedCircularBuffer<float, FZeroFloatFunc, FFloatMagnitudeFunc, TCircularBufferRunningSumMinMax<float, FZeroFloatFunc>>;
+	using FFloatNaiveBuffer = TTimedCircularBuffer<float, FZeroFloatFunc, FFloatMagnitudeFunc, TCircularBufferNoAggregate<float, FZeroFloatFunc>>;
+	using FVectorBuffer = TTimedCircularBuffer<FVector, FZeroVectorFunc, FVectorMagnitudeFunc>;
+	using FVectorNaiveBuffer = TTimedCircularBuffer<FVector, FZeroVectorFunc, FVectorMagnitudeFunc, TCircularBufferNoAggregate<FVector, FZeroVectorFunc>>;
+
+	constexpr int32 BufferSizes[] = { 8, 16, 32, 64, 128, 256, 512, 1024 };
+
+	/*
+	* Reference aggregates computed in double precision from the values that should be in the buffer.
+	*/
+	struct FReferenceWindow
+	{
+		TArray<double> Values;
+		int32 Capacity;
+
+		void Add(double Value)
+		{
+			Values.Add(Value);
+			if (Values.Num() > Capacity)
+			{
+				Values.RemoveAt(0, 1, false);
+			}
+		}
+
+		double Sum() const
+		{
+			double Result{};
+			for (auto Value : Values)
+			{
+				Result += Value;
+			}
+			return Result;
+		}
+	};
+
+	/*
+	* Checks running sum, average, min, max and delta against reference values for random sequences at each buffer size, including after clearing and resizing,
+	* and checks that a long run of large and small values does not drift.
+	*/
+	void RunCircularBufferVerification(const TArray<FString>& Args)
+	{
+		const int32 AddCount = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 100000;
+
+		FRandomStream Rng(RandUtils::GenerateSeed());
+
+		int32 Failures{};
+
+		const auto CheckNear = [&Failures](const TCHAR* Label, int32 Size, double Actual, double Expected, double Tolerance)
+		{
+			if (!FMath::IsNearlyEqual(Actual, Expected, Tolerance))
+			{
+				++Failures;
+				UE_LOG(LogTRCore, Error, TEXT("RunCircularBufferVerification: Size=%d - %s=%f; Expected=%f"), Size, Label, Actual, Expected);
+			}
+		};
+
+		for (const auto Size : BufferSizes)
+		{
+			FFloatMinMaxBuffer Buffer(Size);
+			FVectorBuffer VectorBuffer(Size);
+			FReferenceWindow Reference{ .Capacity = Size };
+
+			// Fewer adds at larger sizes as the reference is linear
+			const auto SizeAddCount = FMath::Max(4 * Size, AddCount / Size);
+
+			for (int32 i = 0; i < SizeAddCount; ++i)
+			{
+				// Mostly small values with occasional large ones like throttle and position changes
+				const auto Value = Rng.FRand() < 0.05f ? Rng.FRandRange(-1e4f, 1e4f) : Rng.FRandRange(-1.0f, 1.0f);
+
+				Buffer.Add(Value);
+				VectorBuffer.Add(FVector(Value, -Value, 2.0 * Value));
+				Reference.Add(Value);
+
+				if (i == SizeAddCount / 2)
+				{
+					// Restart part way through
+					Buffer.ClearAndResize(Size);
+					VectorBuffer.Clear();
+					Reference.Values.Reset();
+					continue;
+				}
+
+				const auto ExpectedSum = Reference.Sum();
+				const auto Tolerance = 1e-3 * FMath::Max(1.0, FMath::Abs(ExpectedSum));
+
+				CheckNear(TEXT("Sum"), Size, Buffer.Sum(), ExpectedSum, Tolerance);
+				CheckNear(TEXT("Average"), Size, Buffer.Average(), ExpectedSum / Reference.Values.Num(), Tolerance);
+				CheckNear(TEXT("Min"), Size, Buffer.Min(), FMath::Min(Reference.Values), 0.0);
+				CheckNear(TEXT("Max"), Size, Buffer.Max(), FMath::Max(Reference.Values), 0.0);
+				CheckNear(TEXT("Delta"), Size, Buffer.Delta(),
+					Reference.Values.Num() > 1 ? Reference.Values.Last() - Reference.Values[0] : Reference.Values[0], Tolerance);
+				CheckNear(TEXT("VectorSum.Z"), Size, VectorBuffer.Sum().Z, 2.0 * ExpectedSum, 2.0 * Tolerance);
+			}
+
+			if (Failures > 100)
+			{
+				break;
+			}
+		}
+
+		// Drift: cycle large values through the buffer then fill it with small ones. The sum should be exactly that of the small values
+		{
+			constexpr int32 Size = 64;
+			FFloatMinMaxBuffer Buffer(Size);
+
+			for (int32 i = 0; i < AddCount; ++i)
+			{
+				Buffer.Add(i % 2 ? 1e6f : 0.001f);
+			}
+
+			for (int32 i = 0; i < Size; ++i)
+			{
+				Buffer.Add(0.001f);
+			}
+
+			CheckNear(TEXT("DriftSum"), Size, Buffer.Sum(), Size * 0.001, 1e-4);
+		}
+
+		UE_LOG(LogTRCore, Display, TEXT("RunCircularBufferVerification: %s - AddCount=%d; Failures=%d"),
+			Failures == 0 ? TEXT("PASSED") : TEXT("FAILED"), AddCount, Failures);
+	}
+
+	FAutoConsoleCommandWithArgs CircularBufferVerifyCommand(
+		TEXT("tr.core.circularBuffer.verify"),
+		TEXT("Verifies circular buffer running aggregates against reference values for buffer sizes 8-1024: [AddCount=100000]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunCircularBufferVerification));
+
+	template<typename TBuffer, typename TValue, typename TQuery>
+	double TimeAddAndQuery(int32 Size, const TArray<TValue>& Values, TQuery&& Query)
+	{
+		TBuffer Buffer(Size);
+		double Sink{};
+
+		const auto StartTime = FPlatformTime::Seconds();
+
+		for (const auto& Value : Values)
+		{
+			Buffer.Add(Value);
+			Sink += Query(Buffer);
+		}
+
+		const auto ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+
+		// Keep the queries from being optimized away
+		UE_LOG(LogTRCore, VeryVerbose, TEXT("TimeAddAndQuery: Sink=%f"), Sink);
+
+		return ElapsedSeconds;
+	}
+
+	/*
+	* Times adding a value and querying the average each tick like stuck detection and aim smoothing with and without running aggregates.
+	*/
+	void RunCircularBufferBenchmark(const TArray<FString>& Args)
+	{
+		const int32 TickCount = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 100000;
+
+		FRandomStream Rng(RandUtils::GenerateSeed());
+
+		TArray<float> Floats;
+		TArray<FVector> Vectors;
+		Floats.Reserve(TickCount);
+		Vectors.Reserve(TickCount);
+
+		for (int32 i = 0; i < TickCount; ++i)
+		{
+			Floats.Add(Rng.FRandRange(-1.0f, 1.0f));
+			Vectors.Add(Rng.GetUnitVector());
+		}
+
+		const auto FloatAverage = [](const auto& Buffer) { return static_cast<double>(Buffer.Average()); };
+		const auto VectorAverage = [](const auto& Buffer) { return Buffer.Average().X; };
+
+		for (const auto Size : BufferSizes)
+		{
+			const auto FloatNaiveSeconds = TimeAddAndQuery<FFloatNaiveBuffer>(Size, Floats, FloatAverage);
+			const auto FloatRunningSeconds = TimeAddAndQuery<FFloatMinMaxBuffer>(Size, Floats, FloatAverage);
+			const auto VectorNaiveSeconds = TimeAddAndQuery<FVectorNaiveBuffer>(Size, Vectors, VectorAverage);
+			const auto VectorRunningSeconds = TimeAddAndQuery<FVectorBuffer>(Size, Vectors, VectorAverage);
+
+			UE_LOG(LogTRCore, Display,
+				TEXT("RunCircularBufferBenchmark: Size=%4d - float: Naive=%.1fns; Running=%.1fns - FVector: Naive=%.1fns; Running=%.1fns"),
+				Size,
+				FloatNaiveSeconds * 1e9 / TickCount, FloatRunningSeconds * 1e9 / TickCount,
+				VectorNaiveSeconds * 1e9 / TickCount, VectorRunningSeconds * 1e9 / TickCount);
+		}
+	}
+
+	FAutoConsoleCommandWithArgs CircularBufferBenchmarkCommand(
+		TEXT("tr.core.circularBuffer.benchmark"),
+		TEXT("Times add and average per tick with and without running aggregates for buffer sizes 8-1024: [TickCount=100000]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunCircularBufferBenchmark));
+}
+
+#endif
+
+#pragma endregion Verification
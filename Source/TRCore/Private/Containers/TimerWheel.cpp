@@ -0,0 +1,445 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Containers/TimerWheel.h"
+
+#include "TRConstants.h"
+
+#include "Logging/LoggingUtils.h"
+#include "TRCoreLogging.h"
+
+#if TR_DEBUG_ENABLED
+	#include "HAL/IConsoleManager.h"
+	#include "Utils/RandUtils.h"
+#endif
+
+DECLARE_CYCLE_STAT(TEXT("TimerWheel::Advance"), STAT_TimerWheel_Advance, STATGROUP_TRCore);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Timer Wheel Timers Fired"), STAT_TimerWheel_Fired, STATGROUP_TRCore);
+
+using namespace TR;
+
+namespace
+{
+	/* Absorbs floating point error so that e.g. 0.05s is exactly 6 ticks at 120Hz rather than 7. */
+	constexpr double TickRoundingTolerance = 1e-6;
+}
+
+FTimerWheel::FTimerWheel(double InTickSeconds) : TickSeconds(InTickSeconds)
+{
+	check(TickSeconds > 0);
+
+	Reset();
+}
+
+FTimerWheelHandle FTimerWheel::SetTimer(FTimerDelegate Delegate, double DelaySeconds, double IntervalSeconds, bool bCoalesce)
+{
+	const auto IntervalTicks = IntervalSeconds > 0 ? FMath::Max<uint64>(1, ToTicksCeil(IntervalSeconds)) : 0;
+	const auto DelayTicks = FMath::Max<uint64>(1, ToTicksCeil(FMath::Max(0.0, DelaySeconds)));
+
+	// Relative to the time of the last advance rather than the last whole tick so that the delay is not shortened
+	auto ExpiryTick = FMath::Max(CurrentTick + 1, ToTicksCeil(CurrentSeconds - StartSeconds + FMath::Max(0.0, DelaySeconds)));
+
+	if (bCoalesce)
+	{
+		ExpiryTick = AlignExpiry(ExpiryTick, IntervalTicks > 0 ? IntervalTicks : DelayTicks);
+	}
+
+	const auto Serial = NextSerial++;
+	if (NextSerial == 0)
+	{
+		NextSerial = 1;
+	}
+
+	const auto Index = Entries.Add(FTimerEntry
+	{
+		.Delegate = MoveTemp(Delegate),
+		.ExpiryTick = ExpiryTick,
+		.IntervalTicks = IntervalTicks,
+		.Serial = Serial
+	});
+
+	Link(Index);
+
+	return FTimerWheelHandle
+	{
+		.Index = Index,
+		.Serial = Serial
+	};
+}
+
+bool FTimerWheel::ClearTimer(FTimerWheelHandle& Handle)
+{
+	const auto bActive = IsTimerActive(Handle);
+
+	if (bActive)
+	{
+		Unlink(Handle.Index);
+		Entries.RemoveAt(Handle.Index);
+	}
+
+	Handle.Invalidate();
+
+	return bActive;
+}
+
+double FTimerWheel::GetTimerRemaining(const FTimerWheelHandle& Handle) const
+{
+	const auto Entry = FindEntry(Handle);
+	if (!Entry)
+	{
+		return -1.0;
+	}
+
+	return FMath::Max(0.0, StartSeconds + Entry->ExpiryTick * TickSeconds - CurrentSeconds);
+}
+
+int32 FTimerWheel::Advance(double NowSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_TimerWheel_Advance);
+
+	// Ticks are counted from the first advance so that timers set before it are relative to when the wheel started
+	if (!bStarted)
+	{
+		bStarted = true;
+		StartSeconds = CurrentSeconds = NowSeconds;
+		return 0;
+	}
+
+	CurrentSeconds = FMath::Max(CurrentSeconds, NowSeconds);
+
+	const auto TargetTick = static_cast<uint64>((CurrentSeconds - StartSeconds) / TickSeconds + TickRoundingTolerance);
+
+	// Nothing in any slot so the wheel can jump straight to the target
+	if (Entries.IsEmpty())
+	{
+		CurrentTick = FMath::Max(CurrentTick, TargetTick);
+		return 0;
+	}
+
+	int32 FiredCount{};
+
+	while (CurrentTick < TargetTick)
+	{
+		++CurrentTick;
+
+		// Cascade from the highest level whose lower levels just wrapped so that timers can drop more than one level on the same tick
+		if ((CurrentTick & SlotMask) == 0)
+		{
+			int32 HighestLevel = 1;
+			while (HighestLevel < LevelCount - 1 && (CurrentTick & ((1ull << (SlotBits * (HighestLevel + 1))) - 1)) == 0)
+			{
+				++HighestLevel;
+			}
+
+			if (HighestLevel == LevelCount - 1 && (CurrentTick & ((1ull << (SlotBits * LevelCount)) - 1)) == 0)
+			{
+				CascadeLevel(OverflowLevel);
+			}
+
+			for (int32 Level = HighestLevel; Level >= 1; --Level)
+			{
+				CascadeLevel(Level);
+			}
+		}
+
+		FiredCount += FireSlot(static_cast<int32>(CurrentTick & SlotMask));
+	}
+
+	INC_DWORD_STAT_BY(STAT_TimerWheel_Fired, FiredCount);
+
+	return FiredCount;
+}
+
+void FTimerWheel::Reset()
+{
+	Entries.Empty();
+
+	for (auto& LevelHeads : SlotHeads)
+	{
+		for (auto& Head : LevelHeads)
+		{
+			Head = INDEX_NONE;
+		}
+	}
+
+	OverflowHead = INDEX_NONE;
+
+	StartSeconds = CurrentSeconds = 0;
+	CurrentTick = 0;
+	bStarted = false;
+
+	// Serial is not reset so that handles from before the reset remain invalid
+}
+
+uint64 FTimerWheel::ToTicksCeil(double Seconds) const
+{
+	return static_cast<uint64>(FMath::CeilToDouble(Seconds / TickSeconds - TickRoundingTolerance));
+}
+
+uint64 FTimerWheel::AlignExpiry(uint64 ExpiryTick, uint64 PeriodTicks) const
+{
+	return PeriodTicks > 1 ? ((ExpiryTick + PeriodTicks - 1) / PeriodTicks) * PeriodTicks : ExpiryTick;
+}
+
+const FTimerWheel::FTimerEntry* FTimerWheel::FindEntry(const FTimerWheelHandle& Handle) const
+{
+	if (!Handle.IsValid() || !Entries.IsValidIndex(Handle.Index))
+	{
+		return nullptr;
+	}
+
+	const auto& Entry = Entries[Handle.Index];
+	return Entry.Serial == Handle.Serial ? &Entry : nullptr;
+}
+
+int32& FTimerWheel::GetListHead(int32 Level, int32 Slot)
+{
+	return Level == OverflowLevel ? OverflowHead : SlotHeads[Level][Slot];
+}
+
+void FTimerWheel::Link(int32 Index)
+{
+	auto& Entry = Entries[Index];
+	check(!Entry.bLinked);
+
+	// Lowest level where the expiry is in the same span as the current tick
+	int32 Level = OverflowLevel;
+	int32 Slot = 0;
+
+	for (int32 CandidateLevel = 0; CandidateLevel < LevelCount; ++CandidateLevel)
+	{
+		const auto SpanShift = SlotBits * (CandidateLevel + 1);
+
+		if ((Entry.ExpiryTick >> SpanShift) == (CurrentTick >> SpanShift))
+		{
+			Level = CandidateLevel;
+			Slot = static_cast<int32>((Entry.ExpiryTick >> (SlotBits * CandidateLevel)) & SlotMask);
+			break;
+		}
+	}
+
+	auto& Head = GetListHead(Level, Slot);
+
+	Entry.Level = static_cast<uint8>(Level);
+	Entry.Slot = static_cast<uint8>(Slot);
+	Entry.Prev = INDEX_NONE;
+	Entry.Next = Head;
+	Entry.bLinked = true;
+
+	if (Head != INDEX_NONE)
+	{
+		Entries[Head].Prev = Index;
+	}
+
+	Head = Index;
+}
+
+void FTimerWheel::Unlink(int32 Index)
+{
+	auto& Entry = Entries[Index];
+	if (!Entry.bLinked)
+	{
+		return;
+	}
+
+	if (Entry.Prev != INDEX_NONE)
+	{
+		Entries[Entry.Prev].Next = Entry.Next;
+	}
+	else
+	{
+		GetListHead(Entry.Level, Entry.Slot) = Entry.Next;
+	}
+
+	if (Entry.Next != INDEX_NONE)
+	{
+		Entries[Entry.Next].Prev = Entry.Prev;
+	}
+
+	Entry.Prev = Entry.Next = INDEX_NONE;
+	Entry.bLinked = false;
+}
+
+void FTimerWheel::CascadeLevel(int32 Level)
+{
+	const auto Slot = Level == OverflowLevel ? 0 : static_cast<int32>((CurrentTick >> (SlotBits * Level)) & SlotMask);
+	auto& Head = GetListHead(Level, Slot);
+
+	auto Index = Head;
+	Head = INDEX_NONE;
+
+	while (Index != INDEX_NONE)
+	{
+		auto& Entry = Entries[Index];
+		const auto Next = Entry.Next;
+
+		Entry.Prev = Entry.Next = INDEX_NONE;
+		Entry.bLinked = false;
+
+		Link(Index);
+
+		Index = Next;
+	}
+}
+
+int32 FTimerWheel::FireSlot(int32 Slot)
+{
+	int32 FiredCount{};
+
+	// Callbacks may set or clear timers so always take the current head
+	for (auto Index = SlotHeads[0][Slot]; Index != INDEX_NONE; Index = SlotHeads[0][Slot])
+	{
+		Unlink(Index);
+
+		auto& Entry = Entries[Index];
+
+		// Bound object destroyed so a looping timer would otherwise never be removed
+		if (!Entry.Delegate.IsBound())
+		{
+			Entries.RemoveAt(Index);
+			continue;
+		}
+
+		// Copied as the entry may be reallocated or removed while executing
+		const auto Delegate = Entry.Delegate;
+
+		// Reschedule before executing so that the callback can clear its own timer
+		if (Entry.IntervalTicks > 0)
+		{
+			Entry.ExpiryTick += Entry.IntervalTicks;
+			Link(Index);
+		}
+		else
+		{
+			Entries.RemoveAt(Index);
+		}
+
+		Delegate.Execute();
+		++FiredCount;
+	}
+
+	return FiredCount;
+}
+
+#pragma region Benchmark
+
+#if TR_DEBUG_ENABLED
+
+namespace
+{
+	/*
+	* Compares setting, ticking and clearing timers on the timer wheel against FTimerManager with a mix of one shot and coalesced looping timers like
+	* projectile and effect timers.
+	*/
+	void RunTimerWheelBenchmark(const TArray<FString>& Args)
+	{
+		const int32 TimerCount = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 1000;
+
+		constexpr int32 FrameCount = 600;
+		constexpr float FrameSeconds = 1.0f / 60;
+		constexpr float LoopIntervals[] = { 0.05f, 0.1f, 0.5f };
+
+		FRandomStream Rng(RandUtils::GenerateSeed());
+
+		TArray<float> Delays;
+		TArray<float> Intervals;
+		Delays.Reserve(TimerCount);
+		Intervals.Reserve(TimerCount);
+
+		for (int32 i = 0; i < TimerCount; ++i)
+		{
+			Delays.Add(Rng.FRandRange(0.0f, 5.0f));
+			Intervals.Add(Rng.RandHelper(2) ? LoopIntervals[Rng.RandHelper(UE_ARRAY_COUNT(LoopIntervals))] : 0.0f);
+		}
+
+		int32 TimerManagerFired{};
+		int32 TimerWheelFired{};
+
+		// FTimerManager
+		double TimerManagerSetSeconds, TimerManagerTickSeconds, TimerManagerClearSeconds;
+		{
+			FTimerManager TimerManager;
+			TArray<FTimerHandle> Handles;
+			Handles.SetNum(TimerCount);
+
+			const auto Delegate = FTimerDelegate::CreateLambda([&TimerManagerFired]() { ++TimerManagerFired; });
+
+			auto StartTime = FPlatformTime::Seconds();
+			for (int32 i = 0; i < TimerCount; ++i)
+			{
+				const auto bLoop = Intervals[i] > 0;
+				TimerManager.SetTimer(Handles[i], Delegate, bLoop ? Intervals[i] : Delays[i], bLoop, Delays[i]);
+			}
+			TimerManagerSetSeconds = FPlatformTime::Seconds() - StartTime;
+
+			// FTimerManager only ticks once per frame so simulate the frame counter advancing and restore it after
+			const auto SavedFrameCounter = GFrameCounter;
+
+			StartTime = FPlatformTime::Seconds();
+			for (int32 Frame = 0; Frame < FrameCount; ++Frame)
+			{
+				++GFrameCounter;
+				TimerManager.Tick(FrameSeconds);
+			}
+			TimerManagerTickSeconds = FPlatformTime::Seconds() - StartTime;
+
+			GFrameCounter = SavedFrameCounter;
+
+			StartTime = FPlatformTime::Seconds();
+			for (auto& Handle : Handles)
+			{
+				TimerManager.ClearTimer(Handle);
+			}
+			TimerManagerClearSeconds = FPlatformTime::Seconds() - StartTime;
+		}
+
+		// FTimerWheel
+		double TimerWheelSetSeconds, TimerWheelTickSeconds, TimerWheelClearSeconds;
+		{
+			FTimerWheel TimerWheel;
+			TimerWheel.Advance(0.0);
+
+			TArray<FTimerWheelHandle> Handles;
+			Handles.Reserve(TimerCount);
+
+			const auto Delegate = FTimerDelegate::CreateLambda([&TimerWheelFired]() { ++TimerWheelFired; });
+
+			auto StartTime = FPlatformTime::Seconds();
+			for (int32 i = 0; i < TimerCount; ++i)
+			{
+				const auto bLoop = Intervals[i] > 0;
+				Handles.Add(TimerWheel.SetTimer(Delegate, Delays[i], Intervals[i], bLoop));
+			}
+			TimerWheelSetSeconds = FPlatformTime::Seconds() - StartTime;
+
+			StartTime = FPlatformTime::Seconds();
+			for (int32 Frame = 1; Frame <= FrameCount; ++Frame)
+			{
+				TimerWheel.Advance(Frame * FrameSeconds);
+			}
+			TimerWheelTickSeconds = FPlatformTime::Seconds() - StartTime;
+
+			StartTime = FPlatformTime::Seconds();
+			for (auto& Handle : Handles)
+			{
+				TimerWheel.ClearTimer(Handle);
+			}
+			TimerWheelClearSeconds = FPlatformTime::Seconds() - StartTime;
+		}
+
+		UE_LOG(LogTRCore, Display,
+			TEXT("RunTimerWheelBenchmark: Timers=%d; Frames=%d - FTimerManager: Set=%.3fms; Tick=%.3fms; Clear=%.3fms; Fired=%d - FTimerWheel: Set=%.3fms; Tick=%.3fms; Clear=%.3fms; Fired=%d"),
+			TimerCount, FrameCount,
+			TimerManagerSetSeconds * 1000, TimerManagerTickSeconds * 1000, TimerManagerClearSeconds * 1000, TimerManagerFired,
+			TimerWheelSetSeconds * 1000, TimerWheelTickSeconds * 1000, TimerWheelClearSeconds * 1000, TimerWheelFired);
+	}
+
+	FAutoConsoleCommandWithArgs TimerWheelBenchmarkCommand(
+		TEXT("tr.core.timerWheel.benchmark"),
+		TEXT("Times the timer wheel against FTimerManager, e.g. with 1000 and 10000 timers: [TimerCount=1000]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunTimerWheelBenchmark));
+}
+
+#endif
+
+#pragma endregion Benchmark
@@ -1,5 +1,93 @@
 #include "Debug/TRConsoleVars.h"
 
+namespace TR
+{
+	// Available in test builds so that both paths can be profiled with the Tools/Profiling scripts
+	TAutoConsoleVariable<bool> CVarHomingAsyncTraces(
+		TEXT("tr.item.homing.asyncTraces"),
+		true,
+		TEXT("Toggle between async (true) and synchronous (false) line of sight traces for homing projectile targeting"),
+		ECVF_Default);
+
+	TAutoConsoleVariable<int32> CVarProjectilePoolPrewarmBudget(
+		TEXT("tr.item.projectilePool.prewarmBudget"),
+		64,
+		TEXT("Maximum number of projectiles spawned up front into the projectile pool of each level. 0 disables pre-warming"),
+		ECVF_Default);
+
+	TAutoConsoleVariable<bool> CVarAISchedulerEnabled(
+		TEXT("tr.ai.scheduler.enabled"),
+		true,
+		TEXT("Toggle between running tank AI from the time-sliced scheduler (true) and every controller tick (false)"),
+		ECVF_Default);
+
+	TAutoConsoleVariable<float> CVarAISchedulerBudgetMs(
+		TEXT("tr.ai.scheduler.budgetMs"),
+		2.0f,
+		TEXT("Milliseconds per frame the AI scheduler may spend running tank AI before deferring due controllers to the next frame"),
+		ECVF_Default);
+
+	TAutoConsoleVariable<bool> CVarAIWanderPointsEnabled(
+		TEXT("tr.ai.wanderPoints.enabled"),
+		true,
+		TEXT("Toggle between handing out AI wander destinations from the shared navmesh point reservoir (true) and a navmesh query per request (false)"),
+		ECVF_Default);
+
+	TAutoConsoleVariable<bool> CVarTankGroundProbeAsync(
+		TEXT("tr.tank.groundProbe.async"),
+		true,
+		TEXT("Toggle between batched async (true) and synchronous (false) ground contact traces for tank tracks and wheels"),
+		ECVF_Default);
+
+	TAutoConsoleVariable<bool> CVarTankRecoveryEnabled(
+		TEXT("tr.tank.recovery.enabled"),
+		true,
+		TEXT("Toggle between the tank recovery subsystem (true) and the legacy track stuck reset and flipped over correction (false) for freeing stuck, wedged, flipped and perched tanks"),
+		ECVF_Default);
+
+	TAutoConsoleVariable<bool> CVarTankSpringWheelManaged(
+		TEXT("tr.tank.springWheel.managed"),
+		true,
+		TEXT("Toggle between updating all suspension spring wheels from one subsystem tick (true) and ticking each wheel actor (false). Read when each wheel begins play"),
+		ECVF_Default);
+
+	TAutoConsoleVariable<bool> CVarAudioDispatchEnabled(
+		TEXT("tr.audio.dispatch.enabled"),
+		true,
+		TEXT("Toggle between merging and budgeting one-shot sfx at the end of the frame (true) and playing each request immediately (false)"),
+		ECVF_Default);
+
+	TAutoConsoleVariable<bool> CVarAudioDispatchRecord(
+		TEXT("tr.audio.dispatch.record"),
+		false,
+		TEXT("Record dispatched one-shot sfx instead of playing them. Always recorded when there is no audio device"),
+		ECVF_Default);
+
+	TAutoConsoleVariable<bool> CVarVfxManagerEnabled(
+		TEXT("tr.vfx.enabled"),
+		true,
+		TEXT("Toggle between pooling and budgeting hit, death and explosion vfx at the end of the frame (true) and spawning each request immediately (false)"),
+		ECVF_Default);
+
+	TAutoConsoleVariable<int32> CVarVfxSpawnBudget(
+		TEXT("tr.vfx.spawnBudget"),
+		16,
+		TEXT("Maximum number of non-critical vfx spawned per frame. Requests over the budget are deferred or dropped by priority"),
+		ECVF_Default);
+
+	TAutoConsoleVariable<bool> CVarStatsJournalEnabled(
+		TEXT("tr.stats.journal.enabled"),
+		false,
+		TEXT("Record gameplay events of each run to a journal in Saved/Journals for offline analysis with the GameEventJournal commandlet. Read when the level begins play"),
+		ECVF_Default);
+
+	TAutoConsoleVariable<float> CVarHUDMaxUpdateRate(
+		TEXT("tr.ui.hud.maxUpdateRate"),
+		15.0f,
+		TEXT("Maximum number of times per second the HUD view model pushes changed values to widgets. 0 pushes every frame that has changes"),
+		ECVF_Default);
+}
+
 #if TR_DEBUG_ENABLED
 
 namespace TR
@@ -0,0 +1,497 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/AudioDispatchSubsystem.h"
+
+#include "Kismet/GameplayStatics.h"
+#include "Components/AudioComponent.h"
+#include "Sound/SoundBase.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+
+#include "Debug/TRConsoleVars.h"
+
+#include "Logging/LoggingUtils.h"
+#include "TRCoreLogging.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AudioDispatchSubsystem)
+
+DECLARE_CYCLE_STAT(TEXT("AudioDispatchSubsystem::Flush"), STAT_AudioDispatchSubsystem_Flush, STATGROUP_TRCore);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sfx Requests"), STAT_AudioDispatchSubsystem_Requests, STATGROUP_TRCore);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sfx Voices Started"), STAT_AudioDispatchSubsystem_Started, STATGROUP_TRCore);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sfx Requests Merged"), STAT_AudioDispatchSubsystem_Merged, STATGROUP_TRCore);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sfx Voices Over Budget"), STAT_AudioDispatchSubsystem_OverBudget, STATGROUP_TRCore);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sfx Voices Stolen"), STAT_AudioDispatchSubsystem_Stolen, STATGROUP_TRCore);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Sfx Active Voices"), STAT_AudioDispatchSubsystem_Active, STATGROUP_TRCore);
+
+namespace
+{
+	/* Requests for the same sound within this distance are merged into one voice. */
+	constexpr float CoalesceRadius = 300.0f;
+
+	/* Requests close to a voice of the same sound started this recently are merged into that voice instead of starting another. */
+	constexpr double CoalesceWindowSeconds = 0.05;
+
+	/* Merged voices are louder by the combined energy of the requests up to this multiple of the loudest request. */
+	constexpr float MaxMergedVolumeMultiplier = 2.0f;
+
+	/* Length assumed for recorded voices of sounds that loop or have no duration. */
+	constexpr double DefaultRecordedVoiceSeconds = 1.0;
+
+	constexpr int32 MaxRecordedSfx = 16 * 1024;
+
+	/* Voices playing at once in each category */
+	constexpr int32 VoiceBudgets[] =
+	{
+		8, // Impact
+		6, // Explosion
+		8, // Weapon
+		4, // Item
+	};
+
+	static_assert(UE_ARRAY_COUNT(VoiceBudgets) == static_cast<int32>(ESfxCategory::MAX), "VoiceBudgets must have a budget for each ESfxCategory");
+
+	float GetMergedVolume(float VolumeSquaredSum, float LoudestVolume)
+	{
+		// Uncorrelated sounds add by energy rather than amplitude
+		return FMath::Min(FMath::Sqrt(VolumeSquaredSum), LoudestVolume * MaxMergedVolumeMultiplier);
+	}
+}
+
+void UAudioDispatchSubsystem::PlaySfx(const FOneShotSfxRequest& Request)
+{
+	if (!ensure(Request.Sound.IsValid()))
+	{
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_AudioDispatchSubsystem_Requests);
+
+	if (IsEnabled())
+	{
+		PendingRequests.Add(Request);
+		return;
+	}
+
+	// Dispatch disabled: play every request as it comes in like UGameplayStatics
+	auto World = GetWorld();
+	check(World);
+
+	const auto TimeSeconds = World->GetTimeSeconds();
+	const bool bRecording = IsRecording();
+
+	PruneFinishedVoices(TimeSeconds, bRecording);
+
+	FMergedSfx Voice;
+	Voice.Add(Request);
+	Voice.UpdateListenerDistance(GetListenerLocation());
+
+	StartVoice(Voice, TimeSeconds, bRecording);
+}
+
+void UAudioDispatchSubsystem::QueueSfxAtActor(const AActor& Actor, USoundBase* Sound, ESfxCategory Category, AActor* ConcurrencyOwner, bool bReverb)
+{
+	auto World = Actor.GetWorld();
+	check(World);
+
+	auto AudioDispatchSubsystem = World->GetSubsystem<UAudioDispatchSubsystem>();
+	if (!ensure(AudioDispatchSubsystem))
+	{
+		return;
+	}
+
+	AudioDispatchSubsystem->PlaySfx(FOneShotSfxRequest
+	{
+		.Sound = Sound,
+		.Owner = ConcurrencyOwner,
+		.Location = Actor.GetActorLocation(),
+		.Rotation = Actor.GetActorRotation(),
+		.Category = Category,
+		.bReverb = bReverb
+	});
+}
+
+int32 UAudioDispatchSubsystem::FlushPendingSfx()
+{
+	SCOPE_CYCLE_COUNTER(STAT_AudioDispatchSubsystem_Flush);
+
+	if (PendingRequests.IsEmpty())
+	{
+		return 0;
+	}
+
+	auto World = GetWorld();
+	check(World);
+
+	const auto TimeSeconds = World->GetTimeSeconds();
+	const bool bRecording = IsRecording();
+
+	PruneFinishedVoices(TimeSeconds, bRecording);
+
+	// Move out as starting a voice could queue another request
+	const auto Requests = MoveTemp(PendingRequests);
+	PendingRequests.Reset();
+
+	TArray<FMergedSfx, TInlineAllocator<16>> Voices;
+	int32 MergedCount{};
+
+	for (const auto& Request : Requests)
+	{
+		if (!Request.Sound.IsValid())
+		{
+			continue;
+		}
+
+		if (MergeIntoRecentVoice(Request, TimeSeconds))
+		{
+			++MergedCount;
+			continue;
+		}
+
+		auto Voice = Voices.FindByPredicate([&](const FMergedSfx& Candidate)
+		{
+			return CanMerge(Request, Candidate.Loudest.Sound, Candidate.Loudest.AttachComponent, Candidate.Loudest.Category, Candidate.GetLocation());
+		});
+
+		if (Voice)
+		{
+			++MergedCount;
+		}
+		else
+		{
+			Voice = &Voices.AddDefaulted_GetRef();
+		}
+
+		Voice->Add(Request);
+	}
+
+	const auto ListenerLocation = GetListenerLocation();
+
+	for (auto& Voice : Voices)
+	{
+		Voice.UpdateListenerDistance(ListenerLocation);
+	}
+
+	// Nearest voices have first claim on the budget
+	Voices.Sort([](const auto& First, const auto& Second)
+	{
+		return First.ListenerDistanceSq < Second.ListenerDistanceSq;
+	});
+
+	int32 ActiveCounts[static_cast<int32>(ESfxCategory::MAX)]{};
+	for (const auto& ActiveVoice : ActiveVoices)
+	{
+		++ActiveCounts[static_cast<int32>(ActiveVoice.Category)];
+	}
+
+	int32 StartedCount{};
+	int32 OverBudgetCount{};
+
+	for (const auto& Voice : Voices)
+	{
+		const auto CategoryIndex = static_cast<int32>(Voice.Loudest.Category);
+
+		if (ActiveCounts[CategoryIndex] >= GetVoiceBudget(Voice.Loudest.Category))
+		{
+			if (!StealVoice(Voice.Loudest.Category, Voice.ListenerDistanceSq))
+			{
+				++OverBudgetCount;
+				continue;
+			}
+
+			--ActiveCounts[CategoryIndex];
+		}
+
+		if (StartVoice(Voice, TimeSeconds, bRecording))
+		{
+			++ActiveCounts[CategoryIndex];
+			++StartedCount;
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_AudioDispatchSubsystem_Merged, MergedCount);
+	INC_DWORD_STAT_BY(STAT_AudioDispatchSubsystem_OverBudget, OverBudgetCount);
+	SET_DWORD_STAT(STAT_AudioDispatchSubsystem_Active, ActiveVoices.Num());
+
+	UE_LOG(LogTRCore, VeryVerbose, TEXT("%s: FlushPendingSfx - %d request%s: Started=%d; Merged=%d; OverBudget=%d; Active=%d; bRecording=%s"),
+		*GetName(), Requests.Num(), LoggingUtils::Pluralize(Requests.Num()), StartedCount, MergedCount, OverBudgetCount, ActiveVoices.Num(),
+		LoggingUtils::GetBoolString(bRecording));
+
+	return StartedCount;
+}
+
+void UAudioDispatchSubsystem::Reset()
+{
+	PendingRequests.Reset();
+	ActiveVoices.Reset();
+	RecordedSfx.Reset();
+
+	SET_DWORD_STAT(STAT_AudioDispatchSubsystem_Active, 0);
+}
+
+bool UAudioDispatchSubsystem::IsEnabled()
+{
+	return TR::CVarAudioDispatchEnabled.GetValueOnGameThread();
+}
+
+bool UAudioDispatchSubsystem::IsRecording() const
+{
+	if (TR::CVarAudioDispatchRecord.GetValueOnGameThread())
+	{
+		return true;
+	}
+
+	auto World = GetWorld();
+	return !World || !World->GetAudioDeviceRaw();
+}
+
+void UAudioDispatchSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	FlushPendingSfx();
+}
+
+bool UAudioDispatchSubsystem::IsTickable() const
+{
+	return !PendingRequests.IsEmpty();
+}
+
+TStatId UAudioDispatchSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAudioDispatchSubsystem, STATGROUP_Tickables);
+}
+
+void UAudioDispatchSubsystem::Deinitialize()
+{
+	Reset();
+
+	Super::Deinitialize();
+}
+
+void UAudioDispatchSubsystem::PruneFinishedVoices(double TimeSeconds, bool bRecording)
+{
+	ActiveVoices.RemoveAllSwap([TimeSeconds, bRecording](const auto& Voice)
+	{
+		if (bRecording)
+		{
+			return TimeSeconds >= Voice.EndTimeSeconds;
+		}
+
+		auto AudioComponent = Voice.AudioComponent.Get();
+		return !AudioComponent || !AudioComponent->IsPlaying();
+	});
+}
+
+bool UAudioDispatchSubsystem::MergeIntoRecentVoice(const FOneShotSfxRequest& Request, double TimeSeconds)
+{
+	auto Voice = ActiveVoices.FindByPredicate([&](const auto& Candidate)
+	{
+		return TimeSeconds - Candidate.StartTimeSeconds <= CoalesceWindowSeconds
+			&& CanMerge(Request, Candidate.Sound, Candidate.AttachComponent, Candidate.Category, Candidate.Location);
+	});
+
+	if (!Voice)
+	{
+		return false;
+	}
+
+	Voice->LoudestVolume = FMath::Max(Voice->LoudestVolume, Request.Volume);
+	Voice->VolumeSquaredSum += FMath::Square(Request.Volume);
+	++Voice->MergedCount;
+
+	// The request is only heard through the voice already playing so that voice gets louder instead. The energy sum only grows so the volume never drops
+	Voice->Volume = GetMergedVolume(Voice->VolumeSquaredSum, Voice->LoudestVolume);
+
+	if (auto AudioComponent = Voice->AudioComponent.Get(); AudioComponent)
+	{
+		AudioComponent->SetVolumeMultiplier(Voice->Volume);
+	}
+
+	if (RecordedSfx.IsValidIndex(Voice->RecordedIndex))
+	{
+		auto& Recorded = RecordedSfx[Voice->RecordedIndex];
+		Recorded.Volume = Voice->Volume;
+		Recorded.MergedCount = Voice->MergedCount;
+	}
+
+	return true;
+}
+
+bool UAudioDispatchSubsystem::StartVoice(const FMergedSfx& Voice, double TimeSeconds, bool bRecording)
+{
+	auto Sound = Voice.Loudest.Sound.Get();
+	if (!Sound)
+	{
+		return false;
+	}
+
+	const auto Location = Voice.GetLocation();
+	const auto Volume = Voice.GetVolume();
+
+	auto& ActiveVoice = ActiveVoices.Add_GetRef(FActiveVoice
+	{
+		.Sound = Voice.Loudest.Sound,
+		.AttachComponent = Voice.Loudest.AttachComponent,
+		.Location = Location,
+		.StartTimeSeconds = TimeSeconds,
+		.ListenerDistanceSq = Voice.ListenerDistanceSq,
+		.LoudestVolume = Voice.Loudest.Volume,
+		.VolumeSquaredSum = Voice.VolumeSquaredSum,
+		.Volume = Volume,
+		.MergedCount = Voice.MergedCount,
+		.Category = Voice.Loudest.Category
+	});
+
+	INC_DWORD_STAT(STAT_AudioDispatchSubsystem_Started);
+
+	if (bRecording)
+	{
+		const auto Duration = Sound->GetDuration();
+		ActiveVoice.EndTimeSeconds = TimeSeconds + (Duration > 0 && Duration < INDEFINITELY_LOOPING_DURATION ? Duration : DefaultRecordedVoiceSeconds);
+
+		if (RecordedSfx.Num() < MaxRecordedSfx)
+		{
+			RecordedSfx.Add(FDispatchedSfx
+			{
+				.SoundName = Sound->GetFName(),
+				.Location = Location,
+				.Volume = Volume,
+				.ListenerDistance = FMath::Sqrt(Voice.ListenerDistanceSq),
+				.MergedCount = Voice.MergedCount,
+				.Category = Voice.Loudest.Category,
+				.Frame = GFrameCounter
+			});
+		}
+
+		return true;
+	}
+
+	UAudioComponent* AudioComponent{};
+
+	if (auto AttachComponent = Voice.Loudest.AttachComponent.Get(); AttachComponent)
+	{
+		AudioComponent = UGameplayStatics::SpawnSoundAttached(Sound, AttachComponent, NAME_None, FVector::ZeroVector, EAttachLocation::KeepRelativeOffset, true, Volume);
+	}
+	else
+	{
+		// The owner of the audio component is derived from the world context object and this will control the sound concurrency
+		UObject* WorldContext = Voice.Loudest.Owner.Get();
+		AudioComponent = UGameplayStatics::SpawnSoundAtLocation(WorldContext ? WorldContext : this, Sound, Location, Voice.Loudest.Rotation, Volume);
+	}
+
+	if (!AudioComponent)
+	{
+		// Not an error as the component is not spawned if the sound is not audible, e.g. attenuated by distance or filtered by sound concurrency
+		ActiveVoices.Pop(false);
+
+		UE_LOG(LogTRCore, Verbose, TEXT("%s: StartVoice - Unable to spawn audio component for sfx=%s; Volume=%.3f; MergedCount=%d"),
+			*GetName(), *Sound->GetName(), Volume, Voice.MergedCount);
+		return false;
+	}
+
+	AudioComponent->bAutoDestroy = true;
+	// bReverb == true does NOT mean to exclude reverb
+	AudioComponent->bReverb = Voice.Loudest.bReverb;
+
+	ActiveVoice.AudioComponent = AudioComponent;
+
+	UE_LOG(LogTRCore, Verbose, TEXT("%s: StartVoice - Playing sfx=%s at Volume=%.3f; MergedCount=%d"),
+		*GetName(), *Sound->GetName(), Volume, Voice.MergedCount);
+
+	return true;
+}
+
+bool UAudioDispatchSubsystem::StealVoice(ESfxCategory Category, float ListenerDistanceSq)
+{
+	int32 FurthestIndex{ INDEX_NONE };
+
+	for (int32 i = 0; i < ActiveVoices.Num(); ++i)
+	{
+		const auto& Voice = ActiveVoices[i];
+
+		if (Voice.Category == Category && Voice.ListenerDistanceSq > ListenerDistanceSq
+			&& (FurthestIndex == INDEX_NONE || Voice.ListenerDistanceSq > ActiveVoices[FurthestIndex].ListenerDistanceSq))
+		{
+			FurthestIndex = i;
+		}
+	}
+
+	if (FurthestIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	if (auto AudioComponent = ActiveVoices[FurthestIndex].AudioComponent.Get(); AudioComponent)
+	{
+		AudioComponent->Stop();
+	}
+
+	ActiveVoices.RemoveAtSwap(FurthestIndex);
+
+	INC_DWORD_STAT(STAT_AudioDispatchSubsystem_Stolen);
+
+	return true;
+}
+
+TOptional<FVector> UAudioDispatchSubsystem::GetListenerLocation() const
+{
+	auto World = GetWorld();
+	check(World);
+
+	auto PlayerController = World->GetFirstPlayerController();
+	if (!PlayerController)
+	{
+		return {};
+	}
+
+	FVector Location, FrontDirection, RightDirection;
+	PlayerController->GetAudioListenerPosition(Location, FrontDirection, RightDirection);
+
+	return Location;
+}
+
+int32 UAudioDispatchSubsystem::GetVoiceBudget(ESfxCategory Category)
+{
+	return VoiceBudgets[static_cast<int32>(Category)];
+}
+
+bool UAudioDispatchSubsystem::CanMerge(const FOneShotSfxRequest& Request, const TWeakObjectPtr<USoundBase>& Sound, const TWeakObjectPtr<USceneComponent>& AttachComponent,
+	ESfxCategory Category, const FVector& Location)
+{
+	if (Request.Sound != Sound || Request.Category != Category || Request.AttachComponent != AttachComponent)
+	{
+		return false;
+	}
+
+	return AttachComponent.IsValid() || FVector::DistSquared(Request.Location, Location) <= FMath::Square(CoalesceRadius);
+}
+
+void UAudioDispatchSubsystem::FMergedSfx::Add(const FOneShotSfxRequest& Request)
+{
+	if (MergedCount == 0 || Request.Volume > Loudest.Volume)
+	{
+		Loudest = Request;
+	}
+
+	WeightedLocationSum += Request.Location * Request.Volume;
+	VolumeSum += Request.Volume;
+	VolumeSquaredSum += FMath::Square(Request.Volume);
+	++MergedCount;
+}
+
+FVector UAudioDispatchSubsystem::FMergedSfx::GetLocation() const
+{
+	// Weighted toward the loudest requests
+	return VolumeSum > UE_KINDA_SMALL_NUMBER ? WeightedLocationSum / VolumeSum : Loudest.Location;
+}
+
+void UAudioDispatchSubsystem::FMergedSfx::UpdateListenerDistance(const TOptional<FVector>& ListenerLocation)
+{
+	ListenerDistanceSq = ListenerLocation ? FVector::DistSquared(*ListenerLocation, GetLocation()) : 0.0f;
+}
+
+float UAudioDispatchSubsystem::FMergedSfx::GetVolume() const
+{
+	return GetMergedVolume(VolumeSquaredSum, Loudest.Volume);
+}
@@ -0,0 +1,327 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/PawnSpatialHashSubsystem.h"
+
+#include "GameFramework/Pawn.h"
+#include "Engine/World.h"
+
+#include "Utils/CollisionUtils.h"
+#include "TRConstants.h"
+
+#include "Logging/LoggingUtils.h"
+#include "TRCoreLogging.h"
+
+#if TR_DEBUG_ENABLED
+	#include "HAL/IConsoleManager.h"
+	#include "Utils/RandUtils.h"
+#endif
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(PawnSpatialHashSubsystem)
+
+DECLARE_CYCLE_STAT(TEXT("PawnSpatialHashSubsystem::Update"), STAT_PawnSpatialHashSubsystem_Update, STATGROUP_TRCore);
+DECLARE_CYCLE_STAT(TEXT("PawnSpatialHashSubsystem::Query"), STAT_PawnSpatialHashSubsystem_Query, STATGROUP_TRCore);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Spatial Hash Pawns"), STAT_PawnSpatialHashSubsystem_Pawns, STATGROUP_TRCore);
+
+namespace
+{
+	/* A few tank lengths so that typical query radii only touch a handful of cells. */
+	constexpr float CellSize = 2500.0f;
+}
+
+UPawnSpatialHashSubsystem::UPawnSpatialHashSubsystem() : Grid(CellSize)
+{
+}
+
+void UPawnSpatialHashSubsystem::RegisterPawn(APawn& Pawn)
+{
+	const auto bExisting = IsRegistered(Pawn);
+
+	// Use the XY extent of the bounds as the pawn radius for box overlap tests
+	const auto Bounds = TR::CollisionUtils::GetAABB(Pawn);
+	const auto Radius = static_cast<float>(Bounds.GetExtent().Size2D());
+
+	Grid.Add(TObjectKey<APawn>(&Pawn), Pawn.GetActorLocation(), Radius);
+
+	if (!bExisting)
+	{
+		INC_DWORD_STAT(STAT_PawnSpatialHashSubsystem_Pawns);
+	}
+
+	UE_LOG(LogTRCore, Verbose, TEXT("%s: RegisterPawn: %s - Radius=%.1f; %d pawn%s registered"),
+		*GetName(), *Pawn.GetName(), Radius, Grid.Num(), LoggingUtils::Pluralize(Grid.Num()));
+}
+
+void UPawnSpatialHashSubsystem::UnregisterPawn(APawn& Pawn)
+{
+	if (Grid.Remove(TObjectKey<APawn>(&Pawn)))
+	{
+		DEC_DWORD_STAT(STAT_PawnSpatialHashSubsystem_Pawns);
+
+		UE_LOG(LogTRCore, Verbose, TEXT("%s: UnregisterPawn: %s - %d pawn%s registered"),
+			*GetName(), *Pawn.GetName(), Grid.Num(), LoggingUtils::Pluralize(Grid.Num()));
+	}
+}
+
+void UPawnSpatialHashSubsystem::QueryRadius(const FVector& Center, float Radius, TArray<APawn*>& OutPawns) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_PawnSpatialHashSubsystem_Query);
+
+	OutPawns.Reset();
+
+	Grid.ForEachInRadius(Center, Radius, [&](const TObjectKey<APawn>& PawnKey, const FVector&, double)
+	{
+		if (auto Pawn = PawnKey.ResolveObjectPtr(); Pawn)
+		{
+			OutPawns.Add(Pawn);
+		}
+	});
+}
+
+void UPawnSpatialHashSubsystem::QuerySphereOverlap(const FVector& Center, float Radius, TArray<APawn*>& OutPawns) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_PawnSpatialHashSubsystem_Query);
+
+	OutPawns.Reset();
+
+	const auto RadiusSq = FMath::Square(static_cast<double>(Radius));
+
+	// Any pawn whose bounds reach the sphere has its location within the largest pawn radius of it
+	Grid.ForEachInRadius(Center, Radius + Grid.GetMaxElementRadius(), [&](const TObjectKey<APawn>& PawnKey, const FVector&, double DistSq)
+	{
+		auto Pawn = PawnKey.ResolveObjectPtr();
+		if (!Pawn)
+		{
+			return;
+		}
+
+		if (DistSq <= RadiusSq || FMath::SphereAABBIntersection(Center, RadiusSq, TR::CollisionUtils::GetAABB(*Pawn)))
+		{
+			OutPawns.Add(Pawn);
+		}
+	});
+}
+
+void UPawnSpatialHashSubsystem::QueryCone(const FVector& Origin, const FVector& Direction, float MaxDistance, float MinCosine, TArray<APawn*>& OutPawns) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_PawnSpatialHashSubsystem_Query);
+
+	OutPawns.Reset();
+
+	Grid.ForEachInRadius(Origin, MaxDistance, [&](const TObjectKey<APawn>& PawnKey, const FVector& Location, double DistSq)
+	{
+		// Compare against cosine scaled by distance to avoid normalizing
+		const auto Dot = (Location - Origin) | Direction;
+		const auto MinDot = MinCosine * FMath::Sqrt(DistSq);
+
+		if (Dot < MinDot)
+		{
+			return;
+		}
+
+		if (auto Pawn = PawnKey.ResolveObjectPtr(); Pawn)
+		{
+			OutPawns.Add(Pawn);
+		}
+	});
+}
+
+void UPawnSpatialHashSubsystem::QueryNearest(const FVector& Center, int32 Count, float MaxRadius, TArray<APawn*>& OutPawns, const APawn* IgnoredPawn) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_PawnSpatialHashSubsystem_Query);
+
+	TArray<TObjectKey<APawn>> NearestResult;
+	Grid.FindNearest(Center, Count, MaxRadius, [IgnoredPawn](const TObjectKey<APawn>& PawnKey)
+	{
+		const auto Pawn = PawnKey.ResolveObjectPtr();
+		return Pawn && Pawn != IgnoredPawn;
+	}, NearestResult);
+
+	OutPawns.Reset(NearestResult.Num());
+
+	for (const auto& PawnKey : NearestResult)
+	{
+		OutPawns.Add(PawnKey.ResolveObjectPtr());
+	}
+}
+
+void UPawnSpatialHashSubsystem::GetPawns(TArray<APawn*>& OutPawns) const
+{
+	OutPawns.Reset(Grid.Num());
+
+	Grid.ForEach([&](const TObjectKey<APawn>& PawnKey, const FVector&)
+	{
+		if (auto Pawn = PawnKey.ResolveObjectPtr(); Pawn)
+		{
+			OutPawns.Add(Pawn);
+		}
+	});
+}
+
+bool UPawnSpatialHashSubsystem::AnyOverlappingBox(const FBox& Box, TArrayView<AActor* const> IgnoredActors) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_PawnSpatialHashSubsystem_Query);
+
+	return Grid.AnyInBox(Box, [&](const TObjectKey<APawn>& PawnKey, const FVector&)
+	{
+		const auto Pawn = PawnKey.ResolveObjectPtr();
+		return Pawn && !IgnoredActors.Contains(Pawn);
+	});
+}
+
+void UPawnSpatialHashSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_PawnSpatialHashSubsystem_Update);
+
+	Super::Tick(DeltaTime);
+
+	// Pawns that are destroyed without going through the tank destroyed event are removed here
+	Grid.ForEach([this](const TObjectKey<APawn>& PawnKey, const FVector&)
+	{
+		if (!PawnKey.ResolveObjectPtr())
+		{
+			StalePawns.Add(PawnKey);
+		}
+	});
+
+	for (const auto& PawnKey : StalePawns)
+	{
+		Grid.Remove(PawnKey);
+		DEC_DWORD_STAT(STAT_PawnSpatialHashSubsystem_Pawns);
+	}
+
+	if (!StalePawns.IsEmpty())
+	{
+		UE_LOG(LogTRCore, Verbose, TEXT("%s: Tick - Removed %d stale pawn%s"), *GetName(), StalePawns.Num(), LoggingUtils::Pluralize(StalePawns.Num()));
+		StalePawns.Reset();
+	}
+
+	// Grid only stores the element so collect the updates first as updating can reorder cells
+	TArray<TPair<TObjectKey<APawn>, FVector>, TInlineAllocator<256>> Updates;
+	Updates.Reserve(Grid.Num());
+
+	Grid.ForEach([&Updates](const TObjectKey<APawn>& PawnKey, const FVector&)
+	{
+		auto Pawn = PawnKey.ResolveObjectPtr();
+		Updates.Emplace(PawnKey, Pawn->GetActorLocation());
+	});
+
+	for (const auto& [PawnKey, Location] : Updates)
+	{
+		Grid.Update(PawnKey, Location);
+	}
+}
+
+bool UPawnSpatialHashSubsystem::IsTickable() const
+{
+	return !Grid.IsEmpty();
+}
+
+TStatId UPawnSpatialHashSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UPawnSpatialHashSubsystem, STATGROUP_Tickables);
+}
+
+void UPawnSpatialHashSubsystem::Deinitialize()
+{
+	DEC_DWORD_STAT_BY(STAT_PawnSpatialHashSubsystem_Pawns, Grid.Num());
+
+	Grid.Reset();
+	StalePawns.Reset();
+
+	Super::Deinitialize();
+}
+
+#pragma region Benchmark
+
+#if TR_DEBUG_ENABLED
+
+namespace
+{
+	/*
+	* Compares spatial hash radius and nearest queries against the physics overlap queries they replace using the pawns registered in the current world.
+	* Spawn the number of tanks to compare first, e.g. 50, 200 and 1000.
+	*/
+	void RunSpatialHashBenchmark(const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World)
+		{
+			return;
+		}
+
+		auto Subsystem = World->GetSubsystem<UPawnSpatialHashSubsystem>();
+		if (!Subsystem || Subsystem->Num() == 0)
+		{
+			UE_LOG(LogTRCore, Warning, TEXT("RunSpatialHashBenchmark: No pawns registered"));
+			return;
+		}
+
+		const int32 QueryCount = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 1000;
+		const float Radius = Args.Num() > 1 ? FCString::Atof(*Args[1]) : 5000.0f;
+
+		// Sample query centers around the registered pawns
+		TArray<APawn*> Pawns;
+		Subsystem->GetPawns(Pawns);
+
+		if (Pawns.IsEmpty())
+		{
+			return;
+		}
+
+		FRandomStream Rng(RandUtils::GenerateSeed());
+
+		TArray<FVector> Centers;
+		Centers.Reserve(QueryCount);
+
+		for (int32 i = 0; i < QueryCount; ++i)
+		{
+			Centers.Add(Pawns[Rng.RandHelper(Pawns.Num())]->GetActorLocation() + Rng.GetUnitVector() * Radius * 0.5f);
+		}
+
+		TArray<APawn*> Results;
+		int64 HashResultCount{};
+
+		const auto HashStartTime = FPlatformTime::Seconds();
+		for (const auto& Center : Centers)
+		{
+			Subsystem->QueryRadius(Center, Radius, Results);
+			HashResultCount += Results.Num();
+		}
+		const auto HashSeconds = FPlatformTime::Seconds() - HashStartTime;
+
+		const auto NearestStartTime = FPlatformTime::Seconds();
+		for (const auto& Center : Centers)
+		{
+			Subsystem->QueryNearest(Center, 5, Radius, Results);
+		}
+		const auto NearestSeconds = FPlatformTime::Seconds() - NearestStartTime;
+
+		const FCollisionShape Shape = FCollisionShape::MakeSphere(Radius);
+		TArray<FOverlapResult> Overlaps;
+		int64 OverlapResultCount{};
+
+		const auto OverlapStartTime = FPlatformTime::Seconds();
+		for (const auto& Center : Centers)
+		{
+			World->OverlapMultiByObjectType(Overlaps, Center, FQuat::Identity, ECollisionChannel::ECC_Pawn, Shape);
+			OverlapResultCount += Overlaps.Num();
+		}
+		const auto OverlapSeconds = FPlatformTime::Seconds() - OverlapStartTime;
+
+		UE_LOG(LogTRCore, Display,
+			TEXT("RunSpatialHashBenchmark: Pawns=%d; Queries=%d; Radius=%.1fm - HashRadius=%.3fus/query (%lld results); HashNearest5=%.3fus/query; PhysicsOverlap=%.3fus/query (%lld results)"),
+			Subsystem->Num(), QueryCount, Radius / 100,
+			HashSeconds * 1e6 / QueryCount, HashResultCount,
+			NearestSeconds * 1e6 / QueryCount,
+			OverlapSeconds * 1e6 / QueryCount, OverlapResultCount);
+	}
+
+	FAutoConsoleCommandWithWorldAndArgs SpatialHashBenchmarkCommand(
+		TEXT("tr.core.spatialHash.benchmark"),
+		TEXT("Times spatial hash pawn queries against physics overlaps: [QueryCount=1000] [RadiusCm=5000]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunSpatialHashBenchmark));
+}
+
+#endif
+
+#pragma endregion Benchmark
@@ -14,6 +14,11 @@ void URealtimeTimerSubsystem::Tick(float DeltaTime)
 
 	Super::Tick(DeltaTime);
 
+	if (auto World = GetWorld(); World)
+	{
+		TimerWheel.Advance(World->GetRealTimeSeconds());
+	}
+
 	if (RealTimeTimerDelegate.IsBound())
 	{
 		TickDelegates(DeltaTime);
@@ -36,6 +41,8 @@ void URealtimeTimerSubsystem::OnWorldBeginPlay(UWorld& InWorld)
 
 void URealtimeTimerSubsystem::Deinitialize()
 {
+	TimerWheel.Reset();
+
 	Super::Deinitialize();
 }
 
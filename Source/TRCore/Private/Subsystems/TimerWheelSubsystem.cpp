@@ -0,0 +1,43 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/TimerWheelSubsystem.h"
+
+#include "Engine/World.h"
+
+#include "Logging/LoggingUtils.h"
+#include "TRCoreLogging.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(TimerWheelSubsystem)
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Timer Wheel Game Timers"), STAT_TimerWheelSubsystem_Timers, STATGROUP_TRCore);
+
+void UTimerWheelSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	auto World = GetWorld();
+	check(World);
+
+	// Always advanced even when empty so that the wheel time is current for timers set during the next frame
+	const auto FiredCount = TimerWheel.Advance(World->GetTimeSeconds());
+
+	SET_DWORD_STAT(STAT_TimerWheelSubsystem_Timers, TimerWheel.Num());
+
+	UE_LOG(LogTRCore, VeryVerbose, TEXT("%s: Tick - Fired %d timer%s; %d pending"),
+		*GetName(), FiredCount, LoggingUtils::Pluralize(FiredCount), TimerWheel.Num());
+}
+
+TStatId UTimerWheelSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTimerWheelSubsystem, STATGROUP_Tickables);
+}
+
+void UTimerWheelSubsystem::Deinitialize()
+{
+	TimerWheel.Reset();
+
+	SET_DWORD_STAT(STAT_TimerWheelSubsystem_Timers, 0);
+
+	Super::Deinitialize();
+}
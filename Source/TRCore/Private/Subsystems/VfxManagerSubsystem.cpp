@@ -0,0 +1,393 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/VfxManagerSubsystem.h"
+
+#include "NiagaraFunctionLibrary.h"
+#include "NiagaraComponent.h"
+#include "NiagaraSystem.h"
+
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/World.h"
+
+#include "Debug/TRConsoleVars.h"
+
+#include "Logging/LoggingUtils.h"
+#include "TRCoreLogging.h"
+
+#if TR_DEBUG_ENABLED
+	#include "HAL/IConsoleManager.h"
+	#include "Utils/RandUtils.h"
+#endif
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(VfxManagerSubsystem)
+
+DECLARE_CYCLE_STAT(TEXT("VfxManagerSubsystem::Flush"), STAT_VfxManagerSubsystem_Flush, STATGROUP_TRCore);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Vfx Requests"), STAT_VfxManagerSubsystem_Requested, STATGROUP_TRCore);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Vfx Issued"), STAT_VfxManagerSubsystem_Issued, STATGROUP_TRCore);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Vfx Culled"), STAT_VfxManagerSubsystem_Culled, STATGROUP_TRCore);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Vfx Deferred"), STAT_VfxManagerSubsystem_Deferred, STATGROUP_TRCore);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Vfx Dropped"), STAT_VfxManagerSubsystem_Dropped, STATGROUP_TRCore);
+
+namespace
+{
+	/* Maximum distance from the view for each priority. Critical effects are never culled. */
+	constexpr double CullDistances[] =
+	{
+		8000.0,  // Low
+		15000.0, // Normal
+		30000.0, // High
+		0.0,     // Critical
+	};
+
+	static_assert(UE_ARRAY_COUNT(CullDistances) == static_cast<int32>(EVfxPriority::MAX), "CullDistances must have a distance for each EVfxPriority");
+
+	/* Deferred requests still waiting after this many frames are dropped as the effect would be visibly late. */
+	constexpr uint64 MaxDeferredFrames = 3;
+}
+
+void UVfxManagerSubsystem::SpawnVfx(FVfxSpawnRequest&& Request)
+{
+	if (!ensure(Request.System.IsValid()))
+	{
+		return;
+	}
+
+	++Counters.Requested;
+	INC_DWORD_STAT(STAT_VfxManagerSubsystem_Requested);
+
+	if (!IsEnabled())
+	{
+		// Manager disabled: spawn as it comes in like UNiagaraFunctionLibrary
+		IssueRequest(Request, false);
+		return;
+	}
+
+	PendingRequests.Add(FPendingVfx
+	{
+		.Request = MoveTemp(Request),
+		.RequestFrame = GFrameCounter
+	});
+}
+
+int32 UVfxManagerSubsystem::FlushPendingVfx()
+{
+	SCOPE_CYCLE_COUNTER(STAT_VfxManagerSubsystem_Flush);
+
+	if (PendingRequests.IsEmpty())
+	{
+		return 0;
+	}
+
+	// Move out as spawn callbacks could queue more requests
+	auto Requests = MoveTemp(PendingRequests);
+	PendingRequests.Reset();
+
+	const auto ViewLocation = GetViewLocation();
+
+	int32 CulledCount{};
+
+	for (int32 i = Requests.Num() - 1; i >= 0; --i)
+	{
+		auto& Pending = Requests[i];
+
+		if (!Pending.Request.System.IsValid())
+		{
+			Requests.RemoveAtSwap(i, 1, false);
+			continue;
+		}
+
+		Pending.ViewDistanceSq = ViewLocation ? FVector::DistSquared(*ViewLocation, GetRequestLocation(Pending.Request)) : 0.0;
+
+		const auto Priority = Pending.Request.Priority;
+		if (Priority != EVfxPriority::Critical && Pending.ViewDistanceSq > FMath::Square(CullDistances[static_cast<int32>(Priority)]))
+		{
+			++CulledCount;
+			Requests.RemoveAtSwap(i, 1, false);
+		}
+	}
+
+	// Highest priority then nearest first
+	Requests.Sort([](const FPendingVfx& First, const FPendingVfx& Second)
+	{
+		if (First.Request.Priority != Second.Request.Priority)
+		{
+			return First.Request.Priority > Second.Request.Priority;
+		}
+		return First.ViewDistanceSq < Second.ViewDistanceSq;
+	});
+
+	const auto SpawnBudget = GetSpawnBudget();
+
+	int32 IssuedCount{};
+	int32 BudgetedIssuedCount{};
+	int32 DeferredCount{};
+	int32 DroppedCount{};
+
+	TArray<FPendingVfx> DeferredRequests;
+
+	for (auto& Pending : Requests)
+	{
+		const bool bCritical = Pending.Request.Priority == EVfxPriority::Critical;
+
+		if (!bCritical && BudgetedIssuedCount >= SpawnBudget)
+		{
+			if (Pending.Request.Priority == EVfxPriority::Low || GFrameCounter - Pending.RequestFrame >= MaxDeferredFrames)
+			{
+				++DroppedCount;
+			}
+			else
+			{
+				++DeferredCount;
+				DeferredRequests.Add(MoveTemp(Pending));
+			}
+			continue;
+		}
+
+		IssueRequest(Pending.Request, true);
+
+		++IssuedCount;
+		if (!bCritical)
+		{
+			++BudgetedIssuedCount;
+		}
+	}
+
+	// Deferred requests go ahead of any queued by the spawn callbacks
+	DeferredRequests.Append(MoveTemp(PendingRequests));
+	PendingRequests = MoveTemp(DeferredRequests);
+
+	Counters.Culled += CulledCount;
+	Counters.Deferred += DeferredCount;
+	Counters.Dropped += DroppedCount;
+	Counters.MaxIssuedInFrame = FMath::Max(Counters.MaxIssuedInFrame, BudgetedIssuedCount);
+	++Counters.Frames;
+
+	INC_DWORD_STAT_BY(STAT_VfxManagerSubsystem_Culled, CulledCount);
+	INC_DWORD_STAT_BY(STAT_VfxManagerSubsystem_Deferred, DeferredCount);
+	INC_DWORD_STAT_BY(STAT_VfxManagerSubsystem_Dropped, DroppedCount);
+
+	UE_LOG(LogTRCore, VeryVerbose, TEXT("%s: FlushPendingVfx - Issued=%d; Culled=%d; Deferred=%d; Dropped=%d; SpawnBudget=%d"),
+		*GetName(), IssuedCount, CulledCount, DeferredCount, DroppedCount, SpawnBudget);
+
+	return IssuedCount;
+}
+
+bool UVfxManagerSubsystem::IsEnabled()
+{
+	return TR::CVarVfxManagerEnabled.GetValueOnGameThread();
+}
+
+int32 UVfxManagerSubsystem::GetSpawnBudget()
+{
+	return FMath::Max(1, TR::CVarVfxSpawnBudget.GetValueOnGameThread());
+}
+
+void UVfxManagerSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	FlushPendingVfx();
+}
+
+bool UVfxManagerSubsystem::IsTickable() const
+{
+	return !PendingRequests.IsEmpty();
+}
+
+TStatId UVfxManagerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UVfxManagerSubsystem, STATGROUP_Tickables);
+}
+
+void UVfxManagerSubsystem::Deinitialize()
+{
+	PendingRequests.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UVfxManagerSubsystem::IssueRequest(const FVfxSpawnRequest& Request, bool bPooled)
+{
+	auto System = Request.System.Get();
+	if (!System)
+	{
+		return false;
+	}
+
+	++Counters.Issued;
+	INC_DWORD_STAT(STAT_VfxManagerSubsystem_Issued);
+
+	// Auto release returns the component to the pool of the system asset when the effect completes
+	const auto PoolMethod = bPooled ? ENCPoolMethod::AutoRelease : ENCPoolMethod::None;
+
+	UNiagaraComponent* NiagaraComponent{};
+
+	if (auto AttachComponent = Request.AttachComponent.Get(); AttachComponent)
+	{
+		NiagaraComponent = UNiagaraFunctionLibrary::SpawnSystemAttached(System, AttachComponent, Request.AttachSocketName, Request.Location, Request.Rotation,
+			Request.Scale, EAttachLocation::KeepRelativeOffset, true, PoolMethod, true);
+	}
+	else
+	{
+		NiagaraComponent = UNiagaraFunctionLibrary::SpawnSystemAtLocation(this, System, Request.Location, Request.Rotation, Request.Scale, true, true, PoolMethod);
+	}
+
+	if (!NiagaraComponent)
+	{
+		// Not an error as Niagara culls systems that would not be visible, e.g. by the system's own scalability settings
+		UE_LOG(LogTRCore, Verbose, TEXT("%s: IssueRequest - Niagara did not spawn %s at %s"),
+			*GetName(), *System->GetName(), *GetRequestLocation(Request).ToCompactString());
+		return false;
+	}
+
+	++Counters.Spawned;
+
+	Request.OnSpawned.ExecuteIfBound(*NiagaraComponent);
+
+	return true;
+}
+
+TOptional<FVector> UVfxManagerSubsystem::GetViewLocation() const
+{
+	auto World = GetWorld();
+	check(World);
+
+	auto PlayerController = World->GetFirstPlayerController();
+	if (!PlayerController || !PlayerController->PlayerCameraManager)
+	{
+		return {};
+	}
+
+	return PlayerController->PlayerCameraManager->GetCameraLocation();
+}
+
+FVector UVfxManagerSubsystem::GetRequestLocation(const FVfxSpawnRequest& Request)
+{
+	if (auto AttachComponent = Request.AttachComponent.Get(); AttachComponent)
+	{
+		return AttachComponent->GetSocketLocation(Request.AttachSocketName);
+	}
+
+	return Request.Location;
+}
+
+#pragma region Verification
+
+#if TR_DEBUG_ENABLED
+
+namespace
+{
+	/*
+	* Queues a scripted barrage of requests at random distances and priorities over a number of frames and checks that no frame issues more
+	* than the spawn budget of non-critical effects and that every request is accounted for. Runs under -nullrhi as only the counters are checked.
+	*/
+	void RunVfxBarrageVerification(const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World)
+		{
+			return;
+		}
+
+		auto Subsystem = World->GetSubsystem<UVfxManagerSubsystem>();
+		if (!Subsystem || !UVfxManagerSubsystem::IsEnabled())
+		{
+			UE_LOG(LogTRCore, Warning, TEXT("RunVfxBarrageVerification: Vfx manager is not available or tr.vfx.enabled is 0"));
+			return;
+		}
+
+		const int32 RequestsPerFrame = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 100;
+		const int32 FrameCount = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 10;
+
+		// Any system will do as only the budget is checked
+		auto System = NewObject<UNiagaraSystem>(GetTransientPackage(), TEXT("VfxBarrageVerifySystem"));
+
+		FRandomStream Rng(RandUtils::GenerateSeed());
+
+		// Flush anything already queued so that only the barrage is counted
+		while (Subsystem->NumPending() > 0)
+		{
+			Subsystem->FlushPendingVfx();
+		}
+
+		Subsystem->ResetCounters();
+
+		const auto SpawnBudget = UVfxManagerSubsystem::GetSpawnBudget();
+
+		FVector ViewLocation{ EForceInit::ForceInitToZero };
+		if (auto PlayerController = World->GetFirstPlayerController(); PlayerController && PlayerController->PlayerCameraManager)
+		{
+			ViewLocation = PlayerController->PlayerCameraManager->GetCameraLocation();
+		}
+
+		int32 CriticalCount{};
+		int32 Failures{};
+
+		for (int32 Frame = 0; Frame < FrameCount; ++Frame)
+		{
+			int32 FrameCriticalCount{};
+
+			for (int32 i = 0; i < RequestsPerFrame; ++i)
+			{
+				const auto Priority = static_cast<EVfxPriority>(Rng.RandRange(0, static_cast<int32>(EVfxPriority::MAX) - 1));
+				FrameCriticalCount += Priority == EVfxPriority::Critical;
+
+				Subsystem->SpawnVfx(FVfxSpawnRequest
+				{
+					.System = System,
+					.Location = ViewLocation + Rng.GetUnitVector() * Rng.FRandRange(0.0f, 40000.0f),
+					.Priority = Priority
+				});
+			}
+
+			CriticalCount += FrameCriticalCount;
+
+			// Critical requests are never deferred so are all issued in the frame they are requested
+			const auto Issued = Subsystem->FlushPendingVfx();
+			if (Issued > SpawnBudget + FrameCriticalCount)
+			{
+				++Failures;
+				UE_LOG(LogTRCore, Error, TEXT("RunVfxBarrageVerification: Frame %d issued %d > SpawnBudget=%d + Critical=%d"),
+					Frame, Issued, SpawnBudget, FrameCriticalCount);
+			}
+		}
+
+		// Let the deferred requests drain
+		for (uint64 Frame = 0; Frame <= MaxDeferredFrames && Subsystem->NumPending() > 0; ++Frame)
+		{
+			Subsystem->FlushPendingVfx();
+		}
+
+		const auto& Counters = Subsystem->GetCounters();
+
+		// Deferred requests are counted each time they are deferred so are not part of the total
+		const auto Accounted = Counters.Issued + Counters.Culled + Counters.Dropped + Subsystem->NumPending();
+
+		if (Counters.MaxIssuedInFrame > SpawnBudget)
+		{
+			++Failures;
+			UE_LOG(LogTRCore, Error, TEXT("RunVfxBarrageVerification: MaxIssuedInFrame=%d > SpawnBudget=%d"), Counters.MaxIssuedInFrame, SpawnBudget);
+		}
+
+		if (Accounted != Counters.Requested)
+		{
+			++Failures;
+			UE_LOG(LogTRCore, Error, TEXT("RunVfxBarrageVerification: Requested=%d but Issued+Culled+Dropped+Pending=%d"), Counters.Requested, Accounted);
+		}
+
+		UE_LOG(LogTRCore, Display,
+			TEXT("RunVfxBarrageVerification: %s - Requested=%d; Issued=%d; Spawned=%d; Culled=%d; Deferred=%d; Dropped=%d; Critical=%d; MaxIssuedInFrame=%d; SpawnBudget=%d; Frames=%d"),
+			Failures == 0 ? TEXT("PASSED") : TEXT("FAILED"), Counters.Requested, Counters.Issued, Counters.Spawned, Counters.Culled, Counters.Deferred,
+			Counters.Dropped, CriticalCount, Counters.MaxIssuedInFrame, SpawnBudget, Counters.Frames);
+	}
+
+	FAutoConsoleCommandWithWorldAndArgs VfxBarrageVerifyCommand(
+		TEXT("tr.core.vfx.verifyBarrage"),
+		TEXT("Checks the vfx spawn budget under a scripted barrage using the manager counters. Can run with -nullrhi: [RequestsPerFrame=100] [Frames=10]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunVfxBarrageVerification));
+}
+
+#endif
+
+#pragma endregion Verification
@@ -11,3 +11,6 @@
 #else
 	DECLARE_LOG_CATEGORY_EXTERN(LogTRCore, Display, All);
 #endif
+
+// Stat groups
+DECLARE_STATS_GROUP(TEXT("TRCore"), STATGROUP_TRCore, STATCAT_Advanced);
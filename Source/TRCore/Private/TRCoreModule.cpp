@@ -3,8 +3,12 @@
 #include "Modules/ModuleManager.h"
 
 #include "TRCoreLogging.h"
+#include "Debug/TRCsvProfiler.h"
 
 IMPLEMENT_MODULE( FDefaultModuleImpl, TRCore );
 
 // Logging
 DEFINE_LOG_CATEGORY(LogTRCore);
+
+// Profiling
+CSV_DEFINE_CATEGORY_MODULE(TRCORE_API, TR, false);
@@ -0,0 +1,270 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/AudioDispatchSubsystem.h"
+
+#include "Debug/TRConsoleVars.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Misc/AutomationTest.h"
+#include "Sound/SoundWave.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace AudioDispatchSubsystemTests
+{
+	constexpr auto TestFlags = EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter;
+
+	/* Merged voices are capped at twice the volume of their loudest request. */
+	constexpr float MaxMergedVolume = 2.0f;
+
+	/* Further apart than the coalescing radius so requests are never merged. */
+	constexpr float SeparateDistance = 2000.0f;
+
+	/*
+	* Transient world with a player controller as the listener that records voices instead of playing them.
+	* Time does not advance so every voice started stays active and within the coalescing window.
+	*/
+	struct FTestWorld
+	{
+		UWorld* World{};
+		UAudioDispatchSubsystem* Subsystem{};
+		FVector ListenerLocation{ EForceInit::ForceInitToZero };
+
+		const bool bWasRecording{ TR::CVarAudioDispatchRecord.GetValueOnGameThread() };
+		const bool bWasEnabled{ TR::CVarAudioDispatchEnabled.GetValueOnGameThread() };
+
+		FTestWorld()
+		{
+			TR::CVarAudioDispatchRecord->Set(true, ECVF_SetByConsole);
+			TR::CVarAudioDispatchEnabled->Set(true, ECVF_SetByConsole);
+
+			World = UWorld::CreateWorld(EWorldType::Game, false);
+			Subsystem = World->GetSubsystem<UAudioDispatchSubsystem>();
+
+			if (auto PlayerController = World->SpawnActor<APlayerController>(); PlayerController)
+			{
+				FVector FrontDirection, RightDirection;
+				PlayerController->GetAudioListenerPosition(ListenerLocation, FrontDirection, RightDirection);
+			}
+		}
+
+		~FTestWorld()
+		{
+			World->DestroyWorld(false);
+
+			TR::CVarAudioDispatchRecord->Set(bWasRecording, ECVF_SetByConsole);
+			TR::CVarAudioDispatchEnabled->Set(bWasEnabled, ECVF_SetByConsole);
+		}
+
+		bool IsValid(FAutomationTestBase& Test) const
+		{
+			return Test.TestNotNull(TEXT("Subsystem"), Subsystem) && Test.TestNotNull(TEXT("Listener"), World->GetFirstPlayerController());
+		}
+
+		void PlaySfx(USoundBase* Sound, ESfxCategory Category, const FVector& Offset, float Volume = 1.0f) const
+		{
+			Subsystem->PlaySfx(FOneShotSfxRequest
+			{
+				.Sound = Sound,
+				.Location = ListenerLocation + Offset,
+				.Volume = Volume,
+				.Category = Category
+			});
+		}
+	};
+
+	USoundWave* MakeSound()
+	{
+		return NewObject<USoundWave>(GetTransientPackage());
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAudioDispatchSubsystemMergeTest, "TankRampage.TRCore.AudioDispatchSubsystem.Merge", AudioDispatchSubsystemTests::TestFlags)
+
+bool FAudioDispatchSubsystemMergeTest::RunTest(const FString& Parameters)
+{
+	using namespace AudioDispatchSubsystemTests;
+
+	const FTestWorld TestWorld;
+	if (!TestWorld.IsValid(*this))
+	{
+		return true;
+	}
+
+	const auto Subsystem = TestWorld.Subsystem;
+	const auto& Recorded = Subsystem->GetRecordedSfx();
+
+	// Pileup of impacts in one place merges into one louder voice
+	const auto BurstSound = MakeSound();
+	constexpr int32 BurstCount = 40;
+
+	for (int32 i = 0; i < BurstCount; ++i)
+	{
+		TestWorld.PlaySfx(BurstSound, ESfxCategory::Impact, FVector(1000.0 + i, i, 0.0));
+	}
+
+	TestEqual(TEXT("Burst voices started"), Subsystem->FlushPendingSfx(), 1);
+
+	if (!TestEqual(TEXT("Burst voices recorded"), Recorded.Num(), 1))
+	{
+		return true;
+	}
+
+	TestEqual(TEXT("Burst merged count"), Recorded[0].MergedCount, BurstCount);
+	TestEqual(TEXT("Burst volume capped"), Recorded[0].Volume, MaxMergedVolume, UE_KINDA_SMALL_NUMBER);
+	TestEqual(TEXT("Burst location averaged"), Recorded[0].Location, TestWorld.ListenerLocation + FVector(1000.0 + (BurstCount - 1) / 2.0, (BurstCount - 1) / 2.0, 0.0), 0.01f);
+
+	// Requests on a later frame within the coalescing window raise the voice already playing by their energy rather than starting another
+	const auto RepeatSound = MakeSound();
+
+	TestWorld.PlaySfx(RepeatSound, ESfxCategory::Impact, FVector(1000.0, 0.0, 0.0), 0.5f);
+	TestEqual(TEXT("First repeat started"), Subsystem->FlushPendingSfx(), 1);
+
+	TestWorld.PlaySfx(RepeatSound, ESfxCategory::Impact, FVector(1050.0, 0.0, 0.0), 0.5f);
+	TestEqual(TEXT("Second repeat started"), Subsystem->FlushPendingSfx(), 0);
+
+	if (!TestEqual(TEXT("Repeat voices recorded"), Recorded.Num(), 2))
+	{
+		return true;
+	}
+
+	TestEqual(TEXT("Repeat merged count"), Recorded[1].MergedCount, 2);
+	TestEqual(TEXT("Repeat volume raised by energy"), Recorded[1].Volume, FMath::Sqrt(2 * FMath::Square(0.5f)), UE_KINDA_SMALL_NUMBER);
+
+	// Too far away or a different category to merge
+	TestWorld.PlaySfx(RepeatSound, ESfxCategory::Impact, FVector(1000.0 + SeparateDistance, 0.0, 0.0));
+	TestWorld.PlaySfx(RepeatSound, ESfxCategory::Weapon, FVector(1000.0, 0.0, 0.0));
+
+	TestEqual(TEXT("Separate voices started"), Subsystem->FlushPendingSfx(), 2);
+	TestEqual(TEXT("Repeat voice unchanged"), Recorded[1].MergedCount, 2);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAudioDispatchSubsystemBudgetTest, "TankRampage.TRCore.AudioDispatchSubsystem.Budget", AudioDispatchSubsystemTests::TestFlags)
+
+bool FAudioDispatchSubsystemBudgetTest::RunTest(const FString& Parameters)
+{
+	using namespace AudioDispatchSubsystemTests;
+
+	const FTestWorld TestWorld;
+	if (!TestWorld.IsValid(*this))
+	{
+		return true;
+	}
+
+	const auto Subsystem = TestWorld.Subsystem;
+	const auto& Recorded = Subsystem->GetRecordedSfx();
+
+	const auto ExplosionSound = MakeSound();
+	const auto ExplosionBudget = UAudioDispatchSubsystem::GetVoiceBudget(ESfxCategory::Explosion);
+
+	// Queued furthest first so the nearest first order comes from the dispatch
+	for (int32 i = ExplosionBudget + 4; i > 0; --i)
+	{
+		TestWorld.PlaySfx(ExplosionSound, ESfxCategory::Explosion, FVector(0.0, SeparateDistance * i, 0.0));
+	}
+
+	TestEqual(TEXT("Explosions started"), Subsystem->FlushPendingSfx(), ExplosionBudget);
+
+	if (!TestEqual(TEXT("Explosions recorded"), Recorded.Num(), ExplosionBudget))
+	{
+		return true;
+	}
+
+	for (int32 i = 0; i < Recorded.Num(); ++i)
+	{
+		TestEqual(*FString::Printf(TEXT("Explosion %d is the next nearest"), i), Recorded[i].ListenerDistance, SeparateDistance * (i + 1), 1.0f);
+	}
+
+	// Other categories have budgets of their own
+	TestWorld.PlaySfx(MakeSound(), ESfxCategory::Item, FVector(0.0, SeparateDistance * 100, 0.0));
+	TestEqual(TEXT("Item started with explosions over budget"), Subsystem->FlushPendingSfx(), 1);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAudioDispatchSubsystemStealTest, "TankRampage.TRCore.AudioDispatchSubsystem.Steal", AudioDispatchSubsystemTests::TestFlags)
+
+bool FAudioDispatchSubsystemStealTest::RunTest(const FString& Parameters)
+{
+	using namespace AudioDispatchSubsystemTests;
+
+	const FTestWorld TestWorld;
+	if (!TestWorld.IsValid(*this))
+	{
+		return true;
+	}
+
+	const auto Subsystem = TestWorld.Subsystem;
+	const auto& Recorded = Subsystem->GetRecordedSfx();
+
+	const auto ExplosionSound = MakeSound();
+	const auto ExplosionBudget = UAudioDispatchSubsystem::GetVoiceBudget(ESfxCategory::Explosion);
+
+	for (int32 i = 1; i <= ExplosionBudget; ++i)
+	{
+		TestWorld.PlaySfx(ExplosionSound, ESfxCategory::Explosion, FVector(0.0, SeparateDistance * i, 0.0));
+	}
+
+	TestEqual(TEXT("Budget filled"), Subsystem->FlushPendingSfx(), ExplosionBudget);
+
+	// Further than every playing voice so there is nothing to take the place of
+	TestWorld.PlaySfx(ExplosionSound, ESfxCategory::Explosion, FVector(0.0, SeparateDistance * (ExplosionBudget + 1), 0.0));
+	TestEqual(TEXT("Further explosion started"), Subsystem->FlushPendingSfx(), 0);
+
+	// Nearer than the furthest playing voice so takes its place
+	TestWorld.PlaySfx(ExplosionSound, ESfxCategory::Explosion, FVector(0.0, -SeparateDistance / 2, 0.0));
+	TestEqual(TEXT("Nearer explosion started"), Subsystem->FlushPendingSfx(), 1);
+
+	if (!TestEqual(TEXT("Explosions recorded"), Recorded.Num(), ExplosionBudget + 1))
+	{
+		return true;
+	}
+
+	TestEqual(TEXT("Nearer explosion distance"), Recorded.Last().ListenerDistance, SeparateDistance / 2, 1.0f);
+
+	// The stolen voice is no longer playing so this is further than every voice that is
+	TestWorld.PlaySfx(ExplosionSound, ESfxCategory::Explosion, FVector(0.0, SeparateDistance * (ExplosionBudget - 0.5f), 0.0));
+	TestEqual(TEXT("Explosion nearer than the stolen voice started"), Subsystem->FlushPendingSfx(), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAudioDispatchSubsystemDisabledTest, "TankRampage.TRCore.AudioDispatchSubsystem.Disabled", AudioDispatchSubsystemTests::TestFlags)
+
+bool FAudioDispatchSubsystemDisabledTest::RunTest(const FString& Parameters)
+{
+	using namespace AudioDispatchSubsystemTests;
+
+	const FTestWorld TestWorld;
+	if (!TestWorld.IsValid(*this))
+	{
+		return true;
+	}
+
+	TR::CVarAudioDispatchEnabled->Set(false, ECVF_SetByConsole);
+
+	const auto Subsystem = TestWorld.Subsystem;
+	const auto& Recorded = Subsystem->GetRecordedSfx();
+
+	// Every request plays right away without merging
+	const auto ImpactSound = MakeSound();
+
+	TestWorld.PlaySfx(ImpactSound, ESfxCategory::Impact, FVector(1000.0, 0.0, 0.0));
+	TestWorld.PlaySfx(ImpactSound, ESfxCategory::Impact, FVector(1000.0, 0.0, 0.0));
+
+	TestEqual(TEXT("Started without a flush"), Recorded.Num(), 2);
+	TestEqual(TEXT("Nothing queued"), Subsystem->FlushPendingSfx(), 0);
+
+	for (const auto& Sfx : Recorded)
+	{
+		TestEqual(TEXT("Listener distance"), Sfx.ListenerDistance, 1000.0f, 1.0f);
+		TestEqual(TEXT("Merged count"), Sfx.MergedCount, 1);
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,108 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Containers/IndexedMinHeap.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace IndexedMinHeapTests
+{
+	constexpr auto TestFlags = EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FIndexedMinHeapUpdateTest, "TankRampage.TRCore.IndexedMinHeap.Update", IndexedMinHeapTests::TestFlags)
+
+bool FIndexedMinHeapUpdateTest::RunTest(const FString& Parameters)
+{
+	TR::TIndexedMinHeap<int32> Heap;
+
+	TestTrue(TEXT("Starts empty"), Heap.IsEmpty());
+
+	TestTrue(TEXT("Add 1"), Heap.AddOrUpdate(1, 5.0f));
+	TestTrue(TEXT("Add 2"), Heap.AddOrUpdate(2, 3.0f));
+	TestTrue(TEXT("Add 3"), Heap.AddOrUpdate(3, 4.0f));
+	TestEqual(TEXT("Top after adds"), Heap.Top(), 2);
+
+	// Extending the stun of the first to expire moves it to the back
+	TestFalse(TEXT("Update 2 is not an add"), Heap.AddOrUpdate(2, 10.0f));
+	TestEqual(TEXT("Num after update"), Heap.Num(), 3);
+	TestEqual(TEXT("Top after increase"), Heap.Top(), 3);
+
+	Heap.AddOrUpdate(1, 1.0f);
+	TestEqual(TEXT("Top after decrease"), Heap.Top(), 1);
+	TestEqual(TEXT("Top priority"), Heap.TopPriority(), 1.0f);
+
+	if (const auto Priority = Heap.FindPriority(2); TestNotNull(TEXT("Priority of 2"), Priority))
+	{
+		TestEqual(TEXT("Updated priority of 2"), *Priority, 10.0f);
+	}
+
+	TestTrue(TEXT("Remove 3"), Heap.Remove(3));
+	TestFalse(TEXT("Remove 3 again"), Heap.Remove(3));
+	TestFalse(TEXT("Contains 3"), Heap.Contains(3));
+
+	TestEqual(TEXT("First pop"), Heap.Pop(), 1);
+	TestEqual(TEXT("Second pop"), Heap.Pop(), 2);
+	TestTrue(TEXT("Empty after pops"), Heap.IsEmpty());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FIndexedMinHeapOrderTest, "TankRampage.TRCore.IndexedMinHeap.Order", IndexedMinHeapTests::TestFlags)
+
+bool FIndexedMinHeapOrderTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 KeyCount = 200;
+
+	TR::TIndexedMinHeap<int32> Heap;
+	TMap<int32, float> Expected;
+
+	FRandomStream Rng(1234);
+
+	// Random adds, updates and removes against a map of the expected priorities
+	for (int32 i = 0; i < 5 * KeyCount; ++i)
+	{
+		const auto Key = Rng.RandRange(0, KeyCount - 1);
+
+		if (Rng.FRand() < 0.2f)
+		{
+			TestEqual(*FString::Printf(TEXT("Remove %d"), Key), Heap.Remove(Key), Expected.Remove(Key) > 0);
+		}
+		else
+		{
+			const auto Priority = Rng.FRandRange(0.0f, 100.0f);
+
+			TestEqual(*FString::Printf(TEXT("AddOrUpdate %d"), Key), Heap.AddOrUpdate(Key, Priority), !Expected.Contains(Key));
+			Expected.Add(Key, Priority);
+		}
+	}
+
+	TestEqual(TEXT("Num"), Heap.Num(), Expected.Num());
+
+	float PreviousPriority = -1.0f;
+
+	while (!Heap.IsEmpty())
+	{
+		const auto Priority = Heap.TopPriority();
+		const auto Key = Heap.Pop();
+
+		const auto ExpectedPriority = Expected.Find(Key);
+		if (!TestNotNull(*FString::Printf(TEXT("Popped %d is expected"), Key), ExpectedPriority)
+			|| !TestEqual(*FString::Printf(TEXT("Priority of %d"), Key), Priority, *ExpectedPriority)
+			|| !TestTrue(*FString::Printf(TEXT("Popped %d in order"), Key), PreviousPriority <= Priority))
+		{
+			break;
+		}
+
+		Expected.Remove(Key);
+		PreviousPriority = Priority;
+	}
+
+	TestEqual(TEXT("Every key popped"), Expected.Num(), 0);
+
+	return true;
+}
+
+#endif
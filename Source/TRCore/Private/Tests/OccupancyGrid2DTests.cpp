@@ -0,0 +1,288 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Containers/OccupancyGrid2D.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace OccupancyGrid2DTests
+{
+	constexpr auto TestFlags = EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter;
+
+	/* 10x10 cells of 100. */
+	TR::FOccupancyGrid2D MakeGrid()
+	{
+		TR::FOccupancyGrid2D Grid;
+		Grid.Init(FBox2D(FVector2D(0, 0), FVector2D(1000, 1000)), 100.0f);
+
+		return Grid;
+	}
+
+	FBox2D MakeBox(double MinX, double MinY, double MaxX, double MaxY)
+	{
+		return FBox2D(FVector2D(MinX, MinY), FVector2D(MaxX, MaxY));
+	}
+
+	TArray<FBox2D> MakeRandomFootprints(FRandomStream& Rng, const FBox2D& Bounds, int32 Count, float MaxSize)
+	{
+		TArray<FBox2D> Footprints;
+		Footprints.Reserve(Count);
+
+		for (int32 i = 0; i < Count; ++i)
+		{
+			const FVector2D Min(Rng.FRandRange(Bounds.Min.X, Bounds.Max.X), Rng.FRandRange(Bounds.Min.Y, Bounds.Max.Y));
+			const FVector2D Size(Rng.FRandRange(10.0f, MaxSize), Rng.FRandRange(10.0f, MaxSize));
+
+			Footprints.Emplace(Min, Min + Size);
+		}
+
+		return Footprints;
+	}
+
+	/*
+	* Reference search that tests every candidate within the search square.
+	*/
+	TOptional<double> BruteForceNearestFreeDistSq(const TR::FOccupancyGrid2D& Grid, const FVector2D& Center, const FVector2D& Extent, float MaxRadius)
+	{
+		const auto CellSize = Grid.GetCellSize();
+		const auto MaxRing = FMath::CeilToInt32(MaxRadius / CellSize);
+
+		TOptional<double> BestDistSq;
+
+		for (int32 DY = -MaxRing; DY <= MaxRing; ++DY)
+		{
+			for (int32 DX = -MaxRing; DX <= MaxRing; ++DX)
+			{
+				const FVector2D Offset(DX * CellSize, DY * CellSize);
+				const auto DistSq = Offset.SizeSquared();
+				const auto Location = Center + Offset;
+
+				if (DistSq <= FMath::Square(static_cast<double>(MaxRadius)) && Grid.IsFree(FBox2D(Location - Extent, Location + Extent)) &&
+					(!BestDistSq || DistSq < *BestDistSq))
+				{
+					BestDistSq = DistSq;
+				}
+			}
+		}
+
+		return BestDistSq;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOccupancyGrid2DMarkAndClearTest, "TankRampage.TRCore.OccupancyGrid2D.MarkAndClear", OccupancyGrid2DTests::TestFlags)
+
+bool FOccupancyGrid2DMarkAndClearTest::RunTest(const FString& Parameters)
+{
+	using namespace OccupancyGrid2DTests;
+
+	auto Grid = MakeGrid();
+
+	TestTrue(TEXT("Initialized"), Grid.IsInitialized());
+	TestEqual(TEXT("Cell count"), Grid.GetCellCount(), FIntPoint(10, 10));
+
+	// Touches cells 1-2 on each axis
+	Grid.MarkOccupied(MakeBox(150, 150, 250, 250));
+
+	TestEqual(TEXT("Occupied cells"), Grid.NumOccupied(), 4);
+	TestFalse(TEXT("Overlapping box"), Grid.IsFree(MakeBox(240, 240, 260, 260)));
+	TestFalse(TEXT("Box in an occupied cell but outside the footprint"), Grid.IsFree(MakeBox(260, 260, 290, 290)));
+	TestTrue(TEXT("Box ending on the edge of an occupied cell"), Grid.IsFree(MakeBox(0, 0, 100, 100)));
+	TestTrue(TEXT("Box starting on the far edge of an occupied cell"), Grid.IsFree(MakeBox(300, 300, 400, 400)));
+	TestTrue(TEXT("Box outside the bounds"), Grid.IsFree(MakeBox(-500, -500, -100, -100)));
+
+	// Stamping beyond the bounds only marks the cells inside
+	Grid.MarkOccupied(MakeBox(950, -100, 1100, 50));
+	TestEqual(TEXT("Occupied cells after clamped stamp"), Grid.NumOccupied(), 5);
+
+	Grid.ClearRegion(MakeBox(150, 150, 250, 250));
+	TestEqual(TEXT("Occupied cells after clear"), Grid.NumOccupied(), 1);
+	TestTrue(TEXT("Cleared box"), Grid.IsFree(MakeBox(150, 150, 250, 250)));
+
+	Grid.Reset();
+	TestFalse(TEXT("Initialized after reset"), Grid.IsInitialized());
+	TestTrue(TEXT("Everything is free after reset"), Grid.IsFree(MakeBox(950, 0, 1000, 50)));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOccupancyGrid2DCellSizeCapTest, "TankRampage.TRCore.OccupancyGrid2D.CellSizeCap", OccupancyGrid2DTests::TestFlags)
+
+bool FOccupancyGrid2DCellSizeCapTest::RunTest(const FString& Parameters)
+{
+	AddExpectedError(TEXT("too large for cell size"), EAutomationExpectedErrorFlags::Contains, 1);
+
+	TR::FOccupancyGrid2D Grid;
+
+	// 100x100 cells do not fit in 100 so the cell size doubles until 7x7 do
+	Grid.Init(FBox2D(FVector2D(0, 0), FVector2D(1000, 1000)), 10.0f, 100);
+
+	TestEqual(TEXT("Cell size"), Grid.GetCellSize(), 160.0f);
+	TestEqual(TEXT("Cell count"), Grid.GetCellCount(), FIntPoint(7, 7));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOccupancyGrid2DFindNearestFreeTest, "TankRampage.TRCore.OccupancyGrid2D.FindNearestFree", OccupancyGrid2DTests::TestFlags)
+
+bool FOccupancyGrid2DFindNearestFreeTest::RunTest(const FString& Parameters)
+{
+	using namespace OccupancyGrid2DTests;
+
+	auto Grid = MakeGrid();
+
+	const FVector2D Center(500, 500);
+	const FVector2D Extent(40, 40);
+
+	TestEqual(TEXT("Free center"), Grid.FindNearestFree(Center, Extent, 500), TOptional<FVector2D>(Center));
+
+	// Blocks the center and the first ring of candidates
+	Grid.MarkOccupied(MakeBox(400, 400, 600, 600));
+
+	const auto Nearest = Grid.FindNearestFree(Center, Extent, 500);
+	if (TestTrue(TEXT("Found a free location"), Nearest.IsSet()))
+	{
+		TestEqual(TEXT("Distance to nearest"), FVector2D::Distance(*Nearest, Center), 200.0);
+		TestTrue(TEXT("Nearest is free"), Grid.IsFree(FBox2D(*Nearest - Extent, *Nearest + Extent)));
+	}
+
+	TestFalse(TEXT("Nothing free within radius"), Grid.FindNearestFree(Center, Extent, 150).IsSet());
+
+	const auto NearestAbove = Grid.FindNearestFree(Center, Extent, 500, [](const FVector2D& Location) { return Location.Y > 500; });
+	if (TestTrue(TEXT("Found a free location matching the predicate"), NearestAbove.IsSet()))
+	{
+		TestTrue(TEXT("Predicate respected"), NearestAbove->Y > 500);
+		TestEqual(TEXT("Distance to nearest matching the predicate"), FVector2D::Distance(*NearestAbove, Center), 200.0);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOccupancyGrid2DEnclosedTest, "TankRampage.TRCore.OccupancyGrid2D.Enclosed", OccupancyGrid2DTests::TestFlags)
+
+bool FOccupancyGrid2DEnclosedTest::RunTest(const FString& Parameters)
+{
+	using namespace OccupancyGrid2DTests;
+
+	TR::FOccupancyGrid2D Grid;
+	Grid.Init(MakeBox(-1000, -1000, 1000, 1000), 50.0f);
+
+	// Ring of walls around the origin with the inside left free
+	Grid.MarkOccupied(MakeBox(-500, -500, 500, -400));
+	Grid.MarkOccupied(MakeBox(-500, 400, 500, 500));
+	Grid.MarkOccupied(MakeBox(-500, -500, -400, 500));
+	Grid.MarkOccupied(MakeBox(400, -500, 500, 500));
+
+	TestEqual(TEXT("Free center"), Grid.FindNearestFree(FVector2D::ZeroVector, FVector2D(50), 1000), TOptional<FVector2D>(FVector2D::ZeroVector));
+
+	// Starting inside a wall must not jump over the ring when a closer free spot exists on either side
+	const auto FromWall = Grid.FindNearestFree(FVector2D(450, 0), FVector2D(25), 1000);
+	if (TestTrue(TEXT("Found a free location from inside the wall"), FromWall.IsSet()))
+	{
+		TestTrue(*FString::Printf(TEXT("%s next to the wall"), *FromWall->ToString()), FMath::Abs(FromWall->X - 450) <= 100);
+	}
+
+	// Fill the inside so that nothing fits within the radius
+	Grid.MarkOccupied(MakeBox(-500, -500, 500, 500));
+	TestFalse(TEXT("Nothing free inside the filled ring"), Grid.FindNearestFree(FVector2D::ZeroVector, FVector2D(50), 300).IsSet());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FOccupancyGrid2DRandomLayoutsTest, "TankRampage.TRCore.OccupancyGrid2D.RandomLayouts", OccupancyGrid2DTests::TestFlags)
+
+bool FOccupancyGrid2DRandomLayoutsTest::RunTest(const FString& Parameters)
+{
+	using namespace OccupancyGrid2DTests;
+
+	constexpr int32 LayoutCount = 20;
+	constexpr int32 QueriesPerLayout = 100;
+	constexpr float CellSize = 50.0f;
+
+	const auto Bounds = MakeBox(-5000, -5000, 5000, 5000);
+
+	FRandomStream Rng(1234);
+
+	int32 NotFoundCount{};
+
+	for (int32 Layout = 0; Layout < LayoutCount; ++Layout)
+	{
+		// Increasingly dense layouts up to almost completely covered
+		const auto FootprintCount = 200 + Layout * 2000 / LayoutCount;
+		const auto Footprints = MakeRandomFootprints(Rng, Bounds, FootprintCount, 800.0f);
+
+		TR::FOccupancyGrid2D Grid;
+		Grid.Init(Bounds, CellSize);
+
+		for (const auto& Footprint : Footprints)
+		{
+			Grid.MarkOccupied(Footprint);
+		}
+
+		// The spiral search must find a free location at the same distance as testing every candidate
+		for (int32 Query = 0; Query < QueriesPerLayout; ++Query)
+		{
+			const FVector2D Center(Rng.FRandRange(Bounds.Min.X, Bounds.Max.X), Rng.FRandRange(Bounds.Min.Y, Bounds.Max.Y));
+			const FVector2D Extent(Rng.FRandRange(10.0f, 150.0f), Rng.FRandRange(10.0f, 150.0f));
+			const auto MaxRadius = Rng.FRandRange(0.0f, 1500.0f);
+
+			const auto Description = FString::Printf(TEXT("Layout %d: Center=%s; Extent=%s; MaxRadius=%.1f"), Layout, *Center.ToString(), *Extent.ToString(), MaxRadius);
+
+			const auto Result = Grid.FindNearestFree(Center, Extent, MaxRadius);
+			const auto Expected = BruteForceNearestFreeDistSq(Grid, Center, Extent, MaxRadius);
+
+			if (!Result)
+			{
+				++NotFoundCount;
+			}
+
+			if (!TestEqual(*FString::Printf(TEXT("%s found"), *Description), Result.IsSet(), Expected.IsSet()) || !Result)
+			{
+				continue;
+			}
+
+			TestTrue(*FString::Printf(TEXT("%s result %s is free"), *Description, *Result->ToString()), Grid.IsFree(FBox2D(*Result - Extent, *Result + Extent)));
+			TestEqual(*FString::Printf(TEXT("%s distance"), *Description), FVector2D::Distance(*Result, Center), FMath::Sqrt(*Expected), 1.0);
+		}
+
+		// Remove a random subset like destroyed actors and restamp the footprints touching the dirty regions
+		TArray<FBox2D> Remaining;
+		TArray<FBox2D> Removed;
+
+		for (const auto& Footprint : Footprints)
+		{
+			(Rng.FRand() < 0.2f ? Removed : Remaining).Add(Footprint);
+		}
+
+		for (const auto& Region : Removed)
+		{
+			Grid.ClearRegion(Region);
+
+			for (const auto& Footprint : Remaining)
+			{
+				if (Footprint.Intersect(Region.ExpandBy(CellSize)))
+				{
+					Grid.MarkOccupied(Footprint);
+				}
+			}
+		}
+
+		TR::FOccupancyGrid2D ExpectedGrid;
+		ExpectedGrid.Init(Bounds, CellSize);
+
+		for (const auto& Footprint : Remaining)
+		{
+			ExpectedGrid.MarkOccupied(Footprint);
+		}
+
+		TestEqual(*FString::Printf(TEXT("Layout %d occupied cells after the dirty region rebuild"), Layout), Grid.NumOccupied(), ExpectedGrid.NumOccupied());
+	}
+
+	// The densest layouts must exercise the not found path
+	TestTrue(TEXT("Some queries found nothing"), NotFoundCount > 0);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,104 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Containers/SpscRingBuffer.h"
+
+#include "Async/Async.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace SpscRingBufferTests
+{
+	constexpr auto TestFlags = EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpscRingBufferBasicTest, "TankRampage.TRCore.SpscRingBuffer.Basic", SpscRingBufferTests::TestFlags)
+
+bool FSpscRingBufferBasicTest::RunTest(const FString& Parameters)
+{
+	TR::TSpscRingBuffer<int32> Ring(5);
+
+	TestEqual(TEXT("Capacity rounded up"), Ring.Capacity(), 8u);
+	TestTrue(TEXT("Starts empty"), Ring.IsEmpty());
+
+	int32 Value{};
+	TestFalse(TEXT("Pop when empty"), Ring.Pop(Value));
+
+	for (int32 i = 0; i < 8; ++i)
+	{
+		TestTrue(*FString::Printf(TEXT("Push %d"), i), Ring.Push(i));
+	}
+
+	TestFalse(TEXT("Push when full"), Ring.Push(8));
+	TestEqual(TEXT("Num when full"), Ring.Num(), 8u);
+
+	TestTrue(TEXT("Pop when full"), Ring.Pop(Value));
+	TestEqual(TEXT("First in first out"), Value, 0);
+
+	// Wraps around the end of the storage
+	TestTrue(TEXT("Push after pop"), Ring.Push(8));
+
+	TArray<int32> Popped;
+	TestEqual(TEXT("PopAll limited"), Ring.PopAll(Popped, 3), 3);
+	TestEqual(TEXT("PopAll appends"), Ring.PopAll(Popped), 5);
+	TestEqual(TEXT("PopAll order"), Popped, TArray<int32>{ 1, 2, 3, 4, 5, 6, 7, 8 });
+	TestTrue(TEXT("Empty after PopAll"), Ring.IsEmpty());
+	TestEqual(TEXT("PopAll when empty"), Ring.PopAll(Popped), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpscRingBufferThreadedTest, "TankRampage.TRCore.SpscRingBuffer.Threaded", SpscRingBufferTests::TestFlags)
+
+bool FSpscRingBufferThreadedTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 Count = 200000;
+
+	// Small ring so that the producer keeps running into a full ring and the indices wrap many times
+	TR::TSpscRingBuffer<int32> Ring(64);
+
+	auto Producer = Async(EAsyncExecution::Thread, [&Ring]()
+	{
+		for (int32 i = 0; i < Count; ++i)
+		{
+			while (!Ring.Push(i))
+			{
+				FPlatformProcess::Yield();
+			}
+		}
+	});
+
+	int32 Received{};
+	int32 OutOfOrder{};
+	TArray<int32> Popped;
+
+	// Keeps draining after a mismatch so that the producer is never left blocked on a full ring
+	while (Received < Count)
+	{
+		Popped.Reset();
+		if (Ring.PopAll(Popped, 16) == 0)
+		{
+			FPlatformProcess::Yield();
+			continue;
+		}
+
+		for (const auto Value : Popped)
+		{
+			if (Value != Received)
+			{
+				++OutOfOrder;
+			}
+			++Received;
+		}
+	}
+
+	Producer.Wait();
+
+	TestEqual(TEXT("Popped out of order"), OutOfOrder, 0);
+	TestTrue(TEXT("Empty after consuming everything"), Ring.IsEmpty());
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Containers/SubstringMatcher.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace SubstringMatcherTests
+{
+	constexpr auto TestFlags = EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter;
+
+	bool ContainsAny(const FString& Input, TConstArrayView<FString> Substrings)
+	{
+		return Substrings.ContainsByPredicate([&Input](const FString& Substring) { return Input.Contains(Substring); });
+	}
+
+	FString MakeRandomString(FRandomStream& Rng, int32 MaxLength)
+	{
+		// Few distinct characters so that partial matches and failure links are exercised
+		static const TCHAR Alphabet[] = TEXT("abAB_1\u00E9");
+		constexpr int32 AlphabetLength = UE_ARRAY_COUNT(Alphabet) - 1;
+
+		FString Result;
+		for (int32 i = 0, Length = Rng.RandRange(0, MaxLength); i < Length; ++i)
+		{
+			Result.AppendChar(Alphabet[Rng.RandRange(0, AlphabetLength - 1)]);
+		}
+
+		return Result;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSubstringMatcherBasicTest, "TankRampage.TRCore.SubstringMatcher.Basic", SubstringMatcherTests::TestFlags)
+
+bool FSubstringMatcherBasicTest::RunTest(const FString& Parameters)
+{
+	TR::FSubstringMatcher Empty;
+	TestTrue(TEXT("Default is empty"), Empty.IsEmpty());
+	TestFalse(TEXT("Empty matches nothing"), Empty.Matches(TEXT("Wall")));
+
+	const TR::FSubstringMatcher Matcher(TArray<FString>{ TEXT("Wall"), TEXT("Rock") });
+	TestFalse(TEXT("Compiled is not empty"), Matcher.IsEmpty());
+	TestTrue(TEXT("Different case"), Matcher.Matches(TEXT("SM_BigWALL_01")));
+	TestTrue(TEXT("At the start"), Matcher.Matches(TEXT("rockface")));
+	TestFalse(TEXT("Partial match"), Matcher.Matches(TEXT("SM_Wal_Roc")));
+	TestFalse(TEXT("Empty input"), Matcher.Matches(TEXT("")));
+
+	// Only found by following failure links after a partial match
+	const TR::FSubstringMatcher OverlapMatcher(TArray<FString>{ TEXT("he"), TEXT("she"), TEXT("his"), TEXT("hers") });
+	TestTrue(TEXT("Overlapping substrings"), OverlapMatcher.Matches(TEXT("ushers")));
+	TestFalse(TEXT("Only prefixes of overlapping substrings"), OverlapMatcher.Matches(TEXT("shi_sh")));
+
+	const TR::FSubstringMatcher RepeatMatcher(TArray<FString>{ TEXT("aab") });
+	TestTrue(TEXT("Repeated prefix"), RepeatMatcher.Matches(TEXT("aaab")));
+
+	const TR::FSubstringMatcher EmptySubstringMatcher(TArray<FString>{ TEXT("Wall"), FString() });
+	TestTrue(TEXT("Empty substring matches everything"), EmptySubstringMatcher.Matches(TEXT("Tree")));
+	TestTrue(TEXT("Empty substring matches empty input"), EmptySubstringMatcher.Matches(TEXT("")));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSubstringMatcherMatchesContainsTest, "TankRampage.TRCore.SubstringMatcher.MatchesContains", SubstringMatcherTests::TestFlags)
+
+bool FSubstringMatcherMatchesContainsTest::RunTest(const FString& Parameters)
+{
+	using namespace SubstringMatcherTests;
+
+	FRandomStream Rng(1234);
+
+	for (int32 SetIndex = 0; SetIndex < 50; ++SetIndex)
+	{
+		TArray<FString> Substrings;
+		for (int32 i = 0, Count = Rng.RandRange(1, 6); i < Count; ++i)
+		{
+			Substrings.Add(MakeRandomString(Rng, 4));
+		}
+
+		const TR::FSubstringMatcher Matcher(Substrings);
+
+		for (int32 InputIndex = 0; InputIndex < 100; ++InputIndex)
+		{
+			const auto Input = MakeRandomString(Rng, 16);
+
+			if (!TestEqual(*FString::Printf(TEXT("Matches(%s) with [%s]"), *Input, *FString::Join(Substrings, TEXT(", "))),
+				Matcher.Matches(Input), ContainsAny(Input, Substrings)))
+			{
+				return true;
+			}
+		}
+	}
+
+	return true;
+}
+
+#endif
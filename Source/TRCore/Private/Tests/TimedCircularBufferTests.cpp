@@ -0,0 +1,150 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Containers/TimedCircularBuffer.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace TimedCircularBufferTests
+{
+	using FZeroFloatFunc = decltype([]() { return 0.0f; });
+	using FFloatMagnitudeFunc = decltype([](float V) { return FMath::Abs(V); });
+	using FHundredIntFunc = decltype([]() { return 100; });
+
+	using FFloatMinMaxBuffer = TR::TTimedCircularBuffer<float, FZeroFloatFunc, FFloatMagnitudeFunc, TR::TCircularBufferRunningSumMinMax<float, FZeroFloatFunc>>;
+	using FFloatNaiveBuffer = TR::TTimedCircularBuffer<float, FZeroFloatFunc, FFloatMagnitudeFunc, TR::TCircularBufferNoAggregate<float, FZeroFloatFunc>>;
+
+	constexpr auto TestFlags = EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTimedCircularBufferRunningSumTest, "TankRampage.TRCore.TimedCircularBuffer.RunningSum", TimedCircularBufferTests::TestFlags)
+
+bool FTimedCircularBufferRunningSumTest::RunTest(const FString& Parameters)
+{
+	TR::TTimedCircularBuffer<int32> Buffer(4);
+
+	TestTrue(TEXT("Starts empty"), Buffer.IsEmpty());
+	TestEqual(TEXT("Empty sum"), Buffer.Sum(), 0);
+
+	for (int32 Value = 1; Value <= 6; ++Value)
+	{
+		Buffer.Add(Value);
+	}
+
+	// 1 and 2 have been evicted
+	TestTrue(TEXT("Full"), Buffer.IsFull());
+	TestEqual(TEXT("Size"), Buffer.Size(), 4u);
+	TestEqual(TEXT("Sum"), Buffer.Sum(), 3 + 4 + 5 + 6);
+	TestEqual(TEXT("Average"), Buffer.Average(), (3 + 4 + 5 + 6) / 4);
+	TestEqual(TEXT("Delta"), Buffer.Delta(), 6 - 3);
+
+	Buffer.ClearAndResize(2);
+	Buffer.Add(10);
+
+	TestEqual(TEXT("Capacity after resize"), Buffer.Capacity(), 2u);
+	TestEqual(TEXT("Sum after resize"), Buffer.Sum(), 10);
+
+	// Sums start from the default value whether or not it is zero and evicting values does not add it again
+	TR::TTimedCircularBuffer<int32, TimedCircularBufferTests::FHundredIntFunc> DefaultedBuffer(2);
+
+	TestEqual(TEXT("Empty defaulted sum"), DefaultedBuffer.Sum(), 100);
+
+	for (int32 Value = 1; Value <= 5; ++Value)
+	{
+		DefaultedBuffer.Add(Value);
+	}
+
+	TestEqual(TEXT("Defaulted sum after evictions"), DefaultedBuffer.Sum(), 100 + 4 + 5);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTimedCircularBufferMinMaxTest, "TankRampage.TRCore.TimedCircularBuffer.MinMax", TimedCircularBufferTests::TestFlags)
+
+bool FTimedCircularBufferMinMaxTest::RunTest(const FString& Parameters)
+{
+	TimedCircularBufferTests::FFloatMinMaxBuffer Buffer(3);
+
+	const auto AddAndTest = [&](float Value, float ExpectedMin, float ExpectedMax)
+	{
+		Buffer.Add(Value);
+
+		TestEqual(*FString::Printf(TEXT("Min after adding %.0f"), Value), Buffer.Min(), ExpectedMin);
+		TestEqual(*FString::Printf(TEXT("Max after adding %.0f"), Value), Buffer.Max(), ExpectedMax);
+	};
+
+	AddAndTest(5, 5, 5);
+	AddAndTest(1, 1, 5);
+	AddAndTest(4, 1, 5);
+	// Evicts 5
+	AddAndTest(6, 1, 6);
+	// Evicts 1
+	AddAndTest(7, 4, 7);
+	// Evicts 4
+	AddAndTest(2, 2, 7);
+
+	Buffer.Clear();
+
+	TestEqual(TEXT("Min after clear"), Buffer.Min(), 0.0f);
+	TestEqual(TEXT("Max after clear"), Buffer.Max(), 0.0f);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTimedCircularBufferMatchesNaiveTest, "TankRampage.TRCore.TimedCircularBuffer.MatchesNaive", TimedCircularBufferTests::TestFlags)
+
+bool FTimedCircularBufferMatchesNaiveTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 Size = 32;
+
+	TimedCircularBufferTests::FFloatMinMaxBuffer Buffer(Size);
+	TimedCircularBufferTests::FFloatNaiveBuffer NaiveBuffer(Size);
+	TArray<float> Window;
+
+	FRandomStream Rng(1234);
+
+	for (int32 i = 0; i < 10 * Size; ++i)
+	{
+		// Mostly small values with occasional large ones like throttle and position changes
+		const auto Value = Rng.FRand() < 0.05f ? Rng.FRandRange(-1e4f, 1e4f) : Rng.FRandRange(-1.0f, 1.0f);
+
+		Buffer.Add(Value);
+		NaiveBuffer.Add(Value);
+
+		Window.Add(Value);
+		if (Window.Num() > Size)
+		{
+			Window.RemoveAt(0, 1, false);
+		}
+
+		const auto Tolerance = 1e-3f * FMath::Max(1.0f, FMath::Abs(NaiveBuffer.Sum()));
+
+		if (!TestEqual(*FString::Printf(TEXT("Sum at %d"), i), Buffer.Sum(), NaiveBuffer.Sum(), Tolerance)
+			|| !TestEqual(*FString::Printf(TEXT("Min at %d"), i), Buffer.Min(), FMath::Min(Window))
+			|| !TestEqual(*FString::Printf(TEXT("Max at %d"), i), Buffer.Max(), FMath::Max(Window)))
+		{
+			break;
+		}
+	}
+
+	// Large values cycled through the buffer must not leave any drift behind once only small ones remain
+	TimedCircularBufferTests::FFloatMinMaxBuffer DriftBuffer(64);
+
+	for (int32 i = 0; i < 100000; ++i)
+	{
+		DriftBuffer.Add(i % 2 ? 1e6f : 0.001f);
+	}
+
+	for (int32 i = 0; i < 64; ++i)
+	{
+		DriftBuffer.Add(0.001f);
+	}
+
+	TestEqual(TEXT("Sum after drift"), DriftBuffer.Sum(), 64 * 0.001f, 1e-4f);
+
+	return true;
+}
+
+#endif
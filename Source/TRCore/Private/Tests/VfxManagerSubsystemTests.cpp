@@ -0,0 +1,90 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/VfxManagerSubsystem.h"
+
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/ScopeExit.h"
+#include "NiagaraSystem.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace VfxManagerSubsystemTests
+{
+	constexpr auto TestFlags = EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FVfxManagerSubsystemBudgetTest, "TankRampage.TRCore.VfxManagerSubsystem.Budget", VfxManagerSubsystemTests::TestFlags)
+
+bool FVfxManagerSubsystemBudgetTest::RunTest(const FString& Parameters)
+{
+	if (!UVfxManagerSubsystem::IsEnabled())
+	{
+		AddInfo(TEXT("tr.vfx.enabled is 0 so requests are not budgeted"));
+		return true;
+	}
+
+	// No player controller so nothing is culled by view distance
+	auto World = UWorld::CreateWorld(EWorldType::Game, false);
+	ON_SCOPE_EXIT
+	{
+		World->DestroyWorld(false);
+	};
+
+	auto Subsystem = World->GetSubsystem<UVfxManagerSubsystem>();
+	if (!TestNotNull(TEXT("Subsystem"), Subsystem))
+	{
+		return true;
+	}
+
+	// Any system will do as only the counters are checked
+	auto System = NewObject<UNiagaraSystem>(GetTransientPackage());
+
+	const auto SpawnBudget = UVfxManagerSubsystem::GetSpawnBudget();
+
+	auto Queue = [&](EVfxPriority Priority, int32 Count)
+	{
+		for (int32 i = 0; i < Count; ++i)
+		{
+			Subsystem->SpawnVfx(FVfxSpawnRequest
+			{
+				.System = System,
+				.Location = FVector(100.0 * i, 0, 0),
+				.Priority = Priority
+			});
+		}
+	};
+
+	// Critical and high go first, the last two normal requests do not fit the budget and low is dropped rather than deferred
+	Queue(EVfxPriority::Low, 2);
+	Queue(EVfxPriority::Normal, SpawnBudget);
+	Queue(EVfxPriority::Critical, 1);
+	Queue(EVfxPriority::High, 2);
+
+	TestEqual(TEXT("Pending before flush"), Subsystem->NumPending(), SpawnBudget + 5);
+	TestEqual(TEXT("Issued in first frame"), Subsystem->FlushPendingVfx(), SpawnBudget + 1);
+
+	const auto& Counters = Subsystem->GetCounters();
+
+	TestEqual(TEXT("Deferred"), Counters.Deferred, 2);
+	TestEqual(TEXT("Dropped"), Counters.Dropped, 2);
+	TestEqual(TEXT("Pending after first frame"), Subsystem->NumPending(), 2);
+	TestEqual(TEXT("MaxIssuedInFrame"), Counters.MaxIssuedInFrame, SpawnBudget);
+
+	// Deferred requests are issued the next frame
+	TestEqual(TEXT("Issued in second frame"), Subsystem->FlushPendingVfx(), 2);
+	TestEqual(TEXT("Pending after second frame"), Subsystem->NumPending(), 0);
+
+	TestEqual(TEXT("Requested"), Counters.Requested, SpawnBudget + 5);
+	TestEqual(TEXT("Every request accounted for"), Counters.Issued + Counters.Culled + Counters.Dropped, Counters.Requested);
+	TestTrue(TEXT("Spawned no more than issued"), Counters.Spawned <= Counters.Issued);
+	TestEqual(TEXT("Frames"), Counters.Frames, 2);
+
+	Subsystem->ResetCounters();
+	TestEqual(TEXT("Requested after reset"), Subsystem->GetCounters().Requested, 0);
+
+	return true;
+}
+
+#endif
@@ -1,10 +1,55 @@
 #include "Utils/RandUtils.h"
 
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Misc/Crc.h"
+#include "UObject/Object.h"
+
 #include <random>
 
-unsigned RandUtils::GenerateSeed()
+namespace
+{
+	TOptional<unsigned> ReadPinnedSeedFromCommandLine()
+	{
+		unsigned Seed;
+		if (FParse::Value(FCommandLine::Get(), TEXT("TRSeed="), Seed))
+		{
+			return Seed;
+		}
+
+		return {};
+	}
+
+	TOptional<unsigned>& GetPinnedSeedStorage()
+	{
+		static TOptional<unsigned> PinnedSeed = ReadPinnedSeedFromCommandLine();
+		return PinnedSeed;
+	}
+}
+
+unsigned RandUtils::GenerateSeed(uint32 Key)
 {
+	if (const auto PinnedSeed = GetPinnedSeed(); PinnedSeed)
+	{
+		return HashCombine(*PinnedSeed, Key);
+	}
+
 	std::random_device rd;
 
 	return rd();
 }
+
+unsigned RandUtils::GenerateSeed(const UObject& Object)
+{
+	return GenerateSeed(FCrc::StrCrc32(*Object.GetPathName()));
+}
+
+void RandUtils::SetPinnedSeed(TOptional<unsigned> Seed)
+{
+	GetPinnedSeedStorage() = Seed;
+}
+
+TOptional<unsigned> RandUtils::GetPinnedSeed()
+{
+	return GetPinnedSeedStorage();
+}
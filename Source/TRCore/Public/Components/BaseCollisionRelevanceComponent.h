@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "Containers/SubstringMatcher.h"
 #include "BaseCollisionRelevanceComponent.generated.h"
 
 
@@ -12,11 +13,14 @@ class TRCORE_API UBaseCollisionRelevanceComponent : public UActorComponent
 {
 	GENERATED_BODY()
 
+	friend struct FCollisionRelevanceBenchmark;
+
 public:	
 	UBaseCollisionRelevanceComponent();
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	virtual void RegisterCollisions() PURE_VIRTUAL(UBaseCollisionRelevanceComponent::RegisterCollisions, ;);
 
@@ -36,7 +40,19 @@ private:
 	UFUNCTION()
 	void OnComponentHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComponent, FVector NormalImpulse, const FHitResult& Hit);
 		
-	bool IsRelevantCollision(const FHitResult& Hit) const;
+	bool IsRelevantCollision(const FHitResult& Hit);
+	bool EvaluateRelevance(const UPrimitiveComponent* OtherComponent, const AActor* Actor) const;
+
+	void ClearCachedVerdicts();
+	static void InvalidateCachedVerdicts(UActorComponent* Component);
+
+private:
+	struct FCachedVerdict
+	{
+		TWeakObjectPtr<const AActor> Actor;
+		ECollisionChannel ObjectType;
+		bool bRelevant;
+	};
 
 private:
 	UPROPERTY(EditDefaultsOnly, Category = "Detection")
@@ -53,4 +69,10 @@ private:
 	bool bNotifyAllButSpecified{ };
 
 	bool bMatchTrueCondition{};
+
+	TR::FSubstringMatcher ActorMatcher{};
+	TR::FSubstringMatcher ComponentMatcher{};
+
+	/* Verdicts for components hit before. Removed when the component is unregistered. */
+	TMap<TWeakObjectPtr<const UPrimitiveComponent>, FCachedVerdict> VerdictCache{};
 };
@@ -0,0 +1,289 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <concepts>
+
+namespace TR
+{
+	template<typename T>
+	concept IndexedMinHeapKeyConcept = std::equality_comparable<T> && requires(const T& t)
+	{
+		{
+			GetTypeHash(t)
+		} -> std::convertible_to<uint32>;
+	};
+
+	/**
+	 * Binary min-heap of unique keys ordered by priority that also tracks the heap index of each key.
+	 * Looking up, changing the priority of or removing a key already in the heap is logarithmic instead of a linear search and rebuild
+	 * as with <c>TArray::Heapify</c>, which suits expiry times that are extended while waiting.
+	 */
+	template<IndexedMinHeapKeyConcept KeyType, typename PriorityType = float>
+	class TIndexedMinHeap
+	{
+	public:
+		/*
+		* Adds the key or changes its priority if it is already in the heap. Returns true if the key was added.
+		*/
+		bool AddOrUpdate(const KeyType& Key, PriorityType Priority);
+
+		bool Remove(const KeyType& Key);
+
+		bool Contains(const KeyType& Key) const;
+		const PriorityType* FindPriority(const KeyType& Key) const;
+
+		/*
+		* Key with the lowest priority. The heap must not be empty.
+		*/
+		const KeyType& Top() const;
+		PriorityType TopPriority() const;
+
+		/*
+		* Removes and returns the key with the lowest priority. The heap must not be empty.
+		*/
+		KeyType Pop();
+
+		int32 Num() const;
+		bool IsEmpty() const;
+
+		void Reserve(int32 Count);
+		void Reset();
+
+		/*
+		* Calls <c>Func(const KeyType&, PriorityType)</c> for every key in heap order, which is not sorted order.
+		*/
+		template<typename Func>
+		void ForEach(Func&& Callback) const;
+
+	private:
+		struct FNode
+		{
+			KeyType Key;
+			PriorityType Priority;
+		};
+
+		void SiftUp(int32 Index);
+		void SiftDown(int32 Index);
+
+		void SetNode(int32 Index, FNode&& Node);
+		void RemoveAt(int32 Index);
+
+	private:
+		TArray<FNode> Nodes{};
+		TMap<KeyType, int32> IndexByKey{};
+	};
+
+#pragma region Template Definitions
+
+	template<IndexedMinHeapKeyConcept KeyType, typename PriorityType>
+	bool TIndexedMinHeap<KeyType, PriorityType>::AddOrUpdate(const KeyType& Key, PriorityType Priority)
+	{
+		if (const auto ExistingIndex = IndexByKey.Find(Key); ExistingIndex)
+		{
+			const auto Index = *ExistingIndex;
+			const auto OldPriority = Nodes[Index].Priority;
+
+			Nodes[Index].Priority = Priority;
+
+			if (Priority < OldPriority)
+			{
+				SiftUp(Index);
+			}
+			else if (OldPriority < Priority)
+			{
+				SiftDown(Index);
+			}
+
+			return false;
+		}
+
+		const auto Index = Nodes.Add(FNode{ Key, Priority });
+		IndexByKey.Add(Key, Index);
+
+		SiftUp(Index);
+
+		return true;
+	}
+
+	template<IndexedMinHeapKeyConcept KeyType, typename PriorityType>
+	bool TIndexedMinHeap<KeyType, PriorityType>::Remove(const KeyType& Key)
+	{
+		const auto ExistingIndex = IndexByKey.Find(Key);
+		if (!ExistingIndex)
+		{
+			return false;
+		}
+
+		RemoveAt(*ExistingIndex);
+
+		return true;
+	}
+
+	template<IndexedMinHeapKeyConcept KeyType, typename PriorityType>
+	inline bool TIndexedMinHeap<KeyType, PriorityType>::Contains(const KeyType& Key) const
+	{
+		return IndexByKey.Contains(Key);
+	}
+
+	template<IndexedMinHeapKeyConcept KeyType, typename PriorityType>
+	inline const PriorityType* TIndexedMinHeap<KeyType, PriorityType>::FindPriority(const KeyType& Key) const
+	{
+		const auto ExistingIndex = IndexByKey.Find(Key);
+		return ExistingIndex ? &Nodes[*ExistingIndex].Priority : nullptr;
+	}
+
+	template<IndexedMinHeapKeyConcept KeyType, typename PriorityType>
+	inline const KeyType& TIndexedMinHeap<KeyType, PriorityType>::Top() const
+	{
+		check(!Nodes.IsEmpty());
+		return Nodes[0].Key;
+	}
+
+	template<IndexedMinHeapKeyConcept KeyType, typename PriorityType>
+	inline PriorityType TIndexedMinHeap<KeyType, PriorityType>::TopPriority() const
+	{
+		check(!Nodes.IsEmpty());
+		return Nodes[0].Priority;
+	}
+
+	template<IndexedMinHeapKeyConcept KeyType, typename PriorityType>
+	KeyType TIndexedMinHeap<KeyType, PriorityType>::Pop()
+	{
+		check(!Nodes.IsEmpty());
+
+		KeyType Key = Nodes[0].Key;
+		RemoveAt(0);
+
+		return Key;
+	}
+
+	template<IndexedMinHeapKeyConcept KeyType, typename PriorityType>
+	inline int32 TIndexedMinHeap<KeyType, PriorityType>::Num() const
+	{
+		return Nodes.Num();
+	}
+
+	template<IndexedMinHeapKeyConcept KeyType, typename PriorityType>
+	inline bool TIndexedMinHeap<KeyType, PriorityType>::IsEmpty() const
+	{
+		return Nodes.IsEmpty();
+	}
+
+	template<IndexedMinHeapKeyConcept KeyType, typename PriorityType>
+	inline void TIndexedMinHeap<KeyType, PriorityType>::Reserve(int32 Count)
+	{
+		Nodes.Reserve(Count);
+		IndexByKey.Reserve(Count);
+	}
+
+	template<IndexedMinHeapKeyConcept KeyType, typename PriorityType>
+	inline void TIndexedMinHeap<KeyType, PriorityType>::Reset()
+	{
+		Nodes.Reset();
+		IndexByKey.Reset();
+	}
+
+	template<IndexedMinHeapKeyConcept KeyType, typename PriorityType>
+	template<typename Func>
+	void TIndexedMinHeap<KeyType, PriorityType>::ForEach(Func&& Callback) const
+	{
+		for (const auto& Node : Nodes)
+		{
+			Callback(Node.Key, Node.Priority);
+		}
+	}
+
+	template<IndexedMinHeapKeyConcept KeyType, typename PriorityType>
+	void TIndexedMinHeap<KeyType, PriorityType>::SiftUp(int32 Index)
+	{
+		// Hold the moving node aside and shift parents down into the hole so each level is one move instead of a swap
+		FNode Node = MoveTemp(Nodes[Index]);
+
+		while (Index > 0)
+		{
+			const auto ParentIndex = (Index - 1) / 2;
+			if (!(Node.Priority < Nodes[ParentIndex].Priority))
+			{
+				break;
+			}
+
+			SetNode(Index, MoveTemp(Nodes[ParentIndex]));
+			Index = ParentIndex;
+		}
+
+		SetNode(Index, MoveTemp(Node));
+	}
+
+	template<IndexedMinHeapKeyConcept KeyType, typename PriorityType>
+	void TIndexedMinHeap<KeyType, PriorityType>::SiftDown(int32 Index)
+	{
+		const auto Count = Nodes.Num();
+
+		FNode Node = MoveTemp(Nodes[Index]);
+
+		for (;;)
+		{
+			auto ChildIndex = 2 * Index + 1;
+			if (ChildIndex >= Count)
+			{
+				break;
+			}
+
+			if (const auto RightIndex = ChildIndex + 1; RightIndex < Count && Nodes[RightIndex].Priority < Nodes[ChildIndex].Priority)
+			{
+				ChildIndex = RightIndex;
+			}
+
+			if (!(Nodes[ChildIndex].Priority < Node.Priority))
+			{
+				break;
+			}
+
+			SetNode(Index, MoveTemp(Nodes[ChildIndex]));
+			Index = ChildIndex;
+		}
+
+		SetNode(Index, MoveTemp(Node));
+	}
+
+	template<IndexedMinHeapKeyConcept KeyType, typename PriorityType>
+	inline void TIndexedMinHeap<KeyType, PriorityType>::SetNode(int32 Index, FNode&& Node)
+	{
+		IndexByKey.FindChecked(Node.Key) = Index;
+		Nodes[Index] = MoveTemp(Node);
+	}
+
+	template<IndexedMinHeapKeyConcept KeyType, typename PriorityType>
+	void TIndexedMinHeap<KeyType, PriorityType>::RemoveAt(int32 Index)
+	{
+		check(Nodes.IsValidIndex(Index));
+
+		IndexByKey.Remove(Nodes[Index].Key);
+
+		const auto LastIndex = Nodes.Num() - 1;
+		if (Index == LastIndex)
+		{
+			Nodes.RemoveAt(LastIndex, 1, false);
+			return;
+		}
+
+		// Fill the hole with the last node and restore the heap in whichever direction it is out of order
+		const auto RemovedPriority = Nodes[Index].Priority;
+		Nodes[Index] = Nodes.Pop(false);
+		IndexByKey.FindChecked(Nodes[Index].Key) = Index;
+
+		if (Nodes[Index].Priority < RemovedPriority)
+		{
+			SiftUp(Index);
+		}
+		else
+		{
+			SiftDown(Index);
+		}
+	}
+
+#pragma endregion Template Definitions
+}
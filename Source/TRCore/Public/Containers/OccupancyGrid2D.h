@@ -0,0 +1,183 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace TR
+{
+	/**
+	 * Bit grid in the XY plane marking cells covered by obstacle footprints.
+	 * Footprints are stamped conservatively so a box is only reported free if none of the cells it touches are occupied.
+	 * Cells outside the grid bounds are always free.
+	 *
+	 * The grid does not remember which footprints set a cell. To remove or move a footprint, clear its region and stamp the remaining footprints
+	 * that touch the region again.
+	 */
+	class TRCORE_API FOccupancyGrid2D
+	{
+	public:
+		static constexpr float DefaultCellSize = 50.0f;
+
+		/* Caps the memory at 2MB. Larger bounds use a coarser cell size instead. */
+		static constexpr int64 DefaultMaxCellCount = 16 * 1024 * 1024;
+
+		/*
+		* Clears the grid and resizes it to cover <c>InBounds</c>. The cell size is increased if the bounds would need more than <c>MaxCellCount</c> cells.
+		*/
+		void Init(const FBox2D& InBounds, float InCellSize = DefaultCellSize, int64 MaxCellCount = DefaultMaxCellCount);
+
+		void Reset();
+
+		bool IsInitialized() const;
+
+		/*
+		* Marks every cell touched by <c>Box</c> as occupied.
+		*/
+		void MarkOccupied(const FBox2D& Box);
+
+		/*
+		* Marks every cell touched by <c>Box</c> as free.
+		*/
+		void ClearRegion(const FBox2D& Box);
+
+		bool IsFree(const FBox2D& Box) const;
+
+		/*
+		* Searches outward from <c>Center</c> in rings of cells for the closest location within <c>MaxRadius</c> where a box of <c>Extent</c> is free
+		* and <c>Predicate(const FVector2D& Location)</c> returns true. Candidate locations are offset from <c>Center</c> by whole cells.
+		*/
+		template<typename Func>
+		TOptional<FVector2D> FindNearestFree(const FVector2D& Center, const FVector2D& Extent, float MaxRadius, Func&& Predicate) const;
+		TOptional<FVector2D> FindNearestFree(const FVector2D& Center, const FVector2D& Extent, float MaxRadius) const;
+
+		const FBox2D& GetBounds() const;
+		float GetCellSize() const;
+		FIntPoint GetCellCount() const;
+		int32 NumOccupied() const;
+
+	private:
+		/*
+		* Range of cells touched by <c>Box</c> clamped to the grid. Returns false if the box is entirely outside the grid.
+		*/
+		bool GetCellRange(const FBox2D& Box, FIntPoint& OutMin, FIntPoint& OutMax) const;
+
+		int32 ToIndex(int32 X, int32 Y) const;
+
+		void SetRegion(const FBox2D& Box, bool bOccupied);
+
+	private:
+		FBox2D Bounds{ EForceInit::ForceInit };
+		float CellSize{ DefaultCellSize };
+		int32 CellCountX{};
+		int32 CellCountY{};
+
+		TBitArray<> Occupied{};
+	};
+}
+
+#pragma region Inline Definitions
+
+namespace TR
+{
+	template<typename Func>
+	TOptional<FVector2D> FOccupancyGrid2D::FindNearestFree(const FVector2D& Center, const FVector2D& Extent, float MaxRadius, Func&& Predicate) const
+	{
+		const auto MaxRing = FMath::Max(0, FMath::CeilToInt32(MaxRadius / CellSize));
+		const auto MaxRadiusSq = FMath::Square(static_cast<double>(MaxRadius));
+
+		TOptional<FVector2D> Best;
+		double BestDistSq = MaxRadiusSq;
+
+		for (int32 Ring = 0; Ring <= MaxRing; ++Ring)
+		{
+			// Every candidate on this ring is at least Ring cells away so nothing closer can be found
+			if (Best && FMath::Square(Ring * static_cast<double>(CellSize)) > BestDistSq)
+			{
+				break;
+			}
+
+			const auto TestCandidate = [&](int32 DX, int32 DY)
+			{
+				const FVector2D Offset(DX * CellSize, DY * CellSize);
+				const auto DistSq = Offset.SizeSquared();
+
+				if (DistSq > BestDistSq || (Best && DistSq == BestDistSq))
+				{
+					return;
+				}
+
+				const auto Location = Center + Offset;
+
+				if (IsFree(FBox2D(Location - Extent, Location + Extent)) && Predicate(Location))
+				{
+					Best = Location;
+					BestDistSq = DistSq;
+				}
+			};
+
+			if (Ring == 0)
+			{
+				TestCandidate(0, 0);
+				continue;
+			}
+
+			// Top and bottom rows then the left and right columns without the corners
+			for (int32 D = -Ring; D <= Ring; ++D)
+			{
+				TestCandidate(D, -Ring);
+				TestCandidate(D, Ring);
+			}
+
+			for (int32 D = -Ring + 1; D < Ring; ++D)
+			{
+				TestCandidate(-Ring, D);
+				TestCandidate(Ring, D);
+			}
+		}
+
+		return Best;
+	}
+
+	inline TOptional<FVector2D> FOccupancyGrid2D::FindNearestFree(const FVector2D& Center, const FVector2D& Extent, float MaxRadius) const
+	{
+		return FindNearestFree(Center, Extent, MaxRadius, [](const FVector2D&) { return true; });
+	}
+
+	inline bool FOccupancyGrid2D::IsInitialized() const
+	{
+		return CellCountX > 0 && CellCountY > 0;
+	}
+
+	inline void FOccupancyGrid2D::MarkOccupied(const FBox2D& Box)
+	{
+		SetRegion(Box, true);
+	}
+
+	inline void FOccupancyGrid2D::ClearRegion(const FBox2D& Box)
+	{
+		SetRegion(Box, false);
+	}
+
+	inline const FBox2D& FOccupancyGrid2D::GetBounds() const
+	{
+		return Bounds;
+	}
+
+	inline float FOccupancyGrid2D::GetCellSize() const
+	{
+		return CellSize;
+	}
+
+	inline FIntPoint FOccupancyGrid2D::GetCellCount() const
+	{
+		return { CellCountX, CellCountY };
+	}
+
+	inline int32 FOccupancyGrid2D::ToIndex(int32 X, int32 Y) const
+	{
+		return Y * CellCountX + X;
+	}
+}
+
+#pragma endregion Inline Definitions
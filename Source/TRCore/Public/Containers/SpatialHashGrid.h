@@ -0,0 +1,479 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <concepts>
+
+namespace TR
+{
+	template<typename T>
+	concept SpatialHashElementConcept = std::equality_comparable<T> && requires(const T& t)
+	{
+		{
+			GetTypeHash(t)
+		} -> std::convertible_to<uint32>;
+	};
+
+	/**
+	 * Uniform grid in the XY plane of point elements with a bounding radius.
+	 * Distances are always measured in 3D from the stored locations so the grid suits objects spread over terrain like tanks.
+	 * Element locations are only updated with <c>Update</c> so the grid does not need to know how to find them.
+	 */
+	template<SpatialHashElementConcept ElementType>
+	class TSpatialHashGrid
+	{
+	public:
+		static constexpr float DefaultCellSize = 1000.0f;
+
+		explicit TSpatialHashGrid(float InCellSize = DefaultCellSize);
+
+		/*
+		* Adds the element or updates its location and radius if it was already added.
+		*/
+		void Add(const ElementType& Element, const FVector& Location, float Radius = 0.0f);
+
+		/*
+		* Updates the location of an existing element. Returns false if the element was not added.
+		*/
+		bool Update(const ElementType& Element, const FVector& Location);
+
+		bool Remove(const ElementType& Element);
+
+		bool Contains(const ElementType& Element) const;
+		const FVector* FindLocation(const ElementType& Element) const;
+
+		int32 Num() const;
+		bool IsEmpty() const;
+		float GetCellSize() const;
+
+		/* Largest radius of any element added since the last reset. */
+		float GetMaxElementRadius() const;
+
+		/*
+		* Removes all elements and changes the cell size.
+		*/
+		void Reset(float InCellSize);
+		void Reset();
+
+		/*
+		* Calls <c>Func(const ElementType&, const FVector& Location)</c> for every element.
+		*/
+		template<typename Func>
+		void ForEach(Func&& Callback) const;
+
+		/*
+		* Calls <c>Func(const ElementType&, const FVector& Location, double DistanceSquared)</c> for every element with a location within <c>Radius</c> of <c>Center</c>.
+		*/
+		template<typename Func>
+		void ForEachInRadius(const FVector& Center, float Radius, Func&& Callback) const;
+
+		/*
+		* Calls <c>Func(const ElementType&, const FVector& Location)</c> for elements whose bounding sphere overlaps the box until <c>Func</c> returns true.
+		* Returns true if any call returned true.
+		*/
+		template<typename Func>
+		bool AnyInBox(const FBox& Box, Func&& Predicate) const;
+
+		/*
+		* Finds up to <c>Count</c> elements closest to <c>Center</c> within <c>MaxRadius</c> that pass <c>Predicate(const ElementType&)</c>, sorted nearest first.
+		*/
+		template<typename Func>
+		void FindNearest(const FVector& Center, int32 Count, float MaxRadius, Func&& Predicate, TArray<ElementType>& OutElements) const;
+
+	private:
+		struct FEntry
+		{
+			ElementType Element;
+			FVector Location;
+			float Radius;
+			FIntPoint Cell;
+		};
+
+		using FCellIndices = TArray<int32, TInlineAllocator<4>>;
+
+		FIntPoint GetCell(const FVector& Location) const;
+		FIntRect GetCellRange(const FVector& Center, float Extent) const;
+
+		void AddToCell(const FIntPoint& Cell, int32 EntryIndex);
+		void RemoveFromCell(const FIntPoint& Cell, int32 EntryIndex);
+
+		template<typename Func>
+		void ForEachEntryInCells(const FIntRect& CellRange, Func&& Callback) const;
+
+	private:
+		TArray<FEntry> Entries{};
+		TMap<ElementType, int32> EntryIndices{};
+		TMap<FIntPoint, FCellIndices> Cells{};
+
+		float CellSize{};
+		float InvCellSize{};
+
+		/* Largest element radius added so that box queries can expand the cells visited. Never shrinks. */
+		float MaxElementRadius{};
+	};
+
+#pragma region Template Definitions
+
+	template<SpatialHashElementConcept ElementType>
+	TSpatialHashGrid<ElementType>::TSpatialHashGrid(float InCellSize) :
+		CellSize(InCellSize), InvCellSize(1.0f / InCellSize)
+	{
+		check(InCellSize > 0);
+	}
+
+	template<SpatialHashElementConcept ElementType>
+	void TSpatialHashGrid<ElementType>::Add(const ElementType& Element, const FVector& Location, float Radius)
+	{
+		MaxElementRadius = FMath::Max(MaxElementRadius, Radius);
+
+		if (auto ExistingIndex = EntryIndices.Find(Element); ExistingIndex)
+		{
+			Entries[*ExistingIndex].Radius = Radius;
+			Update(Element, Location);
+			return;
+		}
+
+		const auto Cell = GetCell(Location);
+		const auto Index = Entries.Add(FEntry
+		{
+			.Element = Element,
+			.Location = Location,
+			.Radius = Radius,
+			.Cell = Cell
+		});
+
+		EntryIndices.Add(Element, Index);
+		AddToCell(Cell, Index);
+	}
+
+	template<SpatialHashElementConcept ElementType>
+	bool TSpatialHashGrid<ElementType>::Update(const ElementType& Element, const FVector& Location)
+	{
+		auto Index = EntryIndices.Find(Element);
+		if (!Index)
+		{
+			return false;
+		}
+
+		auto& Entry = Entries[*Index];
+		Entry.Location = Location;
+
+		if (const auto Cell = GetCell(Location); Cell != Entry.Cell)
+		{
+			RemoveFromCell(Entry.Cell, *Index);
+			AddToCell(Cell, *Index);
+			Entry.Cell = Cell;
+		}
+
+		return true;
+	}
+
+	template<SpatialHashElementConcept ElementType>
+	bool TSpatialHashGrid<ElementType>::Remove(const ElementType& Element)
+	{
+		int32 Index;
+		if (!EntryIndices.RemoveAndCopyValue(Element, Index))
+		{
+			return false;
+		}
+
+		RemoveFromCell(Entries[Index].Cell, Index);
+
+		// Swap the last entry into the removed slot and fix up its references
+		const auto LastIndex = Entries.Num() - 1;
+		if (Index != LastIndex)
+		{
+			const auto& LastEntry = Entries[LastIndex];
+
+			EntryIndices[LastEntry.Element] = Index;
+
+			auto& LastCellIndices = Cells.FindChecked(LastEntry.Cell);
+			LastCellIndices[LastCellIndices.IndexOfByKey(LastIndex)] = Index;
+		}
+
+		Entries.RemoveAtSwap(Index, 1, false);
+
+		return true;
+	}
+
+	template<SpatialHashElementConcept ElementType>
+	inline bool TSpatialHashGrid<ElementType>::Contains(const ElementType& Element) const
+	{
+		return EntryIndices.Contains(Element);
+	}
+
+	template<SpatialHashElementConcept ElementType>
+	inline const FVector* TSpatialHashGrid<ElementType>::FindLocation(const ElementType& Element) const
+	{
+		auto Index = EntryIndices.Find(Element);
+		return Index ? &Entries[*Index].Location : nullptr;
+	}
+
+	template<SpatialHashElementConcept ElementType>
+	inline int32 TSpatialHashGrid<ElementType>::Num() const
+	{
+		return Entries.Num();
+	}
+
+	template<SpatialHashElementConcept ElementType>
+	inline bool TSpatialHashGrid<ElementType>::IsEmpty() const
+	{
+		return Entries.IsEmpty();
+	}
+
+	template<SpatialHashElementConcept ElementType>
+	inline float TSpatialHashGrid<ElementType>::GetCellSize() const
+	{
+		return CellSize;
+	}
+
+	template<SpatialHashElementConcept ElementType>
+	inline float TSpatialHashGrid<ElementType>::GetMaxElementRadius() const
+	{
+		return MaxElementRadius;
+	}
+
+	template<SpatialHashElementConcept ElementType>
+	void TSpatialHashGrid<ElementType>::Reset(float InCellSize)
+	{
+		check(InCellSize > 0);
+
+		Reset();
+
+		CellSize = InCellSize;
+		InvCellSize = 1.0f / InCellSize;
+	}
+
+	template<SpatialHashElementConcept ElementType>
+	void TSpatialHashGrid<ElementType>::Reset()
+	{
+		Entries.Reset();
+		EntryIndices.Reset();
+		Cells.Reset();
+		MaxElementRadius = 0.0f;
+	}
+
+	template<SpatialHashElementConcept ElementType>
+	template<typename Func>
+	void TSpatialHashGrid<ElementType>::ForEach(Func&& Callback) const
+	{
+		for (const auto& Entry : Entries)
+		{
+			Callback(Entry.Element, Entry.Location);
+		}
+	}
+
+	template<SpatialHashElementConcept ElementType>
+	template<typename Func>
+	void TSpatialHashGrid<ElementType>::ForEachInRadius(const FVector& Center, float Radius, Func&& Callback) const
+	{
+		const auto RadiusSq = FMath::Square(static_cast<double>(Radius));
+
+		ForEachEntryInCells(GetCellRange(Center, Radius), [&](const FEntry& Entry)
+		{
+			if (const auto DistSq = FVector::DistSquared(Entry.Location, Center); DistSq <= RadiusSq)
+			{
+				Callback(Entry.Element, Entry.Location, DistSq);
+			}
+		});
+	}
+
+	template<SpatialHashElementConcept ElementType>
+	template<typename Func>
+	bool TSpatialHashGrid<ElementType>::AnyInBox(const FBox& Box, Func&& Predicate) const
+	{
+		FVector BoxCenter, BoxExtent;
+		Box.GetCenterAndExtents(BoxCenter, BoxExtent);
+
+		bool bFound{};
+
+		ForEachEntryInCells(GetCellRange(BoxCenter, FMath::Max(BoxExtent.X, BoxExtent.Y) + MaxElementRadius), [&](const FEntry& Entry)
+		{
+			if (!bFound && Box.ComputeSquaredDistanceToPoint(Entry.Location) <= FMath::Square(Entry.Radius))
+			{
+				bFound = Predicate(Entry.Element, Entry.Location);
+			}
+		});
+
+		return bFound;
+	}
+
+	template<SpatialHashElementConcept ElementType>
+	template<typename Func>
+	void TSpatialHashGrid<ElementType>::FindNearest(const FVector& Center, int32 Count, float MaxRadius, Func&& Predicate, TArray<ElementType>& OutElements) const
+	{
+		OutElements.Reset();
+
+		if (Count <= 0 || Entries.IsEmpty())
+		{
+			return;
+		}
+
+		struct FCandidate
+		{
+			double DistSq;
+			int32 Index;
+		};
+
+		// Max heap of the current best so that the furthest is replaced first
+		TArray<FCandidate, TInlineAllocator<16>> Best;
+		const auto Compare = [](const FCandidate& First, const FCandidate& Second) { return First.DistSq > Second.DistSq; };
+
+		const auto MaxRadiusSq = FMath::Square(static_cast<double>(MaxRadius));
+
+		const auto VisitEntry = [&](const FEntry& Entry)
+		{
+			const auto DistSq = FVector::DistSquared(Entry.Location, Center);
+			if (DistSq > MaxRadiusSq || (Best.Num() == Count && DistSq >= Best.HeapTop().DistSq) || !Predicate(Entry.Element))
+			{
+				return;
+			}
+
+			if (Best.Num() == Count)
+			{
+				Best.HeapPopDiscard(Compare, false);
+			}
+
+			Best.HeapPush(FCandidate{ DistSq, static_cast<int32>(&Entry - Entries.GetData()) }, Compare);
+		};
+
+		// Expand rings of cells outward from the center until the remaining cells can't contain anything closer
+		const auto CenterCell = GetCell(Center);
+		// Clamp so that an unbounded radius doesn't overflow - the linear scan below takes over long before this
+		const auto MaxRing = static_cast<int32>(FMath::Min(FMath::CeilToDouble(MaxRadius * InvCellSize), static_cast<double>(1 << 20)));
+
+		for (int32 Ring = 0; Ring <= MaxRing; ++Ring)
+		{
+			// Every element in the unvisited rings is at least this far away
+			const auto VisitedDistance = static_cast<double>(Ring - 1) * CellSize;
+			if (Ring > 0 && Best.Num() == Count && Best.HeapTop().DistSq <= FMath::Square(VisitedDistance))
+			{
+				break;
+			}
+
+			// More cells left in the ring than elements so just check everything once
+			if (FMath::Square(2 * Ring + 1) > Entries.Num() * 4)
+			{
+				Best.Reset();
+
+				for (const auto& Entry : Entries)
+				{
+					VisitEntry(Entry);
+				}
+
+				break;
+			}
+
+			for (int32 X = -Ring; X <= Ring; ++X)
+			{
+				const bool bEdgeColumn = FMath::Abs(X) == Ring;
+
+				for (int32 Y = -Ring; Y <= Ring; Y += bEdgeColumn ? 1 : 2 * FMath::Max(Ring, 1))
+				{
+					if (auto CellIndices = Cells.Find(CenterCell + FIntPoint{ X, Y }); CellIndices)
+					{
+						for (auto Index : *CellIndices)
+						{
+							VisitEntry(Entries[Index]);
+						}
+					}
+				}
+			}
+		}
+
+		Best.Sort([](const FCandidate& First, const FCandidate& Second) { return First.DistSq < Second.DistSq; });
+
+		OutElements.Reserve(Best.Num());
+		for (const auto& Candidate : Best)
+		{
+			OutElements.Add(Entries[Candidate.Index].Element);
+		}
+	}
+
+	template<SpatialHashElementConcept ElementType>
+	inline FIntPoint TSpatialHashGrid<ElementType>::GetCell(const FVector& Location) const
+	{
+		return FIntPoint
+		{
+			FMath::FloorToInt32(Location.X * InvCellSize),
+			FMath::FloorToInt32(Location.Y * InvCellSize)
+		};
+	}
+
+	template<SpatialHashElementConcept ElementType>
+	inline FIntRect TSpatialHashGrid<ElementType>::GetCellRange(const FVector& Center, float Extent) const
+	{
+		return FIntRect
+		{
+			GetCell(Center - FVector{ Extent, Extent, 0.0 }),
+			GetCell(Center + FVector{ Extent, Extent, 0.0 })
+		};
+	}
+
+	template<SpatialHashElementConcept ElementType>
+	void TSpatialHashGrid<ElementType>::AddToCell(const FIntPoint& Cell, int32 EntryIndex)
+	{
+		Cells.FindOrAdd(Cell).Add(EntryIndex);
+	}
+
+	template<SpatialHashElementConcept ElementType>
+	void TSpatialHashGrid<ElementType>::RemoveFromCell(const FIntPoint& Cell, int32 EntryIndex)
+	{
+		auto CellIndices = Cells.Find(Cell);
+		if (!ensure(CellIndices))
+		{
+			return;
+		}
+
+		CellIndices->RemoveSingleSwap(EntryIndex, false);
+
+		if (CellIndices->IsEmpty())
+		{
+			Cells.Remove(Cell);
+		}
+	}
+
+	template<SpatialHashElementConcept ElementType>
+	template<typename Func>
+	void TSpatialHashGrid<ElementType>::ForEachEntryInCells(const FIntRect& CellRange, Func&& Callback) const
+	{
+		const auto NumCells = static_cast<int64>(CellRange.Width() + 1) * (CellRange.Height() + 1);
+
+		// Large queries relative to the number of elements are cheaper as a linear scan than hashing every cell
+		if (NumCells > Cells.Num())
+		{
+			for (const auto& [Cell, CellIndices] : Cells)
+			{
+				if (Cell.X < CellRange.Min.X || Cell.X > CellRange.Max.X || Cell.Y < CellRange.Min.Y || Cell.Y > CellRange.Max.Y)
+				{
+					continue;
+				}
+
+				for (auto Index : CellIndices)
+				{
+					Callback(Entries[Index]);
+				}
+			}
+
+			return;
+		}
+
+		for (int32 X = CellRange.Min.X; X <= CellRange.Max.X; ++X)
+		{
+			for (int32 Y = CellRange.Min.Y; Y <= CellRange.Max.Y; ++Y)
+			{
+				if (auto CellIndices = Cells.Find(FIntPoint{ X, Y }); CellIndices)
+				{
+					for (auto Index : *CellIndices)
+					{
+						Callback(Entries[Index]);
+					}
+				}
+			}
+		}
+	}
+
+#pragma endregion Template Definitions
+}
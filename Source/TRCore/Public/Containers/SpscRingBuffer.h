@@ -0,0 +1,153 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <atomic>
+#include <concepts>
+
+namespace TR
+{
+	template<typename T>
+	concept SpscRingBufferElementConcept = std::is_trivially_copyable_v<T> && std::default_initializable<T>;
+
+	/**
+	 * Fixed capacity lock-free ring for exactly one producer thread and one consumer thread, e.g. the game thread handing records to a writer thread.
+	 * Elements are copied in and out so only trivially copyable types are allowed. A full ring rejects new elements rather than blocking the producer.
+	 */
+	template<SpscRingBufferElementConcept T>
+	class TSpscRingBuffer
+	{
+	public:
+		/*
+		* Capacity is rounded up to a power of two.
+		*/
+		explicit TSpscRingBuffer(uint32 InCapacity);
+
+		TSpscRingBuffer(const TSpscRingBuffer&) = delete;
+		TSpscRingBuffer& operator=(const TSpscRingBuffer&) = delete;
+
+		/*
+		* Producer only. Returns false if the ring is full.
+		*/
+		bool Push(const T& Element);
+
+		/*
+		* Consumer only. Returns false if the ring is empty.
+		*/
+		bool Pop(T& OutElement);
+
+		/*
+		* Consumer only. Pops up to <c>MaxCount</c> elements onto the end of <c>OutElements</c> and returns the number popped.
+		*/
+		template<typename AllocatorType>
+		int32 PopAll(TArray<T, AllocatorType>& OutElements, int32 MaxCount = TNumericLimits<int32>::Max());
+
+		/*
+		* Approximate when called from a thread other than the producer or consumer.
+		*/
+		uint32 Num() const;
+		bool IsEmpty() const;
+		uint32 Capacity() const;
+
+	private:
+		TArray<T> Elements{};
+		uint32 Mask{};
+
+		/* Kept on separate cache lines so that the producer and consumer don't contend. */
+		alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> WriteIndex{};
+		alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> ReadIndex{};
+	};
+
+#pragma region Template Definitions
+
+	template<SpscRingBufferElementConcept T>
+	TSpscRingBuffer<T>::TSpscRingBuffer(uint32 InCapacity)
+	{
+		check(InCapacity > 0);
+
+		const auto RoundedCapacity = FMath::RoundUpToPowerOfTwo(InCapacity);
+		Elements.SetNum(RoundedCapacity);
+		Mask = RoundedCapacity - 1;
+	}
+
+	template<SpscRingBufferElementConcept T>
+	inline bool TSpscRingBuffer<T>::Push(const T& Element)
+	{
+		const auto Write = WriteIndex.load(std::memory_order_relaxed);
+		const auto Read = ReadIndex.load(std::memory_order_acquire);
+
+		// Indices wrap around uint32 so the difference is the count even after overflow
+		if (Write - Read > Mask)
+		{
+			return false;
+		}
+
+		Elements[Write & Mask] = Element;
+		WriteIndex.store(Write + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	template<SpscRingBufferElementConcept T>
+	inline bool TSpscRingBuffer<T>::Pop(T& OutElement)
+	{
+		const auto Read = ReadIndex.load(std::memory_order_relaxed);
+		const auto Write = WriteIndex.load(std::memory_order_acquire);
+
+		if (Read == Write)
+		{
+			return false;
+		}
+
+		OutElement = Elements[Read & Mask];
+		ReadIndex.store(Read + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	template<SpscRingBufferElementConcept T>
+	template<typename AllocatorType>
+	int32 TSpscRingBuffer<T>::PopAll(TArray<T, AllocatorType>& OutElements, int32 MaxCount)
+	{
+		const auto Read = ReadIndex.load(std::memory_order_relaxed);
+		const auto Write = WriteIndex.load(std::memory_order_acquire);
+
+		const auto Count = static_cast<int32>(FMath::Min<uint32>(Write - Read, static_cast<uint32>(MaxCount)));
+		if (Count == 0)
+		{
+			return 0;
+		}
+
+		OutElements.Reserve(OutElements.Num() + Count);
+		for (int32 i = 0; i < Count; ++i)
+		{
+			OutElements.Add(Elements[(Read + i) & Mask]);
+		}
+
+		ReadIndex.store(Read + Count, std::memory_order_release);
+
+		return Count;
+	}
+
+	template<SpscRingBufferElementConcept T>
+	inline uint32 TSpscRingBuffer<T>::Num() const
+	{
+		return WriteIndex.load(std::memory_order_acquire) - ReadIndex.load(std::memory_order_acquire);
+	}
+
+	template<SpscRingBufferElementConcept T>
+	inline bool TSpscRingBuffer<T>::IsEmpty() const
+	{
+		return Num() == 0;
+	}
+
+	template<SpscRingBufferElementConcept T>
+	inline uint32 TSpscRingBuffer<T>::Capacity() const
+	{
+		return Mask + 1;
+	}
+
+#pragma endregion Template Definitions
+}
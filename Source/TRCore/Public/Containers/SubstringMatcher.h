@@ -0,0 +1,84 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace TR
+{
+	/**
+	 * Case insensitive test of whether a string contains any of a set of substrings in a single pass over the string.
+	 * The substrings are compiled into an Aho-Corasick automaton stored as a dense transition table over the characters that appear in them,
+	 * so matching is one table lookup per character regardless of the number of substrings.
+	 *
+	 * Matches <c>FString::Contains</c> with the default case insensitive search, including an empty substring matching everything.
+	 */
+	class TRCORE_API FSubstringMatcher
+	{
+	public:
+		FSubstringMatcher() = default;
+		explicit FSubstringMatcher(TConstArrayView<FString> Substrings);
+
+		void Compile(TConstArrayView<FString> Substrings);
+
+		bool Matches(FStringView Input) const;
+
+		bool IsEmpty() const;
+		int32 NumStates() const;
+
+	private:
+		static constexpr int32 AsciiCount = 128;
+
+		int32 GetSymbol(TCHAR Char) const;
+		int32 AddSymbol(TCHAR Char);
+
+	private:
+		/* NumStates x SymbolCount table of the next state. State 0 is the root. */
+		TArray<int32> Transitions{};
+
+		/* Whether a substring ends at the state or at any state on its failure chain. */
+		TBitArray<> Accepting{};
+
+		/* Symbol of each upper case ASCII character or INDEX_NONE if it is not in any substring. */
+		TArray<int32, TFixedAllocator<AsciiCount>> AsciiSymbols{};
+		TMap<TCHAR, int32> OtherSymbols{};
+
+		int32 SymbolCount{};
+		bool bMatchesAll{};
+	};
+}
+
+#pragma region Inline Definitions
+
+namespace TR
+{
+	inline FSubstringMatcher::FSubstringMatcher(TConstArrayView<FString> Substrings)
+	{
+		Compile(Substrings);
+	}
+
+	inline bool FSubstringMatcher::IsEmpty() const
+	{
+		return !bMatchesAll && Accepting.IsEmpty();
+	}
+
+	inline int32 FSubstringMatcher::NumStates() const
+	{
+		return Accepting.Num();
+	}
+
+	inline int32 FSubstringMatcher::GetSymbol(TCHAR Char) const
+	{
+		const auto Upper = TChar<TCHAR>::ToUpper(Char);
+
+		if (static_cast<uint32>(Upper) < AsciiCount)
+		{
+			return AsciiSymbols[Upper];
+		}
+
+		const auto Symbol = OtherSymbols.Find(Upper);
+		return Symbol ? *Symbol : INDEX_NONE;
+	}
+}
+
+#pragma endregion Inline Definitions
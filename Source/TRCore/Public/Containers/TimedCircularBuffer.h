@@ -58,14 +58,131 @@ namespace TR
 		} -> std::convertible_to<TThreshold>;
 	};
 
+	template<typename T>
+	concept CircularBufferRunningSumConcept = CircularBufferSumConcept<T> && CircularBufferDifferenceConcept<T>;
+
+	template<typename TPolicy, typename T>
+	concept CircularBufferAggregatePolicyConcept = std::default_initializable<TPolicy> &&
+		requires(TPolicy Policy, const T& Value, uint32 Sequence, int32 Capacity)
+	{
+		Policy.Reset(Capacity);
+		Policy.OnAdd(Value, Sequence);
+		Policy.OnEvict(Value, Sequence);
+	};
+
 #pragma endregion Concepts
+
+#pragma region Aggregate Policies
+
+	/*
+	* Keeps no aggregates so queries loop over the buffer.
+	*/
+	template<typename T, typename TDefaultValueFunc>
+	class TCircularBufferNoAggregate
+	{
+	public:
+		void Reset(int32 /* Capacity */) {}
+		void OnAdd(const T& /* Value */, uint32 /* Sequence */) {}
+		void OnEvict(const T& /* Value */, uint32 /* Sequence */) {}
+	};
+
+	/*
+	* Keeps a running sum updated as values are added and evicted so that <c>Sum</c> and <c>Average</c> are constant time.
+	* Floating point sums use Kahan-Babuska compensated summation so that adding and evicting values every tick does not drift.
+	* Plain Kahan summation is not enough as it loses the compensation when a large value is evicted.
+	* The sum starts from the default value as it does when looping over the buffer and evicted values are subtracted directly so the default need not be zero.
+	*/
+	template<typename T, typename TDefaultValueFunc>
+	class TCircularBufferRunningSum
+	{
+	public:
+		void Reset(int32 Capacity);
+		void OnAdd(const T& Value, uint32 Sequence);
+		void OnEvict(const T& Value, uint32 Sequence);
+
+		T GetSum() const;
+
+	private:
+		void Accumulate(const T& Value);
+		void Deduct(const T& Value);
+
+	private:
+		T RunningSum{ (TDefaultValueFunc{})() };
+		T Compensation{ RunningSum - RunningSum };
+	};
+
+	/*
+	* Running sum along with monotonic queues of the values in the buffer so that <c>Min</c> and <c>Max</c> are amortized constant time.
+	*/
+	template<typename T, typename TDefaultValueFunc>
+	class TCircularBufferRunningSumMinMax : public TCircularBufferRunningSum<T, TDefaultValueFunc>
+	{
+		using Super = TCircularBufferRunningSum<T, TDefaultValueFunc>;
+
+	public:
+		void Reset(int32 Capacity);
+		void OnAdd(const T& Value, uint32 Sequence);
+		void OnEvict(const T& Value, uint32 Sequence);
+
+		const T& GetMin() const;
+		const T& GetMax() const;
+
+	private:
+		struct FEntry
+		{
+			T Value;
+			uint32 Sequence;
+		};
+
+		/*
+		* Fixed capacity double ended queue of entries in increasing sequence order.
+		*/
+		class FMonotonicQueue
+		{
+		public:
+			void Reset(int32 Capacity);
+
+			/*
+			* Removes entries from the back that the new value supersedes before adding it.
+			*/
+			template<typename TCompare>
+			void Push(const T& Value, uint32 Sequence, TCompare Supersedes);
+			void PopIfFront(uint32 Sequence);
+
+			const T& Front() const;
+			bool IsEmpty() const { return Num == 0; }
+
+		private:
+			TArray<FEntry> Entries{};
+			int32 Head{};
+			int32 Num{};
+		};
+
+	private:
+		FMonotonicQueue MinQueue{};
+		FMonotonicQueue MaxQueue{};
+	};
+
+	/*
+	* Running sum for types that can be added and subtracted and no aggregates otherwise.
+	*/
+	template<typename T, typename TDefaultValueFunc>
+	using TDefaultCircularBufferAggregate = std::conditional_t<CircularBufferRunningSumConcept<T>,
+		TCircularBufferRunningSum<T, TDefaultValueFunc>,
+		TCircularBufferNoAggregate<T, TDefaultValueFunc>>;
+
+#pragma endregion Aggregate Policies
+
 	/**
-	 *
+	 * Fixed capacity ring buffer of the most recent samples over a time window.
+	 * Aggregates are maintained by <c>TAggregatePolicy</c> as values are added and evicted, so <c>Sum</c>, <c>Average</c> and, with
+	 * <c>TCircularBufferRunningSumMinMax</c>, <c>Min</c> and <c>Max</c> do not loop over the buffer.
 	 */
 	template<typename T, 
 			 typename TDefaultValueFunc = decltype([]() { return T{}; }),
-		     typename TDefaultThresholdFunc = decltype([](const T& t) { return FMath::Abs(t); })
-	> requires CircularBufferConcept<T, TDefaultValueFunc>
+		     typename TDefaultThresholdFunc = decltype([](const T& t) { return FMath::Abs(t); }),
+			 typename TAggregatePolicy = TDefaultCircularBufferAggregate<T, TDefaultValueFunc>
+	> requires CircularBufferConcept<T, TDefaultValueFunc> && CircularBufferAggregatePolicyConcept<TAggregatePolicy, T>
 	class TTimedCircularBuffer
 	{
 	public:
@@ -92,6 +209,9 @@ namespace TR
 		T Sum() const requires CircularBufferSumConcept<T>;
 		T Delta() const requires CircularBufferDifferenceConcept<T>;
 
+		T Min() const requires requires(const TAggregatePolicy& Policy) { Policy.GetMin(); Policy.GetMax(); };
+		T Max() const requires requires(const TAggregatePolicy& Policy) { Policy.GetMin(); Policy.GetMax(); };
+
 		template<typename TThreshold, typename TFunc = TDefaultThresholdFunc>
 		bool IsZero(const TThreshold& Threshold = {}, const TFunc& Func = {}) const
 			requires CircularBufferSumConcept<T> && CircularBufferMangitudeConcept<T, TFunc, TThreshold>;
@@ -104,10 +224,17 @@ namespace TR
 	private:
 		uint32 NextIndex() const;
 
+		/*
+		* Notifies the policy of the value about to be overwritten by the next add.
+		*/
+		void EvictForAdd();
+
 
 	private:
 		TArray<T> Buffer{};
 		uint32 Count{};
+
+		TAggregatePolicy Aggregates{};
 	};
 }
 
@@ -117,80 +244,112 @@ namespace TR
 {
 #pragma region Inline Definitions
 
-	template<typename T, typename TDefaultValueFunc, typename TDefaultThresholdFunc> requires CircularBufferConcept<T, TDefaultValueFunc>
-	inline bool TTimedCircularBuffer<T, TDefaultValueFunc, TDefaultThresholdFunc>::IsEmpty() const
+	template<typename T, typename TDefaultValueFunc, typename TDefaultThresholdFunc, typename TAggregatePolicy> requires CircularBufferConcept<T, TDefaultValueFunc> && CircularBufferAggregatePolicyConcept<TAggregatePolicy, T>
+	inline bool TTimedCircularBuffer<T, TDefaultValueFunc, TDefaultThresholdFunc, TAggregatePolicy>::IsEmpty() const
 	{
 		return Count == 0;
 	}
 
-	template<typename T, typename TDefaultValueFunc, typename TDefaultThresholdFunc> requires CircularBufferConcept<T, TDefaultValueFunc>
-	inline bool TTimedCircularBuffer<T, TDefaultValueFunc, TDefaultThresholdFunc>::IsFull() const
+	template<typename T, typename TDefaultValueFunc, typename TDefaultThresholdFunc, typename TAggregatePolicy> requires CircularBufferConcept<T, TDefaultValueFunc> && CircularBufferAggregatePolicyConcept<TAggregatePolicy, T>
+	inline bool TTimedCircularBuffer<T, TDefaultValueFunc, TDefaultThresholdFunc, TAggregatePolicy>::IsFull() const
 	{
 		return Count >= Capacity();
 	}
 	 
-	template<typename T, typename TDefaultValueFunc, typename TDefaultThresholdFunc> requires CircularBufferConcept<T, TDefaultValueFunc>
-	inline void TTimedCircularBuffer<T, TDefaultValueFunc, TDefaultThresholdFunc>::Add(T&& Value) requires std::movable<T>
+	template<typename T, typename TDefaultValueFunc, typename TDefaultThresholdFunc, typename TAggregatePolicy> requires CircularBufferConcept<T, TDefaultValueFunc> && CircularBufferAggregatePolicyConcept<TAggregatePolicy, T>
+	inline void TTimedCircularBuffer<T, TDefaultValueFunc, TDefaultThresholdFunc, TAggregatePolicy>::Add(T&& Value) requires std::movable<T>
 	{
-		Buffer[NextIndex()] = std::move(Value);
+		EvictForAdd();
+
+		auto& Added = Buffer[NextIndex()];
+		Added = std::move(Value);
+		Aggregates.OnAdd(Added, Count);
+
 		++Count;
 		// We could overflow here but since using unsigned that would just clear the buffer which isn't terrible so no need to put in a truncation
 		// This is merely theoretical and actual usage will never overflow
 	}
 
-	template<typename T, typename TDefaultValueFunc, typename TDefaultThresholdFunc> requires CircularBufferConcept<T, TDefaultValueFunc>
-	inline void TTimedCircularBuffer<T, TDefaultValueFunc, TDefaultThresholdFunc>::Add(const T& Value) requires std::assignable_from<T&, T>
+	template<typename T, typename TDefaultValueFunc, typename TDefaultThresholdFunc, typename TAggregatePolicy> requires CircularBufferConcept<T, TDefaultValueFunc> && CircularBufferAggregatePolicyConcept<TAggregatePolicy, T>
+	inline void TTimedCircularBuffer<T, TDefaultValueFunc, TDefaultThresholdFunc, TAggregatePolicy>::Add(const T& Value) requires std::assignable_from<T&, T>
 	{
-		Buffer[NextIndex()] = Value;
+		EvictForAdd();
+
+		auto& Added = Buffer[NextIndex()];
+		Added = Value;
+		Aggregates.OnAdd(Added, Count);
+
 		++Count;
 	}
 
-	template<typename T, typename TDefaultValueFunc, typename TDefaultThresholdFunc> requires CircularBufferConcept<T, TDefaultValueFunc>
-	inline void TTimedCircularBuffer<T, TDefaultValueFunc, TDefaultThresholdFunc>::Clear()
+	template<typename T, typename TDefaultValueFunc, typename TDefaultThresholdFunc, typename TAggregatePolicy> requires CircularBufferConcept<T, TDefaultValueFunc> && CircularBufferAggregatePolicyConcept<TAggregatePolicy, T>
+	inline void TTimedCircularBuffer<T, TDefaultValueFunc, TDefaultThresholdFunc, TAggregatePolicy>::EvictForAdd()
+	{
+		if (IsFull())
+		{
+			Aggregates.OnEvict(Buffer[NextIndex()], Count - Capacity());
+		}
+	}
+
+	template<typename T, typename TDefaultValueFunc, typename TDefaultThresholdFunc, typename TAggregatePolicy> requires CircularBufferConcept<T, TDefaultValueFunc> && CircularBufferAggregatePolicyConcept<TAggregatePolicy, T>
+	inline void TTimedCircularBuffer<T, TDefaultValueFunc, TDefaultThresholdFunc, TAggregatePolicy>::Clear()
 	{
 		Count = 0;
+		Aggregates.Reset(Capacity());
 	}
 
-	template<typename T, typename TDefaultValueFunc, typename TDefaultThresholdFunc> requires CircularBufferConcept<T, TDefaultValueFunc>
-	inline uint32 TTimedCircularBuffer<T, TDefaultValueFunc, TDefaultThresholdFunc>::NextIndex() const
+	template<typename T, typename TDefaultValueFunc, typename TDefaultThresholdFunc, typename TAggregatePolicy> requires CircularBufferConcept<T, TDefaultValueFunc> && CircularBufferAggregatePolicyConcept<TAggregatePolicy, T>
+	inline uint32 TTimedCircularBuffer<T, TDefaultValueFunc, TDefaultThresholdFunc, TAggregatePolicy>::NextIndex() const
 	{
 		return Count % Capacity();
 	}
 
-	template<typename T, typename TDefaultValueFunc, typename TDefaultThresholdFunc> requires CircularBufferConcept<T, TDefaultValueFunc>
+	template<typename T, typename TDefaultValueFunc, typename TDefaultThresholdFunc, typename TAggregatePolicy> requires CircularBufferConcept<T, TDefaultValueFunc> && CircularBufferAggregatePolicyConcept<TAggregatePolicy, T>
 	template<typename TThreshold, typename TFunc>
-	inline bool TTimedCircularBuffer<T, TDefaultValueFunc, TDefaultThresholdFunc>::IsZero(const TThreshold& Threshold, const TFunc& Func) const
+	inline bool TTimedCircularBuffer<T, TDefaultValueFunc, TDefaultThresholdFunc, TAggregatePolicy>::IsZero(const TThreshold& Threshold, const TFunc& Func) const
 		requires CircularBufferSumConcept<T>&& CircularBufferMangitudeConcept<T, TFunc, TThreshold>
 	{
 		return Func(Sum()) <= Threshold;
 	}
 
-	template<typename T, typename TDefaultValueFunc, typename TDefaultThresholdFunc> requires CircularBufferConcept<T, TDefaultValueFunc>
-	inline T TTimedCircularBuffer<T, TDefaultValueFunc, TDefaultThresholdFunc>::Average() const requires CircularBufferAverageConcept<T>
+	template<typename T, typename TDefaultValueFunc, typename TDefaultThresholdFunc, typename TAggregatePolicy> requires CircularBufferConcept<T, TDefaultValueFunc> && CircularBufferAggregatePolicyConcept<TAggregatePolicy, T>
+	inline T TTimedCircularBuffer<T, TDefaultValueFunc, TDefaultThresholdFunc, TAggregatePolicy>::Average() const requires CircularBufferAverageConcept<T>
 	{
 		const auto NumElements = Size();
 		return NumElements > 0 ? Sum() / NumElements : (TDefaultValueFunc{})();
 	}
 
-	template<typename T, typename TDefaultValueFunc, typename TDefaultThresholdFunc> requires CircularBufferConcept<T, TDefaultValueFunc>
-	inline uint32 TTimedCircularBuffer<T, TDefaultValueFunc, TDefaultThresholdFunc>::Capacity() const
+	template<typename T, typename TDefaultValueFunc, typename TDefaultThresholdFunc, typename TAggregatePolicy> requires CircularBufferConcept<T, TDefaultValueFunc> && CircularBufferAggregatePolicyConcept<TAggregatePolicy, T>
+	inline T TTimedCircularBuffer<T, TDefaultValueFunc, TDefaultThresholdFunc, TAggregatePolicy>::Min() const requires requires(const TAggregatePolicy& Policy) { Policy.GetMin(); Policy.GetMax(); }
+	{
+		return IsEmpty() ? (TDefaultValueFunc{})() : Aggregates.GetMin();
+	}
+
+	template<typename T, typename TDefaultValueFunc, typename TDefaultThresholdFunc, typename TAggregatePolicy> requires CircularBufferConcept<T, TDefaultValueFunc> && CircularBufferAggregatePolicyConcept<TAggregatePolicy, T>
+	inline T TTimedCircularBuffer<T, TDefaultValueFunc, TDefaultThresholdFunc, TAggregatePolicy>::Max() const requires requires(const TAggregatePolicy& Policy) { Policy.GetMin(); Policy.GetMax(); }
+	{
+		return IsEmpty() ? (TDefaultValueFunc{})() : Aggregates.GetMax();
+	}
+
+	template<typename T, typename TDefaultValueFunc, typename TDefaultThresholdFunc, typename TAggregatePolicy> requires CircularBufferConcept<T, TDefaultValueFunc> && CircularBufferAggregatePolicyConcept<TAggregatePolicy, T>
+	inline uint32 TTimedCircularBuffer<T, TDefaultValueFunc, TDefaultThresholdFunc, TAggregatePolicy>::Capacity() const
 	{
 		return Buffer.Num();
 	}
 
-	template<typename T, typename TDefaultValueFunc, typename TDefaultThresholdFunc> requires CircularBufferConcept<T, TDefaultValueFunc>
-	inline uint32 TTimedCircularBuffer<T, TDefaultValueFunc, TDefaultThresholdFunc>::Size() const
+	template<typename T, typename TDefaultValueFunc, typename TDefaultThresholdFunc, typename TAggregatePolicy> requires CircularBufferConcept<T, TDefaultValueFunc> && CircularBufferAggregatePolicyConcept<TAggregatePolicy, T>
+	inline uint32 TTimedCircularBuffer<T, TDefaultValueFunc, TDefaultThresholdFunc, TAggregatePolicy>::Size() const
 	{
 		return FMath::Min(Count, Capacity());
 	}
 
-	template<typename T, typename TDefaultValueFunc, typename TDefaultThresholdFunc> requires CircularBufferConcept<T, TDefaultValueFunc>
-	inline TTimedCircularBuffer<T, TDefaultValueFunc, TDefaultThresholdFunc>::TTimedCircularBuffer() : TTimedCircularBuffer(1) {}
+	template<typename T, typename TDefaultValueFunc, typename TDefaultThresholdFunc, typename TAggregatePolicy> requires CircularBufferConcept<T, TDefaultValueFunc> && CircularBufferAggregatePolicyConcept<TAggregatePolicy, T>
+	inline TTimedCircularBuffer<T, TDefaultValueFunc, TDefaultThresholdFunc, TAggregatePolicy>::TTimedCircularBuffer() : TTimedCircularBuffer(1) {}
 
 #pragma endregion Inline Definitions
 
-	template<typename T, typename TDefaultValueFunc, typename TDefaultThresholdFunc> requires CircularBufferConcept<T, TDefaultValueFunc>
-	TTimedCircularBuffer<T, TDefaultValueFunc, TDefaultThresholdFunc>::TTimedCircularBuffer(float MeasurementIntervalSeconds, float ExpectedAddRateSeconds)
+	template<typename T, typename TDefaultValueFunc, typename TDefaultThresholdFunc, typename TAggregatePolicy> requires CircularBufferConcept<T, TDefaultValueFunc> && CircularBufferAggregatePolicyConcept<TAggregatePolicy, T>
+	TTimedCircularBuffer<T, TDefaultValueFunc, TDefaultThresholdFunc, TAggregatePolicy>::TTimedCircularBuffer(float MeasurementIntervalSeconds, float ExpectedAddRateSeconds)
 	{
 		const auto BufferSize = FMath::CeilToInt32(MeasurementIntervalSeconds / ExpectedAddRateSeconds);
 
@@ -198,31 +357,40 @@ namespace TR
 			TEXT("MeasurementIntervalSeconds=%f; ExpectedAddRateSeconds=%f; Count=%d"), MeasurementIntervalSeconds, ExpectedAddRateSeconds, BufferSize);
 
 		Buffer.AddZeroed(BufferSize);
+		Aggregates.Reset(BufferSize);
 	}
 
-	template<typename T, typename TDefaultValueFunc, typename TDefaultThresholdFunc> requires CircularBufferConcept<T, TDefaultValueFunc>
-	TTimedCircularBuffer<T, TDefaultValueFunc, TDefaultThresholdFunc>::TTimedCircularBuffer(int32 NumSamples)
+	template<typename T, typename TDefaultValueFunc, typename TDefaultThresholdFunc, typename TAggregatePolicy> requires CircularBufferConcept<T, TDefaultValueFunc> && CircularBufferAggregatePolicyConcept<TAggregatePolicy, T>
+	TTimedCircularBuffer<T, TDefaultValueFunc, TDefaultThresholdFunc, TAggregatePolicy>::TTimedCircularBuffer(int32 NumSamples)
 	{
 		checkf(NumSamples > 0, TEXT("NumSamples=%d"), NumSamples);
 
 		Buffer.AddZeroed(NumSamples);
+		Aggregates.Reset(NumSamples);
 	}
 
-	template<typename T, typename TDefaultValueFunc, typename TDefaultThresholdFunc> requires CircularBufferConcept<T, TDefaultValueFunc>
-	T TTimedCircularBuffer<T, TDefaultValueFunc, TDefaultThresholdFunc>::Sum() const requires CircularBufferSumConcept<T>
+	template<typename T, typename TDefaultValueFunc, typename TDefaultThresholdFunc, typename TAggregatePolicy> requires CircularBufferConcept<T, TDefaultValueFunc> && CircularBufferAggregatePolicyConcept<TAggregatePolicy, T>
+	T TTimedCircularBuffer<T, TDefaultValueFunc, TDefaultThresholdFunc, TAggregatePolicy>::Sum() const requires CircularBufferSumConcept<T>
 	{
-		T SumValue{ (TDefaultValueFunc{})()};
-
-		for (uint32 i = 0, Len = Size(); i < Len; ++i)
+		if constexpr (requires(const TAggregatePolicy& Policy) { Policy.GetSum(); })
 		{
-			SumValue = SumValue + Buffer[i];
+			return IsEmpty() ? (TDefaultValueFunc{})() : Aggregates.GetSum();
 		}
+		else
+		{
+			T SumValue{ (TDefaultValueFunc{})() };
 
-		return SumValue;
+			for (uint32 i = 0, Len = Size(); i < Len; ++i)
+			{
+				SumValue = SumValue + Buffer[i];
+			}
+
+			return SumValue;
+		}
 	}
 
-	template<typename T, typename TDefaultValueFunc, typename TDefaultThresholdFunc> requires CircularBufferConcept<T, TDefaultValueFunc>
-	T TTimedCircularBuffer<T, TDefaultValueFunc, TDefaultThresholdFunc>::Delta() const requires CircularBufferDifferenceConcept<T>
+	template<typename T, typename TDefaultValueFunc, typename TDefaultThresholdFunc, typename TAggregatePolicy> requires CircularBufferConcept<T, TDefaultValueFunc> && CircularBufferAggregatePolicyConcept<TAggregatePolicy, T>
+	T TTimedCircularBuffer<T, TDefaultValueFunc, TDefaultThresholdFunc, TAggregatePolicy>::Delta() const requires CircularBufferDifferenceConcept<T>
 	{
 		uint32 MinIndex, MaxIndex, Len;
 
@@ -251,8 +419,8 @@ namespace TR
 		return Buffer[MaxIndex] - Buffer[MinIndex];
 	}
 
-	template<typename T, typename TDefaultValueFunc, typename TDefaultThresholdFunc> requires CircularBufferConcept<T, TDefaultValueFunc>
-	void TTimedCircularBuffer<T, TDefaultValueFunc, TDefaultThresholdFunc>::ClearAndResize(int32 NewNumSamples)
+	template<typename T, typename TDefaultValueFunc, typename TDefaultThresholdFunc, typename TAggregatePolicy> requires CircularBufferConcept<T, TDefaultValueFunc> && CircularBufferAggregatePolicyConcept<TAggregatePolicy, T>
+	void TTimedCircularBuffer<T, TDefaultValueFunc, TDefaultThresholdFunc, TAggregatePolicy>::ClearAndResize(int32 NewNumSamples)
 	{
 		checkf(NewNumSamples > 0, TEXT("NewNumSamples=%d"), NewNumSamples);
 
@@ -262,5 +430,161 @@ namespace TR
 		Clear();
 	}
 
+#pragma region Aggregate Policy Definitions
+
+	template<typename T, typename TDefaultValueFunc>
+	inline void TCircularBufferRunningSum<T, TDefaultValueFunc>::Reset(int32 /* Capacity */)
+	{
+		RunningSum = (TDefaultValueFunc{})();
+		Compensation = RunningSum - RunningSum;
+	}
+
+	template<typename T, typename TDefaultValueFunc>
+	inline void TCircularBufferRunningSum<T, TDefaultValueFunc>::OnAdd(const T& Value, uint32 /* Sequence */)
+	{
+		Accumulate(Value);
+	}
+
+	template<typename T, typename TDefaultValueFunc>
+	inline void TCircularBufferRunningSum<T, TDefaultValueFunc>::OnEvict(const T& Value, uint32 /* Sequence */)
+	{
+		Deduct(Value);
+	}
+
+	template<typename T, typename TDefaultValueFunc>
+	inline void TCircularBufferRunningSum<T, TDefaultValueFunc>::Accumulate(const T& Value)
+	{
+		if constexpr (std::is_integral_v<T>)
+		{
+			RunningSum = RunningSum + Value;
+		}
+		else
+		{
+			// Branchless two sum that recovers the exact rounding error of the addition regardless of which operand is larger
+			// so that it also works per component for vectors
+			const T NewSum = RunningSum + Value;
+			const T ValuePart = NewSum - RunningSum;
+			const T Error = (RunningSum - (NewSum - ValuePart)) + (Value - ValuePart);
+
+			Compensation = Compensation + Error;
+			RunningSum = NewSum;
+		}
+	}
+
+	template<typename T, typename TDefaultValueFunc>
+	inline void TCircularBufferRunningSum<T, TDefaultValueFunc>::Deduct(const T& Value)
+	{
+		if constexpr (std::is_integral_v<T>)
+		{
+			RunningSum = RunningSum - Value;
+		}
+		else
+		{
+			// Same two sum as Accumulate with the value negated, which is exact, without needing a unary minus on T
+			const T NewSum = RunningSum - Value;
+			const T ValuePart = RunningSum - NewSum;
+			const T Error = (RunningSum - (NewSum + ValuePart)) - (Value - ValuePart);
+
+			Compensation = Compensation + Error;
+			RunningSum = NewSum;
+		}
+	}
+
+	template<typename T, typename TDefaultValueFunc>
+	inline T TCircularBufferRunningSum<T, TDefaultValueFunc>::GetSum() const
+	{
+		if constexpr (std::is_integral_v<T>)
+		{
+			return RunningSum;
+		}
+		else
+		{
+			return RunningSum + Compensation;
+		}
+	}
+
+	template<typename T, typename TDefaultValueFunc>
+	void TCircularBufferRunningSumMinMax<T, TDefaultValueFunc>::Reset(int32 Capacity)
+	{
+		Super::Reset(Capacity);
+
+		MinQueue.Reset(Capacity);
+		MaxQueue.Reset(Capacity);
+	}
+
+	template<typename T, typename TDefaultValueFunc>
+	void TCircularBufferRunningSumMinMax<T, TDefaultValueFunc>::OnAdd(const T& Value, uint32 Sequence)
+	{
+		Super::OnAdd(Value, Sequence);
+
+		// Older values that are not smaller can never be the minimum again while the new value is in the buffer
+		MinQueue.Push(Value, Sequence, [](const T& Back, const T& New) { return !(Back < New); });
+		MaxQueue.Push(Value, Sequence, [](const T& Back, const T& New) { return !(New < Back); });
+	}
+
+	template<typename T, typename TDefaultValueFunc>
+	void TCircularBufferRunningSumMinMax<T, TDefaultValueFunc>::OnEvict(const T& Value, uint32 Sequence)
+	{
+		Super::OnEvict(Value, Sequence);
+
+		MinQueue.PopIfFront(Sequence);
+		MaxQueue.PopIfFront(Sequence);
+	}
+
+	template<typename T, typename TDefaultValueFunc>
+	inline const T& TCircularBufferRunningSumMinMax<T, TDefaultValueFunc>::GetMin() const
+	{
+		return MinQueue.Front();
+	}
+
+	template<typename T, typename TDefaultValueFunc>
+	inline const T& TCircularBufferRunningSumMinMax<T, TDefaultValueFunc>::GetMax() const
+	{
+		return MaxQueue.Front();
+	}
+
+	template<typename T, typename TDefaultValueFunc>
+	void TCircularBufferRunningSumMinMax<T, TDefaultValueFunc>::FMonotonicQueue::Reset(int32 Capacity)
+	{
+		// The queue never holds more entries than the buffer
+		Entries.SetNum(FMath::Max(1, Capacity));
+		Head = Num = 0;
+	}
+
+	template<typename T, typename TDefaultValueFunc>
+	template<typename TCompare>
+	void TCircularBufferRunningSumMinMax<T, TDefaultValueFunc>::FMonotonicQueue::Push(const T& Value, uint32 Sequence, TCompare Supersedes)
+	{
+		const auto QueueCapacity = Entries.Num();
+
+		while (Num > 0 && Supersedes(Entries[(Head + Num - 1) % QueueCapacity].Value, Value))
+		{
+			--Num;
+		}
+
+		check(Num < QueueCapacity);
+
+		Entries[(Head + Num) % QueueCapacity] = FEntry{ Value, Sequence };
+		++Num;
+	}
+
+	template<typename T, typename TDefaultValueFunc>
+	void TCircularBufferRunningSumMinMax<T, TDefaultValueFunc>::FMonotonicQueue::PopIfFront(uint32 Sequence)
+	{
+		if (Num > 0 && Entries[Head].Sequence == Sequence)
+		{
+			Head = (Head + 1) % Entries.Num();
+			--Num;
+		}
+	}
+
+	template<typename T, typename TDefaultValueFunc>
+	inline const T& TCircularBufferRunningSumMinMax<T, TDefaultValueFunc>::FMonotonicQueue::Front() const
+	{
+		check(Num > 0);
+		return Entries[Head].Value;
+	}
+
+#pragma endregion Aggregate Policy Definitions
 }
 #pragma endregion Template Definitions
@@ -0,0 +1,138 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TimerManager.h"
+
+namespace TR
+{
+	struct FTimerWheelHandle
+	{
+		int32 Index{ INDEX_NONE };
+		uint32 Serial{};
+
+		bool IsValid() const { return Index != INDEX_NONE; }
+		void Invalidate() { *this = {}; }
+
+		bool operator==(const FTimerWheelHandle&) const = default;
+	};
+
+	/**
+	 * Hierarchical timer wheel with constant time insert and cancel.
+	 * Time is quantized into ticks of <c>TickSeconds</c> and timers are bucketed into levels of 64 slots where each level covers 64 times the span of the level below.
+	 * Advancing the wheel only touches the slots for the ticks that elapsed and timers cascade down a level as their expiry approaches.
+	 *
+	 * Coalesced timers have their expiry aligned to a multiple of their interval so that all timers with the same interval land in the same slot
+	 * and fire together in one batch.
+	 */
+	class TRCORE_API FTimerWheel
+	{
+	public:
+		/* Finer than a frame so that timers fire on the same frame they would with FTimerManager. */
+		static constexpr double DefaultTickSeconds = 1.0 / 120;
+
+		explicit FTimerWheel(double InTickSeconds = DefaultTickSeconds);
+
+		/*
+		* Calls <c>Delegate</c> after <c>DelaySeconds</c> and then every <c>IntervalSeconds</c> if positive.
+		* Timers always fire on a later call to <c>Advance</c> even with no delay.
+		*/
+		FTimerWheelHandle SetTimer(FTimerDelegate Delegate, double DelaySeconds, double IntervalSeconds = 0.0, bool bCoalesce = false);
+
+		/*
+		* Cancels the timer and invalidates the handle. Returns false if the timer already fired or was cleared.
+		*/
+		bool ClearTimer(FTimerWheelHandle& Handle);
+
+		bool IsTimerActive(const FTimerWheelHandle& Handle) const;
+
+		/*
+		* Seconds until the timer next fires or a negative value if it is not active.
+		*/
+		double GetTimerRemaining(const FTimerWheelHandle& Handle) const;
+
+		/*
+		* Advances the wheel to <c>NowSeconds</c> firing all expired timers in expiry order.
+		* Returns the number of timers fired.
+		*/
+		int32 Advance(double NowSeconds);
+
+		int32 Num() const;
+		bool IsEmpty() const;
+		double GetTickSeconds() const;
+
+		void Reset();
+
+	private:
+		static constexpr int32 SlotBits = 6;
+		static constexpr int32 SlotCount = 1 << SlotBits;
+		static constexpr uint64 SlotMask = SlotCount - 1;
+		static constexpr int32 LevelCount = 4;
+
+		/* Timers beyond the span of the top level wait in an overflow list until the top level wraps. */
+		static constexpr int32 OverflowLevel = LevelCount;
+
+		struct FTimerEntry
+		{
+			FTimerDelegate Delegate;
+			uint64 ExpiryTick{};
+			uint64 IntervalTicks{};
+			int32 Prev{ INDEX_NONE };
+			int32 Next{ INDEX_NONE };
+			uint32 Serial{};
+			uint8 Level{};
+			uint8 Slot{};
+			bool bLinked{};
+		};
+
+		uint64 ToTicksCeil(double Seconds) const;
+		uint64 AlignExpiry(uint64 ExpiryTick, uint64 PeriodTicks) const;
+		const FTimerEntry* FindEntry(const FTimerWheelHandle& Handle) const;
+
+		int32& GetListHead(int32 Level, int32 Slot);
+
+		void Link(int32 Index);
+		void Unlink(int32 Index);
+
+		void CascadeLevel(int32 Level);
+		int32 FireSlot(int32 Slot);
+
+	private:
+		TSparseArray<FTimerEntry> Entries{};
+
+		int32 SlotHeads[LevelCount][SlotCount];
+		int32 OverflowHead{ INDEX_NONE };
+
+		double TickSeconds{};
+		double StartSeconds{};
+		double CurrentSeconds{};
+		uint64 CurrentTick{};
+		uint32 NextSerial{ 1 };
+		bool bStarted{};
+	};
+
+#pragma region Inline Definitions
+
+	inline bool FTimerWheel::IsTimerActive(const FTimerWheelHandle& Handle) const
+	{
+		return FindEntry(Handle) != nullptr;
+	}
+
+	inline int32 FTimerWheel::Num() const
+	{
+		return Entries.Num();
+	}
+
+	inline bool FTimerWheel::IsEmpty() const
+	{
+		return Entries.IsEmpty();
+	}
+
+	inline double FTimerWheel::GetTickSeconds() const
+	{
+		return TickSeconds;
+	}
+
+#pragma endregion Inline Definitions
+}
@@ -3,6 +3,24 @@
 #include "CoreMinimal.h"
 #include "TRConstants.h"
 
+namespace TR
+{
+	extern TRCORE_API TAutoConsoleVariable<bool> CVarHomingAsyncTraces;
+	extern TRCORE_API TAutoConsoleVariable<int32> CVarProjectilePoolPrewarmBudget;
+	extern TRCORE_API TAutoConsoleVariable<bool> CVarAISchedulerEnabled;
+	extern TRCORE_API TAutoConsoleVariable<float> CVarAISchedulerBudgetMs;
+	extern TRCORE_API TAutoConsoleVariable<bool> CVarAIWanderPointsEnabled;
+	extern TRCORE_API TAutoConsoleVariable<bool> CVarTankGroundProbeAsync;
+	extern TRCORE_API TAutoConsoleVariable<bool> CVarTankRecoveryEnabled;
+	extern TRCORE_API TAutoConsoleVariable<bool> CVarTankSpringWheelManaged;
+	extern TRCORE_API TAutoConsoleVariable<bool> CVarAudioDispatchEnabled;
+	extern TRCORE_API TAutoConsoleVariable<bool> CVarAudioDispatchRecord;
+	extern TRCORE_API TAutoConsoleVariable<bool> CVarVfxManagerEnabled;
+	extern TRCORE_API TAutoConsoleVariable<int32> CVarVfxSpawnBudget;
+	extern TRCORE_API TAutoConsoleVariable<bool> CVarStatsJournalEnabled;
+	extern TRCORE_API TAutoConsoleVariable<float> CVarHUDMaxUpdateRate;
+}
+
 #if TR_DEBUG_ENABLED
 
 namespace TR
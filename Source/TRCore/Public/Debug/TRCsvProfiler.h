@@ -0,0 +1,12 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+/*
+* CSV profiler category for per-frame gameplay timings and counters.
+* Captured with <c>-csvCategories=TR</c> alongside <c>-csvProfile</c> or by the Rampage soak benchmark which enables it by default.
+*/
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(TRCORE_API, TR);
@@ -0,0 +1,190 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "AudioDispatchSubsystem.generated.h"
+
+class USoundBase;
+class UAudioComponent;
+
+UENUM()
+enum class ESfxCategory : uint8
+{
+	Impact,
+	Explosion,
+	Weapon,
+	Item,
+	MAX UMETA(Hidden)
+};
+
+struct FOneShotSfxRequest
+{
+	TWeakObjectPtr<USoundBase> Sound{};
+
+	/* World context of the spawned voice. Sound concurrency is scoped to this owner. */
+	TWeakObjectPtr<AActor> Owner{};
+
+	/* Attaches the voice to this component instead of playing it at <c>Location</c>. Attached requests are only merged with requests for the same component. */
+	TWeakObjectPtr<USceneComponent> AttachComponent{};
+
+	FVector Location{ EForceInit::ForceInitToZero };
+	FRotator Rotation{ EForceInit::ForceInitToZero };
+
+	float Volume{ 1.0f };
+
+	ESfxCategory Category{ ESfxCategory::Impact };
+
+	bool bReverb{};
+};
+
+/*
+* Voice started by the dispatcher or that would have been started when recording.
+*/
+struct FDispatchedSfx
+{
+	FName SoundName{};
+	FVector Location{ EForceInit::ForceInitToZero };
+	float Volume{};
+	float ListenerDistance{};
+
+	/* Number of requests merged into this voice. */
+	int32 MergedCount{};
+
+	ESfxCategory Category{};
+	uint64 Frame{};
+};
+
+/**
+ * Collects one-shot sound requests during a frame and starts them together at the end of the frame.
+ * Requests for the same sound close to each other are merged into a single louder voice, including requests close to a voice started within the
+ * last few frames. Each category has a budget of voices playing at once. Voices nearest the listener are started first and may take the place
+ * of a playing voice further away when the budget is exhausted.
+ *
+ * When there is no audio device, e.g. a headless or -nosound run, or when <c>tr.audio.dispatch.record</c> is set, voices are recorded instead of played
+ * so that the dispatch can be checked without audio.
+ */
+UCLASS()
+class TRCORE_API UAudioDispatchSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/*
+	* Queues a one-shot sound to be started at the end of the frame. Started right away when dispatch is disabled.
+	*/
+	void PlaySfx(const FOneShotSfxRequest& Request);
+
+	/*
+	* Queues a one-shot sound at the location of <c>Actor</c> with the dispatcher of its world. Sound concurrency is scoped to <c>ConcurrencyOwner</c>.
+	*/
+	static void QueueSfxAtActor(const AActor& Actor, USoundBase* Sound, ESfxCategory Category, AActor* ConcurrencyOwner, bool bReverb = false);
+
+	/*
+	* Starts all queued requests now. Returns the number of voices started.
+	*/
+	int32 FlushPendingSfx();
+
+	const TArray<FDispatchedSfx>& GetRecordedSfx() const;
+
+	/*
+	* Drops queued requests, forgets playing voices without stopping them and clears the recorded voices.
+	*/
+	void Reset();
+
+	static bool IsEnabled();
+
+	bool IsRecording() const;
+
+	/*
+	* Voices of the category that may play at once.
+	*/
+	static int32 GetVoiceBudget(ESfxCategory Category);
+
+protected:
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+
+	virtual TStatId GetStatId() const override;
+
+	virtual void Deinitialize() override;
+
+private:
+	struct FMergedSfx
+	{
+		FOneShotSfxRequest Loudest{};
+		FVector WeightedLocationSum{ EForceInit::ForceInitToZero };
+		float VolumeSum{};
+		float VolumeSquaredSum{};
+		int32 MergedCount{};
+		float ListenerDistanceSq{};
+
+		void Add(const FOneShotSfxRequest& Request);
+
+		/* Distance is zero without a listener so voices are then started in request order. */
+		void UpdateListenerDistance(const TOptional<FVector>& ListenerLocation);
+
+		FVector GetLocation() const;
+		float GetVolume() const;
+	};
+
+	struct FActiveVoice
+	{
+		TWeakObjectPtr<UAudioComponent> AudioComponent{};
+		TWeakObjectPtr<USoundBase> Sound{};
+		TWeakObjectPtr<USceneComponent> AttachComponent{};
+		FVector Location{ EForceInit::ForceInitToZero };
+		double StartTimeSeconds{};
+
+		/* Only used when recording as there is no audio component to check. */
+		double EndTimeSeconds{};
+
+		float ListenerDistanceSq{};
+
+		/* Combined energy of the requests merged into the voice so later requests within the coalescing window can raise its volume. */
+		float LoudestVolume{};
+		float VolumeSquaredSum{};
+		float Volume{};
+		int32 MergedCount{};
+
+		/* Index of the voice in <c>RecordedSfx</c> when recording. */
+		int32 RecordedIndex{ INDEX_NONE };
+
+		ESfxCategory Category{};
+	};
+
+	void PruneFinishedVoices(double TimeSeconds, bool bRecording);
+
+	/*
+	* Merges into a voice started within the coalescing window if there is one close enough and raises its volume by the energy of the request.
+	*/
+	bool MergeIntoRecentVoice(const FOneShotSfxRequest& Request, double TimeSeconds);
+
+	bool StartVoice(const FMergedSfx& Voice, double TimeSeconds, bool bRecording);
+
+	/*
+	* Stops the voice furthest from the listener in the category if it is further than <c>ListenerDistanceSq</c> to make room in the budget.
+	*/
+	bool StealVoice(ESfxCategory Category, float ListenerDistanceSq);
+
+	TOptional<FVector> GetListenerLocation() const;
+
+	static bool CanMerge(const FOneShotSfxRequest& Request, const TWeakObjectPtr<USoundBase>& Sound, const TWeakObjectPtr<USceneComponent>& AttachComponent,
+		ESfxCategory Category, const FVector& Location);
+
+private:
+	TArray<FOneShotSfxRequest> PendingRequests{};
+	TArray<FActiveVoice> ActiveVoices{};
+	TArray<FDispatchedSfx> RecordedSfx{};
+};
+
+#pragma region Inline Definitions
+
+inline const TArray<FDispatchedSfx>& UAudioDispatchSubsystem::GetRecordedSfx() const
+{
+	return RecordedSfx;
+}
+
+#pragma endregion Inline Definitions
@@ -0,0 +1,84 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Containers/SpatialHashGrid.h"
+
+#include "PawnSpatialHashSubsystem.generated.h"
+
+/**
+ * Uniform grid spatial hash of the live tank pawns in the world so that gameplay code can find nearby tanks without physics scene queries.
+ * Tanks register themselves on begin play and are removed when destroyed. Positions are refreshed once per frame,
+ * so query results can be up to a frame behind and are measured from actor locations rather than collision shapes.
+ */
+UCLASS()
+class TRCORE_API UPawnSpatialHashSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UPawnSpatialHashSubsystem();
+
+	void RegisterPawn(APawn& Pawn);
+	void UnregisterPawn(APawn& Pawn);
+	bool IsRegistered(const APawn& Pawn) const;
+
+	int32 Num() const;
+	void GetPawns(TArray<APawn*>& OutPawns) const;
+
+	/*
+	* Returns the pawns within <c>Radius</c> of <c>Center</c>.
+	*/
+	void QueryRadius(const FVector& Center, float Radius, TArray<APawn*>& OutPawns) const;
+
+	/*
+	* Returns the pawns whose bounds overlap the sphere, like a physics sphere overlap, rather than only those whose location is inside it.
+	*/
+	void QuerySphereOverlap(const FVector& Center, float Radius, TArray<APawn*>& OutPawns) const;
+
+	/*
+	* Returns the pawns within <c>MaxDistance</c> of <c>Origin</c> where the cosine of the angle between <c>Direction</c> and the direction to the pawn is at least <c>MinCosine</c>.
+	* <c>MinCosine</c> may be negative for cones wider than a hemisphere.
+	*/
+	void QueryCone(const FVector& Origin, const FVector& Direction, float MaxDistance, float MinCosine, TArray<APawn*>& OutPawns) const;
+
+	/*
+	* Returns up to <c>Count</c> pawns nearest to <c>Center</c> within <c>MaxRadius</c>, sorted nearest first. <c>IgnoredPawn</c> is excluded, e.g. the querying pawn.
+	*/
+	void QueryNearest(const FVector& Center, int32 Count, float MaxRadius, TArray<APawn*>& OutPawns, const APawn* IgnoredPawn = nullptr) const;
+
+	/*
+	* Returns true if the bounds of any pawn not in <c>IgnoredActors</c> overlap the box.
+	*/
+	bool AnyOverlappingBox(const FBox& Box, TArrayView<AActor* const> IgnoredActors = {}) const;
+
+protected:
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+	virtual void Deinitialize() override;
+
+private:
+	/* Keyed by object key rather than weak pointer as stale weak pointers all compare equal and would collide once their pawns are collected. */
+	TR::TSpatialHashGrid<TObjectKey<APawn>> Grid;
+
+	/* Pending removals found during the position refresh. */
+	TArray<TObjectKey<APawn>> StalePawns{};
+};
+
+#pragma region Inline Definitions
+
+inline bool UPawnSpatialHashSubsystem::IsRegistered(const APawn& Pawn) const
+{
+	return Grid.Contains(TObjectKey<APawn>(&Pawn));
+}
+
+inline int32 UPawnSpatialHashSubsystem::Num() const
+{
+	return Grid.Num();
+}
+
+#pragma endregion Inline Definitions
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
+#include "Containers/TimerWheel.h"
 #include "RealtimeTimerSubsystem.generated.h"
 
 DECLARE_MULTICAST_DELEGATE_OneParam(FRealTimeTimerDelegate, float /* DeltaTime */)
@@ -12,6 +13,8 @@ DECLARE_MULTICAST_DELEGATE_OneParam(FRealTimeTimerDelegate, float /* DeltaTime *
  * Allows ticking delegate functions when game is paused, but all ticks are done in realtime rather than game time.
  * Useful for UI ticks that do not happen from a <c>UUserWidget</c> where ticking when paused could be explicitly configured.
  * FTimerManager does not support ticking when paused
+ *
+ * Also has a realtime timer wheel for one shot and looping timers that fire regardless of pause. See <c>UTimerWheelSubsystem</c> for game time timers.
  */
 UCLASS()
 class TRCORE_API URealtimeTimerSubsystem : public UTickableWorldSubsystem
@@ -22,6 +25,8 @@ public:
 
 	FRealTimeTimerDelegate RealTimeTimerDelegate{};
 
+	TR::FTimerWheel& GetTimerWheel() { return TimerWheel; }
+
 protected:
 	virtual bool IsTickableWhenPaused() const override { return true;  }
 
@@ -34,4 +39,7 @@ protected:
 
 private:
 	void TickDelegates(float DeltaTime);
+
+private:
+	TR::FTimerWheel TimerWheel{};
 };
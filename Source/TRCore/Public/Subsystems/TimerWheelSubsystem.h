@@ -0,0 +1,44 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Containers/TimerWheel.h"
+
+#include "TimerWheelSubsystem.generated.h"
+
+/**
+ * Game time timers on a hierarchical timer wheel for high volume gameplay timers such as per projectile timers, which would otherwise all go
+ * through the FTimerManager heap. Pauses and dilates with the world like FTimerManager.
+ * Timers fire at the end of the frame after actors have ticked so a timer with no delay set during a frame fires at the end of that frame.
+ *
+ * See <c>URealtimeTimerSubsystem</c> for timers that continue while the game is paused.
+ */
+UCLASS()
+class TRCORE_API UTimerWheelSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	TR::FTimerWheel& GetTimerWheel();
+
+protected:
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	virtual void Deinitialize() override;
+
+private:
+	TR::FTimerWheel TimerWheel{};
+};
+
+#pragma region Inline Definitions
+
+inline TR::FTimerWheel& UTimerWheelSubsystem::GetTimerWheel()
+{
+	return TimerWheel;
+}
+
+#pragma endregion Inline Definitions
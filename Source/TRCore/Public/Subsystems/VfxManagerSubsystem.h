@@ -0,0 +1,146 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "VfxManagerSubsystem.generated.h"
+
+class UNiagaraSystem;
+class UNiagaraComponent;
+
+UENUM()
+enum class EVfxPriority : uint8
+{
+	/* Dropped when over the spawn budget. */
+	Low,
+
+	/* Deferred to later frames when over the spawn budget and dropped if still waiting after a few frames. */
+	Normal,
+	High,
+
+	/* Never culled, deferred or dropped. Not counted against the spawn budget. */
+	Critical,
+
+	MAX UMETA(Hidden)
+};
+
+DECLARE_DELEGATE_OneParam(FOnVfxSpawned, UNiagaraComponent& /* NiagaraComponent */);
+
+struct FVfxSpawnRequest
+{
+	TWeakObjectPtr<UNiagaraSystem> System{};
+
+	/* Attaches the effect to this component with <c>Location</c> and <c>Rotation</c> relative to <c>AttachSocketName</c>. */
+	TWeakObjectPtr<USceneComponent> AttachComponent{};
+	FName AttachSocketName{};
+
+	FVector Location{ EForceInit::ForceInitToZero };
+	FRotator Rotation{ EForceInit::ForceInitToZero };
+	FVector Scale{ FVector::OneVector };
+
+	EVfxPriority Priority{ EVfxPriority::Normal };
+
+	/* Called when the effect is spawned to set its parameters. Not called if the request is culled or dropped. */
+	FOnVfxSpawned OnSpawned{};
+};
+
+struct FVfxManagerCounters
+{
+	int32 Requested{};
+
+	/* Requests that were within the budget or critical and passed to Niagara. */
+	int32 Issued{};
+
+	/* Issued requests that Niagara spawned a component for. */
+	int32 Spawned{};
+
+	int32 Culled{};
+	int32 Deferred{};
+	int32 Dropped{};
+
+	/* Most non-critical requests issued in a single frame. Never more than the spawn budget. */
+	int32 MaxIssuedInFrame{};
+
+	int32 Frames{};
+};
+
+/**
+ * Spawns Niagara effects for hits, deaths and explosions through the Niagara component pool of each system asset.
+ * Requests made during a frame are spawned together at the end of the frame nearest the view first, up to a per frame spawn budget so that a
+ * barrage of explosions does not spawn every effect in the same frame. Requests too far from the view for their priority are culled and
+ * requests over the budget are deferred or dropped depending on their priority.
+ *
+ * Spawned effects are released back to the pool when complete so <c>FOnVfxSpawned</c> should not keep the component.
+ */
+UCLASS()
+class TRCORE_API UVfxManagerSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/*
+	* Queues an effect to be spawned at the end of the frame. Spawned right away without pooling or budgeting when the manager is disabled.
+	*/
+	void SpawnVfx(FVfxSpawnRequest&& Request);
+
+	/*
+	* Spawns queued requests up to the spawn budget and defers the rest by priority. Returns the number of requests issued.
+	*/
+	int32 FlushPendingVfx();
+
+	const FVfxManagerCounters& GetCounters() const;
+	void ResetCounters();
+
+	int32 NumPending() const;
+
+	static bool IsEnabled();
+	static int32 GetSpawnBudget();
+
+protected:
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+
+	virtual TStatId GetStatId() const override;
+
+	virtual void Deinitialize() override;
+
+private:
+	struct FPendingVfx
+	{
+		FVfxSpawnRequest Request{};
+		uint64 RequestFrame{};
+		double ViewDistanceSq{};
+	};
+
+	bool IssueRequest(const FVfxSpawnRequest& Request, bool bPooled);
+
+	TOptional<FVector> GetViewLocation() const;
+
+	static FVector GetRequestLocation(const FVfxSpawnRequest& Request);
+
+private:
+	TArray<FPendingVfx> PendingRequests{};
+
+	FVfxManagerCounters Counters{};
+};
+
+#pragma region Inline Definitions
+
+inline const FVfxManagerCounters& UVfxManagerSubsystem::GetCounters() const
+{
+	return Counters;
+}
+
+inline void UVfxManagerSubsystem::ResetCounters()
+{
+	Counters = {};
+}
+
+inline int32 UVfxManagerSubsystem::NumPending() const
+{
+	return PendingRequests.Num();
+}
+
+#pragma endregion Inline Definitions
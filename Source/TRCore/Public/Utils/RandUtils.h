@@ -1,14 +1,32 @@
 #pragma once
 
+#include "CoreMinimal.h"
+
 #include <random>
 #include <algorithm>
 #include <concepts>
 #include <iterator>
 #include <numeric>
 
+class UObject;
+
 namespace RandUtils
 {
-	TRCORE_API unsigned GenerateSeed();
+	/*
+	* Returns a non-deterministic seed unless a seed is pinned with <c>-TRSeed=N</c> on the command line or <c>SetPinnedSeed</c>.
+	* When pinned the seed is derived from the pinned seed and <c>Key</c> so that generators keyed by something stable, e.g. the owner name,
+	* get the same sequence on every run regardless of the order they are created in.
+	*/
+	TRCORE_API unsigned GenerateSeed(uint32 Key = 0);
+
+	/*
+	* <c>GenerateSeed</c> keyed by the path name of <c>Object</c>, which unlike its FName index is the same in every process.
+	* Call from BeginPlay or later rather than a constructor so that a seed pinned once the game starts is picked up by level placed objects.
+	*/
+	TRCORE_API unsigned GenerateSeed(const UObject& Object);
+
+	TRCORE_API void SetPinnedSeed(TOptional<unsigned> Seed);
+	TRCORE_API TOptional<unsigned> GetPinnedSeed();
 
 	template<typename Random, std::forward_iterator Iter>
 	void ShuffleIndices(Iter Begin, Random& Rng, std::size_t Count);
@@ -35,6 +35,7 @@ public class TRCore : ModuleRules
 
 		var enginePrivateDependencyModuleNames = new string[] 
 		{
+			"Niagara",
 		};
 
 		PrivateDependencyModuleNames.AddRange(enginePrivateDependencyModuleNames);
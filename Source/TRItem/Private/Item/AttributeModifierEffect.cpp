@@ -3,6 +3,8 @@
 
 #include "Item/AttributeModifierEffect.h"
 
+#include "Subsystems/AudioDispatchSubsystem.h"
+
 #include "AbilitySystemComponent.h"
 #include "AbilitySystemBlueprintLibrary.h"
 #include "AbilitySystem/TRGameplayTags.h"
@@ -101,5 +103,5 @@ void UAttributeModifierEffect::PlayActivationSfx() const
 		return;
 	}
 
-	PlaySfxAttached(ActivationSfx);
+	QueueSfxAttached(ActivationSfx, ESfxCategory::Item);
 }
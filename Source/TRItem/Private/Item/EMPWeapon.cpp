@@ -3,6 +3,9 @@
 
 #include "Item/EMPWeapon.h"
 
+#include "Subsystems/AudioDispatchSubsystem.h"
+#include "Subsystems/VfxManagerSubsystem.h"
+
 #include "AbilitySystemComponent.h"
 #include "AbilitySystemBlueprintLibrary.h"
 
@@ -13,14 +16,14 @@
 #include "NiagaraFunctionLibrary.h"
 #include "NiagaraComponent.h"
 
-#include <limits>
+#include "Subsystems/PawnSpatialHashSubsystem.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(EMPWeapon)
 
 bool UEMPWeapon::DoActivation(USceneComponent& ActivationReferenceComponent, const FName& ActivationSocketName)
 {
 	PlayActivationVfx();
-	PlaySfxAtActorLocation(ActivationSfx);
+	QueueSfxAtActorLocation(ActivationSfx, ESfxCategory::Weapon);
 
 	auto AffectedEnemies = SweepForAffectedEnemies();
 
@@ -35,22 +38,45 @@ bool UEMPWeapon::DoActivation(USceneComponent& ActivationReferenceComponent, con
 	auto World = GetWorld();
 	check(World);
 
-	const float EffectEndGameTime = World->GetTimeSeconds() + EffectDuration;
+	const float CurrentTimeSeconds = World->GetTimeSeconds();
+	const float EffectEndGameTime = CurrentTimeSeconds + EffectDuration;
 
 	const FGameplayTagContainer DebuffTagsContainer = FGameplayTagContainer::CreateFromArray(DebuffTags);
 
+	// Pawns can share an ability system component, e.g. when it is owned by the player state, so only stun each one once per activation
+	TSet<UAbilitySystemComponent*> SweptASCs;
+	SweptASCs.Reserve(AffectedEnemies.Num());
+
+	int32 ExtendedCount{};
+
 	for (auto Enemy : AffectedEnemies)
 	{
-		ApplyEffectToEnemy(Enemy, EffectEndGameTime, DebuffTagsContainer);
+		auto ASC = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(Enemy);
+		// already checked in the sweep
+		check(ASC);
+
+		bool bAlreadySwept{};
+		SweptASCs.Add(ASC, &bAlreadySwept);
+
+		if (bAlreadySwept)
+		{
+			continue;
+		}
+
+		if (!ApplyEffectToEnemy(*Enemy, *ASC, EffectEndGameTime, DebuffTagsContainer))
+		{
+			++ExtendedCount;
+		}
 	}
 
+	UE_VLOG_UELOG(GetOwner(), LogTRItem, Log, TEXT("%s-%s: DoActivation: Stunned %d enemies; Extended=%d; AffectedActors=%d"),
+		*LoggingUtils::GetName(GetOwner()), *GetName(), SweptASCs.Num() - ExtendedCount, ExtendedCount, AffectedActors.Num());
+
 	OnItemGameplayTagsChanged.Broadcast(this, AffectedEnemies, DebuffTagsContainer, true);
 
 	if (!TagExpirationHandle.IsValid())
 	{
-		ScheduleStunRemoval(EffectDuration);
-
-		return true;
+		ScheduleNextStunRemoval(CurrentTimeSeconds);
 	}
 
 	return true;
@@ -68,36 +94,31 @@ void UEMPWeapon::BeginDestroy()
 	{
 		TagExpirationHandle.Invalidate();
 	}
+
+	StunExpiries.Reset();
 }
 
 TArray<APawn*> UEMPWeapon::SweepForAffectedEnemies() const
 {
 	auto World = GetWorld();
 	check(World);
-	const auto SweepLocation = GetOwner()->GetActorLocation();
 
-	const FCollisionShape Shape = FCollisionShape::MakeSphere(InfluenceRadius);
-
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(GetOwner());
-
-	TArray<FOverlapResult> Overlaps;
+	auto PawnSpatialHashSubsystem = World->GetSubsystem<UPawnSpatialHashSubsystem>();
+	if (!ensure(PawnSpatialHashSubsystem))
+	{
+		return {};
+	}
 
-	World->OverlapMultiByObjectType(Overlaps, SweepLocation,
-		FQuat::Identity, ECollisionChannel::ECC_Pawn, Shape, QueryParams);
+	const auto SweepLocation = GetOwner()->GetActorLocation();
 
+	// Tanks are tracked in the spatial hash so a physics overlap isn't needed to find them. Tested against pawn bounds to match the overlap radius
 	TArray<APawn*> SelectedPawns;
+	PawnSpatialHashSubsystem->QuerySphereOverlap(SweepLocation, InfluenceRadius, SelectedPawns);
 
-	for (const auto& OverlapResult : Overlaps)
+	SelectedPawns.RemoveAllSwap([Owner = GetOwner()](APawn* Pawn)
 	{
-		auto Pawn = Cast<APawn>(OverlapResult.GetActor());
-		if (!UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(Pawn))
-		{
-			continue;
-		}
-
-		SelectedPawns.AddUnique(Pawn);
-	}
+		return Pawn == Owner || !UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(Pawn);
+	});
 
 	return SelectedPawns;
 }
@@ -116,65 +137,76 @@ void UEMPWeapon::CheckRemoveStunTag()
 	TArray<APawn*> RemovedActors;
 
 	const bool bNotify = OnItemGameplayTagsChanged.IsBound();
+	bool bAnyDestroyed{};
 
-	for (auto MapIt = AffectedActors.CreateIterator(); MapIt; ++MapIt)
+	// Only visit the expired entries in expiry order instead of every affected actor
+	while (!StunExpiries.IsEmpty() && StunExpiries.TopPriority() <= CurrentTimeSeconds)
 	{
-		auto ASC = MapIt->Key;
+		auto ASC = StunExpiries.Pop().ResolveObjectPtr();
 		if (!ASC)
 		{
-			MapIt.RemoveCurrent();
+			// Destroyed while stunned; key in AffectedActors is nulled by garbage collection and removed below
+			bAnyDestroyed = true;
 			continue;
 		}
 
-		auto& Entry = MapIt->Value;
-
-		// expired
-		if (Entry.EndGameTimeSeconds <= CurrentTimeSeconds)
+		FEMPAffectedActorData Entry;
+		if (!AffectedActors.RemoveAndCopyValue(ASC, Entry))
 		{
-			UE_VLOG_UELOG(GetOwner(), LogTRItem, Log, TEXT("%s-%s: CheckRemoveStunTags: Removing %s from %s"),
-				*LoggingUtils::GetName(GetOwner()), *GetName(),
-				*DebuffTagsContainer.ToString(), *LoggingUtils::GetName(ASC->GetOwner()));
+			continue;
+		}
 
-			ASC->RemoveLooseGameplayTags(DebuffTagsContainer);
+		UE_VLOG_UELOG(GetOwner(), LogTRItem, Log, TEXT("%s-%s: CheckRemoveStunTags: Removing %s from %s"),
+			*LoggingUtils::GetName(GetOwner()), *GetName(),
+			*DebuffTagsContainer.ToString(), *LoggingUtils::GetName(ASC->GetOwner()));
 
-			if (bNotify)
+		ASC->RemoveLooseGameplayTags(DebuffTagsContainer);
+
+		if (bNotify)
+		{
+			if (const auto Pawn = Cast<APawn>(ASC->GetOwner()); Pawn)
 			{
-				if (const auto Pawn = Cast<APawn>(ASC->GetOwner()); Pawn)
-				{
-					RemovedActors.Add(Pawn);
-				}
+				RemovedActors.Add(Pawn);
 			}
+		}
+
+		// stop the Vfx
+		if (Entry.Vfx)
+		{
+			Entry.Vfx->Deactivate();
+		}
+	}
 
-			// stop the Vfx
-			if (Entry.Vfx)
+	// Garbage collection nulls keys in place without rehashing so Remove(nullptr) would not find them
+	if (bAnyDestroyed)
+	{
+		for (auto It = AffectedActors.CreateIterator(); It; ++It)
+		{
+			if (!It.Key())
 			{
-				Entry.Vfx->Deactivate();
+				It.RemoveCurrent();
 			}
-
-			MapIt.RemoveCurrent();
 		}
-	} // for
+	}
 
 	if (bNotify)
 	{
 		OnItemGameplayTagsChanged.Broadcast(this, RemovedActors, DebuffTagsContainer, false);
 	}
 
+	ScheduleNextStunRemoval(CurrentTimeSeconds);
+}
+
+void UEMPWeapon::ScheduleNextStunRemoval(float CurrentTimeSeconds)
+{
 	// if there are still some not expired, schedule for nearest expiration
-	if (AffectedActors.IsEmpty())
+	if (StunExpiries.IsEmpty())
 	{
 		TagExpirationHandle.Invalidate();
 		return;
 	}
 
-	float MinTime = std::numeric_limits<float>::max();
-	for(const auto& [_, Entry] : AffectedActors)
-	{
-		if (Entry.EndGameTimeSeconds < MinTime)
-		{
-			MinTime = Entry.EndGameTimeSeconds;
-		}
-	}
+	const auto MinTime = StunExpiries.TopPriority();
 
 	const auto MinDeltaTime = MinTime - CurrentTimeSeconds;
 	checkf(MinDeltaTime > 0, TEXT("MinDeltaTime <= 0: MinTime=%f; CurrentTimeSeconds=%f"),
@@ -195,20 +227,25 @@ void UEMPWeapon::ScheduleStunRemoval(float DeltaTime)
 	World->GetTimerManager().SetTimer(TagExpirationHandle, this, &ThisClass::CheckRemoveStunTag, DeltaTime, false);
 }
 
-void UEMPWeapon::ApplyEffectToEnemy(AActor* Enemy, float EffectEndGameTimeSeconds, const FGameplayTagContainer& DebuffTagsContainer)
+bool UEMPWeapon::ApplyEffectToEnemy(AActor& Enemy, UAbilitySystemComponent& ASC, float EffectEndGameTimeSeconds, const FGameplayTagContainer& DebuffTagsContainer)
 {
-	check(Enemy);
+	// Re-hit while stunned: extend the stun in place instead of adding the loose tags again, which would need removing twice, and spawning another vfx
+	if (!StunExpiries.AddOrUpdate(TObjectKey<UAbilitySystemComponent>(&ASC), EffectEndGameTimeSeconds) && AffectedActors.Contains(&ASC))
+	{
+		UE_VLOG_UELOG(GetOwner(), LogTRItem, Verbose, TEXT("%s-%s: ApplyEffectToEnemy: Extended stun on %s to %fs"),
+			*LoggingUtils::GetName(GetOwner()), *GetName(), *Enemy.GetName(), EffectEndGameTimeSeconds);
 
-	auto ASC = UAbilitySystemBlueprintLibrary::GetAbilitySystemComponent(Enemy);
-	// already checked in the sweep
-	check(ASC);
+		return false;
+	}
 
 	// TODO: Do this from a gameplay effect
-	ASC->AddLooseGameplayTags(DebuffTagsContainer);
+	ASC.AddLooseGameplayTags(DebuffTagsContainer);
 
-	auto NiagaraComponent = PlayAffectedEnemyVfx(Enemy);
+	auto NiagaraComponent = PlayAffectedEnemyVfx(&Enemy);
 
-	AffectedActors.Add(ASC, { NiagaraComponent, EffectEndGameTimeSeconds});
+	AffectedActors.Add(&ASC, { NiagaraComponent });
+
+	return true;
 }
 
 #pragma region Niagara Vfx
@@ -225,39 +262,57 @@ void UEMPWeapon::PlayActivationVfx()
 
 	const auto& SpawnLocation = OwningActor->GetActorLocation();
 
-	UE_VLOG_UELOG(OwningActor, LogTRItem, Log, TEXT("%s: PlayActivationVfx: %s playing at %s"), *GetName(), *ActivationVfx->GetName(), *SpawnLocation.ToCompactString());
-
-	UNiagaraComponent* NiagaraComp = UNiagaraFunctionLibrary::SpawnSystemAtLocation(this, ActivationVfx, SpawnLocation, OwningActor->GetActorRotation());
+	auto World = GetWorld();
+	check(World);
 
-	if (!NiagaraComp)
+	auto VfxManagerSubsystem = World->GetSubsystem<UVfxManagerSubsystem>();
+	if (!ensure(VfxManagerSubsystem))
 	{
-		UE_VLOG_UELOG(OwningActor, LogTRItem, Log, TEXT("%s: PlayActivationVfx: Could not play %s"), *GetName(), *ActivationVfx->GetName());
-
 		return;
 	}
 
+	UE_VLOG_UELOG(OwningActor, LogTRItem, Log, TEXT("%s: PlayActivationVfx: %s queued at %s"), *GetName(), *ActivationVfx->GetName(), *SpawnLocation.ToCompactString());
+
+	// Velocity at activation as the effect may be spawned on a later frame when over the spawn budget
+	const FVector& WorldVelocity = OwningActor->GetVelocity();
+
+	VfxManagerSubsystem->SpawnVfx(FVfxSpawnRequest
+	{
+		.System = ActivationVfx,
+		.Location = SpawnLocation,
+		.Rotation = OwningActor->GetActorRotation(),
+		.Priority = EVfxPriority::High,
+		.OnSpawned = FOnVfxSpawned::CreateWeakLambda(this, [this, WorldVelocity](UNiagaraComponent& NiagaraComponent)
+		{
+			SetActivationVfxParameters(NiagaraComponent, WorldVelocity);
+		})
+	});
+}
+
+void UEMPWeapon::SetActivationVfxParameters(UNiagaraComponent& NiagaraComponent, const FVector& WorldVelocity) const
+{
+	auto OwningActor = GetOwner();
+
 	if (!EffectRadiusName.IsNone())
 	{
 		UE_VLOG_UELOG(OwningActor, LogTRItem, Verbose, TEXT("%s: PlayActivationVfx: (%s,%s) - Setting effect radius parameter Parameter: %s -> %fm"),
-			*GetName(), *ActivationVfx->GetName(), *NiagaraComp->GetName(), *EffectRadiusName.ToString(), InfluenceRadius / 100);
+			*GetName(), *ActivationVfx->GetName(), *NiagaraComponent.GetName(), *EffectRadiusName.ToString(), InfluenceRadius / 100);
 
-		NiagaraComp->SetFloatParameter(EffectRadiusName, InfluenceRadius);
+		NiagaraComponent.SetFloatParameter(EffectRadiusName, InfluenceRadius);
 	}
 
 	if (!OwnerRelativeVelocityName.IsNone())
 	{
-		const FVector& WorldVelocity = OwningActor->GetVelocity();
-
 		UE_VLOG_UELOG(OwningActor, LogTRItem, Verbose, TEXT("%s: PlayActivationVfx: (%s,%s) - Setting relative velocity parameter Parameter: %s -> %s"),
-			*GetName(), *ActivationVfx->GetName(), *NiagaraComp->GetName(),
+			*GetName(), *ActivationVfx->GetName(), *NiagaraComponent.GetName(),
 			*OwnerRelativeVelocityName.ToString(), *WorldVelocity.ToCompactString());
 
 		// This actually needs to be the world velocity and not be relative to the actor's space
-		NiagaraComp->SetVectorParameter(OwnerRelativeVelocityName, WorldVelocity);
+		NiagaraComponent.SetVectorParameter(OwnerRelativeVelocityName, WorldVelocity);
 	}
 
 	UE_VLOG_UELOG(OwningActor, LogTRItem, Log, TEXT("%s: PlayActivationVfx: %s playing NiagaraComponent=%s"),
-		*GetName(), *ActivationVfx->GetName(), *NiagaraComp->GetName());
+		*GetName(), *ActivationVfx->GetName(), *NiagaraComponent.GetName());
 }
 
 UNiagaraComponent* UEMPWeapon::PlayAffectedEnemyVfx(AActor* Enemy)
@@ -10,6 +10,7 @@
 #include "Item/ItemSubsystem.h"
 
 #include "AbilitySystem/TRGameplayTags.h"
+#include "Subsystems/AudioDispatchSubsystem.h"
 
 #include "Kismet/GameplayStatics.h"
 #include "Components/AudioComponent.h"
@@ -321,3 +322,35 @@ UAudioComponent* UItem::PlaySfxAttached(USoundBase* Sound) const
 
 	return SpawnedAudioComponent;
 }
+
+void UItem::QueueSfxAtActorLocation(USoundBase* Sound, ESfxCategory Category) const
+{
+	if (auto ComponentOwner = GetOwner(); ensure(ComponentOwner))
+	{
+		UAudioDispatchSubsystem::QueueSfxAtActor(*ComponentOwner, Sound, Category, ComponentOwner);
+	}
+}
+
+void UItem::QueueSfxAttached(USoundBase* Sound, ESfxCategory Category) const
+{
+	auto ComponentOwner = GetOwner();
+	if (!ensure(Sound) || !ensure(ComponentOwner))
+	{
+		return;
+	}
+
+	auto World = ComponentOwner->GetWorld();
+	check(World);
+
+	if (auto AudioDispatchSubsystem = World->GetSubsystem<UAudioDispatchSubsystem>(); ensure(AudioDispatchSubsystem))
+	{
+		AudioDispatchSubsystem->PlaySfx(FOneShotSfxRequest
+		{
+			.Sound = Sound,
+			.Owner = ComponentOwner,
+			.AttachComponent = ComponentOwner->GetRootComponent(),
+			.Location = ComponentOwner->GetActorLocation(),
+			.Category = Category
+		});
+	}
+}
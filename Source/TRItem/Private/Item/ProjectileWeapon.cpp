@@ -5,6 +5,7 @@
 #include "TRTags.h"
 
 #include "Projectile.h"
+#include "Subsystems/ProjectilePoolSubsystem.h"
 #include "Kismet/GameplayStatics.h"
 
 #include "Logging/LoggingUtils.h"
@@ -61,6 +62,25 @@ bool UProjectileWeapon::DoActivation(USceneComponent& ActivationReferenceCompone
 	return true;
 }
 
+void UProjectileWeapon::NativeInitialize(const FItemConfigData& ItemConfigData)
+{
+	Super::NativeInitialize(ItemConfigData);
+
+	if (ProjectilePoolPrewarmCount <= 0 || !WeaponProjectileClass)
+	{
+		return;
+	}
+
+	auto World = GetWorld();
+	check(World);
+
+	if (auto ProjectilePoolSubsystem = World->GetSubsystem<UProjectilePoolSubsystem>(); ensure(ProjectilePoolSubsystem))
+	{
+		// Enough for a full salvo of multi-shell weapons
+		ProjectilePoolSubsystem->Prewarm(ChooseProjectileClass(), FMath::Max(ProjectilePoolPrewarmCount, ProjectileCount));
+	}
+}
+
 void UProjectileWeapon::LaunchProjectile(USceneComponent& ActivationReferenceComponent, const FName& ActivationSocketName)
 {
 	const FVector SpawnLocation = ActivationReferenceComponent.GetSocketLocation(ActivationSocketName);
@@ -71,8 +91,11 @@ void UProjectileWeapon::LaunchProjectile(USceneComponent& ActivationReferenceCom
 	auto World = GetWorld();
 	check(World);
 
+	auto ProjectilePoolSubsystem = World->GetSubsystem<UProjectilePoolSubsystem>();
+	check(ProjectilePoolSubsystem);
+
 	auto ChosenWeaponProjectileClass = ChooseProjectileClass();
-	auto SpawnedProjectile = World->SpawnActorDeferred<AProjectile>(ChosenWeaponProjectileClass, SpawnTransform, GetOwner(), GetOwner());
+	auto SpawnedProjectile = ProjectilePoolSubsystem->AcquireProjectile(ChosenWeaponProjectileClass, SpawnTransform, GetOwner(), GetOwner());
 
 	if (!SpawnedProjectile)
 	{
@@ -112,7 +135,7 @@ void UProjectileWeapon::LaunchProjectile(USceneComponent& ActivationReferenceCom
 	}
 
 	SpawnedProjectile->Initialize(this, ActivationReferenceComponent, ActivationSocketName, ProjectileDamageParams, OptHomingParams);
-	SpawnedProjectile->FinishSpawning(SpawnTransform);
+	ProjectilePoolSubsystem->ActivateProjectile(*SpawnedProjectile, SpawnTransform);
 
 	SpawnedProjectile->Launch(ProjectileLaunchSpeed);
 }
@@ -147,7 +170,7 @@ void UProjectileWeapon::UpdateHomingTargets(AProjectile& Projectile)
 		return;
 	}
 
-	Projectile.OnDestroyed.AddDynamic(this, &ThisClass::OnProjectileDestroyed);
+	Projectile.OnFinished.AddUObject(this, &ThisClass::OnProjectileFinished);
 	Projectile.OnHomingTargetSelected.AddUObject(this, &ThisClass::OnHomingTargetSelected);
 
 	const float CurrentTimeSeconds = World->GetTimeSeconds();
@@ -176,29 +199,28 @@ TSubclassOf<AProjectile> UProjectileWeapon::ChooseProjectileClass() const
 	return WeaponProjectileClass;
 }
 
-void UProjectileWeapon::OnProjectileDestroyed(AActor* Actor)
+void UProjectileWeapon::OnProjectileFinished(AProjectile* FinishedProjectile)
 {
-	auto DestroyedProjectile = Cast<AProjectile>(Actor);
-	if (!DestroyedProjectile)
+	if (!FinishedProjectile)
 	{
 		return;
 	}
 
-	AActor* DestroyedProjectileHomingTarget{};
-	ProjectileTargetMap.RemoveAndCopyValue(DestroyedProjectile, DestroyedProjectileHomingTarget);
+	AActor* FinishedProjectileHomingTarget{};
+	ProjectileTargetMap.RemoveAndCopyValue(FinishedProjectile, FinishedProjectileHomingTarget);
 
-	if (!IsValid(DestroyedProjectileHomingTarget))
+	if (!IsValid(FinishedProjectileHomingTarget))
 	{
 		return;
 	}
 
-	AvailableHomingTargets.Add(DestroyedProjectileHomingTarget);
+	AvailableHomingTargets.Add(FinishedProjectileHomingTarget);
 
 	for (auto [Projectile, _] : ProjectileTargetMap)
 	{
 		if (IsValid(Projectile))
 		{
-			Projectile->AddAvailableHomingTarget(DestroyedProjectileHomingTarget);
+			Projectile->AddAvailableHomingTarget(FinishedProjectileHomingTarget);
 		}
 	}
 }
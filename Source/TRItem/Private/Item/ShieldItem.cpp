@@ -2,6 +2,8 @@
 
 
 #include "Item/ShieldItem.h"
+
+#include "Subsystems/AudioDispatchSubsystem.h"
 #include "Damage/DamageAdjustmentOwner.h"
 
 #include "Logging/LoggingUtils.h"
@@ -61,7 +63,7 @@ void UShieldItem::OnCooldownComplete()
 {
 	Super::OnCooldownComplete();
 
-	PlaySfxAttached(ActivationSfx);
+	QueueSfxAttached(ActivationSfx, ESfxCategory::Item);
 }
 
 float UShieldItem::OnCalculateDamage(float Damage, const AActor* DamagedActor, const AController* InstigatedBy, const AActor* DamageCauser)
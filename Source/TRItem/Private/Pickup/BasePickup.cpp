@@ -11,6 +11,9 @@
 #include "AbilitySystemComponent.h"
 #include "Kismet/GameplayStatics.h"
 
+#include "Pickup/PickupPoolSubsystem.h"
+#include "Subsystems/TimerWheelSubsystem.h"
+
 #include UE_INLINE_GENERATED_CPP_BY_NAME(BasePickup)
 
 ABasePickup::ABasePickup()
@@ -25,6 +28,25 @@ void ABasePickup::BeginPlay()
 	SetLifetimeIfApplicable();
 }
 
+void ABasePickup::LifeSpanExpired()
+{
+	if (!bPooled)
+	{
+		Super::LifeSpanExpired();
+		return;
+	}
+
+	// Already waiting to be released
+	if (bMarkedForDestroy)
+	{
+		return;
+	}
+
+	UE_VLOG_UELOG(this, LogTRItem, Log, TEXT("%s - LifeSpanExpired - Releasing to pool"), *GetName());
+
+	ReleaseOrDestroy();
+}
+
 void ABasePickup::RegisterOverlapEvent(UPrimitiveComponent* OverlapCheckComponent)
 {
 	if (!ensure(OverlapCheckComponent))
@@ -46,10 +68,68 @@ void ABasePickup::MarkForDestroy()
 
 	bMarkedForDestroy = true;
 
-	GetWorldTimerManager().SetTimerForNextTick(FTimerDelegate::CreateWeakLambda(this, [this]()
+	auto World = GetWorld();
+	check(World);
+
+	// Allow frame to complete before destroying the object
+	if (auto TimerWheelSubsystem = World->GetSubsystem<UTimerWheelSubsystem>(); ensure(TimerWheelSubsystem))
+	{
+		PendingReleaseTimer = TimerWheelSubsystem->GetTimerWheel().SetTimer(FTimerDelegate::CreateWeakLambda(this, [this]()
+		{
+			ReleaseOrDestroy();
+		}), 0.0);
+	}
+}
+
+void ABasePickup::ReleaseOrDestroy()
+{
+	auto World = GetWorld();
+	auto PickupPoolSubsystem = bPooled && World ? World->GetSubsystem<UPickupPoolSubsystem>() : nullptr;
+
+	if (!PickupPoolSubsystem)
 	{
 		Destroy();
-	}));
+		return;
+	}
+
+	PickupPoolSubsystem->ReleasePickup(*this);
+}
+
+void ABasePickup::PrepareForReuse(AActor* NewOwner, APawn* NewInstigator, const FTransform& Transform)
+{
+	check(bPooled);
+
+	bMarkedForDestroy = false;
+
+	SetOwner(NewOwner);
+	SetInstigator(NewInstigator);
+	SetActorLocationAndRotation(Transform.GetLocation(), Transform.GetRotation(), false, nullptr, ETeleportType::ResetPhysics);
+
+	// Moved before enabling collision so that the overlap update re-arms the overlap at the new location, e.g. if the player is already there
+	SetPickupActive(true);
+	SetLifetimeIfApplicable();
+
+	ReceiveOnReusedFromPool();
+}
+
+void ABasePickup::ResetForPool()
+{
+	if (auto World = GetWorld(); World)
+	{
+		if (auto TimerWheelSubsystem = World->GetSubsystem<UTimerWheelSubsystem>(); TimerWheelSubsystem)
+		{
+			TimerWheelSubsystem->GetTimerWheel().ClearTimer(PendingReleaseTimer);
+		}
+	}
+
+	SetLifeSpan(0.0f);
+	SetPickupActive(false);
+}
+
+void ABasePickup::SetPickupActive(bool bActive)
+{
+	SetActorHiddenInGame(!bActive);
+	SetActorEnableCollision(bActive);
 }
 
 void ABasePickup::OnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
@@ -0,0 +1,356 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Pickup/PickupPoolSubsystem.h"
+
+#include "Pickup/BasePickup.h"
+
+#include "Utils/CollisionUtils.h"
+#include "TRConstants.h"
+
+#include "Logging/LoggingUtils.h"
+#include "TRItemLogging.h"
+
+#if TR_DEBUG_ENABLED
+	#include "HAL/IConsoleManager.h"
+	#include "Kismet/GameplayStatics.h"
+	#include "Pickup/XPToken.h"
+	#include "UObject/SoftObjectPath.h"
+	#include "UObject/UObjectArray.h"
+#endif
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(PickupPoolSubsystem)
+
+DECLARE_CYCLE_STAT(TEXT("PickupPoolSubsystem::FlushQueuedSpawns"), STAT_PickupPoolSubsystem_FlushQueuedSpawns, STATGROUP_TRItem);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pickup Pool Hits"), STAT_PickupPoolSubsystem_Hits, STATGROUP_TRItem);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pickup Pool Misses"), STAT_PickupPoolSubsystem_Misses, STATGROUP_TRItem);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pickup Pool Available"), STAT_PickupPoolSubsystem_Available, STATGROUP_TRItem);
+
+namespace
+{
+	/* Ground is searched from slightly above the base location, e.g. the destroyed tank location, to well below it. */
+	constexpr float GroundTraceUpDistance = 100.0f;
+	constexpr float GroundTraceDownDistance = 1000.0f;
+}
+
+ABasePickup* UPickupPoolSubsystem::AcquirePickup(TSubclassOf<ABasePickup> PickupClass, const FTransform& Transform, AActor* Owner, APawn* Instigator)
+{
+	if (!ensure(PickupClass))
+	{
+		return nullptr;
+	}
+
+	if (auto Pool = Pools.Find(PickupClass); Pool)
+	{
+		while (!Pool->Available.IsEmpty())
+		{
+			auto Pickup = Pool->Available.Pop(false);
+			DEC_DWORD_STAT(STAT_PickupPoolSubsystem_Available);
+
+			// Pooled actors can still be destroyed externally, e.g. when streaming out a level
+			if (!IsValid(Pickup))
+			{
+				continue;
+			}
+
+			Pickup->PrepareForReuse(Owner, Instigator, Transform);
+
+			++HitCount;
+			INC_DWORD_STAT(STAT_PickupPoolSubsystem_Hits);
+
+			return Pickup;
+		}
+	}
+
+	auto Pickup = SpawnPickup(PickupClass, Transform, Owner, Instigator);
+
+	if (Pickup && Pickup->IsPoolable())
+	{
+		++MissCount;
+		INC_DWORD_STAT(STAT_PickupPoolSubsystem_Misses);
+
+		UE_LOG(LogTRItem, Verbose, TEXT("%s: AcquirePickup: %s - Pool empty, spawned new pickup; HitCount=%d; MissCount=%d"),
+			*GetName(), *LoggingUtils::GetName(PickupClass), HitCount, MissCount);
+	}
+
+	return Pickup;
+}
+
+void UPickupPoolSubsystem::ReleasePickup(ABasePickup& Pickup)
+{
+	if (!ensureMsgf(Pickup.bPooled, TEXT("%s: ReleasePickup: %s was not spawned by the pool"), *GetName(), *Pickup.GetName()))
+	{
+		Pickup.Destroy();
+		return;
+	}
+
+	Pickup.ResetForPool();
+
+	Pools.FindOrAdd(Pickup.GetClass()).Available.Add(&Pickup);
+	INC_DWORD_STAT(STAT_PickupPoolSubsystem_Available);
+}
+
+void UPickupPoolSubsystem::QueueGroundedSpawn(const FGroundedPickupSpawn& Spawn)
+{
+	if (!ensure(Spawn.PickupClass))
+	{
+		return;
+	}
+
+	QueuedSpawns.Add(Spawn);
+}
+
+bool UPickupPoolSubsystem::IsTickable() const
+{
+	return !QueuedSpawns.IsEmpty();
+}
+
+void UPickupPoolSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	FlushQueuedSpawns();
+}
+
+int32 UPickupPoolSubsystem::FlushQueuedSpawns()
+{
+	SCOPE_CYCLE_COUNTER(STAT_PickupPoolSubsystem_FlushQueuedSpawns);
+
+	if (QueuedSpawns.IsEmpty())
+	{
+		return 0;
+	}
+
+	// Moved out as reused pickups can overlap the player immediately and queue more spawns
+	auto Spawns = MoveTemp(QueuedSpawns);
+	QueuedSpawns.Reset();
+
+	int32 SpawnedCount{};
+
+	for (const auto& Spawn : Spawns)
+	{
+		const auto PickupCDO = Spawn.PickupClass->GetDefaultObject<ABasePickup>();
+		if (!ensureMsgf(PickupCDO, TEXT("%s: FlushQueuedSpawns - PickupClass=%s has no CDO!"), *GetName(), *LoggingUtils::GetName(Spawn.PickupClass)))
+		{
+			continue;
+		}
+
+		const auto SpawnLocation = GetGroundLocation(Spawn.Location, PickupCDO->GetSpawnOffsetZ());
+
+		if (AcquirePickup(Spawn.PickupClass, FTransform(SpawnLocation), Spawn.Owner.Get(), Spawn.Instigator.Get()))
+		{
+			++SpawnedCount;
+		}
+	}
+
+	UE_LOG(LogTRItem, Verbose, TEXT("%s: FlushQueuedSpawns - Placed %d/%d pickup%s; HitCount=%d; MissCount=%d"),
+		*GetName(), SpawnedCount, Spawns.Num(), LoggingUtils::Pluralize(Spawns.Num()), HitCount, MissCount);
+
+	return SpawnedCount;
+}
+
+FVector UPickupPoolSubsystem::GetGroundLocation(const FVector& Location, float OffsetZ) const
+{
+	auto World = GetWorld();
+	check(World);
+
+	FHitResult HitResult;
+
+	if (World->LineTraceSingleByObjectType(
+		HitResult,
+		Location + FVector(0, 0, GroundTraceUpDistance),
+		Location - FVector(0, 0, GroundTraceDownDistance),
+		TR::CollisionChannel::GroundObjectType
+	))
+	{
+		return HitResult.Location + FVector(0, 0, OffsetZ);
+	}
+
+	UE_LOG(LogTRItem, Warning, TEXT("%s: GetGroundLocation - Could not find ground to snap pickup (Is landscape/floor set to 'Ground' profile?); Location=%s"),
+		*GetName(), *Location.ToCompactString());
+
+	return Location + FVector(0, 0, OffsetZ);
+}
+
+ABasePickup* UPickupPoolSubsystem::SpawnPickup(TSubclassOf<ABasePickup> PickupClass, const FTransform& Transform, AActor* Owner, APawn* Instigator)
+{
+	auto World = GetWorld();
+	check(World);
+
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	SpawnParameters.Owner = Owner;
+	SpawnParameters.Instigator = Instigator;
+
+	auto Pickup = World->SpawnActor<ABasePickup>(PickupClass, Transform, SpawnParameters);
+	if (!Pickup)
+	{
+		UE_LOG(LogTRItem, Warning, TEXT("%s: SpawnPickup: Unable to spawn pickup %s at %s"),
+			*GetName(), *LoggingUtils::GetName(PickupClass), *Transform.GetLocation().ToCompactString());
+		return nullptr;
+	}
+
+	Pickup->bPooled = Pickup->IsPoolable();
+
+	return Pickup;
+}
+
+TStatId UPickupPoolSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UPickupPoolSubsystem, STATGROUP_Tickables);
+}
+
+void UPickupPoolSubsystem::Deinitialize()
+{
+	int32 AvailableCount{};
+	for (const auto& [_, Pool] : Pools)
+	{
+		AvailableCount += Pool.Available.Num();
+	}
+
+	DEC_DWORD_STAT_BY(STAT_PickupPoolSubsystem_Available, AvailableCount);
+
+	UE_LOG(LogTRItem, Log, TEXT("%s: Deinitialize: HitCount=%d; MissCount=%d; AvailableCount=%d; QueuedCount=%d"),
+		*GetName(), HitCount, MissCount, AvailableCount, QueuedSpawns.Num());
+
+	Pools.Reset();
+	QueuedSpawns.Reset();
+
+	Super::Deinitialize();
+}
+
+#pragma region Benchmark
+
+#if TR_DEBUG_ENABLED
+
+namespace
+{
+	/*
+	* Spawns a burst of pickups around the player in one frame through the pool or by spawning and tracing each one as before pooling
+	* and reports the time and number of UObjects allocated. Run the pooled variant twice to measure reuse once the pool is warm.
+	* Pooling is opt in so pass the path of a pickup Blueprint with bPoolable set, e.g. the XP token Blueprint, to measure reuse.
+	*/
+	void RunPickupPoolBenchmark(const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World)
+		{
+			return;
+		}
+
+		auto Subsystem = World->GetSubsystem<UPickupPoolSubsystem>();
+		auto PlayerPawn = UGameplayStatics::GetPlayerPawn(World, 0);
+
+		if (!Subsystem || !PlayerPawn)
+		{
+			UE_LOG(LogTRItem, Warning, TEXT("RunPickupPoolBenchmark: Requires a game world with a player pawn"));
+			return;
+		}
+
+		const int32 Count = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 500;
+		const bool bPooled = Args.Num() > 1 ? FCString::ToBool(*Args[1]) : true;
+
+		TSubclassOf<ABasePickup> PickupClass = AXPToken::StaticClass();
+		if (Args.Num() > 2)
+		{
+			PickupClass = FSoftClassPath(Args[2]).TryLoadClass<ABasePickup>();
+			if (!PickupClass)
+			{
+				UE_LOG(LogTRItem, Warning, TEXT("RunPickupPoolBenchmark: %s is not a pickup class"), *Args[2]);
+				return;
+			}
+		}
+
+		const auto PickupCDO = PickupClass->GetDefaultObject<ABasePickup>();
+
+		if (bPooled && !PickupCDO->IsPoolable())
+		{
+			UE_LOG(LogTRItem, Warning, TEXT("RunPickupPoolBenchmark: %s is not poolable so every pickup is spawned"), *LoggingUtils::GetName(PickupClass));
+		}
+
+		// Place in a ring away from the player so that the tokens are not collected
+		const auto Center = PlayerPawn->GetActorLocation();
+		TArray<FVector> Locations;
+		Locations.Reserve(Count);
+
+		for (int32 i = 0; i < Count; ++i)
+		{
+			Locations.Add(Center + FRotator(0, 360.0 * i / Count, 0).Vector() * (5000.0 + 10.0 * (i % 100)));
+		}
+
+		const auto StartObjectCount = GUObjectArray.GetObjectArrayNumMinusAvailable();
+		const auto StartHitCount = Subsystem->GetHitCount();
+
+		TArray<ABasePickup*> Spawned;
+		Spawned.Reserve(Count);
+
+		const auto StartTime = FPlatformTime::Seconds();
+
+		if (bPooled)
+		{
+			for (const auto& Location : Locations)
+			{
+				Subsystem->QueueGroundedSpawn(FGroundedPickupSpawn
+				{
+					.PickupClass = PickupClass,
+					.Location = Location
+				});
+			}
+
+			Subsystem->FlushQueuedSpawns();
+		}
+		else
+		{
+			const auto OffsetZ = PickupCDO->GetSpawnOffsetZ();
+
+			for (const auto& Location : Locations)
+			{
+				FHitResult HitResult;
+				const auto SpawnLocation = (World->LineTraceSingleByObjectType(HitResult, Location + FVector(0, 0, 100), Location - FVector(0, 0, 1000),
+					TR::CollisionChannel::GroundObjectType) ? HitResult.Location : Location) + FVector(0, 0, OffsetZ);
+
+				Spawned.Add(World->SpawnActor<ABasePickup>(PickupClass, SpawnLocation, FRotator::ZeroRotator));
+			}
+		}
+
+		const auto ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+		const auto ObjectCountDelta = GUObjectArray.GetObjectArrayNumMinusAvailable() - StartObjectCount;
+		const auto ReusedCount = Subsystem->GetHitCount() - StartHitCount;
+
+		UE_LOG(LogTRItem, Display, TEXT("RunPickupPoolBenchmark: %s - PickupClass=%s; Count=%d; Time=%.3fms; UObjectsAllocated=%d; Reused=%d"),
+			bPooled ? TEXT("Pooled") : TEXT("Spawned"), *LoggingUtils::GetName(PickupClass), Count, ElapsedSeconds * 1000, ObjectCountDelta, ReusedCount);
+
+		// Clean up so that the benchmark can be repeated. Pooled tokens go back to the pool
+		if (bPooled)
+		{
+			TArray<AActor*> Pickups;
+			UGameplayStatics::GetAllActorsOfClass(World, PickupClass, Pickups);
+
+			for (auto Actor : Pickups)
+			{
+				if (auto Pickup = Cast<ABasePickup>(Actor); Pickup && Pickup->IsPoolable() && !Pickup->IsHidden())
+				{
+					Subsystem->ReleasePickup(*Pickup);
+				}
+			}
+		}
+		else
+		{
+			for (auto Pickup : Spawned)
+			{
+				if (Pickup)
+				{
+					Pickup->Destroy();
+				}
+			}
+		}
+	}
+
+	FAutoConsoleCommandWithWorldAndArgs PickupPoolBenchmarkCommand(
+		TEXT("tr.item.pickupPool.benchmark"),
+		TEXT("Spawns a burst of pickups in one frame and reports time and UObjects allocated: [Count=500] [Pooled=1] [PickupClass=/Script/TRItem.XPToken]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunPickupPoolBenchmark));
+}
+
+#endif
+
+#pragma endregion Benchmark
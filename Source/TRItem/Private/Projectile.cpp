@@ -27,13 +27,22 @@
 
 #include "PhysicalMaterials/PhysicalMaterial.h"
 
-#include "Interfaces/Percentage.h"
+#include "Subsystems/HomingTargetSubsystem.h"
+#include "Subsystems/ProjectilePoolSubsystem.h"
+#include "Subsystems/PawnSpatialHashSubsystem.h"
+#include "Subsystems/TimerWheelSubsystem.h"
+#include "Subsystems/AudioDispatchSubsystem.h"
+#include "Subsystems/VfxManagerSubsystem.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(Projectile)
 
 namespace
 {
 	constexpr ECollisionChannel HomingLOSTraceChannel = TR::CollisionChannel::MissileHomingTargetTraceType;
+
+	/* Slack for spatial hash locations lagging a frame behind so the exact checks decide borderline targets. */
+	constexpr float SpatialHashDistanceMargin = 500.0f;
+	constexpr float SpatialHashCosineMargin = 0.1f;
 }
 
 AProjectile::AProjectile()
@@ -88,19 +97,31 @@ void AProjectile::Initialize(UWeapon* Weapon, USceneComponent& IncidentComponent
 
 	check(ExplosionForce);
 
+	// Start from the class defaults as pooled projectiles are initialized once per launch
+	const auto DefaultExplosionForce = GetClass()->GetDefaultObject<AProjectile>()->ExplosionForce;
+	check(DefaultExplosionForce);
+
 	if (ProjectileDamageParams.WeaponDamageType == EWeaponDamageType::Radial)
 	{
 		ExplosionForce->Falloff = ERadialImpulseFalloff::RIF_Linear;
 		ExplosionForce->Radius = ProjectileDamageParams.DamageOuterRadius;
 	}
+	else
+	{
+		ExplosionForce->Falloff = DefaultExplosionForce->Falloff;
+		ExplosionForce->Radius = DefaultExplosionForce->Radius;
+	}
 
-	ExplosionForce->ImpulseStrength *= ProjectileDamageParams.ImpactImpulseAmountMultiplier;
-	HitVfxScaleParameterValue *= ProjectileDamageParams.ImpactImpulseAmountMultiplier;
+	ExplosionForce->ImpulseStrength = DefaultExplosionForce->ImpulseStrength * ProjectileDamageParams.ImpactImpulseAmountMultiplier;
 
 	if (InOptHomingParams)
 	{
 		InitHomingInfo(*InOptHomingParams);
 	}
+	else
+	{
+		ProjectileHomingParams = {};
+	}
 }
 
 void AProjectile::BeginPlay()
@@ -120,7 +141,15 @@ void AProjectile::EndPlay(EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
-	GetWorldTimerManager().ClearTimer(HomingTargetTimerHandle);
+	Finish();
+
+	if (auto World = GetWorld(); World)
+	{
+		if (auto HomingTargetSubsystem = World->GetSubsystem<UHomingTargetSubsystem>(); HomingTargetSubsystem)
+		{
+			HomingTargetSubsystem->UnregisterProjectile(*this);
+		}
+	}
 
 	DestroyDebugDraw();
 }
@@ -133,8 +162,21 @@ void AProjectile::PostInitializeComponents()
 
 	ProjectileMovementComponent->SetCanDamageOwner(bCanDamageInstigator);
 
+	IgnoreOwnerWhenMoving();
+}
+
+void AProjectile::IgnoreOwnerWhenMoving()
+{
+	if (!ensure(ProjectileMesh))
+	{
+		return;
+	}
+
+	// Owner changes when a pooled projectile is reused
+	ProjectileMesh->ClearMoveIgnoreActors();
+
 	// Avoid self-hit unless configured to allow
-	if (ensure(ProjectileMesh) && !bCanDamageInstigator)
+	if (!bCanDamageInstigator)
 	{
 		ProjectileMesh->IgnoreActorWhenMoving(GetOwner(), true);
 	}
@@ -195,18 +237,34 @@ void AProjectile::PlayHitVfx()
 		return;
 	}
 
-	UE_VLOG_UELOG(this, LogTRItem, Log, TEXT("%s: PlayHitVfx: %s playing at %s"), *GetName(), *HitVfx.GetName(), *GetActorLocation().ToCompactString());
-
-	UNiagaraComponent* NiagaraComp = UNiagaraFunctionLibrary::SpawnSystemAtLocation(this, HitVfx, GetActorLocation());
-
-	UE_VLOG_UELOG(this, LogTRItem, Log, TEXT("%s: PlayHitVfx: %s playing NiagaraComponent=%s"), *GetName(), *HitVfx.GetName(), *LoggingUtils::GetName(NiagaraComp));
+	auto World = GetWorld();
+	check(World);
 
-	if (!NiagaraComp)
+	auto VfxManagerSubsystem = World->GetSubsystem<UVfxManagerSubsystem>();
+	if (!ensure(VfxManagerSubsystem))
 	{
 		return;
 	}
 
-	SetNiagaraHitEffectParameters(NiagaraComp);
+	UE_VLOG_UELOG(this, LogTRItem, Log, TEXT("%s: PlayHitVfx: %s queued at %s"), *GetName(), *HitVfx.GetName(), *GetActorLocation().ToCompactString());
+
+	// Parameters are captured now as the effect may be spawned on a later frame after this projectile was destroyed or released to the pool and reused
+	const FName ScaleParameterName = HitVfxScaleParameterName;
+	const float ScaleParameterValue = HitVfxScaleParameterValue * ProjectileDamageParams.ImpactImpulseAmountMultiplier;
+
+	VfxManagerSubsystem->SpawnVfx(FVfxSpawnRequest
+	{
+		.System = HitVfx,
+		.Location = GetActorLocation(),
+		.Priority = EVfxPriority::Normal,
+		.OnSpawned = FOnVfxSpawned::CreateLambda([ScaleParameterName, ScaleParameterValue](UNiagaraComponent& NiagaraComponent)
+		{
+			if (!ScaleParameterName.IsNone())
+			{
+				NiagaraComponent.SetFloatParameter(ScaleParameterName, ScaleParameterValue);
+			}
+		})
+	});
 }
 
 void AProjectile::StopFiringSfx()
@@ -235,7 +293,8 @@ void AProjectile::PlayExplosionSfxIfSet()
 		return;
 	}
 
-	PlaySfxAtActorLocation(ExplosionSfx);
+	// Owner of the projectile limits the concurrency when firing multiple shells as in PlaySfxAtActorLocation
+	UAudioDispatchSubsystem::QueueSfxAtActor(*this, ExplosionSfx, ESfxCategory::Explosion, GetOwner(), true);
 }
 
 void AProjectile::SetNiagaraFireEffectParameters_Implementation(UNiagaraComponent* NiagaraComponent)
@@ -249,16 +308,6 @@ void AProjectile::SetNiagaraFireEffectParameters_Implementation(UNiagaraComponen
 	}
 }
 
-void AProjectile::SetNiagaraHitEffectParameters_Implementation(UNiagaraComponent* NiagaraComponent)
-{
-	check(NiagaraComponent);
-
-	if (!HitVfxScaleParameterName.IsNone())
-	{
-		NiagaraComponent->SetFloatParameter(HitVfxScaleParameterName, HitVfxScaleParameterValue);
-	}
-}
-
 UAudioComponent* AProjectile::PlaySfxAtActorLocation(USoundBase* Sound) const
 {
 	if (!ensure(Sound))
@@ -353,11 +402,126 @@ void AProjectile::MarkForDestroy()
 {
 	bMarkedForDestroy = true;
 
+	auto World = GetWorld();
+	check(World);
+
 	// Allow frame to complete before destroying the object
-	GetWorldTimerManager().SetTimerForNextTick(FTimerDelegate::CreateWeakLambda(this, [this]()
+	if (auto TimerWheelSubsystem = World->GetSubsystem<UTimerWheelSubsystem>(); ensure(TimerWheelSubsystem))
+	{
+		PendingReleaseTimer = TimerWheelSubsystem->GetTimerWheel().SetTimer(FTimerDelegate::CreateWeakLambda(this, [this]()
+		{
+			ReleaseOrDestroy();
+		}), 0.0);
+	}
+}
+
+void AProjectile::LifeSpanExpired()
+{
+	if (!bPooled)
+	{
+		Super::LifeSpanExpired();
+		return;
+	}
+
+	UE_VLOG_UELOG(this, LogTRItem, Log, TEXT("%s: LifeSpanExpired - Releasing to pool"), *GetName());
+
+	ReleaseOrDestroy();
+}
+
+void AProjectile::ReleaseOrDestroy()
+{
+	auto World = GetWorld();
+	auto ProjectilePoolSubsystem = bPooled && World ? World->GetSubsystem<UProjectilePoolSubsystem>() : nullptr;
+
+	if (!ProjectilePoolSubsystem)
 	{
 		Destroy();
-	}));
+		return;
+	}
+
+	ProjectilePoolSubsystem->ReleaseProjectile(*this);
+}
+
+void AProjectile::Finish()
+{
+	if (bFinished)
+	{
+		return;
+	}
+
+	bFinished = true;
+
+	OnFinished.Broadcast(this);
+
+	// Next user of a pooled projectile binds its own delegates
+	OnFinished.Clear();
+	OnHomingTargetSelected.Clear();
+}
+
+void AProjectile::PrepareForReuse(AActor* NewOwner, APawn* NewInstigator, const FTransform& Transform)
+{
+	check(bPooled);
+
+	bFinished = false;
+	bMarkedForDestroy = false;
+
+	SetOwner(NewOwner);
+	SetInstigator(NewInstigator);
+	SetActorLocationAndRotation(Transform.GetLocation(), Transform.GetRotation(), false, nullptr, ETeleportType::ResetPhysics);
+
+	IgnoreOwnerWhenMoving();
+
+	// BeginPlay only runs for the first use
+	InitDebugDraw();
+}
+
+void AProjectile::ResetForPool()
+{
+	Finish();
+
+	auto World = GetWorld();
+	check(World);
+
+	if (auto HomingTargetSubsystem = World->GetSubsystem<UHomingTargetSubsystem>(); HomingTargetSubsystem)
+	{
+		HomingTargetSubsystem->UnregisterProjectile(*this);
+	}
+
+	// Clears the pending release and lifespan timers
+	if (auto TimerWheelSubsystem = World->GetSubsystem<UTimerWheelSubsystem>(); TimerWheelSubsystem)
+	{
+		TimerWheelSubsystem->GetTimerWheel().ClearTimer(PendingReleaseTimer);
+	}
+
+	// Otherwise a pooled projectile keeps logging its state every 50ms while parked
+	DestroyDebugDraw();
+
+	World->GetTimerManager().ClearAllTimersForObject(this);
+	SetLifeSpan(0.0f);
+
+	check(ProjectileMovementComponent);
+
+	ProjectileMovementComponent->StopMovementImmediately();
+	ProjectileMovementComponent->Deactivate();
+	ProjectileMovementComponent->HomingTargetComponent = nullptr;
+	ProjectileMovementComponent->bIsHomingProjectile = false;
+
+	SetProjectileActive(false);
+
+	// Don't keep references to the previous firing weapon and targets alive
+	FiredFrom = nullptr;
+	AttachComponent = nullptr;
+	FiringAudioComponent = nullptr;
+	ProjectileHomingParams = {};
+	ProjectileDamageParams = {};
+
+	UE_VLOG_UELOG(this, LogTRItem, Log, TEXT("%s: ResetForPool"), *GetName());
+}
+
+void AProjectile::SetProjectileActive(bool bActive)
+{
+	SetActorHiddenInGame(!bActive);
+	SetActorEnableCollision(bActive);
 }
 
 void AProjectile::PlayHitSfx(AActor* HitActor, UPrimitiveComponent* HitComponent, const FHitResult& Hit) const
@@ -376,7 +540,7 @@ void AProjectile::PlayHitSfx(AActor* HitActor, UPrimitiveComponent* HitComponent
 		return;
 	}
 
-	PlaySfxAtActorLocation(Sound);
+	UAudioDispatchSubsystem::QueueSfxAtActor(*this, Sound, ESfxCategory::Impact, GetOwner(), true);
 }
 
 USoundBase* AProjectile::GetHitSound(AActor* HitActor, UPrimitiveComponent* HitComponent, const FHitResult& Hit) const
@@ -474,20 +638,21 @@ void AProjectile::InitHomingInfo(const FProjectileHomingParams& InProjectileHomi
 {
 	ProjectileHomingParams = InProjectileHomingParams;
 
-	GetWorldTimerManager().SetTimer(HomingTargetTimerHandle, this, &AProjectile::RefreshHomingTarget,
-		ProjectileHomingParams.HomingTargetRefreshInterval, true);
-
 	ViabilityTraceBendFactor = FMath::Sin(FMath::DegreesToRadians(ViabilityTraceBendAngleDegrees) * 0.5f);
 
-	// Run also immediately
-	RefreshHomingTarget();
+	auto World = GetWorld();
+	check(World);
+
+	// Targets of all homing projectiles are refreshed together so that traces and target state can be shared
+	// First refresh happens on the next subsystem tick which is still this frame
+	if (auto HomingTargetSubsystem = World->GetSubsystem<UHomingTargetSubsystem>(); ensure(HomingTargetSubsystem))
+	{
+		HomingTargetSubsystem->RegisterProjectile(*this, ProjectileHomingParams.HomingTargetRefreshInterval);
+	}
 }
 
-void AProjectile::RefreshHomingTarget()
+void AProjectile::GatherHomingTargetCandidates(FHomingTargetBatchContext& Context, TArray<FHomingTargetCandidate>& OutCandidates) const
 {
-	std::pair<AActor*, double> BestTarget{ nullptr, std::numeric_limits<double>::max() };
-	int32 ViableCount{};
-
 	const auto& CurrentLocation = GetActorLocation();
 	const auto& VelocityDirection = GetVelocity().GetSafeNormal();
 
@@ -496,16 +661,38 @@ void AProjectile::RefreshHomingTarget()
 
 	const FVector& ProjectileForwardVector = GetActorForwardVector();
 
+	// Pre-filter tracked tanks with a slightly wider cone as hash locations can be a frame behind
+	auto PawnSpatialHashSubsystem = GetWorld()->GetSubsystem<UPawnSpatialHashSubsystem>();
+
+	TArray<APawn*> ConePawns;
+	if (PawnSpatialHashSubsystem)
+	{
+		PawnSpatialHashSubsystem->QueryCone(CurrentLocation, ProjectileForwardVector, MaxHomingDistance + SpatialHashDistanceMargin,
+			HomingTargetCosineThreshold - SpatialHashCosineMargin, ConePawns);
+	}
+
 	for (auto PotentialTarget : ProjectileHomingParams.Targets)
 	{
-		// TODO: Use gameplay tags
-		if (!IsValid(PotentialTarget) || PotentialTarget->ActorHasTag(TR::Tags::Dead))
+		if (!PotentialTarget)
+		{
+			continue;
+		}
+
+		if (auto TargetPawn = Cast<APawn>(PotentialTarget);
+			TargetPawn && PawnSpatialHashSubsystem && PawnSpatialHashSubsystem->IsRegistered(*TargetPawn) && !ConePawns.Contains(TargetPawn))
+		{
+			continue;
+		}
+
+		const auto& TargetInfo = Context.GetTargetInfo(*PotentialTarget);
+
+		if (!TargetInfo.bViable)
 		{
 			continue;
 		}
 
 		// consider both distance and alignment
-		const auto& TargetLocation = PotentialTarget->GetActorLocation();
+		const auto& TargetLocation = TargetInfo.Location;
 		const auto ToTarget = TargetLocation - CurrentLocation;
 		const auto Dist = FMath::Max(0.01, ToTarget.Size());
 
@@ -525,43 +712,93 @@ void AProjectile::RefreshHomingTarget()
 		if (FMath::Abs(CurrentLocation.Z - TargetLocation.Z) <= MaxZDifference && (
 			TargetLocation.Z >= GroundLocation.Z || FMath::Abs(ToTargetDirection | ToGroundDirection) <= HomingGroundAngleCosineThreshold))
 		{
-			++ViableCount;
-
 			// ensure alignment always positive and > 0
 			const auto Alignment = (ToTargetDirection | VelocityDirection) + 1.01;
-			auto Score = Dist / FMath::Cube(Alignment);
+			const auto Score = Dist / FMath::Cube(Alignment);
 
-			if (Score < BestTarget.second)
+			OutCandidates.Add(FHomingTargetCandidate
 			{
-				float HitDist;
-				// Make sure truly viable by line of sight tests
-				if (!HasLineOfSightToTarget(CurrentLocation, *PotentialTarget, Dist, HitDist))
-				{
-					// increase the penalty for close distances
-					// Use EaseOut so that the distance ratio is non-linear and increases as we approach the target
-					const auto OcclusionPenaltyExp = FMath::InterpEaseOut(TraceOcclusionMaxExp, TraceOcclusionMinExp, FMath::Clamp(HitDist / Dist, 0.0f, 1.0f), TraceOcclusionEaseFactor);
-					const auto ScoreWithPenalty = FMath::Pow(Score, OcclusionPenaltyExp);
-
-					UE_VLOG_UELOG(this, LogTRItem, VeryVerbose, TEXT("%s: RefreshHomingTarget: Target=%s; No LOS - OcclusionPenaltyExp=%.3f; HitDist=%fm; Dist=%fm; Score=%.1f->%.1f"),
-						*GetName(), *LoggingUtils::GetName(PotentialTarget), OcclusionPenaltyExp, HitDist / 100, Dist / 100, Score, ScoreWithPenalty);
-
-					Score = ScoreWithPenalty;
-				}
-
-				Score += NearbyTargetPenaltyScore(*PotentialTarget);
-
-				if (Score < BestTarget.second)
-				{
-					BestTarget = { PotentialTarget, Score };
-				}
-			}
+				.Target = PotentialTarget,
+				.LineOfSightLocation = TargetInfo.LineOfSightLocation,
+				.Score = Score,
+				.Distance = static_cast<float>(Dist),
+				.Health = TargetInfo.Health
+			});
 
 			UE_VLOG_LOCATION(this, LogTRItem, Verbose, TargetLocation + FVector(0,0,100), 15.0f, FColor::Cyan, TEXT("MissileTargetScore: %.1f"), Score);
-			UE_VLOG_UELOG(this, LogTRItem, Verbose, TEXT("%s: RefreshHomingTarget: Target=%s; Score=%.1f"), *GetName(), *LoggingUtils::GetName(PotentialTarget), Score);
 		}
 	}
 
-	auto NewHomingTarget = BestTarget.first;
+	// Penalties only increase the score so evaluating in order allows skipping line of sight checks for candidates that cannot win
+	OutCandidates.Sort([](const auto& First, const auto& Second)
+	{
+		return First.Score < Second.Score;
+	});
+}
+
+AActor* AProjectile::ScoreHomingTargetCandidates(TArrayView<const FHomingTargetCandidate> Candidates,
+	TFunctionRef<const FHomingLineOfSightResult* (int32 CandidateIndex)> GetLineOfSight) const
+{
+	std::pair<AActor*, double> BestTarget{ nullptr, std::numeric_limits<double>::max() };
+
+	for (int32 i = 0; i < Candidates.Num(); ++i)
+	{
+		const auto& Candidate = Candidates[i];
+		auto Score = Candidate.Score;
+
+		if (Score >= BestTarget.second)
+		{
+			break;
+		}
+
+		auto PotentialTarget = Candidate.Target.Get();
+
+		// Target may have been destroyed while waiting on async traces
+		if (!IsValid(PotentialTarget))
+		{
+			continue;
+		}
+
+		// Make sure truly viable by line of sight tests
+		const auto LineOfSightResult = GetLineOfSight(i);
+		if (!LineOfSightResult)
+		{
+			continue;
+		}
+
+		if (!LineOfSightResult->bLineOfSight)
+		{
+			const auto HitDist = LineOfSightResult->ObstacleDistance;
+			const auto Dist = Candidate.Distance;
+
+			// increase the penalty for close distances
+			// Use EaseOut so that the distance ratio is non-linear and increases as we approach the target
+			const auto OcclusionPenaltyExp = FMath::InterpEaseOut(TraceOcclusionMaxExp, TraceOcclusionMinExp, FMath::Clamp(HitDist / Dist, 0.0f, 1.0f), TraceOcclusionEaseFactor);
+			const auto ScoreWithPenalty = FMath::Pow(Score, OcclusionPenaltyExp);
+
+			UE_VLOG_UELOG(this, LogTRItem, VeryVerbose, TEXT("%s: ScoreHomingTargetCandidates: Target=%s; No LOS - OcclusionPenaltyExp=%.3f; HitDist=%fm; Dist=%fm; Score=%.1f->%.1f"),
+				*GetName(), *LoggingUtils::GetName(PotentialTarget), OcclusionPenaltyExp, HitDist / 100, Dist / 100, Score, ScoreWithPenalty);
+
+			Score = ScoreWithPenalty;
+		}
+
+		Score += NearbyTargetPenaltyScore(*PotentialTarget, Candidate.Health);
+
+		if (Score < BestTarget.second)
+		{
+			BestTarget = { PotentialTarget, Score };
+		}
+
+		UE_VLOG_UELOG(this, LogTRItem, Verbose, TEXT("%s: ScoreHomingTargetCandidates: Target=%s; Score=%.1f"), *GetName(), *LoggingUtils::GetName(PotentialTarget), Score);
+	}
+
+	UE_VLOG_UELOG(this, LogTRItem, Log, TEXT("%s: ScoreHomingTargetCandidates: Selected %s out of %d viable"), *GetName(), *LoggingUtils::GetName(BestTarget.first), Candidates.Num());
+
+	return BestTarget.first;
+}
+
+void AProjectile::SetHomingTarget(AActor* NewHomingTarget)
+{
 	auto PreviousHomingTarget = GetCurrentHomingTargetActor();
 
 	ProjectileMovementComponent->HomingTargetComponent = GetHomingSceneComponent(NewHomingTarget);
@@ -577,12 +814,10 @@ void AProjectile::RefreshHomingTarget()
 	{
 		UE_VLOG_LOCATION(this, LogTRItem, Log, NewHomingTarget->GetActorLocation(), 50.0f, FColor::Yellow, TEXT("%s: Homing Target (%s)"), *GetName(), *NewHomingTarget->GetActorLocation().ToCompactString());
 	}
-
-	UE_VLOG_UELOG(this, LogTRItem, Log, TEXT("%s: RefreshHomingTarget: Selected %s out of %d viable"), *GetName(), *LoggingUtils::GetName(NewHomingTarget), ViableCount);
 }
 
 
-float AProjectile::NearbyTargetPenaltyScore(const AActor& Target) const
+float AProjectile::NearbyTargetPenaltyScore(const AActor& Target, float CurrentHealth) const
 {
 	const auto& UsedTargets = ProjectileHomingParams.UsedTargets;
 
@@ -594,18 +829,6 @@ float AProjectile::NearbyTargetPenaltyScore(const AActor& Target) const
 		return 0.0f;
 	}
 
-	// Get health component indirectly
-	const float CurrentHealth = [&]()
-	{
-		auto HealthComponent = Cast<IPercentage>(Target.FindComponentByTag<UActorComponent>(TR::Tags::HealthComponent));
-		if (!HealthComponent)
-		{
-			return 0.0f;
-		}
-
-		return HealthComponent->GetCurrentValue();
-	}();
-
 	const FRadialDamageParams DamageCalculator(
 		ProjectileDamageParams.MaxDamageAmount,
 		ProjectileDamageParams.MinDamageAmount,
@@ -667,72 +890,81 @@ float AProjectile::NearbyTargetPenaltyScore(const AActor& Target) const
 		*GetName(), *Target.GetName(),
 		Penalty, CurrentHealth);
 
-	return static_cast<decltype(NearbyTargetPenaltyScore(Target))>(Penalty);
+	return static_cast<float>(Penalty);
 }
 
-bool AProjectile::HasLineOfSightToTarget(const FVector& StartLocation, const AActor& Target, float TargetDistance, float& OutObstacleDistance) const
+TOptional<FHomingLineOfSightTraces> AProjectile::GetLineOfSightTraces(const FVector& StartLocation, const FHomingTargetCandidate& Candidate) const
 {
-	auto World = GetWorld();
-	if (!World)
-	{
-		return false;
-	}
-
 	auto MyOwner = GetOwner();
 
 	if (!IsValid(MyOwner))
 	{
-		return false;
+		return {};
 	}
 
-	const auto TargetBounds = TR::CollisionUtils::GetAABB(Target);
-	FVector TargetCenter, TargetExtent;
-	TargetBounds.GetCenterAndExtents(TargetCenter, TargetExtent);
-	const auto TargetLocation = TargetCenter + FVector::ZAxisVector * TargetExtent.Z;
+	const auto& TargetLocation = Candidate.LineOfSightLocation;
+	const auto TargetDistance = Candidate.Distance;
 
 	const auto TraceZOffset = FMath::Min(ViabilityLineTraceMaxZOffset * TargetDistance / ViabilityLineTraceDistScaling, ViabilityLineTraceMaxZOffset);
 
-	FCollisionQueryParams Params;
-	Params.AddIgnoredActor(MyOwner);
+	// Do a line trace offset from left and right of owner to see if we can bend around
+	// Determine radius from lateral distance of angle bisector of central angle with the distance as the radius of the circle
+	const auto LateralOffsetDistance = ViabilityTraceBendFactor * TargetDistance;
+	const auto RightLateralOffset = MyOwner->GetActorRightVector() * LateralOffsetDistance;
+
+	FHomingLineOfSightTraces Traces
+	{
+		.Start = StartLocation + FVector::ZAxisVector * TraceZOffset,
+		.Ends = { TargetLocation, TargetLocation + RightLateralOffset, TargetLocation - RightLateralOffset },
+		.TraceChannel = HomingLOSTraceChannel
+	};
 
-	const auto StartLocationZOffset = StartLocation + FVector::ZAxisVector * TraceZOffset;
+	Traces.Params.AddIgnoredActor(MyOwner);
 
-	FHitResult HitResult;
+	return Traces;
+}
 
-	bool bLOS = !World->LineTraceSingleByChannel(HitResult, StartLocationZOffset, TargetLocation, HomingLOSTraceChannel, Params);
+FHomingLineOfSightResult AProjectile::HasLineOfSightToTarget(const FVector& StartLocation, const FHomingTargetCandidate& Candidate) const
+{
+	FHomingLineOfSightResult Result;
 
-	UE_VLOG_ARROW(this, LogTRItem, Verbose, StartLocationZOffset, TargetLocation, bLOS ? FColor::Green : FColor::Red, TEXT("MissileTrace(D): %s"), *Target.GetName());
+	auto World = GetWorld();
+	if (!World)
+	{
+		return Result;
+	}
 
-	if(bLOS)
+	const auto Traces = GetLineOfSightTraces(StartLocation, Candidate);
+	if (!Traces)
 	{
-		return true;
+		return Result;
 	}
 
-	// Do a line trace offset from left and right of owner to see if we can bend around
-	// Determine radius from lateral distance of angle bisector of central angle with the distance as the radius of the circle
-	const auto LateralOffsetDistance = ViabilityTraceBendFactor * TargetDistance;
-	const auto RightLateralOffset = MyOwner->GetActorRightVector() * LateralOffsetDistance;
+	static constexpr const TCHAR* TraceLabels[] = { TEXT("MissileTrace(D)"), TEXT("MissileTargetTrace(R)"), TEXT("MissileTargetTrace(L)") };
+	static_assert(UE_ARRAY_COUNT(TraceLabels) == FHomingLineOfSightTraces::Num);
 
-	bLOS = !World->LineTraceSingleByChannel(HitResult, StartLocationZOffset, TargetLocation + RightLateralOffset, HomingLOSTraceChannel, Params);
-	UE_VLOG_ARROW(this, LogTRItem, Verbose, StartLocationZOffset, TargetLocation + RightLateralOffset, bLOS ? FColor::Green : FColor::Red, TEXT("MissileTargetTrace(R): %s"), *Target.GetName());
+	FHitResult HitResult;
 
-	if (bLOS)
+	for (int32 i = 0; i < FHomingLineOfSightTraces::Num; ++i)
 	{
-		return true;
-	}
-	
-	bLOS = !World->LineTraceSingleByChannel(HitResult, StartLocationZOffset, TargetLocation - RightLateralOffset, HomingLOSTraceChannel, Params);
-	UE_VLOG_ARROW(this, LogTRItem, Verbose, StartLocationZOffset, TargetLocation - RightLateralOffset, bLOS ? FColor::Green : FColor::Red, TEXT("MissileTargetTrace(L): %s"), *Target.GetName());
+		const auto& TraceEnd = Traces->Ends[i];
 
-	if (bLOS)
-	{
-		return true;
+		++Result.TraceCount;
+		Result.bLineOfSight = !World->LineTraceSingleByChannel(HitResult, Traces->Start, TraceEnd, Traces->TraceChannel, Traces->Params);
+
+		UE_VLOG_ARROW(this, LogTRItem, Verbose, Traces->Start, TraceEnd, Result.bLineOfSight ? FColor::Green : FColor::Red, TEXT("%s: %s"),
+			TraceLabels[i], *LoggingUtils::GetName(Candidate.Target.Get()));
+
+		if (Result.bLineOfSight)
+		{
+			return Result;
+		}
 	}
 
 	// populate distance to the hit
-	OutObstacleDistance = HitResult.Distance;
+	Result.ObstacleDistance = HitResult.Distance;
 
-	return false;
+	return Result;
 }
 
 bool AProjectile::IsHoming() const
@@ -857,19 +1089,36 @@ void AProjectile::GrabDebugSnapshot(FVisualLogEntry* Snapshot) const
 
 void AProjectile::InitDebugDraw()
 {
+	auto World = GetWorld();
+	check(World);
+
 	// Ensure that state logged regularly so we see the updates in the visual logger
-	FTimerDelegate DebugDrawDelegate = FTimerDelegate::CreateLambda([this]()
+	FTimerDelegate DebugDrawDelegate = FTimerDelegate::CreateWeakLambda(this, [this]()
 		{
 			UE_VLOG(this, LogTRItem, Log, TEXT("Get Projectile State"));
 		});
 
-	GetWorldTimerManager().SetTimer(VisualLoggerTimer, DebugDrawDelegate, 0.05f, true);
+	// Coalesced so that all in flight projectiles log together
+	if (auto TimerWheelSubsystem = World->GetSubsystem<UTimerWheelSubsystem>(); ensure(TimerWheelSubsystem))
+	{
+		VisualLoggerTimer = TimerWheelSubsystem->GetTimerWheel().SetTimer(DebugDrawDelegate, 0.05, 0.05, true);
+	}
 }
 
 
 void AProjectile::DestroyDebugDraw()
 {
-	GetWorldTimerManager().ClearTimer(VisualLoggerTimer);
+	auto World = GetWorld();
+	auto TimerWheelSubsystem = World ? World->GetSubsystem<UTimerWheelSubsystem>() : nullptr;
+
+	if (TimerWheelSubsystem)
+	{
+		TimerWheelSubsystem->GetTimerWheel().ClearTimer(VisualLoggerTimer);
+	}
+	else
+	{
+		VisualLoggerTimer.Invalidate();
+	}
 }
 
 #else
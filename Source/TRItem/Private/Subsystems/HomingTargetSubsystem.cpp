@@ -0,0 +1,429 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/HomingTargetSubsystem.h"
+
+#include "Projectile.h"
+
+#include "Utils/CollisionUtils.h"
+#include "Interfaces/Percentage.h"
+#include "TRTags.h"
+
+#include "Debug/TRConsoleVars.h"
+
+#include "Logging/LoggingUtils.h"
+#include "TRItemLogging.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(HomingTargetSubsystem)
+
+DECLARE_CYCLE_STAT(TEXT("HomingTargetSubsystem::Refresh"), STAT_HomingTargetSubsystem_Refresh, STATGROUP_TRItem);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Homing Projectiles Refreshed"), STAT_HomingTargetSubsystem_ProjectilesRefreshed, STATGROUP_TRItem);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Homing LOS Traces Performed"), STAT_HomingTargetSubsystem_TracesPerformed, STATGROUP_TRItem);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Homing LOS Traces Saved"), STAT_HomingTargetSubsystem_TracesSaved, STATGROUP_TRItem);
+
+namespace
+{
+	/* Projectiles of the same salvo are launched close together so their line of sight to a target is effectively the same. */
+	constexpr float LineOfSightShareDistance = 500.0f;
+
+	/* Async results can't be used to skip line of sight checks for candidates that cannot win so bound the number of traces per projectile. */
+	constexpr int32 MaxAsyncLineOfSightCandidates = 4;
+
+	/* Async trace results are delivered on the next frame so a batch still pending after this is abandoned and scored with the results it has. */
+	constexpr uint64 MaxAsyncBatchFrameLatency = 2;
+}
+
+#pragma region FHomingTargetBatchContext
+
+const FHomingTargetInfo& FHomingTargetBatchContext::GetTargetInfo(const AActor& Target)
+{
+	if (auto ExistingInfo = TargetInfos.Find(&Target); ExistingInfo)
+	{
+		return *ExistingInfo;
+	}
+
+	FHomingTargetInfo Info;
+
+	// Health component of the target adds the dead actor tag when killed so it is skipped before it is destroyed
+	Info.bViable = IsValid(&Target) && !Target.ActorHasTag(TR::Tags::Dead);
+
+	if (Info.bViable)
+	{
+		Info.Location = Target.GetActorLocation();
+
+		const auto TargetBounds = TR::CollisionUtils::GetAABB(Target);
+		FVector TargetCenter, TargetExtent;
+		TargetBounds.GetCenterAndExtents(TargetCenter, TargetExtent);
+		Info.LineOfSightLocation = TargetCenter + FVector::ZAxisVector * TargetExtent.Z;
+
+		// Get health component indirectly
+		if (auto HealthComponent = Cast<IPercentage>(Target.FindComponentByTag<UActorComponent>(TR::Tags::HealthComponent)); HealthComponent)
+		{
+			Info.Health = HealthComponent->GetCurrentValue();
+		}
+	}
+
+	return TargetInfos.Add(&Target, Info);
+}
+
+int32 FHomingTargetBatchContext::FindLineOfSight(const AProjectile& Projectile, const AActor& Target, const FVector& StartLocation)
+{
+	auto CachedStarts = LineOfSightStarts.Find(FLineOfSightKey{ Projectile.GetOwner(), Projectile.GetClass(), &Target });
+	if (!CachedStarts)
+	{
+		return INDEX_NONE;
+	}
+
+	const auto ShareDistanceSq = FMath::Square(LineOfSightShareDistance);
+
+	for (const auto& CachedStart : *CachedStarts)
+	{
+		if (FVector::DistSquared(CachedStart.StartLocation, StartLocation) <= ShareDistanceSq)
+		{
+			TracesSaved += LineOfSights[CachedStart.Index].TraceCount;
+			return CachedStart.Index;
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+int32 FHomingTargetBatchContext::AddLineOfSight(const AProjectile& Projectile, const AActor& Target, const FVector& StartLocation, const FHomingLineOfSightResult& Result)
+{
+	const auto Index = LineOfSights.Add(Result);
+
+	LineOfSightStarts.FindOrAdd(FLineOfSightKey{ Projectile.GetOwner(), Projectile.GetClass(), &Target }).Add(FLineOfSightStart
+	{
+		.StartLocation = StartLocation,
+		.Index = Index
+	});
+
+	TracesPerformed += Result.TraceCount;
+
+	return Index;
+}
+
+#pragma endregion FHomingTargetBatchContext
+
+void UHomingTargetSubsystem::RegisterProjectile(AProjectile& Projectile, float RefreshInterval)
+{
+	auto World = GetWorld();
+	check(World);
+
+	UnregisterProjectile(Projectile);
+
+	Projectiles.Add(FRegisteredProjectile
+	{
+		.Projectile = &Projectile,
+		.RefreshInterval = RefreshInterval,
+		.NextRefreshTime = World->GetTimeSeconds()
+	});
+
+	UE_LOG(LogTRItem, Verbose, TEXT("%s: RegisterProjectile: %s - RefreshInterval=%fs; %d projectile%s registered"),
+		*GetName(), *Projectile.GetName(), RefreshInterval, Projectiles.Num(), LoggingUtils::Pluralize(Projectiles.Num()));
+}
+
+void UHomingTargetSubsystem::UnregisterProjectile(AProjectile& Projectile)
+{
+	// Selecting a target broadcasts to the firing weapon which may end up unregistering projectiles so the entry is left for the tick to remove
+	if (bTicking)
+	{
+		for (auto& Entry : Projectiles)
+		{
+			if (Entry.Projectile.Get() == &Projectile)
+			{
+				Entry.Projectile.Reset();
+			}
+		}
+	}
+	else
+	{
+		Projectiles.RemoveAllSwap([&Projectile](const auto& Entry)
+		{
+			return Entry.Projectile.Get() == &Projectile;
+		});
+	}
+
+	// Pooled projectiles are reused without being destroyed so results still in flight must not be applied to the next launch
+	for (auto& [_, Batch] : AsyncBatches)
+	{
+		Batch.Refreshes.RemoveAllSwap([&Projectile](const auto& Refresh)
+		{
+			return Refresh.Projectile.Get() == &Projectile;
+		});
+	}
+}
+
+bool UHomingTargetSubsystem::IsTickable() const
+{
+	return !Projectiles.IsEmpty() || !AsyncBatches.IsEmpty();
+}
+
+void UHomingTargetSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_HomingTargetSubsystem_Refresh);
+
+	Super::Tick(DeltaTime);
+
+	CompleteStaleAsyncBatches();
+
+	auto World = GetWorld();
+	check(World);
+
+	const auto CurrentTimeSeconds = World->GetTimeSeconds();
+	const bool bAsync = ShouldUseAsyncTraces();
+
+	FHomingTargetBatchContext SyncContext;
+
+	FAsyncHomingBatch* AsyncBatch{};
+	uint32 AsyncBatchId{};
+
+	int32 RefreshCount{};
+
+	// Entries are only removed after the loop but projectiles launched while selecting targets are appended so only visit the existing ones
+	{
+		TGuardValue TickingGuard(bTicking, true);
+
+		const auto Count = Projectiles.Num();
+
+		for (int32 i = 0; i < Count; ++i)
+		{
+			auto& Entry = Projectiles[i];
+
+			if (Entry.NextRefreshTime > CurrentTimeSeconds)
+			{
+				continue;
+			}
+
+			Entry.NextRefreshTime = CurrentTimeSeconds + Entry.RefreshInterval;
+
+			auto Projectile = Entry.Projectile.Get();
+			if (!IsValid(Projectile))
+			{
+				continue;
+			}
+
+			++RefreshCount;
+
+			if (!bAsync)
+			{
+				RefreshSync(*Projectile, SyncContext);
+				continue;
+			}
+
+			if (!AsyncBatch)
+			{
+				AsyncBatchId = NextAsyncBatchId++;
+				AsyncBatch = &AsyncBatches.Add(AsyncBatchId);
+				AsyncBatch->IssuedFrame = GFrameCounter;
+			}
+
+			QueueAsyncRefresh(*Projectile, *AsyncBatch, AsyncBatchId);
+		}
+	}
+
+	Projectiles.RemoveAllSwap([](const auto& Entry)
+	{
+		return !Entry.Projectile.IsValid();
+	});
+
+	const auto& StatsContext = AsyncBatch ? AsyncBatch->Context : SyncContext;
+
+	INC_DWORD_STAT_BY(STAT_HomingTargetSubsystem_ProjectilesRefreshed, RefreshCount);
+	INC_DWORD_STAT_BY(STAT_HomingTargetSubsystem_TracesPerformed, StatsContext.GetTracesPerformed());
+	INC_DWORD_STAT_BY(STAT_HomingTargetSubsystem_TracesSaved, StatsContext.GetTracesSaved());
+
+	if (RefreshCount > 0)
+	{
+		UE_LOG(LogTRItem, VeryVerbose, TEXT("%s: Tick - Refreshed %d projectile%s; Async=%s; TracesPerformed=%d; TracesSaved=%d"),
+			*GetName(), RefreshCount, LoggingUtils::Pluralize(RefreshCount), LoggingUtils::GetBoolString(bAsync),
+			StatsContext.GetTracesPerformed(), StatsContext.GetTracesSaved());
+	}
+
+	// Nothing to wait on if all the candidates were shared or filtered out
+	if (AsyncBatch && AsyncBatch->TracesRemaining == 0)
+	{
+		CompleteAsyncBatch(AsyncBatchId);
+	}
+}
+
+void UHomingTargetSubsystem::RefreshSync(AProjectile& Projectile, FHomingTargetBatchContext& Context)
+{
+	TArray<FHomingTargetCandidate> Candidates;
+	Projectile.GatherHomingTargetCandidates(Context, Candidates);
+
+	const auto& StartLocation = Projectile.GetActorLocation();
+
+	auto NewHomingTarget = Projectile.ScoreHomingTargetCandidates(Candidates, [&](int32 CandidateIndex) -> const FHomingLineOfSightResult*
+	{
+		const auto& Candidate = Candidates[CandidateIndex];
+		// Validity of the target is checked before line of sight is requested
+		const auto& Target = *Candidate.Target;
+
+		// Projectiles from the same salvo share the result for the target
+		auto Index = Context.FindLineOfSight(Projectile, Target, StartLocation);
+		if (Index == INDEX_NONE)
+		{
+			Index = Context.AddLineOfSight(Projectile, Target, StartLocation, Projectile.HasLineOfSightToTarget(StartLocation, Candidate));
+		}
+
+		return &Context.GetLineOfSight(Index);
+	});
+
+	Projectile.SetHomingTarget(NewHomingTarget);
+}
+
+void UHomingTargetSubsystem::QueueAsyncRefresh(AProjectile& Projectile, FAsyncHomingBatch& Batch, uint32 BatchId)
+{
+	auto World = GetWorld();
+	check(World);
+
+	auto& Context = Batch.Context;
+
+	FPendingHomingRefresh Refresh
+	{
+		.Projectile = &Projectile
+	};
+
+	Projectile.GatherHomingTargetCandidates(Context, Refresh.Candidates);
+
+	if (Refresh.Candidates.Num() > MaxAsyncLineOfSightCandidates)
+	{
+		Refresh.Candidates.SetNum(MaxAsyncLineOfSightCandidates);
+	}
+
+	const auto& StartLocation = Projectile.GetActorLocation();
+	const auto TraceDelegate = FTraceDelegate::CreateUObject(this, &ThisClass::OnLineOfSightTraceCompleted, BatchId);
+
+	Refresh.LineOfSightIndices.Reserve(Refresh.Candidates.Num());
+
+	for (const auto& Candidate : Refresh.Candidates)
+	{
+		const auto& Target = *Candidate.Target;
+
+		auto Index = Context.FindLineOfSight(Projectile, Target, StartLocation);
+
+		if (Index == INDEX_NONE)
+		{
+			const auto Traces = Projectile.GetLineOfSightTraces(StartLocation, Candidate);
+
+			// All the traces are issued up front since we can't wait on the direct trace result before deciding to try bending around
+			Index = Context.AddLineOfSight(Projectile, Target, StartLocation, FHomingLineOfSightResult
+			{
+				.TraceCount = Traces ? FHomingLineOfSightTraces::Num : 0
+			});
+
+			if (Traces)
+			{
+				for (int32 TraceIndex = 0; TraceIndex < FHomingLineOfSightTraces::Num; ++TraceIndex)
+				{
+					World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Traces->Start, Traces->Ends[TraceIndex], Traces->TraceChannel, Traces->Params,
+						FCollisionResponseParams::DefaultResponseParam, &TraceDelegate, static_cast<uint32>(Index * FHomingLineOfSightTraces::Num + TraceIndex));
+				}
+
+				Batch.TracesRemaining += FHomingLineOfSightTraces::Num;
+			}
+		}
+
+		Refresh.LineOfSightIndices.Add(Index);
+	}
+
+	Batch.Refreshes.Add(MoveTemp(Refresh));
+}
+
+void UHomingTargetSubsystem::OnLineOfSightTraceCompleted(const FTraceHandle& Handle, FTraceDatum& Datum, uint32 BatchId)
+{
+	auto Batch = AsyncBatches.Find(BatchId);
+	if (!Batch)
+	{
+		// Batch was abandoned
+		return;
+	}
+
+	const int32 LineOfSightIndex = Datum.UserData / FHomingLineOfSightTraces::Num;
+	const int32 TraceIndex = Datum.UserData % FHomingLineOfSightTraces::Num;
+
+	auto& Result = Batch->Context.GetLineOfSight(LineOfSightIndex);
+
+	if (const auto BlockingHit = FHitResult::GetFirstBlockingHit(Datum.OutHits); !BlockingHit)
+	{
+		Result.bLineOfSight = true;
+	}
+	else if (TraceIndex == FHomingLineOfSightTraces::ObstacleDistanceTraceIndex)
+	{
+		Result.ObstacleDistance = BlockingHit->Distance;
+	}
+
+	if (--Batch->TracesRemaining <= 0)
+	{
+		CompleteAsyncBatch(BatchId);
+	}
+}
+
+void UHomingTargetSubsystem::CompleteAsyncBatch(uint32 BatchId)
+{
+	auto FoundBatch = AsyncBatches.Find(BatchId);
+	if (!FoundBatch)
+	{
+		return;
+	}
+
+	// Move out of the map as selecting a target can lead to other projectiles being refreshed
+	FAsyncHomingBatch Batch = MoveTemp(*FoundBatch);
+	AsyncBatches.Remove(BatchId);
+
+	for (const auto& Refresh : Batch.Refreshes)
+	{
+		auto Projectile = Refresh.Projectile.Get();
+		if (!IsValid(Projectile))
+		{
+			continue;
+		}
+
+		auto NewHomingTarget = Projectile->ScoreHomingTargetCandidates(Refresh.Candidates, [&](int32 CandidateIndex) -> const FHomingLineOfSightResult*
+		{
+			return &Batch.Context.GetLineOfSight(Refresh.LineOfSightIndices[CandidateIndex]);
+		});
+
+		Projectile->SetHomingTarget(NewHomingTarget);
+	}
+}
+
+void UHomingTargetSubsystem::CompleteStaleAsyncBatches()
+{
+	TArray<uint32, TInlineAllocator<4>> StaleBatchIds;
+
+	for (const auto& [BatchId, Batch] : AsyncBatches)
+	{
+		if (GFrameCounter - Batch.IssuedFrame > MaxAsyncBatchFrameLatency)
+		{
+			StaleBatchIds.Add(BatchId);
+		}
+	}
+
+	for (auto BatchId : StaleBatchIds)
+	{
+		UE_LOG(LogTRItem, Warning, TEXT("%s: CompleteStaleAsyncBatches - Batch %u still waiting on %d trace%s"),
+			*GetName(), BatchId, AsyncBatches[BatchId].TracesRemaining, LoggingUtils::Pluralize(AsyncBatches[BatchId].TracesRemaining));
+
+		CompleteAsyncBatch(BatchId);
+	}
+}
+
+bool UHomingTargetSubsystem::ShouldUseAsyncTraces()
+{
+	return TR::CVarHomingAsyncTraces.GetValueOnGameThread();
+}
+
+TStatId UHomingTargetSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UHomingTargetSubsystem, STATGROUP_Tickables);
+}
+
+void UHomingTargetSubsystem::Deinitialize()
+{
+	Projectiles.Reset();
+	AsyncBatches.Reset();
+
+	Super::Deinitialize();
+}
@@ -0,0 +1,168 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+
+#include <array>
+
+#include "HomingTargetSubsystem.generated.h"
+
+class AProjectile;
+
+/*
+* Target state sampled once per refresh batch and shared by all homing projectiles.
+*/
+struct FHomingTargetInfo
+{
+	FVector Location{ EForceInit::ForceInitToZero };
+
+	/* Top center of the target AABB used as the end point of line of sight traces. */
+	FVector LineOfSightLocation{ EForceInit::ForceInitToZero };
+
+	float Health{};
+	bool bViable{};
+};
+
+/*
+* Target that passed the distance and alignment filters of a projectile along with its score before line of sight and nearby target penalties.
+*/
+struct FHomingTargetCandidate
+{
+	TWeakObjectPtr<AActor> Target{};
+	FVector LineOfSightLocation{ EForceInit::ForceInitToZero };
+	double Score{};
+	float Distance{};
+	float Health{};
+};
+
+/*
+* Line of sight traces are done in order until one is unobstructed: direct, bend right and then bend left.
+*/
+struct FHomingLineOfSightTraces
+{
+	static constexpr int32 Num = 3;
+	static constexpr int32 ObstacleDistanceTraceIndex = Num - 1;
+
+	FVector Start{ EForceInit::ForceInitToZero };
+	std::array<FVector, Num> Ends{};
+	ECollisionChannel TraceChannel{};
+	FCollisionQueryParams Params{};
+};
+
+struct FHomingLineOfSightResult
+{
+	float ObstacleDistance{};
+	int32 TraceCount{};
+	bool bLineOfSight{};
+};
+
+/*
+* Cache for a single homing refresh batch.
+*/
+class FHomingTargetBatchContext
+{
+public:
+	const FHomingTargetInfo& GetTargetInfo(const AActor& Target);
+
+	/*
+	* Returns the index of a line of sight result for a projectile of the same class fired by the same owner
+	* from a nearby location to the given target or INDEX_NONE if one hasn't been added yet this batch.
+	*/
+	int32 FindLineOfSight(const AProjectile& Projectile, const AActor& Target, const FVector& StartLocation);
+
+	int32 AddLineOfSight(const AProjectile& Projectile, const AActor& Target, const FVector& StartLocation, const FHomingLineOfSightResult& Result);
+
+	FHomingLineOfSightResult& GetLineOfSight(int32 Index) { return LineOfSights[Index]; }
+	const FHomingLineOfSightResult& GetLineOfSight(int32 Index) const { return LineOfSights[Index]; }
+
+	int32 GetTracesPerformed() const { return TracesPerformed; }
+	int32 GetTracesSaved() const { return TracesSaved; }
+
+private:
+	using FLineOfSightKey = TTuple<const AActor* /* Owner */, const UClass* /* ProjectileClass */, const AActor* /* Target */>;
+
+	struct FLineOfSightStart
+	{
+		FVector StartLocation;
+		int32 Index;
+	};
+
+	TMap<const AActor*, FHomingTargetInfo> TargetInfos{};
+	TMap<FLineOfSightKey, TArray<FLineOfSightStart, TInlineAllocator<4>>> LineOfSightStarts{};
+	TArray<FHomingLineOfSightResult> LineOfSights{};
+
+	int32 TracesPerformed{};
+	int32 TracesSaved{};
+};
+
+/**
+ * Refreshes the targets of all active homing projectiles together so that target state and line of sight traces
+ * are computed once per frame and shared between missiles instead of each projectile running its own timer.
+ *
+ * When async traces are enabled with <c>tr.item.homing.asyncTraces</c> the line of sight traces are queued with the async trace API
+ * and the targets are selected in the trace completion callback on the next frame.
+ */
+UCLASS()
+class UHomingTargetSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/*
+	* Registers the projectile for target refreshes every <c>RefreshInterval</c> seconds. The first refresh happens on the next subsystem tick.
+	*/
+	void RegisterProjectile(AProjectile& Projectile, float RefreshInterval);
+	void UnregisterProjectile(AProjectile& Projectile);
+
+protected:
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+
+	virtual TStatId GetStatId() const override;
+
+	virtual void Deinitialize() override;
+
+private:
+	struct FRegisteredProjectile
+	{
+		TWeakObjectPtr<AProjectile> Projectile;
+		float RefreshInterval;
+		float NextRefreshTime;
+	};
+
+	struct FPendingHomingRefresh
+	{
+		TWeakObjectPtr<AProjectile> Projectile;
+		TArray<FHomingTargetCandidate> Candidates;
+		TArray<int32> LineOfSightIndices;
+	};
+
+	struct FAsyncHomingBatch
+	{
+		FHomingTargetBatchContext Context;
+		TArray<FPendingHomingRefresh> Refreshes;
+		int32 TracesRemaining{};
+		uint64 IssuedFrame{};
+	};
+
+	void RefreshSync(AProjectile& Projectile, FHomingTargetBatchContext& Context);
+	void QueueAsyncRefresh(AProjectile& Projectile, FAsyncHomingBatch& Batch, uint32 BatchId);
+
+	void OnLineOfSightTraceCompleted(const FTraceHandle& Handle, FTraceDatum& Datum, uint32 BatchId);
+	void CompleteAsyncBatch(uint32 BatchId);
+	void CompleteStaleAsyncBatches();
+
+	static bool ShouldUseAsyncTraces();
+
+private:
+	TArray<FRegisteredProjectile> Projectiles{};
+
+	TMap<uint32, FAsyncHomingBatch> AsyncBatches{};
+	uint32 NextAsyncBatchId{};
+
+	/* Set while refreshing so that unregistering does not remove entries from under the loop. */
+	bool bTicking{};
+};
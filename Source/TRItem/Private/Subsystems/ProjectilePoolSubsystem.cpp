@@ -0,0 +1,163 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/ProjectilePoolSubsystem.h"
+
+#include "Projectile.h"
+
+#include "Debug/TRConsoleVars.h"
+
+#include "Logging/LoggingUtils.h"
+#include "TRItemLogging.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(ProjectilePoolSubsystem)
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Projectile Pool Hits"), STAT_ProjectilePoolSubsystem_Hits, STATGROUP_TRItem);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Projectile Pool Misses"), STAT_ProjectilePoolSubsystem_Misses, STATGROUP_TRItem);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Projectile Pool Available"), STAT_ProjectilePoolSubsystem_Available, STATGROUP_TRItem);
+
+namespace
+{
+	/* Pooled projectiles are parked out of the way of gameplay while inactive. */
+	const FTransform PooledProjectileTransform{ FVector{ 0.0, 0.0, -100000.0 } };
+}
+
+void UProjectilePoolSubsystem::Prewarm(TSubclassOf<AProjectile> ProjectileClass, int32 Count)
+{
+	if (!ensure(ProjectileClass))
+	{
+		return;
+	}
+
+	const auto PrewarmBudget = TR::CVarProjectilePoolPrewarmBudget.GetValueOnGameThread();
+	auto& SpawnedCount = SpawnedCounts.FindOrAdd(ProjectileClass);
+
+	const auto ToSpawnCount = FMath::Min(Count - SpawnedCount, PrewarmBudget - PrewarmedCount);
+	if (ToSpawnCount <= 0)
+	{
+		return;
+	}
+
+	auto& Pool = Pools.FindOrAdd(ProjectileClass);
+	Pool.Available.Reserve(Pool.Available.Num() + ToSpawnCount);
+
+	for (int32 i = 0; i < ToSpawnCount; ++i)
+	{
+		auto Projectile = SpawnProjectile(ProjectileClass, PooledProjectileTransform, nullptr, nullptr);
+		if (!Projectile)
+		{
+			break;
+		}
+
+		Projectile->FinishSpawning(PooledProjectileTransform);
+		ReleaseProjectile(*Projectile);
+
+		++PrewarmedCount;
+	}
+
+	UE_LOG(LogTRItem, Log, TEXT("%s: Prewarm: %s - %d available; PrewarmedCount=%d/%d"),
+		*GetName(), *LoggingUtils::GetName(ProjectileClass), Pool.Available.Num(), PrewarmedCount, PrewarmBudget);
+}
+
+AProjectile* UProjectilePoolSubsystem::AcquireProjectile(TSubclassOf<AProjectile> ProjectileClass, const FTransform& Transform, AActor* Owner, APawn* Instigator)
+{
+	if (!ensure(ProjectileClass))
+	{
+		return nullptr;
+	}
+
+	if (auto Pool = Pools.Find(ProjectileClass); Pool)
+	{
+		while (!Pool->Available.IsEmpty())
+		{
+			auto Projectile = Pool->Available.Pop(false);
+			DEC_DWORD_STAT(STAT_ProjectilePoolSubsystem_Available);
+
+			// Pooled actors can still be destroyed externally, e.g. when streaming out a level
+			if (!IsValid(Projectile))
+			{
+				--SpawnedCounts.FindOrAdd(ProjectileClass);
+				continue;
+			}
+
+			Projectile->PrepareForReuse(Owner, Instigator, Transform);
+
+			++HitCount;
+			INC_DWORD_STAT(STAT_ProjectilePoolSubsystem_Hits);
+
+			return Projectile;
+		}
+	}
+
+	++MissCount;
+	INC_DWORD_STAT(STAT_ProjectilePoolSubsystem_Misses);
+
+	UE_LOG(LogTRItem, Verbose, TEXT("%s: AcquireProjectile: %s - Pool empty, spawning new projectile; HitCount=%d; MissCount=%d"),
+		*GetName(), *LoggingUtils::GetName(ProjectileClass), HitCount, MissCount);
+
+	return SpawnProjectile(ProjectileClass, Transform, Owner, Instigator);
+}
+
+void UProjectilePoolSubsystem::ActivateProjectile(AProjectile& Projectile, const FTransform& Transform)
+{
+	// Newly spawned projectiles are still deferred
+	if (!Projectile.IsActorInitialized())
+	{
+		Projectile.FinishSpawning(Transform);
+	}
+	else
+	{
+		Projectile.SetProjectileActive(true);
+	}
+}
+
+void UProjectilePoolSubsystem::ReleaseProjectile(AProjectile& Projectile)
+{
+	if (!ensureMsgf(Projectile.bPooled, TEXT("%s: ReleaseProjectile: %s was not spawned by the pool"), *GetName(), *Projectile.GetName()))
+	{
+		Projectile.Destroy();
+		return;
+	}
+
+	Projectile.ResetForPool();
+
+	Pools.FindOrAdd(Projectile.GetClass()).Available.Add(&Projectile);
+	INC_DWORD_STAT(STAT_ProjectilePoolSubsystem_Available);
+}
+
+AProjectile* UProjectilePoolSubsystem::SpawnProjectile(TSubclassOf<AProjectile> ProjectileClass, const FTransform& Transform, AActor* Owner, APawn* Instigator)
+{
+	auto World = GetWorld();
+	check(World);
+
+	auto Projectile = World->SpawnActorDeferred<AProjectile>(ProjectileClass, Transform, Owner, Instigator);
+	if (!Projectile)
+	{
+		UE_LOG(LogTRItem, Warning, TEXT("%s: SpawnProjectile: Unable to spawn projectile %s"), *GetName(), *LoggingUtils::GetName(ProjectileClass));
+		return nullptr;
+	}
+
+	Projectile->bPooled = true;
+	++SpawnedCounts.FindOrAdd(ProjectileClass);
+
+	return Projectile;
+}
+
+void UProjectilePoolSubsystem::Deinitialize()
+{
+	int32 AvailableCount{};
+	for (const auto& [_, Pool] : Pools)
+	{
+		AvailableCount += Pool.Available.Num();
+	}
+
+	DEC_DWORD_STAT_BY(STAT_ProjectilePoolSubsystem_Available, AvailableCount);
+
+	UE_LOG(LogTRItem, Log, TEXT("%s: Deinitialize: HitCount=%d; MissCount=%d; PrewarmedCount=%d; AvailableCount=%d"),
+		*GetName(), HitCount, MissCount, PrewarmedCount, AvailableCount);
+
+	Pools.Reset();
+	SpawnedCounts.Reset();
+
+	Super::Deinitialize();
+}
@@ -0,0 +1,64 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "ProjectilePoolSubsystem.generated.h"
+
+class AProjectile;
+
+USTRUCT()
+struct FProjectilePool
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<AProjectile>> Available{};
+};
+
+/**
+ * Reuses projectile actors of each class in the level so that firing does not spawn and destroy an actor for every shot.
+ * Projectiles are returned to the pool when they hit something or their lifetime expires and are deactivated rather than destroyed.
+ *
+ * Acquiring a projectile is done in two steps to mirror deferred spawning: <c>AcquireProjectile</c> returns an inactive projectile
+ * that can be initialized and then <c>ActivateProjectile</c> finishes spawning it or reactivates it if it was reused.
+ */
+UCLASS()
+class UProjectilePoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/*
+	* Spawns inactive projectiles of <c>ProjectileClass</c> until at least <c>Count</c> exist in the pool,
+	* limited by the remaining pre-warm budget of the level set with <c>tr.item.projectilePool.prewarmBudget</c>.
+	*/
+	void Prewarm(TSubclassOf<AProjectile> ProjectileClass, int32 Count);
+
+	AProjectile* AcquireProjectile(TSubclassOf<AProjectile> ProjectileClass, const FTransform& Transform, AActor* Owner, APawn* Instigator);
+	void ActivateProjectile(AProjectile& Projectile, const FTransform& Transform);
+
+	void ReleaseProjectile(AProjectile& Projectile);
+
+	int32 GetHitCount() const { return HitCount; }
+	int32 GetMissCount() const { return MissCount; }
+
+protected:
+	virtual void Deinitialize() override;
+
+private:
+	AProjectile* SpawnProjectile(TSubclassOf<AProjectile> ProjectileClass, const FTransform& Transform, AActor* Owner, APawn* Instigator);
+
+private:
+	UPROPERTY(Transient)
+	TMap<TSubclassOf<AProjectile>, FProjectilePool> Pools{};
+
+	/* Total number of projectiles spawned for each class whether currently active or in the pool. */
+	TMap<TSubclassOf<AProjectile>, int32> SpawnedCounts{};
+
+	int32 PrewarmedCount{};
+	int32 HitCount{};
+	int32 MissCount{};
+};
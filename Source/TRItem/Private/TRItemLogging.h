@@ -11,3 +11,6 @@
 #else
 	DECLARE_LOG_CATEGORY_EXTERN(LogTRItem, Display, All);
 #endif
+
+// Stat groups
+DECLARE_STATS_GROUP(TEXT("TRItem"), STATGROUP_TRItem, STATCAT_Advanced);
@@ -5,6 +5,9 @@
 #include "CoreMinimal.h"
 #include "Item/Weapon.h"
 #include "GameplayTagContainer.h"
+#include "UObject/ObjectKey.h"
+
+#include "Containers/IndexedMinHeap.h"
 
 #include "EMPWeapon.generated.h"
 
@@ -21,8 +24,6 @@ struct FEMPAffectedActorData
 
 	UPROPERTY(Transient)
 	UNiagaraComponent* Vfx{};
-
-	float EndGameTimeSeconds{};
 };
 
 /**
@@ -42,10 +43,15 @@ protected:
 private:
 	void CheckRemoveStunTag();
 	void ScheduleStunRemoval(float DeltaTime);
+	void ScheduleNextStunRemoval(float CurrentTimeSeconds);
 
 	void PlayActivationVfx();
+	void SetActivationVfxParameters(UNiagaraComponent& NiagaraComponent, const FVector& WorldVelocity) const;
 
-	void ApplyEffectToEnemy(AActor* Enemy, float EffectEndGameTimeSeconds, const FGameplayTagContainer& DebuffTagsContainer);
+	/*
+	* Returns false if the enemy was already stunned and only had its stun extended.
+	*/
+	bool ApplyEffectToEnemy(AActor& Enemy, UAbilitySystemComponent& ASC, float EffectEndGameTimeSeconds, const FGameplayTagContainer& DebuffTagsContainer);
 
 	UNiagaraComponent* PlayAffectedEnemyVfx(AActor* Enemy);
 
@@ -62,6 +68,9 @@ private:
 	UPROPERTY(Transient)
 	TMap<UAbilitySystemComponent*, FEMPAffectedActorData> AffectedActors;
 
+	/* Stun end game time of each entry in <c>AffectedActors</c> so the next expiry is found without scanning them. */
+	TR::TIndexedMinHeap<TObjectKey<UAbilitySystemComponent>, float> StunExpiries;
+
 	UPROPERTY(EditDefaultsOnly, Category = "Effect")
 	TArray<FGameplayTag> DebuffTags;
 
@@ -9,6 +9,7 @@
 class USoundBase;
 class UAudioComponent;
 struct FGameplayTagContainer;
+enum class ESfxCategory : uint8;
 
 UENUM(BlueprintType)
 enum class EItemType : uint8
@@ -129,6 +130,12 @@ protected:
 	UFUNCTION(BlueprintCallable, BlueprintPure = false, Category = "Audio")
 	UAudioComponent* PlaySfxAttached(USoundBase* Sound) const;
 
+	/*
+	* One-shot sfx that are merged with the same sfx nearby and budgeted at the end of the frame. Use the <c>PlaySfx</c> functions when the audio component is needed.
+	*/
+	void QueueSfxAtActorLocation(USoundBase* Sound, ESfxCategory Category) const;
+	void QueueSfxAttached(USoundBase* Sound, ESfxCategory Category) const;
+
 
 private:
 	void RegisterCooldownTimer();
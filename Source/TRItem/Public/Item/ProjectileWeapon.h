@@ -26,6 +26,7 @@ public:
 protected:
 
 	virtual bool DoActivation(USceneComponent& ActivationReferenceComponent, const FName& ActivationSocketName) override;
+	virtual void NativeInitialize(const FItemConfigData& ItemConfigData) override;
 	virtual void BeginDestroy() override;
 
 private:
@@ -35,8 +36,7 @@ private:
 
 	TSubclassOf<AProjectile> ChooseProjectileClass() const;
 
-	UFUNCTION()
-	void OnProjectileDestroyed(AActor* Actor);
+	void OnProjectileFinished(AProjectile* FinishedProjectile);
 
 	void OnHomingTargetSelected(AProjectile* Projectile, AActor* Target);
 
@@ -126,6 +126,12 @@ private:
 	UPROPERTY(Category = "Firing", EditDefaultsOnly)
 	float ProjectileLaunchPeriod{ 0.2f };
 
+	/*
+	* Number of projectiles spawned into the projectile pool when the weapon is added so that the first shots don't need to spawn actors.
+	*/
+	UPROPERTY(Category = "Firing", EditDefaultsOnly, meta = (ClampMin = "0"))
+	int32 ProjectilePoolPrewarmCount{ 2 };
+
 	/*
 	* Prevent concurrent firing if multiple projectiles in process of being launched
 	*/
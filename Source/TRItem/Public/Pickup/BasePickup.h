@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "Containers/TimerWheel.h"
 #include "BasePickup.generated.h"
 
 class UGameplayEffect;
@@ -13,6 +14,8 @@ UCLASS(Abstract)
 class TRITEM_API ABasePickup : public AActor
 {
 	GENERATED_BODY()
+
+	friend class UPickupPoolSubsystem;
 	
 public:	
 	ABasePickup();
@@ -23,8 +26,11 @@ public:
 	UFUNCTION(BlueprintPure)
 	bool IsMarkedForDestroy() const;
 
+	bool IsPoolable() const;
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void LifeSpanExpired() override;
 
 	UFUNCTION(BlueprintCallable)
 	virtual void ApplyEffectToTarget(AActor* Target, TSubclassOf<UGameplayEffect> GameplayEffectClass);
@@ -43,6 +49,12 @@ protected:
 	UFUNCTION(BlueprintImplementableEvent, meta=(DisplayName = "OnOverlap"))
 	void ReceiveOnOverlap(APawn* PlayerPawn);
 
+	/*
+	* Called when a pooled pickup is reused instead of BeginPlay. Reset any state initialized in BeginPlay here.
+	*/
+	UFUNCTION(BlueprintImplementableEvent, meta = (DisplayName = "OnReusedFromPool"))
+	void ReceiveOnReusedFromPool();
+
 	/*
 	* Indicate that this actor should be destroyed once the current frame's processing is complete.
 	*/
@@ -57,10 +69,23 @@ private:
 
 	void SetLifetimeIfApplicable();
 
+	void ReleaseOrDestroy();
+
+	void PrepareForReuse(AActor* NewOwner, APawn* NewInstigator, const FTransform& Transform);
+	void ResetForPool();
+	void SetPickupActive(bool bActive);
+
 protected:
 	UPROPERTY(EditDefaultsOnly, Category = "Applied Effects")
 	TSubclassOf<UGameplayEffect> InstantGameplayEffectClass;
 
+	/*
+	* Reuse actors of this class from the pickup pool instead of spawning and destroying them.
+	* Only enable for Blueprint pickups that reset their BeginPlay state in OnReusedFromPool.
+	*/
+	UPROPERTY(EditDefaultsOnly, Category = "Pooling")
+	bool bPoolable{};
+
 private:
 
 	/* How long the pickup persists after spawning.  Set to a value > 0, to limit the lifetime for spawned pickups.
@@ -74,7 +99,12 @@ private:
 	UPROPERTY(EditDefaultsOnly, Category = "Sound")
 	TObjectPtr<USoundBase> PickupSfx{};
 
+	TR::FTimerWheelHandle PendingReleaseTimer{};
+
 	bool bMarkedForDestroy{};
+
+	/* Spawned by the pickup pool and returned to it instead of being destroyed. */
+	bool bPooled{};
 };
 
 #pragma region Inline Definitions
@@ -88,4 +118,9 @@ inline bool ABasePickup::IsMarkedForDestroy() const
 {
 	return bMarkedForDestroy;
 }
+
+inline bool ABasePickup::IsPoolable() const
+{
+	return bPoolable;
+}
 #pragma endregion Inline Definitions
@@ -0,0 +1,84 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "PickupPoolSubsystem.generated.h"
+
+class ABasePickup;
+
+USTRUCT()
+struct FPickupPool
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<ABasePickup>> Available{};
+};
+
+struct FGroundedPickupSpawn
+{
+	TSubclassOf<ABasePickup> PickupClass{};
+
+	/* Location above the ground to place the pickup. The pickup spawn offset is applied after snapping to the ground below. */
+	FVector Location{ EForceInit::ForceInitToZero };
+
+	TWeakObjectPtr<AActor> Owner{};
+	TWeakObjectPtr<APawn> Instigator{};
+};
+
+/**
+ * Reuses pickup actors of each poolable class in the level so that bursts of kills do not spawn and destroy an actor for every pickup.
+ * Pickups are returned to the pool when collected or their lifetime expires and have their collision and visibility disabled rather than being destroyed.
+ * Classes that are not poolable are spawned and destroyed as usual so all pickups can be spawned through the pool.
+ *
+ * Grounded spawns queued during a frame are deferred to the end of the frame. Each is still snapped to the ground with its own synchronous trace
+ * so that the pickup appears on the same frame.
+ */
+UCLASS()
+class TRITEM_API UPickupPoolSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	ABasePickup* AcquirePickup(TSubclassOf<ABasePickup> PickupClass, const FTransform& Transform, AActor* Owner, APawn* Instigator);
+
+	void ReleasePickup(ABasePickup& Pickup);
+
+	/*
+	* Queues a pickup to be placed on the ground at the end of the frame.
+	*/
+	void QueueGroundedSpawn(const FGroundedPickupSpawn& Spawn);
+
+	/*
+	* Places all queued grounded spawns now. Returns the number of pickups spawned.
+	*/
+	int32 FlushQueuedSpawns();
+
+	int32 GetHitCount() const { return HitCount; }
+	int32 GetMissCount() const { return MissCount; }
+
+protected:
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+
+	virtual TStatId GetStatId() const override;
+
+	virtual void Deinitialize() override;
+
+private:
+	ABasePickup* SpawnPickup(TSubclassOf<ABasePickup> PickupClass, const FTransform& Transform, AActor* Owner, APawn* Instigator);
+
+	FVector GetGroundLocation(const FVector& Location, float OffsetZ) const;
+
+private:
+	UPROPERTY(Transient)
+	TMap<TSubclassOf<ABasePickup>, FPickupPool> Pools{};
+
+	TArray<FGroundedPickupSpawn> QueuedSpawns{};
+
+	int32 HitCount{};
+	int32 MissCount{};
+};
@@ -4,8 +4,10 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "Containers/ArrayView.h"
 
 #include "Item/WeaponConfig.h"
+#include "Containers/TimerWheel.h"
 #include "VisualLogger/VisualLoggerDebugSnapshotInterface.h"
 
 #include <optional>
@@ -21,13 +23,21 @@ class USoundBase;
 class UAudioComponent;
 class UPhysicalMaterial;
 class UWeapon;
+class FHomingTargetBatchContext;
+struct FHomingTargetCandidate;
+struct FHomingLineOfSightTraces;
+struct FHomingLineOfSightResult;
 
 DECLARE_MULTICAST_DELEGATE_TwoParams(FOnHomingTargetSelected, AProjectile* /* Projectile*/, AActor* /*Target*/);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnProjectileFinished, AProjectile* /* Projectile*/);
 
 UCLASS()
 class TRITEM_API AProjectile : public AActor, public IVisualLoggerDebugSnapshotInterface
 {
 	GENERATED_BODY()
+
+	friend class UHomingTargetSubsystem;
+	friend class UProjectilePoolSubsystem;
 	
 public:	
 	AProjectile();
@@ -47,6 +57,12 @@ public:
 
 	FOnHomingTargetSelected OnHomingTargetSelected{};
 
+	/*
+	* Broadcast once the projectile has hit something or its lifetime expired, before it is returned to the projectile pool or destroyed.
+	* All bindings are removed afterwards as the projectile may be reused by another weapon.
+	*/
+	FOnProjectileFinished OnFinished{};
+
 	void AddAvailableHomingTarget(AActor* Actor);
 	void RemoveAvailableHomingTarget(AActor* Actor);
 	void TargetDestroyed(AActor* Actor);
@@ -60,13 +76,11 @@ protected:
 	virtual void PostInitializeComponents() override;
 	virtual void BeginPlay() override;
 	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
+	virtual void LifeSpanExpired() override;
 
 	UFUNCTION(BlueprintNativeEvent)
 	void SetNiagaraFireEffectParameters(UNiagaraComponent* NiagaraComponent);
 
-	UFUNCTION(BlueprintNativeEvent)
-	void SetNiagaraHitEffectParameters(UNiagaraComponent* NiagaraComponent);
-
 	virtual void ApplyPostHitEffects(const FHitResult& HitInfo, const FProjectileDamageParams& DamageParams) {}
 
 private:
@@ -96,15 +110,37 @@ private:
 
 	bool ApplyDamageTo(AActor* OtherActor, const FHitResult& Hit, APawn* InstigatingPawn);
 
-	UFUNCTION()
-	void RefreshHomingTarget();
+	/*
+	* Filters the available homing targets using the state cached in the shared batch context and returns them sorted by their score before penalties.
+	*/
+	void GatherHomingTargetCandidates(FHomingTargetBatchContext& Context, TArray<FHomingTargetCandidate>& OutCandidates) const;
+
+	/*
+	* Applies the line of sight and nearby target penalties to the sorted candidates and returns the best one.
+	* <c>GetLineOfSight</c> is only called for candidates that could still beat the current best and may return nullptr to skip the candidate.
+	*/
+	AActor* ScoreHomingTargetCandidates(TArrayView<const FHomingTargetCandidate> Candidates,
+		TFunctionRef<const FHomingLineOfSightResult* (int32 CandidateIndex)> GetLineOfSight) const;
+
+	void SetHomingTarget(AActor* NewHomingTarget);
 
 	void InitHomingInfo(const FProjectileHomingParams& InProjectileHomingParams);
 	static USceneComponent* GetHomingSceneComponent(AActor* Actor);
 
 	void MarkForDestroy();
+	void ReleaseOrDestroy();
+	void Finish();
 
-	bool HasLineOfSightToTarget(const FVector& StartLocation, const AActor& Target, float TargetDistance, float& OutObstacleDistance) const;
+	/*
+	* Resets the projectile to the state of a new spawn when it is acquired again from the projectile pool.
+	*/
+	void PrepareForReuse(AActor* NewOwner, APawn* NewInstigator, const FTransform& Transform);
+	void ResetForPool();
+	void SetProjectileActive(bool bActive);
+	void IgnoreOwnerWhenMoving();
+
+	TOptional<FHomingLineOfSightTraces> GetLineOfSightTraces(const FVector& StartLocation, const FHomingTargetCandidate& Candidate) const;
+	FHomingLineOfSightResult HasLineOfSightToTarget(const FVector& StartLocation, const FHomingTargetCandidate& Candidate) const;
 
 	bool IsHoming() const;
 
@@ -112,7 +148,7 @@ private:
 	USoundBase* GetHitSound(AActor* HitActor, UPrimitiveComponent* HitComponent, const FHitResult& Hit) const;
 	bool IsPlayer(AActor* Actor) const;
 
-	float NearbyTargetPenaltyScore(const AActor& Target) const;
+	float NearbyTargetPenaltyScore(const AActor& Target, float CurrentHealth) const;
 
 protected:
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = "true"))
@@ -222,9 +258,11 @@ private:
 	FVector InitialDirection{ EForceInit::ForceInitToZero };
 
 #if ENABLE_VISUAL_LOG
-	FTimerHandle VisualLoggerTimer{};
+	TR::FTimerWheelHandle VisualLoggerTimer{};
 #endif
 
+	TR::FTimerWheelHandle PendingReleaseTimer{};
+
 	/*
 	* Indicates whether the tank that fired the weapon can be damaged by it.
 	*/
@@ -237,12 +275,14 @@ private:
 	UPROPERTY(Transient)
 	TObjectPtr<UWeapon> FiredFrom{};
 
-	FTimerHandle HomingTargetTimerHandle{};
-
 	UPROPERTY(Category = "Damage", EditDefaultsOnly)
 	bool bCanDamageInstigator{ false };
 
 	bool bMarkedForDestroy{};
+	bool bFinished{};
+
+	/* Spawned by the projectile pool and returned to it instead of being destroyed. */
+	bool bPooled{};
 };
 
 #pragma region Inline Definitions
@@ -10,6 +10,7 @@ class AXPToken;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnXPTokenOverlap, AXPToken*, Token, APawn*, PlayerPawn);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnXPLevelUp, int32, NewLevel);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnXPChanged, int32, TotalXP, int32, Level, float, LevelPercent);
 
 /**
  * 
@@ -25,4 +26,8 @@ public:
 
 	UPROPERTY(Category = "Notification", Transient, BlueprintAssignable)
 	FOnXPLevelUp OnXPLevelUp;
+
+	/* Fired whenever the total xp changes and once when the game state is initialized. */
+	UPROPERTY(Category = "Notification", Transient, BlueprintAssignable)
+	FOnXPChanged OnXPChanged;
 };
@@ -0,0 +1,359 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "InputRecording.h"
+
+#include "Pawn/BaseTankPawn.h"
+#include "EngineUtils.h"
+
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#include "Utils/RandUtils.h"
+
+#include "TRConstants.h"
+#include "TRPlayerLogging.h"
+
+#if TR_DEBUG_ENABLED
+	#include "HAL/IConsoleManager.h"
+#endif
+
+namespace
+{
+	/* Location quantum in cm. */
+	constexpr double LocationQuantum = 0.01;
+
+	/* Quaternion component quantum, about 0.006 degrees. */
+	constexpr double RotationQuantum = 0.00005;
+}
+
+namespace TR
+{
+	FArchive& operator<<(FArchive& Ar, FInputRecordingFrame& Frame)
+	{
+		Ar << Frame.Flags;
+
+		// Only what was used in the frame so that idle frames cost a byte
+		if (EnumHasAnyFlags(Frame.Flags, EInputRecordingFlags::Move))
+		{
+			Ar << Frame.MoveValue;
+		}
+		if (EnumHasAnyFlags(Frame.Flags, EInputRecordingFlags::Look))
+		{
+			Ar << Frame.LookValue;
+		}
+		if (EnumHasAnyFlags(Frame.Flags, EInputRecordingFlags::Aim))
+		{
+			Ar << Frame.AimOrigin;
+			Ar << Frame.AimDirection;
+		}
+
+		Ar << Frame.SelectWeaponIndex;
+		Ar << Frame.WeaponScroll;
+
+		return Ar;
+	}
+
+	FArchive& operator<<(FArchive& Ar, FInputRecordingChecksum& Checksum)
+	{
+		Ar << Checksum.Frame;
+		Ar << Checksum.Checksum;
+
+		return Ar;
+	}
+
+	bool FInputRecording::SaveToFile(const FString& Path) const
+	{
+		TArray<uint8> Data;
+		if (!SaveToMemory(Data))
+		{
+			return false;
+		}
+
+		if (!FFileHelper::SaveArrayToFile(Data, *Path))
+		{
+			UE_LOG(LogTRPlayer, Error, TEXT("FInputRecording: Unable to write %s"), *Path);
+			return false;
+		}
+
+		UE_LOG(LogTRPlayer, Display, TEXT("FInputRecording: Saved %s - Frames=%d; Checksums=%d; Seed=%u; FixedDeltaSeconds=%f; Size=%dKB"),
+			*Path, Frames.Num(), Checksums.Num(), Seed, FixedDeltaSeconds, Data.Num() / 1024);
+
+		return true;
+	}
+
+	bool FInputRecording::LoadFromFile(const FString& Path, FInputRecording& OutRecording, FString* OutError)
+	{
+		TArray<uint8> Data;
+		if (!FFileHelper::LoadFileToArray(Data, *Path))
+		{
+			if (OutError)
+			{
+				*OutError = FString::Printf(TEXT("Unable to read %s"), *Path);
+			}
+			return false;
+		}
+
+		return LoadFromMemory(Data, OutRecording, OutError);
+	}
+
+	bool FInputRecording::SaveToMemory(TArray<uint8>& OutData) const
+	{
+		FMemoryWriter Writer(OutData);
+
+		auto Copy = *this;
+		return Serialize(Writer, Copy, nullptr);
+	}
+
+	bool FInputRecording::LoadFromMemory(const TArray<uint8>& Data, FInputRecording& OutRecording, FString* OutError)
+	{
+		FMemoryReader Reader(Data);
+
+		OutRecording = {};
+		return Serialize(Reader, OutRecording, OutError);
+	}
+
+	bool FInputRecording::Serialize(FArchive& Ar, FInputRecording& Recording, FString* OutError)
+	{
+		auto Fail = [OutError](const FString& Error)
+		{
+			if (OutError)
+			{
+				*OutError = Error;
+			}
+			return false;
+		};
+
+		uint32 FileMagic = Magic;
+		uint32 Version = CurrentVersion;
+
+		Ar << FileMagic;
+		if (Ar.IsError() || FileMagic != Magic)
+		{
+			return Fail(TEXT("Not an input recording"));
+		}
+
+		Ar << Version;
+		if (Version > CurrentVersion)
+		{
+			return Fail(FString::Printf(TEXT("Recording version %u is newer than %u"), Version, CurrentVersion));
+		}
+
+		Ar << Recording.Seed;
+		Ar << Recording.FixedDeltaSeconds;
+		Ar << Recording.ChecksumIntervalFrames;
+		Ar << Recording.MapName;
+		Ar << Recording.Frames;
+		Ar << Recording.Checksums;
+
+		if (Ar.IsError())
+		{
+			return Fail(TEXT("Truncated recording"));
+		}
+
+		return true;
+	}
+
+	uint32 FInputRecording::ComputeTankTransformChecksum(const UWorld& World)
+	{
+		// Actor iteration order depends on spawn order and pooling so checksum each tank separately and combine them in sorted order
+		TArray<uint32, TInlineAllocator<64>> TankChecksums;
+
+		for (TActorIterator<ABaseTankPawn> It(const_cast<UWorld*>(&World)); It; ++It)
+		{
+			const auto& Transform = It->GetActorTransform();
+			const auto Location = Transform.GetLocation();
+			const auto Rotation = Transform.GetRotation();
+
+			const int64 Quantized[] =
+			{
+				FMath::RoundToInt64(Location.X / LocationQuantum),
+				FMath::RoundToInt64(Location.Y / LocationQuantum),
+				FMath::RoundToInt64(Location.Z / LocationQuantum),
+				FMath::RoundToInt64(Rotation.X / RotationQuantum),
+				FMath::RoundToInt64(Rotation.Y / RotationQuantum),
+				FMath::RoundToInt64(Rotation.Z / RotationQuantum),
+				FMath::RoundToInt64(Rotation.W / RotationQuantum),
+			};
+
+			TankChecksums.Add(FCrc::MemCrc32(Quantized, sizeof(Quantized)));
+		}
+
+		TankChecksums.Sort();
+
+		return FCrc::MemCrc32(TankChecksums.GetData(), TankChecksums.Num() * TankChecksums.GetTypeSize());
+	}
+
+	void FInputRecording::PinSimulation(uint32 Seed, float FixedDeltaSeconds)
+	{
+		RandUtils::SetPinnedSeed(Seed);
+
+		// Engine streams as well so that code using FMath::Rand is also repeatable
+		FMath::RandInit(Seed);
+		FMath::SRandInit(Seed);
+
+		if (FixedDeltaSeconds > 0)
+		{
+			FApp::SetUseFixedTimeStep(true);
+			FApp::SetFixedDeltaTime(FixedDeltaSeconds);
+		}
+	}
+
+	bool FInputRecording::PinSimulationFromCommandLine()
+	{
+		FString Path;
+
+		if (FParse::Value(FCommandLine::Get(), TEXT("TRPlayInput="), Path))
+		{
+			FInputRecording Recording;
+			FString Error;
+
+			if (!LoadFromFile(Path, Recording, &Error))
+			{
+				UE_LOG(LogTRPlayer, Error, TEXT("FInputRecording: PinSimulationFromCommandLine - Unable to read %s: %s"), *Path, *Error);
+				return false;
+			}
+
+			PinSimulation(Recording.Seed, Recording.FixedDeltaSeconds);
+
+			UE_LOG(LogTRPlayer, Display, TEXT("FInputRecording: PinSimulationFromCommandLine - Playback of %s: Seed=%u; FixedDeltaSeconds=%f"),
+				*Path, Recording.Seed, Recording.FixedDeltaSeconds);
+
+			return true;
+		}
+
+		if (FParse::Value(FCommandLine::Get(), TEXT("TRRecordInput="), Path))
+		{
+			float Fps = DefaultRecordFps;
+			FParse::Value(FCommandLine::Get(), TEXT("TRRecordFps="), Fps);
+
+			// Keep a seed pinned with -TRSeed so that it can be compared with other runs
+			const auto PinnedSeed = RandUtils::GetPinnedSeed();
+			const uint32 Seed = PinnedSeed ? *PinnedSeed : RandUtils::GenerateSeed();
+
+			PinSimulation(Seed, 1.0f / FMath::Max(Fps, 1.0f));
+
+			UE_LOG(LogTRPlayer, Display, TEXT("FInputRecording: PinSimulationFromCommandLine - Recording to %s: Seed=%u; Fps=%.1f"), *Path, Seed, Fps);
+
+			return true;
+		}
+
+		return false;
+	}
+}
+
+#pragma region Verification
+
+#if TR_DEBUG_ENABLED
+
+namespace
+{
+	using namespace TR;
+
+	/*
+	* Round trips a synthetic recording through serialization and checks every frame and checksum survives and that a truncated recording is rejected.
+	*/
+	void RunInputRecordingVerification(const TArray<FString>& Args)
+	{
+		const int32 FrameCount = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 10000;
+
+		FRandomStream Rng(RandUtils::GenerateSeed());
+
+		FInputRecording Recording
+		{
+			.Seed = static_cast<uint32>(Rng.GetUnsignedInt()),
+			.FixedDeltaSeconds = 1.0f / 30,
+			.ChecksumIntervalFrames = 30,
+			.MapName = TEXT("Verify")
+		};
+
+		for (int32 i = 0; i < FrameCount; ++i)
+		{
+			auto& Frame = Recording.Frames.AddDefaulted_GetRef();
+
+			Frame.Flags = static_cast<EInputRecordingFlags>(Rng.RandHelper(32));
+			if (EnumHasAnyFlags(Frame.Flags, EInputRecordingFlags::Move))
+			{
+				Frame.MoveValue = FVector2D(Rng.FRandRange(-1, 1), Rng.FRandRange(-1, 1));
+			}
+			if (EnumHasAnyFlags(Frame.Flags, EInputRecordingFlags::Look))
+			{
+				Frame.LookValue = FVector2D(Rng.FRandRange(-5, 5), Rng.FRandRange(-5, 5));
+			}
+			if (EnumHasAnyFlags(Frame.Flags, EInputRecordingFlags::Aim))
+			{
+				Frame.AimOrigin = Rng.GetUnitVector() * Rng.FRandRange(0, 100000);
+				Frame.AimDirection = Rng.GetUnitVector();
+			}
+
+			Frame.SelectWeaponIndex = Rng.RandHelper(8) == 0 ? static_cast<int8>(Rng.RandHelper(4)) : INDEX_NONE;
+			Frame.WeaponScroll = static_cast<int8>(Rng.RandRange(-1, 1));
+
+			if (i % Recording.ChecksumIntervalFrames == 0)
+			{
+				Recording.Checksums.Add({ i, static_cast<uint32>(Rng.GetUnsignedInt()) });
+			}
+		}
+
+		int32 Failures{};
+
+		TArray<uint8> Data;
+		Failures += !Recording.SaveToMemory(Data);
+
+		FInputRecording Loaded;
+		FString Error;
+
+		if (!FInputRecording::LoadFromMemory(Data, Loaded, &Error))
+		{
+			UE_LOG(LogTRPlayer, Error, TEXT("RunInputRecordingVerification: FAILED - %s"), *Error);
+			return;
+		}
+
+		Failures += Loaded.Seed != Recording.Seed || Loaded.FixedDeltaSeconds != Recording.FixedDeltaSeconds ||
+			Loaded.ChecksumIntervalFrames != Recording.ChecksumIntervalFrames || Loaded.MapName != Recording.MapName;
+
+		Failures += Loaded.Frames.Num() != Recording.Frames.Num() || Loaded.Checksums.Num() != Recording.Checksums.Num();
+
+		for (int32 i = 0; i < FMath::Min(Loaded.Frames.Num(), Recording.Frames.Num()); ++i)
+		{
+			const auto& Expected = Recording.Frames[i];
+			const auto& Actual = Loaded.Frames[i];
+
+			if (Actual.Flags != Expected.Flags || Actual.MoveValue != Expected.MoveValue || Actual.LookValue != Expected.LookValue ||
+				Actual.AimOrigin != Expected.AimOrigin || Actual.AimDirection != Expected.AimDirection ||
+				Actual.SelectWeaponIndex != Expected.SelectWeaponIndex || Actual.WeaponScroll != Expected.WeaponScroll)
+			{
+				++Failures;
+				UE_LOG(LogTRPlayer, Error, TEXT("RunInputRecordingVerification: Frame %d differs"), i);
+			}
+		}
+
+		for (int32 i = 0; i < FMath::Min(Loaded.Checksums.Num(), Recording.Checksums.Num()); ++i)
+		{
+			Failures += Loaded.Checksums[i].Frame != Recording.Checksums[i].Frame || Loaded.Checksums[i].Checksum != Recording.Checksums[i].Checksum;
+		}
+
+		Data.SetNum(Data.Num() / 2);
+		if (FInputRecording::LoadFromMemory(Data, Loaded))
+		{
+			++Failures;
+			UE_LOG(LogTRPlayer, Error, TEXT("RunInputRecordingVerification: Truncated recording accepted"));
+		}
+
+		UE_LOG(LogTRPlayer, Display, TEXT("RunInputRecordingVerification: %s - Frames=%d; Checksums=%d; Size=%dKB; Failures=%d"),
+			Failures == 0 ? TEXT("PASSED") : TEXT("FAILED"), Recording.Frames.Num(), Recording.Checksums.Num(), Data.Num() * 2 / 1024, Failures);
+	}
+
+	FAutoConsoleCommandWithArgs InputRecordingVerifyCommand(
+		TEXT("tr.input.recording.verify"),
+		TEXT("Round trips a synthetic input recording through serialization: [FrameCount=10000]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunInputRecordingVerification));
+}
+
+#endif
+
+#pragma endregion Verification
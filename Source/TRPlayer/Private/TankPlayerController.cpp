@@ -27,8 +27,21 @@
 #include "GameFramework/SpringArmComponent.h"
 #include "Camera/PlayerCameraManager.h"
 
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Utils/RandUtils.h"
+
 #include UE_INLINE_GENERATED_CPP_BY_NAME(TankPlayerController)
 
+namespace
+{
+	constexpr int32 DefaultChecksumIntervalFrames = 30;
+
+	/* Recording and playback cover the first level played so that a level restart doesn't overwrite or replay the run. */
+	bool bInputRecordingSessionStarted{};
+}
+
 ATankPlayerController::ATankPlayerController()
 {
 	PrimaryActorTick.bCanEverTick = true;
@@ -58,6 +71,14 @@ void ATankPlayerController::GameHasEnded(AActor* EndGameFocus, bool bIsWinner)
 	}), LevelRestartTime, false);
 }
 
+void ATankPlayerController::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	// Before any actor begins play so that the seed and timestep are pinned before anything draws a random number
+	InitializeInputRecording();
+}
+
 void ATankPlayerController::BeginPlay()
 {
 	Super::BeginPlay();
@@ -68,6 +89,24 @@ void ATankPlayerController::BeginPlay()
 	InitializeInputMappingContext();
 }
 
+void ATankPlayerController::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (IsRecordingInput())
+	{
+		InputRecording.SaveToFile(InputRecordingPath);
+		InputRecordingMode = EInputRecordingMode::None;
+	}
+	else if (IsPlayingBackInput())
+	{
+		UE_LOG(LogTRPlayer, Warning, TEXT("%s: EndPlay - Playback of %s ended at frame %d of %d"),
+			*GetName(), *InputRecordingPath, InputFrameIndex, InputRecording.Frames.Num());
+
+		FinishPlayback();
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void ATankPlayerController::SetupInputComponent()
 {
 	Super::SetupInputComponent();
@@ -118,7 +157,21 @@ void ATankPlayerController::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	// Player controllers tick while paused but the simulation doesn't advance so those frames are not part of the recording
+	const bool bInputFrame = InputRecordingMode != EInputRecordingMode::None && !IsGamePaused();
+
+	// Input handlers have already run for the frame in PlayerTick so playback applies the recorded input at the same point
+	if (bInputFrame && IsPlayingBackInput())
+	{
+		ApplyPlaybackFrame();
+	}
+
 	AimTowardCrosshair();
+
+	if (bInputFrame && InputRecordingMode != EInputRecordingMode::None)
+	{
+		EndInputFrame();
+	}
 }
 
 ABaseTankPawn* ATankPlayerController::GetControlledTank() const
@@ -288,23 +341,45 @@ void ATankPlayerController::AimTowardCrosshair()
 
 	FAimingData AimingData;
 	GetAimingData(AimingData, ZeroingDistance);
+
+	if (IsRecordingInput())
+	{
+		CurrentInputFrame.AimOrigin = AimingData.AimingOriginWorldLocation;
+		CurrentInputFrame.AimDirection = AimingData.AimingWorldDirection;
+		CurrentInputFrame.Flags |= TR::EInputRecordingFlags::Aim;
+	}
 	
 	ControlledTank->AimAt(AimingData);
 }
 
 void ATankPlayerController::OnFire()
 {
+	if (IsLiveInputBlocked())
+	{
+		return;
+	}
+
 	auto ControlledTank = GetControlledTankIfInputShouldBeActive();
 	if (!ControlledTank)
 	{
 		return;
 	}
 
+	if (IsRecordingInput())
+	{
+		CurrentInputFrame.Flags |= TR::EInputRecordingFlags::Fire;
+	}
+
 	ControlledTank->Fire();
 }
 
 void ATankPlayerController::OnMove(const FInputActionValue& Value)
 {
+	if (IsLiveInputBlocked())
+	{
+		return;
+	}
+
 	auto ControlledTank = GetControlledTankIfInputShouldBeActive();
 	if (!ControlledTank)
 	{
@@ -313,18 +388,34 @@ void ATankPlayerController::OnMove(const FInputActionValue& Value)
 
 	const auto MoveAxisValue = Value.Get<FVector2D>();
 
+	if (IsRecordingInput())
+	{
+		CurrentInputFrame.MoveValue = MoveAxisValue;
+		CurrentInputFrame.Flags |= TR::EInputRecordingFlags::Move;
+	}
+
 	ControlledTank->MoveForward(MoveAxisValue.Y);
 	ControlledTank->TurnRight(MoveAxisValue.X);
 }
 
 void ATankPlayerController::OnActivateTurbo()
 {
+	if (IsLiveInputBlocked())
+	{
+		return;
+	}
+
 	auto ItemInventory = GetItemInventory();
 	if (!ItemInventory)
 	{
 		return;
 	}
 
+	if (IsRecordingInput())
+	{
+		CurrentInputFrame.Flags |= TR::EInputRecordingFlags::ActivateTurbo;
+	}
+
 	auto TurboItem = ItemInventory->GetItemByName(TR::ItemNames::TurboSpeedBoost);
 	if (!TurboItem)
 	{
@@ -346,6 +437,11 @@ void ATankPlayerController::OnActivateTurbo()
 
 void ATankPlayerController::OnSelectWeapon(const FInputActionInstance& InputActionInstance)
 {
+	if (IsLiveInputBlocked())
+	{
+		return;
+	}
+
 	const int32 FoundIndex = WeaponSelectActions.Find(InputActionInstance.GetSourceAction());
 	if (FoundIndex != INDEX_NONE)
 	{
@@ -363,22 +459,12 @@ void ATankPlayerController::OnNextWeapon(const FInputActionInstance& InputAction
 	UE_LOG(LogTRPlayer, Log, TEXT("%s: OnScrollWeapon - OnNextWeapon"),
 		*GetName());
 
-	if (!IsWeaponScrollSwitchTriggerable(InputActionInstance))
-	{
-		return;
-	}
-
-	auto ItemInventory = GetItemInventory();
-	if (!ItemInventory)
+	if (IsLiveInputBlocked() || !IsWeaponScrollSwitchTriggerable(InputActionInstance))
 	{
 		return;
 	}
 
-	auto World = GetWorld();
-	check(World);
-	WeaponScrollLastTriggerTime = World->GetTimeSeconds();
-
-	ItemInventory->SetNextWeaponActive(true);
+	ScrollWeapon(true);
 }
 
 void ATankPlayerController::OnPreviousWeapon(const FInputActionInstance& InputActionInstance)
@@ -386,11 +472,16 @@ void ATankPlayerController::OnPreviousWeapon(const FInputActionInstance& InputAc
 	UE_LOG(LogTRPlayer, Log, TEXT("%s: OnScrollWeapon - OnPreviousWeapon"),
 		*GetName());
 
-	if (!IsWeaponScrollSwitchTriggerable(InputActionInstance))
+	if (IsLiveInputBlocked() || !IsWeaponScrollSwitchTriggerable(InputActionInstance))
 	{
 		return;
 	}
 
+	ScrollWeapon(false);
+}
+
+void ATankPlayerController::ScrollWeapon(bool bNext)
+{
 	auto ItemInventory = GetItemInventory();
 	if (!ItemInventory)
 	{
@@ -401,7 +492,19 @@ void ATankPlayerController::OnPreviousWeapon(const FInputActionInstance& InputAc
 	check(World);
 	WeaponScrollLastTriggerTime = World->GetTimeSeconds();
 
-	ItemInventory->SetPreviousWeaponActive(true);
+	if (IsRecordingInput())
+	{
+		CurrentInputFrame.WeaponScroll = bNext ? 1 : -1;
+	}
+
+	if (bNext)
+	{
+		ItemInventory->SetNextWeaponActive(true);
+	}
+	else
+	{
+		ItemInventory->SetPreviousWeaponActive(true);
+	}
 }
 
 bool ATankPlayerController::IsWeaponScrollSwitchTriggerable(const FInputActionInstance& InputActionInstance) const
@@ -423,7 +526,7 @@ UItemInventory* ATankPlayerController::GetItemInventory() const
 	return ItemInventory;
 }
 
-void ATankPlayerController::SelectWeapon(int32 WeaponIndex) const
+void ATankPlayerController::SelectWeapon(int32 WeaponIndex)
 {
 	auto ItemInventory = GetItemInventory();
 	if (!ItemInventory)
@@ -431,6 +534,11 @@ void ATankPlayerController::SelectWeapon(int32 WeaponIndex) const
 		return;
 	}
 
+	if (IsRecordingInput())
+	{
+		CurrentInputFrame.SelectWeaponIndex = static_cast<int8>(WeaponIndex);
+	}
+
 	// TODO: Switch to CanWeaponBeActivatedByIndex if we don't want player to switch to a weapon still in cooldown
 	if (ItemInventory->IsWeaponAvailableByIndex(WeaponIndex))
 	{
@@ -448,13 +556,19 @@ void ATankPlayerController::SelectWeapon(int32 WeaponIndex) const
 
 void ATankPlayerController::OnLook(const FInputActionValue& Value)
 {
-	if (IsGamePaused())
+	if (IsGamePaused() || IsLiveInputBlocked())
 	{
 		return;
 	}
 
 	const auto LookAxisValue = Value.Get<FVector2D>();
 
+	if (IsRecordingInput())
+	{
+		CurrentInputFrame.LookValue += LookAxisValue;
+		CurrentInputFrame.Flags |= TR::EInputRecordingFlags::Look;
+	}
+
 	// AddYawInput and AddPitchInput requires Camera Control Rotation to be checked on the camera spring arm on the pawn
 	if (!FMath::IsNearlyZero(LookAxisValue.X))
 	{
@@ -490,7 +604,16 @@ void ATankPlayerController::GetAimingData(FAimingData& AimingData, float Zeroing
 {
 	const auto CrosshairScreenLocation = GetCrosshairScreenspaceLocation();
 
-	CrosshairToAimingData(CrosshairScreenLocation, AimingData);
+	// There may be no viewport to deproject from on playback, e.g. with -nullrhi
+	if (IsPlayingBackInput())
+	{
+		AimingData.AimingOriginWorldLocation = CurrentInputFrame.AimOrigin;
+		AimingData.AimingWorldDirection = CurrentInputFrame.AimDirection;
+	}
+	else
+	{
+		CrosshairToAimingData(CrosshairScreenLocation, AimingData);
+	}
 
 	const auto TargetLocationOptional = GetAimingTargetLocation(AimingData.AimingOriginWorldLocation, AimingData.AimingWorldDirection, ZeroingDistance);
 
@@ -565,6 +688,175 @@ FVector2D ATankPlayerController::GetCrosshairScreenspaceLocation() const
 
 #pragma endregion Controls
 
+#pragma region Input Recording
+
+void ATankPlayerController::InitializeInputRecording()
+{
+	if (bInputRecordingSessionStarted || !IsLocalController())
+	{
+		return;
+	}
+
+	auto World = GetWorld();
+	check(World);
+
+	if (!World->IsGameWorld())
+	{
+		return;
+	}
+
+	FString Path;
+
+	if (FParse::Value(FCommandLine::Get(), TEXT("TRPlayInput="), Path))
+	{
+		bInputRecordingSessionStarted = true;
+
+		FString Error;
+		if (!TR::FInputRecording::LoadFromFile(Path, InputRecording, &Error))
+		{
+			UE_LOG(LogTRPlayer, Error, TEXT("%s: InitializeInputRecording - Unable to play back %s: %s"), *GetName(), *Path, *Error);
+			return;
+		}
+
+		if (InputRecording.MapName != World->GetMapName())
+		{
+			UE_LOG(LogTRPlayer, Warning, TEXT("%s: InitializeInputRecording - %s was recorded on %s but playing back on %s"),
+				*GetName(), *Path, *InputRecording.MapName, *World->GetMapName());
+		}
+
+		TR::FInputRecording::PinSimulation(InputRecording.Seed, InputRecording.FixedDeltaSeconds);
+
+		InputRecordingPath = Path;
+		InputRecordingMode = EInputRecordingMode::Playback;
+		bExitAfterPlayback = FParse::Param(FCommandLine::Get(), TEXT("TRPlaybackExit"));
+
+		UE_LOG(LogTRPlayer, Display, TEXT("%s: InitializeInputRecording - Playing back %s: Frames=%d; Checksums=%d; Seed=%u; FixedDeltaSeconds=%f"),
+			*GetName(), *Path, InputRecording.Frames.Num(), InputRecording.Checksums.Num(), InputRecording.Seed, InputRecording.FixedDeltaSeconds);
+	}
+	else if (FParse::Value(FCommandLine::Get(), TEXT("TRRecordInput="), Path))
+	{
+		bInputRecordingSessionStarted = true;
+
+		float Fps = TR::FInputRecording::DefaultRecordFps;
+		FParse::Value(FCommandLine::Get(), TEXT("TRRecordFps="), Fps);
+
+		int32 ChecksumIntervalFrames = DefaultChecksumIntervalFrames;
+		FParse::Value(FCommandLine::Get(), TEXT("TRChecksumInterval="), ChecksumIntervalFrames);
+
+		// Normally pinned by the game instance before the map loaded, otherwise keep a seed pinned with -TRSeed
+		const auto PinnedSeed = RandUtils::GetPinnedSeed();
+
+		InputRecording = TR::FInputRecording
+		{
+			.Seed = PinnedSeed ? *PinnedSeed : RandUtils::GenerateSeed(),
+			.FixedDeltaSeconds = 1.0f / FMath::Max(Fps, 1.0f),
+			.ChecksumIntervalFrames = FMath::Max(ChecksumIntervalFrames, 1),
+			.MapName = World->GetMapName()
+		};
+
+		TR::FInputRecording::PinSimulation(InputRecording.Seed, InputRecording.FixedDeltaSeconds);
+
+		InputRecordingPath = FPaths::IsRelative(Path) ? FPaths::ProjectDir() / Path : Path;
+		InputRecordingMode = EInputRecordingMode::Record;
+
+		UE_LOG(LogTRPlayer, Display, TEXT("%s: InitializeInputRecording - Recording to %s: Seed=%u; Fps=%.1f; ChecksumInterval=%d"),
+			*GetName(), *InputRecordingPath, InputRecording.Seed, Fps, InputRecording.ChecksumIntervalFrames);
+	}
+}
+
+void ATankPlayerController::ApplyPlaybackFrame()
+{
+	if (InputFrameIndex >= InputRecording.Frames.Num())
+	{
+		FinishPlayback();
+		return;
+	}
+
+	CurrentInputFrame = InputRecording.Frames[InputFrameIndex];
+
+	TGuardValue ApplyingGuard(bApplyingPlaybackInput, true);
+
+	const auto& Frame = CurrentInputFrame;
+
+	if (EnumHasAnyFlags(Frame.Flags, TR::EInputRecordingFlags::Look))
+	{
+		OnLook(FInputActionValue(Frame.LookValue));
+	}
+	if (EnumHasAnyFlags(Frame.Flags, TR::EInputRecordingFlags::Move))
+	{
+		OnMove(FInputActionValue(Frame.MoveValue));
+	}
+	if (Frame.SelectWeaponIndex != INDEX_NONE)
+	{
+		SelectWeapon(Frame.SelectWeaponIndex);
+	}
+	if (Frame.WeaponScroll != 0)
+	{
+		ScrollWeapon(Frame.WeaponScroll > 0);
+	}
+	if (EnumHasAnyFlags(Frame.Flags, TR::EInputRecordingFlags::Fire))
+	{
+		OnFire();
+	}
+	if (EnumHasAnyFlags(Frame.Flags, TR::EInputRecordingFlags::ActivateTurbo))
+	{
+		OnActivateTurbo();
+	}
+}
+
+void ATankPlayerController::EndInputFrame()
+{
+	auto World = GetWorld();
+	check(World);
+
+	if (IsRecordingInput())
+	{
+		InputRecording.Frames.Add(CurrentInputFrame);
+
+		if (InputFrameIndex % InputRecording.ChecksumIntervalFrames == 0)
+		{
+			InputRecording.Checksums.Add({ InputFrameIndex, TR::FInputRecording::ComputeTankTransformChecksum(*World) });
+		}
+	}
+	else if (IsPlayingBackInput() && InputRecording.Checksums.IsValidIndex(NextChecksumIndex) && InputRecording.Checksums[NextChecksumIndex].Frame == InputFrameIndex)
+	{
+		const auto Expected = InputRecording.Checksums[NextChecksumIndex++].Checksum;
+		const auto Actual = TR::FInputRecording::ComputeTankTransformChecksum(*World);
+
+		if (Actual != Expected)
+		{
+			if (ChecksumMismatchCount++ == 0)
+			{
+				FirstMismatchFrame = InputFrameIndex;
+
+				UE_LOG(LogTRPlayer, Error, TEXT("%s: EndInputFrame - Playback diverged from %s at frame %d: Checksum=%08X; Expected=%08X"),
+					*GetName(), *InputRecordingPath, InputFrameIndex, Actual, Expected);
+			}
+		}
+	}
+
+	CurrentInputFrame = {};
+	++InputFrameIndex;
+}
+
+void ATankPlayerController::FinishPlayback()
+{
+	InputRecordingMode = EInputRecordingMode::None;
+
+	const bool bPassed = ChecksumMismatchCount == 0 && NextChecksumIndex == InputRecording.Checksums.Num();
+
+	UE_LOG(LogTRPlayer, Display, TEXT("%s: FinishPlayback - %s: %s - Frames=%d/%d; Checksums=%d/%d; Mismatches=%d; FirstMismatchFrame=%d"),
+		*GetName(), bPassed ? TEXT("PASSED") : TEXT("FAILED"), *InputRecordingPath, InputFrameIndex, InputRecording.Frames.Num(),
+		NextChecksumIndex, InputRecording.Checksums.Num(), ChecksumMismatchCount, FirstMismatchFrame);
+
+	if (bExitAfterPlayback)
+	{
+		FPlatformMisc::RequestExitWithStatus(false, bPassed ? 0 : 1);
+	}
+}
+
+#pragma endregion Input Recording
+
 void ATankPlayerController::OnHealthChanged(UHealthComponent* HealthComponent, float PreviousHealthValue, float PreviousMaxHealthValue, AController* EventInstigator, AActor* ChangeCauser)
 {
 	check(HealthComponent);
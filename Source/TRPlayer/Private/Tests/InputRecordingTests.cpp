@@ -0,0 +1,192 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "InputRecording.h"
+
+#include "Algo/Reverse.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/ScopeExit.h"
+#include "Pawn/BaseTankPawn.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace InputRecordingTests
+{
+	using namespace TR;
+
+	constexpr auto TestFlags = EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter;
+
+	bool FramesEqual(const FInputRecordingFrame& First, const FInputRecordingFrame& Second)
+	{
+		return First.Flags == Second.Flags && First.MoveValue == Second.MoveValue && First.LookValue == Second.LookValue && First.AimOrigin == Second.AimOrigin &&
+			First.AimDirection == Second.AimDirection && First.SelectWeaponIndex == Second.SelectWeaponIndex && First.WeaponScroll == Second.WeaponScroll;
+	}
+
+	TArray<ABaseTankPawn*> SpawnTanks(UWorld& World, TConstArrayView<FTransform> Transforms)
+	{
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		TArray<ABaseTankPawn*> Tanks;
+		for (const auto& Transform : Transforms)
+		{
+			Tanks.Add(World.SpawnActor<ABaseTankPawn>(ABaseTankPawn::StaticClass(), Transform, SpawnParameters));
+		}
+
+		return Tanks;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInputRecordingRoundTripTest, "TankRampage.TRPlayer.InputRecording.RoundTrip", InputRecordingTests::TestFlags)
+
+bool FInputRecordingRoundTripTest::RunTest(const FString& Parameters)
+{
+	using namespace InputRecordingTests;
+
+	FInputRecording Recording
+	{
+		.Seed = 1234,
+		.FixedDeltaSeconds = 1 / FInputRecording::DefaultRecordFps,
+		.ChecksumIntervalFrames = 30,
+		.MapName = TEXT("RoundTrip")
+	};
+
+	FRandomStream Rng(1234);
+
+	for (int32 i = 0; i < 300; ++i)
+	{
+		auto& Frame = Recording.Frames.AddDefaulted_GetRef();
+
+		// Idle frames are most common and only store the flags and weapon selection
+		if (Rng.FRand() < 0.5f)
+		{
+			continue;
+		}
+
+		Frame.Flags = static_cast<EInputRecordingFlags>(Rng.RandRange(1, 0x1F));
+
+		if (EnumHasAnyFlags(Frame.Flags, EInputRecordingFlags::Move))
+		{
+			Frame.MoveValue = FVector2D(Rng.FRandRange(-1, 1), Rng.FRandRange(-1, 1));
+		}
+		if (EnumHasAnyFlags(Frame.Flags, EInputRecordingFlags::Look))
+		{
+			Frame.LookValue = FVector2D(Rng.FRandRange(-5, 5), Rng.FRandRange(-5, 5));
+		}
+		if (EnumHasAnyFlags(Frame.Flags, EInputRecordingFlags::Aim))
+		{
+			Frame.AimOrigin = Rng.GetUnitVector() * 1000;
+			Frame.AimDirection = Rng.GetUnitVector();
+		}
+
+		Frame.SelectWeaponIndex = static_cast<int8>(Rng.RandRange(INDEX_NONE, 3));
+		Frame.WeaponScroll = static_cast<int8>(Rng.RandRange(-1, 1));
+	}
+
+	for (int32 Frame = 0; Frame < Recording.Frames.Num(); Frame += Recording.ChecksumIntervalFrames)
+	{
+		Recording.Checksums.Add({ .Frame = Frame, .Checksum = Rng.GetUnsignedInt() });
+	}
+
+	TArray<uint8> Data;
+	if (!TestTrue(TEXT("SaveToMemory"), Recording.SaveToMemory(Data)))
+	{
+		return true;
+	}
+
+	FInputRecording Loaded;
+	FString Error;
+
+	const auto bLoaded = FInputRecording::LoadFromMemory(Data, Loaded, &Error);
+	if (!TestTrue(*FString::Printf(TEXT("LoadFromMemory: %s"), *Error), bLoaded))
+	{
+		return true;
+	}
+
+	TestEqual(TEXT("Seed"), Loaded.Seed, Recording.Seed);
+	TestEqual(TEXT("FixedDeltaSeconds"), Loaded.FixedDeltaSeconds, Recording.FixedDeltaSeconds);
+	TestEqual(TEXT("ChecksumIntervalFrames"), Loaded.ChecksumIntervalFrames, Recording.ChecksumIntervalFrames);
+	TestEqual(TEXT("MapName"), Loaded.MapName, Recording.MapName);
+
+	if (TestEqual(TEXT("Frame count"), Loaded.Frames.Num(), Recording.Frames.Num()))
+	{
+		for (int32 i = 0; i < Recording.Frames.Num(); ++i)
+		{
+			if (!TestTrue(*FString::Printf(TEXT("Frame %d matches"), i), FramesEqual(Loaded.Frames[i], Recording.Frames[i])))
+			{
+				break;
+			}
+		}
+	}
+
+	if (TestEqual(TEXT("Checksum count"), Loaded.Checksums.Num(), Recording.Checksums.Num()))
+	{
+		for (int32 i = 0; i < Recording.Checksums.Num(); ++i)
+		{
+			TestTrue(*FString::Printf(TEXT("Checksum %d matches"), i),
+				Loaded.Checksums[i].Frame == Recording.Checksums[i].Frame && Loaded.Checksums[i].Checksum == Recording.Checksums[i].Checksum);
+		}
+	}
+
+	// A recording cut short is rejected rather than played back with missing frames
+	auto Truncated = Data;
+	Truncated.SetNum(Truncated.Num() / 2);
+	TestFalse(TEXT("Load truncated"), FInputRecording::LoadFromMemory(Truncated, Loaded));
+
+	auto Corrupted = Data;
+	Corrupted[0] ^= 0xFF;
+	TestFalse(TEXT("Load corrupted magic"), FInputRecording::LoadFromMemory(Corrupted, Loaded));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInputRecordingChecksumTest, "TankRampage.TRPlayer.InputRecording.Checksum", InputRecordingTests::TestFlags)
+
+bool FInputRecordingChecksumTest::RunTest(const FString& Parameters)
+{
+	using namespace InputRecordingTests;
+
+	auto World = UWorld::CreateWorld(EWorldType::Game, false);
+	auto ReversedWorld = UWorld::CreateWorld(EWorldType::Game, false);
+
+	ON_SCOPE_EXIT
+	{
+		World->DestroyWorld(false);
+		ReversedWorld->DestroyWorld(false);
+	};
+
+	const FTransform Transforms[] =
+	{
+		FTransform(FRotator(0, 0, 0), FVector(0, 0, 0)),
+		FTransform(FRotator(0, 90, 0), FVector(1000, 0, 0)),
+		FTransform(FRotator(5, -45, 0), FVector(0, 2000, 50)),
+	};
+
+	TArray<FTransform> ReversedTransforms(Transforms, UE_ARRAY_COUNT(Transforms));
+	Algo::Reverse(ReversedTransforms);
+
+	const auto Tanks = SpawnTanks(*World, Transforms);
+	SpawnTanks(*ReversedWorld, ReversedTransforms);
+
+	if (!TestFalse(TEXT("Spawned tanks"), Tanks.Contains(nullptr)))
+	{
+		return true;
+	}
+
+	const auto Checksum = FInputRecording::ComputeTankTransformChecksum(*World);
+
+	// Tanks spawned or pooled in a different order still have the same checksum
+	TestEqual(TEXT("Checksum independent of actor order"), FInputRecording::ComputeTankTransformChecksum(*ReversedWorld), Checksum);
+
+	// Well under the 0.1mm quantum
+	Tanks[1]->SetActorLocation(Tanks[1]->GetActorLocation() + FVector(0.0001, 0, 0));
+	TestEqual(TEXT("Checksum after sub-quantum move"), FInputRecording::ComputeTankTransformChecksum(*World), Checksum);
+
+	Tanks[1]->SetActorLocation(Tanks[1]->GetActorLocation() + FVector(1, 0, 0));
+	TestNotEqual(TEXT("Checksum after moving a tank"), FInputRecording::ComputeTankTransformChecksum(*World), Checksum);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,99 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UWorld;
+
+namespace TR
+{
+	enum class EInputRecordingFlags : uint8
+	{
+		None = 0,
+		Fire = 1 << 0,
+		ActivateTurbo = 1 << 1,
+		Move = 1 << 2,
+		Look = 1 << 3,
+		Aim = 1 << 4,
+	};
+
+	ENUM_CLASS_FLAGS(EInputRecordingFlags);
+
+	/**
+	 * Player input applied in one frame: the action values seen by the input handlers and the smoothed crosshair aim used for the frame.
+	 */
+	struct FInputRecordingFrame
+	{
+		FVector2D MoveValue{ ForceInitToZero };
+
+		/* Sum of the look values in the frame as yaw and pitch input accumulate. */
+		FVector2D LookValue{ ForceInitToZero };
+
+		FVector AimOrigin{ ForceInitToZero };
+		FVector AimDirection{ ForceInitToZero };
+
+		int8 SelectWeaponIndex{ INDEX_NONE };
+
+		/* 1 for next weapon and -1 for previous weapon once past the retrigger delay. */
+		int8 WeaponScroll{};
+
+		EInputRecordingFlags Flags{ EInputRecordingFlags::None };
+
+		friend FArchive& operator<<(FArchive& Ar, FInputRecordingFrame& Frame);
+	};
+
+	struct FInputRecordingChecksum
+	{
+		int32 Frame{};
+		uint32 Checksum{};
+
+		friend FArchive& operator<<(FArchive& Ar, FInputRecordingChecksum& Checksum);
+	};
+
+	/**
+	 * Per-frame player input of a run recorded at a fixed timestep along with the seed it ran with and periodic checksums of every tank transform.
+	 * Playing it back with the same seed and timestep should reproduce the run so that a checksum mismatch flags nondeterminism.
+	 */
+	class TRPLAYER_API FInputRecording
+	{
+	public:
+		static constexpr uint32 Magic = 0x52494754; // "TGIR"
+		static constexpr uint32 CurrentVersion = 1;
+		static constexpr float DefaultRecordFps = 30.0f;
+
+		uint32 Seed{};
+		float FixedDeltaSeconds{};
+		int32 ChecksumIntervalFrames{};
+		FString MapName{};
+
+		TArray<FInputRecordingFrame> Frames{};
+		TArray<FInputRecordingChecksum> Checksums{};
+
+		bool SaveToFile(const FString& Path) const;
+		static bool LoadFromFile(const FString& Path, FInputRecording& OutRecording, FString* OutError = nullptr);
+
+		bool SaveToMemory(TArray<uint8>& OutData) const;
+		static bool LoadFromMemory(const TArray<uint8>& Data, FInputRecording& OutRecording, FString* OutError = nullptr);
+
+		/*
+		* Checksum of the location and rotation of every tank in the world independent of actor order, quantized to 0.1mm and about 0.006 degrees.
+		*/
+		static uint32 ComputeTankTransformChecksum(const UWorld& World);
+
+		/*
+		* Pins the seed of <c>RandUtils</c> and the engine random streams and switches the engine to a fixed timestep.
+		*/
+		static void PinSimulation(uint32 Seed, float FixedDeltaSeconds);
+
+		/*
+		* Pins the simulation for <c>-TRPlayInput</c> from the seed and timestep of the recording or for <c>-TRRecordInput</c> from
+		* <c>-TRSeed</c> or a new seed and <c>-TRRecordFps</c>. Call before the first map loads so that every object seeded in the map sees the pinned seed.
+		* Returns false if not recording or playing back or the recording could not be read.
+		*/
+		static bool PinSimulationFromCommandLine();
+
+	private:
+		static bool Serialize(FArchive& Ar, FInputRecording& Recording, FString* OutError);
+	};
+}
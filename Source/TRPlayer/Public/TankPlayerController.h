@@ -8,6 +8,7 @@
 
 
 #include "Containers/TimedCircularBuffer.h"
+#include "InputRecording.h"
 
 #include <optional>
 
@@ -25,7 +26,15 @@ class UEnhancedInputComponent;
 struct FInputActionInstance;
 
 /**
- * 
+ * Player tank controls.
+ *
+ * Input can be recorded at a fixed timestep and played back through the same handlers to reproduce a run, e.g. for profiling:
+ *
+ *   TankRampage Map -game -TRRecordInput=Saved/Run.trinput [-TRRecordFps=30] [-TRChecksumInterval=30] [-TRSeed=N]
+ *   TankRampage Map -game -TRPlayInput=Saved/Run.trinput [-TRPlaybackExit] -nullrhi -nosound -unattended
+ *
+ * The recording pins the seed and timestep it ran with and a checksum of every tank transform every few frames. Playback reports the first frame that
+ * diverges and with <c>-TRPlaybackExit</c> exits with a non-zero code on a mismatch so that nondeterminism regressions can be caught unattended.
  */
 UCLASS()
 class TRPLAYER_API ATankPlayerController : public ABasePlayerController, public ITankOwner
@@ -41,7 +50,9 @@ public:
 	const UInputAction* GetInputActionForItemNameAndIndex(const FName& ItemName, int32 ItemIndex) const;
 
 protected:
+	virtual void PostInitializeComponents() override;
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void SetupInputComponent() override;
 	virtual void Tick(float DeltaTime) override;
 
@@ -71,7 +82,8 @@ private:
 	void OnNextWeapon(const FInputActionInstance& InputActionInstance);
 	void OnPreviousWeapon(const FInputActionInstance& InputActionInstance);
 
-	void SelectWeapon(int32 WeaponIndex) const;
+	void SelectWeapon(int32 WeaponIndex);
+	void ScrollWeapon(bool bNext);
 
 	void GetAimingData(FAimingData& AimingData, float ZeroingDistance) const;
 	void CrosshairToAimingData(const FVector2D& CrosshairScreenLocation, FAimingData& AimingData) const;
@@ -86,8 +98,27 @@ private:
 	bool IsWeaponScrollSwitchTriggerable(const FInputActionInstance& InputActionInstance) const;
 
 	UItemInventory* GetItemInventory() const;
+
+	void InitializeInputRecording();
+
+	/*
+	* Live input is ignored while a recording is played back.
+	*/
+	bool IsLiveInputBlocked() const;
+	bool IsRecordingInput() const;
+	bool IsPlayingBackInput() const;
+
+	void ApplyPlaybackFrame();
+	void EndInputFrame();
+	void FinishPlayback();
 	
 private:
+	enum class EInputRecordingMode : uint8
+	{
+		None,
+		Record,
+		Playback
+	};
 	
 	using FVectorBuffer = TR::TTimedCircularBuffer <
 		FVector,
@@ -141,4 +172,38 @@ private:
 
 	UPROPERTY(EditDefaultsOnly, Category = Input, meta = (ClampMin = "0"))
 	float LevelRestartTime{ 8.0f };
+
+	TR::FInputRecording InputRecording{};
+
+	/* Input of the frame being recorded or played back. */
+	TR::FInputRecordingFrame CurrentInputFrame{};
+
+	FString InputRecordingPath{};
+	int32 InputFrameIndex{};
+	int32 NextChecksumIndex{};
+	int32 ChecksumMismatchCount{};
+	int32 FirstMismatchFrame{ INDEX_NONE };
+
+	EInputRecordingMode InputRecordingMode{ EInputRecordingMode::None };
+	bool bApplyingPlaybackInput{};
+	bool bExitAfterPlayback{};
 };
+
+#pragma region Inline Definitions
+
+inline bool ATankPlayerController::IsLiveInputBlocked() const
+{
+	return InputRecordingMode == EInputRecordingMode::Playback && !bApplyingPlaybackInput;
+}
+
+inline bool ATankPlayerController::IsRecordingInput() const
+{
+	return InputRecordingMode == EInputRecordingMode::Record;
+}
+
+inline bool ATankPlayerController::IsPlayingBackInput() const
+{
+	return InputRecordingMode == EInputRecordingMode::Playback;
+}
+
+#pragma endregion Inline Definitions
@@ -4,6 +4,7 @@
 #include "Components/FlippedOverCorrectionComponent.h"
 
 #include "Utils/CollisionUtils.h"
+#include "Subsystems/TankRecoverySubsystem.h"
 
 #include "TRTankLogging.h"
 #include "Logging/LoggingUtils.h"
@@ -32,6 +33,13 @@ void UFlippedOverCorrectionComponent::TickComponent(float DeltaTime, ELevelTick
 	auto MyActor = GetOwner();
 	check(MyActor);
 
+	// Flipped tanks are handled by the recovery subsystem when enabled
+	if (UTankRecoverySubsystem::IsEnabled())
+	{
+		bIsFlippedOver = false;
+		return;
+	}
+
 	if (IsActorAboveSpeedThreshold())
 	{
 		bIsFlippedOver = false;
@@ -6,7 +6,9 @@
 #include "TankSockets.h"
 #include "Components/TankTurretComponent.h"
 #include "Components/TankBarrelComponent.h"
+#include "Components/TankAttributeSnapshotComponent.h"
 #include "Interfaces/ArmedActor.h"
+#include "Utils/BallisticUtils.h"
 
 #include "AbilitySystem/TRGameplayTags.h"
 
@@ -14,8 +16,6 @@
 #include "Logging/LoggingUtils.h"
 #include "VisualLogger/VisualLogger.h"
 
-#include "Kismet/GameplayStatics.h"
-
 #include UE_INLINE_GENERATED_CPP_BY_NAME(TankAimingComponent)
 
 namespace
@@ -34,9 +34,11 @@ void UTankAimingComponent::SetTankComponents(const FTankComponents& TankComponen
 {
 	Barrel = TankComponents.Barrel;
 	Turret = TankComponents.Turret;
+	AttributeSnapshot = TankComponents.AttributeSnapshot;
 
 	check(Barrel);
 	check(Turret);
+	check(AttributeSnapshot);
 }
 
 void UTankAimingComponent::BeginPlay()
@@ -134,25 +136,12 @@ std::optional<FVector> UTankAimingComponent::GetAssistedAimDirection(const FAimi
 		return AimDirection;
 	}
 
-	FVector OutProjectileVelocity{ EForceInit::ForceInitToZero };
-
-	const bool bSolutionFound = UGameplayStatics::SuggestProjectileVelocity(
-		this,
-		OutProjectileVelocity,
-		FireLocation,
-		AimingData.AimTargetLocation,
-		LaunchSpeed,
-		false,
-		0.0f,
-		0.0f,
-		ESuggestProjVelocityTraceOption::DoNotTrace,
-		{},
-		{},
-		false);
-
-	if (bSolutionFound)
+	auto World = GetWorld();
+	check(World);
+
+	if (const auto Solution = TR::BallisticUtils::SolveLaunch(FireLocation, AimingData.AimTargetLocation, LaunchSpeed, World->GetGravityZ()); Solution)
 	{
-		const auto AimDirection = OutProjectileVelocity.GetSafeNormal();
+		const auto& AimDirection = Solution->Direction;
 
 		UE_VLOG_UELOG(GetOwner(), LogTRTank, VeryVerbose, TEXT("%s-%s: GetAssistedAimDirection - projectile calculation adjusted aim direction from %s to %s"),
 			*LoggingUtils::GetName(GetOwner()), *GetName(),
@@ -294,7 +283,7 @@ bool UTankAimingComponent::IsBarrelAlreadyAtTarget(const FVector& Target, const
 bool UTankAimingComponent::IsAimingAllowed() const
 {
 	// Check if owning actor has a debuff to block aiming
-	if (TR::GameplayTags::HasExactTag(GetOwner(), TR::GameplayTags::AimBlocked))
+	if (AttributeSnapshot->GetSnapshot().bAimBlocked)
 	{
 		UE_VLOG_UELOG(GetOwner(), LogTRTank, Verbose, TEXT("%s-%s: IsAimingAllowed: FALSE - By GameplayTag=%s"),
 			*LoggingUtils::GetName(GetOwner()), *GetName(), *TR::GameplayTags::AimBlocked.ToString());
@@ -0,0 +1,136 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Components/TankAttributeSnapshotComponent.h"
+
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+#include "AbilitySystem/TRGameplayTags.h"
+
+#include "Logging/LoggingUtils.h"
+#include "TRTankLogging.h"
+
+#include "VisualLogger/VisualLogger.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(TankAttributeSnapshotComponent)
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Attribute Snapshot Lookups Avoided"), STAT_TankAttributeSnapshot_LookupsAvoided, STATGROUP_TRTank);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Attribute Snapshot Updates"), STAT_TankAttributeSnapshot_Updates, STATGROUP_TRTank);
+
+UTankAttributeSnapshotComponent::UTankAttributeSnapshotComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+const FTankAttributeSnapshot& UTankAttributeSnapshotComponent::GetSnapshot() const
+{
+	// Each read replaces a tag lookup and ability system component query
+	INC_DWORD_STAT(STAT_TankAttributeSnapshot_LookupsAvoided);
+
+	return Snapshot;
+}
+
+void UTankAttributeSnapshotComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Resolve once instead of on every read
+	SpeedMultiplierTag = *TR::GameplayTags::GetTagByName(TR::GameplayTags::SpeedMultiplier);
+	MovementBlockedTag = *TR::GameplayTags::GetTagByName(TR::GameplayTags::MovementBlocked);
+	AimBlockedTag = *TR::GameplayTags::GetTagByName(TR::GameplayTags::AimBlocked);
+
+	BindAbilitySystemEvents();
+}
+
+void UTankAttributeSnapshotComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UnbindAbilitySystemEvents();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UTankAttributeSnapshotComponent::BindAbilitySystemEvents()
+{
+	UnbindAbilitySystemEvents();
+
+	// Tag counts are tracked by the component before the actor info is initialized on possession so can bind right away
+	auto AbilitySystemComponent = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(GetOwner());
+	if (!AbilitySystemComponent)
+	{
+		UE_VLOG_UELOG(GetOwner(), LogTRTank, Warning, TEXT("%s-%s: BindAbilitySystemEvents - No ability system component; snapshot will keep its defaults"),
+			*LoggingUtils::GetName(GetOwner()), *GetName());
+		return;
+	}
+
+	BoundAbilitySystemComponent = AbilitySystemComponent;
+
+	for (const auto& Tag : { SpeedMultiplierTag, MovementBlockedTag, AimBlockedTag })
+	{
+		// The speed multiplier is encoded in the tag count so need every count change and not just added or removed
+		auto& Delegate = AbilitySystemComponent->RegisterGameplayTagEvent(Tag, EGameplayTagEventType::AnyCountChange);
+
+		TagBindings.Add(FTagBinding
+		{
+			.Tag = Tag,
+			.Handle = Delegate.AddUObject(this, &ThisClass::OnTagCountChanged)
+		});
+	}
+
+	Refresh();
+}
+
+void UTankAttributeSnapshotComponent::UnbindAbilitySystemEvents()
+{
+	if (auto AbilitySystemComponent = BoundAbilitySystemComponent.Get(); AbilitySystemComponent)
+	{
+		for (const auto& Binding : TagBindings)
+		{
+			AbilitySystemComponent->UnregisterGameplayTagEvent(Binding.Handle, Binding.Tag, EGameplayTagEventType::AnyCountChange);
+		}
+	}
+
+	TagBindings.Reset();
+	BoundAbilitySystemComponent.Reset();
+}
+
+void UTankAttributeSnapshotComponent::Refresh()
+{
+	auto AbilitySystemComponent = BoundAbilitySystemComponent.Get();
+	if (!AbilitySystemComponent)
+	{
+		return;
+	}
+
+	for (const auto& Binding : TagBindings)
+	{
+		ApplyTagCount(Binding.Tag, AbilitySystemComponent->GetGameplayTagCount(Binding.Tag));
+	}
+}
+
+void UTankAttributeSnapshotComponent::OnTagCountChanged(const FGameplayTag Tag, int32 NewCount)
+{
+	ApplyTagCount(Tag, NewCount);
+
+	UE_VLOG_UELOG(GetOwner(), LogTRTank, Verbose, TEXT("%s-%s: OnTagCountChanged - Tag=%s; NewCount=%d; SpeedMultiplier=%f; bMovementBlocked=%s; bAimBlocked=%s"),
+		*LoggingUtils::GetName(GetOwner()), *GetName(), *Tag.ToString(), NewCount,
+		Snapshot.SpeedMultiplier, LoggingUtils::GetBoolString(Snapshot.bMovementBlocked), LoggingUtils::GetBoolString(Snapshot.bAimBlocked));
+}
+
+void UTankAttributeSnapshotComponent::ApplyTagCount(const FGameplayTag& Tag, int32 Count)
+{
+	INC_DWORD_STAT(STAT_TankAttributeSnapshot_Updates);
+
+	// Same values as TR::GameplayTags::GetAttributeMultiplierFromTag and TR::GameplayTags::HasExactTag
+	if (Tag == SpeedMultiplierTag)
+	{
+		Snapshot.SpeedMultiplier = Count > 0 ? TR::GameplayTags::AttributeMultiplierTagCountToValueFloat(Count) : 1.0f;
+	}
+	else if (Tag == MovementBlockedTag)
+	{
+		Snapshot.bMovementBlocked = Count > 0;
+	}
+	else if (Tag == AimBlockedTag)
+	{
+		Snapshot.bAimBlocked = Count > 0;
+	}
+}
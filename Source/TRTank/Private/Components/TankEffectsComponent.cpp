@@ -9,9 +9,10 @@
 #include "Logging/LoggingUtils.h"
 #include "VisualLogger/VisualLogger.h"
 
-#include "NiagaraFunctionLibrary.h"
 #include "NiagaraComponent.h"
 
+#include "Subsystems/VfxManagerSubsystem.h"
+
 #include "Pawn/BaseTankPawn.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(TankEffectsComponent)
@@ -45,18 +46,35 @@ void UTankEffectsComponent::PlayDeathVfx()
 
 	const auto& Location = GetExplosionLocation();
 
-	UE_VLOG_UELOG(GetOwner(), LogTRTank, Log, TEXT("%s: PlayHitVfx: %s playing at %s"), *GetName(), *DeathVfx.GetName(), *Location.ToCompactString());
-
-	UNiagaraComponent* NiagaraComp = UNiagaraFunctionLibrary::SpawnSystemAtLocation(this, DeathVfx, Location);
-
-	UE_VLOG_UELOG(GetOwner(), LogTRTank, Log, TEXT("%s: PlayHitVfx: %s playing NiagaraComponent=%s"), *GetName(), *DeathVfx.GetName(), *LoggingUtils::GetName(NiagaraComp));
+	auto World = GetWorld();
+	check(World);
 
-	if (!NiagaraComp)
+	auto VfxManagerSubsystem = World->GetSubsystem<UVfxManagerSubsystem>();
+	if (!ensure(VfxManagerSubsystem))
 	{
 		return;
 	}
 
-	SetNiagaraDeathEffectParameters(NiagaraComp);
+	UE_VLOG_UELOG(GetOwner(), LogTRTank, Log, TEXT("%s: PlayDeathVfx: %s queued at %s"), *GetName(), *DeathVfx.GetName(), *Location.ToCompactString());
+
+	// Parameters are captured now as the tank is usually destroyed in the same frame before the effect is spawned
+	const FName ScaleParameterName = DeathVfxScaleParameterName;
+	const float ScaleParameterValue = DeathVfxScaleParameterValue;
+
+	// Tank deaths are rarer and more important than hits so are kept over them when over the spawn budget
+	VfxManagerSubsystem->SpawnVfx(FVfxSpawnRequest
+	{
+		.System = DeathVfx,
+		.Location = Location,
+		.Priority = EVfxPriority::High,
+		.OnSpawned = FOnVfxSpawned::CreateLambda([ScaleParameterName, ScaleParameterValue](UNiagaraComponent& NiagaraComponent)
+		{
+			if (!ScaleParameterName.IsNone())
+			{
+				NiagaraComponent.SetFloatParameter(ScaleParameterName, ScaleParameterValue);
+			}
+		})
+	});
 }
 
 void UTankEffectsComponent::OnTankDestroyed(ABaseTankPawn* DestroyedTank, AController* DestroyedBy, AActor* DestroyedWith)
@@ -80,13 +98,3 @@ FVector UTankEffectsComponent::GetExplosionLocation() const
 
 	return InitialLocation + Actor->GetActorUpVector() * ExplosionZOffset;
 }
-
-void UTankEffectsComponent::SetNiagaraDeathEffectParameters_Implementation(UNiagaraComponent* NiagaraComponent)
-{
-	check(NiagaraComponent);
-
-	if (!DeathVfxScaleParameterName.IsNone())
-	{
-		NiagaraComponent->SetFloatParameter(DeathVfxScaleParameterName, DeathVfxScaleParameterValue);
-	}
-}
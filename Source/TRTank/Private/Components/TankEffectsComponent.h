@@ -7,7 +7,6 @@
 #include "TankEffectsComponent.generated.h"
 
 class UNiagaraSystem;
-class UNiagaraComponent;
 class ABaseTankPawn;
 
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
@@ -15,15 +14,14 @@ class UTankEffectsComponent : public UActorComponent
 {
 	GENERATED_BODY()
 
+	friend class FTankEffectsComponentOwnerDestroyedTest;
+
 public:	
 	UTankEffectsComponent();
 
 protected:
 	virtual void BeginPlay() override;
 
-	UFUNCTION(BlueprintNativeEvent)
-	void SetNiagaraDeathEffectParameters(UNiagaraComponent* NiagaraComponent);
-
 private:
 	void PlayDeathVfx();
 
@@ -4,6 +4,7 @@
 #include "Components/TankMovementComponent.h"
 
 #include "Components/TankTrackComponent.h"
+#include "Components/TankAttributeSnapshotComponent.h"
 
 #include "AbilitySystem/TRGameplayTags.h"
 
@@ -35,9 +36,11 @@ void UTankMovementComponent::Initialize(const FInitParams& InitParams)
 
 	LeftTrack = InitParams.LeftTrack;
 	RightTrack = InitParams.RightTrack;
+	AttributeSnapshot = InitParams.AttributeSnapshot;
 
 	check(LeftTrack);
 	check(RightTrack);
+	check(AttributeSnapshot);
 }
 
 void UTankMovementComponent::MoveForward(float Throw)
@@ -119,7 +122,7 @@ void UTankMovementComponent::RequestPathMove(const FVector& MoveInput)
 bool UTankMovementComponent::IsMovementAllowed() const
 {
 	// Check if owning actor has a debuff to block movement
-	if (TR::GameplayTags::HasExactTag(GetOwner(), TR::GameplayTags::MovementBlocked))
+	if (AttributeSnapshot->GetSnapshot().bMovementBlocked)
 	{
 		UE_VLOG_UELOG(GetOwner(), LogTRTank, Verbose, TEXT("%s-%s: IsMovementAllowed: FALSE - By GameplayTag=%s"),
 			*LoggingUtils::GetName(GetOwner()), *GetName(), *TR::GameplayTags::MovementBlocked.ToString());
@@ -147,8 +150,8 @@ void UTankMovementComponent::MoveTo(const FVector& MoveDirectionStrength)
 
 FString UTankMovementComponent::FInitParams::ToString() const
 {
-	return FString::Printf(TEXT("LeftTrack=%s; RightTrack=%s"),
-		*LoggingUtils::GetName(LeftTrack), *LoggingUtils::GetName(RightTrack));
+	return FString::Printf(TEXT("LeftTrack=%s; RightTrack=%s; AttributeSnapshot=%s"),
+		*LoggingUtils::GetName(LeftTrack), *LoggingUtils::GetName(RightTrack), *LoggingUtils::GetName(AttributeSnapshot));
 }
 
 
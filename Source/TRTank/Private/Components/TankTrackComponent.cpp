@@ -5,7 +5,10 @@
 
 #include "TankSockets.h"
 #include "AbilitySystem/TRGameplayTags.h"
+#include "Components/TankAttributeSnapshotComponent.h"
 #include "Suspension/SpringWheel.h"
+#include "Subsystems/TankGroundProbeSubsystem.h"
+#include "Subsystems/TankRecoverySubsystem.h"
 #include "Components/SpawnPoint.h"
 
 #include "Utils/CollisionUtils.h"
@@ -15,6 +18,7 @@
 
 #include "VisualLogger/VisualLogger.h"
 #include "Debug/TRDebugUtils.h"
+#include "Debug/TRCsvProfiler.h"
 
 #include "GameFramework/MovementComponent.h" 
 
@@ -303,7 +307,9 @@ bool UTankTrackComponent::HasSuspension() const
 
 float UTankTrackComponent::GetAdjustedMaxDrivingForce(bool bLog) const
 {
-	const auto DrivingForceMultiplier = TR::GameplayTags::GetAttributeMultiplierFromTag(GetOwner(), TR::GameplayTags::SpeedMultiplier);
+	// Tracks not on a tank pawn have no snapshot
+	const auto DrivingForceMultiplier = AttributeSnapshot ? AttributeSnapshot->GetSnapshot().SpeedMultiplier
+		: TR::GameplayTags::GetAttributeMultiplierFromTag(GetOwner(), TR::GameplayTags::SpeedMultiplier);
 	const auto StuckBoostMultiplier = (bStuckBoostActive ? ThrottleBoostMultiplier : 1.0f);
 	const auto AdjustedMaxDrivingForce = DrivingForceMultiplier * StuckBoostMultiplier * TrackMaxDrivingForce;
 
@@ -431,7 +437,8 @@ void UTankTrackComponent::CalculateStuck()
 	{
 		LastStuckTime = World->GetTimeSeconds();
 	}
-	else if (bIsStuck && StuckBeyondResetThreshold())
+	// The recovery subsystem frees stuck tanks when enabled but the throttle boost still applies
+	else if (bIsStuck && StuckBeyondResetThreshold() && !UTankRecoverySubsystem::IsEnabled())
 	{
 		ResetTankTransform();
 	}
@@ -538,6 +545,23 @@ void UTankTrackComponent::CalculateGrounded()
 
 	LastGroundTraceTime = World->GetTimeSeconds();
 
+	// Traces are only drawn by the synchronous path so use it while the visual logger is recording
+	const bool bVisualLoggerRecording =
+#if ENABLE_VISUAL_LOG
+		FVisualLogger::IsRecording();
+#else
+		false;
+#endif
+
+	if (UTankGroundProbeSubsystem::IsEnabled() && !bVisualLoggerRecording)
+	{
+		if (auto GroundProbeSubsystem = World->GetSubsystem<UTankGroundProbeSubsystem>(); ensure(GroundProbeSubsystem))
+		{
+			QueueGroundProbes(*GroundProbeSubsystem);
+			return;
+		}
+	}
+
 	for (auto& Wheel : TrackWheels)
 	{
 		const auto& Transform = GetSocketTransform(Wheel.SocketName);
@@ -546,6 +570,54 @@ void UTankTrackComponent::CalculateGrounded()
 	}
 }
 
+void UTankTrackComponent::QueueGroundProbes(UTankGroundProbeSubsystem& GroundProbeSubsystem)
+{
+	// Keep the last results until the outstanding probes complete
+	if (bGroundProbesPending)
+	{
+		return;
+	}
+
+	auto Owner = GetOwner();
+	check(Owner);
+
+	TArray<FGroundProbeRay, TInlineAllocator<16>> Rays;
+	Rays.Reserve(TrackWheels.Num());
+
+	for (const auto& Wheel : TrackWheels)
+	{
+		const auto& Transform = GetSocketTransform(Wheel.SocketName);
+		const auto& WorldLocation = Transform.GetLocation();
+		const auto& WorldUpVector = Transform.GetRotation().GetUpVector();
+
+		Rays.Add(FGroundProbeRay
+		{
+			.Start = WorldLocation + WorldUpVector * GroundTraceExtent,
+			.End = WorldLocation - WorldUpVector * GroundTraceExtent
+		});
+	}
+
+	bGroundProbesPending = true;
+
+	GroundProbeSubsystem.QueueProbes(*Owner, Rays, {}, FOnGroundProbesCompleted::CreateUObject(this, &ThisClass::OnGroundProbesCompleted));
+}
+
+void UTankTrackComponent::OnGroundProbesCompleted(TConstArrayView<bool> Grounded)
+{
+	bGroundProbesPending = false;
+
+	// Abandoned or wheels changed since the probes were queued
+	if (Grounded.Num() != TrackWheels.Num())
+	{
+		return;
+	}
+
+	for (int32 i = 0; i < TrackWheels.Num(); ++i)
+	{
+		TrackWheels[i].bGrounded = Grounded[i];
+	}
+}
+
 bool UTankTrackComponent::IsGroundedFallback() const
 {
 	return IsGroundedLocation(GetComponentLocation(), GetUpVector());
@@ -647,6 +719,7 @@ void UTankTrackComponent::ApplySidewaysForce(float DeltaTime)
 void UTankTrackComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
 	SCOPE_CYCLE_COUNTER(STAT_TankTrackComponent_Tick);
+	CSV_SCOPED_TIMING_STAT(TR, TankTrackComponent_Tick);
 
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
@@ -702,6 +775,11 @@ void UTankTrackComponent::DescribeSelfToVisLog(FVisualLogEntry* Snapshot) const
 	Category.Add(TEXT("Suspension"), LoggingUtils::GetBoolString(bSuspension));
 	Category.Add(TEXT("Wheels"), FString::Printf(TEXT("%d"), bSuspension ? Wheels.Num() : TrackWheels.Num()));
 
+	if (auto GroundProbeSubsystem = GetWorld()->GetSubsystem<UTankGroundProbeSubsystem>(); GroundProbeSubsystem && GetOwner())
+	{
+		Category.Add(TEXT("GroundProbeTraces"), FString::Printf(TEXT("%d"), GroundProbeSubsystem->GetTraceCount(*GetOwner())));
+	}
+
 	Snapshot->Status.Add(Category);
 
 	// Need to grab wheel snapshot after adding the category
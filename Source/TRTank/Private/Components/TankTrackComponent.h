@@ -10,6 +10,8 @@
 #include "TankTrackComponent.generated.h"
 
 class ASpringWheel;
+class UTankGroundProbeSubsystem;
+class UTankAttributeSnapshotComponent;
 
 /**
  * Tank track is used to set maximum driving force, and to apply forces to the tank.
@@ -43,6 +45,8 @@ public:
 	UFUNCTION(BlueprintPure)
 	float GetThrottle() const;
 
+	void SetAttributeSnapshot(UTankAttributeSnapshotComponent* InAttributeSnapshot);
+
 protected:
 	virtual void BeginPlay() override;
 	virtual void InitializeComponent() override;
@@ -76,6 +80,8 @@ private:
 
 	bool ShouldRecalculateGrounded() const;
 	void CalculateGrounded();
+	void QueueGroundProbes(UTankGroundProbeSubsystem& GroundProbeSubsystem);
+	void OnGroundProbesCompleted(TConstArrayView<bool> Grounded);
 	bool IsGroundedFallback() const;
 
 	bool IsGroundedLocation(const FVector& WorldLocation, const FVector& WorldUpVector) const;
@@ -111,6 +117,9 @@ private:
 	UPROPERTY(Transient)
 	TArray<ASpringWheel*> Wheels;
 
+	UPROPERTY(Transient)
+	TObjectPtr<UTankAttributeSnapshotComponent> AttributeSnapshot{};
+
 	using FVectorBuffer = TR::TTimedCircularBuffer <
 		FVector,
 		decltype([]() { return FVector{ ForceInitToZero }; }),
@@ -174,6 +183,7 @@ private:
 
 	bool bStuckCheckingEnabled{};
 	bool bStuckBoostActive{};
+	bool bGroundProbesPending{};
 };
 
 #pragma region Inline Definitions
@@ -188,4 +198,9 @@ FORCEINLINE float UTankTrackComponent::GetThrottle() const
 	return LastThrottle;
 }
 
+inline void UTankTrackComponent::SetAttributeSnapshot(UTankAttributeSnapshotComponent* InAttributeSnapshot)
+{
+	AttributeSnapshot = InAttributeSnapshot;
+}
+
 #pragma endregion Inline Definitions
\ No newline at end of file
@@ -14,6 +14,7 @@
 #include "Components/TankCollisionDetectionComponent.h"
 #include "Components/TankCrashComponent.h"
 #include "Components/TankEngineSoundsComponent.h"
+#include "Components/TankAttributeSnapshotComponent.h"
 
 #include "GameFramework/SpringArmComponent.h"
 #include "Camera/CameraComponent.h"
@@ -26,6 +27,10 @@
 #include "Item/ItemInventory.h"
 
 #include "Subsystems/TankEventsSubsystem.h"
+#include "Subsystems/PawnSpatialHashSubsystem.h"
+#include "Subsystems/TankRecoverySubsystem.h"
+
+#include "Debug/TRCsvProfiler.h"
 
 #include "TRTankLogging.h"
 #include "Logging/LoggingUtils.h"
@@ -100,6 +105,7 @@ ABaseTankPawn::ABaseTankPawn()
 	AbilitySystemComponent->SetIsReplicated(true);
 
 	AttributeSet = CreateDefaultSubobject<UTRAttributeSet>(TEXT("Attribute Set"));
+	AttributeSnapshotComponent = CreateDefaultSubobject<UTankAttributeSnapshotComponent>(TEXT("Attribute Snapshot"));
 
 	ItemInventoryComponent = CreateDefaultSubobject<UItemInventory>(TEXT("Item Inventory"));
 
@@ -119,6 +125,20 @@ void ABaseTankPawn::BeginPlay()
 
 	// Cannot call this in the constructor
 	TankBody->SetMassOverrideInKg(NAME_None, 40000);
+
+	// Spawned enemies are also registered from the enemy spawned event but the player and any placed tanks are not
+	auto World = GetWorld();
+	check(World);
+
+	if (auto PawnSpatialHashSubsystem = World->GetSubsystem<UPawnSpatialHashSubsystem>(); ensure(PawnSpatialHashSubsystem))
+	{
+		PawnSpatialHashSubsystem->RegisterPawn(*this);
+	}
+
+	if (auto TankRecoverySubsystem = World->GetSubsystem<UTankRecoverySubsystem>(); ensure(TankRecoverySubsystem))
+	{
+		TankRecoverySubsystem->RegisterTank(*this);
+	}
 }
 
 void ABaseTankPawn::PostInitializeComponents()
@@ -130,7 +150,8 @@ void ABaseTankPawn::PostInitializeComponents()
 		TankAimingComponent->SetTankComponents(
 			{
 					.Barrel = TankBarrel,
-					.Turret = TankTurret
+					.Turret = TankTurret,
+					.AttributeSnapshot = AttributeSnapshotComponent
 			});
 	}
 
@@ -139,7 +160,8 @@ void ABaseTankPawn::PostInitializeComponents()
 		TankMovementComponent->Initialize(
 			{
 				.LeftTrack = TankTreadLeft,
-				.RightTrack = TankTreadRight
+				.RightTrack = TankTreadRight,
+				.AttributeSnapshot = AttributeSnapshotComponent
 			});
 	}
 
@@ -147,6 +169,9 @@ void ABaseTankPawn::PostInitializeComponents()
 		&& ensureMsgf(TankTreadLeft, TEXT("TankTreadLeft"))
 		&& ensureMsgf(TankTreadRight, TEXT("TankTreadRight")))
 	{
+		TankTreadLeft->SetAttributeSnapshot(AttributeSnapshotComponent);
+		TankTreadRight->SetAttributeSnapshot(AttributeSnapshotComponent);
+
 		TankCollisionDetectionComponent->OnRelevantCollision.AddUObject(TankTreadLeft, &UTankTrackComponent::NotifyRelevantTankCollision);
 		TankCollisionDetectionComponent->OnRelevantCollision.AddUObject(TankTreadRight, &UTankTrackComponent::NotifyRelevantTankCollision);
 	}
@@ -289,6 +314,7 @@ float ABaseTankPawn::GetFireCooldownProgressPercentage() const
 void ABaseTankPawn::AimAt(const FAimingData& AimingData)
 {
 	SCOPE_CYCLE_COUNTER(STAT_BaseTankPawn_Aim);
+	CSV_SCOPED_TIMING_STAT(TR, BaseTankPawn_Aim);
 
 	auto ActiveWeapon = ItemInventoryComponent->GetActiveWeapon();
 	if (!ActiveWeapon)
@@ -0,0 +1,343 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Recovery/TankRecoveryClassifier.h"
+
+#include "TRConstants.h"
+#include "TRTankLogging.h"
+
+#if TR_DEBUG_ENABLED
+	#include "HAL/IConsoleManager.h"
+	#include "Utils/RandUtils.h"
+#endif
+
+namespace
+{
+	using namespace TR;
+
+	constexpr ETankRecoveryAction StuckLadder[] = { ETankRecoveryAction::ReverseAndTurn, ETankRecoveryAction::ReverseAndTurn, ETankRecoveryAction::Lift, ETankRecoveryAction::Teleport };
+
+	/* Reversing straight back into the same scenery is less likely to help so lift sooner. */
+	constexpr ETankRecoveryAction WedgedLadder[] = { ETankRecoveryAction::ReverseAndTurn, ETankRecoveryAction::Lift, ETankRecoveryAction::Teleport };
+
+	constexpr ETankRecoveryAction FlippedLadder[] = { ETankRecoveryAction::Lift, ETankRecoveryAction::Lift, ETankRecoveryAction::Teleport };
+
+	/* No traction to reverse with. */
+	constexpr ETankRecoveryAction AirborneLadder[] = { ETankRecoveryAction::Lift, ETankRecoveryAction::Teleport };
+}
+
+namespace TR
+{
+	const TCHAR* LexToString(ETankRecoveryState State)
+	{
+		switch (State)
+		{
+			case ETankRecoveryState::None: return TEXT("None");
+			case ETankRecoveryState::Stuck: return TEXT("Stuck");
+			case ETankRecoveryState::Wedged: return TEXT("Wedged");
+			case ETankRecoveryState::Flipped: return TEXT("Flipped");
+			case ETankRecoveryState::Airborne: return TEXT("Airborne");
+			default: return TEXT("Unknown");
+		}
+	}
+
+	const TCHAR* LexToString(ETankRecoveryAction Action)
+	{
+		switch (Action)
+		{
+			case ETankRecoveryAction::None: return TEXT("None");
+			case ETankRecoveryAction::ReverseAndTurn: return TEXT("ReverseAndTurn");
+			case ETankRecoveryAction::Lift: return TEXT("Lift");
+			case ETankRecoveryAction::Teleport: return TEXT("Teleport");
+			default: return TEXT("Unknown");
+		}
+	}
+
+	FString FTankRecoveryDecision::ToString() const
+	{
+		return FString::Printf(TEXT("State=%s; Action=%s; Attempt=%d; StateSeconds=%.1f; Displacement=%.2fm; Throttle=%.2f; Blocked=%.2f; Up=%.2f; Speed=%.1f"),
+			LexToString(State), LexToString(Action), Attempt, StateSeconds, Displacement / 100, ThrottleAverage, BlockedFraction, UpAlignment, Speed);
+	}
+
+	FTankRecoveryClassifier::FTankRecoveryClassifier(const FTankRecoveryConfig& InConfig) :
+		Config(InConfig),
+		PositionBuffer(InConfig.WindowSeconds, InConfig.SampleIntervalSeconds),
+		ThrottleBuffer(InConfig.WindowSeconds, InConfig.SampleIntervalSeconds),
+		BlockedBuffer(InConfig.WindowSeconds, InConfig.SampleIntervalSeconds)
+	{
+	}
+
+	FTankRecoveryDecision FTankRecoveryClassifier::AddSample(float TimeSeconds, const FTankRecoverySignal& Signal)
+	{
+		PositionBuffer.Add(Signal.Location);
+		ThrottleBuffer.Add(Signal.Throttle);
+		BlockedBuffer.Add(Signal.bBlocked ? 1.0f : 0.0f);
+
+		const auto NewState = Classify(Signal);
+		if (NewState != State)
+		{
+			State = NewState;
+			StateStartTime = TimeSeconds;
+
+			// Recovering keeps the ladder position in case the tank falls straight back into the same state
+			if (State != ETankRecoveryState::None && (State != RespondedState || TimeSeconds - LastResponseTime > Config.RelapseSeconds))
+			{
+				Attempt = 0;
+				RespondedState = ETankRecoveryState::None;
+			}
+		}
+
+		FTankRecoveryDecision Decision
+		{
+			.State = State,
+			.Attempt = Attempt,
+			.StateSeconds = TimeSeconds - StateStartTime,
+			.Displacement = static_cast<float>(PositionBuffer.Delta().Size()),
+			.ThrottleAverage = ThrottleBuffer.Average(),
+			.BlockedFraction = BlockedBuffer.Average(),
+			.UpAlignment = Signal.UpAlignment,
+			.Speed = Signal.Speed
+		};
+
+		if (State == ETankRecoveryState::None || Decision.StateSeconds + UE_KINDA_SMALL_NUMBER < GetResponseDelay(State))
+		{
+			return Decision;
+		}
+
+		if (RespondedState == State && TimeSeconds - LastResponseTime + UE_KINDA_SMALL_NUMBER < Config.ResponseIntervalSeconds)
+		{
+			return Decision;
+		}
+
+		const auto Ladder = GetResponseLadder(State);
+		check(!Ladder.IsEmpty());
+
+		// Keep teleporting once at the top of the ladder
+		Decision.Action = Ladder[FMath::Min(Attempt, Ladder.Num() - 1)];
+
+		++Attempt;
+		RespondedState = State;
+		LastResponseTime = TimeSeconds;
+
+		return Decision;
+	}
+
+	void FTankRecoveryClassifier::Reset()
+	{
+		PositionBuffer.Clear();
+		ThrottleBuffer.Clear();
+		BlockedBuffer.Clear();
+
+		State = RespondedState = ETankRecoveryState::None;
+		StateStartTime = 0;
+		LastResponseTime = -1;
+		Attempt = 0;
+	}
+
+	TConstArrayView<ETankRecoveryAction> FTankRecoveryClassifier::GetResponseLadder(ETankRecoveryState State)
+	{
+		switch (State)
+		{
+			case ETankRecoveryState::Stuck: return StuckLadder;
+			case ETankRecoveryState::Wedged: return WedgedLadder;
+			case ETankRecoveryState::Flipped: return FlippedLadder;
+			case ETankRecoveryState::Airborne: return AirborneLadder;
+			default: return {};
+		}
+	}
+
+	ETankRecoveryState FTankRecoveryClassifier::Classify(const FTankRecoverySignal& Signal) const
+	{
+		// A flipped tank also cannot make progress so check before stuck
+		if (Signal.UpAlignment < Config.FlippedUpAlignment)
+		{
+			return Signal.Speed < Config.MaxFlippedSpeed ? ETankRecoveryState::Flipped : ETankRecoveryState::None;
+		}
+
+		if (!Signal.bGrounded)
+		{
+			return Signal.Speed < Config.MaxAirborneSpeed ? ETankRecoveryState::Airborne : ETankRecoveryState::None;
+		}
+
+		if (!PositionBuffer.IsFull() || FMath::Abs(ThrottleBuffer.Average()) < Config.MinStuckThrottle ||
+			PositionBuffer.Delta().SizeSquared() > FMath::Square(Config.StuckDisplacement))
+		{
+			return ETankRecoveryState::None;
+		}
+
+		return BlockedBuffer.Average() >= Config.WedgedBlockedFraction ? ETankRecoveryState::Wedged : ETankRecoveryState::Stuck;
+	}
+
+	float FTankRecoveryClassifier::GetResponseDelay(ETankRecoveryState InState) const
+	{
+		switch (InState)
+		{
+			case ETankRecoveryState::Flipped: return Config.FlippedDelaySeconds;
+			case ETankRecoveryState::Airborne: return Config.AirborneDelaySeconds;
+			default: return 0;
+		}
+	}
+}
+
+#pragma region Verification
+
+#if TR_DEBUG_ENABLED
+
+namespace
+{
+	using FSignalFunc = TFunction<FTankRecoverySignal()>;
+
+	/*
+	* Feeds a synthetic trace to the classifier at the configured sample rate and returns the responses made.
+	*/
+	TArray<FTankRecoveryDecision> RunTrace(FTankRecoveryClassifier& Classifier, float& TimeSeconds, float DurationSeconds, const FSignalFunc& SignalFunc)
+	{
+		TArray<FTankRecoveryDecision> Decisions;
+
+		const auto SampleInterval = Classifier.GetConfig().SampleIntervalSeconds;
+
+		for (const auto EndTime = TimeSeconds + DurationSeconds; TimeSeconds < EndTime; TimeSeconds += SampleInterval)
+		{
+			if (const auto Decision = Classifier.AddSample(TimeSeconds, SignalFunc()); Decision.Action != ETankRecoveryAction::None)
+			{
+				Decisions.Add(Decision);
+			}
+		}
+
+		return Decisions;
+	}
+
+	bool ExpectActions(const TCHAR* Scenario, const TArray<FTankRecoveryDecision>& Decisions, ETankRecoveryState ExpectedState, TConstArrayView<ETankRecoveryAction> ExpectedActions)
+	{
+		bool bPassed = Decisions.Num() >= ExpectedActions.Num();
+
+		for (int32 i = 0; bPassed && i < ExpectedActions.Num(); ++i)
+		{
+			bPassed = Decisions[i].State == ExpectedState && Decisions[i].Action == ExpectedActions[i] && Decisions[i].Attempt == i;
+		}
+
+		if (!bPassed)
+		{
+			UE_LOG(LogTRTank, Error, TEXT("RunTankRecoveryVerification: %s - Expected %d %s responses but got %d%s%s"),
+				Scenario, ExpectedActions.Num(), LexToString(ExpectedState), Decisions.Num(),
+				Decisions.IsEmpty() ? TEXT("") : TEXT(" - First: "), Decisions.IsEmpty() ? TEXT("") : *Decisions[0].ToString());
+		}
+
+		return bPassed;
+	}
+
+	/*
+	* Feeds synthetic signal traces for driving, idling, stuck, wedged, flipped, perched and jumping tanks to the classifier
+	* and checks the states and response ladders it produces.
+	*/
+	void RunTankRecoveryVerification(const TArray<FString>& Args)
+	{
+		const float Noise = Args.Num() > 0 ? FMath::Max(0.0f, FCString::Atof(*Args[0])) : 5.0f;
+
+		FRandomStream Rng(RandUtils::GenerateSeed());
+
+		// Position carried across traces so that switching between them doesn't look like a jump
+		FVector Position{ ForceInitToZero };
+		int32 SampleCount{};
+
+		// Sensor jitter well under the stuck displacement
+		auto Jittered = [&]() { return Position + FVector(Rng.FRandRange(-Noise, Noise), Rng.FRandRange(-Noise, Noise), 0); };
+
+		auto Driving = [&]()
+		{
+			Position += FVector(50, 0, 0);
+			return FTankRecoverySignal{ .Location = Jittered(), .Speed = 500, .Throttle = 1 };
+		};
+
+		auto Stationary = [&](float Throttle, bool bBlocked = false)
+		{
+			return [&, Throttle, bBlocked]()
+			{
+				return FTankRecoverySignal{ .Location = Jittered(), .Speed = Rng.FRandRange(0, 10), .Throttle = Throttle, .bBlocked = bBlocked && (++SampleCount % 2 == 0) };
+			};
+		};
+
+		int32 Failures{};
+		float TimeSeconds{};
+
+		{
+			FTankRecoveryClassifier Classifier;
+			Failures += !RunTrace(Classifier, TimeSeconds, 20, Driving).IsEmpty();
+			Failures += !RunTrace(Classifier, TimeSeconds, 20, Stationary(0.1f)).IsEmpty();
+		}
+
+		{
+			FTankRecoveryClassifier Classifier;
+			Failures += !ExpectActions(TEXT("Stuck"), RunTrace(Classifier, TimeSeconds, 20, Stationary(1.0f)), ETankRecoveryState::Stuck, StuckLadder);
+		}
+
+		{
+			FTankRecoveryClassifier Classifier;
+			Failures += !ExpectActions(TEXT("Wedged"), RunTrace(Classifier, TimeSeconds, 20, Stationary(-1.0f, true)), ETankRecoveryState::Wedged, WedgedLadder);
+		}
+
+		{
+			FTankRecoveryClassifier Classifier;
+			const auto Decisions = RunTrace(Classifier, TimeSeconds, 20, [&]()
+			{
+				return FTankRecoverySignal{ .Location = Jittered(), .UpAlignment = -0.8f, .Speed = 5, .Throttle = 1 };
+			});
+
+			Failures += !ExpectActions(TEXT("Flipped"), Decisions, ETankRecoveryState::Flipped, FlippedLadder);
+			Failures += !Decisions.IsEmpty() && Decisions[0].StateSeconds + UE_KINDA_SMALL_NUMBER < Classifier.GetConfig().FlippedDelaySeconds;
+		}
+
+		{
+			FTankRecoveryClassifier Classifier;
+			Failures += !ExpectActions(TEXT("Perched"), RunTrace(Classifier, TimeSeconds, 20, [&]()
+			{
+				return FTankRecoverySignal{ .Location = Jittered(), .Speed = 2, .Throttle = 1, .bGrounded = false };
+			}), ETankRecoveryState::Airborne, AirborneLadder);
+		}
+
+		{
+			// Short fast jumps between driving are left alone
+			FTankRecoveryClassifier Classifier;
+			for (int32 i = 0; i < 5; ++i)
+			{
+				Failures += !RunTrace(Classifier, TimeSeconds, 2, [&]()
+				{
+					Position += FVector(80, 0, 20);
+					return FTankRecoverySignal{ .Location = Position, .Speed = 800, .Throttle = 1, .bGrounded = false };
+				}).IsEmpty();
+
+				Failures += !RunTrace(Classifier, TimeSeconds, 2, Driving).IsEmpty();
+			}
+		}
+
+		{
+			// Getting free briefly and then stuck again continues up the ladder
+			FTankRecoveryClassifier Classifier;
+			const auto WindowSeconds = Classifier.GetConfig().WindowSeconds;
+
+			const auto First = RunTrace(Classifier, TimeSeconds, WindowSeconds + 0.5f, Stationary(1.0f));
+			RunTrace(Classifier, TimeSeconds, 1, Driving);
+			const auto Relapse = RunTrace(Classifier, TimeSeconds, WindowSeconds + 0.5f, Stationary(1.0f));
+
+			Failures += !ExpectActions(TEXT("Relapse"), First, ETankRecoveryState::Stuck, MakeArrayView(StuckLadder, 1));
+			Failures += Relapse.IsEmpty() || Relapse[0].Attempt != 1 || Relapse[0].Action != StuckLadder[1];
+
+			// Teleport forgets the history
+			Classifier.Reset();
+			Failures += Classifier.GetState() != ETankRecoveryState::None;
+			Failures += !RunTrace(Classifier, TimeSeconds, WindowSeconds - 0.5f, Stationary(1.0f)).IsEmpty();
+		}
+
+		UE_LOG(LogTRTank, Display, TEXT("RunTankRecoveryVerification: %s - Noise=%.1fcm; Failures=%d"),
+			Failures == 0 ? TEXT("PASSED") : TEXT("FAILED"), Noise, Failures);
+	}
+
+	FAutoConsoleCommandWithArgs TankRecoveryVerifyCommand(
+		TEXT("tr.tank.recovery.verify"),
+		TEXT("Feeds synthetic signal traces to the tank recovery classifier and checks the states and responses: [NoiseCm=5]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunTankRecoveryVerification));
+}
+
+#endif
+
+#pragma endregion Verification
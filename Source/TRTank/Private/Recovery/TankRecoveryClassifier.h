@@ -0,0 +1,191 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Containers/TimedCircularBuffer.h"
+
+namespace TR
+{
+	enum class ETankRecoveryState : uint8
+	{
+		None,
+
+		/* Throttle held but the tank is not getting anywhere. */
+		Stuck,
+
+		/* Stuck while repeatedly colliding with steep scenery. */
+		Wedged,
+
+		/* Resting on its side or roof. */
+		Flipped,
+
+		/* Not touching the ground while not moving, e.g. high centered on debris or another tank. */
+		Airborne,
+
+		MAX
+	};
+
+	const TCHAR* LexToString(ETankRecoveryState State);
+
+	/* Responses in order of increasing severity. */
+	enum class ETankRecoveryAction : uint8
+	{
+		None,
+		ReverseAndTurn,
+		Lift,
+		Teleport,
+		MAX
+	};
+
+	const TCHAR* LexToString(ETankRecoveryAction Action);
+
+	/**
+	 * Per sample movement signals of a tank.
+	 */
+	struct FTankRecoverySignal
+	{
+		FVector Location{ ForceInitToZero };
+
+		/* Dot product of the tank up vector with world up. */
+		float UpAlignment{ 1.0f };
+
+		float Speed{};
+
+		/* Forward component of the track throttles in [-1, 1]. Turning in place is 0. */
+		float Throttle{};
+
+		bool bGrounded{ true };
+
+		/* Collided with steep scenery since the previous sample. */
+		bool bBlocked{};
+	};
+
+	struct FTankRecoveryConfig
+	{
+		float SampleIntervalSeconds{ 0.1f };
+
+		/* Time the stuck signals are averaged over. */
+		float WindowSeconds{ 3.0f };
+
+		/* Minimum absolute average throttle over the window to consider the tank stuck. */
+		float MinStuckThrottle{ 0.5f };
+
+		/* Tank is stuck if it moved less than this over the window. */
+		float StuckDisplacement{ 100.0f };
+
+		/* Fraction of samples in the window with a blocking collision to consider a stuck tank wedged. */
+		float WedgedBlockedFraction{ 0.3f };
+
+		/* Up alignment below which the tank is on its side, about 80 degrees from upright. */
+		float FlippedUpAlignment{ 0.17f };
+
+		/* A tank moving faster than this may still right itself so is not considered flipped. */
+		float MaxFlippedSpeed{ 100.0f };
+
+		/* An airborne tank moving faster than this is jumping or falling rather than perched. */
+		float MaxAirborneSpeed{ 50.0f };
+
+		/* Time a state must persist before the first response. Stuck and wedged already need a full window. */
+		float FlippedDelaySeconds{ 3.0f };
+		float AirborneDelaySeconds{ 3.0f };
+
+		/* Time between responses while the state persists. */
+		float ResponseIntervalSeconds{ 1.5f };
+
+		/* Falling back into the same state within this time of the last response continues up the ladder rather than restarting it. */
+		float RelapseSeconds{ 10.0f };
+	};
+
+	/**
+	 * Response chosen for a tank along with the signals that led to it.
+	 */
+	struct FTankRecoveryDecision
+	{
+		ETankRecoveryState State{ ETankRecoveryState::None };
+		ETankRecoveryAction Action{ ETankRecoveryAction::None };
+
+		/* Zero based response attempt for the current occurrence of the state. */
+		int32 Attempt{};
+
+		float StateSeconds{};
+		float Displacement{};
+		float ThrottleAverage{};
+		float BlockedFraction{};
+		float UpAlignment{};
+		float Speed{};
+
+		FString ToString() const;
+	};
+
+	/**
+	 * Classifies the recovery state of one tank from a history of its movement signals and plans graded responses for it.
+	 * Each occurrence of a state walks a ladder of responses, e.g. reversing out of a stuck position twice, then a lift and finally a teleport.
+	 * The ladder restarts when the state changes or the tank stays recovered for a while so that a tank that keeps falling back into the same spot escalates.
+	 */
+	class FTankRecoveryClassifier
+	{
+	public:
+		explicit FTankRecoveryClassifier(const FTankRecoveryConfig& InConfig = {});
+
+		/*
+		* Adds a sample taken at <c>TimeSeconds</c> and returns the response that is due if any.
+		*/
+		FTankRecoveryDecision AddSample(float TimeSeconds, const FTankRecoverySignal& Signal);
+
+		ETankRecoveryState GetState() const;
+
+		/*
+		* Forgets the signal history, e.g. after the tank was teleported.
+		*/
+		void Reset();
+
+		const FTankRecoveryConfig& GetConfig() const;
+
+		static TConstArrayView<ETankRecoveryAction> GetResponseLadder(ETankRecoveryState State);
+
+	private:
+		ETankRecoveryState Classify(const FTankRecoverySignal& Signal) const;
+
+		float GetResponseDelay(ETankRecoveryState State) const;
+
+	private:
+		using FVectorBuffer = TTimedCircularBuffer <
+			FVector,
+			decltype([]() { return FVector{ ForceInitToZero }; }),
+			decltype([](const FVector& V) { return FMath::Max3(FMath::Abs(V.X), FMath::Abs(V.Y), FMath::Abs(V.Z)); })
+		>;
+
+		FTankRecoveryConfig Config;
+
+		FVectorBuffer PositionBuffer;
+		TTimedCircularBuffer<float> ThrottleBuffer;
+
+		/* 1 for samples with a blocking collision so that the average is the blocked fraction. */
+		TTimedCircularBuffer<float> BlockedBuffer;
+
+		ETankRecoveryState State{ ETankRecoveryState::None };
+
+		/* State the last response was for. */
+		ETankRecoveryState RespondedState{ ETankRecoveryState::None };
+
+		float StateStartTime{};
+		float LastResponseTime{ -1.0f };
+		int32 Attempt{};
+	};
+
+#pragma region Inline Definitions
+
+	inline ETankRecoveryState FTankRecoveryClassifier::GetState() const
+	{
+		return State;
+	}
+
+	inline const FTankRecoveryConfig& FTankRecoveryClassifier::GetConfig() const
+	{
+		return Config;
+	}
+
+#pragma endregion Inline Definitions
+}
@@ -0,0 +1,636 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/SpringWheelSubsystem.h"
+
+#include "Suspension/SpringWheel.h"
+
+#include "Components/SphereComponent.h"
+
+#include "Debug/TRConsoleVars.h"
+#include "TRConstants.h"
+
+#include "Logging/LoggingUtils.h"
+#include "TRTankLogging.h"
+
+#if TR_DEBUG_ENABLED
+	#include "HAL/IConsoleManager.h"
+	#include "CoreGlobals.h"
+	#include "Containers/Ticker.h"
+	#include "EngineUtils.h"
+	#include "Engine/World.h"
+	#include "GameFramework/DefaultPawn.h"
+	#include "GameFramework/PlayerController.h"
+	#include "UObject/SoftObjectPath.h"
+#endif
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(SpringWheelSubsystem)
+
+DECLARE_CYCLE_STAT(TEXT("SpringWheelSubsystem::Tick"), STAT_SpringWheelSubsystem_Tick, STATGROUP_TRTank);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Managed Spring Wheels"), STAT_SpringWheelSubsystem_Wheels, STATGROUP_TRTank);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Spring Wheel Probes"), STAT_SpringWheelSubsystem_Probes, STATGROUP_TRTank);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Spring Wheel Probes Skipped"), STAT_SpringWheelSubsystem_ProbesSkipped, STATGROUP_TRTank);
+
+namespace
+{
+	/* A grounded wheel that moved less than this since its last probe is assumed to still be grounded. */
+	constexpr float MaxProbeSkipDisplacement = 2.0f;
+
+	/* Longest a grounded wheel reuses its last probe before probing again regardless of movement. */
+	constexpr float MaxProbeSkipSeconds = 0.25f;
+}
+
+void USpringWheelSubsystem::RegisterWheel(ASpringWheel& Wheel)
+{
+	if (!ensureMsgf(Wheel.ManagedIndex == INDEX_NONE, TEXT("%s: RegisterWheel - %s is already registered"), *GetName(), *Wheel.GetName()))
+	{
+		return;
+	}
+
+	check(Wheel.WheelComponent && Wheel.AxleComponent);
+
+	Wheel.ManagedIndex = Wheels.Add(&Wheel);
+
+	WheelComponents.Add(Wheel.WheelComponent);
+	AxleComponents.Add(Wheel.AxleComponent);
+	Tanks.Add(Wheel.AttachParent ? Wheel.AttachParent.Get() : &Wheel);
+	TraceExtents.Add(Wheel.GroundTraceExtent + Wheel.WheelComponent->GetScaledSphereRadius());
+
+	// Carry over any force and grounded state from the actor tick
+	Forces.Add(Wheel.CurrentForce);
+	ProbeLocations.Add(Wheel.WheelComponent->GetComponentLocation());
+	ProbeTimes.Add(-1.0f);
+	Grounded.Add(Wheel.bGrounded);
+	ProbePending.Add(false);
+
+	Wheel.CurrentForce = 0;
+
+	INC_DWORD_STAT(STAT_SpringWheelSubsystem_Wheels);
+
+	UE_LOG(LogTRTank, Verbose, TEXT("%s: RegisterWheel - %s-%s at index %d"),
+		*GetName(), *LoggingUtils::GetName(Wheel.AttachParent), *Wheel.GetName(), Wheel.ManagedIndex);
+}
+
+void USpringWheelSubsystem::UnregisterWheel(ASpringWheel& Wheel)
+{
+	const auto Index = Wheel.ManagedIndex;
+	if (!Wheels.IsValidIndex(Index) || Wheels[Index] != &Wheel)
+	{
+		return;
+	}
+
+	// Hand the state back in case the wheel goes back to ticking itself
+	Wheel.CurrentForce = Forces[Index];
+	Wheel.bGrounded = Grounded[Index];
+	Wheel.ManagedIndex = INDEX_NONE;
+
+	Wheels.RemoveAtSwap(Index, 1, false);
+	WheelComponents.RemoveAtSwap(Index, 1, false);
+	AxleComponents.RemoveAtSwap(Index, 1, false);
+	Tanks.RemoveAtSwap(Index, 1, false);
+	TraceExtents.RemoveAtSwap(Index, 1, false);
+	Forces.RemoveAtSwap(Index, 1, false);
+	ProbeLocations.RemoveAtSwap(Index, 1, false);
+	ProbeTimes.RemoveAtSwap(Index, 1, false);
+	Grounded.RemoveAtSwap(Index);
+	ProbePending.RemoveAtSwap(Index);
+
+	// Last wheel moved into the removed slot
+	if (Wheels.IsValidIndex(Index))
+	{
+		Wheels[Index]->ManagedIndex = Index;
+	}
+
+	DEC_DWORD_STAT(STAT_SpringWheelSubsystem_Wheels);
+
+	UE_LOG(LogTRTank, Verbose, TEXT("%s: UnregisterWheel - %s-%s"),
+		*GetName(), *LoggingUtils::GetName(Wheel.AttachParent), *Wheel.GetName());
+}
+
+void USpringWheelSubsystem::AddDrivingForce(int32 WheelIndex, float ForceMagnitude)
+{
+	check(Forces.IsValidIndex(WheelIndex));
+
+	Forces[WheelIndex] += ForceMagnitude;
+}
+
+float USpringWheelSubsystem::GetDrivingForce(int32 WheelIndex) const
+{
+	return Forces.IsValidIndex(WheelIndex) ? Forces[WheelIndex] : 0.0f;
+}
+
+bool USpringWheelSubsystem::IsGrounded(int32 WheelIndex) const
+{
+	return Grounded.IsValidIndex(WheelIndex) && Grounded[WheelIndex];
+}
+
+bool USpringWheelSubsystem::IsEnabled()
+{
+	return TR::CVarTankSpringWheelManaged.GetValueOnGameThread();
+}
+
+bool USpringWheelSubsystem::IsTickable() const
+{
+	return !Wheels.IsEmpty();
+}
+
+void USpringWheelSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_SpringWheelSubsystem_Tick);
+
+	auto World = GetWorld();
+	check(World);
+
+	const auto TimeSeconds = World->GetTimeSeconds();
+
+	auto GroundProbeSubsystem = UTankGroundProbeSubsystem::IsEnabled() ? World->GetSubsystem<UTankGroundProbeSubsystem>() : nullptr;
+
+	int32 ProbeCount{}, SkippedCount{};
+
+	for (int32 i = 0; i < Wheels.Num(); ++i)
+	{
+		// Same as the actor tick which only probes the ground while driving
+		if (FMath::IsNearlyZero(Forces[i]))
+		{
+			continue;
+		}
+
+		auto WheelComponent = WheelComponents[i].Get();
+		const auto Location = WheelComponent->GetComponentLocation();
+
+		if (ShouldProbe(i, Location, TimeSeconds))
+		{
+			const auto TraceOffset = WheelComponent->GetUpVector() * TraceExtents[i];
+
+			const FGroundProbeRay Ray
+			{
+				.Start = Location + TraceOffset,
+				.End = Location - TraceOffset
+			};
+
+			ProbeLocations[i] = Location;
+			ProbeTimes[i] = TimeSeconds;
+			++ProbeCount;
+
+			if (GroundProbeSubsystem)
+			{
+				// Use the previous result while driving and refresh it for the next frame
+				auto& Batch = TankProbeBatches.FindOrAdd(Tanks[i].Get());
+				Batch.Rays.Add(Ray);
+				Batch.IgnoredActors.Add(Wheels[i].Get());
+				Batch.Wheels.Add(Wheels[i].Get());
+
+				ProbePending[i] = true;
+			}
+			else
+			{
+				Grounded[i] = TraceGround(i, Ray.Start, Ray.End);
+			}
+		}
+		else if (!ProbePending[i])
+		{
+			++SkippedCount;
+		}
+
+		if (Grounded[i])
+		{
+			WheelComponent->AddForce(AxleComponents[i]->GetForwardVector() * Forces[i]);
+			Forces[i] = 0;
+		}
+	}
+
+	if (GroundProbeSubsystem)
+	{
+		DispatchProbes(*GroundProbeSubsystem);
+	}
+
+	INC_DWORD_STAT_BY(STAT_SpringWheelSubsystem_Probes, ProbeCount);
+	INC_DWORD_STAT_BY(STAT_SpringWheelSubsystem_ProbesSkipped, SkippedCount);
+}
+
+bool USpringWheelSubsystem::ShouldProbe(int32 WheelIndex, const FVector& Location, float TimeSeconds) const
+{
+	if (ProbePending[WheelIndex])
+	{
+		return false;
+	}
+
+	// Wheels off the ground are probed every frame as they can land at any time
+	if (!Grounded[WheelIndex] || ProbeTimes[WheelIndex] < 0)
+	{
+		return true;
+	}
+
+	return TimeSeconds - ProbeTimes[WheelIndex] >= MaxProbeSkipSeconds ||
+		FVector::DistSquared(Location, ProbeLocations[WheelIndex]) >= FMath::Square(MaxProbeSkipDisplacement);
+}
+
+bool USpringWheelSubsystem::TraceGround(int32 WheelIndex, const FVector& Start, const FVector& End) const
+{
+	auto World = GetWorld();
+	check(World);
+
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(SpringWheelGroundProbe), false, Tanks[WheelIndex].Get());
+	Params.AddIgnoredActor(Wheels[WheelIndex].Get());
+
+	return World->LineTraceTestByChannel(Start, End, ECollisionChannel::ECC_Visibility, Params);
+}
+
+void USpringWheelSubsystem::DispatchProbes(UTankGroundProbeSubsystem& GroundProbeSubsystem)
+{
+	for (auto& [Tank, Batch] : TankProbeBatches)
+	{
+		GroundProbeSubsystem.QueueProbes(*Tank, Batch.Rays, Batch.IgnoredActors,
+			FOnGroundProbesCompleted::CreateUObject(this, &ThisClass::OnGroundProbesCompleted, Batch.Wheels));
+	}
+
+	TankProbeBatches.Reset();
+}
+
+void USpringWheelSubsystem::OnGroundProbesCompleted(TConstArrayView<bool> ProbeResults, FProbedWheels ProbedWheels)
+{
+	for (int32 i = 0; i < ProbedWheels.Num(); ++i)
+	{
+		auto Wheel = ProbedWheels[i].Get();
+
+		// Wheel destroyed or handed back to the actor tick since the probe was queued
+		if (!Wheel || !Wheels.IsValidIndex(Wheel->ManagedIndex) || Wheels[Wheel->ManagedIndex] != Wheel)
+		{
+			continue;
+		}
+
+		const auto Index = Wheel->ManagedIndex;
+		ProbePending[Index] = false;
+
+		// Keep the previous result if abandoned
+		if (ProbeResults.IsValidIndex(i))
+		{
+			Grounded[Index] = ProbeResults[i];
+		}
+	}
+}
+
+TStatId USpringWheelSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USpringWheelSubsystem, STATGROUP_Tickables);
+}
+
+void USpringWheelSubsystem::Deinitialize()
+{
+	for (auto Wheel : Wheels)
+	{
+		if (Wheel)
+		{
+			Wheel->ManagingSubsystem = nullptr;
+			Wheel->ManagedIndex = INDEX_NONE;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_SpringWheelSubsystem_Wheels, 0);
+
+	Wheels.Reset();
+	WheelComponents.Reset();
+	AxleComponents.Reset();
+	Tanks.Reset();
+	TraceExtents.Reset();
+	Forces.Reset();
+	ProbeLocations.Reset();
+	ProbeTimes.Reset();
+	Grounded.Reset();
+	ProbePending.Reset();
+	TankProbeBatches.Reset();
+
+	Super::Deinitialize();
+}
+
+#pragma region Benchmark
+
+#if TR_DEBUG_ENABLED
+
+namespace
+{
+	/*
+	* Compares the average game thread time with spring wheels ticking as actors against being updated by the subsystem.
+	* Spawns a number of stand in tanks, 40 with 8 wheels each by default, and moves them every frame so that the wheels keep probing the ground.
+	* With no tanks to spawn the spring wheels already in the world are compared instead and returned to their previous mode afterwards.
+	* Each mode runs for a number of frames after a warm up.
+	*/
+	class FSpringWheelBenchmark
+	{
+	public:
+		FSpringWheelBenchmark(UWorld& InWorld, int32 InFrames)
+			: World(&InWorld)
+			, Frames(InFrames)
+		{
+		}
+
+		~FSpringWheelBenchmark()
+		{
+			if (TickerHandle.IsValid())
+			{
+				FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+			}
+
+			DestroySpawned();
+		}
+
+		bool Start(int32 InTankCount, int32 WheelsPerTank, TSubclassOf<ASpringWheel> WheelClass)
+		{
+			if (InTankCount > 0)
+			{
+				SpawnTanks(InTankCount, WheelsPerTank, WheelClass);
+			}
+			else
+			{
+				AddWorldWheels();
+			}
+
+			if (Wheels.IsEmpty())
+			{
+				UE_LOG(LogTRTank, Warning, TEXT("RunSpringWheelBenchmark: No spring wheels in the world"));
+				return false;
+			}
+
+			UE_LOG(LogTRTank, Display, TEXT("RunSpringWheelBenchmark: Started - Tanks=%d; Wheels=%d; Frames=%d per mode"), TankCount, Wheels.Num(), Frames);
+
+			SetManaged(false);
+			TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FSpringWheelBenchmark::Tick));
+
+			return true;
+		}
+
+		bool IsRunning() const
+		{
+			return TickerHandle.IsValid();
+		}
+
+	private:
+		enum EMode : int32
+		{
+			Actor,
+			Managed,
+			Num
+		};
+
+		void AddWorldWheels()
+		{
+			TSet<const AActor*> Tanks;
+
+			for (TActorIterator<ASpringWheel> It(World.Get()); It; ++It)
+			{
+				Wheels.Add(*It);
+				WasManaged.Add(It->IsManaged());
+				Tanks.Add(It->GetAttachParentActor());
+			}
+
+			TankCount = Tanks.Num();
+		}
+
+		/*
+		* Default pawns stand in for the tanks as they have a primitive root for the wheel constraints and a movement component for their tick dependencies.
+		* They are laid out in a grid in front of the player with the wheels in two rows down their sides.
+		*/
+		void SpawnTanks(int32 InTankCount, int32 WheelsPerTank, TSubclassOf<ASpringWheel> WheelClass)
+		{
+			auto PlayerPawn = World->GetFirstPlayerController() ? World->GetFirstPlayerController()->GetPawn() : nullptr;
+
+			const auto Origin = PlayerPawn ? PlayerPawn->GetActorLocation() + PlayerPawn->GetActorForwardVector() * TankSpacing : FVector::ZeroVector;
+			const auto Columns = FMath::CeilToInt32(FMath::Sqrt(static_cast<float>(InTankCount)));
+			const auto WheelsPerSide = FMath::DivideAndRoundUp(WheelsPerTank, 2);
+
+			FActorSpawnParameters SpawnParameters;
+			SpawnParameters.ObjectFlags |= RF_Transient;
+			SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+			for (int32 TankIndex = 0; TankIndex < InTankCount; ++TankIndex)
+			{
+				const auto TankLocation = Origin + FVector(TankIndex / Columns, TankIndex % Columns - (Columns - 1) / 2.0, 0) * TankSpacing;
+
+				auto Tank = World->SpawnActor<ADefaultPawn>(TankLocation, FRotator::ZeroRotator, SpawnParameters);
+				if (!Tank)
+				{
+					continue;
+				}
+
+				SpawnedTanks.Add(Tank);
+				TankOrigins.Add(TankLocation);
+
+				for (int32 WheelIndex = 0; WheelIndex < WheelsPerTank; ++WheelIndex)
+				{
+					const auto Side = WheelIndex % 2 ? 1.0 : -1.0;
+					const auto Row = WheelIndex / 2 - (WheelsPerSide - 1) / 2.0;
+					const FTransform WheelTransform(TankLocation + FVector(Row * WheelSpacing, Side * WheelSpacing, -WheelSpacing / 2));
+
+					// Attached before finishing spawning so that the constraints are set up against the tank in BeginPlay
+					auto Wheel = World->SpawnActorDeferred<ASpringWheel>(WheelClass, WheelTransform, Tank, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+					if (!Wheel)
+					{
+						continue;
+					}
+
+					Wheel->SetFlags(RF_Transient);
+					Wheel->AttachToActor(Tank, FAttachmentTransformRules::KeepWorldTransform);
+					Wheel->FinishSpawning(WheelTransform);
+
+					Wheels.Add(Wheel);
+					WasManaged.Add(Wheel->IsManaged());
+				}
+			}
+
+			TankCount = SpawnedTanks.Num();
+		}
+
+		void DestroySpawned()
+		{
+			if (!World.IsValid())
+			{
+				return;
+			}
+
+			for (const auto& Tank : SpawnedTanks)
+			{
+				if (!Tank.IsValid())
+				{
+					continue;
+				}
+
+				TArray<AActor*> AttachedActors;
+				Tank->GetAttachedActors(AttachedActors);
+
+				for (auto AttachedActor : AttachedActors)
+				{
+					AttachedActor->Destroy();
+				}
+
+				Tank->Destroy();
+			}
+
+			SpawnedTanks.Reset();
+		}
+
+		/* Drives the spawned tanks back and forth so the wheels move every frame in both modes. */
+		void MoveTanks(float DeltaTime)
+		{
+			ElapsedSeconds += DeltaTime;
+
+			const auto Offset = FVector(FMath::Sin(ElapsedSeconds * DriveFrequency) * DriveAmplitude, 0, 0);
+
+			for (int32 i = 0; i < SpawnedTanks.Num(); ++i)
+			{
+				if (SpawnedTanks[i].IsValid())
+				{
+					SpawnedTanks[i]->SetActorLocation(TankOrigins[i] + Offset);
+				}
+			}
+		}
+
+		bool Tick(float DeltaTime)
+		{
+			if (!World.IsValid())
+			{
+				UE_LOG(LogTRTank, Warning, TEXT("RunSpringWheelBenchmark: World went away - aborted"));
+				TickerHandle.Reset();
+				return false;
+			}
+
+			MoveTanks(DeltaTime);
+
+			// Skip the frames right after switching modes
+			if (++FrameInMode > WarmupFrames)
+			{
+				GameThreadMs[Mode] += FPlatformTime::ToMilliseconds(GGameThreadTime);
+			}
+
+			if (FrameInMode < WarmupFrames + Frames)
+			{
+				return true;
+			}
+
+			if (Mode == EMode::Actor)
+			{
+				Mode = EMode::Managed;
+				FrameInMode = 0;
+				SetManaged(true);
+
+				return true;
+			}
+
+			Report();
+			Restore();
+
+			TickerHandle.Reset();
+			return false;
+		}
+
+		void SetManaged(bool bManaged)
+		{
+			for (const auto& Wheel : Wheels)
+			{
+				if (Wheel.IsValid())
+				{
+					Wheel->SetManaged(bManaged);
+				}
+			}
+		}
+
+		void Restore()
+		{
+			if (!SpawnedTanks.IsEmpty())
+			{
+				DestroySpawned();
+				return;
+			}
+
+			for (int32 i = 0; i < Wheels.Num(); ++i)
+			{
+				if (Wheels[i].IsValid())
+				{
+					Wheels[i]->SetManaged(WasManaged[i]);
+				}
+			}
+		}
+
+		void Report() const
+		{
+			const auto ActorMs = GameThreadMs[EMode::Actor] / Frames;
+			const auto ManagedMs = GameThreadMs[EMode::Managed] / Frames;
+
+			UE_LOG(LogTRTank, Display,
+				TEXT("RunSpringWheelBenchmark: Tanks=%d; Wheels=%d; Frames=%d - ActorPerWheel=%.3fms/frame; Managed=%.3fms/frame; Saved=%.3fus/wheel/frame"),
+				TankCount, Wheels.Num(), Frames, ActorMs, ManagedMs, (ActorMs - ManagedMs) * 1000 / Wheels.Num());
+		}
+
+	private:
+		static constexpr int32 WarmupFrames = 30;
+		static constexpr double TankSpacing = 1000.0;
+		static constexpr double WheelSpacing = 100.0;
+		static constexpr float DriveAmplitude = 200.0f;
+		static constexpr float DriveFrequency = 2.0f;
+
+		TWeakObjectPtr<UWorld> World;
+		TArray<TWeakObjectPtr<ASpringWheel>> Wheels;
+		TArray<bool> WasManaged;
+		int32 TankCount{};
+
+		TArray<TWeakObjectPtr<APawn>> SpawnedTanks;
+		TArray<FVector> TankOrigins;
+		float ElapsedSeconds{};
+
+		int32 Frames;
+		EMode Mode{ EMode::Actor };
+		int32 FrameInMode{};
+		double GameThreadMs[EMode::Num]{};
+
+		FTSTicker::FDelegateHandle TickerHandle{};
+	};
+
+	TUniquePtr<FSpringWheelBenchmark> SpringWheelBenchmark;
+
+	void RunSpringWheelBenchmark(const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World)
+		{
+			return;
+		}
+
+		if (SpringWheelBenchmark && SpringWheelBenchmark->IsRunning())
+		{
+			UE_LOG(LogTRTank, Warning, TEXT("RunSpringWheelBenchmark: Already running"));
+			return;
+		}
+
+		const int32 Frames = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 300;
+		const int32 TankCount = Args.Num() > 1 ? FMath::Max(0, FCString::Atoi(*Args[1])) : 40;
+		const int32 WheelsPerTank = Args.Num() > 2 ? FMath::Max(1, FCString::Atoi(*Args[2])) : 8;
+
+		TSubclassOf<ASpringWheel> WheelClass = ASpringWheel::StaticClass();
+		if (Args.Num() > 3)
+		{
+			WheelClass = FSoftClassPath(Args[3]).TryLoadClass<ASpringWheel>();
+			if (!WheelClass)
+			{
+				UE_LOG(LogTRTank, Warning, TEXT("RunSpringWheelBenchmark: %s is not a spring wheel class"), *Args[3]);
+				return;
+			}
+		}
+
+		// Destroys the tanks spawned by the previous run if it was aborted
+		SpringWheelBenchmark = MakeUnique<FSpringWheelBenchmark>(*World, Frames);
+
+		if (!SpringWheelBenchmark->Start(TankCount, WheelsPerTank, WheelClass))
+		{
+			SpringWheelBenchmark.Reset();
+		}
+	}
+
+	FAutoConsoleCommandWithWorldAndArgs SpringWheelBenchmarkCommand(
+		TEXT("tr.tank.springWheel.benchmark"),
+		TEXT("Compares game thread time of spring wheels ticking as actors against the spring wheel subsystem on spawned tanks, or the spring wheels in the world when Tanks is 0: [Frames=300] [Tanks=40] [WheelsPerTank=8] [WheelClass=/Script/TRTank.SpringWheel]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunSpringWheelBenchmark));
+}
+
+#endif
+
+#pragma endregion Benchmark
@@ -0,0 +1,100 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "Subsystems/TankGroundProbeSubsystem.h"
+
+#include "SpringWheelSubsystem.generated.h"
+
+class ASpringWheel;
+class USphereComponent;
+
+/**
+ * Updates the suspension spring wheels of all tanks from a single tick instead of a tick and ground trace per wheel actor.
+ * Wheel state is kept in parallel arrays indexed by the managed index of each wheel and ground probes are queued per tank with
+ * <c>UTankGroundProbeSubsystem</c>. A grounded wheel that has barely moved since its last probe reuses the result for a short time.
+ * The wheel actors keep their physics constraints and only forward driving forces here.
+ *
+ * Toggled with <c>tr.tank.springWheel.managed</c>. When disabled each wheel ticks itself.
+ */
+UCLASS()
+class USpringWheelSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	void RegisterWheel(ASpringWheel& Wheel);
+	void UnregisterWheel(ASpringWheel& Wheel);
+
+	void AddDrivingForce(int32 WheelIndex, float ForceMagnitude);
+	float GetDrivingForce(int32 WheelIndex) const;
+	bool IsGrounded(int32 WheelIndex) const;
+
+	int32 Num() const;
+
+	static bool IsEnabled();
+
+protected:
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+
+	virtual TStatId GetStatId() const override;
+
+	virtual void Deinitialize() override;
+
+private:
+	using FProbedWheels = TArray<TWeakObjectPtr<ASpringWheel>, TInlineAllocator<8>>;
+
+	struct FTankProbeBatch
+	{
+		TArray<FGroundProbeRay, TInlineAllocator<8>> Rays;
+		TArray<const AActor*, TInlineAllocator<8>> IgnoredActors;
+		FProbedWheels Wheels;
+	};
+
+	bool ShouldProbe(int32 WheelIndex, const FVector& Location, float TimeSeconds) const;
+	bool TraceGround(int32 WheelIndex, const FVector& Start, const FVector& End) const;
+
+	void DispatchProbes(UTankGroundProbeSubsystem& GroundProbeSubsystem);
+	void OnGroundProbesCompleted(TConstArrayView<bool> ProbeResults, FProbedWheels ProbedWheels);
+
+private:
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<ASpringWheel>> Wheels{};
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<USphereComponent>> WheelComponents{};
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<USphereComponent>> AxleComponents{};
+
+	/* Tank each wheel is attached to or the wheel itself if unattached. Probes are queued and ignored per tank. */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<AActor>> Tanks{};
+
+	TArray<float> TraceExtents{};
+
+	/* Driving force accumulated since it was last applied. Held while the wheel is off the ground as with the actor tick. */
+	TArray<float> Forces{};
+
+	TArray<FVector> ProbeLocations{};
+	TArray<float> ProbeTimes{};
+
+	TBitArray<> Grounded{};
+	TBitArray<> ProbePending{};
+
+	/* Probes of the current tick grouped by tank. */
+	TMap<const AActor*, FTankProbeBatch> TankProbeBatches{};
+};
+
+#pragma region Inline Definitions
+
+inline int32 USpringWheelSubsystem::Num() const
+{
+	return Wheels.Num();
+}
+
+#pragma endregion Inline Definitions
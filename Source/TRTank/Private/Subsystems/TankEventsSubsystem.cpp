@@ -3,4 +3,48 @@
 
 #include "Subsystems/TankEventsSubsystem.h"
 
+#include "Pawn/BaseTankPawn.h"
+#include "Subsystems/PawnSpatialHashSubsystem.h"
+
 #include UE_INLINE_GENERATED_CPP_BY_NAME(TankEventsSubsystem)
+
+void UTankEventsSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	OnEnemySpawned.AddDynamic(this, &ThisClass::RegisterSpawnedEnemy);
+	OnTankDestroyed.AddDynamic(this, &ThisClass::UnregisterDestroyedTank);
+}
+
+void UTankEventsSubsystem::RegisterSpawnedEnemy(APawn* Enemy)
+{
+	if (!Enemy)
+	{
+		return;
+	}
+
+	auto World = GetWorld();
+	check(World);
+
+	if (auto PawnSpatialHashSubsystem = World->GetSubsystem<UPawnSpatialHashSubsystem>(); ensure(PawnSpatialHashSubsystem))
+	{
+		PawnSpatialHashSubsystem->RegisterPawn(*Enemy);
+	}
+}
+
+void UTankEventsSubsystem::UnregisterDestroyedTank(ABaseTankPawn* DestroyedTank, AController* DestroyedBy, AActor* DestroyedWith)
+{
+	if (!DestroyedTank)
+	{
+		return;
+	}
+
+	auto World = GetWorld();
+	check(World);
+
+	// Destroyed tanks stay in the world for a while so remove them now rather than waiting on the stale pawn cleanup
+	if (auto PawnSpatialHashSubsystem = World->GetSubsystem<UPawnSpatialHashSubsystem>(); ensure(PawnSpatialHashSubsystem))
+	{
+		PawnSpatialHashSubsystem->UnregisterPawn(*DestroyedTank);
+	}
+}
@@ -0,0 +1,204 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/TankGroundProbeSubsystem.h"
+
+#include "Debug/TRConsoleVars.h"
+
+#include "Logging/LoggingUtils.h"
+#include "TRTankLogging.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(TankGroundProbeSubsystem)
+
+DECLARE_CYCLE_STAT(TEXT("TankGroundProbeSubsystem::Dispatch"), STAT_TankGroundProbeSubsystem_Dispatch, STATGROUP_TRTank);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Ground Probe Traces"), STAT_TankGroundProbeSubsystem_Traces, STATGROUP_TRTank);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Ground Probe Tanks"), STAT_TankGroundProbeSubsystem_Tanks, STATGROUP_TRTank);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Ground Probe Traces Per Tank"), STAT_TankGroundProbeSubsystem_TracesPerTank, STATGROUP_TRTank);
+
+namespace
+{
+	/* Async trace results are delivered on the next frame so a batch still pending after this is abandoned and probed again. */
+	constexpr uint64 MaxBatchFrameLatency = 2;
+}
+
+void UTankGroundProbeSubsystem::QueueProbes(const AActor& Tank, TConstArrayView<FGroundProbeRay> Rays, TConstArrayView<const AActor*> IgnoredActors, FOnGroundProbesCompleted OnCompleted)
+{
+	if (Rays.IsEmpty())
+	{
+		return;
+	}
+
+	auto& Request = PendingRequests.AddDefaulted_GetRef();
+	Request.Tank = &Tank;
+	Request.Rays.Append(Rays.GetData(), Rays.Num());
+	Request.Params = FCollisionQueryParams(SCENE_QUERY_STAT(TankGroundProbe), false, &Tank);
+	Request.OnCompleted = MoveTemp(OnCompleted);
+
+	for (auto IgnoredActor : IgnoredActors)
+	{
+		Request.Params.AddIgnoredActor(IgnoredActor);
+	}
+}
+
+int32 UTankGroundProbeSubsystem::GetTraceCount(const AActor& Tank) const
+{
+	const auto Count = TankTraceCounts.Find(&Tank);
+	return Count ? *Count : 0;
+}
+
+bool UTankGroundProbeSubsystem::IsEnabled()
+{
+	return TR::CVarTankGroundProbeAsync.GetValueOnGameThread();
+}
+
+bool UTankGroundProbeSubsystem::IsTickable() const
+{
+	return !PendingRequests.IsEmpty() || !Batches.IsEmpty();
+}
+
+void UTankGroundProbeSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	AbandonStaleBatches();
+	DispatchPendingProbes();
+}
+
+void UTankGroundProbeSubsystem::DispatchPendingProbes()
+{
+	SCOPE_CYCLE_COUNTER(STAT_TankGroundProbeSubsystem_Dispatch);
+
+	TankTraceCounts.Reset();
+
+	if (PendingRequests.IsEmpty())
+	{
+		return;
+	}
+
+	auto World = GetWorld();
+	check(World);
+
+	const auto BatchId = NextBatchId++;
+	auto& Batch = Batches.Add(BatchId);
+	Batch.IssuedFrame = GFrameCounter;
+	Batch.Requests.Reserve(PendingRequests.Num());
+
+	const auto TraceDelegate = FTraceDelegate::CreateUObject(this, &ThisClass::OnProbeTraceCompleted, BatchId);
+
+	for (const auto& Request : PendingRequests)
+	{
+		// Tank destroyed after queueing
+		if (!Request.Tank.IsValid())
+		{
+			continue;
+		}
+
+		const auto FirstProbeIndex = Batch.Grounded.Num();
+
+		for (const auto& Ray : Request.Rays)
+		{
+			const auto ProbeIndex = Batch.Grounded.Add(false);
+
+			World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Ray.Start, Ray.End, ECollisionChannel::ECC_Visibility, Request.Params,
+				FCollisionResponseParams::DefaultResponseParam, &TraceDelegate, static_cast<uint32>(ProbeIndex));
+		}
+
+		Batch.Requests.Add(FBatchProbeRequest
+		{
+			.OnCompleted = Request.OnCompleted,
+			.FirstProbeIndex = FirstProbeIndex,
+			.ProbeCount = Request.Rays.Num()
+		});
+
+		TankTraceCounts.FindOrAdd(Request.Tank) += Request.Rays.Num();
+	}
+
+	Batch.TracesRemaining = Batch.Grounded.Num();
+	PendingRequests.Reset();
+
+	const auto TraceCount = Batch.TracesRemaining;
+	const auto TankCount = TankTraceCounts.Num();
+
+	INC_DWORD_STAT_BY(STAT_TankGroundProbeSubsystem_Traces, TraceCount);
+	INC_DWORD_STAT_BY(STAT_TankGroundProbeSubsystem_Tanks, TankCount);
+	INC_FLOAT_STAT_BY(STAT_TankGroundProbeSubsystem_TracesPerTank, TankCount > 0 ? static_cast<float>(TraceCount) / TankCount : 0.0f);
+
+	UE_LOG(LogTRTank, VeryVerbose, TEXT("%s: DispatchPendingProbes - Batch %u: %d trace%s for %d tank%s"),
+		*GetName(), BatchId, TraceCount, LoggingUtils::Pluralize(TraceCount), TankCount, LoggingUtils::Pluralize(TankCount));
+
+	if (TraceCount == 0)
+	{
+		CompleteBatch(BatchId);
+	}
+}
+
+void UTankGroundProbeSubsystem::OnProbeTraceCompleted(const FTraceHandle& Handle, FTraceDatum& Datum, uint32 BatchId)
+{
+	auto Batch = Batches.Find(BatchId);
+	if (!Batch)
+	{
+		// Batch was abandoned
+		return;
+	}
+
+	Batch->Grounded[Datum.UserData] = FHitResult::GetFirstBlockingHit(Datum.OutHits) != nullptr;
+
+	if (--Batch->TracesRemaining <= 0)
+	{
+		CompleteBatch(BatchId);
+	}
+}
+
+void UTankGroundProbeSubsystem::CompleteBatch(uint32 BatchId, bool bAbandoned)
+{
+	auto FoundBatch = Batches.Find(BatchId);
+	if (!FoundBatch)
+	{
+		return;
+	}
+
+	// Move out of the map as callbacks may queue new probes
+	FGroundProbeBatch Batch = MoveTemp(*FoundBatch);
+	Batches.Remove(BatchId);
+
+	for (const auto& Request : Batch.Requests)
+	{
+		Request.OnCompleted.ExecuteIfBound(bAbandoned ?
+			TConstArrayView<bool>{} : TConstArrayView<bool>(Batch.Grounded.GetData() + Request.FirstProbeIndex, Request.ProbeCount));
+	}
+}
+
+void UTankGroundProbeSubsystem::AbandonStaleBatches()
+{
+	TArray<uint32, TInlineAllocator<4>> StaleBatchIds;
+
+	for (const auto& [BatchId, Batch] : Batches)
+	{
+		if (GFrameCounter - Batch.IssuedFrame > MaxBatchFrameLatency)
+		{
+			StaleBatchIds.Add(BatchId);
+		}
+	}
+
+	for (auto BatchId : StaleBatchIds)
+	{
+		UE_LOG(LogTRTank, Warning, TEXT("%s: AbandonStaleBatches - Batch %u still waiting on %d trace%s"),
+			*GetName(), BatchId, Batches[BatchId].TracesRemaining, LoggingUtils::Pluralize(Batches[BatchId].TracesRemaining));
+
+		CompleteBatch(BatchId, true);
+	}
+}
+
+TStatId UTankGroundProbeSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTankGroundProbeSubsystem, STATGROUP_Tickables);
+}
+
+void UTankGroundProbeSubsystem::Deinitialize()
+{
+	PendingRequests.Reset();
+	Batches.Reset();
+	TankTraceCounts.Reset();
+
+	Super::Deinitialize();
+}
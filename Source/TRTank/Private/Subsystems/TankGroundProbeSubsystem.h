@@ -0,0 +1,91 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+
+#include "TankGroundProbeSubsystem.generated.h"
+
+/*
+* Called with whether each probe ray hit the ground in the order the rays were queued or with an empty view if the results were abandoned.
+*/
+DECLARE_DELEGATE_OneParam(FOnGroundProbesCompleted, TConstArrayView<bool> /* Grounded */);
+
+struct FGroundProbeRay
+{
+	FVector Start{ EForceInit::ForceInitToZero };
+	FVector End{ EForceInit::ForceInitToZero };
+};
+
+/**
+ * Collects the ground contact probes of all tank tracks and wheels queued during a frame and dispatches them together
+ * as async traces at the end of the frame. Results are delivered on the next frame so callers use the grounded state from the previous probe.
+ *
+ * Toggled with <c>tr.tank.groundProbe.async</c>. When disabled callers fall back to synchronous traces.
+ */
+UCLASS()
+class UTankGroundProbeSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/*
+	* Queues probe rays for <c>Tank</c> to be traced with the next batch. <c>IgnoredActors</c> are excluded from the traces in addition to <c>Tank</c>.
+	*/
+	void QueueProbes(const AActor& Tank, TConstArrayView<FGroundProbeRay> Rays, TConstArrayView<const AActor*> IgnoredActors, FOnGroundProbesCompleted OnCompleted);
+
+	/*
+	* Number of traces dispatched for <c>Tank</c> in the last batch.
+	*/
+	int32 GetTraceCount(const AActor& Tank) const;
+
+	static bool IsEnabled();
+
+protected:
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+
+	virtual TStatId GetStatId() const override;
+
+	virtual void Deinitialize() override;
+
+private:
+	struct FPendingProbeRequest
+	{
+		TWeakObjectPtr<const AActor> Tank;
+		TArray<FGroundProbeRay, TInlineAllocator<8>> Rays;
+		FCollisionQueryParams Params;
+		FOnGroundProbesCompleted OnCompleted;
+	};
+
+	struct FBatchProbeRequest
+	{
+		FOnGroundProbesCompleted OnCompleted;
+		int32 FirstProbeIndex;
+		int32 ProbeCount;
+	};
+
+	struct FGroundProbeBatch
+	{
+		TArray<FBatchProbeRequest> Requests;
+		TArray<bool> Grounded;
+		int32 TracesRemaining{};
+		uint64 IssuedFrame{};
+	};
+
+	void DispatchPendingProbes();
+
+	void OnProbeTraceCompleted(const FTraceHandle& Handle, FTraceDatum& Datum, uint32 BatchId);
+	void CompleteBatch(uint32 BatchId, bool bAbandoned = false);
+	void AbandonStaleBatches();
+
+private:
+	TArray<FPendingProbeRequest> PendingRequests{};
+
+	TMap<uint32, FGroundProbeBatch> Batches{};
+	uint32 NextBatchId{};
+
+	TMap<TWeakObjectPtr<const AActor>, int32> TankTraceCounts{};
+};
@@ -0,0 +1,363 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/TankRecoverySubsystem.h"
+
+#include "Pawn/BaseTankPawn.h"
+#include "Components/HealthComponent.h"
+#include "Components/TankCollisionDetectionComponent.h"
+#include "Subsystems/TankEventsSubsystem.h"
+
+#include "NavigationSystem.h"
+
+#include "Utils/CollisionUtils.h"
+#include "Utils/RandUtils.h"
+#include "Debug/TRConsoleVars.h"
+
+#include "Logging/LoggingUtils.h"
+#include "TRTankLogging.h"
+
+#include "VisualLogger/VisualLogger.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(TankRecoverySubsystem)
+
+DEFINE_VLOG_EVENT(EventTankRecovery, Display, "Recovery")
+
+DECLARE_CYCLE_STAT(TEXT("TankRecoverySubsystem::Sample"), STAT_TankRecoverySubsystem_Sample, STATGROUP_TRTank);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Recovery Tracked Tanks"), STAT_TankRecoverySubsystem_Tanks, STATGROUP_TRTank);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Recovery Reverse And Turn"), STAT_TankRecoverySubsystem_ReverseAndTurn, STATGROUP_TRTank);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Recovery Lift"), STAT_TankRecoverySubsystem_Lift, STATGROUP_TRTank);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Recovery Teleport"), STAT_TankRecoverySubsystem_Teleport, STATGROUP_TRTank);
+
+using namespace TR;
+
+namespace
+{
+	const FTankRecoveryConfig RecoveryConfig{};
+
+	/* Collisions with surfaces steeper than about 60 degrees count as blocking. */
+	constexpr double MaxBlockingNormalZ = 0.5;
+
+	/* Velocity change backing away from the obstacle in cm/s with a little lift to break contact. */
+	constexpr float ReverseSpeed = 300.0f;
+	constexpr float ReverseLiftSpeed = 100.0f;
+
+	/* Yaw rate change in deg/s so the tank doesn't drive straight back into the obstacle. */
+	constexpr float ReverseTurnRate = 60.0f;
+
+	/* Upward velocity change in cm/s. */
+	constexpr float LiftSpeed = 400.0f;
+
+	/* Roll rate change in deg/s toward upright applied with a lift when flipped over. */
+	constexpr float RightingRate = 120.0f;
+
+	/* Search extent around the tank for a navmesh location to teleport to. */
+	const FVector TeleportQueryExtent{ 1000.0, 1000.0, 1000.0 };
+
+	/* Height above the ground to drop the tank at after a teleport. */
+	constexpr float TeleportZOffset = 50.0f;
+}
+
+void UTankRecoverySubsystem::RegisterTank(ABaseTankPawn& Tank)
+{
+	const FObjectKey TankKey(&Tank);
+	if (Tanks.Contains(TankKey))
+	{
+		return;
+	}
+
+	auto& Tracked = Tanks.Add(TankKey, FTrackedTank{ .Tank = &Tank, .Classifier = FTankRecoveryClassifier(RecoveryConfig) });
+
+	if (auto CollisionDetectionComponent = Tank.FindComponentByClass<UTankCollisionDetectionComponent>(); CollisionDetectionComponent)
+	{
+		Tracked.CollisionHandle = CollisionDetectionComponent->OnRelevantCollision.AddWeakLambda(this, [this, TankKey](const FHitResult& Hit, const FVector&)
+		{
+			OnTankCollision(TankKey, Hit);
+		});
+	}
+
+	INC_DWORD_STAT(STAT_TankRecoverySubsystem_Tanks);
+
+	UE_LOG(LogTRTank, Verbose, TEXT("%s: RegisterTank: %s - %d tank%s registered"),
+		*GetName(), *Tank.GetName(), Tanks.Num(), LoggingUtils::Pluralize(Tanks.Num()));
+}
+
+void UTankRecoverySubsystem::UnregisterTank(ABaseTankPawn& Tank)
+{
+	FTrackedTank Tracked;
+	if (!Tanks.RemoveAndCopyValue(FObjectKey(&Tank), Tracked))
+	{
+		return;
+	}
+
+	if (auto CollisionDetectionComponent = Tank.FindComponentByClass<UTankCollisionDetectionComponent>(); CollisionDetectionComponent)
+	{
+		CollisionDetectionComponent->OnRelevantCollision.Remove(Tracked.CollisionHandle);
+	}
+
+	DEC_DWORD_STAT(STAT_TankRecoverySubsystem_Tanks);
+
+	UE_LOG(LogTRTank, Verbose, TEXT("%s: UnregisterTank: %s - %d tank%s registered"),
+		*GetName(), *Tank.GetName(), Tanks.Num(), LoggingUtils::Pluralize(Tanks.Num()));
+}
+
+bool UTankRecoverySubsystem::IsEnabled()
+{
+	return CVarTankRecoveryEnabled.GetValueOnGameThread();
+}
+
+bool UTankRecoverySubsystem::IsTickable() const
+{
+	return !Tanks.IsEmpty() && IsEnabled();
+}
+
+void UTankRecoverySubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	auto World = GetWorld();
+	check(World);
+
+	TimeSinceSample += DeltaTime;
+	if (TimeSinceSample < RecoveryConfig.SampleIntervalSeconds)
+	{
+		return;
+	}
+
+	TimeSinceSample = FMath::Fmod(TimeSinceSample, RecoveryConfig.SampleIntervalSeconds);
+
+	SampleTanks(World->GetTimeSeconds());
+}
+
+TStatId UTankRecoverySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTankRecoverySubsystem, STATGROUP_Tickables);
+}
+
+void UTankRecoverySubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Keyed by path name so that a pinned seed gives the same turn directions every run
+	Rng.Initialize(RandUtils::GenerateSeed(*this));
+
+	if (auto TankEventsSubsystem = InWorld.GetSubsystem<UTankEventsSubsystem>(); ensure(TankEventsSubsystem))
+	{
+		TankEventsSubsystem->OnTankDestroyed.AddDynamic(this, &ThisClass::OnTankDestroyed);
+	}
+}
+
+void UTankRecoverySubsystem::Deinitialize()
+{
+	LogDecisionCounts();
+
+	SET_DWORD_STAT(STAT_TankRecoverySubsystem_Tanks, 0);
+	Tanks.Reset();
+
+	Super::Deinitialize();
+}
+
+void UTankRecoverySubsystem::SampleTanks(float TimeSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_TankRecoverySubsystem_Sample);
+
+	for (auto It = Tanks.CreateIterator(); It; ++It)
+	{
+		auto& Tracked = It.Value();
+
+		auto Tank = Tracked.Tank.Get();
+		if (!Tank)
+		{
+			DEC_DWORD_STAT(STAT_TankRecoverySubsystem_Tanks);
+			It.RemoveCurrent();
+			continue;
+		}
+
+		if (auto HealthComponent = Tank->GetHealthComponent(); !HealthComponent || !HealthComponent->IsAlive())
+		{
+			continue;
+		}
+
+		const auto Signal = Sample(Tracked, *Tank);
+
+		if (const auto Decision = Tracked.Classifier.AddSample(TimeSeconds, Signal); Decision.Action != ETankRecoveryAction::None)
+		{
+			Respond(Tracked, *Tank, Decision);
+		}
+	}
+}
+
+FTankRecoverySignal UTankRecoverySubsystem::Sample(FTrackedTank& Tracked, const ABaseTankPawn& Tank) const
+{
+	const auto ThrottleState = Tank.GetThrottleState();
+
+	FTankRecoverySignal Signal
+	{
+		.Location = Tank.GetActorLocation(),
+		.UpAlignment = static_cast<float>(Tank.GetActorUpVector().Z),
+		.Speed = static_cast<float>(Tank.GetVelocity().Size()),
+		.Throttle = FMath::Clamp((ThrottleState.LeftThrottle + ThrottleState.RightThrottle) * 0.5f, -1.0f, 1.0f),
+		// One track on the ground still gives traction
+		.bGrounded = !Tank.IsAirborne(),
+		.bBlocked = Tracked.bBlocked
+	};
+
+	Tracked.bBlocked = false;
+
+	return Signal;
+}
+
+void UTankRecoverySubsystem::Respond(FTrackedTank& Tracked, ABaseTankPawn& Tank, const FTankRecoveryDecision& Decision)
+{
+	++DecisionCounts[static_cast<int32>(Decision.State)][static_cast<int32>(Decision.Action)];
+
+	UE_VLOG_EVENT_WITH_DATA(&Tank, EventTankRecovery);
+	UE_VLOG_LOCATION(&Tank, LogTRTank, Log, Tank.GetActorLocation(), 50.0f, FColor::Orange, TEXT("%s"), LexToString(Decision.Action));
+	UE_VLOG_UELOG(&Tank, LogTRTank, Display, TEXT("%s: Recovery: Tank=%s; Location=%s; %s"),
+		*GetName(), *Tank.GetName(), *Tank.GetActorLocation().ToCompactString(), *Decision.ToString());
+
+	switch (Decision.Action)
+	{
+		case ETankRecoveryAction::ReverseAndTurn:
+			INC_DWORD_STAT(STAT_TankRecoverySubsystem_ReverseAndTurn);
+			ReverseAndTurn(Tracked, Tank, Decision);
+			break;
+		case ETankRecoveryAction::Lift:
+			INC_DWORD_STAT(STAT_TankRecoverySubsystem_Lift);
+			Lift(Tank, Decision);
+			break;
+		case ETankRecoveryAction::Teleport:
+			INC_DWORD_STAT(STAT_TankRecoverySubsystem_Teleport);
+			if (Teleport(Tank))
+			{
+				Tracked.Classifier.Reset();
+			}
+			break;
+		default:
+			checkNoEntry();
+	}
+}
+
+void UTankRecoverySubsystem::ReverseAndTurn(const FTrackedTank& Tracked, ABaseTankPawn& Tank, const FTankRecoveryDecision& Decision)
+{
+	auto RootComponent = Cast<UPrimitiveComponent>(Tank.GetRootComponent());
+	if (!RootComponent)
+	{
+		return;
+	}
+
+	// Back away from what the tank is wedged against or opposite to the direction it was trying to drive
+	FVector Direction;
+	if (Decision.State == ETankRecoveryState::Wedged && !Tracked.BlockingNormal.IsNearlyZero())
+	{
+		Direction = FVector(Tracked.BlockingNormal.X, Tracked.BlockingNormal.Y, 0).GetSafeNormal();
+	}
+	else
+	{
+		Direction = -FMath::Sign(Decision.ThrottleAverage) * Tank.GetActorForwardVector();
+	}
+
+	const auto TurnRate = Rng.RandHelper(2) == 0 ? ReverseTurnRate : -ReverseTurnRate;
+
+	RootComponent->AddImpulse(Direction * ReverseSpeed + FVector::UpVector * ReverseLiftSpeed, NAME_None, true);
+	RootComponent->AddAngularImpulseInDegrees(FVector::UpVector * TurnRate, NAME_None, true);
+}
+
+void UTankRecoverySubsystem::Lift(ABaseTankPawn& Tank, const FTankRecoveryDecision& Decision)
+{
+	auto RootComponent = Cast<UPrimitiveComponent>(Tank.GetRootComponent());
+	if (!RootComponent)
+	{
+		return;
+	}
+
+	RootComponent->AddImpulse(FVector::UpVector * LiftSpeed, NAME_None, true);
+
+	if (Decision.State != ETankRecoveryState::Flipped)
+	{
+		return;
+	}
+
+	// Roll about the axis that brings the tank up vector toward world up. Upside down has no preferred axis so roll about forward.
+	auto RightingAxis = (Tank.GetActorUpVector() ^ FVector::UpVector).GetSafeNormal();
+	if (RightingAxis.IsNearlyZero())
+	{
+		RightingAxis = Tank.GetActorForwardVector();
+	}
+
+	RootComponent->AddAngularImpulseInDegrees(RightingAxis * RightingRate, NAME_None, true);
+}
+
+bool UTankRecoverySubsystem::Teleport(ABaseTankPawn& Tank)
+{
+	auto World = GetWorld();
+	check(World);
+
+	// Snap to the navmesh so the tank ends up somewhere drivable rather than back on the same obstacle
+	auto ResetLocation = Tank.GetActorLocation();
+
+	if (auto NavigationSystem = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World); NavigationSystem)
+	{
+		if (FNavLocation NavLocation; NavigationSystem->ProjectPointToNavigation(ResetLocation, NavLocation, TeleportQueryExtent))
+		{
+			ResetLocation = NavLocation.Location;
+		}
+		else
+		{
+			UE_VLOG_UELOG(&Tank, LogTRTank, Warning, TEXT("%s: Teleport: %s - No navmesh within %s of %s - resetting in place"),
+				*GetName(), *Tank.GetName(), *TeleportQueryExtent.ToCompactString(), *ResetLocation.ToCompactString());
+		}
+	}
+
+	const auto GroundData = CollisionUtils::GetGroundData(Tank, ResetLocation);
+	if (!GroundData)
+	{
+		UE_VLOG_UELOG(&Tank, LogTRTank, Warning, TEXT("%s: Teleport: %s - Could not determine ground at %s"),
+			*GetName(), *Tank.GetName(), *ResetLocation.ToCompactString());
+		return false;
+	}
+
+	UE_VLOG_LOCATION(&Tank, LogTRTank, Log, Tank.GetActorLocation(), 25.0f, FColor::Yellow, TEXT("OriginalLocation"));
+	UE_VLOG_LOCATION(&Tank, LogTRTank, Log, GroundData->Location, 25.0f, FColor::Green, TEXT("ResetLocation"));
+
+	CollisionUtils::ResetActorToGround(*GroundData, Tank, TeleportZOffset);
+
+	return true;
+}
+
+void UTankRecoverySubsystem::OnTankCollision(const FObjectKey& TankKey, const FHitResult& Hit)
+{
+	if (Hit.ImpactNormal.Z > MaxBlockingNormalZ)
+	{
+		return;
+	}
+
+	if (auto Tracked = Tanks.Find(TankKey); Tracked)
+	{
+		Tracked->bBlocked = true;
+		Tracked->BlockingNormal = Hit.ImpactNormal;
+	}
+}
+
+void UTankRecoverySubsystem::OnTankDestroyed(ABaseTankPawn* DestroyedTank, AController* DestroyedBy, AActor* DestroyedWith)
+{
+	if (DestroyedTank)
+	{
+		UnregisterTank(*DestroyedTank);
+	}
+}
+
+void UTankRecoverySubsystem::LogDecisionCounts() const
+{
+	for (int32 State = 0; State < static_cast<int32>(ETankRecoveryState::MAX); ++State)
+	{
+		for (int32 Action = 0; Action < static_cast<int32>(ETankRecoveryAction::MAX); ++Action)
+		{
+			if (const auto Count = DecisionCounts[State][Action]; Count > 0)
+			{
+				UE_LOG(LogTRTank, Display, TEXT("%s: Recovery Summary: State=%s; Action=%s; Count=%d"),
+					*GetName(), LexToString(static_cast<ETankRecoveryState>(State)), LexToString(static_cast<ETankRecoveryAction>(Action)), Count);
+			}
+		}
+	}
+}
@@ -0,0 +1,81 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "Recovery/TankRecoveryClassifier.h"
+
+#include "TankRecoverySubsystem.generated.h"
+
+class ABaseTankPawn;
+class AController;
+
+/**
+ * Frees tanks that are stuck, wedged against scenery, flipped over or perched off the ground. Every registered tank is sampled at a fixed
+ * rate into a shared signal history that classifies its state, and responses escalate from a reverse-and-turn impulse to a small lift
+ * and finally a teleport to the navmesh. Every response is logged with the signals that triggered it for later analysis.
+ *
+ * Toggled with <c>tr.tank.recovery.enabled</c>. When disabled the track stuck reset and <c>UFlippedOverCorrectionComponent</c> take over.
+ */
+UCLASS()
+class UTankRecoverySubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	void RegisterTank(ABaseTankPawn& Tank);
+	void UnregisterTank(ABaseTankPawn& Tank);
+
+	static bool IsEnabled();
+
+protected:
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+
+	virtual TStatId GetStatId() const override;
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+private:
+	struct FTrackedTank
+	{
+		TWeakObjectPtr<ABaseTankPawn> Tank{};
+		TR::FTankRecoveryClassifier Classifier{};
+
+		/* Most recent steep surface collided with since the last sample. */
+		FVector BlockingNormal{ ForceInitToZero };
+		bool bBlocked{};
+
+		FDelegateHandle CollisionHandle{};
+	};
+
+	void SampleTanks(float TimeSeconds);
+
+	TR::FTankRecoverySignal Sample(FTrackedTank& Tracked, const ABaseTankPawn& Tank) const;
+
+	void Respond(FTrackedTank& Tracked, ABaseTankPawn& Tank, const TR::FTankRecoveryDecision& Decision);
+
+	void ReverseAndTurn(const FTrackedTank& Tracked, ABaseTankPawn& Tank, const TR::FTankRecoveryDecision& Decision);
+	void Lift(ABaseTankPawn& Tank, const TR::FTankRecoveryDecision& Decision);
+	bool Teleport(ABaseTankPawn& Tank);
+
+	void OnTankCollision(const FObjectKey& TankKey, const FHitResult& Hit);
+
+	UFUNCTION()
+	void OnTankDestroyed(ABaseTankPawn* DestroyedTank, AController* DestroyedBy, AActor* DestroyedWith);
+
+	void LogDecisionCounts() const;
+
+private:
+	TMap<FObjectKey, FTrackedTank> Tanks{};
+
+	FRandomStream Rng{};
+
+	float TimeSinceSample{};
+
+	/* Responses made this level by state and action for the summary logged at the end of the level. */
+	int32 DecisionCounts[static_cast<int32>(TR::ETankRecoveryState::MAX)][static_cast<int32>(TR::ETankRecoveryAction::MAX)]{};
+};
@@ -8,6 +8,9 @@
 
 #include "GameFramework/MovementComponent.h" 
 
+#include "Subsystems/TankGroundProbeSubsystem.h"
+#include "Subsystems/SpringWheelSubsystem.h"
+
 #include "TRTankLogging.h"
 #include "Logging/LoggingUtils.h"
 #include "VisualLogger/VisualLogger.h"
@@ -37,7 +40,14 @@ ASpringWheel::ASpringWheel()
 
 void ASpringWheel::AddDrivingForce(float ForceMagnitude)
 {
-	CurrentForce += ForceMagnitude;
+	if (ManagingSubsystem)
+	{
+		ManagingSubsystem->AddDrivingForce(ManagedIndex, ForceMagnitude);
+	}
+	else
+	{
+		CurrentForce += ForceMagnitude;
+	}
 
 	UE_VLOG_UELOG(GetLogContext(), LogTRTank, VeryVerbose, TEXT("%s-%s: AddDrivingForce: %f"),
 		*GetName(), *LoggingUtils::GetName(AttachParent), ForceMagnitude);
@@ -50,13 +60,58 @@ void ASpringWheel::BeginPlay()
 
 	SetupConstraint();
 	SetupTickDependencies();
+
+	if (USpringWheelSubsystem::IsEnabled())
+	{
+		SetManaged(true);
+	}
+}
+
+void ASpringWheel::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (ManagingSubsystem)
+	{
+		ManagingSubsystem->UnregisterWheel(*this);
+		ManagingSubsystem = nullptr;
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ASpringWheel::SetManaged(bool bManaged)
+{
+	if (bManaged == IsManaged())
+	{
+		return;
+	}
+
+	if (bManaged)
+	{
+		auto World = GetWorld();
+		check(World);
+
+		if (auto Subsystem = World->GetSubsystem<USpringWheelSubsystem>(); ensure(Subsystem))
+		{
+			Subsystem->RegisterWheel(*this);
+			ManagingSubsystem = Subsystem;
+
+			SetActorTickEnabled(false);
+		}
+	}
+	else
+	{
+		ManagingSubsystem->UnregisterWheel(*this);
+		ManagingSubsystem = nullptr;
+
+		SetActorTickEnabled(true);
+	}
 }
 
 void ASpringWheel::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	if (!FMath::IsNearlyZero(CurrentForce) && IsGrounded())
+	if (!FMath::IsNearlyZero(CurrentForce) && UpdateGrounded())
 	{
 		ApplyDrivingForce();
 	}
@@ -120,6 +175,53 @@ bool ASpringWheel::IsGrounded() const
 		Params);
 }
 
+bool ASpringWheel::UpdateGrounded()
+{
+	auto World = GetWorld();
+	check(World);
+
+	auto GroundProbeSubsystem = UTankGroundProbeSubsystem::IsEnabled() ? World->GetSubsystem<UTankGroundProbeSubsystem>() : nullptr;
+	if (!GroundProbeSubsystem)
+	{
+		return bGrounded = IsGrounded();
+	}
+
+	// Use the previous result while driving and refresh it for the next frame
+	if (!bGroundProbePending)
+	{
+		const auto& UpVector = WheelComponent->GetUpVector();
+		const auto& ReferenceLocation = WheelComponent->GetComponentLocation();
+		const auto TraceExtent = GroundTraceExtent + WheelComponent->GetScaledSphereRadius();
+
+		const FGroundProbeRay Ray
+		{
+			.Start = ReferenceLocation + UpVector * TraceExtent,
+			.End = ReferenceLocation - UpVector * TraceExtent
+		};
+
+		// Counted against the tank and ignores both the tank and the wheel
+		const AActor* IgnoredActors[] = { this };
+		const AActor& Tank = AttachParent ? *AttachParent : *this;
+
+		bGroundProbePending = true;
+
+		GroundProbeSubsystem->QueueProbes(Tank, MakeArrayView(&Ray, 1), IgnoredActors,
+			FOnGroundProbesCompleted::CreateUObject(this, &ThisClass::OnGroundProbesCompleted));
+	}
+
+	return bGrounded;
+}
+
+void ASpringWheel::OnGroundProbesCompleted(TConstArrayView<bool> Grounded)
+{
+	bGroundProbePending = false;
+
+	if (!Grounded.IsEmpty())
+	{
+		bGrounded = Grounded[0];
+	}
+}
+
 void ASpringWheel::ApplyDrivingForce()
 {
 	UE_VLOG_UELOG(GetLogContext(), LogTRTank, VeryVerbose, TEXT("%s-%s: ApplyDrivingForce: %f"),
@@ -161,7 +263,8 @@ void ASpringWheel::GrabDebugSnapshot(FVisualLogEntry* Snapshot) const
 	Category.Category = FString::Printf(TEXT("Wheel (%s)"), *GetName());
 
 	Category.Add(TEXT("Grounded"), LoggingUtils::GetBoolString(IsGrounded()));
-	Category.Add(TEXT("CurrentForce"), FString::Printf(TEXT("%f"), CurrentForce));
+	Category.Add(TEXT("CurrentForce"), FString::Printf(TEXT("%f"), ManagingSubsystem ? ManagingSubsystem->GetDrivingForce(ManagedIndex) : CurrentForce));
+	Category.Add(TEXT("Managed"), LoggingUtils::GetBoolString(IsManaged()));
 
 	Snapshot->AddElement(WheelComponent->GetComponentLocation(), LogTRTank.GetCategoryName(), ELogVerbosity::Log, FColor::Red, TEXT(""),
 		static_cast<uint16>(WheelComponent->GetScaledSphereRadius()));
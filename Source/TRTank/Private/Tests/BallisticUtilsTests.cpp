@@ -0,0 +1,207 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Utils/BallisticUtils.h"
+
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/ScopeExit.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace BallisticUtilsTests
+{
+	using namespace TR::BallisticUtils;
+
+	constexpr auto TestFlags = EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter;
+
+	constexpr float MaxAngleErrorDegrees = 0.01f;
+
+	/* Relative to the distance travelled so long shots are not held to a tighter absolute error than short ones. */
+	constexpr float MaxLandingError = 1e-3f;
+
+	constexpr float MaxTimeOfFlightError = 1e-3f;
+
+	/*
+	* Grid of targets around the origin at varying distance, height and heading so both horizontal components are exercised.
+	*/
+	TArray<FVector> MakeTargetGrid()
+	{
+		constexpr int32 DistanceSteps = 40;
+		constexpr int32 HeightSteps = 21;
+		constexpr float MaxDistance = 40000.0f;
+		constexpr float MaxHeight = 5000.0f;
+
+		TArray<FVector> Targets;
+		Targets.Reserve(DistanceSteps * HeightSteps);
+
+		for (int32 DistanceIndex = 1; DistanceIndex <= DistanceSteps; ++DistanceIndex)
+		{
+			for (int32 HeightIndex = 0; HeightIndex < HeightSteps; ++HeightIndex)
+			{
+				const auto Distance = MaxDistance * DistanceIndex / DistanceSteps;
+				const auto Height = MaxHeight * (2.0f * HeightIndex / (HeightSteps - 1) - 1);
+
+				Targets.Add(FRotator(0, DistanceIndex * 37.0, 0).Vector() * Distance + FVector(0, 0, Height));
+			}
+		}
+
+		return Targets;
+	}
+
+	double GetAngleDegrees(const FVector& First, const FVector& Second)
+	{
+		return FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(First.GetSafeNormal() | Second.GetSafeNormal(), -1.0, 1.0)));
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBallisticUtilsMatchesSuggestProjectileVelocityTest, "TankRampage.TRTank.BallisticUtils.MatchesSuggestProjectileVelocity", BallisticUtilsTests::TestFlags)
+
+bool FBallisticUtilsMatchesSuggestProjectileVelocityTest::RunTest(const FString& Parameters)
+{
+	using namespace BallisticUtilsTests;
+
+	// SuggestProjectileVelocity needs a world for its gravity
+	auto World = UWorld::CreateWorld(EWorldType::Game, false);
+	ON_SCOPE_EXIT
+	{
+		World->DestroyWorld(false);
+	};
+
+	const auto GravityZ = World->GetGravityZ();
+	const auto Targets = MakeTargetGrid();
+
+	for (const auto LaunchSpeed : { 5000.0f, 10000.0f })
+	{
+		for (const auto Arc : { EBallisticArc::Low, EBallisticArc::High })
+		{
+			const auto bHighArc = Arc == EBallisticArc::High;
+
+			int32 SolvedCount{};
+
+			for (const auto& Target : Targets)
+			{
+				const auto Description = FString::Printf(TEXT("LaunchSpeed=%.0f; HighArc=%d; Target=%s"), LaunchSpeed, bHighArc, *Target.ToCompactString());
+
+				FVector EngineVelocity;
+				const auto bEngineSolved = UGameplayStatics::SuggestProjectileVelocity(World, EngineVelocity, FVector::ZeroVector, Target, LaunchSpeed,
+					bHighArc, 0.0f, 0.0f, ESuggestProjVelocityTraceOption::DoNotTrace);
+
+				const auto Solution = SolveLaunch(FVector::ZeroVector, Target, LaunchSpeed, GravityZ, Arc);
+
+				if (!TestEqual(*FString::Printf(TEXT("%s solvable"), *Description), Solution.IsSet(), bEngineSolved) || !Solution)
+				{
+					continue;
+				}
+
+				++SolvedCount;
+
+				TestTrue(*FString::Printf(TEXT("%s direction within %.2f degrees"), *Description, MaxAngleErrorDegrees),
+					GetAngleDegrees(EngineVelocity, Solution->Direction) <= MaxAngleErrorDegrees);
+
+				// Following the solution for its time of flight should land on the target
+				const auto TimeOfFlight = Solution->TimeOfFlight;
+				const auto Landing = Solution->Direction * LaunchSpeed * TimeOfFlight + FVector(0, 0, 0.5 * GravityZ * FMath::Square(TimeOfFlight));
+
+				TestTrue(*FString::Printf(TEXT("%s lands at %s"), *Description, *Landing.ToCompactString()),
+					FVector::Dist(Landing, Target) <= MaxLandingError * Target.Size());
+			}
+
+			TestTrue(*FString::Printf(TEXT("LaunchSpeed=%.0f; HighArc=%d has solvable targets"), LaunchSpeed, bHighArc), SolvedCount > 0);
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBallisticUtilsBatchMatchesScalarTest, "TankRampage.TRTank.BallisticUtils.BatchMatchesScalar", BallisticUtilsTests::TestFlags)
+
+bool FBallisticUtilsBatchMatchesScalarTest::RunTest(const FString& Parameters)
+{
+	using namespace BallisticUtilsTests;
+
+	constexpr int32 Count = 1000;
+	constexpr float GravityZ = -980.0f;
+
+	FRandomStream Rng(1234);
+
+	TArray<float> StartX, StartY, StartZ, TargetX, TargetY, TargetZ, LaunchSpeed;
+
+	const auto AddCase = [&](const FVector& Start, const FVector& Target, float Speed)
+	{
+		StartX.Add(Start.X);
+		StartY.Add(Start.Y);
+		StartZ.Add(Start.Z);
+		TargetX.Add(Target.X);
+		TargetY.Add(Target.Y);
+		TargetZ.Add(Target.Z);
+		LaunchSpeed.Add(Speed);
+	};
+
+	for (int32 i = 0; i < Count; ++i)
+	{
+		const auto Start = FVector(Rng.FRandRange(-10000, 10000), Rng.FRandRange(-10000, 10000), Rng.FRandRange(-1000, 1000));
+		const auto Target = Start + Rng.GetUnitVector() * Rng.FRandRange(100, 40000);
+
+		AddCase(Start, Target, Rng.FRandRange(3000, 12000));
+	}
+
+	// The batch only solves low arcs with horizontal travel so targets directly above or below are reported out of range
+	AddCase(FVector::ZeroVector, FVector(0, 0, 1000), 10000.0f);
+	AddCase(FVector::ZeroVector, FVector(0, 0, -1000), 10000.0f);
+
+	const FBallisticBatchInput Input
+	{
+		.StartX = StartX, .StartY = StartY, .StartZ = StartZ,
+		.TargetX = TargetX, .TargetY = TargetY, .TargetZ = TargetZ,
+		.LaunchSpeed = LaunchSpeed
+	};
+
+	FBallisticBatchOutput Output;
+	SolveLaunchBatch(Input, GravityZ, Output);
+
+	if (!TestEqual(TEXT("Output size"), Output.TimeOfFlight.Num(), LaunchSpeed.Num()))
+	{
+		return true;
+	}
+
+	int32 SolvedCount{};
+
+	for (int32 i = 0; i < Count; ++i)
+	{
+		const auto Start = FVector(StartX[i], StartY[i], StartZ[i]);
+		const auto Target = FVector(TargetX[i], TargetY[i], TargetZ[i]);
+		const auto Description = FString::Printf(TEXT("Case %d: Start=%s; Target=%s; LaunchSpeed=%.0f"), i, *Start.ToCompactString(), *Target.ToCompactString(), LaunchSpeed[i]);
+
+		const auto Solution = SolveLaunch(Start, Target, LaunchSpeed[i], GravityZ);
+		const auto bBatchSolved = Output.TimeOfFlight[i] >= 0;
+
+		if (!TestEqual(*FString::Printf(TEXT("%s solvable"), *Description), bBatchSolved, Solution.IsSet()) || !Solution)
+		{
+			continue;
+		}
+
+		++SolvedCount;
+
+		const auto BatchDirection = FVector(Output.DirectionX[i], Output.DirectionY[i], Output.DirectionZ[i]);
+
+		TestTrue(*FString::Printf(TEXT("%s direction within %.2f degrees"), *Description, MaxAngleErrorDegrees),
+			GetAngleDegrees(BatchDirection, Solution->Direction) <= MaxAngleErrorDegrees);
+
+		TestTrue(*FString::Printf(TEXT("%s time of flight %.4f matches %.4f"), *Description, Output.TimeOfFlight[i], Solution->TimeOfFlight),
+			FMath::IsNearlyEqual(Output.TimeOfFlight[i], Solution->TimeOfFlight, MaxTimeOfFlightError * FMath::Max(1.0f, Solution->TimeOfFlight)));
+	}
+
+	TestTrue(TEXT("Some cases solvable"), SolvedCount > 0);
+	TestTrue(TEXT("Some cases out of range"), SolvedCount < Count);
+
+	for (int32 i = Count; i < LaunchSpeed.Num(); ++i)
+	{
+		TestTrue(*FString::Printf(TEXT("Vertical case %d out of range"), i - Count), Output.TimeOfFlight[i] < 0);
+	}
+
+	return true;
+}
+
+#endif
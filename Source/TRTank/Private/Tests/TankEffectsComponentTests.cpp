@@ -0,0 +1,101 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Components/TankEffectsComponent.h"
+
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/ScopeExit.h"
+#include "NiagaraComponent.h"
+#include "NiagaraSystem.h"
+#include "Subsystems/VfxManagerSubsystem.h"
+#include "UObject/UObjectIterator.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace TankEffectsComponentTests
+{
+	constexpr auto TestFlags = EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter;
+
+	const FName ScaleParameterName = TEXT("DeathScale");
+	constexpr float ScaleParameterValue = 2.5f;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTankEffectsComponentOwnerDestroyedTest, "TankRampage.TRTank.TankEffectsComponent.OwnerDestroyed", TankEffectsComponentTests::TestFlags)
+
+bool FTankEffectsComponentOwnerDestroyedTest::RunTest(const FString& Parameters)
+{
+	using namespace TankEffectsComponentTests;
+
+	if (!UVfxManagerSubsystem::IsEnabled())
+	{
+		AddInfo(TEXT("tr.vfx.enabled is 0 so the death effect is not deferred"));
+		return true;
+	}
+
+	auto World = UWorld::CreateWorld(EWorldType::Game, false);
+	ON_SCOPE_EXIT
+	{
+		World->DestroyWorld(false);
+	};
+
+	auto Subsystem = World->GetSubsystem<UVfxManagerSubsystem>();
+	if (!TestNotNull(TEXT("Subsystem"), Subsystem))
+	{
+		return true;
+	}
+
+	auto System = NewObject<UNiagaraSystem>(GetTransientPackage());
+
+	// Any owner will do as the death effect is played directly rather than from the tank destroyed event
+	auto Owner = World->SpawnActor<AActor>();
+	if (!TestNotNull(TEXT("Owner"), Owner))
+	{
+		return true;
+	}
+
+	auto Component = NewObject<UTankEffectsComponent>(Owner);
+	Component->RegisterComponent();
+
+	Component->DeathVfx = System;
+	Component->DeathVfxScaleParameterName = ScaleParameterName;
+	Component->DeathVfxScaleParameterValue = ScaleParameterValue;
+
+	Component->PlayDeathVfx();
+
+	// As when a tank is destroyed on death in the same frame as its effect is queued. Weak references to the component are now stale
+	Owner->Destroy();
+
+	TestFalse(TEXT("Component destroyed"), IsValid(Component));
+	TestEqual(TEXT("Pending before flush"), Subsystem->NumPending(), 1);
+	TestEqual(TEXT("Issued"), Subsystem->FlushPendingVfx(), 1);
+
+	if (Subsystem->GetCounters().Spawned == 0)
+	{
+		AddInfo(TEXT("Niagara did not spawn the empty test system so its parameters cannot be checked"));
+		return true;
+	}
+
+	UNiagaraComponent* NiagaraComponent{};
+	for (auto Candidate : TObjectRange<UNiagaraComponent>())
+	{
+		if (Candidate->GetWorld() == World && Candidate->GetAsset() == System)
+		{
+			NiagaraComponent = Candidate;
+			break;
+		}
+	}
+
+	if (!TestNotNull(TEXT("NiagaraComponent"), NiagaraComponent))
+	{
+		return true;
+	}
+
+	const FNiagaraVariable ScaleParameter(FNiagaraTypeDefinition::GetFloatDef(), ScaleParameterName);
+	TestEqual(TEXT("Scale parameter set after the owner was destroyed"), NiagaraComponent->GetOverrideParameters().GetParameterValue<float>(ScaleParameter), ScaleParameterValue);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,242 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Recovery/TankRecoveryClassifier.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace TankRecoveryClassifierTests
+{
+	using namespace TR;
+
+	constexpr auto TestFlags = EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter;
+
+	struct FResponse
+	{
+		float TimeSeconds{};
+		FTankRecoveryDecision Decision{};
+	};
+
+	/*
+	* Feeds a trace to the classifier at the configured sample rate and returns the responses made.
+	*/
+	TArray<FResponse> RunTrace(FTankRecoveryClassifier& Classifier, float& TimeSeconds, float DurationSeconds, TFunctionRef<FTankRecoverySignal()> SignalFunc)
+	{
+		TArray<FResponse> Responses;
+
+		const auto SampleInterval = Classifier.GetConfig().SampleIntervalSeconds;
+
+		for (const auto EndTime = TimeSeconds + DurationSeconds; TimeSeconds < EndTime; TimeSeconds += SampleInterval)
+		{
+			if (const auto Decision = Classifier.AddSample(TimeSeconds, SignalFunc()); Decision.Action != ETankRecoveryAction::None)
+			{
+				Responses.Add({ TimeSeconds, Decision });
+			}
+		}
+
+		return Responses;
+	}
+
+	/*
+	* Synthetic tank signals. Position is carried across traces so that switching between them doesn't look like a jump.
+	*/
+	struct FTraceSource
+	{
+		FRandomStream Rng{ 1234 };
+		FVector Position{ ForceInitToZero };
+		int32 SampleCount{};
+
+		/* Sensor jitter well under the stuck displacement. */
+		FVector Jittered()
+		{
+			return Position + FVector(Rng.FRandRange(-5, 5), Rng.FRandRange(-5, 5), 0);
+		}
+
+		FTankRecoverySignal Driving()
+		{
+			Position += FVector(50, 0, 0);
+			return { .Location = Jittered(), .Speed = 500, .Throttle = 1 };
+		}
+
+		/* Blocked on every other sample when <c>bBlocked</c>. */
+		FTankRecoverySignal Stationary(float Throttle, bool bBlocked = false)
+		{
+			return { .Location = Jittered(), .Speed = Rng.FRandRange(0, 10), .Throttle = Throttle, .bBlocked = bBlocked && (++SampleCount % 2 == 0) };
+		}
+	};
+
+	/*
+	* Checks the responses walk the ladder of the state, keep teleporting at the top and are spaced by the response interval.
+	*/
+	void TestLadder(FAutomationTestBase& Test, const TCHAR* Scenario, const FTankRecoveryClassifier& Classifier, const TArray<FResponse>& Responses, ETankRecoveryState ExpectedState)
+	{
+		const auto Ladder = FTankRecoveryClassifier::GetResponseLadder(ExpectedState);
+		const auto& Config = Classifier.GetConfig();
+
+		if (!Test.TestTrue(*FString::Printf(TEXT("%s: Responses=%d cover the ladder of %d"), Scenario, Responses.Num(), Ladder.Num()), Responses.Num() >= Ladder.Num()))
+		{
+			return;
+		}
+
+		for (int32 i = 0; i < Responses.Num(); ++i)
+		{
+			const auto& Decision = Responses[i].Decision;
+
+			// Keeps teleporting once at the top of the ladder
+			const auto ExpectedAction = Ladder[FMath::Min(i, Ladder.Num() - 1)];
+
+			if (!Test.TestTrue(*FString::Printf(TEXT("%s: Response %d is %s %s; Got %s"), Scenario, i, LexToString(ExpectedState), LexToString(ExpectedAction), *Decision.ToString()),
+				Decision.State == ExpectedState && Decision.Action == ExpectedAction && Decision.Attempt == i))
+			{
+				return;
+			}
+
+			if (i > 0 && !Test.TestTrue(*FString::Printf(TEXT("%s: Response %d interval"), Scenario, i),
+				Responses[i].TimeSeconds - Responses[i - 1].TimeSeconds + UE_KINDA_SMALL_NUMBER >= Config.ResponseIntervalSeconds))
+			{
+				return;
+			}
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTankRecoveryClassifierNoResponseTest, "TankRampage.TRTank.TankRecoveryClassifier.NoResponse", TankRecoveryClassifierTests::TestFlags)
+
+bool FTankRecoveryClassifierNoResponseTest::RunTest(const FString& Parameters)
+{
+	using namespace TankRecoveryClassifierTests;
+
+	FTraceSource Source;
+	float TimeSeconds{};
+
+	FTankRecoveryClassifier Classifier;
+
+	TestEqual(TEXT("Driving"), RunTrace(Classifier, TimeSeconds, 20, [&]() { return Source.Driving(); }).Num(), 0);
+	TestEqual(TEXT("State after driving"), Classifier.GetState(), ETankRecoveryState::None);
+
+	// Sitting still without much throttle is waiting rather than stuck
+	TestEqual(TEXT("Idling"), RunTrace(Classifier, TimeSeconds, 20, [&]() { return Source.Stationary(0.1f); }).Num(), 0);
+
+	// Short fast jumps between driving are left alone
+	for (int32 i = 0; i < 5; ++i)
+	{
+		TestEqual(*FString::Printf(TEXT("Jump %d"), i), RunTrace(Classifier, TimeSeconds, 2, [&]()
+		{
+			Source.Position += FVector(80, 0, 20);
+			return FTankRecoverySignal{ .Location = Source.Position, .Speed = 800, .Throttle = 1, .bGrounded = false };
+		}).Num(), 0);
+
+		TestEqual(*FString::Printf(TEXT("Driving after jump %d"), i), RunTrace(Classifier, TimeSeconds, 2, [&]() { return Source.Driving(); }).Num(), 0);
+	}
+
+	// Rolling over at speed may still right itself
+	TestEqual(TEXT("Rolling"), RunTrace(Classifier, TimeSeconds, 10, [&]()
+	{
+		Source.Position += FVector(50, 0, 0);
+		return FTankRecoverySignal{ .Location = Source.Position, .UpAlignment = 0, .Speed = 500, .Throttle = 1 };
+	}).Num(), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTankRecoveryClassifierLaddersTest, "TankRampage.TRTank.TankRecoveryClassifier.Ladders", TankRecoveryClassifierTests::TestFlags)
+
+bool FTankRecoveryClassifierLaddersTest::RunTest(const FString& Parameters)
+{
+	using namespace TankRecoveryClassifierTests;
+
+	FTraceSource Source;
+	float TimeSeconds{};
+
+	{
+		FTankRecoveryClassifier Classifier;
+		const auto Responses = RunTrace(Classifier, TimeSeconds, 20, [&]() { return Source.Stationary(1.0f); });
+
+		TestLadder(*this, TEXT("Stuck"), Classifier, Responses, ETankRecoveryState::Stuck);
+	}
+
+	{
+		FTankRecoveryClassifier Classifier;
+		const auto Responses = RunTrace(Classifier, TimeSeconds, 20, [&]() { return Source.Stationary(-1.0f, true); });
+
+		TestLadder(*this, TEXT("Wedged"), Classifier, Responses, ETankRecoveryState::Wedged);
+	}
+
+	{
+		FTankRecoveryClassifier Classifier;
+		const auto Responses = RunTrace(Classifier, TimeSeconds, 20, [&]()
+		{
+			return FTankRecoverySignal{ .Location = Source.Jittered(), .UpAlignment = -0.8f, .Speed = 5, .Throttle = 1 };
+		});
+
+		TestLadder(*this, TEXT("Flipped"), Classifier, Responses, ETankRecoveryState::Flipped);
+
+		if (!Responses.IsEmpty())
+		{
+			TestTrue(TEXT("Flipped waits for the delay"), Responses[0].Decision.StateSeconds + UE_KINDA_SMALL_NUMBER >= Classifier.GetConfig().FlippedDelaySeconds);
+		}
+	}
+
+	{
+		FTankRecoveryClassifier Classifier;
+		const auto Responses = RunTrace(Classifier, TimeSeconds, 20, [&]()
+		{
+			return FTankRecoverySignal{ .Location = Source.Jittered(), .Speed = 2, .Throttle = 1, .bGrounded = false };
+		});
+
+		TestLadder(*this, TEXT("Perched"), Classifier, Responses, ETankRecoveryState::Airborne);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTankRecoveryClassifierRelapseTest, "TankRampage.TRTank.TankRecoveryClassifier.Relapse", TankRecoveryClassifierTests::TestFlags)
+
+bool FTankRecoveryClassifierRelapseTest::RunTest(const FString& Parameters)
+{
+	using namespace TankRecoveryClassifierTests;
+
+	FTraceSource Source;
+	float TimeSeconds{};
+
+	FTankRecoveryClassifier Classifier;
+
+	const auto WindowSeconds = Classifier.GetConfig().WindowSeconds;
+	const auto StuckLadder = FTankRecoveryClassifier::GetResponseLadder(ETankRecoveryState::Stuck);
+
+	// Getting free briefly and then stuck again continues up the ladder
+	const auto First = RunTrace(Classifier, TimeSeconds, WindowSeconds + 0.5f, [&]() { return Source.Stationary(1.0f); });
+	RunTrace(Classifier, TimeSeconds, 1, [&]() { return Source.Driving(); });
+	const auto Relapse = RunTrace(Classifier, TimeSeconds, WindowSeconds + 0.5f, [&]() { return Source.Stationary(1.0f); });
+
+	if (TestEqual(TEXT("First responses"), First.Num(), 1))
+	{
+		TestEqual(TEXT("First action"), First[0].Decision.Action, StuckLadder[0]);
+	}
+
+	if (TestFalse(TEXT("Relapse responded"), Relapse.IsEmpty()))
+	{
+		TestEqual(TEXT("Relapse attempt"), Relapse[0].Decision.Attempt, 1);
+		TestEqual(TEXT("Relapse action"), Relapse[0].Decision.Action, StuckLadder[1]);
+	}
+
+	// Staying free past the relapse time starts the ladder over
+	RunTrace(Classifier, TimeSeconds, Classifier.GetConfig().RelapseSeconds + 1, [&]() { return Source.Driving(); });
+	const auto Later = RunTrace(Classifier, TimeSeconds, WindowSeconds + 0.5f, [&]() { return Source.Stationary(1.0f); });
+
+	if (TestFalse(TEXT("Later responded"), Later.IsEmpty()))
+	{
+		TestEqual(TEXT("Later attempt"), Later[0].Decision.Attempt, 0);
+	}
+
+	// Teleport forgets the history
+	Classifier.Reset();
+	TestEqual(TEXT("State after reset"), Classifier.GetState(), ETankRecoveryState::None);
+	TestEqual(TEXT("Responses within a window of reset"), RunTrace(Classifier, TimeSeconds, WindowSeconds - 0.5f, [&]() { return Source.Stationary(1.0f); }).Num(), 0);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,319 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Utils/BallisticUtils.h"
+
+#include "TRConstants.h"
+
+#include "TRTankLogging.h"
+
+#if TR_DEBUG_ENABLED
+	#include "HAL/IConsoleManager.h"
+	#include "Kismet/GameplayStatics.h"
+	#include "Engine/World.h"
+#endif
+
+using namespace TR::BallisticUtils;
+
+namespace
+{
+	/* Fixed point iterations of the intercept time. Each one typically reduces the error by the ratio of target to projectile speed. */
+	constexpr int32 MaxInterceptIterations = 4;
+	constexpr float InterceptTimeToleranceSeconds = 1e-3f;
+
+	constexpr float MinHorizontalDistance = 1.0f;
+
+	TOptional<FBallisticSolution> SolveVerticalLaunch(float DeltaZ, float LaunchSpeed, float Gravity);
+	FBallisticSolution SolveDirectLaunch(const FVector& Delta, float LaunchSpeed);
+}
+
+TOptional<FBallisticSolution> TR::BallisticUtils::SolveLaunch(const FVector& Start, const FVector& Target, float LaunchSpeed, float GravityZ, EBallisticArc Arc)
+{
+	if (LaunchSpeed <= UE_KINDA_SMALL_NUMBER)
+	{
+		return {};
+	}
+
+	const auto Delta = Target - Start;
+	const auto Gravity = -GravityZ;
+
+	if (Gravity <= UE_KINDA_SMALL_NUMBER)
+	{
+		return SolveDirectLaunch(Delta, LaunchSpeed);
+	}
+
+	const auto HorizontalDistance = static_cast<float>(Delta.Size2D());
+	const auto DeltaZ = static_cast<float>(Delta.Z);
+
+	if (HorizontalDistance < MinHorizontalDistance)
+	{
+		return SolveVerticalLaunch(DeltaZ, LaunchSpeed, Gravity);
+	}
+
+	// Launch angle satisfies tan(theta) = (v^2 -/+ sqrt(v^4 - g(g x^2 + 2 y v^2))) / (g x)
+	const auto SpeedSq = FMath::Square(LaunchSpeed);
+	const auto Discriminant = FMath::Square(SpeedSq) - Gravity * (Gravity * FMath::Square(HorizontalDistance) + 2 * DeltaZ * SpeedSq);
+
+	if (Discriminant < 0)
+	{
+		return {};
+	}
+
+	const auto SqrtDiscriminant = FMath::Sqrt(Discriminant);
+	const auto TanTheta = (Arc == EBallisticArc::Low ? SpeedSq - SqrtDiscriminant : SpeedSq + SqrtDiscriminant) / (Gravity * HorizontalDistance);
+
+	// 1 / cos(theta) scales the horizontal direction and time of flight
+	const auto SecTheta = FMath::Sqrt(1 + FMath::Square(TanTheta));
+	const auto HorizontalDirection = FVector(Delta.X, Delta.Y, 0) / HorizontalDistance;
+
+	return FBallisticSolution
+	{
+		.Direction = (HorizontalDirection + FVector::UpVector * TanTheta) / SecTheta,
+		.TimeOfFlight = HorizontalDistance * SecTheta / LaunchSpeed
+	};
+}
+
+TOptional<FBallisticSolution> TR::BallisticUtils::SolveIntercept(const FVector& Start, const FVector& Target, const FVector& TargetVelocity, float LaunchSpeed, float GravityZ, EBallisticArc Arc)
+{
+	auto Solution = SolveLaunch(Start, Target, LaunchSpeed, GravityZ, Arc);
+
+	if (!Solution || TargetVelocity.IsNearlyZero())
+	{
+		return Solution;
+	}
+
+	for (int32 Iteration = 0; Iteration < MaxInterceptIterations; ++Iteration)
+	{
+		const auto PredictedTarget = Target + TargetVelocity * Solution->TimeOfFlight;
+		const auto NextSolution = SolveLaunch(Start, PredictedTarget, LaunchSpeed, GravityZ, Arc);
+
+		if (!NextSolution)
+		{
+			return {};
+		}
+
+		const auto bConverged = FMath::Abs(NextSolution->TimeOfFlight - Solution->TimeOfFlight) <= InterceptTimeToleranceSeconds;
+		Solution = NextSolution;
+
+		if (bConverged)
+		{
+			break;
+		}
+	}
+
+	return Solution;
+}
+
+void TR::BallisticUtils::FBallisticBatchOutput::Reset(int32 Num)
+{
+	DirectionX.SetNumUninitialized(Num);
+	DirectionY.SetNumUninitialized(Num);
+	DirectionZ.SetNumUninitialized(Num);
+	TimeOfFlight.SetNumUninitialized(Num);
+}
+
+void TR::BallisticUtils::SolveLaunchBatch(const FBallisticBatchInput& Input, float GravityZ, FBallisticBatchOutput& Output)
+{
+	const auto Num = Input.LaunchSpeed.Num();
+
+	check(Input.StartX.Num() == Num && Input.StartY.Num() == Num && Input.StartZ.Num() == Num);
+	check(Input.TargetX.Num() == Num && Input.TargetY.Num() == Num && Input.TargetZ.Num() == Num);
+
+	Output.Reset(Num);
+
+	const auto Gravity = -GravityZ;
+
+	// Degenerate gravity needs the direct solution so take the scalar path rather than branching in the loop
+	if (Gravity <= UE_KINDA_SMALL_NUMBER)
+	{
+		for (int32 i = 0; i < Num; ++i)
+		{
+			const auto Solution = SolveLaunch(
+				FVector(Input.StartX[i], Input.StartY[i], Input.StartZ[i]), FVector(Input.TargetX[i], Input.TargetY[i], Input.TargetZ[i]), Input.LaunchSpeed[i], GravityZ);
+
+			Output.DirectionX[i] = Solution ? Solution->Direction.X : 0.0f;
+			Output.DirectionY[i] = Solution ? Solution->Direction.Y : 0.0f;
+			Output.DirectionZ[i] = Solution ? Solution->Direction.Z : 0.0f;
+			Output.TimeOfFlight[i] = Solution ? Solution->TimeOfFlight : -1.0f;
+		}
+		return;
+	}
+
+	const float* RESTRICT StartX = Input.StartX.GetData();
+	const float* RESTRICT StartY = Input.StartY.GetData();
+	const float* RESTRICT StartZ = Input.StartZ.GetData();
+	const float* RESTRICT TargetX = Input.TargetX.GetData();
+	const float* RESTRICT TargetY = Input.TargetY.GetData();
+	const float* RESTRICT TargetZ = Input.TargetZ.GetData();
+	const float* RESTRICT LaunchSpeed = Input.LaunchSpeed.GetData();
+
+	float* RESTRICT DirectionX = Output.DirectionX.GetData();
+	float* RESTRICT DirectionY = Output.DirectionY.GetData();
+	float* RESTRICT DirectionZ = Output.DirectionZ.GetData();
+	float* RESTRICT TimeOfFlight = Output.TimeOfFlight.GetData();
+
+	// Same math as SolveLaunch with selects instead of early outs. Targets directly above or below are reported out of range
+	for (int32 i = 0; i < Num; ++i)
+	{
+		const float DeltaX = TargetX[i] - StartX[i];
+		const float DeltaY = TargetY[i] - StartY[i];
+		const float DeltaZ = TargetZ[i] - StartZ[i];
+
+		const float HorizontalDistSq = DeltaX * DeltaX + DeltaY * DeltaY;
+		const float HorizontalDistance = FMath::Max(FMath::Sqrt(HorizontalDistSq), MinHorizontalDistance);
+		const float Speed = FMath::Max(LaunchSpeed[i], UE_KINDA_SMALL_NUMBER);
+		const float SpeedSq = Speed * Speed;
+
+		const float Discriminant = SpeedSq * SpeedSq - Gravity * (Gravity * HorizontalDistSq + 2 * DeltaZ * SpeedSq);
+		const bool bValid = Discriminant >= 0 && HorizontalDistSq >= MinHorizontalDistance * MinHorizontalDistance && LaunchSpeed[i] > UE_KINDA_SMALL_NUMBER;
+
+		const float TanTheta = (SpeedSq - FMath::Sqrt(FMath::Max(Discriminant, 0.0f))) / (Gravity * HorizontalDistance);
+		const float SecTheta = FMath::Sqrt(1 + TanTheta * TanTheta);
+		const float HorizontalScale = 1 / (HorizontalDistance * SecTheta);
+
+		DirectionX[i] = bValid ? DeltaX * HorizontalScale : 0.0f;
+		DirectionY[i] = bValid ? DeltaY * HorizontalScale : 0.0f;
+		DirectionZ[i] = bValid ? TanTheta / SecTheta : 0.0f;
+		TimeOfFlight[i] = bValid ? HorizontalDistance * SecTheta / Speed : -1.0f;
+	}
+}
+
+namespace
+{
+	TOptional<FBallisticSolution> SolveVerticalLaunch(float DeltaZ, float LaunchSpeed, float Gravity)
+	{
+		// Solve DeltaZ = +/-v t - g t^2 / 2 for the first positive t
+		const auto Discriminant = FMath::Square(LaunchSpeed) - 2 * Gravity * DeltaZ;
+		if (Discriminant < 0)
+		{
+			return {};
+		}
+
+		const auto SqrtDiscriminant = FMath::Sqrt(Discriminant);
+
+		return FBallisticSolution
+		{
+			.Direction = DeltaZ >= 0 ? FVector::UpVector : FVector::DownVector,
+			.TimeOfFlight = (DeltaZ >= 0 ? LaunchSpeed - SqrtDiscriminant : SqrtDiscriminant - LaunchSpeed) / Gravity
+		};
+	}
+
+	FBallisticSolution SolveDirectLaunch(const FVector& Delta, float LaunchSpeed)
+	{
+		return FBallisticSolution
+		{
+			.Direction = Delta.GetSafeNormal(),
+			.TimeOfFlight = static_cast<float>(Delta.Size()) / LaunchSpeed
+		};
+	}
+}
+
+#pragma region Benchmark
+
+#if TR_DEBUG_ENABLED
+
+namespace
+{
+	/*
+	* Times UGameplayStatics::SuggestProjectileVelocity against the scalar and batch analytic solvers across a grid of distances and heights.
+	* Agreement between them is checked by the TankRampage.TRTank.BallisticUtils automation tests.
+	*/
+	void RunBallisticSolverBenchmark(const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World)
+		{
+			return;
+		}
+
+		const float LaunchSpeed = Args.Num() > 0 ? FCString::Atof(*Args[0]) : 10000.0f;
+		const int32 Repeats = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 100;
+		const float GravityZ = World->GetGravityZ();
+
+		constexpr int32 DistanceSteps = 40;
+		constexpr int32 HeightSteps = 21;
+		constexpr float MaxDistance = 40000.0f;
+		constexpr float MaxHeight = 5000.0f;
+
+		TArray<FVector> Targets;
+		Targets.Reserve(DistanceSteps * HeightSteps);
+
+		for (int32 DistanceIndex = 1; DistanceIndex <= DistanceSteps; ++DistanceIndex)
+		{
+			for (int32 HeightIndex = 0; HeightIndex < HeightSteps; ++HeightIndex)
+			{
+				const auto Distance = MaxDistance * DistanceIndex / DistanceSteps;
+				const auto Height = MaxHeight * (2.0f * HeightIndex / (HeightSteps - 1) - 1);
+
+				// Vary the heading as well so both horizontal components are exercised
+				Targets.Add(FRotator(0, DistanceIndex * 37.0, 0).Vector() * Distance + FVector(0, 0, Height));
+			}
+		}
+
+		FVector Velocity;
+
+		const auto EngineStartTime = FPlatformTime::Seconds();
+		for (int32 Repeat = 0; Repeat < Repeats; ++Repeat)
+		{
+			for (const auto& Target : Targets)
+			{
+				UGameplayStatics::SuggestProjectileVelocity(World, Velocity, FVector::ZeroVector, Target, LaunchSpeed, false, 0.0f, 0.0f, ESuggestProjVelocityTraceOption::DoNotTrace);
+			}
+		}
+		const auto EngineSeconds = FPlatformTime::Seconds() - EngineStartTime;
+
+		int32 SolvedCount{};
+
+		const auto AnalyticStartTime = FPlatformTime::Seconds();
+		for (int32 Repeat = 0; Repeat < Repeats; ++Repeat)
+		{
+			for (const auto& Target : Targets)
+			{
+				SolvedCount += SolveLaunch(FVector::ZeroVector, Target, LaunchSpeed, GravityZ).IsSet();
+			}
+		}
+		const auto AnalyticSeconds = FPlatformTime::Seconds() - AnalyticStartTime;
+
+		const auto Count = Targets.Num();
+		TArray<float> Zeros, TargetX, TargetY, TargetZ, Speeds;
+		Zeros.SetNumZeroed(Count);
+		Speeds.Init(LaunchSpeed, Count);
+
+		for (const auto& Target : Targets)
+		{
+			TargetX.Add(Target.X);
+			TargetY.Add(Target.Y);
+			TargetZ.Add(Target.Z);
+		}
+
+		const FBallisticBatchInput BatchInput
+		{
+			.StartX = Zeros, .StartY = Zeros, .StartZ = Zeros,
+			.TargetX = TargetX, .TargetY = TargetY, .TargetZ = TargetZ,
+			.LaunchSpeed = Speeds
+		};
+		FBallisticBatchOutput BatchOutput;
+
+		const auto BatchStartTime = FPlatformTime::Seconds();
+		for (int32 Repeat = 0; Repeat < Repeats; ++Repeat)
+		{
+			SolveLaunchBatch(BatchInput, GravityZ, BatchOutput);
+		}
+		const auto BatchSeconds = FPlatformTime::Seconds() - BatchStartTime;
+
+		const auto SolveCount = static_cast<double>(Count) * Repeats;
+
+		UE_LOG(LogTRTank, Display,
+			TEXT("RunBallisticSolverBenchmark: LaunchSpeed=%.1fm/s; Targets=%d; Solved=%d; Repeats=%d - Engine=%.3fus/solve; Analytic=%.3fus/solve; Batch=%.3fus/solve"),
+			LaunchSpeed / 100, Count, SolvedCount / Repeats, Repeats,
+			EngineSeconds * 1e6 / SolveCount, AnalyticSeconds * 1e6 / SolveCount, BatchSeconds * 1e6 / SolveCount);
+	}
+
+	FAutoConsoleCommandWithWorldAndArgs BallisticSolverBenchmarkCommand(
+		TEXT("tr.tank.ballistics.benchmark"),
+		TEXT("Times the analytic ballistic solvers against SuggestProjectileVelocity over a grid of distances and heights: [LaunchSpeedCm=10000] [Repeats=100]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunBallisticSolverBenchmark));
+}
+
+#endif
+
+#pragma endregion Benchmark
@@ -50,6 +50,7 @@ struct FAimingData
 
 class UTankBarrelComponent;
 class UTankTurretComponent;
+class UTankAttributeSnapshotComponent;
 
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class UTankAimingComponent : public UActorComponent
@@ -62,6 +63,7 @@ public:
 	{
 		UTankBarrelComponent* Barrel{};
 		UTankTurretComponent* Turret{};
+		UTankAttributeSnapshotComponent* AttributeSnapshot{};
 	};
 
 	UTankAimingComponent();
@@ -124,6 +126,9 @@ private:
 	UPROPERTY(Transient)
 	TObjectPtr<UTankTurretComponent> Turret{};
 
+	UPROPERTY(Transient)
+	TObjectPtr<UTankAttributeSnapshotComponent> AttributeSnapshot{};
+
 	UPROPERTY(Category = Setup, EditDefaultsOnly)
 	float AimToleranceDegrees{ 2.5f };
 
@@ -0,0 +1,72 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "GameplayTagContainer.h"
+#include "TankAttributeSnapshotComponent.generated.h"
+
+class UAbilitySystemComponent;
+
+/*
+* Gameplay tag state that the tank components read every frame.
+*/
+struct FTankAttributeSnapshot
+{
+	/* Driving force multiplier from the speed multiplier tag count. 1 when there are no speed tags. */
+	float SpeedMultiplier{ 1.0f };
+
+	bool bMovementBlocked{};
+	bool bAimBlocked{};
+};
+
+/*
+* Copies the gameplay tag state of the owner's ability system component into a plain struct so that track, movement and aiming components
+* don't need to resolve the tags and query the ability system component each time they drive or aim.
+* The snapshot is only updated when the ability system component signals a tag count change.
+*/
+UCLASS(ClassGroup = (Custom))
+class TRTANK_API UTankAttributeSnapshotComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UTankAttributeSnapshotComponent();
+
+	const FTankAttributeSnapshot& GetSnapshot() const;
+
+	/*
+	* Re-reads all the tag counts from the ability system component. Change events keep the snapshot current so this is only needed on binding.
+	*/
+	void Refresh();
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	void BindAbilitySystemEvents();
+	void UnbindAbilitySystemEvents();
+
+	void OnTagCountChanged(const FGameplayTag Tag, int32 NewCount);
+
+	void ApplyTagCount(const FGameplayTag& Tag, int32 Count);
+
+private:
+	struct FTagBinding
+	{
+		FGameplayTag Tag{};
+		FDelegateHandle Handle{};
+	};
+
+	TArray<FTagBinding, TInlineAllocator<3>> TagBindings{};
+
+	TWeakObjectPtr<UAbilitySystemComponent> BoundAbilitySystemComponent{};
+
+	FGameplayTag SpeedMultiplierTag{};
+	FGameplayTag MovementBlockedTag{};
+	FGameplayTag AimBlockedTag{};
+
+	FTankAttributeSnapshot Snapshot{};
+};
@@ -7,6 +7,7 @@
 #include "TankMovementComponent.generated.h"
 
 class UTankTrackComponent;
+class UTankAttributeSnapshotComponent;
 
 /**
  * 
@@ -24,6 +25,7 @@ public:
 	{
 		UTankTrackComponent* LeftTrack{};
 		UTankTrackComponent* RightTrack{};
+		UTankAttributeSnapshotComponent* AttributeSnapshot{};
 
 		FString ToString() const;
 	};
@@ -70,6 +72,9 @@ private:
 	UPROPERTY(Transient)
 	TObjectPtr<UTankTrackComponent> RightTrack{};
 
+	UPROPERTY(Transient)
+	TObjectPtr<UTankAttributeSnapshotComponent> AttributeSnapshot{};
+
 #if ENABLE_VISUAL_LOG
 	FVector LastMovementVector{ EForceInit::ForceInitToZero };
 	float LastMovementTime{ -1.0f };
@@ -27,6 +27,7 @@ class UTankEffectsComponent;
 class UTankCollisionDetectionComponent;
 class UTankCrashComponent;
 class UTankEngineSoundsComponent;
+class UTankAttributeSnapshotComponent;
 class UAbilitySystemComponent;
 class UAttributeSet;
 class UGameplayEffect;
@@ -101,6 +102,8 @@ public:
 
 	UItemInventory* GetItemInventory() const;
 
+	UTankAttributeSnapshotComponent* GetAttributeSnapshotComponent() const;
+
 #if ENABLE_VISUAL_LOG
 	virtual void GrabDebugSnapshot(FVisualLogEntry* Snapshot) const override;
 #endif
@@ -154,6 +157,9 @@ protected:
 	UPROPERTY(Category = "Components", VisibleDefaultsOnly, BlueprintReadOnly)
 	TObjectPtr<UItemInventory> ItemInventoryComponent{};
 
+	UPROPERTY(Category = "GAS", VisibleDefaultsOnly)
+	TObjectPtr<UTankAttributeSnapshotComponent> AttributeSnapshotComponent{};
+
 private:
 	UPROPERTY(Category = "Tank Model", VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = "true"))
 	TObjectPtr<UStaticMeshComponent> TankBody{};
@@ -234,4 +240,9 @@ inline UItemInventory* ABaseTankPawn::GetItemInventory() const
 	return ItemInventoryComponent;
 }
 
+inline UTankAttributeSnapshotComponent* ABaseTankPawn::GetAttributeSnapshotComponent() const
+{
+	return AttributeSnapshotComponent;
+}
+
 #pragma endregion Inline Definitions
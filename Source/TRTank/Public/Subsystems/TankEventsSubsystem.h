@@ -25,4 +25,15 @@ public:
 
 	UPROPERTY(Category = "Notification", Transient, BlueprintAssignable)
 	FOnEnemySpawned OnEnemySpawned;
+
+protected:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+private:
+	/* Keeps the pawn spatial hash in TRCore in sync as TRCore cannot depend on the tank events. */
+	UFUNCTION()
+	void RegisterSpawnedEnemy(APawn* Enemy);
+
+	UFUNCTION()
+	void UnregisterDestroyedTank(ABaseTankPawn* DestroyedTank, AController* DestroyedBy, AActor* DestroyedWith);
 };
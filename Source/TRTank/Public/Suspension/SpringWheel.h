@@ -10,23 +10,33 @@
 
 class USphereComponent;
 class UPhysicsConstraintComponent;
+class USpringWheelSubsystem;
 
 UCLASS()
 class TRTANK_API ASpringWheel : public AActor, public IVisualLoggerDebugSnapshotInterface
 {
 	GENERATED_BODY()
+
+	friend class USpringWheelSubsystem;
 	
 public:	
 	ASpringWheel();
 
 	void AddDrivingForce(float ForceMagnitude);
 
+	/*
+	* Hands the ground probes and driving force of this wheel over to <c>USpringWheelSubsystem</c> and stops ticking it (true) or takes them back (false).
+	*/
+	void SetManaged(bool bManaged);
+	bool IsManaged() const;
+
 #if ENABLE_VISUAL_LOG
 	virtual void GrabDebugSnapshot(FVisualLogEntry* Snapshot) const override;
 #endif
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	virtual void Tick(float DeltaTime) override;
 private:
@@ -34,6 +44,8 @@ private:
 	const UObject* GetLogContext() const;
 
 	bool IsGrounded() const;
+	bool UpdateGrounded();
+	void OnGroundProbesCompleted(TConstArrayView<bool> Grounded);
 
 	void ApplyDrivingForce();
 
@@ -60,4 +72,24 @@ private:
 	float GroundTraceExtent{ 20 };
 
 	float CurrentForce{};
+
+	/* Result of the last batched ground probe. */
+	bool bGrounded{};
+	bool bGroundProbePending{};
+
+	/* Subsystem that owns the wheel state while managed. */
+	UPROPERTY(Transient)
+	TObjectPtr<USpringWheelSubsystem> ManagingSubsystem{};
+
+	/* Index of the wheel in the arrays of <c>ManagingSubsystem</c>. */
+	int32 ManagedIndex{ INDEX_NONE };
 };
+
+#pragma region Inline Definitions
+
+inline bool ASpringWheel::IsManaged() const
+{
+	return ManagingSubsystem != nullptr;
+}
+
+#pragma endregion Inline Definitions
@@ -0,0 +1,62 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace TR::BallisticUtils
+{
+	enum class EBallisticArc : uint8
+	{
+		Low,
+		High
+	};
+
+	struct FBallisticSolution
+	{
+		/* Normalized launch direction. */
+		FVector Direction;
+		/* Seconds until the projectile reaches the target. */
+		float TimeOfFlight;
+	};
+
+	/*
+	* Closed-form launch direction to hit <c>Target</c> from <c>Start</c> at <c>LaunchSpeed</c> under <c>GravityZ</c>, e.g. <c>UWorld::GetGravityZ</c>.
+	* Matches <c>UGameplayStatics::SuggestProjectileVelocity</c> without tracing. Returns no solution if the target is out of range.
+	*/
+	TRTANK_API TOptional<FBallisticSolution> SolveLaunch(const FVector& Start, const FVector& Target, float LaunchSpeed, float GravityZ, EBallisticArc Arc = EBallisticArc::Low);
+
+	/*
+	* Launch direction to hit a target moving at constant <c>TargetVelocity</c> where <c>Target</c> is its current location.
+	* Refines the intercept point from the time of flight of the previous solution which converges quickly while the target is slower than the projectile.
+	* Returns no solution if the intercept point goes out of range.
+	*/
+	TRTANK_API TOptional<FBallisticSolution> SolveIntercept(const FVector& Start, const FVector& Target, const FVector& TargetVelocity, float LaunchSpeed, float GravityZ,
+		EBallisticArc Arc = EBallisticArc::Low);
+
+	/*
+	* Structure of arrays input for solving many low arc launches at once. All arrays must have the same number of elements.
+	*/
+	struct FBallisticBatchInput
+	{
+		TConstArrayView<float> StartX, StartY, StartZ;
+		TConstArrayView<float> TargetX, TargetY, TargetZ;
+		TConstArrayView<float> LaunchSpeed;
+	};
+
+	/*
+	* Structure of arrays output of <c>SolveLaunchBatch</c>. <c>TimeOfFlight</c> is negative for targets out of range and the direction is then zero.
+	*/
+	struct FBallisticBatchOutput
+	{
+		TArray<float> DirectionX, DirectionY, DirectionZ;
+		TArray<float> TimeOfFlight;
+
+		void Reset(int32 Num);
+	};
+
+	/*
+	* Low arc solutions of <c>SolveLaunch</c> for every element of <c>Input</c>. The loop is branch free over contiguous floats so the compiler can vectorize it.
+	*/
+	TRTANK_API void SolveLaunchBatch(const FBallisticBatchInput& Input, float GravityZ, FBallisticBatchOutput& Output);
+}
@@ -41,6 +41,7 @@ public class TRTank : ModuleRules
 		var enginePrivateDependencyModuleNames = new string[] 
 		{
 			"Niagara",
+			"NavigationSystem",
         };
 
 		PrivateDependencyModuleNames.AddRange(enginePrivateDependencyModuleNames);
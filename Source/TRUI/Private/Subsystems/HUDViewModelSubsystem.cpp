@@ -0,0 +1,132 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/HUDViewModelSubsystem.h"
+
+#include "Pawn/BaseTankPawn.h"
+#include "Components/HealthComponent.h"
+
+#include "Item/ItemInventory.h"
+#include "Item/ItemNames.h"
+#include "Item/PassiveEffect.h"
+#include "XPSubsystem.h"
+
+#include "Kismet/GameplayStatics.h"
+
+#include "Debug/TRConsoleVars.h"
+
+#include "TRUILogging.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(HUDViewModelSubsystem)
+
+void UHUDViewModelSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const auto MaxUpdateRate = TR::CVarHUDMaxUpdateRate.GetValueOnGameThread();
+	ViewModel.SetMinUpdateInterval(MaxUpdateRate > 0 ? 1 / MaxUpdateRate : 0.0f);
+
+	ViewModel.Update(DeltaTime);
+}
+
+TStatId UHUDViewModelSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UHUDViewModelSubsystem, STATGROUP_Tickables);
+}
+
+void UHUDViewModelSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	ViewModel.OnUpdated.AddUObject(this, &ThisClass::OnViewModelUpdated);
+
+	if (auto XPSubsystem = InWorld.GetSubsystem<UXPSubsystem>(); ensure(XPSubsystem))
+	{
+		XPSubsystem->OnXPChanged.AddDynamic(this, &ThisClass::OnXPChanged);
+	}
+
+	if (auto PlayerPawn = Cast<ABaseTankPawn>(UGameplayStatics::GetPlayerPawn(&InWorld, 0)); PlayerPawn)
+	{
+		BindPlayerPawn(*PlayerPawn);
+	}
+	else
+	{
+		UE_LOG(LogTRUI, Warning, TEXT("%s: PlayerPawn not available - HUD will not show health or shield"), *GetName());
+	}
+}
+
+void UHUDViewModelSubsystem::Deinitialize()
+{
+	ViewModel.OnUpdated.RemoveAll(this);
+
+	Super::Deinitialize();
+}
+
+void UHUDViewModelSubsystem::BindPlayerPawn(ABaseTankPawn& PlayerPawn)
+{
+	UE_LOG(LogTRUI, Log, TEXT("%s: BindPlayerPawn: %s"), *GetName(), *PlayerPawn.GetName());
+
+	if (auto HealthComponent = PlayerPawn.GetHealthComponent(); ensure(HealthComponent))
+	{
+		HealthComponent->OnHealthChanged.AddUniqueDynamic(this, &ThisClass::OnHealthChanged);
+		ViewModel.SetHealth(HealthComponent->GetHealth(), HealthComponent->GetMaxHealth());
+	}
+
+	if (auto Inventory = PlayerPawn.GetItemInventory(); ensure(Inventory))
+	{
+		Inventory->OnInventoryItemAdded.AddUniqueDynamic(this, &ThisClass::OnInventoryItemAdded);
+
+		// Shield may have been granted before begin play
+		if (auto Shield = Cast<UPassiveEffect>(Inventory->GetItemByName(TR::ItemNames::Shield)); Shield)
+		{
+			BindShield(*Shield);
+		}
+	}
+}
+
+void UHUDViewModelSubsystem::BindShield(UPassiveEffect& Shield)
+{
+	UE_LOG(LogTRUI, Log, TEXT("%s: BindShield: %s"), *GetName(), *Shield.GetName());
+
+	Shield.OnItemValueChanged.AddUniqueDynamic(this, &ThisClass::OnShieldValueChanged);
+	ViewModel.SetShield(Shield.GetCurrentValue(), Shield.GetMaxValue());
+}
+
+void UHUDViewModelSubsystem::OnViewModelUpdated(const FHUDViewState& State, EHUDViewField ChangedFields)
+{
+	UE_LOG(LogTRUI, VeryVerbose, TEXT("%s: OnViewModelUpdated: ChangedFields=%d"), *GetName(), static_cast<int32>(ChangedFields));
+
+	OnHUDViewStateChanged.Broadcast(State, static_cast<int32>(ChangedFields));
+}
+
+void UHUDViewModelSubsystem::OnXPChanged(int32 TotalXP, int32 Level, float LevelPercent)
+{
+	ViewModel.SetXP(TotalXP, Level, LevelPercent);
+}
+
+void UHUDViewModelSubsystem::OnHealthChanged(UHealthComponent* HealthComponent, float PreviousHealthValue, float PreviousMaxHealthValue, AController* EventInstigator, AActor* ChangeCauser)
+{
+	check(HealthComponent);
+
+	ViewModel.SetHealth(HealthComponent->GetHealth(), HealthComponent->GetMaxHealth());
+}
+
+void UHUDViewModelSubsystem::OnInventoryItemAdded(const UItemInventory* Inventory, const FName& Name, int32 Index, const FItemConfigData& ItemConfigData)
+{
+	if (Name != TR::ItemNames::Shield)
+	{
+		return;
+	}
+
+	check(Inventory);
+
+	if (auto Shield = Cast<UPassiveEffect>(Inventory->GetItemByName(Name)); ensureMsgf(Shield, TEXT("%s: %s is not a passive effect"), *GetName(), *Name.ToString()))
+	{
+		BindShield(*Shield);
+	}
+}
+
+void UHUDViewModelSubsystem::OnShieldValueChanged(const UPassiveEffect* Item, float CurrentValue, float PreviousValue, float MaxValue, float PreviousMaxValue)
+{
+	ViewModel.SetShield(CurrentValue, MaxValue);
+}
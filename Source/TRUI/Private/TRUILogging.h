@@ -11,3 +11,6 @@
 #else
 	DECLARE_LOG_CATEGORY_EXTERN(LogTRUI, Display, All);
 #endif
+
+// Stat groups
+DECLARE_STATS_GROUP(TEXT("TRUI"), STATGROUP_TRUI, STATCAT_Advanced);
@@ -0,0 +1,130 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "UI/HUDViewModel.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace HUDViewModelTests
+{
+	constexpr auto TestFlags = EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHUDViewModelChangedFieldsTest, "TankRampage.TRUI.HUDViewModel.ChangedFields", HUDViewModelTests::TestFlags)
+
+bool FHUDViewModelChangedFieldsTest::RunTest(const FString& Parameters)
+{
+	FHUDViewModel ViewModel;
+
+	int32 Updates{};
+	auto LastChangedFields = EHUDViewField::None;
+
+	ViewModel.OnUpdated.AddLambda([&](const FHUDViewState& State, EHUDViewField ChangedFields)
+	{
+		++Updates;
+		LastChangedFields = ChangedFields;
+	});
+
+	// Setting unchanged values is not a change
+	ViewModel.SetHealth(0, 0);
+	ViewModel.SetShield(0, 0);
+	ViewModel.SetXP(0, 0, 0);
+
+	TestEqual(TEXT("Field changes for unchanged values"), ViewModel.NumFieldChanges(), 0);
+	TestEqual(TEXT("Pushed for unchanged values"), ViewModel.Update(1.0f / 60), EHUDViewField::None);
+	TestEqual(TEXT("Updates for unchanged values"), Updates, 0);
+
+	ViewModel.SetHealth(100, 100);
+	TestEqual(TEXT("Dirty after health change"), ViewModel.GetDirtyFields(), EHUDViewField::Health);
+	TestEqual(TEXT("Pushed after health change"), ViewModel.Update(1.0f / 60), EHUDViewField::Health);
+	TestEqual(TEXT("Listener fields after health change"), LastChangedFields, EHUDViewField::Health);
+
+	// A level up changes both the xp bar and the level
+	ViewModel.SetXP(120, 2, 0.2f);
+	TestEqual(TEXT("Pushed after level up"), ViewModel.Flush(), EHUDViewField::XP | EHUDViewField::Level);
+
+	ViewModel.SetXP(130, 2, 0.3f);
+	TestEqual(TEXT("Pushed after xp change"), ViewModel.Flush(), EHUDViewField::XP);
+
+	TestEqual(TEXT("Flush with nothing dirty"), ViewModel.Flush(), EHUDViewField::None);
+	TestEqual(TEXT("Updates"), Updates, 3);
+	TestEqual(TEXT("NumUpdates"), ViewModel.NumUpdates(), 3);
+	TestEqual(TEXT("NumFieldChanges"), ViewModel.NumFieldChanges(), 4);
+
+	const auto& State = ViewModel.GetState();
+	TestEqual(TEXT("Health"), State.Health, 100.0f);
+	TestEqual(TEXT("TotalXP"), State.TotalXP, 130);
+	TestEqual(TEXT("Level"), State.Level, 2);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FHUDViewModelUpdateCountsTest, "TankRampage.TRUI.HUDViewModel.UpdateCounts", HUDViewModelTests::TestFlags)
+
+bool FHUDViewModelUpdateCountsTest::RunTest(const FString& Parameters)
+{
+	constexpr float DeltaTime = 1.0f / 60;
+	constexpr int32 Frames = 60;
+
+	FHUDViewModel ViewModel;
+	ViewModel.SetMinUpdateInterval(0.1f);
+
+	int32 Updates{};
+	FHUDViewState LastState{};
+
+	ViewModel.OnUpdated.AddLambda([&](const FHUDViewState& State, EHUDViewField ChangedFields)
+	{
+		++Updates;
+		LastState = State;
+	});
+
+	// First change after being idle is pushed on the same frame
+	ViewModel.SetHealth(100, 100);
+	TestEqual(TEXT("First change pushed right away"), ViewModel.Update(DeltaTime), EHUDViewField::Health);
+
+	// Health changes every frame and is pushed every 6 frames at 60 fps
+	for (int32 Frame = 1; Frame <= Frames; ++Frame)
+	{
+		ViewModel.SetHealth(100.0f - Frame, 100);
+
+		if (Frame % 3 == 0)
+		{
+			ViewModel.SetShield(static_cast<float>(Frame), 100);
+		}
+
+		const auto Pushed = ViewModel.Update(DeltaTime);
+		if (!TestEqual(*FString::Printf(TEXT("Pushed on frame %d"), Frame), Pushed != EHUDViewField::None, Frame % 6 == 0))
+		{
+			break;
+		}
+	}
+
+	TestEqual(TEXT("Updates"), Updates, 1 + Frames / 6);
+	TestEqual(TEXT("NumUpdates"), ViewModel.NumUpdates(), Updates);
+	TestEqual(TEXT("NumFieldChanges"), ViewModel.NumFieldChanges(), 1 + Frames + Frames / 3);
+	TestEqual(TEXT("Listener has the latest health"), LastState.Health, 100.0f - Frames);
+
+	// Coalesced changes go out on flush
+	ViewModel.SetHealth(1, 100);
+	TestEqual(TEXT("Change within the interval is held"), ViewModel.Update(DeltaTime), EHUDViewField::None);
+	TestEqual(TEXT("Flush pushes the held change"), ViewModel.Flush(), EHUDViewField::Health);
+	TestEqual(TEXT("Listener health after flush"), LastState.Health, 1.0f);
+
+	// Unthrottled pushes every frame with a change
+	ViewModel.SetMinUpdateInterval(0);
+	const auto UnthrottledStart = Updates;
+
+	for (int32 Frame = 0; Frame < 10; ++Frame)
+	{
+		ViewModel.SetHealth(Frame + 2.0f, 100);
+		ViewModel.Update(DeltaTime);
+	}
+
+	TestEqual(TEXT("Unthrottled updates"), Updates - UnthrottledStart, 10);
+
+	return true;
+}
+
+#endif
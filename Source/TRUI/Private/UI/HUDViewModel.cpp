@@ -0,0 +1,235 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "UI/HUDViewModel.h"
+
+#include "TRConstants.h"
+#include "TRUILogging.h"
+
+#if TR_DEBUG_ENABLED
+	#include "HAL/IConsoleManager.h"
+	#include "Utils/RandUtils.h"
+#endif
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(HUDViewModel)
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("HUD Field Changes"), STAT_HUDViewModel_FieldChanges, STATGROUP_TRUI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("HUD Field Changes Coalesced"), STAT_HUDViewModel_FieldChangesCoalesced, STATGROUP_TRUI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("HUD Dirty Fields Pushed"), STAT_HUDViewModel_FieldsPushed, STATGROUP_TRUI);
+DECLARE_DWORD_COUNTER_STAT(TEXT("HUD View Pushes"), STAT_HUDViewModel_Updates, STATGROUP_TRUI);
+
+void FHUDViewModel::SetHealth(float Health, float MaxHealth)
+{
+	if (Health == State.Health && MaxHealth == State.MaxHealth)
+	{
+		return;
+	}
+
+	State.Health = Health;
+	State.MaxHealth = MaxHealth;
+
+	MarkDirty(EHUDViewField::Health);
+}
+
+void FHUDViewModel::SetShield(float Shield, float MaxShield)
+{
+	if (Shield == State.Shield && MaxShield == State.MaxShield)
+	{
+		return;
+	}
+
+	State.Shield = Shield;
+	State.MaxShield = MaxShield;
+
+	MarkDirty(EHUDViewField::Shield);
+}
+
+void FHUDViewModel::SetXP(int32 TotalXP, int32 Level, float LevelPercent)
+{
+	if (TotalXP != State.TotalXP || LevelPercent != State.LevelPercent)
+	{
+		State.TotalXP = TotalXP;
+		State.LevelPercent = LevelPercent;
+
+		MarkDirty(EHUDViewField::XP);
+	}
+
+	if (Level != State.Level)
+	{
+		State.Level = Level;
+
+		MarkDirty(EHUDViewField::Level);
+	}
+}
+
+EHUDViewField FHUDViewModel::Update(float DeltaTime)
+{
+	if (TimeSinceUpdate < MinUpdateInterval)
+	{
+		TimeSinceUpdate += DeltaTime;
+	}
+
+	// Tolerance so that frame times that evenly divide the interval don't slip a frame from rounding
+	if (DirtyFields == EHUDViewField::None || TimeSinceUpdate + UE_KINDA_SMALL_NUMBER < MinUpdateInterval)
+	{
+		return EHUDViewField::None;
+	}
+
+	return Flush();
+}
+
+EHUDViewField FHUDViewModel::Flush()
+{
+	const auto PushedFields = DirtyFields;
+	if (PushedFields == EHUDViewField::None)
+	{
+		return PushedFields;
+	}
+
+	DirtyFields = EHUDViewField::None;
+	TimeSinceUpdate = 0;
+	++UpdateCount;
+
+	INC_DWORD_STAT(STAT_HUDViewModel_Updates);
+	INC_DWORD_STAT_BY(STAT_HUDViewModel_FieldsPushed, FMath::CountBits(static_cast<uint64>(PushedFields)));
+
+	OnUpdated.Broadcast(State, PushedFields);
+
+	return PushedFields;
+}
+
+void FHUDViewModel::MarkDirty(EHUDViewField Field)
+{
+	++FieldChangeCount;
+	INC_DWORD_STAT(STAT_HUDViewModel_FieldChanges);
+
+	if (EnumHasAnyFlags(DirtyFields, Field))
+	{
+		INC_DWORD_STAT(STAT_HUDViewModel_FieldChangesCoalesced);
+	}
+
+	DirtyFields |= Field;
+}
+
+#pragma region Verification
+
+#if TR_DEBUG_ENABLED
+
+namespace
+{
+	struct FHUDViewModelListener
+	{
+		int32 Updates{};
+		int32 FieldsPushed{};
+		FHUDViewState LastState{};
+	};
+
+	bool StatesEqual(const FHUDViewState& First, const FHUDViewState& Second)
+	{
+		return First.Health == Second.Health && First.MaxHealth == Second.MaxHealth && First.Shield == Second.Shield && First.MaxShield == Second.MaxShield &&
+			First.TotalXP == Second.TotalXP && First.Level == Second.Level && First.LevelPercent == Second.LevelPercent;
+	}
+
+	/*
+	* Drives xp, health and shield changes through a view model at a fixed frame rate without a world and checks
+	* how many pushes result and that listeners always end up with the latest values.
+	*/
+	void RunHUDViewModelVerification(const TArray<FString>& Args)
+	{
+		const int32 Frames = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 600;
+		const float UpdateRate = Args.Num() > 1 ? FMath::Max(1.0f, FCString::Atof(*Args[1])) : 15.0f;
+		const float DeltaTime = Args.Num() > 2 ? FMath::Max(0.001f, FCString::Atof(*Args[2])) : 1.0f / 60;
+
+		FRandomStream Rng(RandUtils::GenerateSeed());
+
+		int32 Failures{};
+
+		FHUDViewModel ViewModel;
+		ViewModel.SetMinUpdateInterval(1 / UpdateRate);
+
+		FHUDViewModelListener Listener;
+		ViewModel.OnUpdated.AddLambda([&](const FHUDViewState& State, EHUDViewField ChangedFields)
+		{
+			++Listener.Updates;
+			Listener.FieldsPushed += FMath::CountBits(static_cast<uint64>(ChangedFields));
+			Listener.LastState = State;
+		});
+
+		// Setting unchanged values is not an update
+		ViewModel.SetHealth(0, 0);
+		ViewModel.SetShield(0, 0);
+		ViewModel.SetXP(0, 0, 0);
+		Failures += ViewModel.Update(DeltaTime) != EHUDViewField::None || Listener.Updates != 0;
+
+		// First change after being idle is pushed on the same frame
+		ViewModel.SetHealth(100, 100);
+		ViewModel.SetShield(50, 50);
+		ViewModel.SetXP(0, 0, 0);
+		Failures += ViewModel.Update(DeltaTime) != (EHUDViewField::Health | EHUDViewField::Shield) || Listener.Updates != 1;
+
+		// Health changes every frame, shield every few frames and xp now and then so something is always dirty
+		float Health = 100, Shield = 50;
+		int32 TotalXP = 0, Level = 0;
+		int32 ExpectedUpdates = Listener.Updates;
+		int32 FramesSinceUpdate{};
+
+		const int32 FramesPerUpdate = FMath::Max(1, FMath::CeilToInt32(1 / (UpdateRate * DeltaTime) - UE_KINDA_SMALL_NUMBER));
+
+		for (int32 Frame = 0; Frame < Frames; ++Frame)
+		{
+			Health = Health > 1 ? Health - Rng.FRandRange(0.1f, 1.0f) : 100;
+			ViewModel.SetHealth(Health, 100);
+
+			if (Frame % 3 == 0)
+			{
+				Shield = FMath::Fmod(Shield + 1, 50.0f);
+				ViewModel.SetShield(Shield, 50);
+			}
+
+			if (Rng.RandHelper(10) == 0)
+			{
+				TotalXP += Rng.RandRange(1, 10);
+				Level = TotalXP / 100;
+				ViewModel.SetXP(TotalXP, Level, (TotalXP % 100) / 100.0f);
+			}
+
+			++FramesSinceUpdate;
+			if (FramesSinceUpdate >= FramesPerUpdate)
+			{
+				++ExpectedUpdates;
+				FramesSinceUpdate = 0;
+			}
+
+			ViewModel.Update(DeltaTime);
+		}
+
+		Failures += Listener.Updates != ExpectedUpdates;
+
+		// Whatever was coalesced since the last push goes out on flush and listeners end on the latest values
+		ViewModel.Flush();
+		Failures += !StatesEqual(Listener.LastState, ViewModel.GetState()) || ViewModel.GetDirtyFields() != EHUDViewField::None;
+
+		const int32 ThrottledUpdates = Listener.Updates;
+
+		// Unthrottled pushes every frame with a change
+		ViewModel.SetMinUpdateInterval(0);
+		for (int32 Frame = 0; Frame < 10; ++Frame)
+		{
+			ViewModel.SetHealth(Frame + 1.0f, 100);
+			ViewModel.Update(DeltaTime);
+		}
+		Failures += Listener.Updates != ThrottledUpdates + 10;
+
+		UE_LOG(LogTRUI, Display, TEXT("RunHUDViewModelVerification: %s - Frames=%d; Rate=%.1f; FieldChanges=%d; Updates=%d; ExpectedUpdates=%d; FieldsPushed=%d; Failures=%d"),
+			Failures == 0 ? TEXT("PASSED") : TEXT("FAILED"), Frames, UpdateRate, ViewModel.NumFieldChanges(), ThrottledUpdates, ExpectedUpdates, Listener.FieldsPushed, Failures);
+	}
+
+	FAutoConsoleCommandWithArgs HUDViewModelVerifyCommand(
+		TEXT("tr.ui.hud.verify"),
+		TEXT("Drives xp, health and shield changes through a HUD view model and checks the number of pushes: [Frames=600] [Rate=15] [DeltaTime=0.0167]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunHUDViewModelVerification));
+}
+
+#endif
+
+#pragma endregion Verification
@@ -3,11 +3,47 @@
 
 #include "UI/TRHUD.h"
 
+#include "Subsystems/HUDViewModelSubsystem.h"
+
 #include "Logging/LoggingUtils.h"
 #include "TRUILogging.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(TRHUD)
 
+void ATRHUD::BeginPlay()
+{
+	Super::BeginPlay();
+
+	auto World = GetWorld();
+	check(World);
+
+	if (auto HUDViewModelSubsystem = World->GetSubsystem<UHUDViewModelSubsystem>(); ensure(HUDViewModelSubsystem))
+	{
+		HUDViewModelSubsystem->OnHUDViewStateChanged.AddDynamic(this, &ThisClass::HandleHUDViewStateChanged);
+
+		// Everything bound so far is new to the Blueprint
+		OnHUDViewStateChanged(HUDViewModelSubsystem->GetViewState(), static_cast<int32>(EHUDViewField::Health | EHUDViewField::Shield | EHUDViewField::XP | EHUDViewField::Level));
+	}
+}
+
+void ATRHUD::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (auto World = GetWorld(); World)
+	{
+		if (auto HUDViewModelSubsystem = World->GetSubsystem<UHUDViewModelSubsystem>(); HUDViewModelSubsystem)
+		{
+			HUDViewModelSubsystem->OnHUDViewStateChanged.RemoveAll(this);
+		}
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ATRHUD::HandleHUDViewStateChanged(const FHUDViewState& State, int32 ChangedFields)
+{
+	OnHUDViewStateChanged(State, ChangedFields);
+}
+
 void ATRHUD::ShowHUD()
 {
 	Super::ShowHUD();
@@ -0,0 +1,91 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UI/HUDViewModel.h"
+#include "HUDViewModelSubsystem.generated.h"
+
+class UHealthComponent;
+class UItemInventory;
+class UPassiveEffect;
+class ABaseTankPawn;
+struct FItemConfigData;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnHUDViewStateChanged, const FHUDViewState&, State, int32, ChangedFields);
+
+/**
+ * HUD view model for the player. Subscribes once to the xp, health and shield notifications and broadcasts the changed fields
+ * at most <c>tr.ui.hud.maxUpdateRate</c> times a second. The HUD widgets still use their own property bindings; they only stop
+ * polling once they are moved over to <c>OnHUDViewStateChanged</c> on <c>ATRHUD</c>.
+ */
+UCLASS()
+class TRUI_API UHUDViewModelSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	UFUNCTION(Category = "HUD", BlueprintPure)
+	const FHUDViewState& GetViewState() const;
+
+	UFUNCTION(Category = "HUD", BlueprintPure)
+	static bool IsFieldChanged(int32 ChangedFields, EHUDViewField Field);
+
+	const FHUDViewModel& GetViewModel() const;
+
+	/* Widgets bind to this and refresh only the fields in <c>ChangedFields</c>. */
+	UPROPERTY(Category = "Notification", Transient, BlueprintAssignable)
+	FOnHUDViewStateChanged OnHUDViewStateChanged;
+
+protected:
+	virtual bool IsTickableWhenPaused() const override { return true; }
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+private:
+	void BindPlayerPawn(ABaseTankPawn& PlayerPawn);
+	void BindShield(UPassiveEffect& Shield);
+
+	void OnViewModelUpdated(const FHUDViewState& State, EHUDViewField ChangedFields);
+
+	UFUNCTION()
+	void OnXPChanged(int32 TotalXP, int32 Level, float LevelPercent);
+
+	UFUNCTION()
+	void OnHealthChanged(UHealthComponent* HealthComponent, float PreviousHealthValue, float PreviousMaxHealthValue, AController* EventInstigator, AActor* ChangeCauser);
+
+	UFUNCTION()
+	void OnInventoryItemAdded(const UItemInventory* Inventory, const FName& Name, int32 Index, const FItemConfigData& ItemConfigData);
+
+	UFUNCTION()
+	void OnShieldValueChanged(const UPassiveEffect* Item, float CurrentValue, float PreviousValue, float MaxValue, float PreviousMaxValue);
+
+private:
+	FHUDViewModel ViewModel{};
+};
+
+#pragma region Inline Definitions
+
+inline const FHUDViewState& UHUDViewModelSubsystem::GetViewState() const
+{
+	return ViewModel.GetState();
+}
+
+inline bool UHUDViewModelSubsystem::IsFieldChanged(int32 ChangedFields, EHUDViewField Field)
+{
+	return (ChangedFields & static_cast<int32>(Field)) != 0;
+}
+
+inline const FHUDViewModel& UHUDViewModelSubsystem::GetViewModel() const
+{
+	return ViewModel;
+}
+
+#pragma endregion Inline Definitions
@@ -0,0 +1,129 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HUDViewModel.generated.h"
+
+UENUM(BlueprintType, meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class EHUDViewField : uint8
+{
+	None = 0 UMETA(Hidden),
+	Health = 1 << 0,
+	Shield = 1 << 1,
+	XP = 1 << 2,
+	Level = 1 << 3,
+};
+
+ENUM_CLASS_FLAGS(EHUDViewField);
+
+USTRUCT(BlueprintType)
+struct TRUI_API FHUDViewState
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Category = "HUD", BlueprintReadOnly)
+	float Health{};
+
+	UPROPERTY(Category = "HUD", BlueprintReadOnly)
+	float MaxHealth{};
+
+	UPROPERTY(Category = "HUD", BlueprintReadOnly)
+	float Shield{};
+
+	UPROPERTY(Category = "HUD", BlueprintReadOnly)
+	float MaxShield{};
+
+	UPROPERTY(Category = "HUD", BlueprintReadOnly)
+	int32 TotalXP{};
+
+	UPROPERTY(Category = "HUD", BlueprintReadOnly)
+	int32 Level{};
+
+	UPROPERTY(Category = "HUD", BlueprintReadOnly)
+	float LevelPercent{};
+};
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnHUDViewModelUpdated, const FHUDViewState& /* State */, EHUDViewField /* ChangedFields */);
+
+/**
+ * Cached values shown on the HUD. Changes are coalesced and pushed to listeners at most once per update interval
+ * so that a listener is only refreshed when something it shows changed.
+ */
+class TRUI_API FHUDViewModel
+{
+public:
+	void SetHealth(float Health, float MaxHealth);
+	void SetShield(float Shield, float MaxShield);
+	void SetXP(int32 TotalXP, int32 Level, float LevelPercent);
+
+	/*
+	* Minimum time between pushes. 0 pushes on every update that has changes.
+	*/
+	void SetMinUpdateInterval(float Seconds);
+
+	/*
+	* Advances time and pushes the changed fields if the update interval has elapsed. Returns the fields that were pushed.
+	*/
+	EHUDViewField Update(float DeltaTime);
+
+	/*
+	* Pushes the changed fields now regardless of the update interval.
+	*/
+	EHUDViewField Flush();
+
+	const FHUDViewState& GetState() const;
+	EHUDViewField GetDirtyFields() const;
+
+	/* Number of times listeners were notified. */
+	int32 NumUpdates() const;
+
+	/* Number of field changes including ones coalesced into a pending update. */
+	int32 NumFieldChanges() const;
+
+	FOnHUDViewModelUpdated OnUpdated{};
+
+private:
+	void MarkDirty(EHUDViewField Field);
+
+private:
+	FHUDViewState State{};
+	EHUDViewField DirtyFields{ EHUDViewField::None };
+
+	float MinUpdateInterval{};
+
+	/* Starts elapsed so that the first change is pushed right away. */
+	float TimeSinceUpdate{ TNumericLimits<float>::Max() };
+
+	int32 UpdateCount{};
+	int32 FieldChangeCount{};
+};
+
+#pragma region Inline Definitions
+
+inline void FHUDViewModel::SetMinUpdateInterval(float Seconds)
+{
+	MinUpdateInterval = FMath::Max(0.0f, Seconds);
+}
+
+inline const FHUDViewState& FHUDViewModel::GetState() const
+{
+	return State;
+}
+
+inline EHUDViewField FHUDViewModel::GetDirtyFields() const
+{
+	return DirtyFields;
+}
+
+inline int32 FHUDViewModel::NumUpdates() const
+{
+	return UpdateCount;
+}
+
+inline int32 FHUDViewModel::NumFieldChanges() const
+{
+	return FieldChangeCount;
+}
+
+#pragma endregion Inline Definitions
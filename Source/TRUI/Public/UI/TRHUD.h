@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/HUD.h"
+#include "UI/HUDViewModel.h"
 #include "TRHUD.generated.h"
 
 /**
@@ -28,6 +29,21 @@ public:
 	void OnGameOver();
 
 protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	UFUNCTION(BlueprintImplementableEvent, Category = "UI")
 	void OnToggleHUDVisibility(bool bVisible);
+
+	/*
+	* Called with the HUD values that changed since the last call at most <c>tr.ui.hud.maxUpdateRate</c> times a second.
+	* Use <c>IsFieldChanged</c> on the view model subsystem to refresh only the affected widgets. Not implemented by the HUD
+	* Blueprint yet, so its widgets still poll their bindings until they are moved over to this.
+	*/
+	UFUNCTION(BlueprintImplementableEvent, Category = "UI")
+	void OnHUDViewStateChanged(const FHUDViewState& State, int32 ChangedFields);
+
+private:
+	UFUNCTION()
+	void HandleHUDViewStateChanged(const FHUDViewState& State, int32 ChangedFields);
 };
@@ -0,0 +1,86 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Commandlets/GameEventJournalCommandlet.h"
+
+#include "Subsystems/GameEventJournal.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+#include "TankRampageLogging.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(GameEventJournalCommandlet)
+
+UGameEventJournalCommandlet::UGameEventJournalCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UGameEventJournalCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Paths;
+
+	if (FString Path; FParse::Value(*Params, TEXT("Journal="), Path))
+	{
+		Paths.Add(Path);
+	}
+	else
+	{
+		const auto Directory = FPaths::ProjectSavedDir() / TEXT("Journals");
+
+		TArray<FString> FileNames;
+		IFileManager::Get().FindFiles(FileNames, *(Directory / TEXT("*.trjournal")), true, false);
+
+		for (const auto& FileName : FileNames)
+		{
+			Paths.Add(Directory / FileName);
+		}
+
+		// Newest first
+		Paths.Sort([](const FString& First, const FString& Second)
+		{
+			return IFileManager::Get().GetTimeStamp(*First) > IFileManager::Get().GetTimeStamp(*Second);
+		});
+
+		if (!FParse::Param(*Params, TEXT("All")) && Paths.Num() > 1)
+		{
+			Paths.SetNum(1);
+		}
+	}
+
+	if (Paths.IsEmpty())
+	{
+		UE_LOG(LogTankRampage, Error, TEXT("GameEventJournal: No journals found - record one with tr.stats.journal.enabled or pass -Journal=Path"));
+		return 1;
+	}
+
+	int32 FailedCount{};
+	for (const auto& Path : Paths)
+	{
+		FailedCount += !AnalyzeJournal(Path);
+	}
+
+	return FailedCount > 0 ? 1 : 0;
+}
+
+bool UGameEventJournalCommandlet::AnalyzeJournal(const FString& Path) const
+{
+	FGameJournal Journal;
+	FString Error;
+
+	if (!FGameJournal::LoadFromFile(Path, Journal, &Error))
+	{
+		UE_LOG(LogTankRampage, Error, TEXT("GameEventJournal: %s - %s"), *Path, *Error);
+		return false;
+	}
+
+	UE_LOG(LogTankRampage, Display, TEXT("GameEventJournal: %s"), *Path);
+
+	FGameJournalSummary::Analyze(Journal).Log(Journal);
+
+	return true;
+}
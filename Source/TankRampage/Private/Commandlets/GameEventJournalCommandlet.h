@@ -0,0 +1,29 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+
+#include "GameEventJournalCommandlet.generated.h"
+
+/**
+ * Prints the per-minute kill rate, spawn pressure and item attribution of journals recorded with <c>tr.stats.journal.enabled</c>, e.g.
+ *
+ *   UnrealEditor-Cmd TankRampage.uproject -run=GameEventJournal [-Journal=Path] [-All]
+ *
+ * Without <c>-Journal</c> the most recent journal in Saved/Journals is analyzed or every journal there with <c>-All</c>.
+ */
+UCLASS()
+class UGameEventJournalCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UGameEventJournalCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	bool AnalyzeJournal(const FString& Path) const;
+};
@@ -4,6 +4,7 @@
 #include "GameMode/Rampage/EnemySpawnerComponent.h"
 
 #include "Spawner/EnemySpawner.h"
+#include "RampageBakedData.h"
 #include "Kismet/GameplayStatics.h"
 #include "TankRampageLogging.h"
 #include "Logging/LoggingUtils.h"
@@ -24,7 +25,7 @@ void UEnemySpawnerComponent::BeginPlay()
 	InitSpawners();
 
 	UE_VLOG_UELOG(GetOwner(), LogTankRampage, Log, TEXT("%s-%s: BeginPlay - Found %d enemy spawners and %d enemy spawn minute configs"),
-		*LoggingUtils::GetName(GetOwner()), *GetName(), Spawners.Num(), SpawnerDataByMinute.Num());
+		*LoggingUtils::GetName(GetOwner()), *GetName(), Spawners.Num(), GetSpawnerMinuteCount());
 
 	InitSpawningSchedule();
 }
@@ -55,13 +56,40 @@ void UEnemySpawnerComponent::InitSpawners()
 
 	CurrentSpawnerState.Reset();
 	EligibleSpawners.Reset(Spawners.Num());
+	SpawnerCandidates.Reset(Spawners.Num());
 
 	AvailableSpawnerIndices.Reset(Spawners.Num());
+
+	InitSpawnerGrid();
+}
+
+void UEnemySpawnerComponent::InitSpawnerGrid()
+{
+	SpawnerGrid.Reset(SpawnerGridCellSize);
+	SpawnerGridMaxDistance = 0.0f;
+
+	// Spawners are static so only need to be indexed when the spawners change
+	for (int32 i = 0; i < Spawners.Num(); ++i)
+	{
+		auto Spawner = Spawners[i];
+		check(Spawner);
+
+		SpawnerGrid.Add(i, Spawner->GetActorLocation());
+		SpawnerGridMaxDistance = FMath::Max(SpawnerGridMaxDistance, Spawner->GetMaxDistance());
+	}
 }
 
 void UEnemySpawnerComponent::InitData()
 {
-	SpawnerDataByMinute = EnemySpawnerDataParser::ReadAll(EnemySpawnerDataTable);
+	// Baked records are read in place so the table is only loaded without them
+	if (BakedData)
+	{
+		SpawnerDataByMinute.Reset();
+	}
+	else
+	{
+		SpawnerDataByMinute = EnemySpawnerDataParser::ReadAll(EnemySpawnerDataTable.LoadSynchronous());
+	}
 }
 
 void UEnemySpawnerComponent::InitSpawningSchedule()
@@ -137,6 +165,7 @@ void UEnemySpawnerComponent::ScheduleSpawning()
 float UEnemySpawnerComponent::CalculateSpawningLoop()
 {
 	EligibleSpawners.Reset();
+	SpawnerCandidates.Reset();
 	CurrentSpawnerState.Reset();
 	AvailableSpawnerIndices.Reset();
 
@@ -242,7 +271,7 @@ void UEnemySpawnerComponent::DoSpawnTimeSlice()
 		++IterationCount;
 		++SpawnerIndex;
 
-		if (SpawnerIndex >= EligibleSpawners.Num() && (IterationCount < EligibleSpawners.Num() || SpawnCountCurrentLoop > 0))
+		if (SpawnerIndex >= EligibleSpawners.Num() && SpawnerCandidates.IsEmpty() && (IterationCount < EligibleSpawners.Num() || SpawnCountCurrentLoop > 0))
 		{
 			// Refresh the eligible spawners
 			CalculateEligibleSpawners(*PlayerPawn);
@@ -250,7 +279,7 @@ void UEnemySpawnerComponent::DoSpawnTimeSlice()
 		}
 	};
 
-	while (SpawnerIndex < EligibleSpawners.Num())
+	while (SpawnerIndex < EligibleSpawners.Num() || AddNextEligibleSpawner(*PlayerPawn))
 	{
 		auto& SpawnerState = EligibleSpawners[SpawnerIndex];
 		auto EnemySpawner = Spawners[SpawnerState.Index];
@@ -264,7 +293,7 @@ void UEnemySpawnerComponent::DoSpawnTimeSlice()
 
 		// Recheck spawn eligibility since player has been moving since this was calculated at the start of the minute
 		check(PlayerPawn);
-		if (!EnemySpawner->CanSpawnAnyFor(*PlayerPawn))
+		if (SpawnerState.CheckTime < GetWorld()->GetTimeSeconds() && !EnemySpawner->CanSpawnAnyFor(*PlayerPawn))
 		{
 			UE_VLOG_UELOG(GetOwner(), LogTankRampage, Log, TEXT("%s-%s: DoSpawnTimeSlice - Skipped spawner %s that is no longer relevant for player"),
 				*LoggingUtils::GetName(GetOwner()), *GetName(), *EnemySpawner->GetName());
@@ -306,7 +335,7 @@ void UEnemySpawnerComponent::DoSpawnTimeSlice()
 
 bool UEnemySpawnerComponent::IsSpawnerStateValid() const
 {
-	return !Spawners.IsEmpty() && !SpawnerDataByMinute.IsEmpty();
+	return !Spawners.IsEmpty() && GetSpawnerMinuteCount() > 0;
 }
 
 bool UEnemySpawnerComponent::TryRefreshSpawnersAndRescheduleIfInvalid()
@@ -339,6 +368,8 @@ void UEnemySpawnerComponent::CalculateEligibleSpawners(const APawn& PlayerPawn)
 	UE_VLOG_UELOG(GetOwner(), LogTankRampage, Log, TEXT("%s-%s: CalculateEligibleSpawners - AvailableSpawnerIndices = %d / %d; DesiredClusterSize=%d"),
 		*LoggingUtils::GetName(GetOwner()), *GetName(), AvailableSpawnerIndices.Num(), Spawners.Num(), DesiredClusterSize);
 
+	SpawnerCandidates.Reset(AvailableSpawnerIndices.Num());
+
 	for (auto SpawnerIndexIt = AvailableSpawnerIndices.CreateIterator(); SpawnerIndexIt; ++SpawnerIndexIt)
 	{
 		const int32 SpawnerIndex = *SpawnerIndexIt;
@@ -353,8 +384,10 @@ void UEnemySpawnerComponent::CalculateEligibleSpawners(const APawn& PlayerPawn)
 			continue;
 		}
 
+		// The field of view trace is deferred until the spawner is the best candidate
 		float SpawnerScore;
-		if (!Spawner->CanSpawnAnyFor(PlayerPawn, &SpawnerScore))
+		bool bRequiresFOVTrace;
+		if (!Spawner->CanSpawnAnyFor(PlayerPawn, &SpawnerScore, &bRequiresFOVTrace))
 		{
 			UE_VLOG_UELOG(GetOwner(), LogTankRampage, Verbose, TEXT("%s-%s: CalculateSpawningLoop - Spawner %s cannot spawn any"),
 				*LoggingUtils::GetName(GetOwner()), *GetName(), *Spawner->GetName());
@@ -362,29 +395,20 @@ void UEnemySpawnerComponent::CalculateEligibleSpawners(const APawn& PlayerPawn)
 			continue;
 		}
 
-		// Lower score is better
-		if (Spawner->GetMaxSpawnCount() >= DesiredClusterSize)
-		{
-			SpawnerScore /= ClusterMatchScoreMultiplier;
-		}
-
-		EligibleSpawners.Add(FSpawnerMetadata
+		SpawnerCandidates.Add(FSpawnerCandidate
 		{
 			.Index = SpawnerIndex,
-			.SpawnCount = 0,
-			.VisitCount = 0,
-			.Score = SpawnerScore
+			.Score = AdjustSpawnerScore(*Spawner, SpawnerScore),
+			.bRequiresFOVTrace = bRequiresFOVTrace,
+			.CheckTime = World->GetTimeSeconds()
 		});
 	}
 
-	// Find best spawners
-	EligibleSpawners.Sort([](const auto& First, const auto& Second)
-	{
-		return First.Score < Second.Score;
-	});
+	// Candidates are popped as DoSpawnTimeSlice visits them so only those that are needed are ordered
+	SpawnerCandidates.Heapify();
 
 	CurrentSpawnerState.EligibleSpawnersIndex = 0;
-	CurrentSpawnerState.NumEligibleSpawners = EligibleSpawners.Num();
+	CurrentSpawnerState.NumEligibleSpawners = SpawnerCandidates.Num();
 
 	UE_VLOG_UELOG(GetOwner(), LogTankRampage, Log, TEXT("%s-%s: CalculateEligibleSpawners - NumEligibleSpawners=%d"),
 		*LoggingUtils::GetName(GetOwner()), *GetName(), CurrentSpawnerState.NumEligibleSpawners);
@@ -392,6 +416,56 @@ void UEnemySpawnerComponent::CalculateEligibleSpawners(const APawn& PlayerPawn)
 	LastEligibleSpawnersSortTime = World->GetTimeSeconds();
 }
 
+bool UEnemySpawnerComponent::AddNextEligibleSpawner(const APawn& PlayerPawn)
+{
+	auto World = GetWorld();
+	check(World);
+
+	// A candidate's exact score is never better than its best case so it is pushed back until it is on top with its exact score
+	while (!SpawnerCandidates.IsEmpty())
+	{
+		FSpawnerCandidate Candidate;
+		SpawnerCandidates.HeapPop(Candidate, false);
+
+		if (!Candidate.bRequiresFOVTrace)
+		{
+			EligibleSpawners.Add(FSpawnerMetadata
+			{
+				.Index = Candidate.Index,
+				.SpawnCount = 0,
+				.VisitCount = 0,
+				.Score = Candidate.Score,
+				.CheckTime = Candidate.CheckTime
+			});
+
+			return true;
+		}
+
+		auto Spawner = Spawners[Candidate.Index];
+
+		float SpawnerScore;
+		if (!IsValid(Spawner) || !Spawner->CanSpawnAnyFor(PlayerPawn, &SpawnerScore))
+		{
+			--CurrentSpawnerState.NumEligibleSpawners;
+			continue;
+		}
+
+		Candidate.Score = AdjustSpawnerScore(*Spawner, SpawnerScore);
+		Candidate.bRequiresFOVTrace = false;
+		Candidate.CheckTime = World->GetTimeSeconds();
+
+		SpawnerCandidates.HeapPush(Candidate);
+	}
+
+	return false;
+}
+
+float UEnemySpawnerComponent::AdjustSpawnerScore(const AEnemySpawner& Spawner, float Score) const
+{
+	// Lower score is better
+	return Spawner.GetMaxSpawnCount() >= CurrentSpawnerState.SpawnerData.SpawnClusterSize ? Score / ClusterMatchScoreMultiplier : Score;
+}
+
 void UEnemySpawnerComponent::CalculatePossibleSpawners(const APawn& PlayerPawn)
 {
 	AvailableSpawnerIndices.Reset();
@@ -404,22 +478,25 @@ void UEnemySpawnerComponent::CalculatePossibleSpawners(const APawn& PlayerPawn)
 
 	const auto StartingSpawnerCount = Spawners.Num();
 
-	for (auto SpawnerIt = Spawners.CreateIterator(); SpawnerIt; ++SpawnerIt)
+	// Indices are stored in the spawner grid so rebuild it if any spawners were removed
+	if (Spawners.RemoveAll([](const auto Spawner) { return !IsValid(Spawner); }) > 0)
 	{
-		auto Spawner = *SpawnerIt;
-		if (!IsValid(Spawner))
-		{
-			UE_VLOG_UELOG(GetOwner(), LogTankRampage, Log, TEXT("%s-%s: CalculatePossibleSpawners - Removed de-allocated spawner"),
-				*LoggingUtils::GetName(GetOwner()), *GetName());
-			SpawnerIt.RemoveCurrent();
-			continue;
-		}
+		UE_VLOG_UELOG(GetOwner(), LogTankRampage, Log, TEXT("%s-%s: CalculatePossibleSpawners - Removed %d de-allocated spawner%s"),
+			*LoggingUtils::GetName(GetOwner()), *GetName(), StartingSpawnerCount - Spawners.Num(), LoggingUtils::Pluralize(StartingSpawnerCount - Spawners.Num()));
+
+		InitSpawnerGrid();
+	}
+
+	// Only visit spawners that could pass ShouldBeConsideredForSpawning with the largest spawner max distance
+	const auto QueryRadius = FMath::Sqrt(ConsiderationRadiusSq + FMath::Square(SpawnerGridMaxDistance));
 
-		if (Spawner->ShouldBeConsideredForSpawning(PlayerPawn, ConsiderationRadiusSq))
+	SpawnerGrid.ForEachInRadius(PlayerPawn.GetActorLocation(), QueryRadius, [&](int32 Index, const FVector&, double)
+	{
+		if (Spawners[Index]->ShouldBeConsideredForSpawning(PlayerPawn, ConsiderationRadiusSq))
 		{
-			AvailableSpawnerIndices.Add(SpawnerIt.GetIndex());
+			AvailableSpawnerIndices.Add(Index);
 		}
-	}
+	});
 
 	UE_VLOG_UELOG(GetOwner(), LogTankRampage, Log, TEXT("%s-%s: CalculatePossibleSpawners - %d/%d available spawners: %d were removed"),
 		*LoggingUtils::GetName(GetOwner()), *GetName(), AvailableSpawnerIndices.Num(), Spawners.Num(), StartingSpawnerCount - Spawners.Num());
@@ -452,16 +529,34 @@ std::optional<FEnemySpawnerData> UEnemySpawnerComponent::GetCurrentSpawnerData()
 	UE_VLOG_UELOG(GetOwner(), LogTankRampage, Verbose, TEXT("%s-%s: GetCurrentSpawnerData - CurrentMinute = %d"),
 		*LoggingUtils::GetName(GetOwner()), *GetName(), CurrentMinute);
 
-	if (SpawnerDataByMinute.IsEmpty())
+	const int32 MinuteCount = GetSpawnerMinuteCount();
+	if (MinuteCount == 0)
 	{
 		return {};
 	}
 
-	const int32 Index = FMath::Min(CurrentMinute, SpawnerDataByMinute.Num());
+	// Keep using the last minute once past the end of the data
+	const int32 Index = FMath::Min(CurrentMinute, MinuteCount - 1);
+
+	if (BakedData)
+	{
+		const auto& Record = BakedData->GetSpawnerRecords()[Index];
+
+		FEnemySpawnerData SpawnerData;
+		SpawnerData.SpawnCount = Record.SpawnCount;
+		SpawnerData.SpawnClusterSize = Record.SpawnClusterSize;
+
+		return SpawnerData;
+	}
 
 	return SpawnerDataByMinute[Index];
 }
 
+int32 UEnemySpawnerComponent::GetSpawnerMinuteCount() const
+{
+	return BakedData ? BakedData->GetSpawnerRecords().Num() : SpawnerDataByMinute.Num();
+}
+
 bool UEnemySpawnerComponent::IsDueForSpawnerPrioritization() const
 {
 	auto World = GetWorld();
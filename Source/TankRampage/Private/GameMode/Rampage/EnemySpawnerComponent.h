@@ -5,12 +5,14 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "EnemySpawnerData.h"
+#include "Containers/SpatialHashGrid.h"
 #include <optional>
 
 #include "EnemySpawnerComponent.generated.h"
 
 class AEnemySpawner;
 class UDataTable;
+class URampageBakedData;
 
 DECLARE_MULTICAST_DELEGATE(FOnSpawnerStateChange);
 
@@ -27,12 +29,19 @@ public:
 
 	bool CanSpawnAny() const;
 
+	/*
+	* Reads the spawner records in place from the baked data instead of loading <c>EnemySpawnerDataTable</c>. Must be set before BeginPlay
+	* and only once its records are loaded. <c>EnemySpawnerDataTable</c> is parsed when not set.
+	*/
+	void SetBakedData(URampageBakedData* InBakedData);
+
 protected:
 	virtual void BeginPlay() override;
 	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
 
 private:
 	void InitSpawners();
+	void InitSpawnerGrid();
 	void InitData();
 
 	void InitSpawningSchedule();
@@ -47,11 +56,18 @@ private:
 	bool TryRefreshSpawnersAndRescheduleIfInvalid();
 
 	void CalculateEligibleSpawners(const APawn& PlayerPawn);
+
+	/*
+	* Moves the best remaining candidate to <c>EligibleSpawners</c>, doing its field of view trace first if needed. Returns false if there are none left.
+	*/
+	bool AddNextEligibleSpawner(const APawn& PlayerPawn);
+	float AdjustSpawnerScore(const AEnemySpawner& Spawner, float Score) const;
 	void CalculatePossibleSpawners(const APawn& PlayerPawn);
 
 	std::pair<float,int32> CalculateSpawnIntervalTimeAndCycles() const;
 
 	std::optional<FEnemySpawnerData> GetCurrentSpawnerData() const;
+	int32 GetSpawnerMinuteCount() const;
 
 	bool CalculateEligibleSpawnersAsNeeded(const APawn& PlayerPawn);
 
@@ -89,6 +105,12 @@ private:
 	UPROPERTY(EditDefaultsOnly, Category = "Spawning")
 	int32 SpawnerRefreshMinutes{ -1 };
 
+	/*
+	* Cell size of the grid of spawner locations used to find spawners near the player.
+	*/
+	UPROPERTY(EditDefaultsOnly, Category = "Spawning")
+	float SpawnerGridCellSize{ 50000.0f };
+
 
 	UPROPERTY(Transient)
 	TArray<AEnemySpawner*> Spawners;
@@ -99,11 +121,32 @@ private:
 		uint16 SpawnCount;
 		uint16 VisitCount;
 		float Score;
+		float CheckTime;
+	};
+
+	struct FSpawnerCandidate
+	{
+		int32 Index;
+		float Score;
+		bool bRequiresFOVTrace;
+		float CheckTime;
+
+		bool operator<(const FSpawnerCandidate& Other) const;
 	};
 
 	TArray<FSpawnerMetadata> EligibleSpawners;
+
+	/*
+	* Heap of the eligible spawners not yet visited in this prioritization, best score first.
+	* Scores of the candidates that still require the field of view trace are their best case.
+	*/
+	TArray<FSpawnerCandidate> SpawnerCandidates;
 	TArray<int32> AvailableSpawnerIndices;
 
+	/* Indices into Spawners by actor location. */
+	TR::TSpatialHashGrid<int32> SpawnerGrid{};
+	float SpawnerGridMaxDistance{};
+
 	struct FCurrentSpawnerState
 	{
 		FEnemySpawnerData SpawnerData{};
@@ -125,9 +168,14 @@ private:
 
 	FCurrentSpawnerState CurrentSpawnerState{};
 
+	/* Only loaded when the baked data is not used. */
 	UPROPERTY(EditDefaultsOnly, Category = Data)
-	TObjectPtr<UDataTable> EnemySpawnerDataTable{};
+	TSoftObjectPtr<UDataTable> EnemySpawnerDataTable{};
+
+	UPROPERTY(Transient)
+	TObjectPtr<URampageBakedData> BakedData{};
 
+	/* Parsed from the data table when there is no baked data. */
 	TArray<FEnemySpawnerData> SpawnerDataByMinute;
 	float SpawningOffsetTime{ -1.0f };
 	float LastEligibleSpawnersSortTime{ -1.0f };
@@ -138,6 +186,16 @@ private:
 
 #pragma region Inline Definitions
 
+inline void UEnemySpawnerComponent::SetBakedData(URampageBakedData* InBakedData)
+{
+	BakedData = InBakedData;
+}
+
+inline bool UEnemySpawnerComponent::FSpawnerCandidate::operator<(const FSpawnerCandidate& Other) const
+{
+	return Score < Other.Score;
+}
+
 inline float UEnemySpawnerComponent::GetEarliestSpawningGameTimeSeconds() const
 {
 	return EarliestSpawningGameTimeSeconds;
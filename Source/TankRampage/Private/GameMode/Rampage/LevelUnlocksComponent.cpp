@@ -7,6 +7,8 @@
 #include "Item/ItemInventory.h"
 #include "Item/Item.h"
 
+#include "RampageBakedData.h"
+
 #include "Logging/LoggingUtils.h"
 #include "VisualLogger/VisualLogger.h"
 #include "TankRampageLogging.h"
@@ -34,8 +36,7 @@ namespace
 	void SelectRandomizedAvailableItems(Random& Rng, const TArray<FLevelUnlock>& PossibleUnlocks, TArray<FLevelUnlock>& OutAvailable, int32 Count);
 }
 
-// Initialize the random number generator with a seed from current time
-ULevelUnlocksComponent::ULevelUnlocksComponent() : Rng(RandUtils::GenerateSeed())
+ULevelUnlocksComponent::ULevelUnlocksComponent()
 {
 	PrimaryComponentTick.bCanEverTick = false;
 }
@@ -44,6 +45,9 @@ void ULevelUnlocksComponent::BeginPlay()
 {
 	Super::BeginPlay();
 
+	// Keyed by path name so that a pinned seed gives the same unlock options every run
+	Rng.seed(RandUtils::GenerateSeed(*this));
+
 	GiveLocalPlayerFirstLevelUnlocks();
 }
 
@@ -70,7 +74,7 @@ std::optional<FLevelUnlocksContext> ULevelUnlocksComponent::GetNextLevelUnlockOp
 	checkf(NextLevel >= 0, TEXT("NextLevel=%d < 0"), NextLevel);
 
 	// Make sure at least one level unlock is available
-	if (!ensure(!LevelUnlocks.IsEmpty()))
+	if (!ensure(GetLevelCount() > 0))
 	{
 		return std::nullopt;
 	}
@@ -113,17 +117,19 @@ void ULevelUnlocksComponent::DetermineAvailableOptionCounts(int32 NextLevel, int
 {
 	// Offer 0 to N-1 previous upgrades passed on previously - if at the end of level - keep offering available previous upgrades
 
-	if (NextLevel >= LevelUnlocks.Num())
+	const int32 LevelCount = GetLevelCount();
+
+	if (NextLevel >= LevelCount)
 	{
-		NumAvailableOptions = GetNumUnlockOptions(LevelUnlocks.Last());
+		NumAvailableOptions = GetNumUnlockOptions(GetLevelUnlocksConfig(LevelCount - 1));
 		NumCurrent = 0;
 
-		UE_VLOG_UELOG(this, LogTankRampage, Display, TEXT("%s: DetermineAvailableOptionCounts : NextLevel=%d >= LevelUnlocks.Num()=%d - Offering previous unlocks; MaxOptions=%d"),
-			*GetName(), NextLevel, LevelUnlocks.Num(), NumAvailableOptions);
+		UE_VLOG_UELOG(this, LogTankRampage, Display, TEXT("%s: DetermineAvailableOptionCounts : NextLevel=%d >= LevelCount=%d - Offering previous unlocks; MaxOptions=%d"),
+			*GetName(), NextLevel, LevelCount, NumAvailableOptions);
 	}
 	else
 	{
-		const auto& Config = LevelUnlocks[NextLevel];
+		const auto Config = GetLevelUnlocksConfig(NextLevel);
 		NumAvailableOptions = GetNumUnlockOptions(Config);
 		NumCurrent = NumAvailableOptions > 0 ? FMath::Min(FMath::RandRange(1, NumAvailableOptions), Config.AvailableUnlocks.Num()) : 0;
 
@@ -145,7 +151,7 @@ TArray<FLevelUnlock> ULevelUnlocksComponent::GetAvailableUnlocks(const int32 Nex
 	{
 		PossibleCurrentUnlocks.Reserve(MaxOptions);
 
-		PopulateViableUnlockOptions(CurrentItems, LevelUnlocks[NextLevel].AvailableUnlocks, PossibleCurrentUnlocks);
+		PopulateViableUnlockOptions(CurrentItems, GetLevelUnlocksConfig(NextLevel).AvailableUnlocks, PossibleCurrentUnlocks);
 
 		// Not all current unlocks will be viable if previous levels not earned
 		NumCurrent = FMath::Min(NumCurrent, PossibleCurrentUnlocks.Num());
@@ -157,9 +163,9 @@ TArray<FLevelUnlock> ULevelUnlocksComponent::GetAvailableUnlocks(const int32 Nex
 	{
 		PossiblePreviousUnlocks.Reserve(MaxOptions);
 		// Start at previous level and iterate backwards
-		for (int32 i = FMath::Min(NextLevel, LevelUnlocks.Num()) - 1; i >= 0; --i)
+		for (int32 i = FMath::Min(NextLevel, GetLevelCount()) - 1; i >= 0; --i)
 		{
-			PopulateViableUnlockOptions(CurrentItems, LevelUnlocks[i].AvailableUnlocks, PossiblePreviousUnlocks);
+			PopulateViableUnlockOptions(CurrentItems, GetLevelUnlocksConfig(i).AvailableUnlocks, PossiblePreviousUnlocks);
 		}
 	}
 
@@ -240,12 +246,25 @@ UItemInventory* ULevelUnlocksComponent::GetItemInventory(APawn* Pawn) const
 std::optional<FLevelUnlocksContext> ULevelUnlocksComponent::GetFirstLevelUnlockOptions() const
 {
 	// Make sure at least one level unlock is available
-	if (!ensure(!LevelUnlocks.IsEmpty()))
+	if (!ensure(GetLevelCount() > 0))
 	{
 		return std::nullopt;
 	}
 
-	return GetLevelUnlocksContext(1, LevelUnlocks[0].AvailableUnlocks, LevelUnlocks[0].AvailableUnlocks.Num());
+	const auto FirstLevelConfig = GetLevelUnlocksConfig(0);
+
+	return GetLevelUnlocksContext(1, FirstLevelConfig.AvailableUnlocks, FirstLevelConfig.AvailableUnlocks.Num());
+}
+
+int32 ULevelUnlocksComponent::GetLevelCount() const
+{
+	return BakedData ? BakedData->GetPlayerLevelRecords().Num() : LevelUnlocks.Num();
+}
+
+FLevelUnlocksConfig ULevelUnlocksComponent::GetLevelUnlocksConfig(int32 Index) const
+{
+	// Only the levels offered are copied out of the baked records
+	return BakedData ? BakedData->GetLevelUnlocksConfig(Index) : LevelUnlocks[Index];
 }
 
 FLevelUnlocksContext ULevelUnlocksComponent::GetLevelUnlocksContext(int32 NextLevel, const TArray<FLevelUnlock>& TotalOptions, int32 NumAvailableOptions) const
@@ -13,6 +13,7 @@
 
 class UItem;
 class UItemInventory;
+class URampageBakedData;
 
 /*
 * Gets available player unlocks based on the next level and also applies them to the player's inventory.
@@ -35,6 +36,12 @@ public:
 
 	void SetLevelUnlocks(const TArray<FLevelUnlocksConfig>& InLevelUnlocks);
 
+	/*
+	* Reads the unlocks of each level from the baked records when needed instead of the level unlocks set above. Must be set before BeginPlay
+	* and the records loaded by the caller.
+	*/
+	void SetBakedData(URampageBakedData* InBakedData);
+
 protected:
 	virtual void BeginPlay() override;
 
@@ -50,11 +57,21 @@ private:
 	void PopulateViableUnlockOptions(const TArray<UItem*>& CurrentItems, const TArray<FLevelUnlock>& TotalOptions, TArray<FLevelUnlock>& OutOptions) const;
 	UItemInventory* GetItemInventory(APawn* Pawn) const;
 
+	int32 GetLevelCount() const;
+
+	/*
+	* Index is the player level - 1.
+	*/
+	FLevelUnlocksConfig GetLevelUnlocksConfig(int32 Index) const;
+
 private:
 
 	UPROPERTY(Transient)
 	TArray<FLevelUnlocksConfig> LevelUnlocks;
 
+	UPROPERTY(Transient)
+	TObjectPtr<URampageBakedData> BakedData{};
+
 	mutable std::default_random_engine Rng;
 };
 
@@ -65,4 +82,9 @@ inline void ULevelUnlocksComponent::SetLevelUnlocks(const TArray<FLevelUnlocksCo
 	this->LevelUnlocks = InLevelUnlocks;
 }
 
+inline void ULevelUnlocksComponent::SetBakedData(URampageBakedData* InBakedData)
+{
+	BakedData = InBakedData;
+}
+
 #pragma endregion Inline Definitions
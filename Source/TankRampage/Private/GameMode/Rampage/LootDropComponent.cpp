@@ -8,6 +8,8 @@
 #include "Item/ItemSubsystem.h"
 #include "Pawn/BaseTankPawn.h"
 #include "Pickup/BasePickup.h"
+#include "Pickup/PickupPoolSubsystem.h"
+#include "Subsystems/LootPlacementSubsystem.h"
 
 #include "Logging/LoggingUtils.h"
 #include "VisualLogger/VisualLogger.h"
@@ -29,18 +31,6 @@
 namespace
 {
 	FRealCurve* FindCurveForLevel(UCurveTable* CurveTable, int32 Level);
-
-	bool ShouldIgnoreOverlap(const FOverlapResult& Overlap);
-
-	const UObject* OverlapKey(const FOverlapResult& Overlap);
-
-	FBox GetObjectAABB(const UObject* Object);
-
-	// LandscapeSplineActor on Urban map cannot have object type set to "Ground" (locked in the base class) so need to filter that here
-	bool ShouldIgnoreOverlapByName(const FOverlapResult& Overlap);
-	bool ShouldIgnoreOverlapByName(const FString& ObjectName);
-
-	const TArray<FString> OverlapIgnoreNames = { "Landscape" };
 }
 
 struct FSpawnData
@@ -56,8 +46,6 @@ struct ULootDropComponent::FSpawnContext
 {
 	TSubclassOf<ABasePickup> PickupClass{};
 	TOptional<FBox> PickupBounds{};
-	TOptional<FVector> BiasLocation{};
-	FBox OverlapBounds{ EForceInit::ForceInitToZero };
 	TArray<FSpawnData>* OtherSpawned{};
 
 	FSpawnContext(const TSubclassOf<ABasePickup>& PickupClass, TArray<FSpawnData>& OtherSpawned) : PickupClass(PickupClass), OtherSpawned(&OtherSpawned) {}
@@ -120,7 +108,7 @@ void ULootDropComponent::OnTankDestroyed(ABaseTankPawn* DestroyedTank, AControll
 
 	const auto BaseLocation = GetSpawnBaseLocation(*DestroyedTank, PlayerController, SpawnReferenceLocation);
 
-	SpawnLoot(PlayerController, BaseLocation, SpawnReferenceLocation);
+	SpawnLoot(PlayerController, BaseLocation);
 }
 
 void ULootDropComponent::OnXPLevelUp(int32 NewLevel)
@@ -133,7 +121,7 @@ void ULootDropComponent::OnXPLevelUp(int32 NewLevel)
 	InitializeLevelData(NewLevel);
 }
 
-void ULootDropComponent::SpawnLoot(const AController* Owner, const FVector& BaseSpawnLocation, const TOptional<FVector>& SpawnReferenceLocation)
+void ULootDropComponent::SpawnLoot(const AController* Owner, const FVector& BaseSpawnLocation)
 {
 	auto World = GetWorld();
 	check(World);
@@ -154,7 +142,6 @@ void ULootDropComponent::SpawnLoot(const AController* Owner, const FVector& Base
 		}
 
 		FSpawnContext Context(Class, SpawnedLootBounds);
-		Context.BiasLocation = SpawnReferenceLocation;
 
 		FVector InitialSpawnLocation;
 
@@ -199,15 +186,14 @@ const ABasePickup* ULootDropComponent::SpawnLoot(const AController* Owner, const
 	auto World = GetWorld();
 	check(World);
 
-	FActorSpawnParameters SpawnParameters;
-	SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-
-	if (Owner)
+	auto PickupPoolSubsystem = World->GetSubsystem<UPickupPoolSubsystem>();
+	if (!ensure(PickupPoolSubsystem))
 	{
-		SpawnParameters.Instigator = Owner->GetPawn();
+		return nullptr;
 	}
 
-	auto Pickup = World->SpawnActor<ABasePickup>(PickupClass, SpawnLocation, FRotator::ZeroRotator, SpawnParameters);
+	// Only reused if the pickup class opts into pooling
+	auto Pickup = PickupPoolSubsystem->AcquirePickup(PickupClass, FTransform(SpawnLocation), nullptr, Owner ? Owner->GetPawn() : nullptr);
 	if (Pickup)
 	{
 		UE_VLOG_UELOG(GetOwner(), LogTankRampage, Log, TEXT("%s: SpawnLoot - Spawned pickup=%s with class=%s at SpawnLocation=%s"),
@@ -226,24 +212,9 @@ FVector ULootDropComponent::GetSpawnLocation(FSpawnContext& SpawnContext, const
 {
 	SpawnContext.PickupBounds = GetPickupBounds(SpawnContext.PickupClass);
 
-	FVector SpawnLocation = InitialSpawnLocation = GetOffsetSpawnLocation(SpawnContext, BaseLocation, FSpawnData::IndexInitial);
+	InitialSpawnLocation = GetOffsetSpawnLocation(SpawnContext, BaseLocation, FSpawnData::IndexInitial);
 
-	for (int32 i = 0; i < CollisionTestMaxIterations; ++i)
-	{
-		UE_VLOG_UELOG(GetOwner(), LogTankRampage, Log, TEXT("%s: GetSpawnLocation - %s - Testing for collision iteration %d / %d with SpawnLocation=%s"),
-			*GetName(), *LoggingUtils::GetName(SpawnContext.PickupClass), i + 1, CollisionTestMaxIterations, *SpawnLocation.ToCompactString());
-
-		if (GetCollisionFreeSpawnLocation(SpawnContext, SpawnLocation, i))
-		{
-			// No further collision
-			break;
-		}
-		else if (i == CollisionTestMaxIterations - 1)
-		{
-			UE_VLOG_UELOG(GetOwner(), LogTankRampage, Warning, TEXT("%s: GetSpawnLocation - %s - Reached max iterations of %d when testing for collisions - SpawnLocation=%s"),
-				*GetName(), *LoggingUtils::GetName(SpawnContext.PickupClass), CollisionTestMaxIterations, *SpawnLocation.ToCompactString());
-		}
-	}
+	const auto SpawnLocation = GetCollisionFreeSpawnLocation(SpawnContext, InitialSpawnLocation);
 
 	return GroundSpawnLocation(SpawnContext.PickupClass, SpawnLocation);
 }
@@ -344,124 +315,52 @@ bool ULootDropComponent::IsOverlappingExistingSpawns(const FSpawnContext& SpawnC
 	return false;
 }
 
-bool ULootDropComponent::GetCollisionFreeSpawnLocation(FSpawnContext& SpawnContext, FVector& SpawnLocation, int32 Iteration) const
+FVector ULootDropComponent::GetCollisionFreeSpawnLocation(const FSpawnContext& SpawnContext, const FVector& SpawnLocation) const
 {
 	if (!SpawnContext.PickupBounds)
 	{
-		return true;
+		return SpawnLocation;
 	}
 
 	auto World = GetWorld();
 	check(World);
 
-	TArray<FOverlapResult> Overlaps;
-
-	const FVector& PickupBoundsExtent = SpawnContext.PickupBounds->GetExtent();
-
-	const auto PickupCollisionShape = FCollisionShape::MakeBox(PickupBoundsExtent);
-
-	World->OverlapMultiByObjectType(
-		Overlaps,
-		SpawnLocation,
-		FQuat{ EForceInit::ForceInit }, // ZeroRotator
-		ECollisionChannel::ECC_WorldStatic,
-		PickupCollisionShape);
-
-	TSet<const UObject*, DefaultKeyFuncs<const UObject*>, TInlineSetAllocator<64>> OverlapResults;
-
-	for (const auto& OverlapResult : Overlaps)
+	auto LootPlacementSubsystem = World->GetSubsystem<ULootPlacementSubsystem>();
+	if (!ensure(LootPlacementSubsystem))
 	{
-		const auto Key = OverlapKey(OverlapResult);
-		if (!Key)
-		{
-			continue;
-		}
-
-		if (ShouldIgnoreOverlap(OverlapResult))
-		{
-			continue;
-		}
-
-		bool bAlreadyVisited{};
-		OverlapResults.Add(Key, &bAlreadyVisited);
+		return SpawnLocation;
+	}
 
-		if (!bAlreadyVisited)
-		{
-			const FBox& ObjectBounds = GetObjectAABB(Key);
+	const auto FreeLocation = LootPlacementSubsystem->FindFreeLocation(SpawnLocation, SpawnContext.PickupBounds->GetExtent(), PlacementSearchRadius,
+		[&](const FVector& Candidate)
+	{
+		return !IsOverlappingExistingSpawns(SpawnContext, Candidate, FSpawnData::IndexFinal);
+	});
 
-			SpawnContext.OverlapBounds += ObjectBounds;
+	if (!FreeLocation)
+	{
+		UE_VLOG_UELOG(GetOwner(), LogTankRampage, Warning, TEXT("%s: GetCollisionFreeSpawnLocation - %s - No free location within %.0f of SpawnLocation=%s"),
+			*GetName(), *LoggingUtils::GetName(SpawnContext.PickupClass), PlacementSearchRadius, *SpawnLocation.ToCompactString());
 
-			UE_VLOG_UELOG(GetOwner(), LogTankRampage, Verbose, TEXT("%s: GetCollisionFreeSpawnLocation - %s Overlapped with %s Bounds=%s; TotalOverlapBounds=%s"),
-				*GetName(), *Key->GetName(), *LoggingUtils::GetName(SpawnContext.PickupClass),
-				*ObjectBounds.ToString(), *SpawnContext.OverlapBounds.ToString());
-		}
+		return SpawnLocation;
 	}
 
 #if ENABLE_VISUAL_LOG
-	// Don't overdraw
-	if (FVisualLogger::IsRecording() && Iteration == 0)
+	if (FVisualLogger::IsRecording())
 	{
 		UE_VLOG_BOX(GetOwner(), LogTankRampage, Verbose, SpawnContext.PickupBounds->MoveTo(SpawnLocation), FColor::Blue, TEXT("I: %s"), *SpawnContext.PickupClass->GetName());
-	}
-#endif
-	// Draw overlap
-	if (!OverlapResults.IsEmpty())
-	{
-		UE_VLOG_BOX(GetOwner(), LogTankRampage, Verbose, SpawnContext.OverlapBounds, FColor::Orange, TEXT("O: %s"), *SpawnContext.PickupClass->GetName());
-	}
-	else
-	{
-		UE_VLOG_UELOG(GetOwner(), LogTankRampage, Verbose, TEXT("%s: GetCollisionFreeSpawnLocation - No overlaps detected with %s at %s"),
-			*GetName(), *LoggingUtils::GetName(SpawnContext.PickupClass), *SpawnLocation.ToCompactString());
-
-		// No adjustment required, no further overlap testing required
-		return true;
-	}
-
-
-	FVector OverlapCenter, OverlapExtent;
-	SpawnContext.OverlapBounds.GetCenterAndExtents(OverlapCenter, OverlapExtent);
-
-	OverlapCenter.Z = SpawnLocation.Z;
-
-	// Discount the Z difference
-	const FBox OverlapBounds2D = SpawnContext.OverlapBounds.MoveTo(OverlapCenter);
 
-	const auto PickupBoundsSize2D = PickupBoundsExtent.Size2D();
-	const auto ExtentSize = OverlapExtent.Size2D() + PickupBoundsSize2D;
-
-	const auto PushOutDirection = OrientDirectionTowardPlayer(SpawnContext, SpawnLocation, (SpawnLocation - OverlapCenter).GetSafeNormal());
-	const auto CircleEdgeLocation = SpawnLocation + PushOutDirection * ExtentSize;
-
-	// Dial-in the push out distance since we are using a circumscribed circle
-	// In order to push out needed to make sure we are outside the box as GetClosestPointTo returns the point if inside the box
-	const auto ClampedBoxPoint = OverlapBounds2D.GetClosestPointTo(CircleEdgeLocation);
-	// Add in the pickup bounds again and offset distance - make sure don't spawn back in the box when randomize the final location
-	const auto CandidateLocation = ClampedBoxPoint + PushOutDirection * (PickupBoundsSize2D + SpawnRadius);
-	const auto FinalLocation = GetOffsetSpawnLocation(SpawnContext, CandidateLocation, FSpawnData::IndexFinal);
-
-	UE_VLOG_BOX(GetOwner(), LogTankRampage, Verbose, SpawnContext.PickupBounds->MoveTo(FinalLocation), FColor::Green, TEXT("F(%d): %s"), Iteration, *SpawnContext.PickupClass->GetName());
-	UE_VLOG_UELOG(GetOwner(), LogTankRampage, Log, TEXT("%s: GetCollisionFreeSpawnLocation - %d overlaps detected with %s at %s -> %s"),
-		*GetName(), OverlapResults.Num(), *LoggingUtils::GetName(SpawnContext.PickupClass),
-		*SpawnLocation.ToCompactString(), *FinalLocation.ToCompactString());
-
-	SpawnLocation = FinalLocation;
-
-	// Overlaps detected in this iteration
-	return false;
-}
-
-FVector ULootDropComponent::OrientDirectionTowardPlayer(const FSpawnContext& SpawnContext, const FVector& Position, const FVector& Direction) const
-{
-	if (!SpawnContext.BiasLocation)
-	{
-		return Direction;
+		if (!FreeLocation->Equals(SpawnLocation))
+		{
+			UE_VLOG_BOX(GetOwner(), LogTankRampage, Verbose, SpawnContext.PickupBounds->MoveTo(*FreeLocation), FColor::Green, TEXT("F: %s"), *SpawnContext.PickupClass->GetName());
+		}
 	}
+#endif
 
-	const auto ToPlayer = *SpawnContext.BiasLocation - Position;
+	UE_VLOG_UELOG(GetOwner(), LogTankRampage, Log, TEXT("%s: GetCollisionFreeSpawnLocation - %s at %s -> %s"),
+		*GetName(), *LoggingUtils::GetName(SpawnContext.PickupClass), *SpawnLocation.ToCompactString(), *FreeLocation->ToCompactString());
 
-	// Flip vector if not oriented toward player
-	return (ToPlayer | Direction) >= 0 ? Direction : -Direction;
+	return *FreeLocation;
 }
 
 TOptional<FBox> ULootDropComponent::GetPickupBounds(const TSubclassOf<ABasePickup>& PickupClass) const
@@ -673,64 +572,4 @@ namespace
 		return CurveTable->FindCurveUnchecked(FName(buf));
 #endif
 	}
-
-	bool ShouldIgnoreOverlap(const FOverlapResult& Overlap)
-	{
-		auto Component = Overlap.GetComponent();
-		if (!Component)
-		{
-			return false;
-		}
-
-		// Ignore the ground for checking for overlaps 
-		// and only consider blocks with the player tank
-		return Component->GetCollisionObjectType() == TR::CollisionChannel::GroundObjectType ||
-			   Component->GetCollisionResponseToChannel(ECC_Pawn) != ECollisionResponse::ECR_Block ||
-			   ShouldIgnoreOverlapByName(Overlap);
-	}
-
-	bool ShouldIgnoreOverlapByName(const FOverlapResult& Overlap)
-	{
-		const auto Actor = Overlap.GetActor();
-
-		if (Actor && ShouldIgnoreOverlapByName(Actor->GetName()))
-		{
-			return true;
-		}
-
-		const auto Component = Overlap.GetComponent();
-		return Component && ShouldIgnoreOverlapByName(Component->GetName());
-	}
-
-	inline bool ShouldIgnoreOverlapByName(const FString& ObjectName)
-	{
-		return OverlapIgnoreNames.ContainsByPredicate([&ObjectName](const auto& NameSubstring)
-		{
-			return ObjectName.Contains(NameSubstring);
-		});
-	}
-
-	inline const UObject* OverlapKey(const FOverlapResult& Overlap)
-	{
-		const UObject* Key = Overlap.GetActor();
-		return Key ? Key : Overlap.GetComponent();
-	}
-
-	FBox GetObjectAABB(const UObject* Object)
-	{
-		const auto ActorResult = Cast<AActor>(Object);
-		if (ActorResult)
-		{
-			return TR::CollisionUtils::GetAABB(*ActorResult);
-		}
-
-		const auto ComponentResult = Cast<USceneComponent>(Object);
-		if (ComponentResult)
-		{
-			return TR::CollisionUtils::GetAABB(*ComponentResult);
-		}
-
-		// Invalid
-		return FBox{ EForceInit::ForceInitToZero };
-	}
 }
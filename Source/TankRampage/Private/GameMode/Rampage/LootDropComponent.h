@@ -54,7 +54,7 @@ private:
 	UFUNCTION()
 	void OnXPLevelUp(int32 NewLevel);
 
-	void SpawnLoot(const AController* Owner, const FVector& BaseSpawnLocation, const TOptional<FVector>& SpawnReferenceLocation);
+	void SpawnLoot(const AController* Owner, const FVector& BaseSpawnLocation);
 
 	const ABasePickup* SpawnLoot(const AController* Owner, const FVector& SpawnLocation, UClass* PickupClass) const;
 	FVector GetSpawnLocation(FSpawnContext& SpawnContext, const FVector& BaseLocation, FVector& InitialSpawnLocation) const;
@@ -63,11 +63,10 @@ private:
 	FVector GetSpawnBaseLocation(const ABaseTankPawn& DestroyedTank, const AController* DestroyedBy, TOptional<FVector>& OutSpawnReferenceLocation) const;
 	TOptional<FVector> GetReferenceActorLocation(const ABaseTankPawn& DestroyedTank, const AController* DestroyedBy) const;
 	FVector GetOffsetSpawnLocation(const FSpawnContext& SpawnContext, const FVector& BaseLocation, int32 LocationIndex) const;
-	bool GetCollisionFreeSpawnLocation(FSpawnContext& SpawnContext, FVector& SpawnLocation, int32 Iteration) const;
+	FVector GetCollisionFreeSpawnLocation(const FSpawnContext& SpawnContext, const FVector& SpawnLocation) const;
 	TOptional<FBox> GetPickupBounds(const TSubclassOf<ABasePickup>& PickupClass) const;
 	TOptional<FBox> GetPickupBounds(const ABasePickup& Pickup) const;
 	bool IsOverlappingExistingSpawns(const FSpawnContext& SpawnContext, const FVector& Location, int32 LocationIndex) const;
-	FVector OrientDirectionTowardPlayer(const FSpawnContext& SpawnContext, const FVector& Position, const FVector& Direction) const;
 
 	FVector GroundSpawnLocation(const TSubclassOf<ABasePickup>& PickupClass, const FVector& Location) const;
 
@@ -86,8 +85,9 @@ private:
 	UPROPERTY(EditDefaultsOnly, Category = "Spawn")
 	float SpawnRadius{ 300.0f };
 
+	/* How far from the initial spawn location to search for a spot clear of static geometry and other loot. */
 	UPROPERTY(EditDefaultsOnly, Category = "Spawn")
-	int32 CollisionTestMaxIterations{ 5 };
+	float PlacementSearchRadius{ 1500.0f };
 
 	UPROPERTY(EditDefaultsOnly, Category = "Spawn")
 	int32 MultipleLootOverlapCheckMaxIterations{ 5 };
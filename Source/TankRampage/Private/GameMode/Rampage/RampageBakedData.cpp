@@ -0,0 +1,560 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GameMode/Rampage/RampageBakedData.h"
+
+#include "LevelUnlocksData.h"
+
+#include "Logging/LoggingUtils.h"
+#include "TankRampageLogging.h"
+#include "TRConstants.h"
+
+#if WITH_EDITOR
+	#include "Misc/DataValidation.h"
+	#include "UObject/ObjectSaveContext.h"
+#endif
+
+#if WITH_EDITOR && TR_DEBUG_ENABLED
+	#include "HAL/IConsoleManager.h"
+	#include "UObject/UObjectIterator.h"
+#endif
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(RampageBakedData)
+
+namespace
+{
+	/* "TRBD" */
+	constexpr uint32 BakedDataMagic = 0x44425254;
+
+	/* Bump when the layout of the records changes so that older blobs are rebaked before they are trusted. */
+	constexpr uint32 BakedDataVersion = 1;
+
+	// Records are read in place so must have the same layout on every platform the blob is cooked for
+	static_assert(PLATFORM_LITTLE_ENDIAN, "Baked rampage data is stored little endian");
+
+	struct FBakedHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		int32 SpawnerRowCount;
+		int32 PlayerLevelCount;
+		int32 UnlockCount;
+		int32 XPLevelCount;
+	};
+
+	template<typename T>
+	void AppendRecords(TArray<uint8>& Blob, const TArray<T>& Records)
+	{
+		Blob.Append(reinterpret_cast<const uint8*>(Records.GetData()), Records.Num() * sizeof(T));
+	}
+
+	template<typename T>
+	TConstArrayView<T> ReadRecords(const TArray<uint8>& Blob, int32& Offset, int32 Count)
+	{
+		static_assert(alignof(T) <= alignof(FBakedHeader), "Records must not need more alignment than the header");
+
+		const auto View = TConstArrayView<T>(reinterpret_cast<const T*>(Blob.GetData() + Offset), Count);
+		Offset += Count * sizeof(T);
+		return View;
+	}
+}
+
+bool URampageBakedData::LoadRecords()
+{
+	LoadedRecords = {};
+	LoadedView = {};
+
+#if WITH_EDITOR
+	if (!FPlatformProperties::RequiresCookedData())
+	{
+		BakeSourceTables(TransientRecords);
+
+		if (!GetBakedView(TransientRecords, LoadedView))
+		{
+			return false;
+		}
+
+		LoadedRecords = &TransientRecords;
+		return true;
+	}
+#endif
+
+	if (!IsUsingBakedData())
+	{
+		UE_LOG(LogTankRampage, Warning, TEXT("%s: LoadRecords - Baked data is missing or out of date (BlobSize=%d; Version=%u); falling back to the data tables until the asset is rebaked"),
+			*GetName(), BakedRecords.Blob.Num(), BakedDataVersion);
+		return false;
+	}
+
+	verify(GetBakedView(BakedRecords, LoadedView));
+	LoadedRecords = &BakedRecords;
+
+	return true;
+}
+
+FLevelUnlock URampageBakedData::GetLevelUnlock(const FRampageUnlockRecord& Record) const
+{
+	check(LoadedRecords);
+
+	// Indices were checked when the view was loaded
+	return FLevelUnlock
+	{
+		.Description = LoadedRecords->Descriptions[Record.DescriptionIndex],
+		.ItemName = LoadedRecords->ItemNames[Record.ItemNameIndex],
+		.Level = Record.ItemLevel
+	};
+}
+
+FLevelUnlocksConfig URampageBakedData::GetLevelUnlocksConfig(int32 Index) const
+{
+	const auto& PlayerLevel = LoadedView.PlayerLevels[Index];
+
+	FLevelUnlocksConfig Config
+	{
+		.MaxUnlockOptions = PlayerLevel.MaxUnlockOptions
+	};
+
+	Config.AvailableUnlocks.Reserve(PlayerLevel.UnlockCount);
+
+	for (const auto& Unlock : LoadedView.Unlocks.Slice(PlayerLevel.FirstUnlockIndex, PlayerLevel.UnlockCount))
+	{
+		Config.AvailableUnlocks.Add(GetLevelUnlock(Unlock));
+	}
+
+	return Config;
+}
+
+bool URampageBakedData::HasValidBakedData() const
+{
+	FBakedView View;
+	return GetBakedView(BakedRecords, View);
+}
+
+bool URampageBakedData::IsUsingBakedData() const
+{
+	// Source tables can be edited without a rebake in the editor so only cooked data is trusted
+	return FPlatformProperties::RequiresCookedData() && HasValidBakedData();
+}
+
+bool URampageBakedData::GetBakedView(const FRampageBakedRecords& Records, FBakedView& OutView)
+{
+	const auto& Blob = Records.Blob;
+
+	if (Blob.Num() < static_cast<int32>(sizeof(FBakedHeader)))
+	{
+		return false;
+	}
+
+	const auto& Header = *reinterpret_cast<const FBakedHeader*>(Blob.GetData());
+	if (Header.Magic != BakedDataMagic || Header.Version != BakedDataVersion)
+	{
+		return false;
+	}
+
+	if (Header.SpawnerRowCount < 0 || Header.PlayerLevelCount < 0 || Header.UnlockCount < 0 || Header.XPLevelCount < 0)
+	{
+		return false;
+	}
+
+	const int64 ExpectedSize = sizeof(FBakedHeader)
+		+ static_cast<int64>(Header.SpawnerRowCount) * sizeof(FRampageSpawnerRecord)
+		+ static_cast<int64>(Header.PlayerLevelCount) * sizeof(FRampagePlayerLevelRecord)
+		+ static_cast<int64>(Header.UnlockCount) * sizeof(FRampageUnlockRecord)
+		+ static_cast<int64>(Header.XPLevelCount) * sizeof(int32);
+
+	if (ExpectedSize != Blob.Num())
+	{
+		return false;
+	}
+
+	int32 Offset = sizeof(FBakedHeader);
+
+	FBakedView View;
+	View.SpawnerRows = ReadRecords<FRampageSpawnerRecord>(Blob, Offset, Header.SpawnerRowCount);
+	View.PlayerLevels = ReadRecords<FRampagePlayerLevelRecord>(Blob, Offset, Header.PlayerLevelCount);
+	View.Unlocks = ReadRecords<FRampageUnlockRecord>(Blob, Offset, Header.UnlockCount);
+	View.XPLevels = ReadRecords<int32>(Blob, Offset, Header.XPLevelCount);
+
+	// Indices are checked once here so that readers do not need to
+	for (const auto& PlayerLevel : View.PlayerLevels)
+	{
+		if (PlayerLevel.FirstUnlockIndex < 0 || PlayerLevel.UnlockCount < 0 || PlayerLevel.FirstUnlockIndex + PlayerLevel.UnlockCount > View.Unlocks.Num())
+		{
+			return false;
+		}
+	}
+
+	for (const auto& Unlock : View.Unlocks)
+	{
+		if (!Records.Descriptions.IsValidIndex(Unlock.DescriptionIndex) || !Records.ItemNames.IsValidIndex(Unlock.ItemNameIndex))
+		{
+			return false;
+		}
+	}
+
+	OutView = View;
+
+	return true;
+}
+
+#if WITH_EDITOR
+
+namespace
+{
+	void BakeRecords(const TArray<FEnemySpawnerData>& SpawnerData, const TArray<FLevelUnlocksConfig>& LevelUnlocks, const TArray<int32>& XPLevels,
+		FRampageBakedRecords& OutRecords)
+	{
+		TArray<FRampageSpawnerRecord> SpawnerRows;
+		SpawnerRows.Reserve(SpawnerData.Num());
+
+		for (const auto& Row : SpawnerData)
+		{
+			SpawnerRows.Add({ Row.SpawnCount, Row.SpawnClusterSize });
+		}
+
+		TArray<FRampagePlayerLevelRecord> PlayerLevels;
+		PlayerLevels.Reserve(LevelUnlocks.Num());
+
+		TArray<FRampageUnlockRecord> Unlocks;
+
+		OutRecords.Descriptions.Reset();
+		OutRecords.ItemNames.Reset();
+
+		// Item names repeat for each item level so only store each once
+		TMap<FName, int32> ItemNameIndices;
+
+		for (const auto& Config : LevelUnlocks)
+		{
+			PlayerLevels.Add({ Unlocks.Num(), Config.AvailableUnlocks.Num(), Config.MaxUnlockOptions });
+
+			for (const auto& Unlock : Config.AvailableUnlocks)
+			{
+				int32 ItemNameIndex;
+				if (const auto ExistingIndex = ItemNameIndices.Find(Unlock.ItemName); ExistingIndex)
+				{
+					ItemNameIndex = *ExistingIndex;
+				}
+				else
+				{
+					ItemNameIndex = OutRecords.ItemNames.Add(Unlock.ItemName);
+					ItemNameIndices.Add(Unlock.ItemName, ItemNameIndex);
+				}
+
+				Unlocks.Add({ OutRecords.Descriptions.Add(Unlock.Description), ItemNameIndex, Unlock.Level });
+			}
+		}
+
+		const FBakedHeader Header
+		{
+			.Magic = BakedDataMagic,
+			.Version = BakedDataVersion,
+			.SpawnerRowCount = SpawnerRows.Num(),
+			.PlayerLevelCount = PlayerLevels.Num(),
+			.UnlockCount = Unlocks.Num(),
+			.XPLevelCount = XPLevels.Num()
+		};
+
+		auto& Blob = OutRecords.Blob;
+
+		Blob.Reset();
+		Blob.Append(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+		AppendRecords(Blob, SpawnerRows);
+		AppendRecords(Blob, PlayerLevels);
+		AppendRecords(Blob, Unlocks);
+		AppendRecords(Blob, XPLevels);
+	}
+}
+
+void URampageBakedData::Bake()
+{
+	// Bake from the parsed form so that the baked data has exactly the same meaning as the parsed tables
+	const auto SpawnerData = ParseEnemySpawnerData();
+	const auto LevelUnlocks = ParseLevelUnlocks();
+	const auto XPLevels = ParseXPLevelRequirements();
+
+	// Views of the saved blob are about to be invalidated
+	if (LoadedRecords == &BakedRecords)
+	{
+		LoadedRecords = {};
+		LoadedView = {};
+	}
+
+	TArray<FText> Errors;
+	if (!ValidateSourceData(SpawnerData, LevelUnlocks, XPLevels, Errors))
+	{
+		for (const auto& Error : Errors)
+		{
+			UE_LOG(LogTankRampage, Error, TEXT("%s: Bake - %s"), *GetName(), *Error.ToString());
+		}
+
+		// Cooked builds fall back to parsing the data tables at load rather than use stale data
+		BakedRecords = {};
+
+		return;
+	}
+
+	BakeRecords(SpawnerData, LevelUnlocks, XPLevels, BakedRecords);
+
+	FBakedView View;
+	GetBakedView(BakedRecords, View);
+
+	UE_LOG(LogTankRampage, Log, TEXT("%s: Bake - SpawnerRows=%d; PlayerLevels=%d; Unlocks=%d; ItemNames=%d; XPLevels=%d; BlobSize=%d bytes"),
+		*GetName(), View.SpawnerRows.Num(), View.PlayerLevels.Num(), View.Unlocks.Num(), BakedRecords.ItemNames.Num(), View.XPLevels.Num(), BakedRecords.Blob.Num());
+}
+
+void URampageBakedData::BakeSourceTables(FRampageBakedRecords& OutRecords) const
+{
+	BakeRecords(ParseEnemySpawnerData(), ParseLevelUnlocks(), ParseXPLevelRequirements(), OutRecords);
+}
+
+void URampageBakedData::SetSourceTables(UDataTable* InEnemySpawnerDataTable, UDataTable* InLevelUnlocksDataTable, UDataTable* InLevelUpDataTable)
+{
+	EnemySpawnerDataTable = InEnemySpawnerDataTable;
+	LevelUnlocksDataTable = InLevelUnlocksDataTable;
+	LevelUpDataTable = InLevelUpDataTable;
+}
+
+TArray<FEnemySpawnerData> URampageBakedData::ParseEnemySpawnerData() const
+{
+	return EnemySpawnerDataParser::ReadAll(EnemySpawnerDataTable);
+}
+
+TArray<FLevelUnlocksConfig> URampageBakedData::ParseLevelUnlocks() const
+{
+	return LevelUnlocksParser::ToConfigArray(LevelUnlocksDataTable, LevelUpDataTable);
+}
+
+TArray<int32> URampageBakedData::ParseXPLevelRequirements() const
+{
+	return LevelUnlocksParser::ToXPLevelRequirementsArray(LevelUpDataTable);
+}
+
+void URampageBakedData::PreSave(FObjectPreSaveContext ObjectSaveContext)
+{
+	Super::PreSave(ObjectSaveContext);
+
+	// Also on editor saves so the asset on disk is never behind its tables when it is cooked
+	Bake();
+}
+
+EDataValidationResult URampageBakedData::IsDataValid(FDataValidationContext& Context) const
+{
+	auto Result = CombineDataValidationResults(Super::IsDataValid(Context), EDataValidationResult::Valid);
+
+	TArray<FText> Errors;
+	if (!ValidateSourceData(ParseEnemySpawnerData(), ParseLevelUnlocks(), ParseXPLevelRequirements(), Errors))
+	{
+		for (const auto& Error : Errors)
+		{
+			Context.AddError(Error);
+		}
+
+		Result = EDataValidationResult::Invalid;
+	}
+
+	return Result;
+}
+
+bool URampageBakedData::ValidateSourceData(const TArray<FEnemySpawnerData>& SpawnerData, const TArray<FLevelUnlocksConfig>& LevelUnlocks, const TArray<int32>& XPLevels,
+	TArray<FText>& OutErrors) const
+{
+	const auto InitialErrorCount = OutErrors.Num();
+
+	if (SpawnerData.IsEmpty())
+	{
+		OutErrors.Add(FText::FromString(FString::Printf(TEXT("EnemySpawnerDataTable=%s has no rows"), *LoggingUtils::GetName(EnemySpawnerDataTable))));
+	}
+
+	for (int32 Minute = 0; Minute < SpawnerData.Num(); ++Minute)
+	{
+		const auto& Row = SpawnerData[Minute];
+		if (Row.SpawnCount < 0 || Row.SpawnClusterSize <= 0)
+		{
+			OutErrors.Add(FText::FromString(FString::Printf(TEXT("EnemySpawnerDataTable minute %d has SpawnCount=%d; SpawnClusterSize=%d"),
+				Minute, Row.SpawnCount, Row.SpawnClusterSize)));
+		}
+	}
+
+	if (LevelUnlocks.IsEmpty() || !LevelUnlocks[0])
+	{
+		OutErrors.Add(FText::FromString(FString::Printf(TEXT("LevelUnlocksDataTable=%s has no unlocks for player level 1"), *LoggingUtils::GetName(LevelUnlocksDataTable))));
+	}
+
+	for (int32 Index = 0; Index < LevelUnlocks.Num(); ++Index)
+	{
+		const auto& Config = LevelUnlocks[Index];
+		if (Config.MaxUnlockOptions <= 0)
+		{
+			OutErrors.Add(FText::FromString(FString::Printf(TEXT("LevelUpDataTable player level %d has UnlockChoices=%d"), Index + 1, Config.MaxUnlockOptions)));
+		}
+
+		for (const auto& Unlock : Config.AvailableUnlocks)
+		{
+			if (Unlock.ItemName.IsNone() || Unlock.Level < 1)
+			{
+				OutErrors.Add(FText::FromString(FString::Printf(TEXT("LevelUnlocksDataTable player level %d has ItemName=%s; ItemLevel=%d"),
+					Index + 1, *Unlock.ItemName.ToString(), Unlock.Level)));
+			}
+		}
+	}
+
+	for (int32 Index = 0; Index < XPLevels.Num(); ++Index)
+	{
+		if (XPLevels[Index] <= 0 || (Index > 0 && XPLevels[Index] <= XPLevels[Index - 1]))
+		{
+			OutErrors.Add(FText::FromString(FString::Printf(TEXT("LevelUpDataTable row %d has XP=%d which is not positive and increasing"), Index, XPLevels[Index])));
+		}
+	}
+
+	return OutErrors.Num() == InitialErrorCount;
+}
+
+#endif
+
+#pragma region Verification
+
+#if WITH_EDITOR
+
+namespace
+{
+	bool AreEquivalent(const FRampageSpawnerRecord& Baked, const FEnemySpawnerData& Parsed)
+	{
+		return Baked.SpawnCount == Parsed.SpawnCount && Baked.SpawnClusterSize == Parsed.SpawnClusterSize;
+	}
+
+	bool AreEquivalent(const FLevelUnlocksConfig& Baked, const FLevelUnlocksConfig& Parsed)
+	{
+		if (Baked.MaxUnlockOptions != Parsed.MaxUnlockOptions || Baked.AvailableUnlocks.Num() != Parsed.AvailableUnlocks.Num())
+		{
+			return false;
+		}
+
+		for (int32 i = 0; i < Baked.AvailableUnlocks.Num(); ++i)
+		{
+			const auto& BakedUnlock = Baked.AvailableUnlocks[i];
+			const auto& ParsedUnlock = Parsed.AvailableUnlocks[i];
+
+			// FLevelUnlock equality ignores the description
+			if (BakedUnlock != ParsedUnlock || !BakedUnlock.Description.EqualTo(ParsedUnlock.Description))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool AreEquivalent(int32 Baked, int32 Parsed)
+	{
+		return Baked == Parsed;
+	}
+
+	template<typename TBaked, typename TParsed>
+	int32 CountMismatches(const TCHAR* Label, const URampageBakedData& BakedData, TConstArrayView<TBaked> Baked, const TArray<TParsed>& Parsed)
+	{
+		if (Baked.Num() != Parsed.Num())
+		{
+			UE_LOG(LogTankRampage, Error, TEXT("%s: CountMismatchesWithSource - %s baked count=%d; parsed count=%d"),
+				*BakedData.GetName(), Label, Baked.Num(), Parsed.Num());
+			return 1;
+		}
+
+		int32 Mismatches{};
+
+		for (int32 i = 0; i < Baked.Num(); ++i)
+		{
+			if (!AreEquivalent(Baked[i], Parsed[i]))
+			{
+				++Mismatches;
+				UE_LOG(LogTankRampage, Error, TEXT("%s: CountMismatchesWithSource - %s differ at index %d"), *BakedData.GetName(), Label, i);
+			}
+		}
+
+		return Mismatches;
+	}
+}
+
+int32 URampageBakedData::CountMismatchesWithSource() const
+{
+	FBakedView View;
+	if (!GetBakedView(BakedRecords, View))
+	{
+		UE_LOG(LogTankRampage, Error, TEXT("%s: CountMismatchesWithSource - No valid baked data"), *GetName());
+		return INDEX_NONE;
+	}
+
+	TArray<FLevelUnlocksConfig> BakedLevelUnlocks;
+	BakedLevelUnlocks.Reserve(View.PlayerLevels.Num());
+
+	for (const auto& PlayerLevel : View.PlayerLevels)
+	{
+		auto& Config = BakedLevelUnlocks.Add_GetRef(FLevelUnlocksConfig
+		{
+			.MaxUnlockOptions = PlayerLevel.MaxUnlockOptions
+		});
+
+		for (const auto& Unlock : View.Unlocks.Slice(PlayerLevel.FirstUnlockIndex, PlayerLevel.UnlockCount))
+		{
+			Config.AvailableUnlocks.Add(FLevelUnlock
+			{
+				.Description = BakedRecords.Descriptions[Unlock.DescriptionIndex],
+				.ItemName = BakedRecords.ItemNames[Unlock.ItemNameIndex],
+				.Level = Unlock.ItemLevel
+			});
+		}
+	}
+
+	return CountMismatches(TEXT("SpawnerData"), *this, View.SpawnerRows, ParseEnemySpawnerData())
+		+ CountMismatches(TEXT("LevelUnlocks"), *this, TConstArrayView<FLevelUnlocksConfig>(BakedLevelUnlocks), ParseLevelUnlocks())
+		+ CountMismatches(TEXT("XPLevels"), *this, View.XPLevels, ParseXPLevelRequirements());
+}
+
+#if TR_DEBUG_ENABLED
+
+namespace
+{
+	/*
+	* Checks that the saved blob of each loaded rampage baked data asset reads back as the same spawner data, level unlocks and xp levels as parsing
+	* its data tables. The asset is rebaked first with <c>rebake</c>.
+	*/
+	void RunRampageBakedDataVerification(const TArray<FString>& Args)
+	{
+		const bool bRebake = Args.Contains(TEXT("rebake"));
+
+		int32 AssetCount{};
+		int32 Failures{};
+
+		for (TObjectIterator<URampageBakedData> It; It; ++It)
+		{
+			auto BakedData = *It;
+			if (BakedData->HasAnyFlags(RF_ClassDefaultObject))
+			{
+				continue;
+			}
+
+			++AssetCount;
+
+			if (bRebake)
+			{
+				BakedData->Bake();
+			}
+
+			const auto Mismatches = BakedData->CountMismatchesWithSource();
+			Failures += Mismatches == INDEX_NONE ? 1 : Mismatches;
+		}
+
+		UE_LOG(LogTankRampage, Display, TEXT("RunRampageBakedDataVerification: %s - Assets=%d; Failures=%d; Rebake=%s"),
+			Failures == 0 ? TEXT("PASSED") : TEXT("FAILED"), AssetCount, Failures, LoggingUtils::GetBoolString(bRebake));
+	}
+
+	FAutoConsoleCommandWithArgs RampageBakedDataVerifyCommand(
+		TEXT("tr.rampage.bakedData.verify"),
+		TEXT("Checks that baked rampage data reads back as the same values as parsing its data tables for each loaded asset: [rebake]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunRampageBakedDataVerification));
+}
+
+#endif
+
+#endif
+
+#pragma endregion Verification
@@ -0,0 +1,178 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+
+#include "EnemySpawnerData.h"
+#include "LevelUnlocksContext.h"
+
+#include "RampageBakedData.generated.h"
+
+class UDataTable;
+
+/* Row index is the minute. */
+struct FRampageSpawnerRecord
+{
+	int32 SpawnCount;
+	int32 SpawnClusterSize;
+};
+
+/* Row index is the player level - 1. Unlocks of the level are the range of unlock records starting at FirstUnlockIndex. */
+struct FRampagePlayerLevelRecord
+{
+	int32 FirstUnlockIndex;
+	int32 UnlockCount;
+	int32 MaxUnlockOptions;
+};
+
+struct FRampageUnlockRecord
+{
+	int32 DescriptionIndex;
+	int32 ItemNameIndex;
+	int32 ItemLevel;
+};
+
+/*
+* Fixed size records flattened into a blob along with the text and names they reference by index.
+*/
+USTRUCT()
+struct FRampageBakedRecords
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Category = "Baked", VisibleAnywhere)
+	TArray<uint8> Blob{};
+
+	UPROPERTY(Category = "Baked", VisibleAnywhere)
+	TArray<FText> Descriptions{};
+
+	UPROPERTY(Category = "Baked", VisibleAnywhere)
+	TArray<FName> ItemNames{};
+};
+
+/**
+ * Enemy spawner, level unlock and level up tables validated and flattened into a compact binary blob when the asset is saved or cooked.
+ * Records are read in place through views over the blob rather than copied out. The source tables are editor only so cooked builds never load them;
+ * without a valid blob the users of the asset parse their own data tables instead.
+ *
+ * Source tables can be edited without a rebake in the editor so there <c>LoadRecords</c> bakes them into a transient blob instead of trusting the saved one.
+ */
+UCLASS()
+class URampageBakedData : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/*
+	* Maps the views onto the saved blob or in the editor onto a fresh transient bake of the source tables. Must be called before reading records.
+	* Views are invalidated by the next call so read them when needed rather than keeping them.
+	* Returns false if there is no valid blob to read, in which case the caller parses its data tables instead.
+	*/
+	bool LoadRecords();
+
+	TConstArrayView<FRampageSpawnerRecord> GetSpawnerRecords() const;
+	TConstArrayView<FRampagePlayerLevelRecord> GetPlayerLevelRecords() const;
+	TConstArrayView<FRampageUnlockRecord> GetUnlockRecords() const;
+	TConstArrayView<int32> GetXPLevelRequirements() const;
+
+	FLevelUnlock GetLevelUnlock(const FRampageUnlockRecord& Record) const;
+
+	/*
+	* Copies out the unlocks of a single player level. Index is the player level - 1.
+	*/
+	FLevelUnlocksConfig GetLevelUnlocksConfig(int32 Index) const;
+
+	/*
+	* Returns true if the saved blob was baked with the current layout version and is consistent.
+	*/
+	bool HasValidBakedData() const;
+
+	bool IsUsingBakedData() const;
+
+#if WITH_EDITOR
+	/*
+	* Validates the source tables and rebakes the saved blob. Done automatically on save and cook.
+	*/
+	UFUNCTION(CallInEditor, Category = "Baking")
+	void Bake();
+
+	/*
+	* Compares the saved blob against parsing the source tables and logs each difference. Returns the number of differences or INDEX_NONE if there is no valid blob.
+	*/
+	int32 CountMismatchesWithSource() const;
+
+	void SetSourceTables(UDataTable* InEnemySpawnerDataTable, UDataTable* InLevelUnlocksDataTable, UDataTable* InLevelUpDataTable);
+
+	virtual void PreSave(FObjectPreSaveContext ObjectSaveContext) override;
+	virtual EDataValidationResult IsDataValid(class FDataValidationContext& Context) const override;
+#endif
+
+private:
+	struct FBakedView
+	{
+		TConstArrayView<FRampageSpawnerRecord> SpawnerRows;
+		TConstArrayView<FRampagePlayerLevelRecord> PlayerLevels;
+		TConstArrayView<FRampageUnlockRecord> Unlocks;
+		TConstArrayView<int32> XPLevels;
+	};
+
+	static bool GetBakedView(const FRampageBakedRecords& Records, FBakedView& OutView);
+
+#if WITH_EDITOR
+	TArray<FEnemySpawnerData> ParseEnemySpawnerData() const;
+	TArray<FLevelUnlocksConfig> ParseLevelUnlocks() const;
+	TArray<int32> ParseXPLevelRequirements() const;
+
+	void BakeSourceTables(FRampageBakedRecords& OutRecords) const;
+
+	bool ValidateSourceData(const TArray<FEnemySpawnerData>& SpawnerData, const TArray<FLevelUnlocksConfig>& LevelUnlocks, const TArray<int32>& XPLevels,
+		TArray<FText>& OutErrors) const;
+#endif
+
+private:
+#if WITH_EDITORONLY_DATA
+	UPROPERTY(Category = "Source", EditDefaultsOnly)
+	TObjectPtr<UDataTable> EnemySpawnerDataTable{};
+
+	UPROPERTY(Category = "Source", EditDefaultsOnly)
+	TObjectPtr<UDataTable> LevelUnlocksDataTable{};
+
+	UPROPERTY(Category = "Source", EditDefaultsOnly)
+	TObjectPtr<UDataTable> LevelUpDataTable{};
+
+	UPROPERTY(Transient)
+	FRampageBakedRecords TransientRecords{};
+#endif
+
+	UPROPERTY(Category = "Baked", VisibleAnywhere)
+	FRampageBakedRecords BakedRecords{};
+
+	const FRampageBakedRecords* LoadedRecords{};
+	FBakedView LoadedView{};
+};
+
+#pragma region Inline Definitions
+
+inline TConstArrayView<FRampageSpawnerRecord> URampageBakedData::GetSpawnerRecords() const
+{
+	return LoadedView.SpawnerRows;
+}
+
+inline TConstArrayView<FRampagePlayerLevelRecord> URampageBakedData::GetPlayerLevelRecords() const
+{
+	return LoadedView.PlayerLevels;
+}
+
+inline TConstArrayView<FRampageUnlockRecord> URampageBakedData::GetUnlockRecords() const
+{
+	return LoadedView.Unlocks;
+}
+
+inline TConstArrayView<int32> URampageBakedData::GetXPLevelRequirements() const
+{
+	return LoadedView.XPLevels;
+}
+
+#pragma endregion Inline Definitions
@@ -17,6 +17,7 @@
 #include "XPSubsystem.h"
 
 #include "LevelUnlocksData.h"
+#include "RampageBakedData.h"
 
 #include "Logging/LoggingUtils.h"
 #include "VisualLogger/VisualLogger.h"
@@ -56,14 +57,29 @@ void ARampageGameMode::PostInitializeComponents()
 {
 	Super::PostInitializeComponents();
 
-	XPLevels = LevelUnlocksParser::ToXPLevelRequirementsArray(LevelUpDataTable);
+	// Baked records are read in place so the tables are only loaded without them
+	bUsingBakedData = BakedData && BakedData->LoadRecords();
+
+	if (!bUsingBakedData)
+	{
+		XPLevels = LevelUnlocksParser::ToXPLevelRequirementsArray(LevelUpDataTable.LoadSynchronous());
+	}
+
 	if (ensure(LevelUnlocksComponent))
 	{
-		LevelUnlocksComponent->SetLevelUnlocks(LevelUnlocksParser::ToConfigArray(LevelUnlocksDataTable, LevelUpDataTable));
+		if (bUsingBakedData)
+		{
+			LevelUnlocksComponent->SetBakedData(BakedData);
+		}
+		else
+		{
+			LevelUnlocksComponent->SetLevelUnlocks(LevelUnlocksParser::ToConfigArray(LevelUnlocksDataTable.LoadSynchronous(), LevelUpDataTable.LoadSynchronous()));
+		}
 	}
 
 	if (ensure(EnemySpawnerComponent))
 	{
+		EnemySpawnerComponent->SetBakedData(bUsingBakedData ? BakedData : nullptr);
 		EnemySpawnerComponent->OnSpawnerStateChange.AddUObject(this, &ThisClass::OnSpawningStateChanged);
 	}
 }
@@ -94,11 +110,13 @@ void ARampageGameMode::AddXP(APawn* PlayerPawn, int32 XP)
 	{
 		++RampageGameState->Level;
 
+		const auto XPLevelRequirements = GetXPLevels();
+
 		int32 NextLevelXP;
 
-		if (RampageGameState->Level < XPLevels.Num())
+		if (RampageGameState->Level < XPLevelRequirements.Num())
 		{
-			NextLevelXP = XPLevels[RampageGameState->Level];
+			NextLevelXP = XPLevelRequirements[RampageGameState->Level];
 		}
 		else
 		{
@@ -106,7 +124,7 @@ void ARampageGameMode::AddXP(APawn* PlayerPawn, int32 XP)
 			NextLevelXP = RampageGameState->LevelUpXP + PreviousLevelDiff;
 
 			UE_VLOG_UELOG(this, LogTankRampage, Display, TEXT("%s: New Level=%d over max configured XP levels=%d - clamping next level xp by last diff=%d to %d"),
-				*GetName(), RampageGameState->Level + 1, XPLevels.Num(), PreviousLevelDiff, NextLevelXP);
+				*GetName(), RampageGameState->Level + 1, XPLevelRequirements.Num(), PreviousLevelDiff, NextLevelXP);
 		}
 
 		RampageGameState->PreviousLevelXP = RampageGameState->LevelUpXP;
@@ -139,6 +157,28 @@ void ARampageGameMode::AddXP(APawn* PlayerPawn, int32 XP)
 			XPSubsystem->OnXPLevelUp.Broadcast(RampageGameState->Level);
 		}
 	}
+
+	if (AppliedXP != 0)
+	{
+		BroadcastXPChanged();
+	}
+}
+
+void ARampageGameMode::BroadcastXPChanged() const
+{
+	auto RampageGameState = GetGameState<ARampageGameState>();
+	if (!ensure(RampageGameState))
+	{
+		return;
+	}
+
+	auto World = GetWorld();
+	check(World);
+
+	if (auto XPSubsystem = World->GetSubsystem<UXPSubsystem>(); ensure(XPSubsystem))
+	{
+		XPSubsystem->OnXPChanged.Broadcast(RampageGameState->TotalXP, RampageGameState->Level, RampageGameState->GetLevelPercent());
+	}
 }
 
 void ARampageGameMode::InitializeGameState()
@@ -149,17 +189,19 @@ void ARampageGameMode::InitializeGameState()
 		return;
 	}
 
-	if (XPLevels.IsEmpty())
+	if (const auto XPLevelRequirements = GetXPLevels(); XPLevelRequirements.IsEmpty())
 	{
 		UE_LOG(LogTankRampage, Error, TEXT("%s: No XP Levels set - No progression will happen!"), *GetName());
 		RampageGameState->LevelUpXP = std::numeric_limits<int32>::max();
 	}
 	else
 	{
-		RampageGameState->LevelUpXP = XPLevels[0];
+		RampageGameState->LevelUpXP = XPLevelRequirements[0];
 	}
 
 	RampageGameState->FirstEnemySpawnTime = EnemySpawnerComponent->GetEarliestSpawningGameTimeSeconds();
+
+	BroadcastXPChanged();
 }
 
 void ARampageGameMode::RegisterEvents()
@@ -174,6 +216,11 @@ void ARampageGameMode::RegisterEvents()
 	}
 }
 
+TConstArrayView<int32> ARampageGameMode::GetXPLevels() const
+{
+	return bUsingBakedData ? BakedData->GetXPLevelRequirements() : TConstArrayView<int32>(XPLevels);
+}
+
 void ARampageGameMode::OnTankDestroyed(ABaseTankPawn* DestroyedTank, AController* DestroyedBy, AActor* DestroyedWith)
 {
 	check(DestroyedTank);
@@ -13,6 +13,7 @@ class UXPCollectionComponent;
 class ULevelUnlocksComponent;
 class UEnemySpawnerComponent;
 class ULootDropComponent;
+class URampageBakedData;
 
 class ABaseTank;
 
@@ -39,6 +40,9 @@ private:
 
 	void InitializeGameState();
 	void RegisterEvents();
+	void BroadcastXPChanged() const;
+
+	TConstArrayView<int32> GetXPLevels() const;
 
 	UFUNCTION()
 	void OnTankDestroyed(ABaseTankPawn* DestroyedTank, AController* DestroyedBy, AActor* DestroyedWith);
@@ -65,11 +69,23 @@ private:
 	UPROPERTY(Category = "XP", EditDefaultsOnly)
 	int32 TokenXPAmount{ 1 };
 
+	/* Parsed from LevelUpDataTable when the baked data is not used. */
 	TArray<int32> XPLevels{};
 
+	/* Only loaded when the baked data is not used. */
 	UPROPERTY(Category = "XP", EditDefaultsOnly)
-	TObjectPtr<UDataTable> LevelUpDataTable{};
+	TSoftObjectPtr<UDataTable> LevelUpDataTable{};
 
+	/* Only loaded when the baked data is not used. */
 	UPROPERTY(Category = "XP", EditDefaultsOnly)
-	TObjectPtr<UDataTable> LevelUnlocksDataTable{};
+	TSoftObjectPtr<UDataTable> LevelUnlocksDataTable{};
+
+	/*
+	* Replaces the data tables above and the enemy spawner data table when set and its records load. The tables are still parsed when it is not set
+	* or a cooked build has no valid baked blob, e.g. it was not rebaked after a layout change.
+	*/
+	UPROPERTY(Category = "Data", EditDefaultsOnly)
+	TObjectPtr<URampageBakedData> BakedData{};
+
+	bool bUsingBakedData{};
 };
@@ -5,14 +5,13 @@
 
 #include "Subsystems/TankEventsSubsystem.h"
 #include "Pickup/XPToken.h"
+#include "Pickup/PickupPoolSubsystem.h"
 #include "Pawn/BaseTankPawn.h"
 
 #include "Logging/LoggingUtils.h"
 #include "VisualLogger/VisualLogger.h"
 #include "TankRampageLogging.h"
 
-#include "Utils/CollisionUtils.h"
-
 #include UE_INLINE_GENERATED_CPP_BY_NAME(XPSpawnerComponent)
 
 UXPSpawnerComponent::UXPSpawnerComponent()
@@ -53,52 +52,6 @@ void UXPSpawnerComponent::OnTankDestroyed(ABaseTankPawn* DestroyedTank, AControl
 	SpawnToken(DestroyedTank->GetActorLocation(), *DestroyedBy);
 }
 
-FVector UXPSpawnerComponent::GetSpawnLocation(const FVector& BaseLocation) const
-{
-	auto World = GetWorld();
-	check(World);
-
-	// Spawn at ground
-
-	const auto OffsetZ = [&]()
-	{
-		check(XPTokenClass);
-		auto CDO = Cast<ABasePickup>(XPTokenClass->GetDefaultObject());
-
-		if (!ensureMsgf(CDO, TEXT("XPTokenClass=%s has no CDO!"), *XPTokenClass->GetName()))
-		{
-			return decltype(CDO->GetSpawnOffsetZ()){};
-		}
-
-		return CDO->GetSpawnOffsetZ();
-	}();
-
-	FHitResult HitResult;
-
-	if (World->LineTraceSingleByObjectType(
-		HitResult,
-		BaseLocation + FVector(0, 0, 100),
-		BaseLocation - FVector(0, 0, 1000),
-		TR::CollisionChannel::GroundObjectType
-	))
-	{
-		UE_VLOG_UELOG(GetOwner(), LogTankRampage, Log, TEXT("%s: SpawnToken - Collided with %s owned by %s - adjusting location from %s to %s"),
-			*GetName(), 
-			*LoggingUtils::GetName(HitResult.Component.Get()),
-			*LoggingUtils::GetName(HitResult.GetActor()),
-			*BaseLocation.ToCompactString(), *HitResult.Location.ToCompactString());
-
-		return HitResult.Location + FVector(0, 0, OffsetZ);
-	}
-	else
-	{
-		UE_VLOG_UELOG(GetOwner(), LogTankRampage, Warning, TEXT("%s: SpawnToken - Could not find ground to snap token (Is landscape/floor set to 'Ground' profile?); Location=%s"),
-			*GetName(), *BaseLocation.ToCompactString());
-
-		return BaseLocation + FVector(0, 0, OffsetZ);
-	}
-}
-
 void UXPSpawnerComponent::SpawnToken(const FVector& Location, const AController& Owner) const
 {
 	UE_VLOG_UELOG(GetOwner(), LogTankRampage, Log, TEXT("%s: SpawnToken - Location=%s; Owner=%s"),
@@ -107,21 +60,14 @@ void UXPSpawnerComponent::SpawnToken(const FVector& Location, const AController&
 	auto World = GetWorld();
 	check(World);
 
-	FActorSpawnParameters SpawnParameters;
-	SpawnParameters.Instigator = Owner.GetPawn();
-
-	const auto SpawnLocation = GetSpawnLocation(Location);
-
-	auto Token = World->SpawnActor<AXPToken>(XPTokenClass, SpawnLocation, FRotator::ZeroRotator, SpawnParameters);
-	if (Token)
-	{
-		UE_VLOG_UELOG(GetOwner(), LogTankRampage, Log, TEXT("%s: SpawnToken - Spawned token=%s with class=%s at Location=%s"),
-			*GetName(), *Token->GetName(), *LoggingUtils::GetName(XPTokenClass), *SpawnLocation.ToCompactString());
-	}
-	else
+	// Deferred to the end of the frame so that the ground trace and spawn or reuse are not done in the middle of the tank destroyed broadcast
+	if (auto PickupPoolSubsystem = World->GetSubsystem<UPickupPoolSubsystem>(); ensure(PickupPoolSubsystem))
 	{
-		UE_VLOG_UELOG(GetOwner(), LogTankRampage, Warning, TEXT("%s: SpawnToken - Unable to spawn token with class=%s; Location=%s; Owner=%s"),
-			*GetName(), *LoggingUtils::GetName(XPTokenClass), *Location.ToCompactString(), *Owner.GetName());
+		PickupPoolSubsystem->QueueGroundedSpawn(FGroundedPickupSpawn
+		{
+			.PickupClass = XPTokenClass,
+			.Location = Location,
+			.Instigator = Owner.GetPawn()
+		});
 	}
 }
-
@@ -26,8 +26,6 @@ private:
 
 	void SpawnToken(const FVector& Location, const AController& Owner) const;
 
-	FVector GetSpawnLocation(const FVector& BaseLocation) const;
-
 private:
 	UPROPERTY(EditDefaultsOnly, Category = "XP")
 	TSubclassOf<AXPToken> XPTokenClass{};
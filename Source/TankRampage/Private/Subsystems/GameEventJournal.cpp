@@ -0,0 +1,648 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/GameEventJournal.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+
+#include "Logging/LoggingUtils.h"
+#include "TankRampageLogging.h"
+
+#if TR_DEBUG_ENABLED
+	#include "HAL/IConsoleManager.h"
+	#include "Misc/Paths.h"
+	#include "Utils/RandUtils.h"
+#endif
+
+namespace
+{
+	/* Events held for the writer thread. About a minute of a heavy wave at 60 events a second. */
+	constexpr uint32 RingCapacity = 4096;
+
+	/* How often the writer thread wakes up to drain the ring. */
+	constexpr uint32 DrainIntervalMs = 250;
+
+	/* Bytes of one event on disk. */
+	constexpr int64 EventRecordSize = sizeof(float) + sizeof(uint32) * 2 + sizeof(int32) + sizeof(uint16) + sizeof(uint8) * 2;
+}
+
+const TCHAR* LexToString(EGameJournalEventType Type)
+{
+	switch (Type)
+	{
+	case EGameJournalEventType::EnemySpawned: return TEXT("EnemySpawned");
+	case EGameJournalEventType::TankDestroyed: return TEXT("TankDestroyed");
+	case EGameJournalEventType::ItemActivated: return TEXT("ItemActivated");
+	case EGameJournalEventType::XPLevelUp: return TEXT("XPLevelUp");
+	case EGameJournalEventType::LootSpawned: return TEXT("LootSpawned");
+	case EGameJournalEventType::LootPickedUp: return TEXT("LootPickedUp");
+	case EGameJournalEventType::NameDefinition: return TEXT("NameDefinition");
+	default: return TEXT("Unknown");
+	}
+}
+
+FArchive& operator<<(FArchive& Ar, FGameJournalEvent& Event)
+{
+	Ar << Event.TimeSeconds;
+	Ar << Event.SubjectId;
+	Ar << Event.OtherId;
+	Ar << Event.Value;
+	Ar << Event.NameId;
+	Ar << Event.Type;
+	Ar << Event.Flags;
+
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FGameJournalHeader& Header)
+{
+	Ar << Header.Version;
+	Ar << Header.StartTime;
+	Ar << Header.MapName;
+
+	return Ar;
+}
+
+#pragma region FGameJournal
+
+const FString& FGameJournal::GetName(uint16 NameId) const
+{
+	static const FString Empty;
+	return Names.IsValidIndex(NameId) ? Names[NameId] : Empty;
+}
+
+bool FGameJournal::LoadFromFile(const FString& Path, FGameJournal& OutJournal, FString* OutError)
+{
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Path, FILEREAD_AllowWrite));
+	if (!Reader)
+	{
+		if (OutError)
+		{
+			*OutError = FString::Printf(TEXT("Unable to open %s"), *Path);
+		}
+		return false;
+	}
+
+	return Load(*Reader, OutJournal, OutError);
+}
+
+bool FGameJournal::LoadFromMemory(const TArray<uint8>& Data, FGameJournal& OutJournal, FString* OutError)
+{
+	FMemoryReader Reader(Data);
+	return Load(Reader, OutJournal, OutError);
+}
+
+bool FGameJournal::Load(FArchive& Ar, FGameJournal& OutJournal, FString* OutError)
+{
+	OutJournal = {};
+
+	auto Fail = [OutError](const FString& Error)
+	{
+		if (OutError)
+		{
+			*OutError = Error;
+		}
+		return false;
+	};
+
+	uint32 Magic{};
+	Ar << Magic;
+
+	if (Ar.IsError() || Magic != FGameJournalHeader::Magic)
+	{
+		return Fail(TEXT("Not a game event journal"));
+	}
+
+	Ar << OutJournal.Header;
+
+	if (Ar.IsError())
+	{
+		return Fail(TEXT("Truncated header"));
+	}
+
+	if (OutJournal.Header.Version > FGameJournalHeader::CurrentVersion)
+	{
+		return Fail(FString::Printf(TEXT("Journal version %u is newer than %u"), OutJournal.Header.Version, FGameJournalHeader::CurrentVersion));
+	}
+
+	const auto TotalSize = Ar.TotalSize();
+
+	while (TotalSize - Ar.Tell() >= EventRecordSize)
+	{
+		FGameJournalEvent Event;
+		Ar << Event;
+
+		if (Event.Type != EGameJournalEventType::NameDefinition)
+		{
+			OutJournal.Events.Add(Event);
+			continue;
+		}
+
+		// Name bytes follow the record
+		const auto ByteCount = Event.Value;
+		if (ByteCount < 0 || TotalSize - Ar.Tell() < ByteCount)
+		{
+			break;
+		}
+
+		TArray<UTF8CHAR> Utf8;
+		Utf8.SetNumUninitialized(ByteCount);
+		Ar.Serialize(Utf8.GetData(), ByteCount);
+
+		if (OutJournal.Names.Num() <= Event.NameId)
+		{
+			OutJournal.Names.SetNum(Event.NameId + 1);
+		}
+		OutJournal.Names[Event.NameId] = FString(ByteCount, Utf8.GetData());
+	}
+
+	return true;
+}
+
+#pragma endregion FGameJournal
+
+#pragma region FGameJournalSummary
+
+FGameJournalSummary FGameJournalSummary::Analyze(const FGameJournal& Journal)
+{
+	FGameJournalSummary Summary;
+
+	TMap<FString, int32> ItemKills;
+
+	int32 Alive{};
+	int32 Level{};
+
+	auto GetMinute = [&Summary, &Alive, &Level](float TimeSeconds) -> FMinute&
+	{
+		const auto Index = FMath::Max(0, FMath::FloorToInt32(TimeSeconds / 60));
+
+		// Minutes without events carry over the alive count and level
+		while (Summary.Minutes.Num() <= Index)
+		{
+			auto& Minute = Summary.Minutes.AddDefaulted_GetRef();
+			Minute.PeakAlive = Alive;
+			Minute.Level = Level;
+		}
+
+		return Summary.Minutes[Index];
+	};
+
+	for (const auto& Event : Journal.Events)
+	{
+		auto& Minute = GetMinute(Event.TimeSeconds);
+
+		switch (Event.Type)
+		{
+		case EGameJournalEventType::EnemySpawned:
+			++Minute.Spawns;
+			++Summary.TotalSpawns;
+			++Alive;
+			break;
+		case EGameJournalEventType::TankDestroyed:
+			if (EnumHasAnyFlags(Event.Flags, EGameJournalEventFlags::Player))
+			{
+				Summary.bPlayerDestroyed = true;
+				break;
+			}
+
+			Alive = FMath::Max(0, Alive - 1);
+
+			if (EnumHasAnyFlags(Event.Flags, EGameJournalEventFlags::ByPlayer))
+			{
+				++Minute.Kills;
+				++Summary.TotalKills;
+
+				const auto& ItemName = Journal.GetName(Event.NameId);
+				++ItemKills.FindOrAdd(ItemName.IsEmpty() ? TEXT("Unattributed") : ItemName);
+			}
+			break;
+		case EGameJournalEventType::ItemActivated:
+			++Minute.ItemActivations;
+			break;
+		case EGameJournalEventType::XPLevelUp:
+			Level = Event.Value;
+			Minute.Level = Level;
+			break;
+		case EGameJournalEventType::LootSpawned:
+			++Minute.LootSpawned;
+			break;
+		case EGameJournalEventType::LootPickedUp:
+			++Minute.LootPickedUp;
+			break;
+		default:
+			break;
+		}
+
+		Minute.PeakAlive = FMath::Max(Minute.PeakAlive, Alive);
+		Summary.DurationSeconds = FMath::Max(Summary.DurationSeconds, Event.TimeSeconds);
+	}
+
+	Summary.ItemKills = ItemKills.Array();
+	Summary.ItemKills.Sort([](const auto& First, const auto& Second)
+	{
+		return First.Value > Second.Value;
+	});
+
+	return Summary;
+}
+
+void FGameJournalSummary::Log(const FGameJournal& Journal) const
+{
+	UE_LOG(LogTankRampage, Display, TEXT("Journal: Map=%s; Started=%s; Version=%u; Events=%d; Names=%d; Duration=%.1fs; Kills=%d; Spawns=%d; PlayerDestroyed=%s"),
+		*Journal.Header.MapName, *Journal.Header.StartTime.ToString(), Journal.Header.Version, Journal.Events.Num(), Journal.Names.Num(),
+		DurationSeconds, TotalKills, TotalSpawns, LoggingUtils::GetBoolString(bPlayerDestroyed));
+
+	UE_LOG(LogTankRampage, Display, TEXT("%6s %8s %8s %10s %10s %8s %8s %6s"),
+		TEXT("Minute"), TEXT("Kills"), TEXT("Spawns"), TEXT("PeakAlive"), TEXT("ItemUses"), TEXT("Loot"), TEXT("Pickups"), TEXT("Level"));
+
+	for (int32 i = 0; i < Minutes.Num(); ++i)
+	{
+		const auto& Minute = Minutes[i];
+
+		UE_LOG(LogTankRampage, Display, TEXT("%6d %8d %8d %10d %10d %8d %8d %6d"),
+			i, Minute.Kills, Minute.Spawns, Minute.PeakAlive, Minute.ItemActivations, Minute.LootSpawned, Minute.LootPickedUp, Minute.Level);
+	}
+
+	for (const auto& [ItemName, Kills] : ItemKills)
+	{
+		UE_LOG(LogTankRampage, Display, TEXT("Item %s: Kills=%d (%.1f%%)"), *ItemName, Kills, TotalKills > 0 ? 100.0f * Kills / TotalKills : 0.0f);
+	}
+}
+
+#pragma endregion FGameJournalSummary
+
+#pragma region FGameEventJournalWriter
+
+FGameEventJournalWriter::FGameEventJournalWriter() : Ring(RingCapacity)
+{
+}
+
+FGameEventJournalWriter::~FGameEventJournalWriter()
+{
+	Close();
+}
+
+bool FGameEventJournalWriter::Open(const FString& InPath, const FGameJournalHeader& Header)
+{
+	check(!IsOpen());
+
+	FileWriter.Reset(IFileManager::Get().CreateFileWriter(*InPath, FILEWRITE_AllowRead));
+	if (!FileWriter)
+	{
+		UE_LOG(LogTankRampage, Error, TEXT("FGameEventJournalWriter: Unable to create %s"), *InPath);
+		return false;
+	}
+
+	Path = InPath;
+
+	auto Magic = FGameJournalHeader::Magic;
+	auto HeaderCopy = Header;
+
+	*FileWriter << Magic;
+	*FileWriter << HeaderCopy;
+
+	bStopping = false;
+	WakeEvent = FPlatformProcess::GetSynchEventFromPool();
+	Thread = FRunnableThread::Create(this, TEXT("GameEventJournalWriter"), 0, TPri_BelowNormal);
+
+	if (!Thread)
+	{
+		UE_LOG(LogTankRampage, Error, TEXT("FGameEventJournalWriter: Unable to create writer thread for %s"), *InPath);
+
+		FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+		WakeEvent = nullptr;
+		FileWriter.Reset();
+
+		return false;
+	}
+
+	UE_LOG(LogTankRampage, Log, TEXT("FGameEventJournalWriter: Recording to %s"), *Path);
+
+	return true;
+}
+
+void FGameEventJournalWriter::Close()
+{
+	if (!Thread)
+	{
+		return;
+	}
+
+	// Run drains whatever is left before returning
+	Thread->Kill(true);
+	delete Thread;
+	Thread = nullptr;
+
+	FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+	WakeEvent = nullptr;
+
+	FileWriter->Close();
+	FileWriter.Reset();
+
+	UE_LOG(LogTankRampage, Log, TEXT("FGameEventJournalWriter: Closed %s - Recorded=%d; Dropped=%d; Names=%d"),
+		*Path, RecordedCount, DroppedCount, NameIds.Num());
+}
+
+void FGameEventJournalWriter::Record(const FGameJournalEvent& Event)
+{
+	check(IsInGameThread());
+
+	if (!IsOpen())
+	{
+		return;
+	}
+
+	if (Ring.Push(Event))
+	{
+		++RecordedCount;
+	}
+	else if (DroppedCount++ == 0)
+	{
+		UE_LOG(LogTankRampage, Warning, TEXT("FGameEventJournalWriter: Journal ring full - dropping events until the writer catches up"));
+	}
+}
+
+uint32 FGameEventJournalWriter::GetObjectId(const UObject* Object)
+{
+	if (!Object)
+	{
+		return 0;
+	}
+
+	// Ids start at 1 so that 0 can mean none
+	return ObjectIds.FindOrAdd(FObjectKey(Object), ObjectIds.Num() + 1);
+}
+
+uint16 FGameEventJournalWriter::GetNameId(const FName& Name)
+{
+	check(IsInGameThread());
+
+	if (Name.IsNone())
+	{
+		return FGameJournalEvent::InvalidNameId;
+	}
+
+	if (auto ExistingId = NameIds.Find(Name); ExistingId)
+	{
+		return *ExistingId;
+	}
+
+	if (NameIds.Num() >= FGameJournalEvent::InvalidNameId)
+	{
+		return FGameJournalEvent::InvalidNameId;
+	}
+
+	const auto NameId = static_cast<uint16>(NameIds.Num());
+	NameIds.Add(Name, NameId);
+
+	PendingNames.Enqueue({ NameId, Name.ToString() });
+
+	return NameId;
+}
+
+uint32 FGameEventJournalWriter::Run()
+{
+	while (!bStopping)
+	{
+		WakeEvent->Wait(DrainIntervalMs);
+		Drain();
+	}
+
+	// Pick up anything recorded between the last drain and the stop
+	Drain();
+
+	return 0;
+}
+
+void FGameEventJournalWriter::Stop()
+{
+	bStopping = true;
+
+	if (WakeEvent)
+	{
+		WakeEvent->Trigger();
+	}
+}
+
+void FGameEventJournalWriter::Drain()
+{
+	check(FileWriter);
+
+	// Names before events so that a journal cut short still has the names of the events written
+	TPair<uint16, FString> PendingName;
+	while (PendingNames.Dequeue(PendingName))
+	{
+		FTCHARToUTF8 Utf8(*PendingName.Value);
+		TArray<uint8> Bytes(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+
+		FGameJournalEvent Definition
+		{
+			.Value = Bytes.Num(),
+			.NameId = PendingName.Key,
+			.Type = EGameJournalEventType::NameDefinition
+		};
+
+		*FileWriter << Definition;
+		FileWriter->Serialize(Bytes.GetData(), Bytes.Num());
+	}
+
+	DrainBuffer.Reset();
+	if (Ring.PopAll(DrainBuffer) == 0)
+	{
+		FileWriter->Flush();
+		return;
+	}
+
+	for (auto& Event : DrainBuffer)
+	{
+		*FileWriter << Event;
+	}
+
+	FileWriter->Flush();
+}
+
+#pragma endregion FGameEventJournalWriter
+
+#pragma region Verification
+
+#if TR_DEBUG_ENABLED
+
+namespace
+{
+	/*
+	* Writes a synthetic run through the journal writer and its thread, reads it back and checks that every event and name survived the round trip
+	* and that the per-minute analysis matches counts kept while generating. Then checks a truncated copy still loads and a corrupted one is rejected.
+	*/
+	void RunGameEventJournalVerification(const TArray<FString>& Args)
+	{
+		const int32 MinuteCount = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 10;
+
+		const auto Path = FPaths::ProjectSavedDir() / TEXT("Journals") / FString::Printf(TEXT("Verify-%s.trjournal"), *FGuid::NewGuid().ToString());
+
+		FRandomStream Rng(RandUtils::GenerateSeed());
+
+		const FName ItemNames[] = { TEXT("MainGun"), TEXT("EMP"), TEXT("MiniNuke"), TEXT("HomingMissile") };
+
+		TArray<FGameJournalEvent> Expected;
+		TArray<int32> ExpectedKills;
+		TArray<int32> ExpectedSpawns;
+
+		int32 Failures{};
+
+		{
+			FGameEventJournalWriter Writer;
+			if (!Writer.Open(Path, FGameJournalHeader{ .StartTime = FDateTime::UtcNow(), .MapName = TEXT("Verify") }))
+			{
+				UE_LOG(LogTankRampage, Error, TEXT("RunGameEventJournalVerification: FAILED - Unable to open %s"), *Path);
+				return;
+			}
+
+			TArray<uint32> AliveEnemies;
+			uint32 NextActorId = 1;
+			int32 Level = 1;
+
+			const uint32 PlayerId = NextActorId++;
+
+			for (int32 Minute = 0; Minute < MinuteCount; ++Minute)
+			{
+				ExpectedKills.Add(0);
+				ExpectedSpawns.Add(0);
+
+				// Waves get bigger each minute as they do in the game mode
+				const auto EventCount = 20 + Minute * 10;
+
+				for (int32 i = 0; i < EventCount; ++i)
+				{
+					FGameJournalEvent Event
+					{
+						.TimeSeconds = Minute * 60 + 60.0f * i / EventCount
+					};
+
+					const auto Roll = Rng.RandHelper(10);
+					if (Roll < 4 || AliveEnemies.IsEmpty())
+					{
+						Event.Type = EGameJournalEventType::EnemySpawned;
+						Event.SubjectId = NextActorId++;
+						AliveEnemies.Add(Event.SubjectId);
+						++ExpectedSpawns[Minute];
+					}
+					else if (Roll < 7)
+					{
+						Event.Type = EGameJournalEventType::TankDestroyed;
+						Event.SubjectId = AliveEnemies.Pop(false);
+						Event.OtherId = PlayerId;
+						Event.Flags = EGameJournalEventFlags::ByPlayer;
+						Event.NameId = Writer.GetNameId(ItemNames[Rng.RandHelper(UE_ARRAY_COUNT(ItemNames))]);
+						++ExpectedKills[Minute];
+					}
+					else if (Roll < 9)
+					{
+						Event.Type = EGameJournalEventType::ItemActivated;
+						Event.SubjectId = PlayerId;
+						Event.NameId = Writer.GetNameId(ItemNames[Rng.RandHelper(UE_ARRAY_COUNT(ItemNames))]);
+					}
+					else
+					{
+						Event.Type = EGameJournalEventType::XPLevelUp;
+						Event.SubjectId = PlayerId;
+						Event.Value = ++Level;
+					}
+
+					Writer.Record(Event);
+					Expected.Add(Event);
+				}
+
+				// Let the writer thread drain part way through so that names and events interleave in the file
+				if (Minute % 3 == 0)
+				{
+					FPlatformProcess::Sleep(DrainIntervalMs / 1000.0f * 1.5f);
+				}
+			}
+
+			Failures += Writer.NumDropped();
+		}
+
+		FGameJournal Journal;
+		FString Error;
+
+		if (!FGameJournal::LoadFromFile(Path, Journal, &Error))
+		{
+			UE_LOG(LogTankRampage, Error, TEXT("RunGameEventJournalVerification: FAILED - %s"), *Error);
+			return;
+		}
+
+		if (Journal.Events.Num() != Expected.Num())
+		{
+			++Failures;
+			UE_LOG(LogTankRampage, Error, TEXT("RunGameEventJournalVerification: Events=%d; Expected=%d"), Journal.Events.Num(), Expected.Num());
+		}
+
+		for (int32 i = 0; i < FMath::Min(Journal.Events.Num(), Expected.Num()); ++i)
+		{
+			const auto& Actual = Journal.Events[i];
+			const auto& Event = Expected[i];
+
+			if (Actual.Type != Event.Type || Actual.TimeSeconds != Event.TimeSeconds || Actual.SubjectId != Event.SubjectId || Actual.OtherId != Event.OtherId ||
+				Actual.Value != Event.Value || Actual.Flags != Event.Flags || Actual.NameId != Event.NameId)
+			{
+				++Failures;
+				UE_LOG(LogTankRampage, Error, TEXT("RunGameEventJournalVerification: Event %d %s differs from %s"), i, LexToString(Actual.Type), LexToString(Event.Type));
+			}
+			else if (Event.NameId != FGameJournalEvent::InvalidNameId && Journal.GetName(Event.NameId).IsEmpty())
+			{
+				++Failures;
+				UE_LOG(LogTankRampage, Error, TEXT("RunGameEventJournalVerification: Event %d name %d not defined"), i, Event.NameId);
+			}
+		}
+
+		const auto Summary = FGameJournalSummary::Analyze(Journal);
+
+		for (int32 Minute = 0; Minute < FMath::Min(MinuteCount, Summary.Minutes.Num()); ++Minute)
+		{
+			if (Summary.Minutes[Minute].Kills != ExpectedKills[Minute] || Summary.Minutes[Minute].Spawns != ExpectedSpawns[Minute])
+			{
+				++Failures;
+				UE_LOG(LogTankRampage, Error, TEXT("RunGameEventJournalVerification: Minute %d - Kills=%d/%d; Spawns=%d/%d"), Minute,
+					Summary.Minutes[Minute].Kills, ExpectedKills[Minute], Summary.Minutes[Minute].Spawns, ExpectedSpawns[Minute]);
+			}
+		}
+
+		// A crash leaves a partial final record behind
+		TArray<uint8> Bytes;
+		FFileHelper::LoadFileToArray(Bytes, *Path);
+
+		FGameJournal Truncated;
+		Bytes.SetNum(Bytes.Num() - static_cast<int32>(EventRecordSize / 2));
+
+		if (!FGameJournal::LoadFromMemory(Bytes, Truncated) || Truncated.Events.Num() != Expected.Num() - 1)
+		{
+			++Failures;
+			UE_LOG(LogTankRampage, Error, TEXT("RunGameEventJournalVerification: Truncated journal Events=%d; Expected=%d"), Truncated.Events.Num(), Expected.Num() - 1);
+		}
+
+		Bytes[0] ^= 0xFF;
+		if (FGameJournal::LoadFromMemory(Bytes, Truncated))
+		{
+			++Failures;
+			UE_LOG(LogTankRampage, Error, TEXT("RunGameEventJournalVerification: Corrupted magic accepted"));
+		}
+
+		IFileManager::Get().Delete(*Path);
+
+		UE_LOG(LogTankRampage, Display, TEXT("RunGameEventJournalVerification: %s - Minutes=%d; Events=%d; Names=%d; Kills=%d; Spawns=%d; Failures=%d"),
+			Failures == 0 ? TEXT("PASSED") : TEXT("FAILED"), MinuteCount, Journal.Events.Num(), Journal.Names.Num(), Summary.TotalKills, Summary.TotalSpawns, Failures);
+	}
+
+	FAutoConsoleCommandWithArgs GameEventJournalVerifyCommand(
+		TEXT("tr.stats.journal.verify"),
+		TEXT("Round trips a synthetic run through the game event journal writer, reader and analyzer: [Minutes=10]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunGameEventJournalVerification));
+}
+
+#endif
+
+#pragma endregion Verification
@@ -0,0 +1,239 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "HAL/Runnable.h"
+
+#include "Containers/SpscRingBuffer.h"
+
+#include <atomic>
+
+class FRunnableThread;
+class FEvent;
+
+enum class EGameJournalEventType : uint8
+{
+	EnemySpawned,
+	TankDestroyed,
+	ItemActivated,
+	XPLevelUp,
+	LootSpawned,
+	LootPickedUp,
+	MAX,
+
+	/* Name table entry followed by the UTF-8 bytes of the name. Never handed out to readers as an event. */
+	NameDefinition = 0xFF
+};
+
+const TCHAR* LexToString(EGameJournalEventType Type);
+
+enum class EGameJournalEventFlags : uint8
+{
+	None = 0,
+
+	/* TankDestroyed: destroyed by the player. */
+	ByPlayer = 1 << 0,
+
+	/* TankDestroyed: the destroyed tank was the player. */
+	Player = 1 << 1,
+};
+
+ENUM_CLASS_FLAGS(EGameJournalEventFlags);
+
+/**
+ * Fixed size journal record. Actors are identified by a compact id that is unique within one journal with 0 for none and names by an index into the journal name table.
+ */
+struct FGameJournalEvent
+{
+	float TimeSeconds{};
+
+	/* Actor the event is about, e.g. the destroyed tank or the pickup. */
+	uint32 SubjectId{};
+
+	/* Other actor involved, e.g. the tank that destroyed the subject or picked it up. */
+	uint32 OtherId{};
+
+	/* Event specific value, e.g. the new level for XPLevelUp. */
+	int32 Value{};
+
+	/* Item name for TankDestroyed and ItemActivated and pickup class for loot events. */
+	uint16 NameId{ InvalidNameId };
+
+	EGameJournalEventType Type{ EGameJournalEventType::MAX };
+	EGameJournalEventFlags Flags{ EGameJournalEventFlags::None };
+
+	static constexpr uint16 InvalidNameId = TNumericLimits<uint16>::Max();
+
+	friend FArchive& operator<<(FArchive& Ar, FGameJournalEvent& Event);
+};
+
+struct FGameJournalHeader
+{
+	static constexpr uint32 Magic = 0x4A524754; // "TGRJ"
+	static constexpr uint32 CurrentVersion = 1;
+
+	uint32 Version{ CurrentVersion };
+	FDateTime StartTime{};
+	FString MapName{};
+
+	friend FArchive& operator<<(FArchive& Ar, FGameJournalHeader& Header);
+};
+
+/**
+ * Journal read back from disk with name references resolved.
+ */
+struct FGameJournal
+{
+	FGameJournalHeader Header{};
+	TArray<FGameJournalEvent> Events{};
+	TArray<FString> Names{};
+
+	/*
+	* Returns an empty string for <c>InvalidNameId</c> or a name that was never defined, e.g. a journal truncated by a crash.
+	*/
+	const FString& GetName(uint16 NameId) const;
+
+	/*
+	* Reads a journal from a file or memory. Returns false with <c>OutError</c> if the data is not a journal or is a newer version.
+	* A truncated final record is ignored so that the journal of a crashed run can still be read.
+	*/
+	static bool LoadFromFile(const FString& Path, FGameJournal& OutJournal, FString* OutError = nullptr);
+	static bool LoadFromMemory(const TArray<uint8>& Data, FGameJournal& OutJournal, FString* OutError = nullptr);
+
+private:
+	static bool Load(FArchive& Ar, FGameJournal& OutJournal, FString* OutError);
+};
+
+/**
+ * Per-minute breakdown of a journal for finding out why the difficulty or frame time of a run spiked.
+ */
+struct FGameJournalSummary
+{
+	struct FMinute
+	{
+		/* Enemies destroyed by the player. */
+		int32 Kills{};
+		int32 Spawns{};
+
+		/* Most enemies alive at once during the minute. */
+		int32 PeakAlive{};
+
+		int32 ItemActivations{};
+		int32 LootSpawned{};
+		int32 LootPickedUp{};
+
+		/* Player level at the end of the minute. */
+		int32 Level{};
+	};
+
+	TArray<FMinute> Minutes{};
+
+	/* Player kills by item name sorted by count. */
+	TArray<TPair<FString, int32>> ItemKills{};
+
+	int32 TotalKills{};
+	int32 TotalSpawns{};
+	float DurationSeconds{};
+	bool bPlayerDestroyed{};
+
+	static FGameJournalSummary Analyze(const FGameJournal& Journal);
+
+	void Log(const FGameJournal& Journal) const;
+};
+
+/**
+ * Appends events to a journal file without blocking the game thread. Events are pushed into a lock-free ring that a writer thread drains to disk a few times a second.
+ * Recording and id assignment must be done on the game thread. Events are dropped and counted when the writer falls behind and the ring is full.
+ */
+class FGameEventJournalWriter : public FRunnable
+{
+public:
+	FGameEventJournalWriter();
+	virtual ~FGameEventJournalWriter() override;
+
+	/*
+	* Creates the file, writes the header and starts the writer thread. Returns false if the file could not be created.
+	*/
+	bool Open(const FString& InPath, const FGameJournalHeader& Header);
+
+	/*
+	* Writes everything recorded so far and closes the file. Called on destruction.
+	*/
+	void Close();
+
+	bool IsOpen() const;
+	const FString& GetPath() const;
+
+	void Record(const FGameJournalEvent& Event);
+
+	/*
+	* Compact id for the object that is stable for the lifetime of the journal. Returns 0 for null.
+	*/
+	uint32 GetObjectId(const UObject* Object);
+
+	/*
+	* Index of the name in the journal name table, adding it if new.
+	*/
+	uint16 GetNameId(const FName& Name);
+
+	int32 NumRecorded() const;
+	int32 NumDropped() const;
+
+protected:
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	/*
+	* Writer thread only. Writes new names then events.
+	*/
+	void Drain();
+
+private:
+	TR::TSpscRingBuffer<FGameJournalEvent> Ring;
+
+	/* Name table entries not yet written. */
+	TQueue<TPair<uint16, FString>, EQueueMode::Spsc> PendingNames{};
+
+	/* Writer thread only after Open. */
+	TUniquePtr<FArchive> FileWriter{};
+	TArray<FGameJournalEvent> DrainBuffer{};
+
+	FRunnableThread* Thread{};
+	FEvent* WakeEvent{};
+	std::atomic<bool> bStopping{};
+
+	FString Path{};
+
+	/* Game thread only. */
+	TMap<FObjectKey, uint32> ObjectIds{};
+	TMap<FName, uint16> NameIds{};
+	int32 RecordedCount{};
+	int32 DroppedCount{};
+};
+
+#pragma region Inline Definitions
+
+inline bool FGameEventJournalWriter::IsOpen() const
+{
+	return Thread != nullptr;
+}
+
+inline const FString& FGameEventJournalWriter::GetPath() const
+{
+	return Path;
+}
+
+inline int32 FGameEventJournalWriter::NumRecorded() const
+{
+	return RecordedCount;
+}
+
+inline int32 FGameEventJournalWriter::NumDropped() const
+{
+	return DroppedCount;
+}
+
+#pragma endregion Inline Definitions
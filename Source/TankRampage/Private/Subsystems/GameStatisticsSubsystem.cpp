@@ -24,6 +24,14 @@
 #include "AbilitySystem/TRGameplayTags.h"
 #include "GameplayTagContainer.h"
 
+#include "XPSubsystem.h"
+#include "Item/ItemSubsystem.h"
+#include "Pickup/BasePickup.h"
+
+#include "Debug/TRConsoleVars.h"
+
+#include "Misc/Paths.h"
+
 #include UE_INLINE_GENERATED_CPP_BY_NAME(GameStatisticsSubsystem)
 
 namespace
@@ -35,11 +43,36 @@ void UGameStatisticsSubsystem::OnWorldBeginPlay(UWorld& InWorld)
 {
 	Super::OnWorldBeginPlay(InWorld);
 
+	// Before registering delegates so that the journal sees events raised during begin play
+	if (TR::CVarStatsJournalEnabled.GetValueOnGameThread())
+	{
+		OpenJournal(InWorld);
+	}
+
 	// Register delegates
 	if (auto TankEventsSubsystem = InWorld.GetSubsystem<UTankEventsSubsystem>();
 		ensureMsgf(TankEventsSubsystem, TEXT("%s: TankEventsSubsystem is NULL"), *GetName()))
 	{
 		TankEventsSubsystem->OnTankDestroyed.AddDynamic(this, &ThisClass::OnTankDestroyed);
+
+		if (Journal)
+		{
+			TankEventsSubsystem->OnEnemySpawned.AddDynamic(this, &ThisClass::OnEnemySpawned);
+		}
+	}
+
+	if (Journal)
+	{
+		if (auto XPSubsystem = InWorld.GetSubsystem<UXPSubsystem>(); ensure(XPSubsystem))
+		{
+			XPSubsystem->OnXPLevelUp.AddDynamic(this, &ThisClass::OnXPLevelUp);
+		}
+
+		if (auto ItemSubsystem = InWorld.GetSubsystem<UItemSubsystem>(); ensure(ItemSubsystem))
+		{
+			ItemSubsystem->OnLootSpawned.AddDynamic(this, &ThisClass::OnLootSpawned);
+			ItemSubsystem->OnLootPickedUp.AddDynamic(this, &ThisClass::OnLootPickedUp);
+		}
 	}
 
 	// Get player pawn and listen for inventory updates
@@ -58,6 +91,24 @@ void UGameStatisticsSubsystem::OnWorldBeginPlay(UWorld& InWorld)
 	}
 }
 
+void UGameStatisticsSubsystem::Deinitialize()
+{
+	if (Journal)
+	{
+		Journal->Close();
+		Journal.Reset();
+	}
+
+	InventoryItemNames.Reset();
+
+	Super::Deinitialize();
+}
+
+FString UGameStatisticsSubsystem::GetJournalPath() const
+{
+	return Journal ? Journal->GetPath() : FString{};
+}
+
 void UGameStatisticsSubsystem::GetItemMostKillsAttributedTo(UItem*& Item, int32& Count) const
 {
 	Item = nullptr;
@@ -77,19 +128,45 @@ void UGameStatisticsSubsystem::OnTankDestroyed(ABaseTankPawn* DestroyedTank, ACo
 {
 	check(DestroyedTank);
 
-	if (!DestroyedBy || !DestroyedBy->IsPlayerController())
+	const auto AttributedItem = RecordEnemyKill(DestroyedTank, DestroyedBy, DestroyedWith);
+
+	if (!Journal)
 	{
 		return;
 	}
 
+	// Every destruction is journaled, including the player's and those not counted for the player
+	const bool bPlayerTank = DestroyedTank->IsPlayerControlled();
+	const bool bByPlayer = DestroyedBy && DestroyedBy->IsPlayerController() && !bPlayerTank;
+
+	FGameJournalEvent Event
+	{
+		.SubjectId = Journal->GetObjectId(DestroyedTank),
+		.OtherId = Journal->GetObjectId(DestroyedBy ? DestroyedBy->GetPawn() : nullptr),
+		.NameId = Journal->GetNameId(GetJournalItemName(AttributedItem)),
+		.Type = EGameJournalEventType::TankDestroyed,
+		.Flags = (bByPlayer ? EGameJournalEventFlags::ByPlayer : EGameJournalEventFlags::None) |
+			(bPlayerTank ? EGameJournalEventFlags::Player : EGameJournalEventFlags::None)
+	};
+
+	RecordJournalEvent(Event);
+}
+
+UItem* UGameStatisticsSubsystem::RecordEnemyKill(ABaseTankPawn* DestroyedTank, AController* DestroyedBy, AActor* DestroyedWith)
+{
+	if (!DestroyedBy || !DestroyedBy->IsPlayerController())
+	{
+		return nullptr;
+	}
+
 	if (!DestroyedTank || DestroyedTank->GetController() == DestroyedBy)
 	{
-		return;
+		return nullptr;
 	}
 
 	if (!ShouldRecordUpdate())
 	{
-		return;
+		return nullptr;
 	}
 
 	++EnemiesKilled;
@@ -101,7 +178,7 @@ void UGameStatisticsSubsystem::OnTankDestroyed(ABaseTankPawn* DestroyedTank, ACo
 		EnemiesKilled
 	);
 
-	AttributeEnemyKillItem(DestroyedTank, DestroyedBy, DestroyedWith);
+	return AttributeEnemyKillItem(DestroyedTank, DestroyedBy, DestroyedWith);
 }
 
 void UGameStatisticsSubsystem::OnItemGameplayTagsChanged(UItem* Item, const TArray<APawn*>& AffectedPawns, const FGameplayTagContainer& Tags, bool bAdded)
@@ -180,6 +257,13 @@ void UGameStatisticsSubsystem::OnInventoryItemAdded(const UItemInventory* Invent
 	}
 
 	Item->OnItemGameplayTagsChanged.AddUObject(this, &ThisClass::OnItemGameplayTagsChanged);
+
+	InventoryItemNames.Add(Item, Name);
+
+	if (Journal)
+	{
+		Item->OnItemActivated.AddUObject(this, &ThisClass::OnItemActivated);
+	}
 }
 
 bool UGameStatisticsSubsystem::ShouldRecordUpdate() const
@@ -189,7 +273,7 @@ bool UGameStatisticsSubsystem::ShouldRecordUpdate() const
 	return PlayerTank && PlayerTank->GetHealthComponent()->IsAlive();
 }
 
-void UGameStatisticsSubsystem::AttributeEnemyKillItem(ABaseTankPawn* DestroyedTank, AController* DestroyedBy, AActor* DestroyedWith)
+UItem* UGameStatisticsSubsystem::AttributeEnemyKillItem(ABaseTankPawn* DestroyedTank, AController* DestroyedBy, AActor* DestroyedWith)
 {
 	// Attribute the passive weapon if disabled at time of kill
 	UItem* AttributedItem{};
@@ -210,12 +294,12 @@ void UGameStatisticsSubsystem::AttributeEnemyKillItem(ABaseTankPawn* DestroyedTa
 			*LoggingUtils::GetName(DestroyedWith)
 		);
 
-		return;
+		return nullptr;
 	}
 
 	if (!ensureMsgf(AttributedItem, TEXT("DestroyedTank=%s; DestroyedWith=%s"), *LoggingUtils::GetName(DestroyedTank), *LoggingUtils::GetName(DestroyedWith)))
 	{
-		return;
+		return nullptr;
 	}
 
 	[[maybe_unused]]
@@ -228,4 +312,114 @@ void UGameStatisticsSubsystem::AttributeEnemyKillItem(ABaseTankPawn* DestroyedTa
 		*LoggingUtils::GetName(AttributedItem),
 		TotalKills
 	);
+
+	return AttributedItem;
+}
+
+void UGameStatisticsSubsystem::OpenJournal(UWorld& InWorld)
+{
+	const auto StartTime = FDateTime::Now();
+	const auto MapName = InWorld.GetMapName();
+
+	const auto Path = FPaths::ProjectSavedDir() / TEXT("Journals") /
+		FString::Printf(TEXT("%s-%s.trjournal"), *FPaths::GetBaseFilename(MapName), *StartTime.ToString());
+
+	auto Writer = MakeUnique<FGameEventJournalWriter>();
+	if (!Writer->Open(Path, FGameJournalHeader{ .StartTime = StartTime, .MapName = MapName }))
+	{
+		return;
+	}
+
+	Journal = MoveTemp(Writer);
+}
+
+void UGameStatisticsSubsystem::RecordJournalEvent(FGameJournalEvent& Event)
+{
+	check(Journal);
+
+	auto World = GetWorld();
+	check(World);
+
+	Event.TimeSeconds = World->GetTimeSeconds();
+
+	Journal->Record(Event);
+}
+
+FName UGameStatisticsSubsystem::GetJournalItemName(const UItem* Item) const
+{
+	if (!Item)
+	{
+		return NAME_None;
+	}
+
+	// Enemy items are not in the player inventory
+	if (auto Name = InventoryItemNames.Find(Item); Name)
+	{
+		return *Name;
+	}
+
+	return Item->GetClass()->GetFName();
+}
+
+void UGameStatisticsSubsystem::OnEnemySpawned(APawn* Enemy)
+{
+	FGameJournalEvent Event
+	{
+		.SubjectId = Journal->GetObjectId(Enemy),
+		.Type = EGameJournalEventType::EnemySpawned
+	};
+
+	RecordJournalEvent(Event);
+}
+
+void UGameStatisticsSubsystem::OnItemActivated(UItem* Item)
+{
+	check(Item);
+
+	FGameJournalEvent Event
+	{
+		.SubjectId = Journal->GetObjectId(Item->GetOwner()),
+		.Value = Item->GetLevel(),
+		.NameId = Journal->GetNameId(GetJournalItemName(Item)),
+		.Type = EGameJournalEventType::ItemActivated
+	};
+
+	RecordJournalEvent(Event);
+}
+
+void UGameStatisticsSubsystem::OnXPLevelUp(int32 NewLevel)
+{
+	FGameJournalEvent Event
+	{
+		.SubjectId = Journal->GetObjectId(UGameplayStatics::GetPlayerPawn(GetWorld(), 0)),
+		.Value = NewLevel,
+		.Type = EGameJournalEventType::XPLevelUp
+	};
+
+	RecordJournalEvent(Event);
+}
+
+void UGameStatisticsSubsystem::OnLootSpawned(const ABasePickup* Pickup)
+{
+	FGameJournalEvent Event
+	{
+		.SubjectId = Journal->GetObjectId(Pickup),
+		.NameId = Journal->GetNameId(Pickup ? Pickup->GetClass()->GetFName() : NAME_None),
+		.Type = EGameJournalEventType::LootSpawned
+	};
+
+	RecordJournalEvent(Event);
+}
+
+void UGameStatisticsSubsystem::OnLootPickedUp(const ABasePickup* Pickup, APawn* PlayerPawn)
+{
+	FGameJournalEvent Event
+	{
+		.SubjectId = Journal->GetObjectId(Pickup),
+		.OtherId = Journal->GetObjectId(PlayerPawn),
+		.NameId = Journal->GetNameId(Pickup ? Pickup->GetClass()->GetFName() : NAME_None),
+		.Type = EGameJournalEventType::LootPickedUp
+	};
+
+	RecordJournalEvent(Event);
 }
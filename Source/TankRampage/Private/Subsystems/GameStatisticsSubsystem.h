@@ -4,15 +4,21 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
+
+#include "Subsystems/GameEventJournal.h"
+
 #include "GameStatisticsSubsystem.generated.h"
 
 class UItem;
 struct FGameplayTagContainer;
 class UItemInventory;
 struct FItemConfigData;
+class ABasePickup;
 
 /**
- * 
+ * Aggregate kill statistics of the current run.
+ * With <c>tr.stats.journal.enabled</c> every spawn, kill, item activation, level up and loot event is also appended to a binary journal in
+ * Saved/Journals that can be analyzed offline with <c>-run=GameEventJournal</c>.
  */
 UCLASS()
 class UGameStatisticsSubsystem : public UWorldSubsystem
@@ -27,14 +33,25 @@ public:
 	UFUNCTION(BlueprintPure)
 	void GetItemMostKillsAttributedTo(UItem*& Item, int32& Count) const;
 
+	/*
+	* Path of the journal being recorded or empty if not recording.
+	*/
+	FString GetJournalPath() const;
+
 protected:
 	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
 
 private:
 
 	UFUNCTION()
 	void OnTankDestroyed(ABaseTankPawn* DestroyedTank, AController* DestroyedBy, AActor* DestroyedWith);
 
+	/*
+	* Counts the kill if it was by the player and returns the item it is attributed to.
+	*/
+	UItem* RecordEnemyKill(ABaseTankPawn* DestroyedTank, AController* DestroyedBy, AActor* DestroyedWith);
+
 	void OnItemGameplayTagsChanged(UItem* Item, const TArray<APawn*>& AffectedPawns, const FGameplayTagContainer& Tags, bool bAdded);
 
 	UFUNCTION()
@@ -42,7 +59,25 @@ private:
 
 	bool ShouldRecordUpdate() const;
 
-	void AttributeEnemyKillItem(ABaseTankPawn* DestroyedTank, AController* DestroyedBy, AActor* DestroyedWith);
+	UItem* AttributeEnemyKillItem(ABaseTankPawn* DestroyedTank, AController* DestroyedBy, AActor* DestroyedWith);
+
+	void OpenJournal(UWorld& InWorld);
+	void RecordJournalEvent(FGameJournalEvent& Event);
+	FName GetJournalItemName(const UItem* Item) const;
+
+	UFUNCTION()
+	void OnEnemySpawned(APawn* Enemy);
+
+	void OnItemActivated(UItem* Item);
+
+	UFUNCTION()
+	void OnXPLevelUp(int32 NewLevel);
+
+	UFUNCTION()
+	void OnLootSpawned(const ABasePickup* Pickup);
+
+	UFUNCTION()
+	void OnLootPickedUp(const ABasePickup* Pickup, APawn* PlayerPawn);
 
 private:
 	int32 EnemiesKilled{};
@@ -55,4 +90,9 @@ private:
 
 	UPROPERTY(Transient)
 	TObjectPtr<UItem> DisabledItemWeaponCredit{};
+
+	/* Inventory names of the player's items so that journal entries don't depend on object names. */
+	TMap<TObjectKey<UItem>, FName> InventoryItemNames{};
+
+	TUniquePtr<FGameEventJournalWriter> Journal{};
 };
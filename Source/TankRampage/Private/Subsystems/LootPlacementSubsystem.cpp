@@ -0,0 +1,225 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/LootPlacementSubsystem.h"
+
+#include "Components/PrimitiveComponent.h"
+#include "EngineUtils.h"
+
+#include "Utils/CollisionUtils.h"
+
+#include "Logging/LoggingUtils.h"
+#include "TankRampageLogging.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(LootPlacementSubsystem)
+
+namespace
+{
+	/* Fine enough to find gaps between props for small pickups. Large levels fall back to a coarser size to cap memory. */
+	constexpr float CellSize = 50.0f;
+
+	// LandscapeSplineActor on Urban map cannot have object type set to "Ground" (locked in the base class) so need to filter that here
+	bool ShouldIgnoreByName(const AActor& Actor, const UPrimitiveComponent& Component);
+
+	const TArray<FString> IgnoreNames = { "Landscape" };
+
+	FBox2D ToBox2D(const FBox& Box);
+}
+
+TOptional<FVector> ULootPlacementSubsystem::FindFreeLocation(const FVector& Location, const FVector& Extent, float MaxRadius, TFunctionRef<bool(const FVector&)> Predicate)
+{
+	ProcessDirtyRegions();
+
+	const auto Result = Grid.FindNearestFree(FVector2D(Location), FVector2D(Extent), MaxRadius, [&](const FVector2D& Candidate)
+	{
+		return Predicate(FVector(Candidate, Location.Z));
+	});
+
+	if (!Result)
+	{
+		return {};
+	}
+
+	return FVector(*Result, Location.Z);
+}
+
+void ULootPlacementSubsystem::MarkRegionDirty(const FBox& Region)
+{
+	if (Region.IsValid)
+	{
+		DirtyRegions.Add(ToBox2D(Region));
+	}
+}
+
+void ULootPlacementSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	Rebuild();
+}
+
+void ULootPlacementSubsystem::Rebuild()
+{
+	auto World = GetWorld();
+	check(World);
+
+	const auto StartTime = FPlatformTime::Seconds();
+
+	Footprints.Reset();
+	DirtyRegions.Reset();
+
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		AddFootprints(**It);
+	}
+
+	FBox2D Bounds{ EForceInit::ForceInit };
+	for (const auto& Footprint : Footprints)
+	{
+		Bounds += Footprint.Box;
+	}
+
+	Grid.Init(Bounds.bIsValid ? Bounds.ExpandBy(CellSize) : Bounds, CellSize);
+
+	for (const auto& Footprint : Footprints)
+	{
+		Grid.MarkOccupied(Footprint.Box);
+	}
+
+	const auto CellCount = Grid.GetCellCount();
+
+	UE_LOG(LogTankRampage, Log, TEXT("%s: Rebuild - Baked %d footprint%s into %dx%d cells of %.0fcm (%d occupied) in %.2fms"),
+		*GetName(), Footprints.Num(), LoggingUtils::Pluralize(Footprints.Num()), CellCount.X, CellCount.Y, Grid.GetCellSize(), Grid.NumOccupied(),
+		(FPlatformTime::Seconds() - StartTime) * 1000);
+}
+
+void ULootPlacementSubsystem::AddFootprints(AActor& Actor)
+{
+	bool bAdded{};
+
+	Actor.ForEachComponent<UPrimitiveComponent>(false, [&](const UPrimitiveComponent* Component)
+	{
+		if (!Component || !IsPlacementBlocker(*Component) || ShouldIgnoreByName(Actor, *Component))
+		{
+			return;
+		}
+
+		Footprints.Add(FFootprint
+		{
+			.Component = Component,
+			.Box = GetFootprint(*Component)
+		});
+
+		bAdded = true;
+	});
+
+	if (bAdded)
+	{
+		Actor.OnDestroyed.AddUniqueDynamic(this, &ThisClass::OnBlockerDestroyed);
+	}
+}
+
+void ULootPlacementSubsystem::OnBlockerDestroyed(AActor* DestroyedActor)
+{
+	// Components are still valid here but are removed when the dirty region is processed
+	for (const auto& Footprint : Footprints)
+	{
+		if (auto Component = Footprint.Component.Get(); !Component || Component->GetOwner() == DestroyedActor)
+		{
+			DirtyRegions.Add(Footprint.Box);
+		}
+	}
+
+	UE_LOG(LogTankRampage, Verbose, TEXT("%s: OnBlockerDestroyed - %s; %d dirty region%s"),
+		*GetName(), *LoggingUtils::GetName(DestroyedActor), DirtyRegions.Num(), LoggingUtils::Pluralize(DirtyRegions.Num()));
+}
+
+void ULootPlacementSubsystem::ProcessDirtyRegions()
+{
+	if (DirtyRegions.IsEmpty())
+	{
+		return;
+	}
+
+	// Footprints of destroyed or no longer blocking components are dropped and the rest are restamped from their current bounds
+	Footprints.RemoveAllSwap([](const FFootprint& Footprint)
+	{
+		const auto Component = Footprint.Component.Get();
+		const auto Owner = Component ? Component->GetOwner() : nullptr;
+		return !IsValid(Component) || Component->IsBeingDestroyed() || (Owner && Owner->IsActorBeingDestroyed()) || !IsPlacementBlocker(*Component);
+	});
+
+	for (const auto& Region : DirtyRegions)
+	{
+		Grid.ClearRegion(Region);
+	}
+
+	int32 RestampedCount{};
+
+	for (auto& Footprint : Footprints)
+	{
+		// Cells partly covered by the region are cleared so include footprints within a cell of it
+		const bool bTouchesDirtyRegion = DirtyRegions.ContainsByPredicate([&](const FBox2D& Region)
+		{
+			return Footprint.Box.Intersect(Region.ExpandBy(Grid.GetCellSize()));
+		});
+
+		if (!bTouchesDirtyRegion)
+		{
+			continue;
+		}
+
+		Footprint.Box = GetFootprint(*Footprint.Component.Get());
+		Grid.MarkOccupied(Footprint.Box);
+
+		++RestampedCount;
+	}
+
+	UE_LOG(LogTankRampage, Verbose, TEXT("%s: ProcessDirtyRegions - Cleared %d region%s and restamped %d footprint%s"),
+		*GetName(), DirtyRegions.Num(), LoggingUtils::Pluralize(DirtyRegions.Num()), RestampedCount, LoggingUtils::Pluralize(RestampedCount));
+
+	DirtyRegions.Reset();
+}
+
+bool ULootPlacementSubsystem::IsPlacementBlocker(const UPrimitiveComponent& Component)
+{
+	// Ignore the ground and only consider blocks with the player tank
+	return Component.IsQueryCollisionEnabled() &&
+		   Component.GetCollisionObjectType() == ECollisionChannel::ECC_WorldStatic &&
+		   Component.GetCollisionResponseToChannel(ECC_Pawn) == ECollisionResponse::ECR_Block;
+}
+
+FBox2D ULootPlacementSubsystem::GetFootprint(const UPrimitiveComponent& Component)
+{
+	return ToBox2D(TR::CollisionUtils::GetAABB(Component));
+}
+
+void ULootPlacementSubsystem::Deinitialize()
+{
+	Grid.Reset();
+	Footprints.Reset();
+	DirtyRegions.Reset();
+
+	Super::Deinitialize();
+}
+
+namespace
+{
+	bool ShouldIgnoreByName(const AActor& Actor, const UPrimitiveComponent& Component)
+	{
+		const auto ContainsIgnoredName = [](const FString& ObjectName)
+		{
+			return IgnoreNames.ContainsByPredicate([&ObjectName](const auto& NameSubstring)
+			{
+				return ObjectName.Contains(NameSubstring);
+			});
+		};
+
+		return ContainsIgnoredName(Actor.GetName()) || ContainsIgnoredName(Component.GetName());
+	}
+
+	inline FBox2D ToBox2D(const FBox& Box)
+	{
+		return FBox2D(FVector2D(Box.Min), FVector2D(Box.Max));
+	}
+}
@@ -0,0 +1,66 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Containers/OccupancyGrid2D.h"
+
+#include "LootPlacementSubsystem.generated.h"
+
+/**
+ * Finds free spots to drop loot without physics queries.
+ * The XY footprints of static geometry that blocks the player tank are baked into an occupancy grid at level start and free spots are found
+ * with a spiral search on the grid.
+ *
+ * Destroying a baked actor clears its footprint automatically. Call <c>MarkRegionDirty</c> when static geometry otherwise changes, e.g. a breakable is fractured.
+ */
+UCLASS()
+class ULootPlacementSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/*
+	* Closest location to <c>Location</c> within <c>MaxRadius</c> where a box of <c>Extent</c> does not overlap static geometry
+	* and <c>Predicate</c> returns true. The Z of the returned location is unchanged.
+	*/
+	TOptional<FVector> FindFreeLocation(const FVector& Location, const FVector& Extent, float MaxRadius, TFunctionRef<bool(const FVector&)> Predicate);
+
+	/*
+	* Rebakes the footprints of static geometry touching <c>Region</c> before the next search.
+	* If geometry moved, mark both the old and the new region dirty.
+	*/
+	void MarkRegionDirty(const FBox& Region);
+
+	/*
+	* Rebakes the whole level.
+	*/
+	void Rebuild();
+
+protected:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+private:
+	struct FFootprint
+	{
+		TWeakObjectPtr<const UPrimitiveComponent> Component;
+		FBox2D Box;
+	};
+
+	void AddFootprints(AActor& Actor);
+	void ProcessDirtyRegions();
+
+	static bool IsPlacementBlocker(const UPrimitiveComponent& Component);
+	static FBox2D GetFootprint(const UPrimitiveComponent& Component);
+
+	UFUNCTION()
+	void OnBlockerDestroyed(AActor* DestroyedActor);
+
+private:
+	TR::FOccupancyGrid2D Grid{};
+
+	TArray<FFootprint> Footprints{};
+	TArray<FBox2D> DirtyRegions{};
+};
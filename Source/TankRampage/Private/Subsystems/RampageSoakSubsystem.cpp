@@ -0,0 +1,218 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/RampageSoakSubsystem.h"
+
+#include "GameMode/Rampage/RampageGameMode.h"
+#include "Pawn/BaseTankPawn.h"
+#include "Components/TankAimingComponent.h"
+#include "Subsystems/PawnSpatialHashSubsystem.h"
+
+#include "Kismet/GameplayStatics.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+
+#include "Utils/RandUtils.h"
+#include "Debug/TRCsvProfiler.h"
+
+#include "Logging/LoggingUtils.h"
+#include "TankRampageLogging.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(RampageSoakSubsystem)
+
+namespace
+{
+	constexpr float DefaultDurationSeconds = 300.0f;
+
+	/* Fixed player stand-in pattern: full turret sweep every 8 seconds aiming at a point at typical engagement range. */
+	constexpr float AimSweepDegreesPerSecond = 45.0f;
+	constexpr float AimDistance = 5000.0f;
+	constexpr float FireIntervalSeconds = 0.5f;
+}
+
+bool URampageSoakSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	if (!Super::ShouldCreateSubsystem(Outer) || !IsSoakRequested())
+	{
+		return false;
+	}
+
+	auto World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+bool URampageSoakSubsystem::IsSoakRequested()
+{
+	return FParse::Param(FCommandLine::Get(), TEXT("RampageSoak"));
+}
+
+void URampageSoakSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	FParse::Value(FCommandLine::Get(), TEXT("SoakTimeScale="), TimeScale);
+	TimeScale = FMath::Max(TimeScale, UE_KINDA_SMALL_NUMBER);
+
+	DurationSeconds = DefaultDurationSeconds;
+	FParse::Value(FCommandLine::Get(), TEXT("SoakDuration="), DurationSeconds);
+
+	// Seed the global engine streams as well as RandUtils so that code using FMath::Rand is also repeatable
+	if (const auto PinnedSeed = RandUtils::GetPinnedSeed(); PinnedSeed)
+	{
+		FMath::RandInit(*PinnedSeed);
+		FMath::SRandInit(*PinnedSeed);
+	}
+	else
+	{
+		UE_LOG(LogTankRampage, Warning, TEXT("%s: Initialize - No -TRSeed specified so runs will not be comparable"), *GetName());
+	}
+}
+
+void URampageSoakSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (!InWorld.GetAuthGameMode<ARampageGameMode>())
+	{
+		UE_LOG(LogTankRampage, Display, TEXT("%s: OnWorldBeginPlay - %s is not a Rampage level; soak skipped"), *GetName(), *InWorld.GetMapName());
+		return;
+	}
+
+	auto PlayerTank = Cast<ABaseTankPawn>(UGameplayStatics::GetPlayerPawn(&InWorld, 0));
+	if (!PlayerTank)
+	{
+		UE_LOG(LogTankRampage, Error, TEXT("%s: OnWorldBeginPlay - No player tank; soak skipped"), *GetName());
+		return;
+	}
+
+	// Spawning is driven by world timers so dilating time runs the wave schedule faster
+	UGameplayStatics::SetGlobalTimeDilation(&InWorld, TimeScale);
+
+	// Stand-in must survive the whole run so that the wave schedule is not cut short
+	PlayerTank->SetCanBeDamaged(false);
+
+	StartTimeSeconds = InWorld.GetTimeSeconds();
+	LastFireTimeSeconds = -1.0f;
+	FrameCount = 0;
+	bRunning = true;
+
+	BeginCapture();
+
+	UE_LOG(LogTankRampage, Display, TEXT("%s: OnWorldBeginPlay - Soak started on %s: TimeScale=%.2f; Duration=%.0fs; Seed=%s"),
+		*GetName(), *InWorld.GetMapName(), TimeScale, DurationSeconds,
+		RandUtils::GetPinnedSeed() ? *FString::Printf(TEXT("%u"), *RandUtils::GetPinnedSeed()) : TEXT("Random"));
+}
+
+bool URampageSoakSubsystem::IsTickable() const
+{
+	return bRunning;
+}
+
+void URampageSoakSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	auto World = GetWorld();
+	check(World);
+
+	const auto ElapsedSeconds = World->GetTimeSeconds() - StartTimeSeconds;
+
+	if (ElapsedSeconds >= DurationSeconds)
+	{
+		EndSoak();
+		return;
+	}
+
+	// Player tank is re-resolved each frame as the level may restart it
+	if (auto PlayerTank = Cast<ABaseTankPawn>(UGameplayStatics::GetPlayerPawn(World, 0)); PlayerTank)
+	{
+		DrivePlayerTank(*PlayerTank, ElapsedSeconds);
+	}
+
+	RecordFrameStats();
+	++FrameCount;
+}
+
+void URampageSoakSubsystem::DrivePlayerTank(ABaseTankPawn& PlayerTank, float ElapsedSeconds)
+{
+	// Ticked after actors so this overrides any aim from the player controller for the frame
+	const auto Yaw = FMath::Fmod(ElapsedSeconds * AimSweepDegreesPerSecond, 360.0f);
+	const auto Direction = FRotator(0, Yaw, 0).Vector();
+	const auto Origin = PlayerTank.GetActorLocation();
+
+	FAimingData AimingData;
+	AimingData.bAimTargetFound = true;
+	AimingData.AimTargetLocation = Origin + Direction * AimDistance;
+	AimingData.AimingOriginWorldLocation = Origin;
+	AimingData.AimingWorldDirection = Direction;
+
+	PlayerTank.AimAt(AimingData);
+
+	if (LastFireTimeSeconds < 0 || ElapsedSeconds - LastFireTimeSeconds >= FireIntervalSeconds)
+	{
+		PlayerTank.Fire();
+		LastFireTimeSeconds = ElapsedSeconds;
+	}
+}
+
+void URampageSoakSubsystem::RecordFrameStats()
+{
+	auto World = GetWorld();
+	check(World);
+
+	if (auto PawnSpatialHashSubsystem = World->GetSubsystem<UPawnSpatialHashSubsystem>(); PawnSpatialHashSubsystem)
+	{
+		CSV_CUSTOM_STAT(TR, SoakTankCount, PawnSpatialHashSubsystem->Num(), ECsvCustomStatOp::Set);
+	}
+}
+
+void URampageSoakSubsystem::BeginCapture()
+{
+#if CSV_PROFILER
+	auto CsvProfiler = FCsvProfiler::Get();
+	check(CsvProfiler);
+
+	CsvProfiler->EnableCategoryByString(TEXT("TR"));
+
+	CSV_METADATA(TEXT("RampageSoakTimeScale"), *FString::SanitizeFloat(TimeScale));
+	CSV_METADATA(TEXT("RampageSoakSeed"), RandUtils::GetPinnedSeed() ? *FString::Printf(TEXT("%u"), *RandUtils::GetPinnedSeed()) : TEXT("Random"));
+
+	// May already be capturing when also started with -csvProfile
+	if (!CsvProfiler->IsCapturing())
+	{
+		CsvProfiler->BeginCapture();
+	}
+#else
+	UE_LOG(LogTankRampage, Warning, TEXT("%s: BeginCapture - CSV profiler not available in this build configuration; only the frame count is reported"), *GetName());
+#endif
+}
+
+void URampageSoakSubsystem::EndSoak()
+{
+	bRunning = false;
+
+	UE_LOG(LogTankRampage, Display, TEXT("%s: EndSoak - Completed %d frame%s over %.0fs of game time"),
+		*GetName(), FrameCount, LoggingUtils::Pluralize(FrameCount), DurationSeconds);
+
+#if CSV_PROFILER
+	if (auto CsvProfiler = FCsvProfiler::Get(); CsvProfiler->IsCapturing())
+	{
+		CsvProfiler->EndCapture();
+	}
+#endif
+
+	// Graceful exit so the CSV writer finishes flushing
+	FPlatformMisc::RequestExit(false);
+}
+
+TStatId URampageSoakSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URampageSoakSubsystem, STATGROUP_Tickables);
+}
+
+void URampageSoakSubsystem::Deinitialize()
+{
+	bRunning = false;
+
+	Super::Deinitialize();
+}
@@ -0,0 +1,59 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "RampageSoakSubsystem.generated.h"
+
+class ABaseTankPawn;
+
+/**
+ * Headless soak benchmark of the Rampage game mode enabled with <c>-RampageSoak</c> on the command line, e.g.
+ *
+ *   TankRampage Map -game -RampageSoak -SoakTimeScale=4 -SoakDuration=600 -TRSeed=1 -nullrhi -nosound -unattended -fixedTimeStep -fps=30
+ *
+ * The player tank stands in as an invulnerable turret sweeping its aim and firing on a fixed pattern while enemy waves
+ * are scheduled at <c>SoakTimeScale</c> times normal speed. Per-frame timings in the <c>TR</c> CSV profiler category
+ * are written to Saved/Profiling/CSV and the game exits after <c>SoakDuration</c> seconds of game time.
+ * Pin <c>-TRSeed</c> so that spawner and loot selection match between runs.
+ */
+UCLASS()
+class URampageSoakSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	static bool IsSoakRequested();
+
+protected:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+
+	virtual TStatId GetStatId() const override;
+
+	virtual void Deinitialize() override;
+
+private:
+	void BeginCapture();
+	void EndSoak();
+
+	void DrivePlayerTank(ABaseTankPawn& PlayerTank, float ElapsedSeconds);
+	void RecordFrameStats();
+
+private:
+	float TimeScale{ 1.0f };
+	float DurationSeconds{};
+
+	float StartTimeSeconds{};
+	float LastFireTimeSeconds{ -1.0f };
+
+	int32 FrameCount{};
+	bool bRunning{};
+};
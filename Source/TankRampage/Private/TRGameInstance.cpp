@@ -9,6 +9,7 @@
 #include "Settings/TRGameUserSettings.h"
 
 #include "InputCharacteristics.h"
+#include "InputRecording.h"
 
 #include "MoviePlayer.h"
 
@@ -31,6 +32,9 @@ void UTRGameInstance::Init()
 
 	Super::Init();
 
+	// Pin the seed of an input recording before the first map loads so that every object seeded in it sees the same seed
+	TR::FInputRecording::PinSimulationFromCommandLine();
+
 	InitGamepadAvailable();
 	InitLoadingScreen();
 }
@@ -0,0 +1,140 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/GameEventJournal.h"
+
+#include "Algo/Find.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace GameEventJournalTests
+{
+	constexpr auto TestFlags = EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter;
+
+	bool EventsEqual(const FGameJournalEvent& First, const FGameJournalEvent& Second)
+	{
+		return First.Type == Second.Type && First.TimeSeconds == Second.TimeSeconds && First.SubjectId == Second.SubjectId && First.OtherId == Second.OtherId &&
+			First.Value == Second.Value && First.Flags == Second.Flags && First.NameId == Second.NameId;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameEventJournalRoundTripTest, "TankRampage.TankRampage.GameEventJournal.RoundTrip", GameEventJournalTests::TestFlags)
+
+bool FGameEventJournalRoundTripTest::RunTest(const FString& Parameters)
+{
+	using namespace GameEventJournalTests;
+
+	const auto Path = FPaths::AutomationTransientDir() / FString::Printf(TEXT("RoundTrip-%s.trjournal"), *FGuid::NewGuid().ToString());
+
+	const FName ItemNames[] = { TEXT("MainGun"), TEXT("EMP"), TEXT("MiniNuke") };
+
+	TArray<FGameJournalEvent> Expected;
+
+	{
+		FGameEventJournalWriter Writer;
+		if (!TestTrue(TEXT("Open"), Writer.Open(Path, FGameJournalHeader{ .StartTime = FDateTime(2024, 1, 1), .MapName = TEXT("RoundTrip") })))
+		{
+			return true;
+		}
+
+		TestEqual(TEXT("None has no name id"), Writer.GetNameId(NAME_None), FGameJournalEvent::InvalidNameId);
+		TestEqual(TEXT("Null has no object id"), Writer.GetObjectId(nullptr), 0u);
+
+		FRandomStream Rng(1234);
+
+		for (int32 i = 0; i < 500; ++i)
+		{
+			FGameJournalEvent Event
+			{
+				.TimeSeconds = i * 0.5f,
+				.SubjectId = static_cast<uint32>(Rng.RandRange(1, 50)),
+				.Value = Rng.RandRange(-100, 100),
+				.Type = static_cast<EGameJournalEventType>(Rng.RandHelper(static_cast<int32>(EGameJournalEventType::MAX)))
+			};
+
+			if (Event.Type == EGameJournalEventType::TankDestroyed || Event.Type == EGameJournalEventType::ItemActivated)
+			{
+				Event.NameId = Writer.GetNameId(ItemNames[Rng.RandHelper(UE_ARRAY_COUNT(ItemNames))]);
+			}
+
+			if (Event.Type == EGameJournalEventType::TankDestroyed)
+			{
+				Event.OtherId = 1;
+				Event.Flags = EGameJournalEventFlags::ByPlayer;
+			}
+
+			Writer.Record(Event);
+			Expected.Add(Event);
+		}
+
+		TestEqual(TEXT("Recorded"), Writer.NumRecorded(), Expected.Num());
+		TestEqual(TEXT("Dropped"), Writer.NumDropped(), 0);
+
+		// Close drains whatever the writer thread has not written yet
+	}
+
+	ON_SCOPE_EXIT
+	{
+		IFileManager::Get().Delete(*Path);
+	};
+
+	FGameJournal Journal;
+	FString Error;
+
+	const auto bLoaded = FGameJournal::LoadFromFile(Path, Journal, &Error);
+	if (!TestTrue(*FString::Printf(TEXT("Load: %s"), *Error), bLoaded))
+	{
+		return true;
+	}
+
+	TestEqual(TEXT("Map name"), Journal.Header.MapName, FString(TEXT("RoundTrip")));
+	TestEqual(TEXT("Start time"), Journal.Header.StartTime, FDateTime(2024, 1, 1));
+
+	if (!TestEqual(TEXT("Event count"), Journal.Events.Num(), Expected.Num()))
+	{
+		return true;
+	}
+
+	for (int32 i = 0; i < Expected.Num(); ++i)
+	{
+		const auto& Event = Expected[i];
+
+		if (!TestTrue(*FString::Printf(TEXT("Event %d matches"), i), EventsEqual(Journal.Events[i], Event)))
+		{
+			break;
+		}
+
+		if (Event.NameId != FGameJournalEvent::InvalidNameId)
+		{
+			const auto& Name = Journal.GetName(Event.NameId);
+			TestTrue(*FString::Printf(TEXT("Event %d name %s"), i, *Name), Algo::FindByPredicate(ItemNames, [&Name](const FName& ItemName) { return ItemName.ToString() == Name; }) != nullptr);
+		}
+	}
+
+	// A crashed run leaves a partial final record that is skipped rather than failing the load
+	TArray<uint8> Data;
+	if (TestTrue(TEXT("Read journal bytes"), FFileHelper::LoadFileToArray(Data, *Path)))
+	{
+		Data.SetNum(Data.Num() - 3);
+
+		FGameJournal Truncated;
+		if (TestTrue(TEXT("Load truncated"), FGameJournal::LoadFromMemory(Data, Truncated)))
+		{
+			TestEqual(TEXT("Truncated event count"), Truncated.Events.Num(), Expected.Num() - 1);
+		}
+
+		Data[0] ^= 0xFF;
+
+		FGameJournal Corrupted;
+		TestFalse(TEXT("Load corrupted magic"), FGameJournal::LoadFromMemory(Data, Corrupted));
+	}
+
+	return true;
+}
+
+#endif
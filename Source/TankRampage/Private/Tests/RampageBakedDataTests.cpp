@@ -0,0 +1,167 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "GameMode/Rampage/RampageBakedData.h"
+
+#include "Engine/DataTable.h"
+#include "GameMode/Rampage/EnemySpawnerData.h"
+#include "GameMode/Rampage/LevelUnlocksData.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR
+
+namespace RampageBakedDataTests
+{
+	constexpr auto TestFlags = EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter;
+
+	template<typename RowType>
+	UDataTable* MakeTable(const TArray<RowType>& Rows)
+	{
+		auto Table = NewObject<UDataTable>(GetTransientPackage());
+		Table->RowStruct = RowType::StaticStruct();
+
+		for (int32 i = 0; i < Rows.Num(); ++i)
+		{
+			Table->AddRow(*FString::Printf(TEXT("Row%d"), i), Rows[i]);
+		}
+
+		return Table;
+	}
+
+	TArray<FEnemySpawnerData> MakeSpawnerRows()
+	{
+		TArray<FEnemySpawnerData> Rows;
+		for (int32 Minute = 0; Minute < 10; ++Minute)
+		{
+			auto& Row = Rows.AddDefaulted_GetRef();
+			Row.SpawnCount = 10 + Minute * 5;
+			Row.SpawnClusterSize = 1 + Minute / 3;
+		}
+
+		return Rows;
+	}
+
+	TArray<FLevelUnlocksData> MakeLevelUnlockRows()
+	{
+		const FName ItemNames[] = { TEXT("MainGun"), TEXT("EMP"), TEXT("MiniNuke"), TEXT("HomingMissile") };
+
+		TArray<FLevelUnlocksData> Rows;
+		for (int32 PlayerLevel = 1; PlayerLevel <= 5; ++PlayerLevel)
+		{
+			// Level 1 has the single starting item and later levels an upgrade of each
+			const int32 UnlockCount = PlayerLevel == 1 ? 1 : UE_ARRAY_COUNT(ItemNames);
+
+			for (int32 i = 0; i < UnlockCount; ++i)
+			{
+				auto& Row = Rows.AddDefaulted_GetRef();
+				Row.PlayerLevel = PlayerLevel;
+				Row.ItemName = ItemNames[i];
+				Row.ItemLevel = PlayerLevel;
+				Row.Description = FText::FromString(FString::Printf(TEXT("%s level %d"), *ItemNames[i].ToString(), PlayerLevel));
+			}
+		}
+
+		return Rows;
+	}
+
+	TArray<FLevelUpData> MakeLevelUpRows()
+	{
+		TArray<FLevelUpData> Rows;
+		for (int32 i = 0; i < 6; ++i)
+		{
+			auto& Row = Rows.AddDefaulted_GetRef();
+			Row.XP = 10 * (i + 1) * (i + 1);
+			Row.UnlockChoices = 2 + i % 2;
+		}
+
+		return Rows;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRampageBakedDataMatchesSourceTest, "TankRampage.TankRampage.RampageBakedData.MatchesSource", RampageBakedDataTests::TestFlags)
+
+bool FRampageBakedDataMatchesSourceTest::RunTest(const FString& Parameters)
+{
+	using namespace RampageBakedDataTests;
+
+	auto EnemySpawnerDataTable = MakeTable(MakeSpawnerRows());
+	auto LevelUnlocksDataTable = MakeTable(MakeLevelUnlockRows());
+	auto LevelUpDataTable = MakeTable(MakeLevelUpRows());
+
+	auto BakedData = NewObject<URampageBakedData>(GetTransientPackage());
+
+	TestFalse(TEXT("No valid baked data before baking"), BakedData->HasValidBakedData());
+	AddExpectedError(TEXT("No valid baked data"), EAutomationExpectedErrorFlags::Contains, 1);
+	TestEqual(TEXT("Mismatches before baking"), BakedData->CountMismatchesWithSource(), static_cast<int32>(INDEX_NONE));
+
+	BakedData->SetSourceTables(EnemySpawnerDataTable, LevelUnlocksDataTable, LevelUpDataTable);
+	BakedData->Bake();
+
+	if (!TestTrue(TEXT("Valid baked data after baking"), BakedData->HasValidBakedData()))
+	{
+		return true;
+	}
+
+	TestEqual(TEXT("Mismatches after baking"), BakedData->CountMismatchesWithSource(), 0);
+
+	// The views the game mode and components read must agree with what they would have parsed without baked data
+	if (!TestTrue(TEXT("Records loaded"), BakedData->LoadRecords()))
+	{
+		return true;
+	}
+
+	const auto SpawnerData = EnemySpawnerDataParser::ReadAll(EnemySpawnerDataTable);
+	const auto LevelUnlocks = LevelUnlocksParser::ToConfigArray(LevelUnlocksDataTable, LevelUpDataTable);
+	const auto XPLevels = LevelUnlocksParser::ToXPLevelRequirementsArray(LevelUpDataTable);
+
+	const auto SpawnerRecords = BakedData->GetSpawnerRecords();
+	if (TestEqual(TEXT("Spawner record count"), SpawnerRecords.Num(), SpawnerData.Num()))
+	{
+		for (int32 Minute = 0; Minute < SpawnerData.Num(); ++Minute)
+		{
+			TestEqual(*FString::Printf(TEXT("SpawnCount at minute %d"), Minute), SpawnerRecords[Minute].SpawnCount, SpawnerData[Minute].SpawnCount);
+			TestEqual(*FString::Printf(TEXT("SpawnClusterSize at minute %d"), Minute), SpawnerRecords[Minute].SpawnClusterSize, SpawnerData[Minute].SpawnClusterSize);
+		}
+	}
+
+	if (TestEqual(TEXT("Player level count"), BakedData->GetPlayerLevelRecords().Num(), LevelUnlocks.Num()))
+	{
+		for (int32 Index = 0; Index < LevelUnlocks.Num(); ++Index)
+		{
+			const auto Config = BakedData->GetLevelUnlocksConfig(Index);
+			const auto& Expected = LevelUnlocks[Index];
+
+			TestEqual(*FString::Printf(TEXT("MaxUnlockOptions at level %d"), Index + 1), Config.MaxUnlockOptions, Expected.MaxUnlockOptions);
+
+			if (!TestEqual(*FString::Printf(TEXT("Unlock count at level %d"), Index + 1), Config.AvailableUnlocks.Num(), Expected.AvailableUnlocks.Num()))
+			{
+				continue;
+			}
+
+			for (int32 i = 0; i < Expected.AvailableUnlocks.Num(); ++i)
+			{
+				const auto& Unlock = Config.AvailableUnlocks[i];
+				const auto& ExpectedUnlock = Expected.AvailableUnlocks[i];
+
+				TestTrue(*FString::Printf(TEXT("Unlock %d at level %d"), i, Index + 1),
+					Unlock == ExpectedUnlock && Unlock.Description.EqualTo(ExpectedUnlock.Description));
+			}
+		}
+	}
+
+	TestEqual(TEXT("XP levels"), TArray<int32>(BakedData->GetXPLevelRequirements()), XPLevels);
+
+	// Editing a source table without rebaking is caught
+	auto Row = EnemySpawnerDataTable->FindRow<FEnemySpawnerData>(TEXT("Row3"), TEXT("FRampageBakedDataMatchesSourceTest"));
+	if (TestNotNull(TEXT("Spawner row to edit"), Row))
+	{
+		Row->SpawnCount += 1;
+
+		AddExpectedError(TEXT("SpawnerData differ at index 3"), EAutomationExpectedErrorFlags::Contains, 1);
+		TestEqual(TEXT("Mismatches after editing a source table"), BakedData->CountMismatchesWithSource(), 1);
+	}
+
+	return true;
+}
+
+#endif